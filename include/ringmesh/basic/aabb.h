@@ -121,6 +121,28 @@ namespace RINGMesh
             bbox_intersect_recursive< EvalIntersection >(
                 box, ROOT_INDEX, 0, nb_bboxes(), action );
         }
+        /*
+         * @brief Computes the element boxes that may intersect a query
+         * only known through a test on boxes (e.g. a plane).
+         * @param[in] box_test The functor telling if a box may intersect the
+         * query, the sub-trees whose box fails the test are skipped
+         * @param[in] action The functor to run on each element box passing
+         * \p box_test
+         * @tparam EvalBox this functor should have an operator() defined like
+         * this:
+         * bool operator()( const Box< DIMENSION >& box ) ;
+         * @tparam EvalIntersection this functor should have an operator()
+         * defined like this:
+         * void operator()( index_t cur_box ) ;
+         * where cur_box is the element box index
+         */
+        template < class EvalBox, class EvalIntersection >
+        void compute_element_bbox_intersections(
+            const EvalBox& box_test, EvalIntersection& action ) const
+        {
+            element_bbox_intersect_recursive< EvalBox, EvalIntersection >(
+                box_test, ROOT_INDEX, 0, nb_bboxes(), action );
+        }
         /*
          * @brief Computes the self intersections of the element boxes.
          * @param[in] action The functor to run when two boxes intersect
@@ -213,6 +235,13 @@ namespace RINGMesh
             index_t element_end,
             ACTION& action ) const;
 
+        template < class TEST, class ACTION >
+        void element_bbox_intersect_recursive( const TEST& box_test,
+            index_t node_index,
+            index_t element_begin,
+            index_t element_end,
+            ACTION& action ) const;
+
         template < class ACTION >
         void self_intersect_recursive( index_t node_index1,
             index_t element_begin1,
@@ -414,6 +443,41 @@ namespace RINGMesh
             box, child_right, box_middle, element_end, action );
     }
 
+    template < index_t DIMENSION >
+    template < class TEST, class ACTION >
+    void AABBTree< DIMENSION >::element_bbox_intersect_recursive(
+        const TEST& box_test,
+        index_t node_index,
+        index_t element_begin,
+        index_t element_end,
+        ACTION& action ) const
+    {
+        ringmesh_assert( node_index < tree_.size() );
+        ringmesh_assert( element_begin != element_end );
+
+        // Prune sub-tree that fails the test
+        if( !box_test( node( node_index ) ) )
+        {
+            return;
+        }
+
+        // Leaf case
+        if( is_leaf( element_begin, element_end ) )
+        {
+            action( mapping_morton_[element_begin] );
+            return;
+        }
+
+        index_t box_middle, child_left, child_right;
+        get_recursive_iterators( node_index, element_begin, element_end,
+            box_middle, child_left, child_right );
+
+        element_bbox_intersect_recursive< TEST, ACTION >(
+            box_test, child_left, element_begin, box_middle, action );
+        element_bbox_intersect_recursive< TEST, ACTION >(
+            box_test, child_right, box_middle, element_end, action );
+    }
+
     template < index_t DIMENSION >
     template < class ACTION >
     void AABBTree< DIMENSION >::self_intersect_recursive( index_t node_index1,
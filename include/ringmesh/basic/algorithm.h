@@ -38,8 +38,12 @@
 #include <ringmesh/basic/common.h>
 
 #include <algorithm>
+#include <cstdint>
+#include <thread>
 #include <vector>
 
+#include <ringmesh/basic/task_handler.h>
+
 /*!
  * @file ringmesh/algorithm.h
  * @brief Template function for basic operations on std container
@@ -152,4 +156,81 @@ namespace RINGMesh
         container.erase( std::unique( container.begin(), container.end() ),
             container.end() );
     }
+
+    /*!
+     * @brief Sorts (key, value) pairs by increasing key with a parallel LSD
+     * radix sort.
+     * @details The sort is stable. The items are split into one contiguous
+     * chunk per thread: each pass counts the digits of every chunk, then
+     * scatters the chunks into disjoint ranges of a buffer. The digits shared
+     * by all the keys are skipped.
+     * @param[in,out] items the pairs to sort
+     * @param[in] nb_key_bits number of low bits used by the keys
+     */
+    template < typename T >
+    void parallel_radix_sort(
+        std::vector< std::pair< std::uint64_t, T > >& items,
+        index_t nb_key_bits = 64 )
+    {
+        const index_t nb_items = static_cast< index_t >( items.size() );
+        if( nb_items < 2 )
+        {
+            return;
+        }
+        const index_t nb_digit_bits{ 11 };
+        const index_t nb_buckets{ 1u << nb_digit_bits };
+        const std::uint64_t digit_mask{ nb_buckets - 1 };
+        const index_t min_chunk_size{ 1u << 14 };
+        const index_t nb_chunks{ std::max( 1u,
+            std::min( std::thread::hardware_concurrency(),
+                nb_items / min_chunk_size ) ) };
+        const index_t chunk_size{ ( nb_items + nb_chunks - 1 ) / nb_chunks };
+        auto chunk_begin = [nb_items, chunk_size]( index_t chunk ) {
+            return std::min( nb_items, chunk * chunk_size );
+        };
+
+        std::vector< std::pair< std::uint64_t, T > > buffer( items.size() );
+        std::vector< index_t > offsets( nb_chunks * nb_buckets );
+        for( index_t shift = 0; shift < nb_key_bits; shift += nb_digit_bits )
+        {
+            std::fill( offsets.begin(), offsets.end(), 0 );
+            parallel_for( nb_chunks, [&]( index_t chunk ) {
+                auto histogram = &offsets[chunk * nb_buckets];
+                for( auto i : range( chunk_begin( chunk ),
+                         chunk_begin( chunk + 1 ) ) )
+                {
+                    histogram[( items[i].first >> shift ) & digit_mask]++;
+                }
+            } );
+
+            bool single_digit{ false };
+            index_t sum{ 0 };
+            for( auto digit : range( nb_buckets ) )
+            {
+                for( auto chunk : range( nb_chunks ) )
+                {
+                    auto& offset = offsets[chunk * nb_buckets + digit];
+                    auto count = offset;
+                    single_digit |= count == nb_items;
+                    offset = sum;
+                    sum += count;
+                }
+            }
+            if( single_digit )
+            {
+                continue;
+            }
+
+            parallel_for( nb_chunks, [&]( index_t chunk ) {
+                auto offset = &offsets[chunk * nb_buckets];
+                for( auto i : range( chunk_begin( chunk ),
+                         chunk_begin( chunk + 1 ) ) )
+                {
+                    auto digit = ( items[i].first >> shift ) & digit_mask;
+                    buffer[offset[digit]++] = items[i];
+                }
+            } );
+            items.swap( buffer );
+        }
+    }
 } // namespace RINGMesh
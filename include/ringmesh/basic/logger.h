@@ -38,6 +38,8 @@
 #include <ringmesh/basic/common.h>
 
 #include <mutex>
+#include <sstream>
+#include <vector>
 
 #include <geogram/basic/logger.h>
 
@@ -51,6 +53,46 @@ namespace RINGMesh
     class basic_api Logger
     {
     public:
+        struct CapturedMessage
+        {
+            bool is_error;
+            std::string feature;
+            std::string message;
+        };
+        using CapturedMessages = std::vector< CapturedMessage >;
+
+        /*!
+         * @brief Keeps the warnings and errors logged by the current thread
+         * @details While a MessageCapture lives, the warnings and errors
+         * logged by the thread that created it are stored instead of being
+         * logged. Concurrent tasks use it to log their messages afterwards
+         * in a deterministic order with replay().
+         */
+        class MessageCapture
+        {
+            ringmesh_disable_copy_and_move( MessageCapture );
+
+        public:
+            MessageCapture() : previous_( captured_messages() )
+            {
+                captured_messages() = &messages_;
+            }
+
+            ~MessageCapture()
+            {
+                captured_messages() = previous_;
+            }
+
+            const CapturedMessages& messages() const
+            {
+                return messages_;
+            }
+
+        private:
+            CapturedMessages messages_{};
+            CapturedMessages* previous_;
+        };
+
         static void div( const std::string& title )
         {
             std::lock_guard< std::mutex > locking( lock() );
@@ -67,6 +109,10 @@ namespace RINGMesh
         template < typename... Args >
         static void err( const std::string& feature, const Args&... args )
         {
+            if( capture( true, feature, args... ) )
+            {
+                return;
+            }
             std::lock_guard< std::mutex > locking( lock() );
             log( GEO::Logger::err( feature ), args... );
         }
@@ -74,26 +120,69 @@ namespace RINGMesh
         template < typename... Args >
         static void warn( const std::string& feature, const Args&... args )
         {
+            if( capture( false, feature, args... ) )
+            {
+                return;
+            }
             std::lock_guard< std::mutex > locking( lock() );
             log( GEO::Logger::warn( feature ), args... );
         }
 
+        /*!
+         * @brief Logs a message stored by a MessageCapture
+         */
+        static void replay( const CapturedMessage& message )
+        {
+            if( message.is_error )
+            {
+                err( message.feature, message.message );
+            }
+            else
+            {
+                warn( message.feature, message.message );
+            }
+        }
+
         static GEO::Logger* instance()
         {
             return GEO::Logger::instance();
         }
 
     private:
-        static void log( std::ostream& os )
+        static void write( std::ostream& os )
         {
-            os << std::endl;
+            ringmesh_unused( os );
         }
 
         template < class A0, class... Args >
-        static void log( std::ostream& os, const A0& a0, const Args&... args )
+        static void write(
+            std::ostream& os, const A0& a0, const Args&... args )
         {
             os << a0;
-            log( os, args... );
+            write( os, args... );
+        }
+
+        template < typename... Args >
+        static void log( std::ostream& os, const Args&... args )
+        {
+            write( os, args... );
+            os << std::endl;
+        }
+
+        template < typename... Args >
+        static bool capture( bool is_error,
+            const std::string& feature,
+            const Args&... args )
+        {
+            auto captured = captured_messages();
+            if( captured == nullptr )
+            {
+                return false;
+            }
+            std::ostringstream message;
+            write( message, args... );
+            captured->push_back( { is_error, feature, message.str() } );
+            return true;
         }
 
         static std::mutex& lock()
@@ -101,6 +190,9 @@ namespace RINGMesh
             static std::mutex lock;
             return lock;
         }
+
+        /// Capture of the current thread, nullptr when messages are logged
+        static CapturedMessages*& captured_messages();
     };
 
     class basic_api ThreadSafeConsoleLogger : public GEO::ConsoleLogger
@@ -35,8 +35,14 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
 #include <functional>
 #include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #include <ringmesh/basic/common.h>
 #include <ringmesh/basic/types.h>
@@ -128,4 +134,99 @@ namespace RINGMesh
         tasks.wait_aysnc_tasks();
     }
 
+    /*!
+     * @brief Hands out jobs one at a time, in a given order
+     * @details Model of the queue used by process_job_queue.
+     */
+    class OrderedJobQueue
+    {
+    public:
+        explicit OrderedJobQueue( std::vector< index_t > jobs )
+            : jobs_( std::move( jobs ) )
+        {
+        }
+
+        /*!
+         * @return the next job, or NO_ID if there is none left
+         */
+        index_t acquire()
+        {
+            auto next = next_job_++;
+            return next < jobs_.size() ? jobs_[next] : NO_ID;
+        }
+
+        /*!
+         * Called once the job @param job is done
+         */
+        void release( index_t job )
+        {
+            ringmesh_unused( job );
+        }
+
+        /*!
+         * Called when the job @param job failed, stops handing out jobs
+         */
+        void abort( index_t job )
+        {
+            ringmesh_unused( job );
+            next_job_ = static_cast< index_t >( jobs_.size() );
+        }
+
+    private:
+        std::vector< index_t > jobs_;
+        std::atomic< index_t > next_job_{ 0 };
+    };
+
+    /*!
+     * @brief Processes the jobs of a queue on a pool of workers
+     * @param[in] queue gives the jobs to the workers (see OrderedJobQueue),
+     * its functions are called concurrently
+     * @param[in] nb_jobs number of jobs, bounds the number of workers
+     * @param[in] action functor called on each job
+     * @details The first exception thrown by @p action is rethrown once
+     * all the workers are done.
+     */
+    template < typename QUEUE, typename ACTION >
+    void process_job_queue(
+        QUEUE& queue, index_t nb_jobs, const ACTION& action )
+    {
+        std::exception_ptr error;
+        std::mutex error_mutex;
+        auto worker = [&queue, &action, &error, &error_mutex]() {
+            for( auto job = queue.acquire(); job != NO_ID;
+                 job = queue.acquire() )
+            {
+                try
+                {
+                    action( job );
+                    queue.release( job );
+                }
+                catch( ... )
+                {
+                    {
+                        std::lock_guard< std::mutex > lock( error_mutex );
+                        if( !error )
+                        {
+                            error = std::current_exception();
+                        }
+                    }
+                    queue.abort( job );
+                }
+            }
+        };
+        index_t nb_workers{ std::max(
+            1u, std::min( std::thread::hardware_concurrency(), nb_jobs ) ) };
+        TaskHandler tasks{ nb_workers };
+        for( auto w : range( nb_workers ) )
+        {
+            ringmesh_unused( w );
+            tasks.execute( worker );
+        }
+        tasks.wait_aysnc_tasks();
+        if( error )
+        {
+            std::rethrow_exception( error );
+        }
+    }
+
 } // namespace RINGMesh
@@ -292,6 +292,33 @@ private:                                                                       \
             mesh_.mesh_->cells.assign_tet_mesh( copy, false );
         }
 
+        void do_assign_tet_mesh( const double* points,
+            index_t nb_points,
+            const index_t* tets,
+            const index_t* adjacents,
+            index_t nb_tets ) override
+        {
+            auto& mesh = *mesh_.mesh_;
+            mesh.cells.clear( true, false );
+            mesh.vertices.assign_points( points, DIMENSION, nb_points );
+            if( nb_tets == 0 )
+            {
+                return;
+            }
+            mesh.cells.create_tets( nb_tets );
+            GEO::Memory::copy( mesh.cell_corners.vertex_index_ptr( 0 ), tets,
+                4 * nb_tets * sizeof( index_t ) );
+            if( adjacents != nullptr )
+            {
+                GEO::Memory::copy( mesh.cell_facets.adjacent_cell_ptr( 0 ),
+                    adjacents, 4 * nb_tets * sizeof( index_t ) );
+            }
+            else
+            {
+                mesh.cells.connect();
+            }
+        }
+
         void do_set_cell_vertex( const ElementLocalVertex& cell_local_vertex,
             index_t vertex_id ) override
         {
@@ -64,7 +64,7 @@ namespace RINGMesh
 
     protected:
         const GeoModel3D& geomodel3d_from_;
-        const Geometry::Plane& plane_;
+        Geometry::Plane plane_;
         vec3 u_axis_{};
         vec3 v_axis_{};
     };
@@ -97,4 +97,69 @@ namespace RINGMesh
         std::vector< vec2 > compute_projected_vertices(
             const GeoModelMeshEntity3D& entity );
     };
+
+    /*!
+     * @brief Builder of GeoModel2D which cuts a GeoModel3D along a plane or
+     * along a vertical curtain.
+     * @details A curtain is given by a polyline in map view, each of its
+     * segments defines a vertical panel. The section coordinates are then
+     * the curvilinear abscissa along the polyline and the elevation.
+     * The Surfaces are cut in parallel using their polygon AABB trees, and
+     * the cut segments are stitched into Lines by the mesh edges they cross.
+     * Each section Line is a part of the cut of one Surface, the section
+     * Corners are at the Line ends, and the section Surfaces are built from
+     * them. The lines of a Surface belonging to an Interface3D are grouped in
+     * an Interface2D.
+     * The GeoModel3D is not modified and the AABB trees of its Surfaces are
+     * kept, so many sections can be cut from the same GeoModel3D.
+     * @note A curtain should cross the whole GeoModel3D: the section is not
+     * closed where the curtain ends inside the model.
+     */
+    class geomodel_builder_api GeoModelBuilder2DCrossSection
+        : public GeoModelBuilder2DFrom3D
+    {
+    public:
+        GeoModelBuilder2DCrossSection( GeoModel2D& geomodel2d,
+            const GeoModel3D& geomodel3d_from,
+            const Geometry::Plane& plane );
+
+        /*!
+         * @param[in] curtain Polyline of at least two points in the (x, y)
+         * map view
+         */
+        GeoModelBuilder2DCrossSection( GeoModel2D& geomodel2d,
+            const GeoModel3D& geomodel3d_from,
+            const std::vector< vec2 >& curtain );
+
+        void build_geomodel();
+
+        /*!
+         * @brief Planar part of the section
+         * @details A point of the panel has the section coordinates
+         * ( abscissa + u, v ), with u and v measured from the plane origin
+         * along u_axis and v_axis. Only u in [u_min, u_max] is kept.
+         */
+        struct SectionPanel
+        {
+            Geometry::Plane plane;
+            vec3 u_axis;
+            vec3 v_axis;
+            double u_min;
+            double u_max;
+            double abscissa;
+        };
+
+    private:
+        GeoModelBuilder2DCrossSection( GeoModel2D& geomodel2d,
+            const GeoModel3D& geomodel3d_from,
+            std::vector< SectionPanel > panels );
+
+        void build_section_corners_and_lines();
+
+        void copy_geomodel_3d_interfaces(
+            const std::vector< index_t >& line_surfaces );
+
+    private:
+        std::vector< SectionPanel > panels_;
+    };
 } // namespace RINGMesh
@@ -285,6 +285,18 @@ namespace RINGMesh
 
         double& modifiable_epsilon();
 
+        /*!
+         * @brief Notifies the GeoModel listeners of a change
+         * @details The modifiable accessors do not notify anything: the
+         * builder operations call these functions once they really change
+         * the geometry or the topology of the GeoModel.
+         */
+        void notify_mesh_entity_change( const gmme_id& id );
+
+        void notify_geological_entity_change( const gmge_id& id );
+
+        void notify_geomodel_change();
+
     private:
         GeoModel< DIMENSION >& geomodel_;
     };
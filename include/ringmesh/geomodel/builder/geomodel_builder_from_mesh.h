@@ -75,9 +75,10 @@ namespace RINGMesh
          * a
          *          Surface of the GeoModel.
          *          Connected components of the mesh are determined with a
-         *          propagation (or "coloriage" algorithm) using the
-         * adjacent_facet
+         *          concurrent union-find on the adjacent_facet
          *          information provided on the input GEO::Mesh.
+         *          The Surfaces are ordered by their smallest facet and
+         *          filled in parallel.
          *
          * @todo Old code - old building - to delimit connected components
          * vertices are duplicated in the input mesh
@@ -37,6 +37,8 @@
 
 #include <ringmesh/geomodel/builder/common.h>
 
+#include <set>
+
 #include <ringmesh/geomodel/builder/geomodel_builder_access.h>
 
 /*!
@@ -54,6 +56,10 @@ namespace RINGMesh
     FORWARD_DECLARATION_DIMENSION_CLASS( SurfaceMeshBuilder );
     FORWARD_DECLARATION_DIMENSION_CLASS( VolumeMeshBuilder );
 
+    struct CellLocalFacet;
+    struct ElementLocalVertex;
+    struct PolygonLocalEdge;
+
     ALIAS_3D( GeoModel );
     ALIAS_3D( GeoModelBuilder );
     ALIAS_3D( VolumeMeshBuilder );
@@ -82,6 +88,7 @@ namespace RINGMesh
         void change_mesh_data_structure(
             const gmme_id& id, const MeshType type )
         {
+            geomodel_access_.notify_mesh_entity_change( id );
             GeoModelMeshEntityAccess< DIMENSION > gmme_access(
                 geomodel_access_.modifiable_mesh_entity( id ) );
             gmme_access.change_mesh_data_structure( type );
@@ -322,7 +329,13 @@ namespace RINGMesh
          * polygon for the edge
          * starting at this vertex.
          * If there is no neighbor inside the same Surface adjacent is set to
-         * NO_ID
+         * NO_ID.
+         * When recomputed, the adjacencies are computed by
+         * SurfaceMeshBuilder::compute_polygon_adjacencies(): the
+         * non-manifold edges and the edges traversed in the same direction
+         * by two polygons are set to NO_ID on all their polygons.
+         * Otherwise, SurfaceMeshBuilder::connect_polygons() links the
+         * polygons of a non-manifold edge to one arbitrary neighbor.
          *
          * @param[in] surface_id Index of the surface
          * @param[in] recompute_adjacency If true, recompute the existing
@@ -331,6 +344,11 @@ namespace RINGMesh
         void compute_surface_adjacencies(
             index_t surface_id, bool recompute_adjacency = true );
 
+        /*!
+         * @brief Cuts every Surface along its internal Lines
+         * @details The Surfaces are cut concurrently, then the GeoModelMesh
+         * vertices are cleared since their mapping is outdated.
+         */
         void cut_surfaces_by_internal_lines();
 
         /*!
@@ -346,21 +364,37 @@ namespace RINGMesh
         GeoModelBuilderGeometryBase( GeoModelBuilder< DIMENSION >& builder,
             GeoModel< DIMENSION >& geomodel );
 
+        /*!
+         * @brief Cuts a Surface along several Lines
+         * @details The Line edges and vertices are located in the Surface
+         * before any cut, so the Surface search structures are built once.
+         * Only reads the other mesh entities.
+         */
+        void cut_surface_by_lines(
+            index_t surface_id, const std::set< index_t >& line_ids );
+
         /*!
          * @brief Duplicates the surface vertices along the fake boundary
          * (NO_ID adjacencies but shared vertices) and duplicate the vertices
+         * @param[in] polygon_vertices for each Line vertex, a colocated
+         * polygon vertex of the Surface
          */
-        void duplicate_surface_vertices_along_line(
-            index_t surface_id, index_t line_id );
+        void duplicate_surface_vertices_along_line( index_t surface_id,
+            index_t line_id,
+            const std::vector< ElementLocalVertex >& polygon_vertices );
         /*
          * @brief Resets the adjacencies for all Surface polygons adjacent to
          * the Line
+         * @param[in] polygon_edges for each Line edge, the matching polygon
+         * edge of the Surface
          * @return The number of disconnection done
          * @pre All the edges of the Line are edges of at least one polygon of
          * the Surface
          */
         index_t disconnect_surface_polygons_along_line_edges(
-            index_t surface_id, index_t line_id );
+            index_t surface_id,
+            index_t line_id,
+            const std::vector< PolygonLocalEdge >& polygon_edges );
 
         void update_polygon_vertex( index_t surface_id,
             const std::vector< index_t >& polygons,
@@ -456,6 +490,11 @@ namespace RINGMesh
         void compute_region_adjacencies(
             index_t region_id, bool recompute_adjacency = true );
 
+        /*!
+         * @brief Cuts every Region along its internal Surfaces
+         * @details The Regions are cut concurrently, then the GeoModelMesh
+         * vertices are cleared since their mapping is outdated.
+         */
         void cut_regions_by_internal_surfaces();
 
         void cut_region_by_surface( index_t region_id, index_t surface_id );
@@ -478,10 +517,22 @@ namespace RINGMesh
             index_t old_vertex,
             index_t new_vertex );
 
-        void duplicate_region_vertices_along_surface(
-            index_t region_id, index_t surface_id );
+        /*!
+         * @brief Cuts a Region along several Surfaces
+         * @details The Surface polygons and vertices are located in the
+         * Region before any cut, so the Region search structures are built
+         * once. Only reads the other mesh entities.
+         */
+        void cut_region_by_surfaces(
+            index_t region_id, const std::set< index_t >& surface_ids );
+
+        void duplicate_region_vertices_along_surface( index_t region_id,
+            index_t surface_id,
+            const std::vector< ElementLocalVertex >& cell_vertices );
 
         index_t disconnect_region_cells_along_surface_polygons(
-            index_t region_id, index_t surface_id );
+            index_t region_id,
+            index_t surface_id,
+            const std::vector< CellLocalFacet >& cell_facets );
     };
 } // namespace RINGMesh
@@ -37,6 +37,8 @@
 
 #include <ringmesh/geomodel/core/common.h>
 
+#include <atomic>
+#include <mutex>
 #include <vector>
 
 #include <ringmesh/basic/frame.h>
@@ -94,6 +96,40 @@ namespace RINGMesh
         std::vector< bool > sides_;
     };
 
+    /*!
+     * @brief Interface of the objects notified of the GeoModel changes
+     * @details A notification is sent by the GeoModelBuilder operations
+     * changing the geometry or the topology of the GeoModel, usually once
+     * per builder call (e.g. once per moved vertex). Renaming entities or
+     * reading the GeoModel through a builder does not notify anything.
+     * Notifications may come from several threads at the same time: they
+     * are serialized by a mutex of the GeoModel, so listeners must be
+     * cheap. Without listener, a notification only costs an atomic load.
+     */
+    template < index_t DIMENSION >
+    class GeoModelChangeListener
+    {
+    public:
+        virtual ~GeoModelChangeListener() = default;
+
+        /*!
+         * @brief The mesh or the relationships of the GeoModelMeshEntity
+         * @param id may be modified
+         */
+        virtual void mesh_entity_changed( const gmme_id& id ) = 0;
+
+        /*!
+         * @brief The relationships of the GeoModelGeologicalEntity @param id
+         * may be modified
+         */
+        virtual void geological_entity_changed( const gmge_id& id ) = 0;
+
+        /*!
+         * @brief Entities may be created, removed or renumbered
+         */
+        virtual void geomodel_changed() = 0;
+    };
+
     template < index_t DIMENSION >
     class geomodel_core_api GeoModelBase
     {
@@ -240,6 +276,27 @@ namespace RINGMesh
             return wells_;
         }
 
+        /*!
+         * @brief Registers a listener notified of the GeoModel changes
+         * @pre The listener is removed before being destroyed.
+         */
+        void add_change_listener(
+            GeoModelChangeListener< DIMENSION >& listener ) const;
+
+        void remove_change_listener(
+            GeoModelChangeListener< DIMENSION >& listener ) const;
+
+        /*!
+         * @brief Gets a counter incremented each time a builder operation
+         * modifies a Surface or the GeoModel structure
+         * @details Caches built on the Surface meshes compare it to the
+         * value they were built with to know when to be rebuilt.
+         */
+        index_t surfaces_revision() const
+        {
+            return surfaces_revision_;
+        }
+
     public:
         mutable GeoModelMesh< DIMENSION > mesh;
 
@@ -319,8 +376,21 @@ namespace RINGMesh
          */
         const WellGroup< DIMENSION >* wells_{ nullptr };
 
+    private:
+        void notify_mesh_entity_change( const gmme_id& id );
+
+        void notify_geological_entity_change( const gmge_id& id );
+
+        void notify_geomodel_change();
+
     private:
         std::unique_ptr< const StratigraphicColumn > strati_column_;
+
+        mutable std::vector< GeoModelChangeListener< DIMENSION >* >
+            change_listeners_;
+        mutable std::mutex change_listeners_lock_;
+        mutable std::atomic< index_t > nb_change_listeners_{ 0 };
+        std::atomic< index_t > surfaces_revision_{ 0 };
     };
     ALIAS_2D_AND_3D( GeoModelBase );
 
@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2012-2018, Association Scientifique pour la Geologie et ses
+ * Applications (ASGA). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of ASGA nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL ASGA BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *     http://www.ring-team.org
+ *
+ *     RING Project
+ *     Ecole Nationale Superieure de Geologie - GeoRessources
+ *     2 Rue du Doyen Marcel Roubault - TSA 70605
+ *     54518 VANDOEUVRE-LES-NANCY
+ *     FRANCE
+ */
+
+#pragma once
+
+#include <ringmesh/geomodel/core/common.h>
+
+#include <memory>
+#include <vector>
+
+#include <ringmesh/basic/geometry.h>
+
+#include <ringmesh/mesh/mesh_aabb.h>
+
+/*!
+ * @file AABB tree of all the Surfaces of a GeoModel
+ */
+
+namespace RINGMesh
+{
+    FORWARD_DECLARATION_DIMENSION_CLASS( GeoModel );
+} // namespace RINGMesh
+
+namespace RINGMesh
+{
+    /*!
+     * Intersection between a segment and a Surface polygon
+     */
+    template < index_t DIMENSION >
+    struct SurfaceIntersection
+    {
+        SurfaceIntersection() = default;
+        SurfaceIntersection( vecn< DIMENSION > point_in,
+            index_t surface_in,
+            index_t polygon_in,
+            double distance_in )
+            : point( std::move( point_in ) ),
+              surface( surface_in ),
+              polygon( polygon_in ),
+              distance( distance_in )
+        {
+        }
+
+        vecn< DIMENSION > point{};
+        index_t surface{ NO_ID };
+        index_t polygon{ NO_ID };
+        /// Distance between the intersection and the segment start
+        double distance{ 0 };
+    };
+
+    ALIAS_2D_AND_3D( SurfaceIntersection );
+
+    /*!
+     * Intersections of a set of segments stored contiguously:
+     * the intersections of the segment s are in the range
+     * [offsets[s], offsets[s+1]) of intersections
+     */
+    template < index_t DIMENSION >
+    struct SegmentsSurfaceIntersections
+    {
+        std::vector< index_t > offsets{};
+        std::vector< SurfaceIntersection< DIMENSION > > intersections{};
+    };
+
+    ALIAS_2D_AND_3D( SegmentsSurfaceIntersections );
+
+    /*!
+     * @brief Two-level AABB tree of the Surfaces of a GeoModel
+     * @details The top tree is built on the Surface bounding boxes and its
+     * leaves are the polygon AABB trees of the Surfaces. A query only
+     * descends into the Surfaces whose bounding box is hit, and does not
+     * need the GeoModelMesh.
+     * @warning The tree is not updated when the Surfaces are modified.
+     */
+    template < index_t DIMENSION >
+    class geomodel_core_api GeoModelSurfacesAABBTree
+    {
+        ringmesh_disable_copy_and_move( GeoModelSurfacesAABBTree );
+        ringmesh_template_assert_2d_or_3d( DIMENSION );
+
+    public:
+        /*!
+         * Builds the Surface bounding boxes and the polygon AABB trees
+         * of the Surfaces in parallel
+         */
+        explicit GeoModelSurfacesAABBTree(
+            const GeoModel< DIMENSION >& geomodel );
+
+        const GeoModel< DIMENSION >& geomodel() const
+        {
+            return geomodel_;
+        }
+
+        /*!
+         * @brief Computes the intersections between a given box and
+         * the bounding boxes of the Surface polygons
+         * @tparam EvalIntersection this functor should have an operator()
+         * defined like this:
+         * void operator()( index_t surface, index_t polygon ) ;
+         */
+        template < class EvalIntersection >
+        void compute_bbox_polygon_bbox_intersections(
+            const Box< DIMENSION >& box, EvalIntersection& action ) const
+        {
+            if( !surfaces_tree_ )
+            {
+                return;
+            }
+            SurfaceAction< EvalIntersection > surface_action(
+                *this, box, action );
+            surfaces_tree_->compute_bbox_element_bbox_intersections(
+                box, surface_action );
+        }
+
+        /*!
+         * @brief Computes the intersections between segments and the
+         * Surface triangles
+         * @details The segments are processed in parallel, each task storing
+         * its intersections in its own buffer.
+         * @pre The Surfaces need to be triangulated
+         * @return the intersections of each segment, sorted by increasing
+         * distance to the segment start
+         */
+        SegmentsSurfaceIntersections< DIMENSION > segment_intersections(
+            const std::vector< Geometry::Segment< DIMENSION > >& segments )
+            const;
+
+    private:
+        const SurfaceAABBTree< DIMENSION >& surface_tree(
+            index_t surface ) const;
+
+        template < class EvalIntersection >
+        class SurfaceAction
+        {
+        public:
+            SurfaceAction( const GeoModelSurfacesAABBTree< DIMENSION >& tree,
+                const Box< DIMENSION >& box,
+                EvalIntersection& action )
+                : tree_( tree ), box_( box ), action_( action )
+            {
+            }
+
+            void operator()( index_t surface )
+            {
+                PolygonAction polygon_action( surface, action_ );
+                tree_.surface_tree( surface )
+                    .compute_bbox_element_bbox_intersections(
+                        box_, polygon_action );
+            }
+
+        private:
+            class PolygonAction
+            {
+            public:
+                PolygonAction( index_t surface, EvalIntersection& action )
+                    : surface_( surface ), action_( action )
+                {
+                }
+
+                void operator()( index_t polygon )
+                {
+                    action_( surface_, polygon );
+                }
+
+            private:
+                index_t surface_;
+                EvalIntersection& action_;
+            };
+
+        private:
+            const GeoModelSurfacesAABBTree< DIMENSION >& tree_;
+            const Box< DIMENSION >& box_;
+            EvalIntersection& action_;
+        };
+
+    private:
+        const GeoModel< DIMENSION >& geomodel_;
+        std::unique_ptr< BoxAABBTree< DIMENSION > > surfaces_tree_{};
+    };
+
+    ALIAS_2D_AND_3D( GeoModelSurfacesAABBTree );
+} // namespace RINGMesh
@@ -803,10 +803,30 @@ namespace RINGMesh
 
     ALIAS_2D_AND_3D( GeoModelMeshEdges );
 
+    /*!
+     * @brief Portion of a well edge lying inside a cell
+     * @details entry and exit are the parametric coordinates (between 0 and 1)
+     * along the edge where the edge enters and leaves the cell.
+     */
+    struct WellEdgeCellIntersection
+    {
+        WellEdgeCellIntersection() = default;
+        WellEdgeCellIntersection(
+            index_t cell_in, double entry_in, double exit_in )
+            : cell( cell_in ), entry( entry_in ), exit( exit_in )
+        {
+        }
+        index_t cell{ NO_ID };
+        double entry{ 0 };
+        double exit{ 0 };
+    };
+
     template < index_t DIMENSION >
     class geomodel_core_api GeoModelMeshWells final
         : public GeoModelMeshCommon< DIMENSION >
     {
+        friend class GeoModelMeshCells< DIMENSION >;
+
     public:
         explicit GeoModelMeshWells( GeoModelMesh< DIMENSION >& gmm,
             GeoModel< DIMENSION >& gm,
@@ -859,6 +879,46 @@ namespace RINGMesh
          */
         const LineAABBTree< DIMENSION >& aabb() const;
 
+        /*!
+         * Gets the number of GeoModelMesh cells crossed by a well edge
+         * @param[in] well the well index
+         * @param[in] edge the edge index in the well
+         * @pre Only available in 3D
+         */
+        index_t nb_cell_intersections( index_t well, index_t edge ) const;
+        /*!
+         * Gets a cell crossed by a well edge
+         * @param[in] well the well index
+         * @param[in] edge the edge index in the well
+         * @param[in] i the intersection index (0 to nb_cell_intersections)
+         * @return the crossed cell with the entry and exit parameters,
+         * intersections are sorted along the edge
+         */
+        const WellEdgeCellIntersection& cell_intersection(
+            index_t well, index_t edge, index_t i ) const;
+        /*!
+         * Gets the cells perforated by a well
+         * @param[in] well the well index
+         * @return the GeoModelMesh cell indices in the order the well
+         * trajectory enters them
+         */
+        const std::vector< index_t >& perforated_cells( index_t well ) const;
+
+    private:
+        /*!
+         * Tests if the well/cell intersections needs to be computed and
+         * compute them
+         */
+        void test_and_initialize_cell_intersections() const;
+        /*!
+         * Computes the cells crossed by each well edge
+         */
+        void initialize_cell_intersections();
+        /*!
+         * Clears the well/cell intersections
+         */
+        void clear_cell_intersections();
+
     private:
         /// Attached Mesh
         std::unique_ptr< LineMesh< DIMENSION > >& mesh_;
@@ -868,6 +928,18 @@ namespace RINGMesh
          * for a given well
          */
         std::vector< index_t > well_ptr_;
+
+        /// Flag telling if the well/cell intersections are up to date
+        bool cell_intersections_initialized_{ false };
+        /*!
+         * Vector storing the index of the first cell intersection
+         * of each edge in cell_intersections_
+         */
+        std::vector< index_t > edge_cell_ptr_;
+        /// Cells crossed by the edges, sorted along each edge
+        std::vector< WellEdgeCellIntersection > cell_intersections_;
+        /// Cells perforated by each well
+        std::vector< std::vector< index_t > > perforated_cells_;
     };
 
     ALIAS_2D_AND_3D( GeoModelMeshWells );
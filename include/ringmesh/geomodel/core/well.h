@@ -52,6 +52,7 @@
 namespace RINGMesh
 {
     FORWARD_DECLARATION_DIMENSION_CLASS( GeoModel );
+    FORWARD_DECLARATION_DIMENSION_CLASS( GeoModelSurfacesAABBTree );
     FORWARD_DECLARATION_DIMENSION_CLASS( Well );
     FORWARD_DECLARATION_DIMENSION_CLASS( NNSearch );
     FORWARD_DECLARATION_DIMENSION_CLASS( PointSetMesh );
@@ -402,6 +403,25 @@ namespace RINGMesh
 
     // --------------------------------------------------------------------------
 
+    /*!
+     * Trajectories of several wells stored in columnar arrays: the vertices
+     * of the well w are the vertices [offsets[w], offsets[w+1]) of the
+     * coordinate arrays, in the order of the trajectory.
+     */
+    struct WellTrajectories
+    {
+        index_t nb_wells() const
+        {
+            return static_cast< index_t >( names.size() );
+        }
+
+        std::vector< std::string > names{};
+        std::vector< index_t > offsets{ 0 };
+        std::vector< double > x{};
+        std::vector< double > y{};
+        std::vector< double > z{};
+    };
+
     /*!
      * Set of wells associated to a GeoModel
      */
@@ -412,7 +432,7 @@ namespace RINGMesh
 
     public:
         WellGroup();
-        virtual ~WellGroup() = default;
+        virtual ~WellGroup();
 
         /*!
          * Gets all the edges contained in a region
@@ -467,6 +487,16 @@ namespace RINGMesh
         void add_well(
             const LineMesh< DIMENSION >& mesh, const std::string& name );
 
+        /*!
+         * Adds several wells from their trajectories and makes them
+         * conformal to the associated GeoModel.
+         * @details The wells are built in parallel. As for add_well(),
+         * a trajectory is ignored if a well with the same name already
+         * exists (or comes first in \p trajectories).
+         * @param[in] trajectories the trajectories of the wells
+         */
+        void add_wells( const WellTrajectories& trajectories );
+
         /*!
          * Gets the number of wells
          */
@@ -488,11 +518,20 @@ namespace RINGMesh
         void compute_conformal_mesh(
             const LineMesh< DIMENSION >& in, LineMesh< DIMENSION >& out );
 
+        const GeoModelSurfacesAABBTree< DIMENSION >& surfaces_aabb();
+
     private:
         /// Vector of the wells
         std::vector< Well< DIMENSION >* > wells_;
         /// Associated GeoModel
         GeoModel< DIMENSION >* geomodel_;
+        /// AABB tree of the GeoModel Surfaces, built at the first well
+        /// addition and rebuilt when the Surfaces are modified through
+        /// the builder
+        std::unique_ptr< GeoModelSurfacesAABBTree< DIMENSION > >
+            surfaces_aabb_;
+        /// GeoModel Surface revision surfaces_aabb_ was built with
+        index_t surfaces_aabb_revision_{ NO_ID };
     };
 
     ALIAS_2D_AND_3D( WellGroup );
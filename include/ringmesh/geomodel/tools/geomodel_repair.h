@@ -71,4 +71,31 @@ namespace RINGMesh
     void geomodel_tools_api repair_geomodel(
         GeoModel< DIMENSION >& geomodel, RepairMode repair_mode );
 
+    /*!
+     * Numbers of changes a repair would make in a GeoModel.
+     * nb_degenerate_polygons counts all the polygons removed from the
+     * Surfaces having polygons with colocated vertices: the duplicated and
+     * zero area ones, and the small connected components left.
+     */
+    struct RepairReport
+    {
+        index_t nb_colocated_vertices{ 0 };
+        index_t nb_degenerate_edges{ 0 };
+        index_t nb_degenerate_polygons{ 0 };
+        index_t nb_lines_with_wrong_boundary_order{ 0 };
+        index_t nb_isolated_vertices{ 0 };
+    };
+
+    /*!
+     * @brief Reports what a repair of a GeoModel would change, without
+     * modifying the GeoModel.
+     * @details The changes are logged entity by entity. Each repair process
+     * is evaluated on the input GeoModel, as if it was the first applied.
+     * The BASIC and CONTACTS modes do not report anything.
+     * @param[in] repair_mode repair mode to evaluate.
+     */
+    template < index_t DIMENSION >
+    RepairReport geomodel_tools_api dry_run_repair_geomodel(
+        const GeoModel< DIMENSION >& geomodel, RepairMode repair_mode );
+
 } // namespace RINGMesh
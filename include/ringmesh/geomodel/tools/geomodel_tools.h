@@ -66,7 +66,8 @@ namespace RINGMesh
      * Compute the tetrahedral mesh of the input structural geomodel
      * @param[in/out] geomodel GeoModel to tetrahedralize
      * @param[in] region_id Region to mesh. By default it set to NO_ID and all
-     * regions are meshed.
+     * regions are meshed concurrently, the largest ones first (see the
+     * algo:tet_budget argument to bound the memory).
      * @param[in] add_steiner_points if true (default value), the mesher will
      * add some points inside the region.
      */
@@ -78,7 +79,7 @@ namespace RINGMesh
      * Compute the tetrahedral mesh of the input structural geomodel
      * @param[in/out] geomodel GeoModel to tetrahedralize
      * @param[in] region_id Region to mesh. If set to NO_ID and all regions are
-     * meshed.
+     * meshed concurrently.
      * @param[in] add_steiner_points if true, the mesher will add some points
      * inside the region.
      * @param[in] internal_vertices points inside the domain to constrain mesh
@@ -37,6 +37,10 @@
 
 #include <ringmesh/geomodel/tools/common.h>
 
+#include <ringmesh/basic/pimpl.h>
+
+#include <ringmesh/geomodel/core/geomodel.h>
+
 /*!
  * @file ringmesh/geomodel_validity.h
  * @brief Functions to check the validity of GeoModels
@@ -45,7 +49,6 @@
 
 namespace RINGMesh
 {
-    FORWARD_DECLARATION_DIMENSION_CLASS( GeoModel );
     FORWARD_DECLARATION_DIMENSION_CLASS( GeoModelEntity );
 } // namespace RINGMesh
 
@@ -90,6 +93,21 @@ namespace RINGMesh
      */
     ValidityCheckMode geomodel_tools_api get_validity_mode_from_arg();
 
+    /*!
+     * @brief Tests if two triangles intersect as the polygon intersection
+     * check does
+     * @details Floating-point filters discard the certified separated
+     * pairs, the other pairs are given to the exact predicate: the result
+     * is the one of GEO::triangles_intersections(), which does not report
+     * the contacts reduced to a shared vertex or edge.
+     */
+    bool geomodel_tools_api are_triangles_intersecting( const vec3& p0,
+        const vec3& p1,
+        const vec3& p2,
+        const vec3& q0,
+        const vec3& q1,
+        const vec3& q2 );
+
     /*!
      * @brief Check global geomodel validity
      * @param[in] geomodel GeoModel to check
@@ -100,6 +118,52 @@ namespace RINGMesh
     bool is_geomodel_valid( const GeoModel< DIMENSION >& geomodel,
         ValidityCheckMode validity_check_mode = get_validity_mode_from_arg() );
 
+    /*!
+     * @brief Validity checks of a GeoModel under edition
+     * @details The session keeps the result of each check per entity and
+     * listens to the GeoModel changes made through the GeoModelBuilders.
+     * When the validity is asked again, only the checks on the modified
+     * entities and on their boundaries, incident entities and parents are
+     * run again. The checks on the whole GeoModel (finite extension,
+     * non-manifold edges, polygon intersections) are run again after any
+     * change. Creating or removing entities resets the session.
+     */
+    template < index_t DIMENSION >
+    class geomodel_tools_api GeoModelValiditySession final
+        : public GeoModelChangeListener< DIMENSION >
+    {
+        ringmesh_disable_copy_and_move( GeoModelValiditySession );
+
+    public:
+        /*!
+         * @param[in] geomodel GeoModel to check
+         * @param[in] validity_check_mode Mode to select what model feature
+         * should be checked.
+         */
+        explicit GeoModelValiditySession( const GeoModel< DIMENSION >& geomodel,
+            ValidityCheckMode validity_check_mode =
+                get_validity_mode_from_arg() );
+
+        ~GeoModelValiditySession();
+
+        /*!
+         * @brief Check global geomodel validity, running again only the
+         * checks affected by the changes since the previous call
+         */
+        bool is_geomodel_valid();
+
+        void mesh_entity_changed( const gmme_id& id ) final;
+
+        void geological_entity_changed( const gmge_id& id ) final;
+
+        void geomodel_changed() final;
+
+    private:
+        IMPLEMENTATION_MEMBER( impl_ );
+    };
+
+    ALIAS_2D_AND_3D( GeoModelValiditySession );
+
     /*!
      * @brief Check the validity of all individual entity meshes
      * @details Check that the entities belong to this geomodel,
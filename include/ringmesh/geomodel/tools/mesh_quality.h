@@ -62,6 +62,25 @@ namespace RINGMesh
         MIN_SOLID_ANGLE
     };
 
+    /*!
+     * @brief Quality metrics defined for all the cell types (tetrahedra,
+     * hexahedra, prisms and pyramids)
+     */
+    enum CellQualityMode
+    {
+        /// Minimum over the cell corners of the Jacobian determinant divided
+        /// by the corner edge lengths, scaled to 1 for the regular cell.
+        /// Between -1 and 1, negative for inverted cells.
+        SCALED_JACOBIAN,
+        /// Maximum over the cell facets of the largest relative deviation
+        /// of the facet angles from those of the regular polygon.
+        /// Between 0 (regular facets) and 1 (degenerate facets).
+        EQUIANGLE_SKEWNESS,
+        /// Ratio of the longest cell edge to the shortest one, 1 for
+        /// regular cells. max_float64() for the cells with a null edge.
+        EDGE_ASPECT_RATIO
+    };
+
     /*!
      * @brief Computes and stores mesh quality in the GeoModel.
      *
@@ -87,6 +106,106 @@ namespace RINGMesh
     void geomodel_tools_api compute_prop_tet_mesh_quality(
         MeshQualityMode mesh_qual_mode, const GeoModel3D& geomodel );
 
+    /*!
+     * @brief Computes and stores the four mesh qualities in the GeoModel.
+     *
+     * All the qualities are computed in a single pass over the cells, each
+     * one stored on the Region cells as compute_prop_tet_mesh_quality does.
+     *
+     * @param[in,out] geomodel GeoModel in which the mesh qualities are
+     * computed.
+     *
+     * @warning The GeoModel must have at least one region. All the regions
+     * must be meshed by simplexes (tetrahedra).
+     */
+    void geomodel_tools_api compute_prop_tet_mesh_qualities(
+        const GeoModel3D& geomodel );
+
+    /*!
+     * @brief Distribution of a mesh quality over the cells of a GeoModel
+     */
+    struct geomodel_tools_api MeshQualityStatistics
+    {
+        /// Number of cells in the GeoModel regions
+        index_t nb_cells{ 0 };
+        /// Number of cells of quality below the requested minimum
+        index_t nb_low_quality_cells{ 0 };
+        /// Number of cells without quality value (EDGE_ASPECT_RATIO of the
+        /// cells with a null edge). They are counted in nb_cells and
+        /// nb_low_quality_cells, but not in the values below.
+        index_t nb_degenerate_cells{ 0 };
+        double min_value{ 0 };
+        double first_quartile{ 0 };
+        double median{ 0 };
+        double third_quartile{ 0 };
+        double max_value{ 0 };
+        double mean{ 0 };
+        /// Number of cells per quality interval, [histogram_min,
+        /// histogram_max] being evenly split. The end intervals also count
+        /// the values out of this range.
+        std::vector< index_t > histogram;
+        double histogram_min{ 0 };
+        double histogram_max{ 1 };
+    };
+
+    /*!
+     * @brief Computes the distribution of a mesh quality without storing
+     * the cell qualities in the GeoModel.
+     *
+     * @param[in] mesh_qual_mode mesh quality to compute.
+     * @param[in] min_quality Value of quality below which a cell is counted
+     * as low quality cell.
+     * @param[in] geomodel GeoModel in which the mesh quality is computed.
+     * @param[in] nb_bins number of histogram intervals.
+     *
+     * @warning All the regions must be meshed by simplexes (tetrahedra).
+     */
+    MeshQualityStatistics geomodel_tools_api
+        compute_tet_mesh_quality_statistics( MeshQualityMode mesh_qual_mode,
+            double min_quality,
+            const GeoModel3D& geomodel,
+            index_t nb_bins = 10 );
+
+    /*!
+     * @brief Computes and stores a cell quality in the GeoModel.
+     *
+     * Unlike the MeshQualityMode metrics, these qualities are defined for
+     * all the cell types, so that hexahedral and mixed meshes can be
+     * checked. The cells are processed in parallel.
+     *
+     * @param[in] cell_qual_mode cell quality to compute.
+     * @param[in,out] geomodel GeoModel in which the cell quality is
+     * computed. The quality is stored on the cells of each Region.
+     *
+     * @warning The GeoModel must have at least one region. All the regions
+     * must be meshed.
+     */
+    void geomodel_tools_api compute_prop_cell_mesh_quality(
+        CellQualityMode cell_qual_mode, const GeoModel3D& geomodel );
+
+    /*!
+     * @brief Computes the distribution of a cell quality without storing
+     * the cell qualities in the GeoModel.
+     *
+     * The histogram covers [-1,1] for SCALED_JACOBIAN, [0,1] for
+     * EQUIANGLE_SKEWNESS and [1,10] for EDGE_ASPECT_RATIO. The cells with a
+     * null edge are counted apart for EDGE_ASPECT_RATIO.
+     *
+     * @param[in] cell_qual_mode cell quality to compute.
+     * @param[in] threshold Value of quality beyond which a cell is counted as
+     * low quality cell: below it for SCALED_JACOBIAN, above it for the other
+     * qualities.
+     * @param[in] geomodel GeoModel in which the cell quality is computed.
+     * @param[in] nb_bins number of histogram intervals.
+     *
+     * @warning All the regions must be meshed.
+     */
+    MeshQualityStatistics geomodel_tools_api
+        compute_cell_mesh_quality_statistics( CellQualityMode cell_qual_mode,
+            double threshold,
+            const GeoModel3D& geomodel,
+            index_t nb_bins = 10 );
+
     /*!
      * @brief Fill the /p output_mesh with cells of quality below \p min_quality
      * @param[in] mesh_qual_mode mesh quality of cells.
@@ -104,4 +223,30 @@ namespace RINGMesh
         double min_quality,
         const GeoModel3D& geomodel,
         VolumeMesh3D& output_mesh );
+
+    /*!
+     * @brief Improves the cells of quality below \p min_quality by local
+     * modifications of the region meshes.
+     *
+     * Each low quality cell is improved within the cells around its vertices
+     * by the first of these operations raising their minimal quality: edge
+     * removal (3-2 flip), facet removal (2-3 flip), vertex smoothing and
+     * split of its longest edge. Cells far enough apart are improved in
+     * parallel. The surfaces bounding the regions are kept unchanged.
+     *
+     * @param[in] mesh_qual_mode mesh quality to improve.
+     * @param[in] min_quality Value of quality below which a cell is improved.
+     * @param[in,out] geomodel GeoModel to improve. The modified regions lose
+     * their cell attribute values and the GeoModelMesh is cleared.
+     * @param[in] nb_passes maximal number of passes over the low quality
+     * cells of each region.
+     * @returns The number of cells still below \p min_quality
+     *
+     * @warning All the regions must be meshed by simplexes (tetrahedra).
+     */
+    index_t geomodel_tools_api improve_tet_mesh_quality(
+        MeshQualityMode mesh_qual_mode,
+        double min_quality,
+        GeoModel3D& geomodel,
+        index_t nb_passes = 3 );
 } // namespace RINGMesh
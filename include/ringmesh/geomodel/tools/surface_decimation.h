@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2012-2018, Association Scientifique pour la Geologie et ses
+ * Applications (ASGA). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of ASGA nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL ASGA BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *     http://www.ring-team.org
+ *
+ *     RING Project
+ *     Ecole Nationale Superieure de Geologie - GeoRessources
+ *     2 Rue du Doyen Marcel Roubault - TSA 70605
+ *     54518 VANDOEUVRE-LES-NANCY
+ *     FRANCE
+ */
+
+#pragma once
+
+#include <ringmesh/geomodel/tools/common.h>
+
+/*!
+ * @file ringmesh/geomodel/tools/surface_decimation.h
+ * @brief Simplification of the Surface meshes of a GeoModel.
+ */
+
+namespace RINGMesh
+{
+    FORWARD_DECLARATION_DIMENSION_CLASS( GeoModel );
+
+    ALIAS_3D( GeoModel );
+} // namespace RINGMesh
+
+namespace RINGMesh
+{
+    /*!
+     * @brief Decimates the triangulated Surfaces of a GeoModel.
+     * @details Edges are collapsed by increasing quadric error (Garland and
+     * Heckbert). The vertices on the Lines bounding each Surface, and so the
+     * Corners, are never moved nor removed: the Surfaces stay conformal with
+     * their boundaries and with each other. A collapse is rejected if the
+     * squared distances from the new vertex to the planes of the original
+     * triangles merged into it sum above max_error squared, if it changes the
+     * mesh topology, flips a triangle or creates a degenerate triangle.
+     * The Surfaces are decimated in parallel. Surfaces with non triangular
+     * polygons are left unchanged.
+     * @warning The Regions must not be meshed: a RINGMeshException is thrown
+     * otherwise.
+     * @param[in] max_error maximal distance between a decimated vertex
+     * and the original triangles it replaces.
+     * @return the number of removed triangles.
+     */
+    index_t geomodel_tools_api decimate_surfaces(
+        GeoModel3D& geomodel, double max_error );
+} // namespace RINGMesh
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2012-2018, Association Scientifique pour la Geologie et ses
+ * Applications (ASGA). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of ASGA nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL ASGA BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *     http://www.ring-team.org
+ *
+ *     RING Project
+ *     Ecole Nationale Superieure de Geologie - GeoRessources
+ *     2 Rue du Doyen Marcel Roubault - TSA 70605
+ *     54518 VANDOEUVRE-LES-NANCY
+ *     FRANCE
+ */
+
+#pragma once
+
+#include <ringmesh/io/common.h>
+
+#include <ringmesh/basic/pimpl.h>
+
+/*!
+ * @file Binary file written at explicit offsets
+ */
+
+namespace RINGMesh
+{
+    /*!
+     * @brief Binary output file written by blocks at given offsets.
+     * @details The file is created with its final size, so that several
+     * threads can encode their part of the data and write it directly at
+     * its location. Writing non overlapping ranges concurrently is safe.
+     */
+    class io_api BinaryFileWriter
+    {
+        ringmesh_disable_copy_and_move( BinaryFileWriter );
+
+    public:
+        BinaryFileWriter( const std::string& filename, std::size_t size );
+        ~BinaryFileWriter();
+
+        /*!
+         * Writes \p size bytes of \p data at position \p offset in the file
+         * @return false if the data could not be written
+         */
+        bool write_at(
+            std::size_t offset, const void* data, std::size_t size ) const;
+
+        bool write_at( std::size_t offset, const std::string& data ) const
+        {
+            return write_at( offset, data.data(), data.size() );
+        }
+
+    private:
+        IMPLEMENTATION_MEMBER( impl_ );
+    };
+
+} // namespace RINGMesh
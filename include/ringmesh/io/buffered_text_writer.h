@@ -0,0 +1,280 @@
+/*
+ * Copyright (c) 2012-2018, Association Scientifique pour la Geologie et ses
+ * Applications (ASGA). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of ASGA nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL ASGA BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *     http://www.ring-team.org
+ *
+ *     RING Project
+ *     Ecole Nationale Superieure de Geologie - GeoRessources
+ *     2 Rue du Doyen Marcel Roubault - TSA 70605
+ *     54518 VANDOEUVRE-LES-NANCY
+ *     FRANCE
+ */
+
+#pragma once
+
+#include <ringmesh/io/common.h>
+
+#include <fstream>
+#include <memory>
+
+#include <ringmesh/basic/task_handler.h>
+
+/*!
+ * @file Buffered text output with locale independent number formatting
+ */
+
+namespace RINGMesh
+{
+    /*!
+     * Formatting of floating point numbers.
+     * GENERAL, SCIENTIFIC and FIXED match the std::defaultfloat,
+     * std::scientific and std::fixed iostream formats.
+     */
+    enum struct FloatFormat
+    {
+        GENERAL,
+        SCIENTIFIC,
+        FIXED
+    };
+
+    /*!
+     * Minimal field width of the next formatted value,
+     * equivalent to std::setw
+     */
+    struct TextWidth
+    {
+        explicit TextWidth( index_t value ) : width( value ) {}
+        index_t width;
+    };
+
+    /*!
+     * @brief In-memory text buffer formatting numbers without iostreams.
+     * @details Integers are converted digit by digit, floating point
+     * numbers are printed either with a given precision (same output as
+     * an iostream with the same precision) or, when the precision is 0,
+     * with the shortest representation that reads back to the same double.
+     * In that case, the mantissa has no trailing zero in every format,
+     * e.g. 0.5 is printed 0.5, 5e-01 and 0.5.
+     * The decimal separator is always '.', whatever the current locale.
+     */
+    class io_api TextBuffer
+    {
+    public:
+        explicit TextBuffer( index_t precision = 0,
+            FloatFormat format = FloatFormat::GENERAL );
+
+        void set_precision( index_t precision )
+        {
+            precision_ = precision;
+        }
+
+        index_t precision() const
+        {
+            return precision_;
+        }
+
+        void set_float_format( FloatFormat format )
+        {
+            format_ = format;
+        }
+
+        FloatFormat float_format() const
+        {
+            return format_;
+        }
+
+        TextBuffer& operator<<( char value );
+        TextBuffer& operator<<( const char* value );
+        TextBuffer& operator<<( const std::string& value );
+        TextBuffer& operator<<( int value );
+        TextBuffer& operator<<( unsigned int value );
+        TextBuffer& operator<<( long value );
+        TextBuffer& operator<<( unsigned long value );
+        TextBuffer& operator<<( long long value );
+        TextBuffer& operator<<( unsigned long long value );
+        TextBuffer& operator<<( double value );
+        TextBuffer& operator<<( float value )
+        {
+            return operator<<( static_cast< double >( value ) );
+        }
+        TextBuffer& operator<<( const TextWidth& width )
+        {
+            width_ = width.width;
+            return *this;
+        }
+
+        template < index_t DIMENSION >
+        TextBuffer& operator<<( const vecn< DIMENSION >& value )
+        {
+            for( auto i : range( DIMENSION ) )
+            {
+                if( i != 0 )
+                {
+                    operator<<( ' ' );
+                }
+                operator<<( value[i] );
+            }
+            return *this;
+        }
+
+        const std::string& str() const
+        {
+            return buffer_;
+        }
+
+        std::size_t size() const
+        {
+            return buffer_.size();
+        }
+
+        void reserve( std::size_t size )
+        {
+            buffer_.reserve( size );
+        }
+
+        void clear()
+        {
+            buffer_.clear();
+        }
+
+    private:
+        void append( const char* value, std::size_t size );
+        void append_unsigned( unsigned long long value, bool negative );
+        void append_signed( long long value );
+        void append_fixed( double value );
+        std::size_t format_double(
+            double value, FloatFormat format, char* digits ) const;
+
+    private:
+        std::string buffer_;
+        index_t precision_;
+        FloatFormat format_;
+        index_t width_{ 0 };
+        /// Decimal separator of the C locale when the buffer was created
+        char locale_decimal_point_;
+        /// Storage of the numbers in fixed notation, up to 309 digits long
+        std::string fixed_digits_;
+    };
+
+    /*!
+     * @brief Text file writer formatting its content in a TextBuffer
+     * @details The buffer is flushed into the file every time it exceeds
+     * a given size. Large sets of items can be formatted in parallel by
+     * chunks with write_parallel(): each chunk is formatted in its own
+     * buffer and the buffers are appended in order to the file, so the
+     * output is the same as the one of a serial loop.
+     */
+    class io_api BufferedTextWriter
+    {
+        ringmesh_disable_copy_and_move( BufferedTextWriter );
+
+    public:
+        explicit BufferedTextWriter( const std::string& filename,
+            index_t precision = 0,
+            FloatFormat format = FloatFormat::GENERAL );
+
+        ~BufferedTextWriter();
+
+        template < typename T >
+        BufferedTextWriter& operator<<( const T& value )
+        {
+            buffer_ << value;
+            if( buffer_.size() >= BUFFER_SIZE )
+            {
+                flush();
+            }
+            return *this;
+        }
+
+        void set_precision( index_t precision )
+        {
+            buffer_.set_precision( precision );
+        }
+
+        void set_float_format( FloatFormat format )
+        {
+            buffer_.set_float_format( format );
+        }
+
+        /*!
+         * Formats \p nb_items items in parallel.
+         * @param[in] action callable with the signature
+         * void( TextBuffer& buffer, index_t item ) writing item \p item
+         * in \p buffer
+         */
+        template < typename ACTION >
+        void write_parallel( index_t nb_items, const ACTION& action )
+        {
+            auto nb_chunks_per_batch = nb_chunks_in_batch();
+            std::vector< std::unique_ptr< TextBuffer > > chunks(
+                nb_chunks_per_batch );
+            for( auto& chunk : chunks )
+            {
+                chunk.reset( new TextBuffer(
+                    buffer_.precision(), buffer_.float_format() ) );
+            }
+            for( index_t batch_start = 0; batch_start < nb_items;
+                 batch_start += nb_chunks_per_batch * CHUNK_SIZE )
+            {
+                auto nb_batch_items = std::min(
+                    nb_items - batch_start, nb_chunks_per_batch * CHUNK_SIZE );
+                auto nb_chunks =
+                    ( nb_batch_items + CHUNK_SIZE - 1 ) / CHUNK_SIZE;
+                parallel_for( nb_chunks, [&]( index_t chunk ) {
+                    auto& chunk_buffer = *chunks[chunk];
+                    chunk_buffer.clear();
+                    auto start = batch_start + chunk * CHUNK_SIZE;
+                    auto end = std::min( start + CHUNK_SIZE, nb_items );
+                    for( auto item : range( start, end ) )
+                    {
+                        action( chunk_buffer, item );
+                    }
+                } );
+                flush();
+                for( auto chunk : range( nb_chunks ) )
+                {
+                    write_to_file( chunks[chunk]->str() );
+                }
+            }
+        }
+
+        void flush();
+
+    private:
+        void write_to_file( const std::string& text );
+
+        /// Number of chunks formatted at once, bounding the memory used
+        /// by write_parallel()
+        static index_t nb_chunks_in_batch();
+
+    private:
+        static const std::size_t BUFFER_SIZE = 1 << 20;
+        static const index_t CHUNK_SIZE = 1 << 13;
+
+        std::ofstream file_;
+        TextBuffer buffer_;
+    };
+} // namespace RINGMesh
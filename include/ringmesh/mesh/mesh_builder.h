@@ -62,6 +62,26 @@ namespace RINGMesh
 
 namespace RINGMesh
 {
+    /*!
+     * @brief Summary of a full adjacency computation
+     * @details Counts the mesh edges (polygons) or facets (cells) by number
+     * of elements sharing them.
+     */
+    struct mesh_api AdjacencyReport
+    {
+        AdjacencyReport& operator+=( const AdjacencyReport& rhs );
+
+        /// Number of edges or facets connecting two elements
+        index_t nb_connected{ 0 };
+        /// Number of edges or facets belonging to only one element
+        index_t nb_borders{ 0 };
+        /// Number of edges or facets shared by more than two elements
+        index_t nb_non_manifold{ 0 };
+        /// Number of edges shared by two polygons traversing them in the
+        /// same direction, i.e. with incompatible orientations
+        index_t nb_inconsistent{ 0 };
+    };
+
     template < index_t DIMENSION >
     class MeshBaseBuilder
     {
@@ -634,6 +654,15 @@ namespace RINGMesh
             }
         }
 
+        /*!
+         * @brief Recomputes the adjacencies of all the polygons in one pass
+         * @details The polygon edges are sorted by vertex pair with a parallel
+         * radix sort. Edges shared by more than two polygons, or by two
+         * polygons with the same orientation, are set on the border.
+         * @return the number of edges found in each configuration
+         */
+        AdjacencyReport compute_polygon_adjacencies();
+
         void permute_polygons( const std::vector< index_t >& permutation )
         {
             do_permute_polygons( permutation );
@@ -813,6 +842,26 @@ namespace RINGMesh
             do_assign_cell_tet_mesh( tets );
             clear_cell_linked_objects();
         }
+        /*!
+         * @brief Replaces the mesh by a tetrahedral mesh given by raw arrays,
+         * copied once into the mesh storage.
+         * @param[in] points the 3 coordinates of each of the \param
+         * nb_points vertices
+         * @param[in] tets the 4 vertices of each of the \param nb_tets
+         * tetrahedra
+         * @param[in] adjacents the adjacent tetrahedron through each facet,
+         * facet f being opposite to vertex f (NO_ID on the borders).
+         * If nullptr, the adjacencies are computed.
+         */
+        void assign_tet_mesh( const double* points,
+            index_t nb_points,
+            const index_t* tets,
+            const index_t* adjacents,
+            index_t nb_tets )
+        {
+            do_assign_tet_mesh( points, nb_points, tets, adjacents, nb_tets );
+            clear_vertex_linked_objects();
+        }
         /*!
          * @brief Sets a vertex of a cell by local vertex index.
          * @param[in] cell_local_vertex index of the cell, and local index of
@@ -857,6 +906,15 @@ namespace RINGMesh
          */
         virtual void connect_cells() = 0;
 
+        /*!
+         * @brief Recomputes the adjacencies of all the cells in one pass
+         * @details The cell facets are hashed from their sorted vertices and
+         * matched after a parallel radix sort. Facets shared by more than two
+         * cells are set on the border.
+         * @return the number of facets found in each configuration
+         */
+        AdjacencyReport compute_cell_adjacencies();
+
         /*!
          * @brief Removes all the cells and attributes.
          * @param[in] keep_attributes if true, then all the existing attribute
@@ -955,6 +1013,15 @@ namespace RINGMesh
          */
         virtual void do_assign_cell_tet_mesh(
             const std::vector< index_t >& tets ) = 0;
+        /*!
+         * @brief Replaces the mesh by a tetrahedral mesh given by raw arrays
+         * @see assign_tet_mesh
+         */
+        virtual void do_assign_tet_mesh( const double* points,
+            index_t nb_points,
+            const index_t* tets,
+            const index_t* adjacents,
+            index_t nb_tets ) = 0;
         /*!
          * @brief Sets a vertex of a cell by local vertex index.
          * @param[in] cell_local_vertex index of the cell,and local index of the
@@ -87,12 +87,25 @@ namespace RINGMesh
 
         void set_regions( const std::vector< vec3 >& one_point_per_region );
 
+        /*!
+         * @brief Hands the TetGen output over to the mesh
+         * @details The kept tets and their vertices are compacted in place in
+         * the TetGen buffers, which are then copied once into the mesh
+         * with the TetGen tet adjacencies.
+         */
         void assign_result_tetmesh_to_mesh(
-            VolumeMeshBuilder< 3 >& output_mesh_builder ) const;
-        std::vector< double > get_result_tetmesh_points() const;
-        std::vector< index_t > get_result_tetmesh_tets() const;
+            VolumeMeshBuilder< 3 >& output_mesh_builder );
+        /*!
+         * Compacts the kept tets and their neighbors in place
+         * @return the number of kept tets
+         */
+        index_t compact_result_tets();
+        /*!
+         * Compacts the vertices of the \param nb_tets first tets in place
+         * @return the number of kept vertices
+         */
+        index_t compact_result_points( index_t nb_tets );
         std::set< double > determine_tet_regions_to_keep() const;
-        std::vector< index_t > determine_tets_to_keep() const;
 
     private:
         GEO_3rdParty::tetgenio tetgen_in_;
@@ -103,8 +103,11 @@ namespace RINGMesh
          * are launched in order to control the outputs
          * @param[in] refine tells whether or not there are refined options to
          * set (true by defaults)
+         * @param[in] update_geomodel_mesh if false, the GeoModelMesh is not
+         * cleared and the caller has to do it once the meshing is done
          */
-        bool tetrahedralize( bool refine = true );
+        bool tetrahedralize(
+            bool refine = true, bool update_geomodel_mesh = true );
 
     protected:
         TetraGen( GeoModel3D& geomodel, index_t region_id )
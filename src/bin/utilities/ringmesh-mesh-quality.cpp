@@ -63,11 +63,18 @@ namespace
     void import_arg_group_quality()
     {
         GEO::CmdLine::declare_arg_group( "quality", "Mesh quality" );
-        GEO::CmdLine::declare_arg( "quality:mode", 0, "Mesh quality mode" );
+        GEO::CmdLine::declare_arg( "quality:mode", 0,
+            "Mesh quality mode of the tetrahedral meshes" );
+        GEO::CmdLine::declare_arg( "quality:cell_mode", 0,
+            "Cell quality mode of the meshes with hexahedra, prisms or "
+            "pyramids" );
         GEO::CmdLine::declare_arg( "quality:min_value", 0.01,
-            "Cell quality is defined as low if below this minimum value" );
+            "Cell quality is defined as low if below this minimum value "
+            "(above it for the cell modes other than the scaled Jacobian)" );
         GEO::CmdLine::declare_arg( "quality:output", "",
             "Output filename for a mesh containing low quality tetrahedra" );
+        GEO::CmdLine::declare_arg( "quality:improve", false,
+            "Improve the tetrahedra below the minimum value before output" );
     }
 
     void import_arg_groups()
@@ -77,7 +84,13 @@ namespace
         CmdLine::import_arg_group( "out" );
     }
 
-    void check_geomodel_is_3d_meshed_by_simplexes( const GeoModel3D& geomodel )
+    bool is_cell_type_supported( CellType type )
+    {
+        return type == CellType::TETRAHEDRON || type == CellType::HEXAHEDRON
+               || type == CellType::PRISM || type == CellType::PYRAMID;
+    }
+
+    void check_geomodel_is_3d_meshed( const GeoModel3D& geomodel )
     {
         if( geomodel.nb_regions() == 0 )
         {
@@ -91,12 +104,68 @@ namespace
                 throw RINGMeshException(
                     "I/O", "Region ", region.index(), " is not meshed." );
             }
+            for( auto cell : range( region.nb_mesh_elements() ) )
+            {
+                if( !is_cell_type_supported( region.cell_type( cell ) ) )
+                {
+                    throw RINGMeshException( "I/O", "Region ", region.index(),
+                        " has cells other than tetrahedra, hexahedra, "
+                        "prisms and pyramids." );
+                }
+            }
+        }
+    }
+
+    bool is_geomodel_3d_meshed_by_simplexes( const GeoModel3D& geomodel )
+    {
+        for( const auto& region : geomodel.regions() )
+        {
             if( !region.is_simplicial() )
             {
-                throw RINGMeshException(
-                    "I/O", "Region ", region.index(), " is not simplicial." );
+                return false;
             }
         }
+        return true;
+    }
+
+    void print_statistics( const MeshQualityStatistics& statistics )
+    {
+        Logger::out( "Quality", "Cell quality quartiles: ",
+            statistics.first_quartile, " ", statistics.median, " ",
+            statistics.third_quartile );
+        Logger::out( "Quality", statistics.nb_low_quality_cells,
+            " low quality cells out of ", statistics.nb_cells );
+    }
+
+    /*!
+     * @brief Computes the cell qualities of the regions meshed by
+     * hexahedra, prisms or pyramids. The cell quality modes do not support
+     * the improvement and the output of the low quality cells.
+     */
+    void compute_cell_quality( const GeoModel3D& geomodel )
+    {
+        if( GEO::CmdLine::get_arg_bool( "quality:improve" )
+            || !GEO::CmdLine::get_arg( "quality:output" ).empty() )
+        {
+            throw RINGMeshException( "I/O",
+                "quality:improve and quality:output need tetrahedra" );
+        }
+        auto cell_mode = static_cast< CellQualityMode >(
+            GEO::CmdLine::get_arg_uint( "quality:cell_mode" ) );
+        compute_prop_cell_mesh_quality( cell_mode, geomodel );
+        print_statistics( compute_cell_mesh_quality_statistics( cell_mode,
+            GEO::CmdLine::get_arg_double( "quality:min_value" ), geomodel ) );
+    }
+
+    void save_geomodel( const GeoModel3D& geomodel )
+    {
+        auto geomodel_out_name = GEO::CmdLine::get_arg( "out:geomodel" );
+        if( geomodel_out_name.empty() )
+        {
+            throw RINGMeshException(
+                "I/O", "Give at least a filename in out:geomodel" );
+        }
+        geomodel_save( geomodel, geomodel_out_name );
     }
 
     void run()
@@ -111,11 +180,30 @@ namespace
         }
         GeoModel3D geomodel;
         geomodel_load( geomodel, geomodel_in_name );
-        check_geomodel_is_3d_meshed_by_simplexes( geomodel );
+        check_geomodel_is_3d_meshed( geomodel );
+        if( !is_geomodel_3d_meshed_by_simplexes( geomodel ) )
+        {
+            compute_cell_quality( geomodel );
+            save_geomodel( geomodel );
+            return;
+        }
 
         auto quality_mode = GEO::CmdLine::get_arg_uint( "quality:mode" );
+        if( GEO::CmdLine::get_arg_bool( "quality:improve" ) )
+        {
+            auto nb_low_quality_cells = improve_tet_mesh_quality(
+                static_cast< MeshQualityMode >( quality_mode ),
+                GEO::CmdLine::get_arg_double( "quality:min_value" ),
+                geomodel );
+            Logger::out( "Quality", "Remaining low quality cells: ",
+                nb_low_quality_cells );
+        }
         compute_prop_tet_mesh_quality(
             static_cast< MeshQualityMode >( quality_mode ), geomodel );
+        auto statistics = compute_tet_mesh_quality_statistics(
+            static_cast< MeshQualityMode >( quality_mode ),
+            GEO::CmdLine::get_arg_double( "quality:min_value" ), geomodel );
+        print_statistics( statistics );
 
         auto min_quality_out_name = GEO::CmdLine::get_arg( "quality:output" );
         if( !min_quality_out_name.empty() )
@@ -130,14 +218,7 @@ namespace
                 min_cell_quality );
             output_mesh->save_mesh( min_quality_out_name );
         }
-
-        auto geomodel_out_name = GEO::CmdLine::get_arg( "out:geomodel" );
-        if( geomodel_out_name.empty() )
-        {
-            throw RINGMeshException(
-                "I/O", "Give at least a filename in out:geomodel" );
-        }
-        geomodel_save( geomodel, geomodel_out_name );
+        save_geomodel( geomodel );
     }
 } // namespace
 
@@ -64,6 +64,8 @@ namespace
             "repair", "GeoModel repair processes" );
         GEO::CmdLine::declare_arg( "repair:mode", 0,
             "Repair mode: repair process to apply to the geomodel" );
+        GEO::CmdLine::declare_arg( "repair:dry_run", false,
+            "Only report what the repair would change" );
     }
 
     void import_arg_groups()
@@ -80,6 +82,12 @@ namespace
         geomodel_load( geomodel, in_model_file_name );
 
         index_t repair_mode = GEO::CmdLine::get_arg_uint( "repair:mode" );
+        if( GEO::CmdLine::get_arg_bool( "repair:dry_run" ) )
+        {
+            dry_run_repair_geomodel(
+                geomodel, static_cast< RepairMode >( repair_mode ) );
+            return;
+        }
         repair_geomodel( geomodel, static_cast< RepairMode >( repair_mode ) );
 
         std::string out_model_file_name =
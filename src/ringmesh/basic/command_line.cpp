@@ -55,6 +55,10 @@ namespace RINGMesh
                 GEO::CmdLine::ARG_ADVANCED );
             GEO::CmdLine::declare_arg( "algo:tet", "TetGen",
                 "Toggles the tetrahedral mesher (TetGen, MG_Tetra)" );
+            GEO::CmdLine::declare_arg( "algo:tet_budget", 0,
+                "Maximal number of boundary triangles and internal points "
+                "of the regions meshed concurrently (0 for no limit)",
+                GEO::CmdLine::ARG_ADVANCED );
             GEO::CmdLine::declare_arg( "sys:plugins", "",
                 "List of the plugins to load, separated by ;" );
         }
@@ -75,6 +79,26 @@ namespace RINGMesh
                 "out:geomodel", "", "Saves the geological model" );
         }
 
+        void import_arg_group_io()
+        {
+            GEO::CmdLine::declare_arg_group( "io", "Input/Output options" );
+            GEO::CmdLine::declare_arg( "io:compression", true,
+                "Compresses the binary data blocks of the output files "
+                "when the format supports it (vtu, resqml)" );
+            GEO::CmdLine::declare_arg( "io:compression_level", 6,
+                "Deflate level, from 1 to 9, of the compressed data "
+                "blocks (resqml)" );
+            GEO::CmdLine::declare_arg( "io:binary", false,
+                "Writes the binary variant of the formats having both "
+                "an ASCII and a binary version (msh, stl)" );
+            GEO::CmdLine::declare_arg( "io:entities", "",
+                "Indices of the surfaces (stl) or lines (svg) to export, "
+                "separated by commas. All of them are exported if empty" );
+            GEO::CmdLine::declare_arg( "io:tolerance", 0.,
+                "Maximal distance between the exported and the input "
+                "lines when simplifying them (svg)" );
+        }
+
         void import_arg_group_validity()
         {
             GEO::CmdLine::declare_arg_group( "validity", "Validity checks" );
@@ -122,6 +146,10 @@ namespace RINGMesh
             {
                 import_arg_group_out();
             }
+            else if( name == "io" )
+            {
+                import_arg_group_io();
+            }
             else if( name == "validity" )
             {
                 import_arg_group_validity();
@@ -68,6 +68,7 @@ namespace
     void configure_ringmesh()
     {
         RINGMesh::CmdLine::import_arg_group( "global" );
+        RINGMesh::CmdLine::import_arg_group( "io" );
         RINGMesh::CmdLine::import_arg_group( "validity" );
     }
 
@@ -40,6 +40,7 @@
 #include <ringmesh/basic/algorithm.h>
 #include <ringmesh/basic/geometry.h>
 #include <ringmesh/basic/pimpl_impl.h>
+#include <ringmesh/basic/task_handler.h>
 #include <ringmesh/geomodel/builder/geomodel_builder_geometry.h>
 #include <ringmesh/geomodel/builder/geomodel_builder_remove.h>
 #include <ringmesh/geomodel/core/geomodel.h>
@@ -214,9 +215,13 @@ namespace
             const GeoModel< DIMENSION >& geomodel )
             : geomodel_( geomodel )
         {
+            // The vertex maps are built before the tasks read them
             const auto& geomodel_vertices = geomodel_.mesh.vertices;
-            for( const auto& surface : geomodel_.surfaces() )
-            {
+            geomodel_vertices.nb();
+            std::vector< std::vector< BorderPolygon > > surface_borders(
+                geomodel_.nb_surfaces() );
+            parallel_for( geomodel_.nb_surfaces(), [&]( index_t s ) {
+                const auto& surface = geomodel_.surface( s );
                 const auto& mesh = surface.mesh();
                 auto S_id = surface.gmme();
                 for( auto p : range( surface.nb_mesh_elements() ) )
@@ -231,13 +236,36 @@ namespace
                             auto next_vertex =
                                 geomodel_vertices.geomodel_vertex_id( S_id,
                                     mesh.next_polygon_vertex( { p, v } ) );
-                            border_polygons_.emplace_back(
-                                surface.index(), p, vertex, next_vertex );
+                            surface_borders[s].emplace_back(
+                                s, p, vertex, next_vertex );
                         }
                     }
                 }
+            } );
+
+            // The stable sort on the edge keeps the (surface, polygon) order
+            // in which the borders were gathered
+            std::vector< BorderPolygon > borders;
+            std::vector< std::pair< std::uint64_t, index_t > > keys;
+            for( const auto& surface_border : surface_borders )
+            {
+                for( const auto& border : surface_border )
+                {
+                    keys.emplace_back(
+                        ( static_cast< std::uint64_t >(
+                              std::min( border.v0, border.v1 ) )
+                            << 32 )
+                            | std::max( border.v0, border.v1 ),
+                        static_cast< index_t >( borders.size() ) );
+                    borders.push_back( border );
+                }
+            }
+            parallel_radix_sort( keys );
+            border_polygons_.reserve( borders.size() );
+            for( const auto& key : keys )
+            {
+                border_polygons_.push_back( borders[key.second] );
             }
-            std::sort( border_polygons_.begin(), border_polygons_.end() );
         }
         ~CommonDataFromGeoModelSurfaces() = default;
 
@@ -582,338 +610,374 @@ namespace
     /*!
      * @brief Determines the geometry of the Lines of a GeoModel in which
      * the geometry of the Surfaces is given
-     * @details All the polygons on the boundaries are classified as belonging
-     * to a Line< DIMENSION >
-     * Two neighboring edges on the boundary belong to the same Line< DIMENSION
-     * > if their incident Surfaces
-     * are the same.
+     * @details The unique edges on the boundaries of the Surfaces form a
+     * graph. A vertex of this graph is a corner when it does not have exactly
+     * two incident edges, when its two edges are not incident to the same
+     * Surfaces, or when another Surface touches it.
+     * Each Line< DIMENSION > is then a chain of edges between two corners or
+     * a cycle of edges without any corner. The chains are walked in parallel
+     * and the Lines are given in the order of their smallest edge.
      */
     template < index_t DIMENSION >
     class LineGeometryFromGeoModelSurfaces
         : public CommonDataFromGeoModelSurfaces< DIMENSION >
     {
+        /*!
+         * @brief Vertices of a chain of border edges
+         */
+        struct EdgeChain
+        {
+            std::vector< index_t > vertices_;
+            index_t first_edge_{ NO_ID };
+            index_t last_edge_{ NO_ID };
+            /// Smallest edge of the chain and its position in the chain
+            index_t min_edge_{ NO_ID };
+            index_t min_edge_position_{ NO_ID };
+        };
+
     public:
         /*!
          * @param geomodel GeoModel providing the Surfaces
-         * @param collect_region_info If true, information needed to determine
-         * closed Regions
-         *  from a GeoModel Surfaces are collected for each Line< DIMENSION >.
          */
         explicit LineGeometryFromGeoModelSurfaces(
             const GeoModel< DIMENSION >& geomodel )
-            : CommonDataFromGeoModelSurfaces< DIMENSION >( geomodel ),
-              cur_border_polygon_( 0 )
+            : CommonDataFromGeoModelSurfaces< DIMENSION >( geomodel )
         {
-            visited_.resize( this->border_polygons_.size(), false );
-            const auto& geomodel_vertices = this->geomodel_.mesh.vertices;
-            surfaces_around_vertices_.resize( geomodel_vertices.nb() );
-            for( const auto& border : this->border_polygons_ )
-            {
-                fill_surfaces_around_vertex( border.v0 );
-                fill_surfaces_around_vertex( border.v1 );
-            }
+            compute_border_edges();
+            compute_vertex_edges();
+            compute_corners();
+            compute_lines();
         }
 
         /*!
-         * @brief Tries to compute a new line and returns true if one was.
+         * @brief Goes to the next line and returns true if there is one.
          * @details To use in a while conditional loop, since the number of
          * lines
          * is considered unknown.
          */
         bool compute_next_line_geometry()
         {
-            for( ; cur_border_polygon_ < this->border_polygons_.size();
-                 cur_border_polygon_++ )
+            if( next_line_ == lines_.size() )
             {
-                if( is_visited( cur_border_polygon_ ) )
-                {
-                    continue;
-                }
-                cur_line_.clear();
-                compute_line_geometry();
-                return true;
+                return false;
             }
-            return false;
+            cur_line_ = next_line_++;
+            return true;
         }
 
         LineDefinition& current_line()
         {
-            return cur_line_;
+            return lines_[cur_line_];
         }
 
     private:
-        void fill_surfaces_around_vertex( index_t vertex )
+        /*!
+         * @brief Groups the BorderPolygons sharing the same edge
+         */
+        void compute_border_edges()
         {
-            auto& surfaces = surfaces_around_vertices_[vertex];
-            if( !surfaces.empty() )
+            for( auto b : range( this->border_polygons_.size() ) )
             {
-                return;
-            }
-            auto gme_vertices = this->geomodel_.mesh.vertices.gme_type_vertices(
-                surface_type_name_static(), vertex );
-            for( const auto& gme_vertex : gme_vertices )
-            {
-                surfaces.push_back( gme_vertex.gmme.index() );
+                if( b == 0
+                    || !this->have_border_polygons_same_boundary_edge(
+                           b - 1, b ) )
+                {
+                    edge_borders_.push_back( b );
+                }
             }
+            edge_borders_.push_back(
+                static_cast< index_t >( this->border_polygons_.size() ) );
         }
 
-        void compute_line_geometry()
-        {
-            visit_border_polygons_on_same_edge( cur_border_polygon_ );
-            auto p0 = this->border_polygons_[cur_border_polygon_].v0;
-            auto p1 = this->border_polygons_[cur_border_polygon_].v1;
-            cur_line_.vertices_.push_back( p0 );
-            cur_line_.vertices_.push_back( p1 );
-
-            cur_line_.adjacent_surfaces_ =
-                get_adjacent_surfaces( cur_border_polygon_ );
-
-            bool backward{ false };
-            get_one_line_vertices( backward );
-            backward = true;
-            get_one_line_vertices( backward );
-        }
         /*!
-         * @brief Gets the geometry of a line propagating in a given direction
-         * @details As long as the adjacent surfaces are the same, the vertices
-         * are added
-         * belong to the line under construction
+         * @brief Stores the edges incident to each vertex
          */
-        void get_one_line_vertices( bool backward )
+        void compute_vertex_edges()
         {
-            ringmesh_assert(
-                cur_border_polygon_ < this->border_polygons_.size() );
-            ringmesh_assert( cur_border_polygon_ != NO_ID );
-
-            auto t = get_next_border_polygon( cur_border_polygon_, backward );
-            ringmesh_assert( t != NO_ID );
-            while( propagate( t, backward ) )
+            vertex_edges_ptr_.resize( this->geomodel_.mesh.vertices.nb() + 1,
+                0 );
+            for( auto e : range( nb_edges() ) )
+            {
+                vertex_edges_ptr_[edge_vertex( e, 0 ) + 1]++;
+                vertex_edges_ptr_[edge_vertex( e, 1 ) + 1]++;
+            }
+            for( auto v : range( 1, vertex_edges_ptr_.size() ) )
             {
-                visit_border_polygons_on_same_edge( t );
-                add_border_polygon_vertices_to_line( t, backward );
-                t = get_next_border_polygon( t, backward );
-                ringmesh_assert( t != NO_ID );
+                vertex_edges_ptr_[v] += vertex_edges_ptr_[v - 1];
+            }
+            vertex_edges_.resize( vertex_edges_ptr_.back() );
+            auto position = vertex_edges_ptr_;
+            for( auto e : range( nb_edges() ) )
+            {
+                vertex_edges_[position[edge_vertex( e, 0 )]++] = e;
+                vertex_edges_[position[edge_vertex( e, 1 )]++] = e;
             }
         }
 
-        bool propagate( index_t t, bool backward ) const
+        void compute_corners()
         {
-            return t != cur_border_polygon_ && !is_visited( t )
-                   && equal_to_line_adjacent_surfaces( t )
-                   && !vertex_is_on_corner( t, backward );
+            const auto& geomodel_vertices = this->geomodel_.mesh.vertices;
+            is_corner_.resize( geomodel_vertices.nb(), 0 );
+            parallel_for( geomodel_vertices.nb(), [&]( index_t v ) {
+                auto nb_incident_edges = nb_vertex_edges( v );
+                if( nb_incident_edges == 0 )
+                {
+                    return;
+                }
+                if( nb_incident_edges != 2 )
+                {
+                    is_corner_[v] = 1;
+                    return;
+                }
+                auto edge = vertex_edge( v, 0 );
+                if( !have_edges_same_surfaces( edge, vertex_edge( v, 1 ) ) )
+                {
+                    is_corner_[v] = 1;
+                    return;
+                }
+                auto gme_vertices = geomodel_vertices.gme_type_vertices(
+                    surface_type_name_static(), v );
+                for( const auto& gme_vertex : gme_vertices )
+                {
+                    if( !is_edge_on_surface( edge, gme_vertex.gmme.index() ) )
+                    {
+                        is_corner_[v] = 1;
+                        return;
+                    }
+                }
+            } );
         }
 
-        bool is_visited( index_t i ) const
+        void compute_lines()
         {
-            return visited_[i];
+            // Each chain between corners is walked from both its ends,
+            // only one of the two walks is kept
+            std::vector< std::pair< index_t, index_t > > chain_starts;
+            for( auto v : range( is_corner_.size() ) )
+            {
+                if( is_corner_[v] )
+                {
+                    for( auto i : range( nb_vertex_edges( v ) ) )
+                    {
+                        chain_starts.emplace_back( v, vertex_edge( v, i ) );
+                    }
+                }
+            }
+            std::vector< EdgeChain > walks( chain_starts.size() );
+            auto nb_walks = static_cast< index_t >( chain_starts.size() );
+            parallel_for( nb_walks, [&]( index_t i ) {
+                walks[i] =
+                    walk_chain( chain_starts[i].first, chain_starts[i].second );
+            } );
+
+            std::vector< EdgeChain > chains;
+            std::vector< bool > edge_in_chain( nb_edges(), false );
+            for( auto& walk : walks )
+            {
+                if( walk.first_edge_ < walk.last_edge_
+                    || ( walk.first_edge_ == walk.last_edge_
+                           && walk.vertices_.front()
+                                  < walk.vertices_.back() ) )
+                {
+                    chain_walk_edges( walk, edge_in_chain );
+                    chains.push_back( std::move( walk ) );
+                }
+            }
+            // The remaining edges are on cycles without corner
+            for( auto e : range( nb_edges() ) )
+            {
+                if( !edge_in_chain[e] )
+                {
+                    auto cycle = walk_chain( edge_vertex( e, 0 ), e );
+                    chain_walk_edges( cycle, edge_in_chain );
+                    orient_cycle( cycle );
+                    chains.push_back( std::move( cycle ) );
+                }
+            }
+
+            std::sort( chains.begin(), chains.end(),
+                []( const EdgeChain& lhs, const EdgeChain& rhs ) {
+                    return lhs.min_edge_ < rhs.min_edge_;
+                } );
+            lines_.resize( chains.size() );
+            parallel_for( static_cast< index_t >( chains.size() ),
+                [&]( index_t l ) { fill_line( chains[l], lines_[l] ); } );
         }
 
-        bool vertex_is_on_corner( index_t t, bool backward ) const
+        /*!
+         * @brief Walks the edges from a vertex until a corner is reached or
+         * the first edge is met again
+         */
+        EdgeChain walk_chain( index_t start_vertex, index_t start_edge ) const
         {
-            const auto& surfaces = [t, backward, this] {
-                if( backward )
+            EdgeChain chain;
+            chain.first_edge_ = start_edge;
+            chain.vertices_.push_back( start_vertex );
+            auto vertex = start_vertex;
+            auto edge = start_edge;
+            while( true )
+            {
+                if( edge < chain.min_edge_ )
                 {
-                    return surfaces_around_vertices_[this->border_polygons_[t]
-                                                         .v1];
+                    chain.min_edge_ = edge;
+                    chain.min_edge_position_ =
+                        static_cast< index_t >( chain.vertices_.size() - 1 );
                 }
-                else
+                chain.last_edge_ = edge;
+                vertex = other_edge_vertex( edge, vertex );
+                chain.vertices_.push_back( vertex );
+                if( is_corner_[vertex] )
                 {
-                    return surfaces_around_vertices_[this->border_polygons_[t]
-                                                         .v0];
+                    break;
                 }
-            }();
-            for( auto surface : surfaces )
-            {
-                if( !contains( cur_line_.adjacent_surfaces_, surface ) )
+                auto edge0 = vertex_edge( vertex, 0 );
+                edge = edge0 == edge ? vertex_edge( vertex, 1 ) : edge0;
+                if( edge == start_edge )
                 {
-                    return true;
+                    break;
                 }
             }
-            return false;
+            return chain;
         }
 
-        bool equal_to_line_adjacent_surfaces( index_t t ) const
+        void chain_walk_edges(
+            const EdgeChain& chain, std::vector< bool >& edge_in_chain ) const
         {
-            auto input = get_adjacent_surfaces( t );
-            if( input.size() != cur_line_.adjacent_surfaces_.size() )
+            for( auto i : range( chain.vertices_.size() - 1 ) )
             {
-                return false;
+                edge_in_chain[find_edge(
+                    chain.vertices_[i], chain.vertices_[i + 1] )] = true;
             }
-            return std::equal( input.begin(), input.end(),
-                cur_line_.adjacent_surfaces_.begin() );
         }
 
-        void add_border_polygon_vertices_to_line(
-            index_t polygon_index, bool backward )
+        /*!
+         * @brief Makes a cycle start at the first vertex of its smallest edge
+         * @note A closed line has front()==back().
+         */
+        void orient_cycle( EdgeChain& cycle ) const
         {
-            const auto& border_polygon = this->border_polygons_[polygon_index];
-            add_vertices_to_line(
-                border_polygon.v0, border_polygon.v1, !backward );
+            auto& vertices = cycle.vertices_;
+            vertices.pop_back();
+            std::rotate( vertices.begin(),
+                vertices.begin() + cycle.min_edge_position_, vertices.end() );
+            vertices.push_back( vertices.front() );
+            cycle.min_edge_position_ = 0;
         }
 
-        void add_vertices_to_line( index_t v0, index_t v1, bool at_the_end )
+        /*!
+         * @brief Orients the chain as the first BorderPolygon on its smallest
+         * edge and copies it in a LineDefinition
+         */
+        void fill_line( EdgeChain& chain, LineDefinition& line ) const
         {
-            auto to_add = v1;
-            if( at_the_end )
+            auto& vertices = chain.vertices_;
+            const auto& border =
+                this->border_polygons_[edge_borders_[chain.min_edge_]];
+            if( vertices[chain.min_edge_position_] != border.v0 )
             {
-                auto end_vertex = cur_line_.vertices_.back();
-                if( v1 == end_vertex )
-                {
-                    to_add = v0;
-                }
-                else
-                {
-                    ringmesh_assert( v0 == end_vertex );
-                }
-                cur_line_.vertices_.push_back( to_add );
+                std::reverse( vertices.begin(), vertices.end() );
             }
-            else
+            line.vertices_ = std::move( vertices );
+            for( auto b : range( edge_borders_[chain.min_edge_],
+                     edge_borders_[chain.min_edge_ + 1] ) )
             {
-                auto first_vertex = cur_line_.vertices_.front();
-                if( v1 == first_vertex )
-                {
-                    to_add = v0;
-                }
-                else
-                {
-                    ringmesh_assert( v0 == first_vertex );
-                }
-                cur_line_.vertices_.insert(
-                    cur_line_.vertices_.begin(), to_add );
+                line.adjacent_surfaces_.push_back(
+                    this->border_polygons_[b].surface );
             }
         }
 
-        /*!
-         * @brief Gets the next BorderPolygon in the same surface
-         */
-        index_t get_next_border_polygon( index_t from, bool backward ) const
+        index_t nb_edges() const
         {
-            const auto& border_polygon = this->border_polygons_[from];
-            const auto& S = this->geomodel_.surface( border_polygon.surface );
-            const auto& mesh = S.mesh();
-            auto surface_id = S.gmme();
-            const auto& geomodel_vertices = this->geomodel_.mesh.vertices;
+            return static_cast< index_t >( edge_borders_.size() - 1 );
+        }
 
-            // Gets the next edge on border in the Surface
-            auto p = border_polygon.polygon;
-            auto possible_v0_id = geomodel_vertices.mesh_entity_vertex_id(
-                surface_id, border_polygon.v0 );
-            ringmesh_assert( !possible_v0_id.empty() );
-            index_t v0_id{ NO_ID };
-            for( auto id : possible_v0_id )
+        index_t edge_vertex( index_t edge, index_t v ) const
+        {
+            const auto& border = this->border_polygons_[edge_borders_[edge]];
+            return v == 0 ? border.v0 : border.v1;
+        }
+
+        index_t other_edge_vertex( index_t edge, index_t vertex ) const
+        {
+            auto v0 = edge_vertex( edge, 0 );
+            return v0 == vertex ? edge_vertex( edge, 1 ) : v0;
+        }
+
+        index_t nb_vertex_edges( index_t vertex ) const
+        {
+            return vertex_edges_ptr_[vertex + 1] - vertex_edges_ptr_[vertex];
+        }
+
+        index_t vertex_edge( index_t vertex, index_t i ) const
+        {
+            return vertex_edges_[vertex_edges_ptr_[vertex] + i];
+        }
+
+        index_t find_edge( index_t v0, index_t v1 ) const
+        {
+            for( auto i : range( nb_vertex_edges( v0 ) ) )
             {
-                if( mesh.vertex_index_in_polygon( p, id ) != NO_ID )
+                auto edge = vertex_edge( v0, i );
+                if( other_edge_vertex( edge, v0 ) == v1 )
                 {
-                    v0_id = id;
+                    return edge;
                 }
             }
-            ringmesh_assert( v0_id != NO_ID );
-            auto v0_id_in_polygon = mesh.vertex_index_in_polygon( p, v0_id );
-            ringmesh_assert( v0_id_in_polygon != NO_ID );
-
-            const PolygonLocalEdge cur_polygon_local_edge{ p,
-                v0_id_in_polygon };
-            PolygonLocalEdge next_polygon_local_edge0_on_border =
-                backward ? mesh.prev_on_border( cur_polygon_local_edge )
-                         : mesh.next_on_border( cur_polygon_local_edge );
-            ringmesh_assert(
-                next_polygon_local_edge0_on_border.polygon_id != NO_ID );
-            ringmesh_assert(
-                next_polygon_local_edge0_on_border.local_edge_id != NO_ID );
-
-            PolygonLocalEdge next_polygon_local_edge1_on_border =
-                mesh.next_polygon_vertex( next_polygon_local_edge0_on_border );
-            ringmesh_assert(
-                next_polygon_local_edge1_on_border.polygon_id != NO_ID );
-            ringmesh_assert(
-                next_polygon_local_edge1_on_border.local_edge_id != NO_ID );
-
-            // Finds the BorderPolygon that is corresponding to this
-            // It must exist and there is only one
-            BorderPolygon bait{ border_polygon.surface,
-                next_polygon_local_edge0_on_border.polygon_id,
-                geomodel_vertices.geomodel_vertex_id(
-                    surface_id, next_polygon_local_edge0_on_border ),
-                geomodel_vertices.geomodel_vertex_id(
-                    surface_id, next_polygon_local_edge1_on_border ) };
-            auto result = find_sorted( this->border_polygons_, bait );
-
-            ringmesh_assert( result != NO_ID );
-            ringmesh_assert( this->border_polygons_[result].same_edge( bait ) );
-            return result;
+            ringmesh_assert_not_reached;
+            return NO_ID;
         }
 
         /*!
-         * @brief Marks as visited all BorderPolygons whose first edge is equal
-         * to i's first edge
+         * @brief Compares the sorted Surfaces incident to two edges
+         * @note When the surface appears twice (the line is an internal border)
+         * both occurrences are compared.
          */
-        void visit_border_polygons_on_same_edge( index_t border_id )
-        {
-            visited_[border_id] = true;
-            for( auto next_border_id = border_id + 1;
-                 next_border_id < this->border_polygons_.size()
-                 && this->have_border_polygons_same_boundary_edge(
-                        border_id, next_border_id );
-                 next_border_id++ )
+        bool have_edges_same_surfaces( index_t edge0, index_t edge1 ) const
+        {
+            auto nb_surfaces = edge_borders_[edge0 + 1] - edge_borders_[edge0];
+            if( nb_surfaces != edge_borders_[edge1 + 1] - edge_borders_[edge1] )
             {
-                visited_[next_border_id] = true;
+                return false;
             }
-            for( auto prev_border_id = border_id - 1;
-                 prev_border_id != NO_ID
-                 && this->have_border_polygons_same_boundary_edge(
-                        border_id, prev_border_id );
-                 prev_border_id-- )
+            for( auto i : range( nb_surfaces ) )
             {
-                visited_[prev_border_id] = true;
+                if( this->border_polygons_[edge_borders_[edge0] + i].surface
+                    != this->border_polygons_[edge_borders_[edge1] + i]
+                           .surface )
+                {
+                    return false;
+                }
             }
+            return true;
         }
 
-        /*!
-         * @brief Gets the sorted indices of the Surfaces incident to the first
-         * edge of the i-th BorderPolygon
-         * @note When the surface appears twice (the line is an internal border)
-         * both occurrences are kept.
-         */
-        std::vector< index_t > get_adjacent_surfaces( index_t border_id ) const
-        {
-            std::vector< index_t > adjacent_surfaces;
-            adjacent_surfaces.reserve( 10 );
-            adjacent_surfaces.push_back(
-                this->border_polygons_[border_id].surface );
-
-            for( auto next_border_id = border_id + 1;
-                 next_border_id < this->border_polygons_.size()
-                 && this->have_border_polygons_same_boundary_edge(
-                        border_id, next_border_id );
-                 next_border_id++ )
-            {
-                adjacent_surfaces.push_back(
-                    this->border_polygons_[next_border_id].surface );
-            }
-
-            for( auto prev_border_id = border_id - 1;
-                 prev_border_id != NO_ID
-                 && this->have_border_polygons_same_boundary_edge(
-                        border_id, prev_border_id );
-                 prev_border_id-- )
+        bool is_edge_on_surface( index_t edge, index_t surface ) const
+        {
+            for( auto b :
+                range( edge_borders_[edge], edge_borders_[edge + 1] ) )
             {
-                adjacent_surfaces.push_back(
-                    this->border_polygons_[prev_border_id].surface );
+                if( this->border_polygons_[b].surface == surface )
+                {
+                    return true;
+                }
             }
-            std::sort( adjacent_surfaces.begin(), adjacent_surfaces.end() );
-            return adjacent_surfaces;
+            return false;
         }
 
     private:
-        /// Flag the visited border_polygons when computing the Lines
-        std::vector< bool > visited_;
+        /// First BorderPolygon of each unique border edge
+        std::vector< index_t > edge_borders_;
+
+        /// Edges incident to each vertex, vertex_edges_ptr_[v] is the first
+        std::vector< index_t > vertex_edges_ptr_;
+        std::vector< index_t > vertex_edges_;
 
-        /// Surfaces around vertices (only filled for boundary vertices)
-        std::vector< std::vector< index_t > > surfaces_around_vertices_;
+        /// Flag the corner vertices, one char per vertex for parallel writes
+        std::vector< char > is_corner_;
 
-        /// Currently computed line information
-        index_t cur_border_polygon_;
-        LineDefinition cur_line_;
+        std::vector< LineDefinition > lines_;
+        index_t next_line_{ 0 };
+        index_t cur_line_{ NO_ID };
     };
 
     double compute_angle_at_corner(
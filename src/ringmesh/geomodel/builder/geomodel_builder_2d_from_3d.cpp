@@ -33,12 +33,19 @@
  *     FRANCE
  */
 
+#include <array>
+#include <unordered_map>
+
 #include <ringmesh/basic/geometry.h>
+#include <ringmesh/basic/nn_search.h>
+#include <ringmesh/basic/task_handler.h>
 #include <ringmesh/geomodel/builder/geomodel_builder_2d_from_3d.h>
 #include <ringmesh/geomodel/core/geomodel.h>
 #include <ringmesh/geomodel/core/geomodel_api.h>
+#include <ringmesh/geomodel/core/geomodel_geological_entity.h>
 #include <ringmesh/geomodel/core/geomodel_mesh_entity.h>
 #include <ringmesh/mesh/mesh_index.h>
+#include <ringmesh/mesh/surface_mesh.h>
 
 namespace
 {
@@ -59,6 +66,384 @@ namespace
     {
         return map.find( key )->second;
     }
+
+    using SectionPanel = GeoModelBuilder2DCrossSection::SectionPanel;
+
+    /*!
+     * @brief Identifies a section point inside a Surface
+     * @details A point is either on a mesh edge (packed sorted vertex pair,
+     * NO_ID), on a mesh vertex (vertex packed twice, NO_ID) or on a polygon
+     * at the junction between two curtain panels (polygon, junction index).
+     */
+    using SectionPointKey = std::pair< std::uint64_t, index_t >;
+
+    std::uint64_t edge_point_key( index_t v0, index_t v1 )
+    {
+        return ( static_cast< std::uint64_t >( v0 ) << 32 ) | v1;
+    }
+
+    /*!
+     * @brief Key of a point on a mesh vertex, it differs from all the edge
+     * keys since the two vertices of an edge are different
+     */
+    std::uint64_t vertex_point_key( index_t v )
+    {
+        return edge_point_key( v, v );
+    }
+
+    struct SectionPointKeyHash
+    {
+        std::size_t operator()( const SectionPointKey& key ) const
+        {
+            return std::hash< std::uint64_t >()(
+                key.first * 0x9E3779B97F4A7C15ULL + key.second );
+        }
+    };
+
+    struct SectionPoint
+    {
+        SectionPointKey key;
+        vec2 coords;
+    };
+
+    using SectionSegment = std::array< SectionPoint, 2 >;
+
+    struct SectionPolyline
+    {
+        std::vector< vec2 > points;
+        bool closed{ false };
+    };
+
+    /*!
+     * @brief Conservative test between a box and a panel, enlarged by
+     * epsilon so that the polygons touching the panel are not missed
+     */
+    bool box_may_cut_panel(
+        const Box3D& box, const SectionPanel& panel, double epsilon )
+    {
+        auto half_diagonal = 0.5 * box.diagonal();
+        double plane_radius{ epsilon };
+        double u_radius{ epsilon };
+        for( auto i : range( 3 ) )
+        {
+            plane_radius +=
+                std::fabs( panel.plane.normal[i] ) * half_diagonal[i];
+            u_radius += std::fabs( panel.u_axis[i] ) * half_diagonal[i];
+        }
+        auto to_center = box.center() - panel.plane.origin;
+        auto u = dot( to_center, panel.u_axis );
+        return std::fabs( dot( to_center, panel.plane.normal ) )
+                   <= plane_radius
+               && u + u_radius >= panel.u_min && u - u_radius <= panel.u_max;
+    }
+
+    /*!
+     * @brief Moves a segment end along the segment to the given u
+     */
+    void clip_segment_end( SectionSegment& segment,
+        index_t end,
+        double u,
+        const SectionPointKey& key )
+    {
+        const auto& p0 = segment[0].coords;
+        const auto& p1 = segment[1].coords;
+        auto lambda = ( u - p0.x ) / ( p1.x - p0.x );
+        segment[end].coords = vec2{ u, p0.y + lambda * ( p1.y - p0.y ) };
+        segment[end].key = key;
+    }
+
+    void add_panel_segment( SectionSegment segment,
+        index_t polygon,
+        const SectionPanel& panel,
+        index_t panel_id,
+        std::vector< SectionSegment >& segments )
+    {
+        if( segment[0].coords.x > segment[1].coords.x )
+        {
+            std::swap( segment[0], segment[1] );
+        }
+        if( segment[1].coords.x < panel.u_min
+            || segment[0].coords.x > panel.u_max )
+        {
+            return;
+        }
+        // A segment only touching a junction belongs to the other panel
+        if( segment[0].coords.x < segment[1].coords.x
+            && ( segment[1].coords.x == panel.u_min
+                   || segment[0].coords.x == panel.u_max ) )
+        {
+            return;
+        }
+        // Panel i starts at junction i and ends at junction i + 1
+        if( segment[0].coords.x < panel.u_min )
+        {
+            clip_segment_end( segment, 0, panel.u_min, { polygon, panel_id } );
+        }
+        if( segment[1].coords.x > panel.u_max )
+        {
+            clip_segment_end(
+                segment, 1, panel.u_max, { polygon, panel_id + 1 } );
+        }
+        for( auto& end : segment )
+        {
+            end.coords.x += panel.abscissa;
+        }
+        segments.push_back( segment );
+    }
+
+    /*!
+     * @brief Signed distance from a point to the plane of a panel, the
+     * points closer than epsilon to the plane are on it
+     */
+    double distance_to_panel(
+        const vec3& point, const SectionPanel& panel, double epsilon )
+    {
+        auto distance = dot( point - panel.plane.origin, panel.plane.normal );
+        return std::fabs( distance ) > epsilon ? distance : 0.;
+    }
+
+    /*!
+     * @brief Cuts a polygon by the plane of a panel
+     * @details The vertices closer than epsilon to the plane are on it,
+     * they are considered above it and are kept as cut points keyed by
+     * their vertex, so that all the polygons around them get the same
+     * point. The other cut points are computed from the smallest edge
+     * vertex, so that the polygons sharing an edge get the same point.
+     * The segments reduced to one vertex, where the polygon only touches
+     * the plane, are dropped.
+     */
+    void cut_polygon( const SurfaceMesh3D& mesh,
+        index_t polygon,
+        const SectionPanel& panel,
+        index_t panel_id,
+        double epsilon,
+        std::vector< SectionSegment >& segments )
+    {
+        const auto& origin = panel.plane.origin;
+        const auto& normal = panel.plane.normal;
+        std::vector< std::pair< vec3, std::uint64_t > > cut_points;
+        for( auto v : range( mesh.nb_polygon_vertices( polygon ) ) )
+        {
+            auto v0 = mesh.polygon_vertex( { polygon, v } );
+            auto v1 = mesh.polygon_vertex(
+                mesh.next_polygon_vertex( { polygon, v } ) );
+            if( v1 < v0 )
+            {
+                std::swap( v0, v1 );
+            }
+            const auto& p0 = mesh.vertex( v0 );
+            const auto& p1 = mesh.vertex( v1 );
+            auto d0 = distance_to_panel( p0, panel, epsilon );
+            auto d1 = distance_to_panel( p1, panel, epsilon );
+            if( ( d0 < 0 ) == ( d1 < 0 ) )
+            {
+                continue;
+            }
+            if( d0 == 0 )
+            {
+                cut_points.emplace_back( p0, vertex_point_key( v0 ) );
+            }
+            else if( d1 == 0 )
+            {
+                cut_points.emplace_back( p1, vertex_point_key( v1 ) );
+            }
+            else
+            {
+                cut_points.emplace_back(
+                    p0 + ( d0 / ( d0 - d1 ) ) * ( p1 - p0 ),
+                    edge_point_key( v0, v1 ) );
+            }
+        }
+        if( cut_points.size() > 2 )
+        {
+            // Non-convex polygon: the points are paired along the cut line
+            auto direction = cross( normal, mesh.polygon_normal( polygon ) );
+            std::sort( cut_points.begin(), cut_points.end(),
+                [&direction]( const std::pair< vec3, std::uint64_t >& lhs,
+                    const std::pair< vec3, std::uint64_t >& rhs ) {
+                    return dot( lhs.first, direction )
+                           < dot( rhs.first, direction );
+                } );
+        }
+        for( index_t p = 0; p + 1 < cut_points.size(); p += 2 )
+        {
+            if( cut_points[p].second == cut_points[p + 1].second )
+            {
+                continue;
+            }
+            SectionSegment segment;
+            for( auto end : range( 2 ) )
+            {
+                auto to_point = cut_points[p + end].first - origin;
+                segment[end].key = { cut_points[p + end].second, NO_ID };
+                segment[end].coords = vec2{ dot( to_point, panel.u_axis ),
+                    dot( to_point, panel.v_axis ) };
+            }
+            add_panel_segment( segment, polygon, panel, panel_id, segments );
+        }
+    }
+
+    /*!
+     * @brief Removes the points closer than epsilon to the previous one,
+     * the polyline ends are kept
+     */
+    void remove_colocated_points(
+        std::vector< vec2 >& points, double epsilon )
+    {
+        auto epsilon_sq = epsilon * epsilon;
+        index_t nb_kept{ 1 };
+        for( auto p : range( 1, points.size() ) )
+        {
+            if( ( points[p] - points[nb_kept - 1] ).length2() > epsilon_sq )
+            {
+                points[nb_kept++] = points[p];
+            }
+            else if( p == points.size() - 1 && nb_kept > 1 )
+            {
+                points[nb_kept - 1] = points[p];
+            }
+        }
+        points.resize( nb_kept );
+    }
+
+    /*!
+     * @brief Stitches the segments sharing their end points into polylines
+     * @details A polyline stops at the points that are not shared by
+     * exactly two segments. The polylines without such point are closed.
+     */
+    std::vector< SectionPolyline > stitch_segments(
+        const std::vector< SectionSegment >& segments, double epsilon )
+    {
+        std::unordered_map< SectionPointKey, std::vector< index_t >,
+            SectionPointKeyHash >
+            point_segment_ends;
+        for( auto s : range( segments.size() ) )
+        {
+            for( auto end : range( 2 ) )
+            {
+                point_segment_ends[segments[s][end].key].push_back(
+                    2 * s + end );
+            }
+        }
+        auto other_segment_end = [&segments, &point_segment_ends](
+                                     index_t segment_end ) {
+            const auto& key = segments[segment_end / 2][segment_end % 2].key;
+            const auto& ends = point_segment_ends.find( key )->second;
+            if( ends.size() != 2 )
+            {
+                return NO_ID;
+            }
+            return ends[0] == segment_end ? ends[1] : ends[0];
+        };
+
+        std::vector< bool > visited( segments.size(), false );
+        std::vector< SectionPolyline > polylines;
+        auto walk = [&]( index_t start_end ) {
+            SectionPolyline polyline;
+            auto& points = polyline.points;
+            points.push_back( segments[start_end / 2][start_end % 2].coords );
+            auto segment_end = start_end;
+            while( segment_end != NO_ID && !visited[segment_end / 2] )
+            {
+                visited[segment_end / 2] = true;
+                auto out_end = segment_end ^ 1;
+                points.push_back( segments[out_end / 2][out_end % 2].coords );
+                segment_end = other_segment_end( out_end );
+            }
+            remove_colocated_points( points, epsilon );
+            polyline.closed = segment_end == start_end;
+            if( polyline.closed && points.size() > 2 )
+            {
+                points.back() = points.front();
+            }
+            if( points.size() > 1 )
+            {
+                polylines.push_back( std::move( polyline ) );
+            }
+        };
+        for( auto segment_end : range( 2 * segments.size() ) )
+        {
+            if( !visited[segment_end / 2]
+                && other_segment_end( segment_end ) == NO_ID )
+            {
+                walk( segment_end );
+            }
+        }
+        for( auto s : range( segments.size() ) )
+        {
+            if( !visited[s] )
+            {
+                walk( 2 * s );
+            }
+        }
+        return polylines;
+    }
+
+    SectionPanel plane_panel( const Geometry::Plane& plane )
+    {
+        PlaneReferenceFrame3D plane_frame( plane );
+        return { plane, plane_frame[0], plane_frame[1], -max_float64(),
+            max_float64(), 0. };
+    }
+
+    /*!
+     * @brief Builds one vertical panel per curtain segment, the segments
+     * of null length are skipped
+     */
+    std::vector< SectionPanel > curtain_panels(
+        const std::vector< vec2 >& curtain )
+    {
+        std::vector< SectionPanel > panels;
+        double abscissa{ 0 };
+        for( index_t p = 0; p + 1 < curtain.size(); p++ )
+        {
+            auto direction = curtain[p + 1] - curtain[p];
+            auto length = direction.length();
+            if( length == 0 )
+            {
+                continue;
+            }
+            vec3 u_axis{ direction.x / length, direction.y / length, 0 };
+            vec3 v_axis{ 0, 0, 1 };
+            Geometry::Plane plane{ cross( u_axis, v_axis ),
+                { curtain[p].x, curtain[p].y, 0 } };
+            panels.push_back(
+                { plane, u_axis, v_axis, 0., length, abscissa } );
+            abscissa += length;
+        }
+        if( panels.empty() )
+        {
+            throw RINGMeshException( "GeoModel",
+                "A curtain needs two distinct points to define a section" );
+        }
+        return panels;
+    }
+
+    std::vector< SectionPolyline > cut_surface( const Surface3D& surface,
+        const std::vector< SectionPanel >& panels,
+        double epsilon )
+    {
+        std::vector< SectionSegment > segments;
+        if( surface.nb_mesh_elements() == 0 )
+        {
+            return {};
+        }
+        const auto& mesh = surface.mesh();
+        for( auto panel_id : range( panels.size() ) )
+        {
+            const auto& panel = panels[panel_id];
+            auto box_test = [&panel, epsilon]( const Box3D& box ) {
+                return box_may_cut_panel( box, panel, epsilon );
+            };
+            auto action = [&]( index_t polygon ) {
+                cut_polygon(
+                    mesh, polygon, panel, panel_id, epsilon, segments );
+            };
+            surface.polygon_aabb().compute_element_bbox_intersections(
+                box_test, action );
+        }
+        return stitch_segments( segments, epsilon );
+    }
 } // namespace
 
 namespace RINGMesh
@@ -209,4 +594,141 @@ namespace RINGMesh
         }
         return projected_vertices;
     }
+
+    GeoModelBuilder2DCrossSection::GeoModelBuilder2DCrossSection(
+        GeoModel2D& geomodel2d,
+        const GeoModel3D& geomodel3d_from,
+        const Geometry::Plane& plane )
+        : GeoModelBuilder2DCrossSection(
+              geomodel2d, geomodel3d_from, { plane_panel( plane ) } )
+    {
+    }
+
+    GeoModelBuilder2DCrossSection::GeoModelBuilder2DCrossSection(
+        GeoModel2D& geomodel2d,
+        const GeoModel3D& geomodel3d_from,
+        const std::vector< vec2 >& curtain )
+        : GeoModelBuilder2DCrossSection(
+              geomodel2d, geomodel3d_from, curtain_panels( curtain ) )
+    {
+    }
+
+    GeoModelBuilder2DCrossSection::GeoModelBuilder2DCrossSection(
+        GeoModel2D& geomodel2d,
+        const GeoModel3D& geomodel3d_from,
+        std::vector< SectionPanel > panels )
+        : GeoModelBuilder2DFrom3D(
+              geomodel2d, geomodel3d_from, panels.front().plane ),
+          panels_( std::move( panels ) )
+    {
+        info.set_geomodel_name( geomodel3d_from_.name() + "_section" );
+    }
+
+    void GeoModelBuilder2DCrossSection::build_geomodel()
+    {
+        build_section_corners_and_lines();
+        build_surfaces_from_corners_and_lines();
+        print_geomodel( geomodel_ );
+    }
+
+    void GeoModelBuilder2DCrossSection::build_section_corners_and_lines()
+    {
+        // The lazy AABB trees and epsilon are built before the parallel cuts
+        auto epsilon = geomodel3d_from_.epsilon();
+        for( const auto& surface : geomodel3d_from_.surfaces() )
+        {
+            if( surface.nb_mesh_elements() > 0 )
+            {
+                surface.polygon_aabb();
+            }
+        }
+        std::vector< std::vector< SectionPolyline > > surface_polylines(
+            geomodel3d_from_.nb_surfaces() );
+        parallel_for( geomodel3d_from_.nb_surfaces(), [&]( index_t s ) {
+            surface_polylines[s] = cut_surface(
+                geomodel3d_from_.surface( s ), panels_, epsilon );
+        } );
+
+        std::vector< const SectionPolyline* > polylines;
+        std::vector< index_t > line_surfaces;
+        std::vector< vec2 > line_ends;
+        for( auto s : range( surface_polylines.size() ) )
+        {
+            for( const auto& polyline : surface_polylines[s] )
+            {
+                polylines.push_back( &polyline );
+                line_surfaces.push_back( s );
+                line_ends.push_back( polyline.points.front() );
+                line_ends.push_back( polyline.points.back() );
+            }
+        }
+        if( polylines.empty() )
+        {
+            return;
+        }
+
+        // The Line ends at the same place share a Corner
+        NNSearch2D line_ends_search( line_ends, false );
+        std::vector< index_t > end_to_corner;
+        std::vector< vec2 > corners;
+        std::tie( std::ignore, end_to_corner, corners ) =
+            line_ends_search.get_colocated_index_mapping_and_unique_points(
+                geomodel3d_from_.epsilon() );
+        auto nb_corners = static_cast< index_t >( corners.size() );
+        topology.create_mesh_entities( corner_type_name_static(), nb_corners );
+        for( auto c : range( nb_corners ) )
+        {
+            geometry.set_corner( c, corners[c] );
+        }
+
+        auto nb_lines = static_cast< index_t >( polylines.size() );
+        topology.create_mesh_entities( line_type_name_static(), nb_lines );
+        for( auto l : range( nb_lines ) )
+        {
+            auto first_corner = end_to_corner[2 * l];
+            auto second_corner = end_to_corner[2 * l + 1];
+            auto vertices = polylines[l]->points;
+            vertices.front() = corners[first_corner];
+            vertices.back() = corners[second_corner];
+            geometry.set_line( l, vertices );
+            topology.add_line_corner_boundary_relation( l, first_corner );
+            topology.add_line_corner_boundary_relation( l, second_corner );
+        }
+        copy_geomodel_3d_interfaces( line_surfaces );
+    }
+
+    void GeoModelBuilder2DCrossSection::copy_geomodel_3d_interfaces(
+        const std::vector< index_t >& line_surfaces )
+    {
+        const auto& interface_type = Interface3D::type_name_static();
+        // Either all the Lines have an Interface2D or none
+        for( auto s : line_surfaces )
+        {
+            if( !geomodel3d_from_.surface( s ).has_parent( interface_type ) )
+            {
+                return;
+            }
+        }
+        std::map< index_t, index_t > interfaces_3d_to_2d;
+        for( auto l : range( line_surfaces.size() ) )
+        {
+            const auto& surface = geomodel3d_from_.surface( line_surfaces[l] );
+            auto parent = surface.parent_gmge( interface_type );
+            auto interface_2d = interfaces_3d_to_2d.find( parent.index() );
+            if( interface_2d == interfaces_3d_to_2d.end() )
+            {
+                auto interface_id = geology.create_geological_entity(
+                    Interface2D::type_name_static() );
+                info.set_geological_entity_name( interface_id,
+                    geomodel3d_from_.geological_entity( parent ).name() );
+                interface_2d = interfaces_3d_to_2d
+                                   .emplace( parent.index(),
+                                       interface_id.index() )
+                                   .first;
+            }
+            geology.add_parent_children_relation(
+                { Interface2D::type_name_static(), interface_2d->second },
+                { line_type_name_static(), l } );
+        }
+    }
 } // namespace RINGMesh
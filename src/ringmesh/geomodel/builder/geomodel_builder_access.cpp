@@ -113,7 +113,8 @@ namespace RINGMesh
     GeoModelMeshEntity< DIMENSION >&
         GeoModelAccess< DIMENSION >::modifiable_mesh_entity( const gmme_id& id )
     {
-        return *modifiable_mesh_entities( id.type() )[id.index()];
+        return const_cast< GeoModelMeshEntity< DIMENSION >& >(
+            geomodel_.mesh_entity( id ) );
     }
 
     template < index_t DIMENSION >
@@ -139,7 +140,8 @@ namespace RINGMesh
         GeoModelAccess< DIMENSION >::modifiable_geological_entity(
             const gmge_id& id )
     {
-        return *modifiable_geological_entities( id.type() )[id.index()];
+        return const_cast< GeoModelGeologicalEntity< DIMENSION >& >(
+            geomodel_.geological_entity( id ) );
     }
 
     template < index_t DIMENSION >
@@ -148,6 +150,26 @@ namespace RINGMesh
         return geomodel_.epsilon_;
     }
 
+    template < index_t DIMENSION >
+    void GeoModelAccess< DIMENSION >::notify_mesh_entity_change(
+        const gmme_id& id )
+    {
+        geomodel_.notify_mesh_entity_change( id );
+    }
+
+    template < index_t DIMENSION >
+    void GeoModelAccess< DIMENSION >::notify_geological_entity_change(
+        const gmge_id& id )
+    {
+        geomodel_.notify_geological_entity_change( id );
+    }
+
+    template < index_t DIMENSION >
+    void GeoModelAccess< DIMENSION >::notify_geomodel_change()
+    {
+        geomodel_.notify_geomodel_change();
+    }
+
     template class geomodel_builder_api GeoModelMeshEntityAccess< 2 >;
     template class geomodel_builder_api GeoModelGeologicalEntityAccess< 2 >;
     template class geomodel_builder_api GeoModelAccess< 2 >;
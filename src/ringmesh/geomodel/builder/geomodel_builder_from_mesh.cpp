@@ -33,9 +33,12 @@
  *     FRANCE
  */
 
-#include <stack>
+#include <atomic>
 
 #include <geogram/mesh/mesh.h>
+
+#include <ringmesh/basic/algorithm.h>
+#include <ringmesh/basic/task_handler.h>
 #include <ringmesh/geomodel/builder/geomodel_builder_from_mesh.h>
 #include <ringmesh/geomodel/core/entity_type.h>
 #include <ringmesh/geomodel/core/geomodel_mesh_entity.h>
@@ -46,72 +49,176 @@
  * @author Jeanne Pellerin
  */
 
-namespace RINGMesh
+namespace
 {
-    void GeoModelBuilderSurfaceMesh::
-        build_polygonal_surfaces_from_connected_components()
-    {
-        std::vector< index_t > global_vertex_id_to_id_in_cc(
-            mesh_.vertices.nb(), NO_ID );
+    using namespace RINGMesh;
 
-        std::vector< bool > visited( mesh_.facets.nb(), false );
-        for( auto i : range( mesh_.facets.nb() ) )
+    /*!
+     * @brief Disjoint sets of elements that can be merged concurrently
+     * @details A root is always linked under a smaller root with a
+     * compare-and-swap, so each set is rooted at its smallest element.
+     */
+    class ConcurrentUnionFind
+    {
+    public:
+        explicit ConcurrentUnionFind( index_t nb_elements )
+            : parents_( nb_elements )
         {
-            if( !visited[i] )
+            for( auto i : range( nb_elements ) )
             {
-                std::vector< index_t > cc_corners;
-                std::vector< index_t > cc_facets_ptr;
-                std::vector< vec3 > cc_vertices;
-
-                /// @todo Review : This should not be necessary as each vertex
-                /// should
-                /// be in one and only one connected component. To test. [JP]
-                std::fill( global_vertex_id_to_id_in_cc.begin(),
-                    global_vertex_id_to_id_in_cc.end(), NO_ID );
+                parents_[i].store( i, std::memory_order_relaxed );
+            }
+        }
 
-                // First facet begin at corner 0
-                cc_facets_ptr.push_back( 0 );
+        index_t find( index_t element )
+        {
+            auto parent = parents_[element].load();
+            while( parent != element )
+            {
+                // Path halving: the element is linked to its grandparent
+                auto grand_parent = parents_[parent].load();
+                parents_[element].compare_exchange_weak( parent, grand_parent );
+                element = grand_parent;
+                parent = parents_[element].load();
+            }
+            return element;
+        }
 
-                // Propagate from facet #i
-                std::stack< index_t > S;
-                S.push( i );
-                while( !S.empty() )
+        void merge( index_t element0, index_t element1 )
+        {
+            while( true )
+            {
+                auto root0 = find( element0 );
+                auto root1 = find( element1 );
+                if( root0 == root1 )
+                {
+                    return;
+                }
+                if( root0 < root1 )
+                {
+                    std::swap( root0, root1 );
+                }
+                if( parents_[root0].compare_exchange_strong( root0, root1 ) )
                 {
-                    index_t f{ S.top() };
-                    S.pop();
-                    visited[f] = true;
+                    return;
+                }
+            }
+        }
 
-                    for( auto c : range( mesh_.facets.corners_begin( f ),
-                             mesh_.facets.corners_end( f ) ) )
-                    {
-                        index_t v{ mesh_.facet_corners.vertex( c ) };
-                        if( global_vertex_id_to_id_in_cc[v] == NO_ID )
-                        {
-                            index_t index{ static_cast< index_t >(
-                                cc_vertices.size() ) };
-                            global_vertex_id_to_id_in_cc[v] = index;
-                            cc_vertices.push_back( mesh_.vertices.point( v ) );
-                        }
-                        cc_corners.push_back( global_vertex_id_to_id_in_cc[v] );
+    private:
+        std::vector< std::atomic< index_t > > parents_;
+    };
+
+    /*!
+     * @brief Renumbers the vertices of the given facets from 0
+     * @details The vertices are ordered as in the input mesh.
+     */
+    void get_connected_component_geometry( const GEO::Mesh& mesh,
+        const index_t* facets,
+        index_t nb_facets,
+        std::vector< vec3 >& cc_vertices,
+        std::vector< index_t >& cc_corners,
+        std::vector< index_t >& cc_facets_ptr )
+    {
+        std::vector< index_t > cc_mesh_vertices;
+        cc_facets_ptr.reserve( nb_facets + 1 );
+        cc_facets_ptr.push_back( 0 );
+        for( auto f : range( nb_facets ) )
+        {
+            for( auto c : range( mesh.facets.corners_begin( facets[f] ),
+                     mesh.facets.corners_end( facets[f] ) ) )
+            {
+                cc_mesh_vertices.push_back( mesh.facet_corners.vertex( c ) );
+            }
+            cc_facets_ptr.push_back(
+                static_cast< index_t >( cc_mesh_vertices.size() ) );
+        }
+        cc_corners.reserve( cc_mesh_vertices.size() );
+        auto sorted_vertices = cc_mesh_vertices;
+        sort_unique( sorted_vertices );
+        for( auto v : cc_mesh_vertices )
+        {
+            cc_corners.push_back( find_sorted( sorted_vertices, v ) );
+        }
+        cc_vertices.reserve( sorted_vertices.size() );
+        for( auto v : sorted_vertices )
+        {
+            cc_vertices.push_back( mesh.vertices.point( v ) );
+        }
+    }
+} // namespace
 
-                        index_t n{ mesh_.facet_corners.adjacent_facet( c ) };
-                        if( n != NO_ID && !visited[n] )
-                        {
-                            visited[n] = true;
-                            S.push( n );
-                        }
-                    }
-                    index_t nb_cc_corners{ static_cast< index_t >(
-                        cc_corners.size() ) };
-                    cc_facets_ptr.push_back( nb_cc_corners );
+namespace RINGMesh
+{
+    void GeoModelBuilderSurfaceMesh::
+        build_polygonal_surfaces_from_connected_components()
+    {
+        // Each facet is labelled by the smallest facet of its component
+        auto nb_facets = mesh_.facets.nb();
+        ConcurrentUnionFind components( nb_facets );
+        parallel_for( nb_facets, [this, &components]( index_t f ) {
+            for( auto c : range( mesh_.facets.corners_begin( f ),
+                     mesh_.facets.corners_end( f ) ) )
+            {
+                index_t n{ mesh_.facet_corners.adjacent_facet( c ) };
+                if( n != NO_ID && n < f )
+                {
+                    components.merge( f, n );
                 }
+            }
+        } );
+        std::vector< index_t > facet_roots( nb_facets );
+        parallel_for( nb_facets, [&facet_roots, &components]( index_t f ) {
+            facet_roots[f] = components.find( f );
+        } );
 
-                gmme_id surface_gme{ topology.create_mesh_entity(
-                    Surface3D::type_name_static() ) };
-                geometry.set_surface_geometry( surface_gme.index(), cc_vertices,
-                    cc_corners, cc_facets_ptr );
+        // Counting sort of the facets by component, the components are
+        // ordered by their smallest facet
+        std::vector< index_t > root_to_component( nb_facets, NO_ID );
+        std::vector< index_t > component_facets_ptr( 1, 0 );
+        for( auto f : range( nb_facets ) )
+        {
+            if( facet_roots[f] == f )
+            {
+                root_to_component[f] =
+                    static_cast< index_t >( component_facets_ptr.size() - 1 );
+                component_facets_ptr.push_back( 0 );
             }
+            component_facets_ptr[root_to_component[facet_roots[f]] + 1]++;
+        }
+        auto nb_components =
+            static_cast< index_t >( component_facets_ptr.size() - 1 );
+        for( auto cc : range( nb_components ) )
+        {
+            component_facets_ptr[cc + 1] += component_facets_ptr[cc];
+        }
+        std::vector< index_t > component_facets( nb_facets );
+        auto position = component_facets_ptr;
+        for( auto f : range( nb_facets ) )
+        {
+            component_facets[position[root_to_component[facet_roots[f]]]++] =
+                f;
+        }
+
+        // The Surfaces are created first, then filled concurrently
+        std::vector< index_t > surfaces( nb_components );
+        for( auto cc : range( nb_components ) )
+        {
+            surfaces[cc] =
+                topology.create_mesh_entity( Surface3D::type_name_static() )
+                    .index();
         }
+        parallel_for( nb_components, [&]( index_t cc ) {
+            std::vector< vec3 > cc_vertices;
+            std::vector< index_t > cc_corners;
+            std::vector< index_t > cc_facets_ptr;
+            get_connected_component_geometry( mesh_,
+                &component_facets[component_facets_ptr[cc]],
+                component_facets_ptr[cc + 1] - component_facets_ptr[cc],
+                cc_vertices, cc_corners, cc_facets_ptr );
+            geometry.set_surface_geometry(
+                surfaces[cc], cc_vertices, cc_corners, cc_facets_ptr );
+        } );
     }
 
 } // namespace RINGMesh
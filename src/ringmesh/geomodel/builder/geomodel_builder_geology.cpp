@@ -176,6 +176,7 @@ namespace RINGMesh
         const GeologicalEntityType& type, index_t nb_additional_entities )
     {
         find_or_create_geological_entity_type( type );
+        geomodel_access_.notify_geomodel_change();
         auto& store = geomodel_access_.modifiable_geological_entities( type );
         auto old_size = static_cast< index_t >( store.size() );
         auto new_size = old_size + nb_additional_entities;
@@ -231,6 +232,7 @@ namespace RINGMesh
     {
         /// No check on the validity of the index of the entity parents_
         /// NO_ID is used to flag entities to delete
+        geomodel_access_.notify_mesh_entity_change( child_gmme );
         auto& mesh_entity =
             geomodel_access_.modifiable_mesh_entity( child_gmme );
         ringmesh_assert( id < mesh_entity.nb_parents() );
@@ -243,6 +245,8 @@ namespace RINGMesh
             relationship_id, parent_gmge );
         if( update_parent )
         {
+            geomodel_access_.notify_geological_entity_change( parent_gmge );
+            geomodel_access_.notify_geological_entity_change( old_parent_gmge );
             update_parent_entity_children(
                 relationship_id, parent_gmge, old_parent_gmge );
         }
@@ -279,6 +283,8 @@ namespace RINGMesh
             }
         }
 
+        geomodel_access_.notify_geological_entity_change( parent );
+        geomodel_access_.notify_mesh_entity_change( children );
         auto& children_entity =
             geomodel_access_.modifiable_mesh_entity( children );
         const auto& children_type =
@@ -320,6 +326,8 @@ namespace RINGMesh
                 "No parent children relation found between ", parent, " and ",
                 children );
         }
+        geomodel_access_.notify_geological_entity_change( parent );
+        geomodel_access_.notify_mesh_entity_change( children );
         GeoModelGeologicalEntityAccess< DIMENSION > parent_access{
             geomodel_access_.modifiable_geological_entity( parent )
         };
@@ -344,6 +352,7 @@ namespace RINGMesh
     {
         /// No check on the validity of the index of the entity child_index
         /// NO_ID is used to flag entities to delete
+        geomodel_access_.notify_geological_entity_change( parent_gmge );
         auto& geol_entity =
             geomodel_access_.modifiable_geological_entity( parent_gmge );
         const auto& child_type =
@@ -362,6 +371,7 @@ namespace RINGMesh
     void GeoModelBuilderGeology< DIMENSION >::delete_geological_entity(
         const GeologicalEntityType& type, index_t index )
     {
+        geomodel_access_.notify_geomodel_change();
         geomodel_access_.modifiable_geological_entities( type )[index].reset();
     }
 
@@ -372,6 +382,7 @@ namespace RINGMesh
         auto index = find_or_create_geological_entity_type( type );
         auto id =
             static_cast< index_t >( geomodel_.nb_geological_entities( type ) );
+        geomodel_access_.notify_geomodel_change();
         geomodel_access_.modifiable_geological_entities()[index].emplace_back(
             GeoModelGeologicalEntityAccess<
                 DIMENSION >::create_geological_entity( type, geomodel_, id ) );
@@ -402,6 +413,7 @@ namespace RINGMesh
         ringmesh_assert(
             GeoModelGeologicalEntityFactory< DIMENSION >::has_creator( type ) );
 
+        geomodel_access_.notify_geomodel_change();
         geomodel_access_.modifiable_entity_type_manager()
             .geological_entity_manager.geological_entity_types_.push_back(
                 type );
@@ -495,6 +507,7 @@ namespace RINGMesh
             typename GeoModelGeologicalEntity< DIMENSION >::GEOL_FEATURE
                 geol_feature )
     {
+        geomodel_access_.notify_geological_entity_change( gmge_id );
         GeoModelGeologicalEntityAccess< DIMENSION > gmge_access{
             geomodel_access_.modifiable_geological_entity( gmge_id )
         };
@@ -36,6 +36,7 @@
 #include <geogram/basic/attributes.h>
 
 #include <ringmesh/basic/geometry.h>
+#include <ringmesh/basic/task_handler.h>
 #include <ringmesh/geomodel/builder/geomodel_builder.h>
 #include <ringmesh/geomodel/builder/geomodel_builder_geometry.h>
 #include <ringmesh/geomodel/core/geomodel.h>
@@ -163,15 +164,22 @@ namespace
         return std::make_tuple( result, cell, cell_facet );
     }
 
+    /*!
+     * Finds a polygon vertex colocated with a given point
+     * @param[out] element_id the polygon index
+     * @param[out] local_vertex_id the index of the vertex in the polygon
+     * @return True if a polygon vertex is found
+     */
     template < index_t DIMENSION >
-    bool find_polygon_from_vertex( const Surface< DIMENSION >& surface,
+    bool find_polygon_local_vertex_from_vertex(
+        const Surface< DIMENSION >& surface,
         const vecn< DIMENSION >& v,
         index_t& element_id,
-        index_t& vertex_id )
+        index_t& local_vertex_id )
     {
         bool result{ false };
         surface.polygon_nn_search().get_neighbors( v, [&surface, &v, &result,
-                                                          &vertex_id,
+                                                          &local_vertex_id,
                                                           &element_id](
                                                           index_t i ) {
             for( auto j : range( surface.nb_mesh_element_vertices( i ) ) )
@@ -179,7 +187,7 @@ namespace
                 if( inexact_equal( surface.mesh_element_vertex( { i, j } ), v,
                         surface.geomodel().epsilon() ) )
                 {
-                    vertex_id = surface.mesh_element_vertex_index( { i, j } );
+                    local_vertex_id = j;
                     element_id = i;
                     result = true;
                     break;
@@ -243,6 +251,108 @@ namespace
         return NO_ID;
     }
 
+    /*!
+     * Finds, for each edge of a Line, the matching polygon edge of a Surface
+     */
+    template < index_t DIMENSION >
+    std::vector< PolygonLocalEdge > find_line_polygon_edges(
+        const Surface< DIMENSION >& surface, const Line< DIMENSION >& line )
+    {
+        std::vector< PolygonLocalEdge > polygon_edges;
+        polygon_edges.reserve( line.nb_mesh_elements() );
+        for( auto i : range( line.nb_mesh_elements() ) )
+        {
+            bool found{ false };
+            index_t p{ NO_ID };
+            index_t e{ NO_ID };
+            std::tie( found, p, e ) = find_polygon_from_edge_vertices(
+                surface, line.vertex( i ), line.vertex( i + 1 ) );
+            ringmesh_unused( found );
+            ringmesh_assert( found && p != NO_ID && e != NO_ID );
+            polygon_edges.emplace_back( p, e );
+        }
+        return polygon_edges;
+    }
+
+    /*!
+     * Finds, for each vertex of a Line, a colocated polygon vertex of a
+     * Surface
+     */
+    template < index_t DIMENSION >
+    std::vector< ElementLocalVertex > find_line_polygon_vertices(
+        const Surface< DIMENSION >& surface, const Line< DIMENSION >& line )
+    {
+        std::vector< ElementLocalVertex > polygon_vertices(
+            line.nb_vertices() );
+        for( auto v : range( line.nb_vertices() ) )
+        {
+            auto& polygon_vertex = polygon_vertices[v];
+            bool found{ find_polygon_local_vertex_from_vertex( surface,
+                line.vertex( v ), polygon_vertex.element_id,
+                polygon_vertex.local_vertex_id ) };
+            ringmesh_unused( found );
+            ringmesh_assert( found && polygon_vertex.element_id != NO_ID
+                             && polygon_vertex.local_vertex_id != NO_ID );
+        }
+        return polygon_vertices;
+    }
+
+    /*!
+     * Finds, for each polygon of a Surface, the matching cell facet of a
+     * Region
+     */
+    template < index_t DIMENSION >
+    std::vector< CellLocalFacet > find_surface_cell_facets(
+        const Region< DIMENSION >& region, const Surface< DIMENSION >& surface )
+    {
+        std::vector< CellLocalFacet > cell_facets;
+        cell_facets.reserve( surface.nb_mesh_elements() );
+        for( auto polygon : range( surface.nb_mesh_elements() ) )
+        {
+            bool found{ false };
+            index_t cell{ NO_ID };
+            index_t cell_facet{ NO_ID };
+            std::tie( found, cell, cell_facet ) =
+                find_cell_facet_from_polygon( region, surface, polygon );
+            ringmesh_unused( found );
+            ringmesh_assert( found && cell != NO_ID && cell_facet != NO_ID );
+            cell_facets.emplace_back( cell, cell_facet );
+        }
+        return cell_facets;
+    }
+
+    /*!
+     * Finds, for each vertex of a Surface, a colocated cell vertex of a
+     * Region
+     */
+    template < index_t DIMENSION >
+    std::vector< ElementLocalVertex > find_surface_cell_vertices(
+        const Region< DIMENSION >& region, const Surface< DIMENSION >& surface )
+    {
+        std::vector< ElementLocalVertex > cell_vertices(
+            surface.nb_vertices() );
+        for( auto v : range( surface.nb_vertices() ) )
+        {
+            auto element_local_vertex =
+                region.find_cell_from_colocated_vertex_if_any(
+                    surface.vertex( v ) );
+            auto cell = element_local_vertex.element_id;
+            ringmesh_assert( cell != NO_ID );
+            for( auto cell_vertex :
+                range( region.nb_mesh_element_vertices( cell ) ) )
+            {
+                if( region.mesh_element_vertex_index( { cell, cell_vertex } )
+                    == element_local_vertex.local_vertex_id )
+                {
+                    cell_vertices[v] = { cell, cell_vertex };
+                    break;
+                }
+            }
+            ringmesh_assert( cell_vertices[v].local_vertex_id != NO_ID );
+        }
+        return cell_vertices;
+    }
+
     template < index_t DIMENSION >
     void check_and_initialize_corner_vertex(
         GeoModel< DIMENSION >& geomodel, index_t corner_id )
@@ -279,6 +389,7 @@ namespace RINGMesh
             index_t corner_id )
     {
         gmme_id id{ corner_type_name_static(), corner_id };
+        geomodel_access_.notify_mesh_entity_change( id );
         auto& corner = geomodel_access_.modifiable_mesh_entity( id );
         GeoModelMeshEntityAccess< DIMENSION > corner_access( corner );
         auto& corner_mesh = dynamic_cast< PointSetMesh< DIMENSION >& >(
@@ -292,6 +403,7 @@ namespace RINGMesh
             index_t line_id )
     {
         gmme_id id{ line_type_name_static(), line_id };
+        geomodel_access_.notify_mesh_entity_change( id );
         auto& line = geomodel_access_.modifiable_mesh_entity( id );
         GeoModelMeshEntityAccess< DIMENSION > line_access( line );
         auto& line_mesh = dynamic_cast< LineMesh< DIMENSION >& >(
@@ -305,6 +417,7 @@ namespace RINGMesh
             index_t surface_id )
     {
         gmme_id id{ surface_type_name_static(), surface_id };
+        geomodel_access_.notify_mesh_entity_change( id );
         auto& surface = geomodel_access_.modifiable_mesh_entity( id );
         GeoModelMeshEntityAccess< DIMENSION > surface_access( surface );
         auto& surface_mesh = dynamic_cast< SurfaceMesh< DIMENSION >& >(
@@ -328,6 +441,7 @@ namespace RINGMesh
         const vecn< DIMENSION >& point,
         bool update )
     {
+        geomodel_access_.notify_mesh_entity_change( entity_id );
         auto& E = geomodel_access_.modifiable_mesh_entity( entity_id );
         ringmesh_assert( v < E.nb_vertices() );
         if( update )
@@ -379,6 +493,7 @@ namespace RINGMesh
         const std::vector< vecn< DIMENSION > >& points,
         bool clear )
     {
+        geomodel_access_.notify_mesh_entity_change( entity_id );
         auto& E = geomodel_access_.modifiable_mesh_entity( entity_id );
         GeoModelMeshEntityAccess< DIMENSION > gmme_access( E );
         auto builder = MeshBaseBuilder< DIMENSION >::create_builder(
@@ -404,6 +519,7 @@ namespace RINGMesh
         GeoModelBuilderGeometryBase< DIMENSION >::create_mesh_entity_vertices(
             const gmme_id& entity_id, index_t nb_vertices )
     {
+        geomodel_access_.notify_mesh_entity_change( entity_id );
         auto& E = geomodel_access_.modifiable_mesh_entity( entity_id );
         GeoModelMeshEntityAccess< DIMENSION > gmme_access( E );
         auto builder = MeshBaseBuilder< DIMENSION >::create_builder(
@@ -417,6 +533,7 @@ namespace RINGMesh
         const std::vector< index_t >& geomodel_vertices,
         bool clear )
     {
+        geomodel_access_.notify_mesh_entity_change( entity_id );
         auto& E = geomodel_access_.modifiable_mesh_entity( entity_id );
         GeoModelMeshEntityAccess< DIMENSION > gmme_access( E );
         auto builder = MeshBaseBuilder< DIMENSION >::create_builder(
@@ -452,9 +569,7 @@ namespace RINGMesh
         set_mesh_entity_vertices(
             { line_type_name_static(), line_id }, vertices, true );
 
-        auto& line = dynamic_cast< Line< DIMENSION >& >(
-            geomodel_access_.modifiable_mesh_entity(
-                { line_type_name_static(), line_id } ) );
+        const auto& line = geomodel_.line( line_id );
         auto builder = create_line_builder( line_id );
         for( auto e : range( 1, line.nb_vertices() ) )
         {
@@ -500,8 +615,7 @@ namespace RINGMesh
         index_t line_id, const std::vector< index_t >& unique_vertices )
     {
         bool clear_vertices{ false };
-        auto& E = geomodel_access_.modifiable_mesh_entity(
-            { line_type_name_static(), line_id } );
+        const auto& E = geomodel_.line( line_id );
 
         ringmesh_assert( E.nb_vertices() == 0 );
         // If there are already some vertices
@@ -542,6 +656,7 @@ namespace RINGMesh
     void GeoModelBuilderGeometryBase< DIMENSION >::delete_mesh_entity_mesh(
         const gmme_id& E_id )
     {
+        geomodel_access_.notify_mesh_entity_change( E_id );
         GeoModelMeshEntityAccess< DIMENSION > gmme_access(
             geomodel_access_.modifiable_mesh_entity( E_id ) );
         auto builder = MeshBaseBuilder< DIMENSION >::create_builder(
@@ -581,6 +696,7 @@ namespace RINGMesh
     void GeoModelBuilderGeometryBase< DIMENSION >::delete_mesh_entity_vertices(
         const gmme_id& E_id, const std::vector< bool >& to_delete )
     {
+        geomodel_access_.notify_mesh_entity_change( E_id );
         GeoModelMeshEntityAccess< DIMENSION > gmme_access(
             geomodel_access_.modifiable_mesh_entity( E_id ) );
         auto builder = MeshBaseBuilder< DIMENSION >::create_builder(
@@ -636,64 +752,93 @@ namespace RINGMesh
     void GeoModelBuilderGeometryBase< DIMENSION >::compute_surface_adjacencies(
         index_t surface_id, bool recompute_adjacency )
     {
-        const auto& surface = geomodel_.surface( surface_id );
         auto builder = create_surface_builder( surface_id );
-
         if( recompute_adjacency )
         {
-            for( auto p : range( surface.nb_mesh_elements() ) )
-            {
-                for( auto v : range( surface.nb_mesh_element_vertices( p ) ) )
-                {
-                    builder->set_polygon_adjacent( { p, v }, NO_ID );
-                }
-            }
+            builder->compute_polygon_adjacencies();
+        }
+        else
+        {
+            builder->connect_polygons();
         }
-        builder->connect_polygons();
     }
 
     template < index_t DIMENSION >
     void GeoModelBuilderGeometryBase<
         DIMENSION >::cut_surfaces_by_internal_lines()
     {
+        std::vector< std::pair< index_t, std::set< index_t > > > surface_cuts;
         for( const auto& surface : geomodel_.surfaces() )
         {
             auto cutting_lines = get_internal_borders( surface );
-            for( auto line_id : cutting_lines )
-            {
-                cut_surface_by_line( surface.index(), line_id );
-            }
             if( !cutting_lines.empty() )
             {
-                auto surface_mesh_builder =
-                    create_surface_builder( surface.index() );
-                surface_mesh_builder->remove_isolated_vertices();
+                surface_cuts.emplace_back(
+                    surface.index(), std::move( cutting_lines ) );
             }
         }
+        if( surface_cuts.empty() )
+        {
+            return;
+        }
+
+        // Each task only modifies its Surface, lazy shared data is built first
+        geomodel_.epsilon();
+        parallel_for( static_cast< index_t >( surface_cuts.size() ),
+            [this, &surface_cuts]( index_t i ) {
+                const auto& surface_cut = surface_cuts[i];
+                cut_surface_by_lines( surface_cut.first, surface_cut.second );
+                auto surface_mesh_builder =
+                    create_surface_builder( surface_cut.first );
+                surface_mesh_builder->remove_isolated_vertices();
+            } );
+        clear_geomodel_mesh();
     }
 
     template < index_t DIMENSION >
     void GeoModelBuilderGeometryBase< DIMENSION >::cut_surface_by_line(
         index_t surface_id, index_t line_id )
     {
-        auto nb_disconnected_edges =
-            disconnect_surface_polygons_along_line_edges( surface_id, line_id );
-        if( nb_disconnected_edges > 0 )
-        {
-            duplicate_surface_vertices_along_line( surface_id, line_id );
-        }
+        cut_surface_by_lines( surface_id, { line_id } );
     }
 
-    struct ElementVertex
+    template < index_t DIMENSION >
+    void GeoModelBuilderGeometryBase< DIMENSION >::cut_surface_by_lines(
+        index_t surface_id, const std::set< index_t >& line_ids )
     {
-        index_t element_;
-        index_t vertex_;
-    };
+        ringmesh_assert( surface_id < geomodel_.nb_surfaces() );
+        const auto& surface = geomodel_.surface( surface_id );
+        std::vector< std::vector< PolygonLocalEdge > > polygon_edges;
+        std::vector< std::vector< ElementLocalVertex > > polygon_vertices;
+        for( auto line_id : line_ids )
+        {
+            ringmesh_assert( line_id < geomodel_.nb_lines() );
+            const auto& line = geomodel_.line( line_id );
+            polygon_edges.push_back( find_line_polygon_edges( surface, line ) );
+            polygon_vertices.push_back(
+                find_line_polygon_vertices( surface, line ) );
+        }
+
+        index_t i{ 0 };
+        for( auto line_id : line_ids )
+        {
+            auto nb_disconnected_edges =
+                disconnect_surface_polygons_along_line_edges(
+                    surface_id, line_id, polygon_edges[i] );
+            if( nb_disconnected_edges > 0 )
+            {
+                duplicate_surface_vertices_along_line(
+                    surface_id, line_id, polygon_vertices[i] );
+            }
+            i++;
+        }
+    }
 
     template < index_t DIMENSION >
     void GeoModelBuilderGeometryBase<
         DIMENSION >::duplicate_surface_vertices_along_line( index_t surface_id,
-        index_t line_id )
+        index_t line_id,
+        const std::vector< ElementLocalVertex >& polygon_vertices )
     {
         ringmesh_assert( surface_id < geomodel_.nb_surfaces() );
         ringmesh_assert( line_id < geomodel_.nb_lines() );
@@ -702,20 +847,6 @@ namespace RINGMesh
         const auto& surface = geomodel_.surface( surface_id );
         const auto& line = geomodel_.line( line_id );
 
-        std::vector< ElementVertex > polygon_vertices( line.nb_vertices() );
-        for( auto v : range( line.nb_vertices() ) )
-        {
-            const auto& p = line.vertex( v );
-
-            auto& polygon_vertex = polygon_vertices[v].vertex_;
-            auto& polygon = polygon_vertices[v].element_;
-            bool found{ find_polygon_from_vertex(
-                surface, p, polygon, polygon_vertex ) };
-            ringmesh_unused( found );
-            ringmesh_assert(
-                found && polygon != NO_ID && polygon_vertex != NO_ID );
-        }
-
         auto vertex_id =
             create_mesh_entity_vertices( surface_gme, line.nb_vertices() );
         auto surface_mesh_builder = create_surface_builder( surface_id );
@@ -723,8 +854,9 @@ namespace RINGMesh
         for( auto v : range( line.nb_vertices() ) )
         {
             const auto& p = line.vertex( v );
-            const auto polygon_vertex = polygon_vertices[v].vertex_;
-            const auto polygon = polygon_vertices[v].element_;
+            const auto polygon_vertex =
+                mesh.polygon_vertex( polygon_vertices[v] );
+            const auto polygon = polygon_vertices[v].element_id;
 
             auto polygons =
                 mesh.polygons_around_vertex( polygon_vertex, false, polygon );
@@ -737,8 +869,9 @@ namespace RINGMesh
 
     template < index_t DIMENSION >
     index_t GeoModelBuilderGeometryBase< DIMENSION >::
-        disconnect_surface_polygons_along_line_edges(
-            index_t surface_id, index_t line_id )
+        disconnect_surface_polygons_along_line_edges( index_t surface_id,
+            index_t line_id,
+            const std::vector< PolygonLocalEdge >& polygon_edges )
     {
         ringmesh_assert( surface_id < geomodel_.nb_surfaces() );
         ringmesh_assert( line_id < geomodel_.nb_lines() );
@@ -751,14 +884,8 @@ namespace RINGMesh
         {
             const auto& p0 = line.vertex( i );
             const auto& p1 = line.vertex( i + 1 );
-
-            bool found{ false };
-            index_t p{ NO_ID };
-            index_t e{ NO_ID };
-            std::tie( found, p, e ) =
-                find_polygon_from_edge_vertices( surface, p0, p1 );
-            ringmesh_unused( found );
-            ringmesh_assert( found && p != NO_ID && e != NO_ID );
+            auto p = polygon_edges[i].polygon_id;
+            auto e = polygon_edges[i].local_edge_id;
 
             auto adj_f = surface.polygon_adjacent_index( { p, e } );
             if( adj_f != NO_ID )
@@ -818,6 +945,7 @@ namespace RINGMesh
     void GeoModelBuilderGeometryBase< DIMENSION >::assign_mesh_to_entity(
         const MeshBase< DIMENSION >& mesh, const gmme_id& to )
     {
+        geomodel_access_.notify_mesh_entity_change( to );
         auto& E = geomodel_access_.modifiable_mesh_entity( to );
         GeoModelMeshEntityAccess< DIMENSION > gmme_access( E );
         auto builder = MeshBaseBuilder< DIMENSION >::create_builder(
@@ -858,6 +986,7 @@ namespace RINGMesh
         GeoModelBuilderGeometry< 3 >::create_region_builder( index_t region_id )
     {
         gmme_id id{ region_type_name_static(), region_id };
+        geomodel_access_.notify_mesh_entity_change( id );
         auto& region = geomodel_access_.modifiable_mesh_entity( id );
         GeoModelMeshEntityAccess3D region_access( region );
         auto& region_mesh =
@@ -867,7 +996,8 @@ namespace RINGMesh
 
     index_t GeoModelBuilderGeometry<
         3 >::disconnect_region_cells_along_surface_polygons( index_t region_id,
-        index_t surface_id )
+        index_t surface_id,
+        const std::vector< CellLocalFacet >& cell_facets )
     {
         ringmesh_assert( region_id < geomodel_.nb_regions() );
         ringmesh_assert( surface_id < geomodel_.nb_surfaces() );
@@ -878,13 +1008,8 @@ namespace RINGMesh
         index_t nb_disconnected_polygons{ 0 };
         for( auto polygon : range( surface.nb_mesh_elements() ) )
         {
-            bool found{ false };
-            index_t cell{ NO_ID };
-            index_t cell_facet{ NO_ID };
-            std::tie( found, cell, cell_facet ) =
-                find_cell_facet_from_polygon( region, surface, polygon );
-            ringmesh_unused( found );
-            ringmesh_assert( found && cell != NO_ID && cell_facet != NO_ID );
+            auto cell = cell_facets[polygon].cell_id;
+            auto cell_facet = cell_facets[polygon].local_facet_id;
 
             auto adj_cell = region.cell_adjacent_index( cell, cell_facet );
             if( adj_cell != NO_ID )
@@ -902,7 +1027,9 @@ namespace RINGMesh
     }
 
     void GeoModelBuilderGeometry< 3 >::duplicate_region_vertices_along_surface(
-        index_t region_id, index_t surface_id )
+        index_t region_id,
+        index_t surface_id,
+        const std::vector< ElementLocalVertex >& cell_vertices )
     {
         ringmesh_assert( region_id < geomodel_.nb_regions() );
         ringmesh_assert( surface_id < geomodel_.nb_surfaces() );
@@ -911,28 +1038,12 @@ namespace RINGMesh
         const auto& region = geomodel_.region( region_id );
         const auto& surface = geomodel_.surface( surface_id );
 
-        std::vector< ElementVertex > cell_vertices( surface.nb_vertices() );
-        for( auto v : range( surface.nb_vertices() ) )
-        {
-            const auto& p = surface.vertex( v );
-
-            auto& cell = cell_vertices[v].element_;
-            auto& cell_vertex = cell_vertices[v].vertex_;
-            auto element_local_vertex =
-                region.find_cell_from_colocated_vertex_if_any( p );
-            cell = element_local_vertex.element_id;
-            cell_vertex = element_local_vertex.local_vertex_id;
-
-            ringmesh_assert( cell != NO_ID && cell_vertex != NO_ID );
-        }
-
         GEO::vector< std::string > names;
         geomodel_.region( region_id )
             .vertex_attribute_manager()
             .list_attribute_names( names );
 
-        auto& E = geomodel_access_.modifiable_mesh_entity( region_gme );
-        auto vertices_nb = E.nb_vertices();
+        auto vertices_nb = region.nb_vertices();
 
         auto vertex_id =
             create_mesh_entity_vertices( region_gme, surface.nb_vertices() );
@@ -942,8 +1053,8 @@ namespace RINGMesh
         for( auto v : range( surface.nb_vertices() ) )
         {
             const auto& p = surface.vertex( v );
-            const auto cell = cell_vertices[v].element_;
-            const auto cell_vertex = cell_vertices[v].vertex_;
+            const auto cell = cell_vertices[v].element_id;
+            const auto cell_vertex = mesh.cell_vertex( cell_vertices[v] );
 
             auto cells = mesh.cells_around_vertex( cell_vertex, cell );
             update_cell_vertex( region_id, cells, cell_vertex, vertex_id );
@@ -972,17 +1083,44 @@ namespace RINGMesh
     void GeoModelBuilderGeometry< 3 >::cut_region_by_surface(
         index_t region_id, index_t surface_id )
     {
-        auto nb_disconnected_polygons =
-            disconnect_region_cells_along_surface_polygons(
-                region_id, surface_id );
-        if( nb_disconnected_polygons > 0 )
+        cut_region_by_surfaces( region_id, { surface_id } );
+    }
+
+    void GeoModelBuilderGeometry< 3 >::cut_region_by_surfaces(
+        index_t region_id, const std::set< index_t >& surface_ids )
+    {
+        ringmesh_assert( region_id < geomodel_.nb_regions() );
+        const auto& region = geomodel_.region( region_id );
+        std::vector< std::vector< CellLocalFacet > > cell_facets;
+        std::vector< std::vector< ElementLocalVertex > > cell_vertices;
+        for( auto surface_id : surface_ids )
         {
-            duplicate_region_vertices_along_surface( region_id, surface_id );
+            ringmesh_assert( surface_id < geomodel_.nb_surfaces() );
+            const auto& surface = geomodel_.surface( surface_id );
+            cell_facets.push_back(
+                find_surface_cell_facets( region, surface ) );
+            cell_vertices.push_back(
+                find_surface_cell_vertices( region, surface ) );
+        }
+
+        index_t i{ 0 };
+        for( auto surface_id : surface_ids )
+        {
+            auto nb_disconnected_polygons =
+                disconnect_region_cells_along_surface_polygons(
+                    region_id, surface_id, cell_facets[i] );
+            if( nb_disconnected_polygons > 0 )
+            {
+                duplicate_region_vertices_along_surface(
+                    region_id, surface_id, cell_vertices[i] );
+            }
+            i++;
         }
     }
 
     void GeoModelBuilderGeometry< 3 >::cut_regions_by_internal_surfaces()
     {
+        std::vector< std::pair< index_t, std::set< index_t > > > region_cuts;
         for( const auto& region : geomodel_.regions() )
         {
             if( region.nb_mesh_elements() == 0 )
@@ -990,17 +1128,28 @@ namespace RINGMesh
                 continue;
             }
             auto cutting_surfaces = get_internal_borders( region );
-            for( auto surface_id : cutting_surfaces )
-            {
-                cut_region_by_surface( region.index(), surface_id );
-            }
             if( !cutting_surfaces.empty() )
             {
-                auto region_mesh_builder =
-                    create_region_builder( region.index() );
-                region_mesh_builder->remove_isolated_vertices();
+                region_cuts.emplace_back(
+                    region.index(), std::move( cutting_surfaces ) );
             }
         }
+        if( region_cuts.empty() )
+        {
+            return;
+        }
+
+        // Each task only modifies its Region, lazy shared data is built first
+        geomodel_.epsilon();
+        parallel_for( static_cast< index_t >( region_cuts.size() ),
+            [this, &region_cuts]( index_t i ) {
+                const auto& region_cut = region_cuts[i];
+                cut_region_by_surfaces( region_cut.first, region_cut.second );
+                auto region_mesh_builder =
+                    create_region_builder( region_cut.first );
+                region_mesh_builder->remove_isolated_vertices();
+            } );
+        clear_geomodel_mesh();
     }
 
     void GeoModelBuilderGeometry< 3 >::set_region_geometry( index_t region_id,
@@ -1015,19 +1164,15 @@ namespace RINGMesh
     void GeoModelBuilderGeometry< 3 >::compute_region_adjacencies(
         index_t region_id, bool recompute_adjacency )
     {
-        const auto& region = geomodel_.region( region_id );
         auto builder = create_region_builder( region_id );
         if( recompute_adjacency )
         {
-            for( auto c : range( region.nb_mesh_elements() ) )
-            {
-                for( auto f : range( region.nb_cell_facets( c ) ) )
-                {
-                    builder->set_cell_adjacent( { c, f }, NO_ID );
-                }
-            }
+            builder->compute_cell_adjacencies();
+        }
+        else
+        {
+            builder->connect_cells();
         }
-        builder->connect_cells();
     }
 
     void GeoModelBuilderGeometry< 3 >::delete_region_cells( index_t region_id,
@@ -85,6 +85,7 @@ namespace RINGMesh
         {
             return;
         }
+        geomodel_access_.notify_geomodel_change();
         initialize_for_removal( entities );
         do_delete_flagged_mesh_entities();
         geomodel_.mesh.vertices.clear();
@@ -131,6 +132,7 @@ namespace RINGMesh
         }
         else
         {
+            geomodel_access_.notify_geomodel_change();
             initialize_for_removal( mesh_entities );
             flag_geological_entities_without_children();
             do_delete_flagged_geological_entities();
@@ -282,6 +282,7 @@ namespace RINGMesh
     {
         copy_all_mesh_entity_topology( from );
 
+        geomodel_access_.notify_geomodel_change();
         geomodel_access_.modifiable_epsilon() = from.epsilon();
         geomodel_access_.modifiable_entity_type_manager()
             .relationship_manager.copy(
@@ -408,6 +409,8 @@ namespace RINGMesh
                 "No boundary relation found between ", boundary, " and ",
                 incident_entity );
         }
+        geomodel_access_.notify_mesh_entity_change( boundary );
+        geomodel_access_.notify_mesh_entity_change( incident_entity );
         GeoModelMeshEntityAccess< DIMENSION > boundary_access(
             geomodel_access_.modifiable_mesh_entity( boundary ) );
         auto& incident_entities =
@@ -431,6 +434,7 @@ namespace RINGMesh
         const auto& entity_type = ENTITY< DIMENSION >::type_name_static();
         index_t nb_entities{ geomodel_.nb_mesh_entities( entity_type ) };
         index_t new_id{ nb_entities };
+        geomodel_access_.notify_geomodel_change();
         geomodel_access_.modifiable_mesh_entities( entity_type )
             .emplace_back(
                 GeoModelMeshEntityAccess< DIMENSION >::template create_entity<
@@ -446,6 +450,7 @@ namespace RINGMesh
         index_t nb_additionnal_entities, const MeshType& type )
     {
         const auto& entity_type = ENTITY< DIMENSION >::type_name_static();
+        geomodel_access_.notify_geomodel_change();
         auto& store = geomodel_access_.modifiable_mesh_entities( entity_type );
         index_t old_size{ static_cast< index_t >( store.size() ) };
         index_t new_size{ old_size + nb_additionnal_entities };
@@ -514,6 +519,8 @@ namespace RINGMesh
             relation_id = manager.add_boundary_relationship(
                 incident_entity_id, boundary_id );
         }
+        geomodel_access_.notify_mesh_entity_change( boundary_id );
+        geomodel_access_.notify_mesh_entity_change( incident_entity_id );
         auto& boundary_entity =
             geomodel_access_.modifiable_mesh_entity( boundary_id );
         GeoModelMeshEntityAccess< DIMENSION > boundary_access(
@@ -534,6 +541,7 @@ namespace RINGMesh
     {
         ringmesh_assert( current_local_boundary_id
                          < geomodel_.mesh_entity( gmme ).nb_boundaries() );
+        geomodel_access_.notify_mesh_entity_change( gmme );
         auto& mesh_entity = geomodel_access_.modifiable_mesh_entity( gmme );
         const auto& b_type =
             geomodel_.entity_type_manager()
@@ -573,6 +581,7 @@ namespace RINGMesh
     {
         /// No check on the validity of the index of the entity incident_entity
         /// NO_ID is used to flag entities to delete
+        geomodel_access_.notify_mesh_entity_change( gmme );
         auto& mesh_entity = geomodel_access_.modifiable_mesh_entity( gmme );
         ringmesh_assert( current_local_incident_entity_id
                          < mesh_entity.nb_incident_entities() );
@@ -593,6 +602,7 @@ namespace RINGMesh
     void GeoModelBuilderTopologyBase< DIMENSION >::delete_mesh_entity(
         const MeshEntityType& type, index_t index )
     {
+        geomodel_access_.notify_geomodel_change();
         geomodel_access_.modifiable_mesh_entities( type )[index].reset();
     }
 
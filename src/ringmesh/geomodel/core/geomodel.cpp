@@ -38,6 +38,8 @@
  * @author Jeanne Pellerin and Arnaud Botella
  */
 
+#include <algorithm>
+
 #include <geogram/basic/command_line.h>
 
 #include <ringmesh/basic/box.h>
@@ -220,6 +222,77 @@ namespace RINGMesh
         wells_ = wells;
     }
 
+    template < index_t DIMENSION >
+    void GeoModelBase< DIMENSION >::add_change_listener(
+        GeoModelChangeListener< DIMENSION >& listener ) const
+    {
+        std::lock_guard< std::mutex > locking( change_listeners_lock_ );
+        change_listeners_.push_back( &listener );
+        nb_change_listeners_ =
+            static_cast< index_t >( change_listeners_.size() );
+    }
+
+    template < index_t DIMENSION >
+    void GeoModelBase< DIMENSION >::remove_change_listener(
+        GeoModelChangeListener< DIMENSION >& listener ) const
+    {
+        std::lock_guard< std::mutex > locking( change_listeners_lock_ );
+        change_listeners_.erase( std::remove( change_listeners_.begin(),
+                                     change_listeners_.end(), &listener ),
+            change_listeners_.end() );
+        nb_change_listeners_ =
+            static_cast< index_t >( change_listeners_.size() );
+    }
+
+    template < index_t DIMENSION >
+    void GeoModelBase< DIMENSION >::notify_mesh_entity_change(
+        const gmme_id& id )
+    {
+        if( id.type() == Surface< DIMENSION >::type_name_static() )
+        {
+            surfaces_revision_++;
+        }
+        if( nb_change_listeners_ == 0 )
+        {
+            return;
+        }
+        std::lock_guard< std::mutex > locking( change_listeners_lock_ );
+        for( auto listener : change_listeners_ )
+        {
+            listener->mesh_entity_changed( id );
+        }
+    }
+
+    template < index_t DIMENSION >
+    void GeoModelBase< DIMENSION >::notify_geological_entity_change(
+        const gmge_id& id )
+    {
+        if( nb_change_listeners_ == 0 )
+        {
+            return;
+        }
+        std::lock_guard< std::mutex > locking( change_listeners_lock_ );
+        for( auto listener : change_listeners_ )
+        {
+            listener->geological_entity_changed( id );
+        }
+    }
+
+    template < index_t DIMENSION >
+    void GeoModelBase< DIMENSION >::notify_geomodel_change()
+    {
+        surfaces_revision_++;
+        if( nb_change_listeners_ == 0 )
+        {
+            return;
+        }
+        std::lock_guard< std::mutex > locking( change_listeners_lock_ );
+        for( auto listener : change_listeners_ )
+        {
+            listener->geomodel_changed();
+        }
+    }
+
     template < index_t DIMENSION >
     double GeoModelBase< DIMENSION >::epsilon() const
     {
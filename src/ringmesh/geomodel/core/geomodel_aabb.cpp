@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2012-2018, Association Scientifique pour la Geologie et ses
+ * Applications (ASGA). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of ASGA nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL ASGA BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *     http://www.ring-team.org
+ *
+ *     RING Project
+ *     Ecole Nationale Superieure de Geologie - GeoRessources
+ *     2 Rue du Doyen Marcel Roubault - TSA 70605
+ *     54518 VANDOEUVRE-LES-NANCY
+ *     FRANCE
+ */
+
+#include <ringmesh/geomodel/core/geomodel_aabb.h>
+
+#include <algorithm>
+
+#include <ringmesh/basic/algorithm.h>
+#include <ringmesh/basic/task_handler.h>
+#include <ringmesh/geomodel/core/geomodel.h>
+#include <ringmesh/geomodel/core/geomodel_mesh_entity.h>
+
+#include <ringmesh/mesh/mesh_index.h>
+
+/*!
+ * @file AABB tree of all the Surfaces of a GeoModel
+ */
+
+namespace
+{
+    using namespace RINGMesh;
+
+    /// Number of segments processed by a task of segment_intersections()
+    const index_t SEGMENT_CHUNK_SIZE{ 1024 };
+
+    class SegmentTriangleIntersectionAction
+    {
+    public:
+        SegmentTriangleIntersectionAction( const GeoModel3D& geomodel,
+            const Geometry::Segment3D& segment,
+            std::vector< SurfaceIntersection3D >& intersections )
+            : geomodel_( geomodel ),
+              segment_( segment ),
+              intersections_( intersections )
+        {
+        }
+
+        void operator()( index_t surface_id, index_t triangle )
+        {
+            const auto& surface = geomodel_.surface( surface_id );
+            bool does_seg_intersect_triangle{ false };
+            vec3 result;
+            std::tie( does_seg_intersect_triangle, result ) =
+                Intersection::segment_triangle( segment_,
+                    { surface.mesh_element_vertex( { triangle, 0 } ),
+                        surface.mesh_element_vertex( { triangle, 1 } ),
+                        surface.mesh_element_vertex( { triangle, 2 } ) } );
+            if( does_seg_intersect_triangle )
+            {
+                intersections_.emplace_back( result, surface_id, triangle,
+                    length( result - segment_.p0 ) );
+            }
+        }
+
+    private:
+        const GeoModel3D& geomodel_;
+        const Geometry::Segment3D& segment_;
+        std::vector< SurfaceIntersection3D >& intersections_;
+    };
+} // namespace
+
+namespace RINGMesh
+{
+    template < index_t DIMENSION >
+    GeoModelSurfacesAABBTree< DIMENSION >::GeoModelSurfacesAABBTree(
+        const GeoModel< DIMENSION >& geomodel )
+        : geomodel_( geomodel )
+    {
+        const auto nb_surfaces = geomodel.nb_surfaces();
+        if( nb_surfaces == 0 )
+        {
+            return;
+        }
+        std::vector< Box< DIMENSION > > boxes( nb_surfaces );
+        parallel_for( nb_surfaces, [&geomodel, &boxes]( index_t s ) {
+            const auto& surface = geomodel.surface( s );
+            for( auto v : range( surface.nb_vertices() ) )
+            {
+                boxes[s].add_point( surface.vertex( v ) );
+            }
+            // The polygon trees are built lazily and are not thread safe:
+            // build them here once for all
+            surface.polygon_aabb();
+        } );
+        surfaces_tree_.reset( new BoxAABBTree< DIMENSION >( boxes ) );
+    }
+
+    template < index_t DIMENSION >
+    const SurfaceAABBTree< DIMENSION >&
+        GeoModelSurfacesAABBTree< DIMENSION >::surface_tree(
+            index_t surface ) const
+    {
+        return geomodel_.surface( surface ).polygon_aabb();
+    }
+
+    template <>
+    SegmentsSurfaceIntersections3D
+        GeoModelSurfacesAABBTree< 3 >::segment_intersections(
+            const std::vector< Geometry::Segment3D >& segments ) const
+    {
+        const auto nb_segments = static_cast< index_t >( segments.size() );
+        const auto nb_chunks =
+            ( nb_segments + SEGMENT_CHUNK_SIZE - 1 ) / SEGMENT_CHUNK_SIZE;
+        std::vector< std::vector< SurfaceIntersection3D > > chunk_intersections(
+            nb_chunks );
+        SegmentsSurfaceIntersections3D result;
+        result.offsets.resize( nb_segments + 1, 0 );
+        parallel_for( nb_chunks, [&segments, &chunk_intersections, &result,
+                                     nb_segments, this]( index_t chunk ) {
+            auto& intersections = chunk_intersections[chunk];
+            const auto begin = chunk * SEGMENT_CHUNK_SIZE;
+            const auto end =
+                std::min( nb_segments, begin + SEGMENT_CHUNK_SIZE );
+            for( auto s : range( begin, end ) )
+            {
+                const auto& segment = segments[s];
+                const auto first = intersections.size();
+                Box3D box;
+                box.add_point( segment.p0 );
+                box.add_point( segment.p1 );
+                SegmentTriangleIntersectionAction action(
+                    geomodel_, segment, intersections );
+                compute_bbox_polygon_bbox_intersections( box, action );
+                std::sort( intersections.begin()
+                               + static_cast< std::ptrdiff_t >( first ),
+                    intersections.end(),
+                    []( const SurfaceIntersection3D& lhs,
+                        const SurfaceIntersection3D& rhs ) {
+                        return lhs.distance < rhs.distance;
+                    } );
+                result.offsets[s + 1] =
+                    static_cast< index_t >( intersections.size() - first );
+            }
+        } );
+
+        for( auto s : range( nb_segments ) )
+        {
+            result.offsets[s + 1] += result.offsets[s];
+        }
+        result.intersections.reserve( result.offsets.back() );
+        for( auto& intersections : chunk_intersections )
+        {
+            result.intersections.insert( result.intersections.end(),
+                intersections.begin(), intersections.end() );
+            std::vector< SurfaceIntersection3D >().swap( intersections );
+        }
+        return result;
+    }
+
+    template class geomodel_core_api GeoModelSurfacesAABBTree< 2 >;
+    template class geomodel_core_api GeoModelSurfacesAABBTree< 3 >;
+} // namespace RINGMesh
@@ -35,6 +35,7 @@
 
 #include <ringmesh/geomodel/core/geomodel_mesh.h>
 
+#include <algorithm>
 #include <numeric>
 #include <stack>
 
@@ -45,6 +46,7 @@
 
 #include <ringmesh/basic/algorithm.h>
 #include <ringmesh/basic/pimpl_impl.h>
+#include <ringmesh/basic/task_handler.h>
 #include <ringmesh/geogram_extension/geogram_extension.h>
 #include <ringmesh/geogram_extension/geogram_mesh.h>
 #include <ringmesh/geomodel/core/geomodel.h>
@@ -52,6 +54,7 @@
 #include <ringmesh/geomodel/core/geomodel_mesh_entity.h>
 #include <ringmesh/geomodel/core/well.h>
 
+#include <ringmesh/mesh/mesh_aabb.h>
 #include <ringmesh/mesh/mesh_builder.h>
 #include <ringmesh/mesh/mesh_set.h>
 
@@ -145,6 +148,107 @@ namespace
             builder->set_vertex( v, mesh.vertex( v ) );
         }
     }
+
+    /*!
+     * Clips the segment [p0, p1] by a cell assumed convex
+     * @return a tuple containing:
+     * - true if the segment crosses the cell.
+     * - the parametric coordinate where the segment enters the cell.
+     * - the parametric coordinate where the segment leaves the cell.
+     */
+    std::tuple< bool, double, double > clip_segment_by_cell(
+        const VolumeMesh3D& mesh, index_t cell, const vec3& p0, const vec3& p1 )
+    {
+        const auto direction = p1 - p0;
+        const auto barycenter = mesh.cell_barycenter( cell );
+        double entry{ 0 };
+        double exit{ 1 };
+        for( auto f : range( mesh.nb_cell_facets( cell ) ) )
+        {
+            CellLocalFacet facet( cell, f );
+            const auto nb_vertices = mesh.nb_cell_facet_vertices( facet );
+            // Newell normal, robust to non planar quadrangles
+            vec3 normal;
+            vec3 center;
+            for( auto v : range( nb_vertices ) )
+            {
+                const auto& a =
+                    mesh.vertex( mesh.cell_facet_vertex( facet, v ) );
+                const auto& b = mesh.vertex( mesh.cell_facet_vertex(
+                    facet, ( v + 1 ) % nb_vertices ) );
+                normal.x += ( a.y - b.y ) * ( a.z + b.z );
+                normal.y += ( a.z - b.z ) * ( a.x + b.x );
+                normal.z += ( a.x - b.x ) * ( a.y + b.y );
+                center += a;
+            }
+            center /= nb_vertices;
+            if( dot( normal, barycenter - center ) > 0 )
+            {
+                normal = -normal;
+            }
+            const auto distance = dot( normal, p0 - center );
+            const auto speed = dot( normal, direction );
+            if( speed == 0 )
+            {
+                if( distance > 0 )
+                {
+                    return std::make_tuple( false, 0., 0. );
+                }
+                continue;
+            }
+            const auto t = -distance / speed;
+            if( speed < 0 )
+            {
+                entry = std::max( entry, t );
+            }
+            else
+            {
+                exit = std::min( exit, t );
+            }
+            if( entry >= exit )
+            {
+                return std::make_tuple( false, 0., 0. );
+            }
+        }
+        return std::make_tuple( true, entry, exit );
+    }
+
+    class SegmentCellIntersectionAction
+    {
+    public:
+        SegmentCellIntersectionAction( const VolumeMesh3D& mesh,
+            const vec3& p0,
+            const vec3& p1,
+            double tolerance,
+            std::vector< WellEdgeCellIntersection >& intersections )
+            : mesh_( mesh ),
+              p0_( p0 ),
+              p1_( p1 ),
+              tolerance_( tolerance ),
+              intersections_( intersections )
+        {
+        }
+
+        void operator()( index_t cell )
+        {
+            bool does_cross{ false };
+            double entry{ 0 };
+            double exit{ 0 };
+            std::tie( does_cross, entry, exit ) =
+                clip_segment_by_cell( mesh_, cell, p0_, p1_ );
+            if( does_cross && exit - entry > tolerance_ )
+            {
+                intersections_.emplace_back( cell, entry, exit );
+            }
+        }
+
+    private:
+        const VolumeMesh3D& mesh_;
+        const vec3& p0_;
+        const vec3& p1_;
+        double tolerance_;
+        std::vector< WellEdgeCellIntersection >& intersections_;
+    };
 } // namespace
 
 namespace RINGMesh
@@ -1874,6 +1978,7 @@ namespace RINGMesh
 
         mode_ = NONE;
         duplicated_vertex_indices_.clear();
+        this->gmm_.wells.clear_cell_intersections();
     }
 
     template < index_t DIMENSION >
@@ -2162,6 +2267,169 @@ namespace RINGMesh
         return mesh_->edge_aabb();
     }
 
+    template < index_t DIMENSION >
+    index_t GeoModelMeshWells< DIMENSION >::nb_cell_intersections(
+        index_t well, index_t edge ) const
+    {
+        test_and_initialize_cell_intersections();
+        const auto global_edge = well_ptr_[well] + edge;
+        return edge_cell_ptr_[global_edge + 1] - edge_cell_ptr_[global_edge];
+    }
+
+    template < index_t DIMENSION >
+    const WellEdgeCellIntersection&
+        GeoModelMeshWells< DIMENSION >::cell_intersection(
+            index_t well, index_t edge, index_t i ) const
+    {
+        test_and_initialize_cell_intersections();
+        ringmesh_assert( i < nb_cell_intersections( well, edge ) );
+        return cell_intersections_[edge_cell_ptr_[well_ptr_[well] + edge]
+                                   + i];
+    }
+
+    template < index_t DIMENSION >
+    const std::vector< index_t >&
+        GeoModelMeshWells< DIMENSION >::perforated_cells( index_t well ) const
+    {
+        test_and_initialize_cell_intersections();
+        return perforated_cells_[well];
+    }
+
+    template < index_t DIMENSION >
+    void GeoModelMeshWells<
+        DIMENSION >::test_and_initialize_cell_intersections() const
+    {
+        test_and_initialize();
+        if( !cell_intersections_initialized_ )
+        {
+            const_cast< GeoModelMeshWells* >( this )
+                ->initialize_cell_intersections();
+        }
+    }
+
+    template < index_t DIMENSION >
+    void GeoModelMeshWells< DIMENSION >::initialize_cell_intersections()
+    {
+        throw RINGMeshException(
+            "Wells", "Well/cell intersections are only available in 3D" );
+    }
+
+    template <>
+    void GeoModelMeshWells< 3 >::initialize_cell_intersections()
+    {
+        cell_intersections_initialized_ = true;
+        const auto nb_edges = well_ptr_.empty() ? 0 : well_ptr_.back();
+        edge_cell_ptr_.assign( nb_edges + 1, 0 );
+        perforated_cells_.assign( well_ptr_.empty() ? 0 : well_ptr_.size() - 1,
+            std::vector< index_t >() );
+        if( nb_edges == 0 || gmm_.cells.nb() == 0 )
+        {
+            return;
+        }
+
+        // Well vertices are not necessarily GeoModelMesh vertices,
+        // the edge geometry is taken from the well parts
+        std::vector< std::pair< vec3, vec3 > > edges;
+        edges.reserve( nb_edges );
+        const auto& wells = *geomodel_.wells();
+        for( auto w : range( wells.nb_wells() ) )
+        {
+            const auto& well = wells.well( w );
+            for( auto p : range( well.nb_parts() ) )
+            {
+                const auto& part = well.part( p );
+                for( auto e : range( part.nb_edges() ) )
+                {
+                    edges.emplace_back( part.edge_vertex( { e, 0 } ),
+                        part.edge_vertex( { e, 1 } ) );
+                }
+            }
+        }
+        ringmesh_assert( edges.size() == nb_edges );
+
+        // The cell tree is built lazily and is not thread safe
+        const auto& cell_aabb = gmm_.cells.aabb();
+        const auto& cell_mesh = gmm_.cells.mesh();
+        const auto epsilon = geomodel_.epsilon();
+        std::vector< std::vector< WellEdgeCellIntersection > >
+            edge_intersections( nb_edges );
+        parallel_for( nb_edges, [&cell_aabb, &cell_mesh, &edges,
+                                    &edge_intersections, epsilon]( index_t e ) {
+            const auto& p0 = edges[e].first;
+            const auto& p1 = edges[e].second;
+            const auto edge_length = length( p1 - p0 );
+            if( edge_length < epsilon )
+            {
+                return;
+            }
+            Box3D box;
+            box.add_point( p0 );
+            box.add_point( p1 );
+            auto& intersections = edge_intersections[e];
+            SegmentCellIntersectionAction action(
+                cell_mesh, p0, p1, epsilon / edge_length, intersections );
+            cell_aabb.compute_bbox_element_bbox_intersections( box, action );
+            std::sort( intersections.begin(), intersections.end(),
+                []( const WellEdgeCellIntersection& lhs,
+                    const WellEdgeCellIntersection& rhs ) {
+                    return lhs.entry < rhs.entry;
+                } );
+        } );
+
+        for( auto e : range( nb_edges ) )
+        {
+            edge_cell_ptr_[e + 1] = edge_cell_ptr_[e]
+                                    + static_cast< index_t >(
+                                          edge_intersections[e].size() );
+        }
+        cell_intersections_.reserve( edge_cell_ptr_.back() );
+        for( auto& intersections : edge_intersections )
+        {
+            cell_intersections_.insert( cell_intersections_.end(),
+                intersections.begin(), intersections.end() );
+        }
+
+        for( auto w : range( perforated_cells_.size() ) )
+        {
+            auto& cells = perforated_cells_[w];
+            for( auto i : range( edge_cell_ptr_[well_ptr_[w]],
+                     edge_cell_ptr_[well_ptr_[w + 1]] ) )
+            {
+                cells.push_back( cell_intersections_[i].cell );
+            }
+            // Keep the first occurrence of each cell along the trajectory
+            std::vector< index_t > sorted_cells( cells );
+            std::sort( sorted_cells.begin(), sorted_cells.end() );
+            sorted_cells.erase(
+                std::unique( sorted_cells.begin(), sorted_cells.end() ),
+                sorted_cells.end() );
+            std::vector< bool > is_visited( sorted_cells.size(), false );
+            index_t nb_cells{ 0 };
+            for( auto cell : cells )
+            {
+                auto index = static_cast< index_t >(
+                    std::lower_bound(
+                        sorted_cells.begin(), sorted_cells.end(), cell )
+                    - sorted_cells.begin() );
+                if( !is_visited[index] )
+                {
+                    is_visited[index] = true;
+                    cells[nb_cells++] = cell;
+                }
+            }
+            cells.resize( nb_cells );
+        }
+    }
+
+    template < index_t DIMENSION >
+    void GeoModelMeshWells< DIMENSION >::clear_cell_intersections()
+    {
+        cell_intersections_initialized_ = false;
+        edge_cell_ptr_.clear();
+        cell_intersections_.clear();
+        perforated_cells_.clear();
+    }
+
     /*******************************************************************************/
     template < index_t DIMENSION >
     const std::string GeoModelMeshPolygonsBase< DIMENSION >::surface_att_name =
@@ -2803,6 +3071,7 @@ namespace RINGMesh
             LineMeshBuilder< DIMENSION >::create_builder( *mesh_ );
         mesh_builder->clear( true, false );
         well_ptr_.clear();
+        clear_cell_intersections();
     }
 
     template < index_t DIMENSION >
@@ -2831,7 +3100,7 @@ namespace RINGMesh
             copy_vertices( mesh_builder.get(), *this->gmm_.vertices.mesh_ );
         }
 
-        // Compute the total number of edge per well
+        // Compute the index of the first edge of each well
         const auto& wells = *this->geomodel_.wells();
         well_ptr_.resize( wells.nb_wells() + 1, 0 );
         index_t nb_edges{ 0 };
@@ -2841,12 +3110,6 @@ namespace RINGMesh
             well_ptr_[w + 1] = nb_edges;
         }
 
-        // Compute the edge offset
-        for( auto i : range( 1, well_ptr_.size() - 1 ) )
-        {
-            well_ptr_[i + 1] += well_ptr_[i];
-        }
-
         // Create edges
         mesh_builder->create_edges( well_ptr_.back() );
 
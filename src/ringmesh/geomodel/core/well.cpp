@@ -35,8 +35,9 @@
 
 #include <ringmesh/geomodel/core/well.h>
 
+#include <algorithm>
 #include <cmath>
-#include <numeric>
+#include <set>
 #include <stack>
 
 #include <geogram/mesh/mesh.h>
@@ -45,7 +46,9 @@
 #include <ringmesh/basic/algorithm.h>
 #include <ringmesh/basic/box.h>
 #include <ringmesh/basic/geometry.h>
+#include <ringmesh/basic/task_handler.h>
 #include <ringmesh/geomodel/core/geomodel.h>
+#include <ringmesh/geomodel/core/geomodel_aabb.h>
 #include <ringmesh/geomodel/core/geomodel_mesh_entity.h>
 
 #include <ringmesh/mesh/line_mesh.h>
@@ -214,41 +217,6 @@ namespace
         well_part.set_points( vertices );
     }
 
-    class EdgeConformerAction
-    {
-    public:
-        EdgeConformerAction( const Surface3D& surface,
-            const vec3& v_from,
-            const vec3& v_to,
-            std::vector< LineInstersection >& intersections )
-            : surface_( surface ),
-              segment_( v_from, v_to ),
-              intersections_( intersections )
-        {
-        }
-
-        void operator()( index_t trgl )
-        {
-            bool does_seg_intersect_triangle = false;
-            vec3 result;
-            std::tie( does_seg_intersect_triangle, result ) =
-                Intersection::segment_triangle( segment_,
-                    { surface_.mesh_element_vertex( { trgl, 0 } ),
-                        surface_.mesh_element_vertex( { trgl, 1 } ),
-                        surface_.mesh_element_vertex( { trgl, 2 } ) } );
-            if( does_seg_intersect_triangle )
-            {
-                intersections_.emplace_back( result, surface_.index(), trgl );
-            }
-        }
-
-    private:
-        const Surface3D& surface_;
-        Geometry::Segment3D segment_;
-
-        std::vector< LineInstersection >& intersections_;
-    };
-
     struct OrientedEdge
     {
         OrientedEdge(
@@ -306,6 +274,145 @@ namespace
         }
         ringmesh_assert( count == 1 );
     }
+
+    /*!
+     * @brief Builds the conformal mesh of a well
+     * @details The vertices of the input mesh are kept, and the
+     * intersections of its edges with the Surfaces are inserted.
+     * @param[in] edge_intersections intersections of the edges sorted
+     * along each edge, the intersections of the edge e of \p in are the ones
+     * of the segment \p first_edge + e
+     */
+    void build_conformal_mesh( const LineMesh3D& in,
+        const SegmentsSurfaceIntersections3D& edge_intersections,
+        index_t first_edge,
+        double epsilon,
+        LineMesh3D& out )
+    {
+        std::unique_ptr< LineMeshBuilder3D > builder =
+            LineMeshBuilder3D::create_builder( out );
+        builder->clear( false, false );
+
+        GEO::Attribute< LineInstersection > vertex_info(
+            out.vertex_attribute_manager(), "info" );
+        builder->create_vertices( in.nb_vertices() );
+        for( auto v : range( in.nb_vertices() ) )
+        {
+            const vec3& vertex = in.vertex( v );
+            builder->set_vertex( v, vertex );
+            vertex_info[v] = LineInstersection( vertex );
+        }
+
+        for( auto e : range( in.nb_edges() ) )
+        {
+            index_t from_id = in.edge_vertex( ElementLocalVertex( e, 0 ) );
+            index_t to_id = in.edge_vertex( ElementLocalVertex( e, 1 ) );
+            double edge_length =
+                length( in.vertex( to_id ) - in.vertex( from_id ) );
+            index_t last_vertex = from_id;
+            for( auto i : range( edge_intersections.offsets[first_edge + e],
+                     edge_intersections.offsets[first_edge + e + 1] ) )
+            {
+                const auto& intersection =
+                    edge_intersections.intersections[i];
+                LineInstersection info( intersection.point,
+                    intersection.surface, intersection.polygon );
+                if( intersection.distance < epsilon )
+                {
+                    vertex_info[from_id] = info;
+                }
+                else if( std::fabs( intersection.distance - edge_length )
+                         < epsilon )
+                {
+                    vertex_info[to_id] = info;
+                }
+                else
+                {
+                    index_t vertex_id =
+                        builder->create_vertex( intersection.point );
+                    vertex_info[vertex_id] = info;
+                    builder->create_edge( last_vertex, vertex_id );
+                    last_vertex = vertex_id;
+                }
+            }
+            builder->create_edge( last_vertex, to_id );
+        }
+    }
+
+    /*!
+     * Creates the parts and corners of a well from its conformal mesh
+     */
+    void build_well( const GeoModel3D& geomodel,
+        const LineMesh3D& conformal_mesh,
+        Well3D& well )
+    {
+        auto edges_around_vertices =
+            get_edges_around_vertices( conformal_mesh );
+
+        std::stack< OrientedEdge > S;
+        for( auto v : range( conformal_mesh.nb_vertices() ) )
+        {
+            const auto& edges = edges_around_vertices[v];
+            if( edges.size() == 1 )
+            {
+                S.emplace( conformal_mesh, edges.front(), v );
+            }
+        }
+        if( S.empty() )
+        {
+            throw RINGMeshException( "Well",
+                "A well should have at least one starting or ending point" );
+        }
+
+        GEO::Attribute< LineInstersection > vertex_info(
+            conformal_mesh.vertex_attribute_manager(), "info" );
+        std::vector< bool > edge_visited( conformal_mesh.nb_edges(), false );
+        do
+        {
+            OrientedEdge cur_edge = S.top();
+            S.pop();
+            if( edge_visited[cur_edge.edge_] )
+            {
+                continue;
+            }
+            edge_visited[cur_edge.edge_] = true;
+
+            std::vector< vec3 > well_part_points;
+            std::stack< OrientedEdge > S_part;
+            S_part.push( cur_edge );
+            do
+            {
+                OrientedEdge cur_edge_part = S_part.top();
+                S_part.pop();
+                edge_visited[cur_edge_part.edge_] = true;
+                const vec3& v_from =
+                    conformal_mesh.vertex( cur_edge_part.vertex_from_ );
+                index_t v_to_id = conformal_mesh.edge_vertex(
+                    ElementLocalVertex( cur_edge_part.edge_,
+                        ( cur_edge_part.edge_vertex_ + 1 ) % 2 ) );
+                const vec3& v_to = conformal_mesh.vertex( v_to_id );
+                well_part_points.push_back( v_from );
+
+                const auto& edges = edges_around_vertices[v_to_id];
+                if( edges.size() == 2 )
+                {
+                    process_linear_edges(
+                        edges, edge_visited, conformal_mesh, S_part, v_to_id );
+                }
+                else
+                {
+                    well_part_points.push_back( v_to );
+                    create_well_part_and_corners( geomodel, well,
+                        well_part_points, vertex_info[cur_edge.vertex_from_],
+                        vertex_info[v_to_id] );
+                    for( auto edge : edges )
+                    {
+                        S.emplace( conformal_mesh, edge, v_to_id );
+                    }
+                }
+            } while( !S_part.empty() );
+        } while( !S.empty() );
+    }
 } // namespace
 
 namespace RINGMesh
@@ -533,6 +640,9 @@ namespace RINGMesh
     {
     }
 
+    template < index_t DIMENSION >
+    WellGroup< DIMENSION >::~WellGroup() = default;
+
     template < index_t DIMENSION >
     void WellGroup< DIMENSION >::get_region_edges(
         index_t region, std::vector< Edge< DIMENSION > >& edges ) const
@@ -583,77 +693,36 @@ namespace RINGMesh
             "Wells", "2D Wells not fully implemented yet" );
     }
 
-    template <>
-    void WellGroup< 3 >::compute_conformal_mesh(
-        const LineMesh3D& in, LineMesh3D& out )
+    template < index_t DIMENSION >
+    const GeoModelSurfacesAABBTree< DIMENSION >&
+        WellGroup< DIMENSION >::surfaces_aabb()
     {
-        double epsilon = geomodel_->epsilon();
-        std::unique_ptr< LineMeshBuilder3D > builder =
-            LineMeshBuilder3D::create_builder( out );
-        builder->clear( false, false );
-
-        GEO::Attribute< LineInstersection > vertex_info(
-            out.vertex_attribute_manager(), "info" );
-        builder->create_vertices( in.nb_vertices() );
-        for( auto v : range( in.nb_vertices() ) )
+        if( !surfaces_aabb_ || &surfaces_aabb_->geomodel() != geomodel_
+            || surfaces_aabb_revision_ != geomodel_->surfaces_revision() )
         {
-            const vec3& vertex = in.vertex( v );
-            builder->set_vertex( v, vertex );
-            vertex_info[v] = LineInstersection( vertex );
+            surfaces_aabb_.reset(
+                new GeoModelSurfacesAABBTree< DIMENSION >( *geomodel_ ) );
+            surfaces_aabb_revision_ = geomodel_->surfaces_revision();
         }
+        return *surfaces_aabb_;
+    }
 
+    template <>
+    void WellGroup< 3 >::compute_conformal_mesh(
+        const LineMesh3D& in, LineMesh3D& out )
+    {
+        std::vector< Geometry::Segment3D > segments;
+        segments.reserve( in.nb_edges() );
         for( auto e : range( in.nb_edges() ) )
         {
-            index_t from_id = in.edge_vertex( ElementLocalVertex( e, 0 ) );
-            const vec3& from_vertex = in.vertex( from_id );
-            index_t to_id = in.edge_vertex( ElementLocalVertex( e, 1 ) );
-            const vec3& to_vertex = in.vertex( to_id );
-
-            Box3D box;
-            box.add_point( from_vertex );
-            box.add_point( to_vertex );
-            std::vector< LineInstersection > intersections;
-            for( const auto& surface : geomodel_->surfaces() )
-            {
-                EdgeConformerAction action(
-                    surface, from_vertex, to_vertex, intersections );
-                surface.polygon_aabb().compute_bbox_element_bbox_intersections(
-                    box, action );
-            }
-
-            std::vector< index_t > indices( intersections.size() );
-            std::iota( indices.begin(), indices.end(), 0 );
-            std::vector< double > distances( intersections.size() );
-            for( auto i : range( intersections.size() ) )
-            {
-                distances[i] =
-                    length( from_vertex - intersections[i].intersection_ );
-            }
-            indirect_sort( distances, indices );
-            double edge_length = length( from_vertex - to_vertex );
-            index_t last_vertex = from_id;
-            for( auto i : range( intersections.size() ) )
-            {
-                if( distances[indices[i]] < epsilon )
-                {
-                    vertex_info[from_id] = intersections[i];
-                }
-                else if( std::fabs( distances[indices[i]] - edge_length )
-                         < epsilon )
-                {
-                    vertex_info[to_id] = intersections[i];
-                }
-                else
-                {
-                    index_t vertex_id = builder->create_vertex(
-                        intersections[i].intersection_ );
-                    vertex_info[vertex_id] = intersections[i];
-                    builder->create_edge( last_vertex, vertex_id );
-                    last_vertex = vertex_id;
-                }
-            }
-            builder->create_edge( last_vertex, to_id );
+            segments.emplace_back(
+                in.vertex( in.edge_vertex( ElementLocalVertex( e, 0 ) ) ),
+                in.vertex( in.edge_vertex( ElementLocalVertex( e, 1 ) ) ) );
         }
+        auto edge_intersections =
+            surfaces_aabb().segment_intersections( segments );
+        build_conformal_mesh(
+            in, edge_intersections, 0, geomodel_->epsilon(), out );
     }
 
     template <>
@@ -681,73 +750,125 @@ namespace RINGMesh
 
         auto conformal_mesh = LineMesh3D::create_mesh();
         compute_conformal_mesh( mesh, *conformal_mesh );
+        build_well( *geomodel(), *conformal_mesh, new_well );
+    }
 
-        auto edges_around_vertices =
-            get_edges_around_vertices( *conformal_mesh );
+    template <>
+    void geomodel_core_api WellGroup< 2 >::add_wells(
+        const WellTrajectories& trajectories )
+    {
+        ringmesh_unused( trajectories );
+        throw RINGMeshException(
+            "Wells", "2D Wells not fully implemented yet" );
+    }
 
-        std::stack< OrientedEdge > S;
-        for( auto v : range( conformal_mesh->nb_vertices() ) )
-        {
-            const auto& edges = edges_around_vertices[v];
-            if( edges.size() == 1 )
-            {
-                S.emplace( *conformal_mesh, edges.front(), v );
-            }
+    template <>
+    void geomodel_core_api WellGroup< 3 >::add_wells(
+        const WellTrajectories& trajectories )
+    {
+        ringmesh_assert( geomodel() );
+        const auto& offsets = trajectories.offsets;
+        if( offsets.size() != trajectories.nb_wells() + 1
+            || !std::is_sorted( offsets.begin(), offsets.end() )
+            || trajectories.x.size() != offsets.back()
+            || trajectories.y.size() != offsets.back()
+            || trajectories.z.size() != offsets.back() )
+        {
+            throw RINGMeshException(
+                "Wells", "Invalid well trajectory arrays" );
         }
-        if( S.empty() )
+
+        std::set< std::string > names;
+        for( auto w : range( nb_wells() ) )
         {
-            throw RINGMeshException( "Well",
-                "A well should have at least one starting or ending point" );
+            names.insert( well( w ).name() );
         }
-
-        GEO::Attribute< LineInstersection > vertex_info(
-            conformal_mesh->vertex_attribute_manager(), "info" );
-        std::vector< bool > edge_visited( conformal_mesh->nb_edges(), false );
-        do
+        std::vector< index_t > new_wells;
+        std::vector< index_t > first_edges{ 0 };
+        for( auto w : range( trajectories.nb_wells() ) )
         {
-            OrientedEdge cur_edge = S.top();
-            S.pop();
-            if( edge_visited[cur_edge.edge_] )
+            if( !names.insert( trajectories.names[w] ).second )
             {
                 continue;
             }
-            edge_visited[cur_edge.edge_] = true;
-
-            std::vector< vec3 > well_part_points;
-            std::stack< OrientedEdge > S_part;
-            S_part.push( cur_edge );
-            do
+            if( offsets[w + 1] - offsets[w] < 2 )
             {
-                OrientedEdge cur_edge_part = S_part.top();
-                S_part.pop();
-                edge_visited[cur_edge_part.edge_] = true;
-                const vec3& v_from =
-                    conformal_mesh->vertex( cur_edge_part.vertex_from_ );
-                index_t v_to_id = conformal_mesh->edge_vertex(
-                    ElementLocalVertex( cur_edge_part.edge_,
-                        ( cur_edge_part.edge_vertex_ + 1 ) % 2 ) );
-                const vec3& v_to = conformal_mesh->vertex( v_to_id );
-                well_part_points.push_back( v_from );
+                throw RINGMeshException( "Wells", "Well ",
+                    trajectories.names[w], " has less than 2 vertices" );
+            }
+            new_wells.push_back( w );
+            first_edges.push_back(
+                first_edges.back() + offsets[w + 1] - offsets[w] - 1 );
+        }
 
-                const auto& edges = edges_around_vertices[v_to_id];
-                if( edges.size() == 2 )
-                {
-                    process_linear_edges(
-                        edges, edge_visited, *conformal_mesh, S_part, v_to_id );
-                }
-                else
+        auto vertex = [&trajectories]( index_t v ) {
+            return vec3{ trajectories.x[v], trajectories.y[v],
+                trajectories.z[v] };
+        };
+        std::vector< Geometry::Segment3D > segments;
+        segments.reserve( first_edges.back() );
+        for( auto w : new_wells )
+        {
+            for( auto v : range( offsets[w], offsets[w + 1] - 1 ) )
+            {
+                segments.emplace_back( vertex( v ), vertex( v + 1 ) );
+            }
+        }
+        auto edge_intersections =
+            surfaces_aabb().segment_intersections( segments );
+
+        const auto nb_new_wells = static_cast< index_t >( new_wells.size() );
+        std::vector< std::unique_ptr< Well3D > > built_wells( nb_new_wells );
+        std::vector< std::string > errors( nb_new_wells );
+        const auto& geomodel = *geomodel_;
+        parallel_for( nb_new_wells,
+            [&trajectories, &new_wells, &first_edges, &edge_intersections,
+                &built_wells, &errors, &geomodel, &vertex]( index_t i ) {
+                const auto w = new_wells[i];
+                const auto first_vertex = trajectories.offsets[w];
+                const auto nb_vertices =
+                    trajectories.offsets[w + 1] - first_vertex;
+                try
                 {
-                    well_part_points.push_back( v_to );
-                    create_well_part_and_corners( *geomodel(), new_well,
-                        well_part_points, vertex_info[cur_edge.vertex_from_],
-                        vertex_info[v_to_id] );
-                    for( auto edge : edges )
+                    auto mesh = LineMesh3D::create_mesh();
+                    auto builder = LineMeshBuilder3D::create_builder( *mesh );
+                    builder->create_vertices( nb_vertices );
+                    for( auto v : range( nb_vertices ) )
+                    {
+                        builder->set_vertex( v, vertex( first_vertex + v ) );
+                    }
+                    builder->create_edges( nb_vertices - 1 );
+                    for( auto e : range( nb_vertices - 1 ) )
                     {
-                        S.emplace( *conformal_mesh, edge, v_to_id );
+                        builder->set_edge_vertex( { e, 0 }, e );
+                        builder->set_edge_vertex( { e, 1 }, e + 1 );
                     }
+                    auto conformal_mesh = LineMesh3D::create_mesh();
+                    build_conformal_mesh( *mesh, edge_intersections,
+                        first_edges[i], geomodel.epsilon(), *conformal_mesh );
+                    built_wells[i].reset( new Well3D );
+                    built_wells[i]->set_name( trajectories.names[w] );
+                    build_well( geomodel, *conformal_mesh, *built_wells[i] );
                 }
-            } while( !S_part.empty() );
-        } while( !S.empty() );
+                catch( const std::exception& e )
+                {
+                    errors[i] = e.what();
+                }
+            } );
+
+        for( auto i : range( nb_new_wells ) )
+        {
+            if( !errors[i].empty() )
+            {
+                throw RINGMeshException( "Wells", "Failed to build well ",
+                    trajectories.names[new_wells[i]], ": ", errors[i] );
+            }
+        }
+        wells_.reserve( wells_.size() + nb_new_wells );
+        for( auto& new_well : built_wells )
+        {
+            wells_.push_back( new_well.release() );
+        }
     }
 
     template < index_t DIMENSION >
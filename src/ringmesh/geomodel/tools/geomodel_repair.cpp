@@ -33,10 +33,13 @@
  *     FRANCE
  */
 
+#include <algorithm>
 #include <array>
 
 #include <geogram/basic/algorithm.h>
 
+#include <ringmesh/basic/task_handler.h>
+
 #include <ringmesh/geomodel/builder/geomodel_builder.h>
 #include <ringmesh/geomodel/core/geomodel_mesh_entity.h>
 #include <ringmesh/geomodel/tools/geomodel_repair.h>
@@ -57,6 +60,692 @@ namespace
 {
     using namespace RINGMesh;
 
+    /// Number of mesh elements checked by one repair detection task
+    static const index_t REPAIR_CHUNK_SIZE = 1024;
+
+    /*!
+     * @brief Vertices or mesh elements of a GeoModelMeshEntity to delete
+     */
+    struct EntityDeletions
+    {
+        gmme_id entity;
+        std::vector< bool > to_delete;
+        index_t nb_to_delete{ 0 };
+    };
+
+    /*!
+     * @brief Colocated vertices of a GeoModelMeshEntity to delete
+     * @details Before the deletion, the mesh elements are redirected to
+     * the vertices given by the colocated index mapping.
+     */
+    struct ColocatedVertices : public EntityDeletions
+    {
+        std::vector< index_t > colocated;
+    };
+
+    /*!
+     * @brief Keeps the entities having something to delete
+     */
+    template < typename DELETIONS >
+    std::vector< DELETIONS > entities_with_deletions(
+        std::vector< DELETIONS > deletions )
+    {
+        deletions.erase( std::remove_if( deletions.begin(), deletions.end(),
+                             []( const DELETIONS& entity ) {
+                                 return entity.nb_to_delete == 0;
+                             } ),
+            deletions.end() );
+        return deletions;
+    }
+
+    /*!
+     * @brief Runs an action on the mesh elements of GeoModelMeshEntities
+     * @details The elements are processed by chunks spread on
+     * the available threads.
+     * @param[in] action functor called as action( e, begin, end ), \p e
+     * being an index in \p entities and [\p begin, \p end) a range of
+     * mesh elements of this entity
+     */
+    template < typename ENTITY, typename ACTION >
+    void parallel_for_mesh_elements(
+        const std::vector< const ENTITY* >& entities, const ACTION& action )
+    {
+        struct ElementChunk
+        {
+            index_t entity;
+            index_t begin;
+            index_t end;
+        };
+        std::vector< ElementChunk > chunks;
+        for( auto e : range( entities.size() ) )
+        {
+            auto nb_elements = entities[e]->nb_mesh_elements();
+            for( index_t begin = 0; begin < nb_elements;
+                 begin += REPAIR_CHUNK_SIZE )
+            {
+                chunks.push_back( { e, begin,
+                    std::min( nb_elements, begin + REPAIR_CHUNK_SIZE ) } );
+            }
+        }
+        parallel_for( static_cast< index_t >( chunks.size() ),
+            [&chunks, &action]( index_t c ) {
+                const auto& chunk = chunks[c];
+                action( chunk.entity, chunk.begin, chunk.end );
+            } );
+    }
+
+    template < index_t DIMENSION >
+    bool polygon_is_degenerate( const SurfaceMesh< DIMENSION >& surface,
+        index_t polygon_id,
+        double epsilon )
+    {
+        if( surface.polygon_area( polygon_id ) < epsilon * epsilon )
+        {
+            return true;
+        }
+
+        auto min_length = epsilon;
+        for( auto c : range( surface.nb_polygon_vertices( polygon_id ) ) )
+        {
+            if( surface.polygon_edge_length( { polygon_id, c } )
+                < min_length )
+            {
+                return false;
+            }
+        }
+        return false;
+    }
+
+    template < index_t DIMENSION >
+    void detect_bad_facets( const SurfaceMesh< DIMENSION >& surface,
+        double epsilon,
+        std::vector< bool >& remove_polygon )
+    {
+        const auto& polygon_search = surface.polygon_nn_search();
+        index_t nb_duplicates;
+        std::vector< index_t > mapping;
+        std::tie( nb_duplicates, mapping ) =
+            polygon_search.get_colocated_index_mapping( epsilon );
+        for( auto p : range( surface.nb_polygons() ) )
+        {
+            if( mapping[p] != p )
+            {
+                remove_polygon[p] = true;
+                // Check if duplicated polygons are adjacent
+                for( auto v : range( surface.nb_polygon_vertices( p ) ) )
+                {
+                    if( surface.polygon_adjacent( { p, v } ) == mapping[p] )
+                    {
+                        // If the duplicated polygons are adjacent, the
+                        // shared
+                        // edges will become a non-manifold edge.
+                        // The two polygons should be removed.
+                        remove_polygon[mapping[p]] = true;
+                        break;
+                    }
+                }
+            }
+        }
+
+        index_t nb_degenerate = 0;
+        for( auto p : range( surface.nb_polygons() ) )
+        {
+            if( !remove_polygon[p]
+                && polygon_is_degenerate( surface, p, epsilon ) )
+            {
+                nb_degenerate++;
+                remove_polygon[p] = true;
+            }
+        }
+        if( nb_duplicates != 0 || nb_degenerate != 0 )
+        {
+            Logger::out( "Repair", "Detected ", nb_duplicates,
+                " duplicate and ", nb_degenerate, " degenerate facets." );
+        }
+    }
+
+    template < index_t DIMENSION >
+    void remove_duplicated_or_degenerated_polygons(
+        const SurfaceMesh< DIMENSION >& surface,
+        SurfaceMeshBuilder< DIMENSION >& builder,
+        double epsilon )
+    {
+        std::vector< bool > remove_polygon( surface.nb_polygons(), false );
+        detect_bad_facets( surface, epsilon, remove_polygon );
+        builder.delete_polygons( remove_polygon, false );
+        for( auto p : range( surface.nb_polygons() ) )
+        {
+            for( auto v : range( surface.nb_polygon_vertices( p ) ) )
+            {
+                builder.set_polygon_adjacent( { p, v }, NO_ID );
+            }
+        }
+        builder.connect_polygons();
+    }
+
+    /*!
+     * \brief Removes the connected components that have an area
+     *  smaller than a given threshold.
+     * \param[in] min_area the connected components with an
+     *  area smaller than this threshold are removed
+     * \param[in] min_polygons the connected components with
+     *  less than \param min_polygons polygons are removed
+     */
+    template < index_t DIMENSION >
+    void remove_small_connected_components(
+        const SurfaceMesh< DIMENSION >& surface,
+        SurfaceMeshBuilder< DIMENSION >& builder,
+        double min_area,
+        index_t min_polygons )
+    {
+        std::vector< index_t > components;
+        index_t nb_components;
+        std::tie( nb_components, components ) =
+            surface.connected_components();
+        if( nb_components == 0 )
+        {
+            return;
+        }
+        std::vector< double > comp_area( nb_components, 0.0 );
+        std::vector< index_t > comp_polygons( nb_components, 0 );
+        for( auto p : range( surface.nb_polygons() ) )
+        {
+            comp_area[components[p]] += surface.polygon_area( p );
+            ++comp_polygons[components[p]];
+        }
+
+        std::vector< bool > polygon_to_delete(
+            surface.nb_polygons(), false );
+        for( auto p : range( surface.nb_polygons() ) )
+        {
+            auto component = components[p];
+            if( comp_area[component] < min_area
+                || comp_polygons[component] < min_polygons )
+            {
+                polygon_to_delete[p] = true;
+            }
+        }
+        builder.delete_polygons( polygon_to_delete, true );
+    }
+
+    /*!
+     * @brief Removes the duplicated and degenerate polygons of a Surface
+     * mesh, then its small connected components
+     */
+    template < index_t DIMENSION >
+    void clean_surface_mesh( const SurfaceMesh< DIMENSION >& surface,
+        SurfaceMeshBuilder< DIMENSION >& builder,
+        double epsilon )
+    {
+        remove_duplicated_or_degenerated_polygons( surface, builder, epsilon );
+        remove_small_connected_components(
+            surface, builder, epsilon * epsilon, 3 );
+    }
+
+    /*!
+     * @brief Detects what the repair processes would change in a GeoModel
+     * @details The detection runs in parallel per GeoModelMeshEntity and per
+     * chunk of mesh elements. The GeoModel is not modified, apart from
+     * the lazy construction of the entity vertex NNSearch.
+     */
+    template < index_t DIMENSION >
+    class GeoModelRepairDetection
+    {
+        ringmesh_disable_copy_and_move( GeoModelRepairDetection );
+        ringmesh_template_assert_2d_or_3d( DIMENSION );
+
+    public:
+        explicit GeoModelRepairDetection(
+            const GeoModel< DIMENSION >& geomodel )
+            : geomodel_( geomodel )
+        {
+        }
+
+        /*!
+         * @brief Detects the colocated vertices to delete in the
+         * GeoModelMeshEntities of a given type
+         * @return the entities with vertices to delete, by increasing index
+         */
+        std::vector< ColocatedVertices > colocated_entity_vertices(
+            const MeshEntityType& type ) const
+        {
+            auto epsilon = geomodel_.epsilon();
+            std::vector< ColocatedVertices > entities(
+                geomodel_.nb_mesh_entities( type ) );
+            parallel_for( static_cast< index_t >( entities.size() ),
+                [this, &type, &entities, epsilon]( index_t e ) {
+                    auto& entity = entities[e];
+                    entity.entity = gmme_id( type, e );
+                    const auto& kdtree =
+                        geomodel_.mesh_entity( entity.entity )
+                            .vertex_nn_search();
+                    std::tie( std::ignore, entity.colocated ) =
+                        kdtree.get_colocated_index_mapping( epsilon );
+
+                    // Get the vertices to delete
+                    auto inside_border =
+                        vertices_on_inside_boundary( entity.entity );
+                    entity.to_delete.resize( entity.colocated.size(), false );
+                    for( auto v : range( entity.colocated.size() ) )
+                    {
+                        // Colocated vertices on an inside boundary are kept
+                        if( entity.colocated[v] != v
+                            && inside_border.find( v ) == inside_border.end() )
+                        {
+                            entity.to_delete[v] = true;
+                            entity.nb_to_delete++;
+                        }
+                    }
+                } );
+            return entities_with_deletions( std::move( entities ) );
+        }
+
+        /*!
+         * @brief Detects the edges of the Lines whose vertices are colocated
+         * @return the Lines with degenerate edges, by increasing index
+         */
+        std::vector< EntityDeletions > degenerate_line_edges() const
+        {
+            std::vector< const Line< DIMENSION >* > lines;
+            for( const auto& line : geomodel_.lines() )
+            {
+                lines.push_back( &line );
+            }
+            return degenerate_mesh_elements(
+                lines, [this]( const Line< DIMENSION >& line, index_t edge,
+                           const std::vector< index_t >& colocated ) {
+                    return edge_is_degenerate( line, edge, colocated );
+                } );
+        }
+
+        /*!
+         * @brief Detects the polygons of the Surfaces having colocated
+         * vertices
+         * @return the Surfaces with degenerate polygons, by increasing index
+         */
+        std::vector< EntityDeletions > degenerate_surface_polygons() const
+        {
+            std::vector< const Surface< DIMENSION >* > surfaces;
+            for( const auto& surface : geomodel_.surfaces() )
+            {
+                surfaces.push_back( &surface );
+            }
+            return degenerate_mesh_elements( surfaces,
+                [this]( const Surface< DIMENSION >& surface, index_t polygon,
+                    const std::vector< index_t >& colocated ) {
+                    return polygon_is_degenerate( surface, polygon, colocated );
+                } );
+        }
+
+        /*!
+         * @brief Detects the Lines whose boundaries do not follow the way of
+         * their vertex indices
+         */
+        std::vector< index_t > lines_with_wrong_boundary_order() const
+        {
+            std::vector< char > wrong_order( geomodel_.nb_lines(), 0 );
+            parallel_for( geomodel_.nb_lines(), [this, &wrong_order](
+                                                    index_t line ) {
+                wrong_order[line] =
+                    !geomodel_.line( line ).is_first_corner_first_vertex();
+            } );
+            std::vector< index_t > lines;
+            for( auto line : range( geomodel_.nb_lines() ) )
+            {
+                if( wrong_order[line] )
+                {
+                    lines.push_back( line );
+                }
+            }
+            return lines;
+        }
+
+        /*!
+         * @brief Detects the vertices of the GeoModelMeshEntities that are
+         * not used by any mesh element
+         */
+        std::vector< EntityDeletions > isolated_entity_vertices() const
+        {
+            auto entities = entities_with_isolated_vertices_check();
+            std::vector< EntityDeletions > isolated( entities.size() );
+            parallel_for( static_cast< index_t >( entities.size() ),
+                [&entities, &isolated]( index_t e ) {
+                    const auto& entity = *entities[e];
+                    auto& vertices = isolated[e];
+                    vertices.entity = entity.gmme();
+                    vertices.to_delete.resize( entity.nb_vertices(), true );
+                    for( auto element : range( entity.nb_mesh_elements() ) )
+                    {
+                        for( auto vertex : range(
+                                 entity.nb_mesh_element_vertices( element ) ) )
+                        {
+                            vertices
+                                .to_delete[entity.mesh_element_vertex_index(
+                                    { element, vertex } )] = false;
+                        }
+                    }
+                    vertices.nb_to_delete = static_cast< index_t >(
+                        std::count( vertices.to_delete.begin(),
+                            vertices.to_delete.end(), true ) );
+                } );
+            return entities_with_deletions( std::move( isolated ) );
+        }
+
+        /*!
+         * @brief Logs what a repair would change in the GeoModel
+         * @details Each repair process is evaluated on the current GeoModel,
+         * as if it was the first one applied.
+         */
+        RepairReport report( RepairMode repair_mode ) const
+        {
+            RepairReport changes;
+            auto all = repair_mode == RepairMode::ALL;
+            if( all || repair_mode == RepairMode::COLOCATED_VERTICES )
+            {
+                for( const auto& type :
+                    { Line< DIMENSION >::type_name_static(),
+                        Surface< DIMENSION >::type_name_static() } )
+                {
+                    for( const auto& entity :
+                        colocated_entity_vertices( type ) )
+                    {
+                        Logger::out( "Repair", entity.nb_to_delete,
+                            " colocated vertices to delete in ",
+                            entity.entity );
+                        changes.nb_colocated_vertices += entity.nb_to_delete;
+                    }
+                }
+            }
+            if( all || repair_mode == RepairMode::DEGENERATE_POLYGONS_EDGES )
+            {
+                for( const auto& line : degenerate_line_edges() )
+                {
+                    Logger::out( "Repair", line.nb_to_delete,
+                        " degenerated edges to remove in ", line.entity );
+                    changes.nb_degenerate_edges += line.nb_to_delete;
+                }
+                for( const auto& polygons : degenerate_surface_polygons() )
+                {
+                    auto nb_removed = nb_removed_surface_polygons(
+                        geomodel_.surface( polygons.entity.index() ) );
+                    Logger::out( "Repair", nb_removed,
+                        " degenerated polygons to remove in ",
+                        polygons.entity );
+                    changes.nb_degenerate_polygons += nb_removed;
+                }
+            }
+            if( all || repair_mode == RepairMode::LINE_BOUNDARY_ORDER )
+            {
+                for( auto line : lines_with_wrong_boundary_order() )
+                {
+                    Logger::out( "Repair", "Boundaries to switch in ",
+                        geomodel_.line( line ).gmme() );
+                    changes.nb_lines_with_wrong_boundary_order++;
+                }
+            }
+            if( all || repair_mode == RepairMode::ISOLATED_VERTICES )
+            {
+                for( const auto& entity : isolated_entity_vertices() )
+                {
+                    Logger::out( "Repair", entity.nb_to_delete,
+                        " isolated vertices to delete in ", entity.entity );
+                    changes.nb_isolated_vertices += entity.nb_to_delete;
+                }
+            }
+            return changes;
+        }
+
+    private:
+        /*!
+         * @brief Counts the polygons that the repair of the degenerate
+         * polygons removes from a Surface
+         * @details The duplicated polygons and the small connected components
+         * are removed too, so the repair is run on a copy of the Surface mesh.
+         */
+        index_t nb_removed_surface_polygons(
+            const Surface< DIMENSION >& surface ) const
+        {
+            if( surface.nb_vertices() == 0 )
+            {
+                return 0;
+            }
+            auto mesh = SurfaceMesh< DIMENSION >::create_mesh(
+                surface.mesh().type_name() );
+            auto builder =
+                SurfaceMeshBuilder< DIMENSION >::create_builder( *mesh );
+            builder->copy( surface.mesh(), false );
+            clean_surface_mesh( *mesh, *builder, geomodel_.epsilon() );
+            return surface.nb_mesh_elements() - mesh->nb_polygons();
+        }
+
+        /*!
+         * @brief Detects the degenerate mesh elements of entities
+         * @param[in] is_degenerate functor called as
+         * is_degenerate( entity, element, colocated ), \p colocated being
+         * the colocated index mapping of the entity vertices
+         */
+        template < typename ENTITY, typename TEST >
+        std::vector< EntityDeletions > degenerate_mesh_elements(
+            const std::vector< const ENTITY* >& entities,
+            const TEST& is_degenerate ) const
+        {
+            auto epsilon = geomodel_.epsilon();
+            std::vector< std::vector< index_t > > colocated( entities.size() );
+            std::vector< std::vector< char > > degenerate( entities.size() );
+            parallel_for( static_cast< index_t >( entities.size() ),
+                [&entities, &colocated, &degenerate, epsilon]( index_t e ) {
+                    const auto& nn_search = entities[e]->vertex_nn_search();
+                    std::tie( std::ignore, colocated[e] ) =
+                        nn_search.get_colocated_index_mapping( epsilon );
+                    degenerate[e].resize( entities[e]->nb_mesh_elements(), 0 );
+                } );
+            parallel_for_mesh_elements(
+                entities, [&entities, &colocated, &degenerate, &is_degenerate](
+                              index_t e, index_t begin, index_t end ) {
+                    for( auto element : range( begin, end ) )
+                    {
+                        degenerate[e][element] = is_degenerate(
+                            *entities[e], element, colocated[e] );
+                    }
+                } );
+            std::vector< EntityDeletions > deletions( entities.size() );
+            for( auto e : range( entities.size() ) )
+            {
+                deletions[e].entity = entities[e]->gmme();
+                deletions[e].to_delete.assign(
+                    degenerate[e].begin(), degenerate[e].end() );
+                deletions[e].nb_to_delete = static_cast< index_t >( std::count(
+                    degenerate[e].begin(), degenerate[e].end(), 1 ) );
+            }
+            return entities_with_deletions( std::move( deletions ) );
+        }
+
+        /*!
+         * @brief Gets the GeoModelMeshEntities from which isolated vertices
+         * are removed
+         */
+        std::vector< const GeoModelMeshEntity< DIMENSION >* >
+            entities_with_isolated_vertices_check() const;
+        void add_lines(
+            std::vector< const GeoModelMeshEntity< DIMENSION >* >& entities )
+            const
+        {
+            for( const auto& line : geomodel_.lines() )
+            {
+                entities.push_back( &line );
+            }
+        }
+
+        /*!
+         * \note Copied and modified from geogram\mesh\mesh_repair.cpp
+         *
+         * @brief Tests whether a polygon is degenerate.
+         * @param[in] surface the Surface that the polygon belongs to
+         * @param[in] polygon_id the index of the polygon in \p S
+         * @param[in] colocated_vertices contains the colocated mapping of the
+         * Surface.
+         * \return true if polygon \p f has duplicated vertices,
+         *  false otherwise
+         */
+        bool polygon_is_degenerate( const Surface< DIMENSION >& surface,
+            index_t polygon_id,
+            const std::vector< index_t >& colocated_vertices ) const
+        {
+            auto nb_vertices = surface.nb_mesh_element_vertices( polygon_id );
+            if( nb_vertices != 3 )
+            {
+                std::vector< index_t > vertices( nb_vertices );
+                for( auto v : range( nb_vertices ) )
+                {
+                    vertices[v] =
+                        colocated_vertices[surface.mesh_element_vertex_index(
+                            ElementLocalVertex( polygon_id, v ) )];
+                }
+                GEO::sort_unique( vertices );
+                return vertices.size() != nb_vertices;
+            }
+            auto v1 = colocated_vertices[surface.mesh_element_vertex_index(
+                { polygon_id, 0 } )];
+            auto v2 = colocated_vertices[surface.mesh_element_vertex_index(
+                { polygon_id, 1 } )];
+            auto v3 = colocated_vertices[surface.mesh_element_vertex_index(
+                { polygon_id, 2 } )];
+            return v1 == v2 || v2 == v3 || v3 == v1;
+        }
+
+        /*!
+         * @brief Checks if an edge is degenerate.
+         *
+         * An edge is degenerate if both vertices are colocated.
+         *
+         * @param[in] line Line to check the edge \p edge.
+         * @param[in] edge edge index in Line \p line.
+         * @param[in] colocated_vertices contains the colocated mapping of the
+         * Line.
+         * @return true if the edge is degenerate. Else false.
+         */
+        bool edge_is_degenerate( const Line< DIMENSION >& line,
+            index_t edge,
+            const std::vector< index_t >& colocated_vertices ) const
+        {
+            auto v1 = colocated_vertices[line.mesh_element_vertex_index(
+                { edge, 0 } )];
+            auto v2 = colocated_vertices[line.mesh_element_vertex_index(
+                { edge, 1 } )];
+            return v1 == v2;
+        }
+
+        /*!
+         * Get the indices of the duplicated vertices that are on an inside
+         * border.
+         * Only the vertex with the biggest index are added.
+         * @param[in] E_id GeoModelMeshEntity to check.
+         * @return vector of the vertex indexes on an inside boundary.
+         */
+        std::set< index_t > vertices_on_inside_boundary(
+            const gmme_id& E_id ) const
+        {
+            std::set< index_t > vertices;
+            if( E_id.type() == Corner< DIMENSION >::type_name_static() )
+            {
+                return vertices;
+            }
+            const auto& mesh_entity = geomodel_.mesh_entity( E_id );
+            if( E_id.type() == Line< DIMENSION >::type_name_static() )
+            {
+                if( mesh_entity.boundary( 0 ).is_inside_border( mesh_entity ) )
+                {
+                    vertices.insert( mesh_entity.nb_vertices() - 1 );
+                }
+                return vertices;
+            }
+            std::vector< const GeoModelMeshEntity< DIMENSION >* > inside_border;
+            for( auto i : range( mesh_entity.nb_boundaries() ) )
+            {
+                if( mesh_entity.boundary( i ).is_inside_border( mesh_entity ) )
+                {
+                    inside_border.push_back(
+                        dynamic_cast< const GeoModelMeshEntity< DIMENSION >* >(
+                            &mesh_entity.boundary( i ) ) );
+                }
+            }
+            if( !inside_border.empty() )
+            {
+                // We want to get the indices of the vertices in E
+                // that are colocated with those of the inside boundary
+                // We assume that the geomodel vertices are not computed
+                const auto& nn_search = mesh_entity.vertex_nn_search();
+
+                for( const auto& entity : inside_border )
+                {
+                    for( auto v : range( entity->nb_vertices() ) )
+                    {
+                        auto colocated_indices = nn_search.get_neighbors(
+                            entity->vertex( v ), geomodel_.epsilon() );
+                        if( colocated_indices.size() > 1 )
+                        {
+                            std::sort( colocated_indices.begin(),
+                                colocated_indices.end() );
+                            // Add colocated vertices except one to the
+                            // duplicated
+                            // vertices set
+                            vertices.insert( colocated_indices.begin() + 1,
+                                colocated_indices.end() );
+                        }
+                    }
+                }
+            }
+            return vertices;
+        }
+
+    private:
+        const GeoModel< DIMENSION >& geomodel_;
+    };
+
+    template <>
+    std::vector< const GeoModelMeshEntity< 3 >* >
+        GeoModelRepairDetection< 3 >::entities_with_isolated_vertices_check()
+            const
+    {
+        std::vector< const GeoModelMeshEntity< 3 >* > entities;
+        add_lines( entities );
+        for( const auto& surface : geomodel_.surfaces() )
+        {
+            entities.push_back( &surface );
+        }
+        for( const auto& region : geomodel_.regions() )
+        {
+            if( region.is_meshed() )
+            {
+                entities.push_back( &region );
+            }
+        }
+        return entities;
+    }
+
+    template <>
+    std::vector< const GeoModelMeshEntity< 2 >* >
+        GeoModelRepairDetection< 2 >::entities_with_isolated_vertices_check()
+            const
+    {
+        std::vector< const GeoModelMeshEntity< 2 >* > entities;
+        add_lines( entities );
+        for( const auto& surface : geomodel_.surfaces() )
+        {
+            if( surface.is_meshed() )
+            {
+                entities.push_back( &surface );
+            }
+        }
+        return entities;
+    }
+
+    /*!
+     * @brief Repairs a GeoModel
+     * @details The changes of each repair process are detected in parallel
+     * by a GeoModelRepairDetection, then applied entity after entity in
+     * increasing index order.
+     */
     template < index_t DIMENSION >
     class GeoModelRepair
     {
@@ -65,7 +754,9 @@ namespace
 
     public:
         GeoModelRepair( GeoModel< DIMENSION >& geomodel )
-            : builder_( geomodel ), geomodel_( geomodel )
+            : builder_( geomodel ),
+              geomodel_( geomodel ),
+              detection_( geomodel )
         {
         }
 
@@ -181,173 +872,27 @@ namespace
          */
         void repair_line_boundary_vertex_order()
         {
-            for( const auto& line : geomodel_.lines() )
+            for( auto line_id : detection_.lines_with_wrong_boundary_order() )
             {
-                if( !line.is_first_corner_first_vertex() )
-                {
-                    const auto first_boundary_index =
-                        line.boundary( 0 ).index();
-                    builder_.topology.set_line_corner_boundary(
-                        line.gmme().index(), 0,
-                        line.boundary_gmme( 1 ).index() );
-                    builder_.topology.set_line_corner_boundary(
-                        line.gmme().index(), 1, first_boundary_index );
-                }
+                const auto& line = geomodel_.line( line_id );
+                const auto first_boundary_index = line.boundary( 0 ).index();
+                builder_.topology.set_line_corner_boundary(
+                    line_id, 0, line.boundary_gmme( 1 ).index() );
+                builder_.topology.set_line_corner_boundary(
+                    line_id, 1, first_boundary_index );
             }
         }
 
         /*!
          * @brief remove isolated vertices on GeoModelMeshEntities
          */
-        void remove_isolated_vertices();
-        void remove_isolated_vertices_base()
-        {
-            for( const auto& line : geomodel_.lines() )
-            {
-                remove_isolated_vertices_on_mesh_entity( line );
-            }
-        }
-
-        /*!
-         * @brief remove isolated vertices on a GeoModelMeshEntity
-         * @param[in] geomodel_mesh_entity The GeoModelMeshEntity to repair
-         */
-        void remove_isolated_vertices_on_mesh_entity(
-            const GeoModelMeshEntity< DIMENSION >& geomodel_mesh_entity )
-        {
-            std::vector< bool > vertices_to_delete(
-                geomodel_mesh_entity.nb_vertices(), true );
-            for( auto mesh_element_index :
-                range( geomodel_mesh_entity.nb_mesh_elements() ) )
-            {
-                for( auto vertex :
-                    range( geomodel_mesh_entity.nb_mesh_element_vertices(
-                        mesh_element_index ) ) )
-                {
-                    vertices_to_delete
-                        [geomodel_mesh_entity.mesh_element_vertex_index(
-                            { mesh_element_index, vertex } )] = false;
-                }
-            }
-            builder_.geometry.delete_mesh_entity_vertices(
-                geomodel_mesh_entity.gmme(), vertices_to_delete );
-        }
-
-        /*!
-         * @brief Detect and remove degenerate edges in a \param line.
-         * @return the number of degenerate edges that have been removed from
-         * the line.
-         */
-        index_t repair_line_mesh( const Line< DIMENSION >& line )
-        {
-            std::vector< index_t > colocated;
-            const auto& nn_search = line.vertex_nn_search();
-            std::tie( std::ignore, colocated ) =
-                nn_search.get_colocated_index_mapping( geomodel_.epsilon() );
-
-            auto degenerate = line_detect_degenerate_edges( line, colocated );
-            auto nb = static_cast< index_t >(
-                std::count( degenerate.begin(), degenerate.end(), 1 ) );
-            /// We have a problem if some vertices are left isolated
-            /// If we remove them here we can kill all index correspondences
-            builder_.geometry.delete_line_edges(
-                line.index(), degenerate, false );
-            return nb;
-        }
-
-        /*!
-         * @return a vector of boolean. Element i of this vector corresponds
-         * to the edge i of the line. If the element is true, the edge is
-         * degenerated.
-         */
-        std::vector< bool > line_detect_degenerate_edges(
-            const Line< DIMENSION >& line,
-            std::vector< index_t >& colocated_vertices )
-        {
-            std::vector< bool > e_is_degenerate( line.nb_mesh_elements() );
-            for( auto e : range( line.nb_mesh_elements() ) )
-            {
-                e_is_degenerate[e] =
-                    edge_is_degenerate( line, e, colocated_vertices );
-            }
-            return e_is_degenerate;
-        }
-
-        /*!
-         * \note Copied and modified from geogram\mesh\mesh_repair.cpp.
-         * @return a vector of boolean. Element i of this vector corresponds
-         * to the facet i of the surface. If the element is true, the facet is
-         * degenerated.
-         */
-        std::vector< index_t > surface_detect_degenerate_polygons(
-            const Surface< DIMENSION >& surface,
-            std::vector< index_t >& colocated_vertices )
-        {
-            std::vector< index_t > f_is_degenerate(
-                surface.nb_mesh_elements() );
-            for( auto p : range( surface.nb_mesh_elements() ) )
-            {
-                f_is_degenerate[p] =
-                    polygon_is_degenerate( surface, p, colocated_vertices );
-            }
-            return f_is_degenerate;
-        }
-
-        /*!
-         * \note Copied and modified from geogram\mesh\mesh_repair.cpp
-         *
-         * @brief Tests whether a polygon is degenerate.
-         * @param[in] surface the Surface that the polygon belongs to
-         * @param[in] polygon_id the index of the polygon in \p S
-         * @param[out] colocated_vertices contains the found colocated vertices
-         * in \p f if any.
-         * \return true if polygon \p f has duplicated vertices,
-         *  false otherwise
-         */
-        bool polygon_is_degenerate( const Surface< DIMENSION >& surface,
-            index_t polygon_id,
-            std::vector< index_t >& colocated_vertices )
+        void remove_isolated_vertices()
         {
-            auto nb_vertices = surface.nb_mesh_element_vertices( polygon_id );
-            if( nb_vertices != 3 )
+            for( const auto& isolated : detection_.isolated_entity_vertices() )
             {
-                std::vector< index_t > vertices( nb_vertices );
-                for( auto v : range( nb_vertices ) )
-                {
-                    vertices[v] =
-                        colocated_vertices[surface.mesh_element_vertex_index(
-                            ElementLocalVertex( polygon_id, v ) )];
-                }
-                GEO::sort_unique( vertices );
-                return vertices.size() != nb_vertices;
+                builder_.geometry.delete_mesh_entity_vertices(
+                    isolated.entity, isolated.to_delete );
             }
-            auto v1 = colocated_vertices[surface.mesh_element_vertex_index(
-                { polygon_id, 0 } )];
-            auto v2 = colocated_vertices[surface.mesh_element_vertex_index(
-                { polygon_id, 1 } )];
-            auto v3 = colocated_vertices[surface.mesh_element_vertex_index(
-                { polygon_id, 2 } )];
-            return v1 == v2 || v2 == v3 || v3 == v1;
-        }
-
-        /*!
-         * @brief Detect and remove degenerated polygons in a Surface
-         * @param[in,out] surface Surface to check for potential degenerate
-         * polygons.
-         * @return the number of degenerate polygons in \p surface.
-         */
-        index_t detect_degenerate_polygons(
-            const Surface< DIMENSION >& surface )
-        {
-            std::vector< index_t > colocated;
-            const auto& nn_search = surface.vertex_nn_search();
-            std::tie( std::ignore, colocated ) =
-                nn_search.get_colocated_index_mapping( geomodel_.epsilon() );
-
-            auto degenerate =
-                surface_detect_degenerate_polygons( surface, colocated );
-            return static_cast< index_t >(
-                std::count( degenerate.begin(), degenerate.end(), 1 ) );
         }
 
         /*!
@@ -361,170 +906,40 @@ namespace
             std::set< gmme_id >& to_remove )
         {
             to_remove.clear();
-            for( const auto& line : geomodel_.lines() )
+            for( const auto& edges : detection_.degenerate_line_edges() )
             {
-                auto nb = repair_line_mesh( line );
-                if( nb > 0 )
+                const auto& line = geomodel_.line( edges.entity.index() );
+                /// We have a problem if some vertices are left isolated
+                /// If we remove them here we can kill all index correspondences
+                builder_.geometry.delete_line_edges(
+                    line.index(), edges.to_delete, false );
+                Logger::out( "Repair", edges.nb_to_delete,
+                    " degenerated edges removed in ", line.gmme() );
+                // If the Line is set it to remove
+                if( line.nb_mesh_elements() == 0 )
                 {
-                    Logger::out( "Repair", nb, " degenerated edges removed in ",
-                        line.gmme() );
-                    // If the Line is set it to remove
-                    if( line.nb_mesh_elements() == 0 )
-                    {
-                        to_remove.insert( line.gmme() );
-                    }
+                    to_remove.insert( line.gmme() );
                 }
             }
-            double epsilon_sq = geomodel_.epsilon() * geomodel_.epsilon();
-            for( const auto& surface : geomodel_.surfaces() )
+            for( const auto& polygons :
+                detection_.degenerate_surface_polygons() )
             {
-                auto nb = detect_degenerate_polygons( surface );
+                const auto& surface =
+                    geomodel_.surface( polygons.entity.index() );
                 /// @todo Check if that cannot be simplified
-                if( nb > 0 )
-                {
-                    if( surface.nb_vertices() > 0 )
-                    {
-                        auto builder = builder_.geometry.create_surface_builder(
-                            surface.index() );
-                        remove_duplicated_or_degenerated_polygons(
-                            surface.mesh(), *builder );
-                        remove_small_connected_components(
-                            surface.mesh(), *builder, epsilon_sq, 3 );
-                    }
-                    if( surface.nb_vertices() == 0
-                        || surface.nb_mesh_elements() == 0 )
-                    {
-                        to_remove.insert( surface.gmme() );
-                    }
-                }
-            }
-        }
-
-        bool polygon_is_degenerate(
-            const SurfaceMesh< DIMENSION >& surface, index_t polygon_id )
-        {
-            if( surface.polygon_area( polygon_id ) < geomodel_.epsilon2() )
-            {
-                return true;
-            }
-
-            auto min_length = geomodel_.epsilon();
-            for( auto c : range( surface.nb_polygon_vertices( polygon_id ) ) )
-            {
-                if( surface.polygon_edge_length( { polygon_id, c } )
-                    < min_length )
-                {
-                    return false;
-                }
-            }
-            return false;
-        }
-
-        void detect_bad_facets( const SurfaceMesh< DIMENSION >& surface,
-            std::vector< bool >& remove_polygon )
-        {
-            const auto& polygon_search = surface.polygon_nn_search();
-            index_t nb_duplicates;
-            std::vector< index_t > mapping;
-            std::tie( nb_duplicates, mapping ) =
-                polygon_search.get_colocated_index_mapping(
-                    geomodel_.epsilon() );
-            for( auto p : range( surface.nb_polygons() ) )
-            {
-                if( mapping[p] != p )
-                {
-                    remove_polygon[p] = true;
-                    // Check if duplicated polygons are adjacent
-                    for( auto v : range( surface.nb_polygon_vertices( p ) ) )
-                    {
-                        if( surface.polygon_adjacent( { p, v } ) == mapping[p] )
-                        {
-                            // If the duplicated polygons are adjacent, the
-                            // shared
-                            // edges will become a non-manifold edge.
-                            // The two polygons should be removed.
-                            remove_polygon[mapping[p]] = true;
-                            break;
-                        }
-                    }
-                }
-            }
-
-            index_t nb_degenerate = 0;
-            for( auto p : range( surface.nb_polygons() ) )
-            {
-                if( !remove_polygon[p] && polygon_is_degenerate( surface, p ) )
-                {
-                    nb_degenerate++;
-                    remove_polygon[p] = true;
-                }
-            }
-            if( nb_duplicates != 0 || nb_degenerate != 0 )
-            {
-                Logger::out( "Repair", "Detected ", nb_duplicates,
-                    " duplicate and ", nb_degenerate, " degenerate facets." );
-            }
-        }
-
-        void remove_duplicated_or_degenerated_polygons(
-            const SurfaceMesh< DIMENSION >& surface,
-            SurfaceMeshBuilder< DIMENSION >& builder )
-        {
-            std::vector< bool > remove_polygon( surface.nb_polygons(), false );
-            detect_bad_facets( surface, remove_polygon );
-            builder.delete_polygons( remove_polygon, false );
-            for( auto p : range( surface.nb_polygons() ) )
-            {
-                for( auto v : range( surface.nb_polygon_vertices( p ) ) )
+                if( surface.nb_vertices() > 0 )
                 {
-                    builder.set_polygon_adjacent( { p, v }, NO_ID );
+                    auto builder = builder_.geometry.create_surface_builder(
+                        surface.index() );
+                    clean_surface_mesh(
+                        surface.mesh(), *builder, geomodel_.epsilon() );
                 }
-            }
-            builder.connect_polygons();
-        }
-
-        /*!
-         * \brief Removes the connected components that have an area
-         *  smaller than a given threshold.
-         * \param[in] min_area the connected components with an
-         *  area smaller than this threshold are removed
-         * \param[in] min_polygons the connected components with
-         *  less than \param min_polygons polygons are removed
-         */
-        void remove_small_connected_components(
-            const SurfaceMesh< DIMENSION >& surface,
-            SurfaceMeshBuilder< DIMENSION >& builder,
-            double min_area,
-            index_t min_polygons )
-        {
-            std::vector< index_t > components;
-            index_t nb_components;
-            std::tie( nb_components, components ) =
-                surface.connected_components();
-            if( nb_components == 0 )
-            {
-                return;
-            }
-            std::vector< double > comp_area( nb_components, 0.0 );
-            std::vector< index_t > comp_polygons( nb_components, 0 );
-            for( auto p : range( surface.nb_polygons() ) )
-            {
-                comp_area[components[p]] += surface.polygon_area( p );
-                ++comp_polygons[components[p]];
-            }
-
-            std::vector< bool > polygon_to_delete(
-                surface.nb_polygons(), false );
-            for( auto p : range( surface.nb_polygons() ) )
-            {
-                auto component = components[p];
-                if( comp_area[component] < min_area
-                    || comp_polygons[component] < min_polygons )
+                if( surface.nb_vertices() == 0
+                    || surface.nb_mesh_elements() == 0 )
                 {
-                    polygon_to_delete[p] = true;
+                    to_remove.insert( surface.gmme() );
                 }
             }
-            builder.delete_polygons( polygon_to_delete, true );
         }
 
         /*!
@@ -542,45 +957,12 @@ namespace
             };
             for( const auto& type : types )
             {
-                for( auto e : range( geomodel_.nb_mesh_entities( type ) ) )
+                for( const auto& colocated :
+                    detection_.colocated_entity_vertices( type ) )
                 {
-                    gmme_id entity_id{ type, e };
+                    const auto& entity_id = colocated.entity;
                     const auto& E = geomodel_.mesh_entity( entity_id );
-
-                    const auto& kdtree = E.vertex_nn_search();
-                    std::vector< index_t > colocated;
-                    std::tie( std::ignore, colocated ) =
-                        kdtree.get_colocated_index_mapping(
-                            geomodel_.epsilon() );
-
-                    // Get the vertices to delete
-                    auto inside_border =
-                        vertices_on_inside_boundary( entity_id );
-
-                    std::vector< bool > to_delete( colocated.size(), false );
-                    index_t nb_todelete{ 0 };
-                    for( auto v : range( colocated.size() ) )
-                    {
-                        if( colocated[v] == v
-                            || inside_border.find( v ) != inside_border.end() )
-                        {
-                            // This point is kept
-                            // No colocated or on an inside boundary
-                        }
-                        else
-                        {
-                            // The point is to remove
-                            to_delete[v] = true;
-                            nb_todelete++;
-                        }
-                    }
-
-                    if( nb_todelete == 0 )
-                    {
-                        // Nothing to do there
-                        continue;
-                    }
-                    if( nb_todelete == E.nb_vertices() )
+                    if( colocated.nb_to_delete == E.nb_vertices() )
                     {
                         // The complete entity should be removed
                         to_remove.insert( E.gmme() );
@@ -588,37 +970,38 @@ namespace
                     }
                     if( type == Surface< DIMENSION >::type_name_static() )
                     {
-                        auto builder =
-                            builder_.geometry.create_surface_builder( e );
+                        auto builder = builder_.geometry.create_surface_builder(
+                            entity_id.index() );
                         for( auto p_itr : range( E.nb_mesh_elements() ) )
                         {
                             for( auto fpv_itr :
                                 range( E.nb_mesh_element_vertices( p_itr ) ) )
                             {
                                 builder->set_polygon_vertex( { p_itr, fpv_itr },
-                                    colocated[E.mesh_element_vertex_index(
-                                        { p_itr, fpv_itr } )] );
+                                    colocated
+                                        .colocated[E.mesh_element_vertex_index(
+                                            { p_itr, fpv_itr } )] );
                             }
                         }
-                        builder->delete_vertices( to_delete );
-                        Logger::out( "Repair", nb_todelete,
+                        builder->delete_vertices( colocated.to_delete );
+                        Logger::out( "Repair", colocated.nb_to_delete,
                             " colocated vertices deleted in ", entity_id );
                     }
                     else if( type == Line< DIMENSION >::type_name_static() )
                     {
-                        auto builder =
-                            builder_.geometry.create_line_builder( e );
+                        auto builder = builder_.geometry.create_line_builder(
+                            entity_id.index() );
                         for( auto e_itr : range( E.nb_mesh_elements() ) )
                         {
                             builder->set_edge_vertex( { e_itr, 0 },
-                                colocated[E.mesh_element_vertex_index(
+                                colocated.colocated[E.mesh_element_vertex_index(
                                     { e_itr, 0 } )] );
                             builder->set_edge_vertex( { e_itr, 1 },
-                                colocated[E.mesh_element_vertex_index(
+                                colocated.colocated[E.mesh_element_vertex_index(
                                     { e_itr, 1 } )] );
                         }
-                        builder->delete_vertices( to_delete );
-                        Logger::out( "Repair", nb_todelete,
+                        builder->delete_vertices( colocated.to_delete );
+                        Logger::out( "Repair", colocated.nb_to_delete,
                             " colocated vertices deleted in ", entity_id );
                     }
                     else
@@ -629,90 +1012,6 @@ namespace
             }
         }
 
-        /*!
-         * Get the indices of the duplicated vertices that are on an inside
-         * border.
-         * Only the vertex with the biggest index are added.
-         * @param[in] E_id GeoModelMeshEntity to check.
-         * @return vector of the vertex indexes on an inside boundary.
-         */
-        std::set< index_t > vertices_on_inside_boundary( const gmme_id& E_id )
-        {
-            std::set< index_t > vertices;
-            if( E_id.type() == Corner< DIMENSION >::type_name_static() )
-            {
-                return vertices;
-            }
-            const auto& mesh_entity = geomodel_.mesh_entity( E_id );
-            if( E_id.type() == Line< DIMENSION >::type_name_static() )
-            {
-                if( mesh_entity.boundary( 0 ).is_inside_border( mesh_entity ) )
-                {
-                    vertices.insert( mesh_entity.nb_vertices() - 1 );
-                }
-                return vertices;
-            }
-            std::vector< const GeoModelMeshEntity< DIMENSION >* > inside_border;
-            for( auto i : range( mesh_entity.nb_boundaries() ) )
-            {
-                if( mesh_entity.boundary( i ).is_inside_border( mesh_entity ) )
-                {
-                    inside_border.push_back(
-                        dynamic_cast< const GeoModelMeshEntity< DIMENSION >* >(
-                            &mesh_entity.boundary( i ) ) );
-                }
-            }
-            if( !inside_border.empty() )
-            {
-                // We want to get the indices of the vertices in E
-                // that are colocated with those of the inside boundary
-                // We assume that the geomodel vertices are not computed
-                const auto& nn_search = mesh_entity.vertex_nn_search();
-
-                for( const auto& entity : inside_border )
-                {
-                    for( auto v : range( entity->nb_vertices() ) )
-                    {
-                        auto colocated_indices = nn_search.get_neighbors(
-                            entity->vertex( v ), geomodel_.epsilon() );
-                        if( colocated_indices.size() > 1 )
-                        {
-                            std::sort( colocated_indices.begin(),
-                                colocated_indices.end() );
-                            // Add colocated vertices except one to the
-                            // duplicated
-                            // vertices set
-                            vertices.insert( colocated_indices.begin() + 1,
-                                colocated_indices.end() );
-                        }
-                    }
-                }
-            }
-            return vertices;
-        }
-
-        /*!
-         * @brief Checks if an edge is degenerate.
-         *
-         * An edge is degenerate if both vertices are colocated.
-         *
-         * @param[in] line Line to check the edge \p edge.
-         * @param[in] edge edge index in Line \p line.
-         * @param[in] colocated_vertices contains the colocated mapping of the
-         * Line.
-         * @return true if the edge is degenerate. Else false.
-         */
-        bool edge_is_degenerate( const Line< DIMENSION >& line,
-            index_t edge,
-            const std::vector< index_t >& colocated_vertices )
-        {
-            auto v1 = colocated_vertices[line.mesh_element_vertex_index(
-                { edge, 0 } )];
-            auto v2 = colocated_vertices[line.mesh_element_vertex_index(
-                { edge, 1 } )];
-            return v1 == v2;
-        }
-
         void build_contacts()
         {
             builder_.geology.build_contacts();
@@ -721,37 +1020,9 @@ namespace
     private:
         GeoModelBuilder< DIMENSION > builder_;
         GeoModel< DIMENSION >& geomodel_;
+        GeoModelRepairDetection< DIMENSION > detection_;
     };
 
-    template <>
-    void GeoModelRepair< 3 >::remove_isolated_vertices()
-    {
-        remove_isolated_vertices_base();
-        for( const auto& surface : geomodel_.surfaces() )
-        {
-            remove_isolated_vertices_on_mesh_entity( surface );
-        }
-        for( const auto& region : geomodel_.regions() )
-        {
-            if( region.is_meshed() )
-            {
-                remove_isolated_vertices_on_mesh_entity( region );
-            }
-        }
-    }
-
-    template <>
-    void GeoModelRepair< 2 >::remove_isolated_vertices()
-    {
-        remove_isolated_vertices_base();
-        for( const auto& surface : geomodel_.surfaces() )
-        {
-            if( surface.is_meshed() )
-            {
-                remove_isolated_vertices_on_mesh_entity( surface );
-            }
-        }
-    }
 } // namespace
 
 namespace RINGMesh
@@ -764,7 +1035,21 @@ namespace RINGMesh
         repairer.repair( repair_mode );
     }
 
+    template < index_t DIMENSION >
+    RepairReport dry_run_repair_geomodel(
+        const GeoModel< DIMENSION >& geomodel, RepairMode repair_mode )
+    {
+        GeoModelRepairDetection< DIMENSION > detection( geomodel );
+        return detection.report( repair_mode );
+    }
+
     template void geomodel_tools_api repair_geomodel( GeoModel2D&, RepairMode );
 
     template void geomodel_tools_api repair_geomodel( GeoModel3D&, RepairMode );
+
+    template RepairReport geomodel_tools_api dry_run_repair_geomodel(
+        const GeoModel2D&, RepairMode );
+
+    template RepairReport geomodel_tools_api dry_run_repair_geomodel(
+        const GeoModel3D&, RepairMode );
 } // namespace RINGMesh
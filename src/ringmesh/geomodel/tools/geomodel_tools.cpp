@@ -33,14 +33,18 @@
  *     FRANCE
  */
 
+#include <algorithm>
 #include <array>
+#include <condition_variable>
 #include <iomanip>
 #include <iostream>
+#include <mutex>
 
 #include <geogram/basic/command_line.h>
 #include <geogram/basic/progress.h>
 
 #include <ringmesh/basic/geometry.h>
+#include <ringmesh/basic/task_handler.h>
 #include <ringmesh/geomodel/core/geomodel.h>
 #include <ringmesh/geomodel/core/geomodel_entity.h>
 #include <ringmesh/geomodel/core/geomodel_geological_entity.h>
@@ -53,6 +57,170 @@
  * @file Set of high level API functions
  */
 
+namespace
+{
+    using namespace RINGMesh;
+
+    /*!
+     * @brief Makes the Logger quiet until the end of the scope
+     */
+    class QuietLogger
+    {
+        ringmesh_disable_copy_and_move( QuietLogger );
+
+    public:
+        QuietLogger() : status_( Logger::instance()->is_quiet() )
+        {
+            Logger::instance()->set_quiet( true );
+        }
+
+        ~QuietLogger()
+        {
+            Logger::instance()->set_quiet( status_ );
+        }
+
+    private:
+        bool status_;
+    };
+
+    void tetrahedralize_region( GeoModel3D& geomodel,
+        index_t region_id,
+        bool add_steiner_points,
+        const std::vector< vec3 >& internal_vertices,
+        const std::string& method,
+        bool update_geomodel_mesh )
+    {
+        std::unique_ptr< TetraGen > tetragen{ TetraGen::create(
+            geomodel, region_id, method ) };
+        tetragen->set_boundaries(
+            geomodel.region( region_id ), geomodel.wells() );
+        tetragen->set_internal_points( internal_vertices );
+        tetragen->tetrahedralize( add_steiner_points, update_geomodel_mesh );
+    }
+
+    /*!
+     * @brief Hands out the regions to mesh concurrently
+     * @details The regions are handed out by decreasing cost, the cost of
+     * a region being the size of the mesher input (number of boundary
+     * triangles and of internal points). The total cost of the regions
+     * being meshed is kept under a budget (0 for no limit), a region
+     * exceeding the budget is meshed alone.
+     */
+    class RegionMeshingScheduler
+    {
+    public:
+        RegionMeshingScheduler( const GeoModel3D& geomodel,
+            const std::vector< std::vector< vec3 > >& internal_vertices,
+            index_t budget )
+            : costs_( geomodel.nb_regions(), 0 ),
+              budget_( budget ),
+              progress_( "Compute", geomodel.nb_regions() )
+        {
+            for( const auto& region : geomodel.regions() )
+            {
+                auto& cost = costs_[region.index()];
+                cost = static_cast< index_t >(
+                    internal_vertices[region.index()].size() );
+                for( auto s : range( region.nb_boundaries() ) )
+                {
+                    cost += region.boundary( s ).nb_mesh_elements();
+                }
+                pending_regions_.push_back( region.index() );
+            }
+            std::stable_sort( pending_regions_.begin(),
+                pending_regions_.end(), [this]( index_t lhs, index_t rhs ) {
+                    return costs_[lhs] > costs_[rhs];
+                } );
+        }
+
+        /*!
+         * Waits for the largest pending region fitting in the budget
+         * @return the region to mesh, or NO_ID if there is none left
+         */
+        index_t acquire()
+        {
+            std::unique_lock< std::mutex > lock( mutex_ );
+            while( !pending_regions_.empty() && !aborted_ )
+            {
+                for( auto it = pending_regions_.begin();
+                     it != pending_regions_.end(); ++it )
+                {
+                    if( fits_in_budget( costs_[*it] ) )
+                    {
+                        auto region_id = *it;
+                        pending_regions_.erase( it );
+                        running_cost_ += costs_[region_id];
+                        nb_running_regions_++;
+                        return region_id;
+                    }
+                }
+                region_done_.wait( lock );
+            }
+            return NO_ID;
+        }
+
+        void release( index_t region_id )
+        {
+            {
+                std::lock_guard< std::mutex > lock( mutex_ );
+                running_cost_ -= costs_[region_id];
+                nb_running_regions_--;
+                progress_.next();
+            }
+            region_done_.notify_all();
+        }
+
+        /*!
+         * Stops handing out regions
+         */
+        void abort( index_t region_id )
+        {
+            {
+                std::lock_guard< std::mutex > lock( mutex_ );
+                aborted_ = true;
+                running_cost_ -= costs_[region_id];
+                nb_running_regions_--;
+            }
+            region_done_.notify_all();
+        }
+
+    private:
+        bool fits_in_budget( index_t cost ) const
+        {
+            return budget_ == 0 || nb_running_regions_ == 0
+                   || running_cost_ + cost <= budget_;
+        }
+
+    private:
+        std::vector< index_t > costs_;
+        std::vector< index_t > pending_regions_;
+        index_t budget_{ 0 };
+        index_t running_cost_{ 0 };
+        index_t nb_running_regions_{ 0 };
+        bool aborted_{ false };
+        std::mutex mutex_;
+        std::condition_variable region_done_;
+        GEO::ProgressTask progress_;
+    };
+
+    void tetrahedralize_regions( GeoModel3D& geomodel,
+        bool add_steiner_points,
+        const std::vector< std::vector< vec3 > >& internal_vertices,
+        const std::string& method )
+    {
+        // Lazy values of the GeoModel are computed before the workers run
+        geomodel.epsilon();
+        RegionMeshingScheduler scheduler( geomodel, internal_vertices,
+            GEO::CmdLine::get_arg_uint( "algo:tet_budget" ) );
+        process_job_queue(
+            scheduler, geomodel.nb_regions(), [&]( index_t region_id ) {
+                tetrahedralize_region( geomodel, region_id,
+                    add_steiner_points, internal_vertices[region_id], method,
+                    false );
+            } );
+    }
+} // namespace
+
 namespace RINGMesh
 {
     template < index_t DIMENSION >
@@ -126,25 +294,15 @@ namespace RINGMesh
         if( region_id == NO_ID )
         {
             Logger::out( "Info", "Using ", method );
-            GEO::ProgressTask progress( "Compute", geomodel.nb_regions() );
-            for( auto i : range( geomodel.nb_regions() ) )
-            {
-                tetrahedralize(
-                    geomodel, i, add_steiner_points, internal_vertices );
-                progress.next();
-            }
+            QuietLogger quiet;
+            tetrahedralize_regions(
+                geomodel, add_steiner_points, internal_vertices, method );
         }
         else
         {
-            std::unique_ptr< TetraGen > tetragen{ TetraGen::create(
-                geomodel, region_id, method ) };
-            tetragen->set_boundaries(
-                geomodel.region( region_id ), geomodel.wells() );
-            tetragen->set_internal_points( internal_vertices[region_id] );
-            bool status{ Logger::instance()->is_quiet() };
-            Logger::instance()->set_quiet( true );
-            tetragen->tetrahedralize( add_steiner_points );
-            Logger::instance()->set_quiet( status );
+            QuietLogger quiet;
+            tetrahedralize_region( geomodel, region_id, add_steiner_points,
+                internal_vertices[region_id], method, false );
         }
 
         // The GeoModelMesh should be updated, just erase everything
@@ -33,20 +33,27 @@
  *     FRANCE
  */
 
+#include <ringmesh/geomodel/tools/geomodel_validity.h>
+
+#include <array>
+#include <cmath>
 #include <future>
+#include <limits>
+#include <numeric>
 
 #include <geogram/basic/file_system.h>
 
 #include <geogram/mesh/triangle_intersection.h>
 
 #include <ringmesh/basic/algorithm.h>
+#include <ringmesh/basic/geometry.h>
+#include <ringmesh/basic/pimpl_impl.h>
 #include <ringmesh/basic/task_handler.h>
 #include <ringmesh/geogram_extension/geogram_mesh.h>
 #include <ringmesh/geogram_extension/geogram_mesh_builder.h>
 #include <ringmesh/geomodel/core/geomodel.h>
 #include <ringmesh/geomodel/core/geomodel_geological_entity.h>
 #include <ringmesh/geomodel/core/geomodel_mesh_entity.h>
-#include <ringmesh/geomodel/tools/geomodel_validity.h>
 
 /*!
  * @file ringmesh/geomodel_tools/geomodel_validity.cpp
@@ -59,92 +66,460 @@ namespace
 {
     using namespace RINGMesh;
 
+    /// Number of mesh elements checked by one validity task
+    static const index_t VALIDITY_CHUNK_SIZE = 1024;
+
+    /*!
+     * @brief Warnings found by one validity task
+     * @details The messages are buffered so that tasks running concurrently
+     * can be logged afterwards in a deterministic order.
+     */
+    class ValidityWarnings
+    {
+    public:
+        /*!
+         * @brief Buffers a Logger warning of the Validity feature
+         */
+        template < typename... Args >
+        void add( const Args&... args )
+        {
+            capture( [&args...] {
+                Logger::warn( "Validity", args... );
+                return true;
+            } );
+        }
+
+        /*!
+         * @brief Runs a test and buffers the warnings and errors it logs
+         * itself (e.g. the ones of the GeoModelEntity validity functions)
+         * @param[in] test functor called as test()
+         */
+        template < typename TEST >
+        bool capture( const TEST& test )
+        {
+            Logger::MessageCapture capture;
+            bool result = test();
+            const auto& messages = capture.messages();
+            messages_.insert(
+                messages_.end(), messages.begin(), messages.end() );
+            return result;
+        }
+
+        void log() const
+        {
+            for( const auto& message : messages_ )
+            {
+                Logger::replay( message );
+            }
+        }
+
+    private:
+        Logger::CapturedMessages messages_{};
+    };
+
+    /*!
+     * @brief Runs a validity test on the entities [0, @param nb_entities)
+     * spread on the available threads
+     * @details The warnings and errors logged by each test are buffered
+     * and logged in the entity order once all the entities are tested.
+     * @param[in] is_valid functor called as is_valid( entity )
+     * @return the result of the test of each entity
+     */
+    template < typename TEST >
+    std::vector< char > check_entities(
+        index_t nb_entities, const TEST& is_valid )
+    {
+        std::vector< char > valid( nb_entities, true );
+        std::vector< ValidityWarnings > warnings( nb_entities );
+        parallel_for(
+            nb_entities, [&is_valid, &valid, &warnings]( index_t e ) {
+                valid[e] = warnings[e].capture(
+                    [&is_valid, e] { return is_valid( e ); } );
+            } );
+        for( const auto& entity_warnings : warnings )
+        {
+            entity_warnings.log();
+        }
+        return valid;
+    }
+
+    /*!
+     * @brief Runs a check on the elements [0, @param nb_elements) by chunks
+     * of VALIDITY_CHUNK_SIZE elements spread on the available threads
+     * @details Each chunk stores its warnings in its own buffer, the buffers
+     * are logged in the chunk order once all the chunks are checked.
+     * @param[in] action functor called as action( element, warnings )
+     */
+    template < typename ACTION >
+    void parallel_check( index_t nb_elements, const ACTION& action )
+    {
+        index_t nb_chunks{ ( nb_elements + VALIDITY_CHUNK_SIZE - 1 )
+                           / VALIDITY_CHUNK_SIZE };
+        std::vector< ValidityWarnings > warnings( nb_chunks );
+        parallel_for( nb_chunks, [&action, &warnings, nb_elements](
+                                     index_t chunk ) {
+            index_t end{ std::min(
+                nb_elements, ( chunk + 1 ) * VALIDITY_CHUNK_SIZE ) };
+            for( auto i : range( chunk * VALIDITY_CHUNK_SIZE, end ) )
+            {
+                action( i, warnings[chunk] );
+            }
+        } );
+        for( const auto& chunk_warnings : warnings )
+        {
+            chunk_warnings.log();
+        }
+    }
+
+    /*!
+     * @brief Gathers element indices on all the Surface polygons by chunks
+     * of VALIDITY_CHUNK_SIZE polygons spread on the available threads
+     * @param[in] action functor called as action( surface, begin, end ) that
+     * returns the indices found on the polygons [begin, end) of the surface
+     * @return for each Surface, the concatenation of the indices returned
+     * by its chunks, in the polygon order
+     */
+    template < index_t DIMENSION, typename ACTION >
+    std::vector< std::vector< index_t > > gather_on_surface_polygons(
+        const GeoModel< DIMENSION >& geomodel, const ACTION& action )
+    {
+        struct PolygonChunk
+        {
+            index_t surface;
+            index_t begin;
+            index_t end;
+        };
+        std::vector< PolygonChunk > chunks;
+        for( const auto& surface : geomodel.surfaces() )
+        {
+            index_t nb_polygons{ surface.nb_mesh_elements() };
+            for( index_t begin = 0; begin < nb_polygons;
+                 begin += VALIDITY_CHUNK_SIZE )
+            {
+                chunks.push_back( { surface.index(), begin,
+                    std::min( nb_polygons, begin + VALIDITY_CHUNK_SIZE ) } );
+            }
+        }
+        std::vector< std::vector< index_t > > chunk_results( chunks.size() );
+        parallel_for( static_cast< index_t >( chunks.size() ),
+            [&geomodel, &action, &chunks, &chunk_results]( index_t c ) {
+                const auto& chunk = chunks[c];
+                chunk_results[c] = action(
+                    geomodel.surface( chunk.surface ), chunk.begin, chunk.end );
+            } );
+        std::vector< std::vector< index_t > > results( geomodel.nb_surfaces() );
+        for( auto c : range( chunks.size() ) )
+        {
+            auto& result = results[chunks[c].surface];
+            const auto& chunk_result = chunk_results[c];
+            result.insert(
+                result.end(), chunk_result.begin(), chunk_result.end() );
+        }
+        return results;
+    }
+
+    /*!
+     * @brief Gets all the GeoModelMeshEntities of a GeoModel
+     */
     template < index_t DIMENSION >
-    bool triangles_intersect( const GeoModel< DIMENSION >& geomodel,
-        const GeoModelMeshPolygons< DIMENSION >& polygons,
-        index_t triangle1,
-        index_t triangle2 )
+    std::vector< const GeoModelMeshEntity< DIMENSION >* > all_mesh_entities(
+        const GeoModel< DIMENSION >& geomodel )
     {
-        ringmesh_assert( polygons.nb_vertices( triangle1 ) == 3 );
-        ringmesh_assert( polygons.nb_vertices( triangle2 ) == 3 );
-        const auto& vertices = geomodel.mesh.vertices;
-        const auto& p1 = vertices.vertex( polygons.vertex( { triangle1, 0 } ) );
-        const auto& p2 = vertices.vertex( polygons.vertex( { triangle1, 1 } ) );
-        const auto& p3 = vertices.vertex( polygons.vertex( { triangle1, 2 } ) );
-
-        const auto& q1 = vertices.vertex( polygons.vertex( { triangle2, 0 } ) );
-        const auto& q2 = vertices.vertex( polygons.vertex( { triangle2, 1 } ) );
-        const auto& q3 = vertices.vertex( polygons.vertex( { triangle2, 2 } ) );
-        GEO::vector< GEO::TriangleIsect > sym;
-        return triangles_intersections( p1, p2, p3, q1, q2, q3, sym );
+        std::vector< const GeoModelMeshEntity< DIMENSION >* > entities;
+        const auto& meshed_types = geomodel.entity_type_manager()
+                                       .mesh_entity_manager.mesh_entity_types();
+        for( const auto& type : meshed_types )
+        {
+            for( auto i : range( geomodel.nb_mesh_entities( type ) ) )
+            {
+                entities.push_back( &geomodel.mesh_entity( type, i ) );
+            }
+        }
+        return entities;
     }
 
+    /*!
+     * @brief Gets all the GeoModelGeologicalEntities of a GeoModel
+     */
     template < index_t DIMENSION >
-    bool triangle_quad_intersect( const GeoModel< DIMENSION >& geomodel,
-        const GeoModelMeshPolygons< DIMENSION >& polygons,
-        index_t triangle,
-        index_t quad )
+    std::vector< const GeoModelGeologicalEntity< DIMENSION >* >
+        all_geological_entities( const GeoModel< DIMENSION >& geomodel )
     {
-        ringmesh_assert( polygons.nb_vertices( triangle ) == 3 );
-        ringmesh_assert( polygons.nb_vertices( quad ) == 4 );
-        const auto& vertices = geomodel.mesh.vertices;
-        const auto& p1 = vertices.vertex( polygons.vertex( { triangle, 0 } ) );
-        const auto& p2 = vertices.vertex( polygons.vertex( { triangle, 1 } ) );
-        const auto& p3 = vertices.vertex( polygons.vertex( { triangle, 2 } ) );
+        std::vector< const GeoModelGeologicalEntity< DIMENSION >* > entities;
+        const auto& geological_types =
+            geomodel.entity_type_manager()
+                .geological_entity_manager.geological_entity_types();
+        for( const auto& type : geological_types )
+        {
+            for( const auto& geol_entity : geomodel.geol_entities( type ) )
+            {
+                entities.push_back( &geol_entity );
+            }
+        }
+        return entities;
+    }
+
+    /*!
+     * @brief Counts the entities that fail a validity test, the entities
+     * being tested in parallel
+     * @param[in] is_valid functor called as is_valid( entity )
+     */
+    template < typename ENTITY, typename TEST >
+    index_t count_invalid_entities(
+        const std::vector< const ENTITY* >& entities, const TEST& is_valid )
+    {
+        auto valid = check_entities( static_cast< index_t >( entities.size() ),
+            [&entities, &is_valid]( index_t e ) {
+                return is_valid( *entities[e] );
+            } );
+        return static_cast< index_t >(
+            std::count( valid.begin(), valid.end(), 0 ) );
+    }
+
+    /// Bound of the relative rounding error of a double operation
+    static const double ROUNDING_ERROR =
+        std::numeric_limits< double >::epsilon() / 2.;
+    /// Relative error bound of the floating-point evaluation of a 2x2
+    /// determinant from point differences (Shewchuk's orient2d filter)
+    static const double ORIENT_2D_ERROR_BOUND =
+        ( 3. + 16. * ROUNDING_ERROR ) * ROUNDING_ERROR;
+    /// Relative error bound of the floating-point evaluation of a 3x3
+    /// determinant from point differences (Shewchuk's orient3d filter)
+    static const double ORIENT_3D_ERROR_BOUND =
+        ( 7. + 56. * ROUNDING_ERROR ) * ROUNDING_ERROR;
 
-        const auto& q1 = vertices.vertex( polygons.vertex( { quad, 0 } ) );
-        const auto& q2 = vertices.vertex( polygons.vertex( { quad, 1 } ) );
-        const auto& q3 = vertices.vertex( polygons.vertex( { quad, 2 } ) );
-        const auto& q4 = vertices.vertex( polygons.vertex( { quad, 3 } ) );
-        GEO::vector< GEO::TriangleIsect > sym;
-        if( triangles_intersections( p1, p2, p3, q1, q2, q3, sym ) )
+    /*!
+     * @brief Gets the sign of a determinant evaluated in floating point
+     * @param[in] error the bound of the evaluation error
+     * @return ZERO if the sign cannot be certified
+     */
+    Sign filtered_sign( double determinant, double error )
+    {
+        if( determinant > error )
         {
-            return true;
+            return POSITIVE;
         }
-        if( triangles_intersections( p1, p2, p3, q1, q3, q4, sym ) )
+        if( determinant < -error )
         {
-            return true;
+            return NEGATIVE;
         }
-        return false;
+        return ZERO;
     }
 
-    template < index_t DIMENSION >
-    bool quad_quad_intersect( const GeoModel< DIMENSION >& geomodel,
-        const GeoModelMeshPolygons< DIMENSION >& polygons,
-        index_t quad1,
-        index_t quad2 )
+    /*!
+     * @brief Triangle prepared for the intersection tests
+     * @details Before calling the exact symbolic predicate of Geogram, the
+     * triangles are tested for a separating plane (the plane of one of them)
+     * and for a separating line in a projection on a coordinate plane (the
+     * line of one of their edges). These tests use orientation predicates
+     * evaluated in floating point, with a static error bound: they only
+     * conclude when the orientations are certified, so that the result
+     * is the one of GEO::triangles_intersections().
+     * A vertex shared by the two triangles is allowed to lie on the
+     * separating plane or line since Geogram does not report
+     * the intersections reduced to a shared vertex or edge. Triangles whose
+     * area cannot be certified non zero are always given to the exact
+     * predicate.
+     */
+    class IntersectionTriangle
     {
-        ringmesh_assert( polygons.nb_vertices( quad1 ) == 4 );
-        ringmesh_assert( polygons.nb_vertices( quad2 ) == 4 );
-        const auto& vertices = geomodel.mesh.vertices;
-        const auto& p1 = vertices.vertex( polygons.vertex( { quad1, 0 } ) );
-        const auto& p2 = vertices.vertex( polygons.vertex( { quad1, 1 } ) );
-        const auto& p3 = vertices.vertex( polygons.vertex( { quad1, 2 } ) );
-        const auto& p4 = vertices.vertex( polygons.vertex( { quad1, 3 } ) );
-
-        const auto& q1 = vertices.vertex( polygons.vertex( { quad2, 0 } ) );
-        const auto& q2 = vertices.vertex( polygons.vertex( { quad2, 1 } ) );
-        const auto& q3 = vertices.vertex( polygons.vertex( { quad2, 2 } ) );
-        const auto& q4 = vertices.vertex( polygons.vertex( { quad2, 3 } ) );
-        GEO::vector< GEO::TriangleIsect > sym;
-        if( triangles_intersections( p1, p2, p3, q1, q2, q3, sym ) )
+    public:
+        IntersectionTriangle() = default;
+        IntersectionTriangle( const vec3& p0, const vec3& p1, const vec3& p2 )
+            : vertices_{ { p0, p1, p2 } }
+        {
+            vec3 u{ p1 - p0 };
+            vec3 v{ p2 - p0 };
+            normal_ = cross( u, v );
+            normal_bound_ =
+                vec3( std::fabs( u.y * v.z ) + std::fabs( u.z * v.y ),
+                    std::fabs( u.z * v.x ) + std::fabs( u.x * v.z ),
+                    std::fabs( u.x * v.y ) + std::fabs( u.y * v.x ) );
+            for( auto axis : range( 3 ) )
+            {
+                if( std::fabs( normal_[axis] )
+                    > std::fabs( normal_[projection_axis_] ) )
+                {
+                    projection_axis_ = axis;
+                }
+                if( filtered_sign( normal_[axis],
+                        ORIENT_2D_ERROR_BOUND * normal_bound_[axis] )
+                    != ZERO )
+                {
+                    degenerate_ = false;
+                }
+            }
+        }
+
+        /*!
+         * @brief Tests if two triangles intersect
+         * @details Same result as GEO::triangles_intersections()
+         */
+        bool intersects( const IntersectionTriangle& other ) const
         {
-            return true;
+            if( !degenerate_ && !other.degenerate_
+                && ( plane_separates( other ) || other.plane_separates( *this )
+                       || edge_separates( other )
+                       || other.edge_separates( *this ) ) )
+            {
+                return false;
+            }
+            GEO::vector< GEO::TriangleIsect > sym;
+            return triangles_intersections( vertices_[0], vertices_[1],
+                vertices_[2], other.vertices_[0], other.vertices_[1],
+                other.vertices_[2], sym );
         }
-        if( triangles_intersections( p1, p2, p3, q1, q3, q4, sym ) )
+
+    private:
+        /*!
+         * @brief Tests if the triangle plane separates another triangle
+         * from this triangle
+         */
+        bool plane_separates( const IntersectionTriangle& other ) const
         {
-            return true;
+            auto separated_side = ZERO;
+            for( const auto& point : other.vertices_ )
+            {
+                if( is_vertex( point ) )
+                {
+                    continue;
+                }
+                vec3 w{ point - vertices_[0] };
+                auto side = filtered_sign( dot( w, normal_ ),
+                    ORIENT_3D_ERROR_BOUND
+                        * ( std::fabs( w.x ) * normal_bound_.x
+                              + std::fabs( w.y ) * normal_bound_.y
+                              + std::fabs( w.z ) * normal_bound_.z ) );
+                if( side == ZERO
+                    || ( separated_side != ZERO && side != separated_side ) )
+                {
+                    return false;
+                }
+                separated_side = side;
+            }
+            return separated_side != ZERO;
+        }
+
+        /*!
+         * @brief Tests if the line of one of the triangle edges separates
+         * another triangle from this triangle once projected on
+         * the coordinate plane most parallel to the triangle
+         */
+        bool edge_separates( const IntersectionTriangle& other ) const
+        {
+            for( auto v : range( 3 ) )
+            {
+                const auto& p0 = vertices_[v];
+                const auto& p1 = vertices_[( v + 1 ) % 3];
+                auto inside = projected_orientation(
+                    p0, p1, vertices_[( v + 2 ) % 3] );
+                if( inside == ZERO )
+                {
+                    continue;
+                }
+                index_t nb_separated{ 0 };
+                for( const auto& point : other.vertices_ )
+                {
+                    if( point == p0 || point == p1 )
+                    {
+                        continue;
+                    }
+                    if( projected_orientation( p0, p1, point ) != -inside )
+                    {
+                        nb_separated = 0;
+                        break;
+                    }
+                    nb_separated++;
+                }
+                if( nb_separated > 0 )
+                {
+                    return true;
+                }
+            }
+            return false;
         }
-        if( triangles_intersections( p1, p3, p4, q1, q2, q3, sym ) )
+
+        /*!
+         * @brief Gets the orientation of three points projected on
+         * the coordinate plane orthogonal to the projection axis
+         * @return ZERO if the orientation cannot be certified
+         */
+        Sign projected_orientation(
+            const vec3& p0, const vec3& p1, const vec3& p2 ) const
         {
-            return true;
+            index_t x{ ( projection_axis_ + 1 ) % 3 };
+            index_t y{ ( projection_axis_ + 2 ) % 3 };
+            double left{ ( p1[x] - p0[x] ) * ( p2[y] - p0[y] ) };
+            double right{ ( p1[y] - p0[y] ) * ( p2[x] - p0[x] ) };
+            return filtered_sign( left - right,
+                ORIENT_2D_ERROR_BOUND
+                    * ( std::fabs( left ) + std::fabs( right ) ) );
         }
-        if( triangles_intersections( p1, p3, p4, q1, q3, q4, sym ) )
+
+        bool is_vertex( const vec3& point ) const
         {
-            return true;
+            return point == vertices_[0] || point == vertices_[1]
+                   || point == vertices_[2];
         }
-        return false;
-    }
+
+    private:
+        std::array< vec3, 3 > vertices_;
+        vec3 normal_;
+        vec3 normal_bound_;
+        index_t projection_axis_{ 0 };
+        bool degenerate_{ true };
+    };
+
+    /*!
+     * @brief Triangles of a polygon of the GeoModelMesh
+     * @details A quad is split into two triangles along its diagonal
+     * between its vertices 0 and 2.
+     */
+    class PolygonTriangles
+    {
+    public:
+        PolygonTriangles() = default;
+        template < index_t DIMENSION >
+        PolygonTriangles(
+            const GeoModelMeshPolygons< DIMENSION >& polygons,
+            const GeoModelMeshVertices< DIMENSION >& vertices,
+            index_t polygon )
+        {
+            ringmesh_assert( polygons.nb_vertices( polygon ) == 3
+                             || polygons.nb_vertices( polygon ) == 4 );
+            const auto& p0 =
+                vertices.vertex( polygons.vertex( { polygon, 0 } ) );
+            const auto& p2 =
+                vertices.vertex( polygons.vertex( { polygon, 2 } ) );
+            triangles_[0] = IntersectionTriangle( p0,
+                vertices.vertex( polygons.vertex( { polygon, 1 } ) ), p2 );
+            if( polygons.nb_vertices( polygon ) == 4 )
+            {
+                triangles_[1] = IntersectionTriangle( p0, p2,
+                    vertices.vertex( polygons.vertex( { polygon, 3 } ) ) );
+                nb_triangles_ = 2;
+            }
+        }
+
+        bool intersects( const PolygonTriangles& other ) const
+        {
+            for( auto t : range( nb_triangles_ ) )
+            {
+                for( auto o : range( other.nb_triangles_ ) )
+                {
+                    if( triangles_[t].intersects( other.triangles_[o] ) )
+                    {
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+    private:
+        std::array< IntersectionTriangle, 2 > triangles_;
+        index_t nb_triangles_{ 1 };
+    };
 
     template < index_t DIMENSION >
     bool is_edge_on_line(
@@ -292,103 +667,58 @@ namespace
         /*!
          * @brief Constructs the StoreIntersections
          * @param[in] geomodel the geomodel
-         * @param[out] has_isect the flag that indicates for each polygon
-         *  whether it has intersections
+         * @param[out] intersections the pairs of intersecting polygons
          */
         StoreIntersections( const GeoModel< DIMENSION >& geomodel,
-            std::vector< bool >& has_isect )
+            std::vector< index_t >& intersections )
             : geomodel_( geomodel ),
               polygons_( geomodel.mesh.polygons ),
-              has_intersection_( has_isect )
+              intersections_( intersections )
         {
-            has_intersection_.assign( polygons_.nb(), 0 );
         }
 
         /*!
-         * @brief Determines the intersections between two polygons
-         * @details It is a callback for AABBTree traversal
-         * @param[in] p1 index of the first polygon
-         * @param[in] p2 index of the second polygon
+         * @brief Sets the polygon tested against the polygons found
+         * during the next AABBTree traversal
          */
-        void operator()( index_t p1, index_t p2 )
+        void set_polygon( index_t polygon )
         {
-            if( p1 == p2 || polygons_are_adjacent( polygons_, p1, p2 )
-                || polygons_share_line_edge( geomodel_, polygons_, p1, p2 ) )
-            {
-                return;
-            }
+            polygon_ = polygon;
+            triangles_ = PolygonTriangles(
+                polygons_, geomodel_.mesh.vertices, polygon );
+        }
 
-            if( is_triangle( p1 ) )
-            {
-                if( is_triangle( p2 ) )
-                {
-                    if( triangles_intersect( geomodel_, polygons_, p1, p2 ) )
-                    {
-                        has_intersection_[p1] = 1;
-                        has_intersection_[p2] = 1;
-                    }
-                }
-                else if( is_quad( p2 ) )
-                {
-                    if( triangle_quad_intersect(
-                            geomodel_, polygons_, p1, p2 ) )
-                    {
-                        has_intersection_[p1] = 1;
-                        has_intersection_[p2] = 1;
-                    }
-                }
-                else
-                {
-                    ringmesh_assert_not_reached;
-                }
-            }
-            else if( is_quad( p1 ) )
+        /*!
+         * @brief Determines the intersection between the current polygon
+         * and another polygon
+         * @details It is a callback for AABBTree traversal. A pair of
+         * polygons is only tested from its lowest polygon index.
+         * @param[in] polygon index of the other polygon
+         */
+        void operator()( index_t polygon )
+        {
+            if( polygon <= polygon_
+                || polygons_are_adjacent( polygons_, polygon_, polygon )
+                || polygons_share_line_edge(
+                       geomodel_, polygons_, polygon_, polygon ) )
             {
-                if( is_triangle( p2 ) )
-                {
-                    if( triangle_quad_intersect(
-                            geomodel_, polygons_, p2, p1 ) )
-                    {
-                        has_intersection_[p1] = 1;
-                        has_intersection_[p2] = 1;
-                    }
-                }
-                else if( is_quad( p2 ) )
-                {
-                    if( quad_quad_intersect( geomodel_, polygons_, p1, p2 ) )
-                    {
-                        has_intersection_[p1] = 1;
-                        has_intersection_[p2] = 1;
-                    }
-                }
-                else
-                {
-                    ringmesh_assert_not_reached;
-                }
+                return;
             }
-            else
+            PolygonTriangles triangles(
+                polygons_, geomodel_.mesh.vertices, polygon );
+            if( triangles_.intersects( triangles ) )
             {
-                ringmesh_assert_not_reached;
+                intersections_.push_back( polygon_ );
+                intersections_.push_back( polygon );
             }
         }
 
-        bool is_triangle( index_t p ) const
-        {
-            PolygonType type;
-            std::tie( type, std::ignore ) = polygons_.type( p );
-            return type == PolygonType::TRIANGLE;
-        }
-        bool is_quad( index_t p ) const
-        {
-            PolygonType type;
-            std::tie( type, std::ignore ) = polygons_.type( p );
-            return type == PolygonType::QUAD;
-        }
-
     private:
         const GeoModel< DIMENSION >& geomodel_;
         const GeoModelMeshPolygons< DIMENSION >& polygons_;
-        std::vector< bool >& has_intersection_;
+        std::vector< index_t >& intersections_;
+        index_t polygon_{ NO_ID };
+        PolygonTriangles triangles_;
     };
 
     void save_mesh_locating_geomodel_inconsistencies(
@@ -425,7 +755,7 @@ namespace
     template < index_t DIMENSION >
     void save_invalid_points( const std::ostringstream& file,
         const GeoModel< DIMENSION >& geomodel,
-        const std::vector< bool >& valid )
+        const std::vector< char >& valid )
     {
         GEO::Mesh point_mesh;
         for( auto i : range( valid.size() ) )
@@ -461,8 +791,9 @@ namespace
         return entities;
     }
 
-    void print_error(
-        const std::vector< index_t >& entities, const std::string& entity_name )
+    void print_error( ValidityWarnings& warnings,
+        const std::vector< index_t >& entities,
+        const std::string& entity_name )
     {
         std::ostringstream oss;
         oss << " Vertex is in " << entities.size() << " " << entity_name
@@ -471,12 +802,13 @@ namespace
         {
             oss << entity << " ; ";
         }
-        Logger::warn( "Validity", oss.str() );
+        warnings.add( oss.str() );
     }
 
     template < template < index_t > class ENTITY, index_t DIMENSION >
     bool is_vertex_valid( const GeoModel< DIMENSION >& geomodel,
-        const std::map< MeshEntityType, std::vector< index_t > >& entities )
+        const std::map< MeshEntityType, std::vector< index_t > >& entities,
+        ValidityWarnings& warnings )
     {
         auto type = ENTITY< DIMENSION >::type_name_static();
         auto boundary_type =
@@ -489,8 +821,9 @@ namespace
             {
                 if( type_entities.size() != 1 )
                 {
-                    print_error( type_entities, type.string() + "s" );
-                    Logger::warn( "Validity", "It should be in only one ",
+                    print_error(
+                        warnings, type_entities, type.string() + "s" );
+                    warnings.add( "It should be in only one ",
                         boundary_type );
                     return false;
                 }
@@ -500,7 +833,7 @@ namespace
         }
         if( type_entities.empty() )
         {
-            Logger::warn( "Validity", " Vertex is in a ", boundary_type,
+            warnings.add( " Vertex is in a ", boundary_type,
                 " but in no ", type );
             return false;
         }
@@ -512,7 +845,7 @@ namespace
                 type_entities.begin(), type_entities.end(), entity );
             if( nb > 2 )
             {
-                Logger::warn( "Validity", " Vertex is ", nb, " times in ",
+                warnings.add( " Vertex is ", nb, " times in ",
                     geomodel.mesh_entity( type, entity ).gmme() );
                 return false;
             }
@@ -533,7 +866,7 @@ namespace
                 }
                 if( !internal_boundary )
                 {
-                    Logger::warn( "Validity", " Vertex appears ", nb,
+                    warnings.add( " Vertex appears ", nb,
                         " times in ",
                         geomodel.mesh_entity( type, entity ).gmme() );
                     return false;
@@ -545,44 +878,50 @@ namespace
 
     template < index_t DIMENSION >
     bool is_region_vertex_valid( const GeoModel< DIMENSION >& geomodel,
-        const std::map< MeshEntityType, std::vector< index_t > >& entities )
+        const std::map< MeshEntityType, std::vector< index_t > >& entities,
+        ValidityWarnings& warnings )
     {
         if( geomodel.nb_regions() > 0 && geomodel.region( 0 ).is_meshed() )
         {
-            return is_vertex_valid< Region >( geomodel, entities );
+            return is_vertex_valid< Region >( geomodel, entities, warnings );
         }
         return true;
     }
 
     template < index_t DIMENSION >
     bool is_surface_vertex_valid( const GeoModel< DIMENSION >& geomodel,
-        const std::map< MeshEntityType, std::vector< index_t > >& entities );
+        const std::map< MeshEntityType, std::vector< index_t > >& entities,
+        ValidityWarnings& warnings );
 
     template <>
     bool is_surface_vertex_valid( const GeoModel2D& geomodel,
-        const std::map< MeshEntityType, std::vector< index_t > >& entities )
+        const std::map< MeshEntityType, std::vector< index_t > >& entities,
+        ValidityWarnings& warnings )
     {
         if( geomodel.nb_surfaces() > 0 && geomodel.surface( 0 ).is_meshed() )
         {
-            return is_vertex_valid< Surface >( geomodel, entities );
+            return is_vertex_valid< Surface >( geomodel, entities, warnings );
         }
         return true;
     }
 
     template < index_t DIMENSION >
     bool is_surface_vertex_valid( const GeoModel< DIMENSION >& geomodel,
-        const std::map< MeshEntityType, std::vector< index_t > >& entities )
+        const std::map< MeshEntityType, std::vector< index_t > >& entities,
+        ValidityWarnings& warnings )
     {
-        return is_vertex_valid< Surface >( geomodel, entities );
+        return is_vertex_valid< Surface >( geomodel, entities, warnings );
     }
 
     template < index_t DIMENSION >
     bool is_line_vertex_valid( const GeoModel< DIMENSION >& geomodel,
-        const std::map< MeshEntityType, std::vector< index_t > >& entities );
+        const std::map< MeshEntityType, std::vector< index_t > >& entities,
+        ValidityWarnings& warnings );
 
     template <>
     bool is_line_vertex_valid( const GeoModel3D& geomodel,
-        const std::map< MeshEntityType, std::vector< index_t > >& entities )
+        const std::map< MeshEntityType, std::vector< index_t > >& entities,
+        ValidityWarnings& warnings )
     {
         const auto& lines = entities.find( Line3D::type_name_static() )->second;
         if( entities.find( Corner3D::type_name_static() )->second.empty() )
@@ -591,9 +930,8 @@ namespace
             {
                 if( lines.size() != 1 )
                 {
-                    print_error( lines, "Lines" );
-                    Logger::warn(
-                        "Validity", "It should be in only one Line." );
+                    print_error( warnings, lines, "Lines" );
+                    warnings.add( "It should be in only one Line." );
                     return false;
                 }
                 return true;
@@ -602,8 +940,8 @@ namespace
         }
         if( lines.size() < 2 )
         {
-            print_error( lines, "Line" );
-            Logger::warn( "Validity", "It should be in at least 2 Lines." );
+            print_error( warnings, lines, "Line" );
+            warnings.add( "It should be in at least 2 Lines." );
             return false;
         }
         for( const auto line : lines )
@@ -613,7 +951,7 @@ namespace
             {
                 if( !geomodel.line( line ).is_closed() )
                 {
-                    Logger::warn( "Validity",
+                    warnings.add(
                         " Vertex"
                         " is twice in Line ",
                         line );
@@ -622,7 +960,7 @@ namespace
             }
             else if( nb > 2 )
             {
-                Logger::warn( "Validity", " Vertex appears ", nb,
+                warnings.add( " Vertex appears ", nb,
                     " times in Line ", line );
                 return false;
             }
@@ -635,7 +973,7 @@ namespace
             gmme_id line_id( Line3D::type_name_static(), line );
             if( !is_boundary_entity( geomodel, line_id, corner_id ) )
             {
-                Logger::warn( "Validity",
+                warnings.add(
                     " Inconsistent Line-Corner connectivity ",
                     " vertex shows that ", line_id,
                     " must be in the boundary of ", corner_id );
@@ -647,7 +985,8 @@ namespace
 
     template <>
     bool is_line_vertex_valid( const GeoModel2D& geomodel,
-        const std::map< MeshEntityType, std::vector< index_t > >& entities )
+        const std::map< MeshEntityType, std::vector< index_t > >& entities,
+        ValidityWarnings& warnings )
     {
         const auto& lines = entities.find( Line2D::type_name_static() )->second;
         if( entities.find( Corner2D::type_name_static() )->second.empty() )
@@ -656,9 +995,8 @@ namespace
             {
                 if( lines.size() != 1 )
                 {
-                    print_error( lines, "Lines" );
-                    Logger::warn(
-                        "Validity", "It should be in only one Line." );
+                    print_error( warnings, lines, "Lines" );
+                    warnings.add( "It should be in only one Line." );
                     return false;
                 }
                 return true;
@@ -667,8 +1005,8 @@ namespace
         }
         if( lines.empty() )
         {
-            print_error( lines, "Lines" );
-            Logger::warn( "Validity", "It should be in at least one Line." );
+            print_error( warnings, lines, "Lines" );
+            warnings.add( "It should be in at least one Line." );
             return false;
         }
         for( auto line : lines )
@@ -678,7 +1016,7 @@ namespace
             {
                 if( !geomodel.line( line ).is_closed() )
                 {
-                    Logger::warn( "Validity",
+                    warnings.add(
                         " Vertex"
                         " is twice in Line ",
                         line );
@@ -687,7 +1025,7 @@ namespace
             }
             else if( nb > 2 )
             {
-                Logger::warn( "Validity", " Vertex appears ", nb,
+                warnings.add( " Vertex appears ", nb,
                     " times in Line ", line );
                 return false;
             }
@@ -700,7 +1038,7 @@ namespace
             gmme_id line_id( Line2D::type_name_static(), line );
             if( !is_boundary_entity( geomodel, line_id, corner_id ) )
             {
-                Logger::warn( "Validity",
+                warnings.add(
                     " Inconsistent Line-Corner connectivity ",
                     " vertex shows that ", line_id,
                     " must be in the boundary of ", corner_id );
@@ -712,14 +1050,15 @@ namespace
 
     template < index_t DIMENSION >
     bool is_corner_valid(
-        const std::map< MeshEntityType, std::vector< index_t > >& entities )
+        const std::map< MeshEntityType, std::vector< index_t > >& entities,
+        ValidityWarnings& warnings )
     {
         const auto& corners =
             entities.find( Corner< DIMENSION >::type_name_static() )->second;
         if( corners.size() > 1 )
         {
-            print_error( corners, "Corners" );
-            Logger::warn( "Validity", "It should be in only one Corner." );
+            print_error( warnings, corners, "Corners" );
+            warnings.add( "It should be in only one Corner." );
             return false;
         }
         return true;
@@ -727,17 +1066,19 @@ namespace
 
     template < index_t DIMENSION >
     bool is_geomodel_vertex_valid_base( const GeoModel< DIMENSION >& geomodel,
-        std::map< MeshEntityType, std::vector< index_t > >& entities )
+        std::map< MeshEntityType, std::vector< index_t > >& entities,
+        ValidityWarnings& warnings )
     {
-        if( !is_corner_valid< DIMENSION >( entities ) )
+        if( !is_corner_valid< DIMENSION >( entities, warnings ) )
         {
             return false;
         }
-        if( !is_line_vertex_valid< DIMENSION >( geomodel, entities ) )
+        if( !is_line_vertex_valid< DIMENSION >( geomodel, entities, warnings ) )
         {
             return false;
         }
-        if( !is_surface_vertex_valid< DIMENSION >( geomodel, entities ) )
+        if( !is_surface_vertex_valid< DIMENSION >(
+                geomodel, entities, warnings ) )
         {
             return false;
         }
@@ -747,20 +1088,23 @@ namespace
 
     template < index_t DIMENSION >
     bool is_geomodel_vertex_valid(
-        const GeoModel< DIMENSION >& geomodel, index_t i );
+        const GeoModel< DIMENSION >& geomodel,
+        index_t i,
+        ValidityWarnings& warnings );
 
     template <>
-    bool is_geomodel_vertex_valid( const GeoModel3D& geomodel, index_t i )
+    bool is_geomodel_vertex_valid(
+        const GeoModel3D& geomodel, index_t i, ValidityWarnings& warnings )
     {
         // Get the mesh entities in which this vertex is
         std::map< MeshEntityType, std::vector< index_t > > entities =
             get_entities( geomodel, i );
 
-        if( !is_geomodel_vertex_valid_base( geomodel, entities ) )
+        if( !is_geomodel_vertex_valid_base( geomodel, entities, warnings ) )
         {
             return false;
         }
-        if( !is_region_vertex_valid< 3 >( geomodel, entities ) )
+        if( !is_region_vertex_valid< 3 >( geomodel, entities, warnings ) )
         {
             return false;
         }
@@ -769,44 +1113,50 @@ namespace
     }
 
     template <>
-    bool is_geomodel_vertex_valid( const GeoModel2D& geomodel, index_t i )
+    bool is_geomodel_vertex_valid(
+        const GeoModel2D& geomodel, index_t i, ValidityWarnings& warnings )
     {
         // Get the mesh entities in which this vertex is
         std::map< MeshEntityType, std::vector< index_t > > entities =
             get_entities( geomodel, i );
 
-        return is_geomodel_vertex_valid_base( geomodel, entities );
+        return is_geomodel_vertex_valid_base( geomodel, entities, warnings );
     }
 
     /*!
-     * @brief Check the geometrical-topological consistency of the geomodel
-     * @details Verification is based on the information stored by the unique
-     *          vertices of the geomodel which validity must be checked
-     * beforehand
-     * @todo Check that the geomodel vertices are consistent with the
-     * geomodel_vertex_ids
-     *       stored at by the GMME
-     * @todo Implementation for regions
-     * @todo Split in smaller functions
+     * @brief Checks the consistency of the given geomodel vertices
+     * @return the validity of each given vertex
      */
     template < index_t DIMENSION >
-    bool check_model_points_validity( const GeoModel< DIMENSION >& geomodel )
+    std::vector< char > are_geomodel_vertices_valid(
+        const GeoModel< DIMENSION >& geomodel,
+        const std::vector< index_t >& vertex_ids )
     {
-        // For all the vertices of the geomodel
-        // We check that the entities in which they are are consistent
-        // to have a valid B-Rep geomodel
-        std::vector< bool > valid( geomodel.mesh.vertices.nb(), true );
-        for( auto i : range( geomodel.mesh.vertices.nb() ) )
-        {
-            valid[i] = is_geomodel_vertex_valid( geomodel, i );
-            if( !valid[i] )
-            {
-                Logger::warn( "Validity", " Vertex ", i, " is not valid." );
-                Logger::warn( "Validity", " Vertex ", i, " : ",
-                    geomodel.mesh.vertices.vertex( i ) );
-            }
-        }
-        auto nb_invalid = std::count( valid.begin(), valid.end(), false );
+        const auto& vertices = geomodel.mesh.vertices;
+        std::vector< char > valid( vertex_ids.size(), true );
+        parallel_check( static_cast< index_t >( vertex_ids.size() ),
+            [&geomodel, &vertices, &vertex_ids, &valid](
+                index_t i, ValidityWarnings& warnings ) {
+                auto v = vertex_ids[i];
+                valid[i] = is_geomodel_vertex_valid( geomodel, v, warnings );
+                if( !valid[i] )
+                {
+                    warnings.add( " Vertex ", v, " is not valid." );
+                    warnings.add( " Vertex ", v, " : ", vertices.vertex( v ) );
+                }
+            } );
+        return valid;
+    }
+
+    /*!
+     * @brief Reports the invalid vertices of the geomodel
+     * @param[in] valid the validity of each geomodel vertex
+     */
+    template < index_t DIMENSION >
+    bool report_invalid_points( const GeoModel< DIMENSION >& geomodel,
+        const std::vector< char >& valid )
+    {
+        auto nb_invalid = std::count( valid.begin(), valid.end(), 0 );
 
         if( nb_invalid > 0 )
         {
@@ -825,10 +1175,33 @@ namespace
         return true;
     }
 
-    template < index_t DIMENSION >
-    void save_edges( const std::ostringstream& file,
-        const GeoModel< DIMENSION >& geomodel,
-        const std::vector< index_t >& e )
+    /*!
+     * @brief Check the geometrical-topological consistency of the geomodel
+     * @details Verification is based on the information stored by the unique
+     *          vertices of the geomodel which validity must be checked
+     * beforehand
+     * @todo Check that the geomodel vertices are consistent with the
+     * geomodel_vertex_ids
+     *       stored at by the GMME
+     * @todo Implementation for regions
+     * @todo Split in smaller functions
+     */
+    template < index_t DIMENSION >
+    bool check_model_points_validity( const GeoModel< DIMENSION >& geomodel )
+    {
+        // For all the vertices of the geomodel
+        // We check that the entities in which they are are consistent
+        // to have a valid B-Rep geomodel
+        std::vector< index_t > vertex_ids( geomodel.mesh.vertices.nb() );
+        std::iota( vertex_ids.begin(), vertex_ids.end(), 0 );
+        return report_invalid_points(
+            geomodel, are_geomodel_vertices_valid( geomodel, vertex_ids ) );
+    }
+
+    template < index_t DIMENSION >
+    void save_edges( const std::ostringstream& file,
+        const GeoModel< DIMENSION >& geomodel,
+        const std::vector< index_t >& e )
     {
         GEO::Mesh edge_mesh;
         index_t previous_vertex_id{ NO_ID };
@@ -874,18 +1247,18 @@ namespace
     }
 
     /*!
-     * @brief Check boundary of a surface
-     * @details All the edges on the boundary of a surface must be in a Line
-     *          of the associated geomodel
-     *          The Line boundaries must form a closed manifold line.
+     * @brief Gets the boundary edges of the polygons [@param begin,
+     * @param end) of a surface that are in no Line of the geomodel
+     * @return the geomodel vertices of these edges, two per edge
      */
     template < index_t DIMENSION >
-    bool surface_boundary_valid( const Surface< DIMENSION >& surface )
+    std::vector< index_t > invalid_surface_boundary_edges(
+        const Surface< DIMENSION >& surface, index_t begin, index_t end )
     {
         const auto& geomodel_vertices = surface.geomodel().mesh.vertices;
         std::vector< index_t > invalid_corners;
         auto S_id = surface.gmme();
-        for( auto p : range( surface.nb_mesh_elements() ) )
+        for( auto p : range( begin, end ) )
         {
             for( auto v : range( surface.nb_mesh_element_vertices( p ) ) )
             {
@@ -906,11 +1279,26 @@ namespace
                 }
             }
         }
+        return invalid_corners;
+    }
+
+    /*!
+     * @brief Check boundary of a surface
+     * @details All the edges on the boundary of a surface must be in a Line
+     *          of the associated geomodel
+     *          The Line boundaries must form a closed manifold line.
+     * @param[in] invalid_corners the vertices of the surface boundary edges
+     * that are in no Line, as given by invalid_surface_boundary_edges
+     */
+    template < index_t DIMENSION >
+    bool surface_boundary_valid( const Surface< DIMENSION >& surface,
+        const std::vector< index_t >& invalid_corners )
+    {
         if( !invalid_corners.empty() )
         {
             Logger::warn( "Validity",
                 " Invalid surface boundary: ", invalid_corners.size() / 2,
-                " boundary edges of ", S_id,
+                " boundary edges of ", surface.gmme(),
                 "  are in no line of the GeoModel." );
             if( GEO::CmdLine::get_arg_bool( "validity:save" ) )
             {
@@ -954,12 +1342,19 @@ namespace
             get_validity_errors_directory() + "/non_manifold_edges.geogram" );
     }
 
+    /*!
+     * @brief Gets the polygons [@param begin, @param end) of a surface
+     * that match no cell facet of the geomodel
+     */
     template < index_t DIMENSION >
-    bool is_surface_conformal_to_volume( const Surface< DIMENSION >& surface,
-        const NNSearch< DIMENSION >& cell_facet_barycenter_nn_search )
+    std::vector< index_t > unconformal_surface_polygons(
+        const Surface< DIMENSION >& surface,
+        const NNSearch< DIMENSION >& cell_facet_barycenter_nn_search,
+        index_t begin,
+        index_t end )
     {
         std::vector< index_t > unconformal_polygons;
-        for( auto p : range( surface.nb_mesh_elements() ) )
+        for( auto p : range( begin, end ) )
         {
             auto center = surface.mesh_element_barycenter( p );
             auto result = cell_facet_barycenter_nn_search.get_neighbors(
@@ -969,6 +1364,13 @@ namespace
                 unconformal_polygons.push_back( p );
             }
         }
+        return unconformal_polygons;
+    }
+
+    template < index_t DIMENSION >
+    bool is_surface_conformal_to_volume( const Surface< DIMENSION >& surface,
+        const std::vector< index_t >& unconformal_polygons )
+    {
         if( !unconformal_polygons.empty() )
         {
             Logger::warn( "Validity",
@@ -994,27 +1396,36 @@ namespace
     std::vector< index_t > compute_border_edges(
         const GeoModel< DIMENSION >& geomodel )
     {
-        std::vector< index_t > edge_indices;
         const auto& polygons = geomodel.mesh.polygons;
-        for( const auto& surface : geomodel.surfaces() )
-        {
-            for( auto p : range( polygons.nb_polygons( surface.index() ) ) )
-            {
-                index_t polygon_id{ polygons.polygon( surface.index(), p ) };
-                for( auto v : range( polygons.nb_vertices( polygon_id ) ) )
+        auto surface_edge_indices = gather_on_surface_polygons( geomodel,
+            [&polygons]( const Surface< DIMENSION >& surface, index_t begin,
+                index_t end ) {
+                std::vector< index_t > edge_indices;
+                for( auto p : range( begin, end ) )
                 {
-                    index_t adj{ polygons.adjacent( { polygon_id, v } ) };
-                    if( adj == NO_ID )
+                    index_t polygon_id{ polygons.polygon(
+                        surface.index(), p ) };
+                    index_t nb_vertices{ polygons.nb_vertices( polygon_id ) };
+                    for( auto v : range( nb_vertices ) )
                     {
-                        edge_indices.push_back(
-                            polygons.vertex( { polygon_id, v } ) );
-                        index_t next_v{ ( v + 1 )
-                                        % polygons.nb_vertices( polygon_id ) };
-                        edge_indices.push_back(
-                            polygons.vertex( { polygon_id, next_v } ) );
+                        index_t adj{ polygons.adjacent( { polygon_id, v } ) };
+                        if( adj == NO_ID )
+                        {
+                            edge_indices.push_back(
+                                polygons.vertex( { polygon_id, v } ) );
+                            index_t next_v{ ( v + 1 ) % nb_vertices };
+                            edge_indices.push_back(
+                                polygons.vertex( { polygon_id, next_v } ) );
+                        }
                     }
                 }
-            }
+                return edge_indices;
+            } );
+        std::vector< index_t > edge_indices;
+        for( const auto& surface_edges : surface_edge_indices )
+        {
+            edge_indices.insert( edge_indices.end(), surface_edges.begin(),
+                surface_edges.end() );
         }
         return edge_indices;
     }
@@ -1037,29 +1448,30 @@ namespace
     }
 
     template < index_t DIMENSION >
-    std::vector< bool > are_border_edges_on_line(
+    std::vector< char > are_border_edges_on_line(
         const GeoModel< DIMENSION >& geomodel,
         const std::vector< vecn< DIMENSION > >& barycenters )
     {
         const auto& line_abbb = geomodel.mesh.edges.aabb();
-        std::vector< bool > border_edges_on_line( barycenters.size(), true );
-        double distance{ 0 };
-
-        for( auto border_edge : range( barycenters.size() ) )
-        {
-            const auto& barycenter = barycenters[border_edge];
-            std::tie( std::ignore, std::ignore, distance ) =
-                line_abbb.closest_edge( barycenter );
-            if( distance > geomodel.epsilon() )
-            {
-                border_edges_on_line[border_edge] = false;
-            }
-        }
+        auto epsilon = geomodel.epsilon();
+        std::vector< char > border_edges_on_line( barycenters.size(), true );
+
+        parallel_for( static_cast< index_t >( barycenters.size() ),
+            [&line_abbb, &barycenters, &border_edges_on_line, epsilon](
+                index_t border_edge ) {
+                double distance{ 0 };
+                std::tie( std::ignore, std::ignore, distance ) =
+                    line_abbb.closest_edge( barycenters[border_edge] );
+                if( distance > epsilon )
+                {
+                    border_edges_on_line[border_edge] = false;
+                }
+            } );
         return border_edges_on_line;
     }
 
     std::vector< index_t > compute_non_manifold_edges(
-        const std::vector< bool >& edge_on_lines )
+        const std::vector< char >& edge_on_lines )
     {
         std::vector< index_t > non_manifold_edges;
         for( auto e : range( edge_on_lines.size() ) )
@@ -1089,6 +1501,8 @@ namespace
             // Without that we cannot do anything
             geomodel_.mesh.vertices.test_and_initialize();
             geomodel_.mesh.polygons.test_and_initialize();
+            // Lazily computed values shared by the parallel checks
+            geomodel_.epsilon();
         }
 
         /*!
@@ -1107,29 +1521,20 @@ namespace
             if( enum_contains(
                     mode_, ValidityCheckMode::GEOMODEL_CONNECTIVITY ) )
             {
-                validity_tasks_handler_.execute(
-                    &GeoModelValidityCheck::test_geomodel_connectivity_validity,
-                    this );
+                test_geomodel_connectivity_validity();
             }
             if( enum_contains( mode_, ValidityCheckMode::GEOLOGICAL_ENTITIES ) )
             {
-                validity_tasks_handler_.execute(
-                    &GeoModelValidityCheck::test_geomodel_geological_validity,
-                    this );
+                test_geomodel_geological_validity();
             }
             if( enum_contains(
                     mode_, ValidityCheckMode::SURFACE_LINE_MESH_CONFORMITY ) )
             {
-                validity_tasks_handler_.execute(
-                    &GeoModelValidityCheck::test_surface_line_mesh_conformity,
-                    this );
+                test_surface_line_mesh_conformity();
             }
             if( enum_contains( mode_, ValidityCheckMode::MESH_ENTITIES ) )
             {
-                validity_tasks_handler_.execute(
-                    &GeoModelValidityCheck::
-                        test_geomodel_mesh_entities_validity,
-                    this );
+                test_geomodel_mesh_entities_validity();
                 /// TODO: find a way to add this test for Model3d. See BC.
                 //  threads.emplace_back(
                 //      &GeoModelValidityCheck::test_non_free_line_at_two_interfaces_intersection,
@@ -1137,6 +1542,12 @@ namespace
             }
         }
 
+        /*!
+         * @brief Runs the checks one after the other
+         * @details Each check spreads its work per entity or per chunk of
+         * mesh elements on the available threads and logs its findings in
+         * a deterministic order.
+         */
         void add_checks()
         {
             add_base_checks();
@@ -1145,7 +1556,6 @@ namespace
         void do_check_validity()
         {
             add_checks();
-            validity_tasks_handler_.wait_aysnc_tasks();
         }
 
         /*!
@@ -1203,9 +1613,16 @@ namespace
                 set_invalid_model();
             }
             // Check on that Surface edges are in a Line
+            auto invalid_corners = gather_on_surface_polygons( geomodel_,
+                []( const Surface< DIMENSION >& surface, index_t begin,
+                    index_t end ) {
+                    return invalid_surface_boundary_edges(
+                        surface, begin, end );
+                } );
             for( const auto& surface : geomodel_.surfaces() )
             {
-                if( !surface_boundary_valid( surface ) )
+                if( !surface_boundary_valid(
+                        surface, invalid_corners[surface.index()] ) )
                 {
                     set_invalid_model();
                 }
@@ -1220,9 +1637,17 @@ namespace
                 // cell facets
                 const auto& nn_search =
                     geomodel_.mesh.cells.cell_facet_nn_search();
+                auto unconformal_polygons = gather_on_surface_polygons(
+                    geomodel_,
+                    [&nn_search]( const Surface< DIMENSION >& surface,
+                        index_t begin, index_t end ) {
+                        return unconformal_surface_polygons(
+                            surface, nn_search, begin, end );
+                    } );
                 for( const auto& surface : geomodel_.surfaces() )
                 {
-                    if( !is_surface_conformal_to_volume( surface, nn_search ) )
+                    if( !is_surface_conformal_to_volume(
+                            surface, unconformal_polygons[surface.index()] ) )
                     {
                         set_invalid_model();
                     }
@@ -1324,12 +1749,7 @@ namespace
                 == geomodel_.mesh.polygons.nb_triangle()
                        + geomodel_.mesh.polygons.nb_quad() )
             {
-                std::vector< bool > has_intersection;
-                StoreIntersections< DIMENSION > action(
-                    geomodel_, has_intersection );
-                const auto& AABB = geomodel_.mesh.polygons.aabb();
-                AABB.compute_self_element_bbox_intersections( action );
-
+                auto has_intersection = compute_polygon_intersections();
                 auto nb_intersections = std::count(
                     has_intersection.begin(), has_intersection.end(), 1 );
 
@@ -1373,6 +1793,52 @@ namespace
             }
         }
 
+        /*!
+         * @brief Flags the polygons that intersect another polygon
+         * @details Each polygon box is queried in the AABBTree by chunks of
+         * polygons spread on the available threads. Most candidate pairs
+         * are rejected by a floating-point filter, the exact predicate being
+         * only evaluated for the ambiguous ones.
+         */
+        std::vector< char > compute_polygon_intersections() const
+        {
+            const auto& polygons = geomodel_.mesh.polygons;
+            const auto& vertices = geomodel_.mesh.vertices;
+            const auto& AABB = polygons.aabb();
+            index_t nb_polygons{ polygons.nb() };
+            index_t nb_chunks{ ( nb_polygons + VALIDITY_CHUNK_SIZE - 1 )
+                               / VALIDITY_CHUNK_SIZE };
+            std::vector< std::vector< index_t > > intersections( nb_chunks );
+            parallel_for( nb_chunks, [this, &polygons, &vertices, &AABB,
+                                         &intersections,
+                                         nb_polygons]( index_t chunk ) {
+                StoreIntersections< DIMENSION > action(
+                    geomodel_, intersections[chunk] );
+                index_t end{ std::min(
+                    nb_polygons, ( chunk + 1 ) * VALIDITY_CHUNK_SIZE ) };
+                for( auto p : range( chunk * VALIDITY_CHUNK_SIZE, end ) )
+                {
+                    Box< DIMENSION > box;
+                    for( auto v : range( polygons.nb_vertices( p ) ) )
+                    {
+                        box.add_point(
+                            vertices.vertex( polygons.vertex( { p, v } ) ) );
+                    }
+                    action.set_polygon( p );
+                    AABB.compute_bbox_element_bbox_intersections( box, action );
+                }
+            } );
+            std::vector< char > has_intersection( nb_polygons, 0 );
+            for( const auto& chunk_intersections : intersections )
+            {
+                for( auto p : chunk_intersections )
+                {
+                    has_intersection[p] = 1;
+                }
+            }
+            return has_intersection;
+        }
+
         void set_invalid_model()
         {
             valid_ = false;
@@ -1382,28 +1848,22 @@ namespace
         const GeoModel< DIMENSION >& geomodel_;
         bool valid_;
         ValidityCheckMode mode_;
-
-        TaskHandler validity_tasks_handler_;
     };
     template <>
     void GeoModelValidityCheck< 3 >::add_checks()
     {
         if( enum_contains( mode_, ValidityCheckMode::POLYGON_INTERSECTIONS ) )
         {
-            validity_tasks_handler_.execute(
-                &GeoModelValidityCheck::test_polygon_intersections, this );
+            test_polygon_intersections();
         }
         if( enum_contains(
                 mode_, ValidityCheckMode::REGION_SURFACE_MESH_CONFORMITY ) )
         {
-            validity_tasks_handler_.execute(
-                &GeoModelValidityCheck::test_region_surface_mesh_conformity,
-                this );
+            test_region_surface_mesh_conformity();
         }
         if( enum_contains( mode_, ValidityCheckMode::NON_MANIFOLD_EDGES ) )
         {
-            validity_tasks_handler_.execute(
-                &GeoModelValidityCheck::test_non_manifold_edges, this );
+            test_non_manifold_edges();
         }
         add_base_checks();
     }
@@ -1482,25 +1942,26 @@ namespace RINGMesh
             GEO::CmdLine::get_arg( "validity:do_not_check" ) );
     }
 
+    bool are_triangles_intersecting( const vec3& p0,
+        const vec3& p1,
+        const vec3& p2,
+        const vec3& q0,
+        const vec3& q1,
+        const vec3& q2 )
+    {
+        return IntersectionTriangle( p0, p1, p2 )
+            .intersects( IntersectionTriangle( q0, q1, q2 ) );
+    }
+
     template < index_t DIMENSION >
     bool are_geomodel_mesh_entities_mesh_valid(
         const GeoModel< DIMENSION >& geomodel )
     {
-        const auto& meshed_types = geomodel.entity_type_manager()
-                                       .mesh_entity_manager.mesh_entity_types();
-        index_t count_invalid{ 0 };
-        for( const auto& type : meshed_types )
-        {
-            index_t nb_entities{ geomodel.nb_mesh_entities( type ) };
-            for( auto i : range( nb_entities ) )
-            {
-                const auto& entity = geomodel.mesh_entity( type, i );
-                if( !entity.is_valid() )
-                {
-                    count_invalid++;
-                }
-            }
-        }
+        auto count_invalid = count_invalid_entities(
+            all_mesh_entities( geomodel ),
+            []( const GeoModelMeshEntity< DIMENSION >& entity ) {
+                return entity.is_valid();
+            } );
         if( count_invalid != 0 )
         {
             Logger::warn( "Validity", count_invalid,
@@ -1513,21 +1974,11 @@ namespace RINGMesh
     bool are_geomodel_mesh_entities_connectivity_valid(
         const GeoModel< DIMENSION >& geomodel )
     {
-        const auto& meshed_types = geomodel.entity_type_manager()
-                                       .mesh_entity_manager.mesh_entity_types();
-        index_t count_invalid{ 0 };
-        for( const auto& type : meshed_types )
-        {
-            index_t nb_entities{ geomodel.nb_mesh_entities( type ) };
-            for( auto i : range( nb_entities ) )
-            {
-                const auto& entity = geomodel.mesh_entity( type, i );
-                if( !entity.is_connectivity_valid() )
-                {
-                    count_invalid++;
-                }
-            }
-        }
+        auto count_invalid = count_invalid_entities(
+            all_mesh_entities( geomodel ),
+            []( const GeoModelMeshEntity< DIMENSION >& entity ) {
+                return entity.is_connectivity_valid();
+            } );
         if( count_invalid != 0 )
         {
             Logger::warn( "Validity", count_invalid,
@@ -1542,20 +1993,11 @@ namespace RINGMesh
     bool are_geomodel_geological_entities_valid(
         const GeoModel< DIMENSION >& geomodel )
     {
-        const auto& geological_types =
-            geomodel.entity_type_manager()
-                .geological_entity_manager.geological_entity_types();
-        index_t count_invalid{ 0 };
-        for( const auto& type : geological_types )
-        {
-            for( auto& geol_entity : geomodel.geol_entities( type ) )
-            {
-                if( !geol_entity.is_valid() )
-                {
-                    count_invalid++;
-                }
-            }
-        }
+        auto count_invalid = count_invalid_entities(
+            all_geological_entities( geomodel ),
+            []( const GeoModelGeologicalEntity< DIMENSION >& entity ) {
+                return entity.is_valid();
+            } );
         if( count_invalid != 0 )
         {
             Logger::warn( "Validity", count_invalid,
@@ -1568,21 +2010,11 @@ namespace RINGMesh
     bool are_geomodel_mesh_entities_parent_valid(
         const GeoModel< DIMENSION >& geomodel )
     {
-        const auto& meshed_types = geomodel.entity_type_manager()
-                                       .mesh_entity_manager.mesh_entity_types();
-        index_t count_invalid{ 0 };
-        for( const auto& type : meshed_types )
-        {
-            index_t nb_entities{ geomodel.nb_mesh_entities( type ) };
-            for( auto i : range( nb_entities ) )
-            {
-                const auto& geol_entity = geomodel.mesh_entity( type, i );
-                if( !geol_entity.is_parent_connectivity_valid() )
-                {
-                    count_invalid++;
-                }
-            }
-        }
+        auto count_invalid = count_invalid_entities(
+            all_mesh_entities( geomodel ),
+            []( const GeoModelMeshEntity< DIMENSION >& entity ) {
+                return entity.is_parent_connectivity_valid();
+            } );
         if( count_invalid != 0 )
         {
             Logger::warn( "Validity", count_invalid,
@@ -1756,6 +2188,539 @@ namespace RINGMesh
         return true;
     }
 
+    template < index_t DIMENSION >
+    class GeoModelValiditySession< DIMENSION >::Impl
+    {
+    public:
+        Impl( const GeoModel< DIMENSION >& geomodel,
+            ValidityCheckMode validity_check_mode )
+            : geomodel_( geomodel ), mode_( validity_check_mode )
+        {
+        }
+
+        const GeoModel< DIMENSION >& geomodel() const
+        {
+            return geomodel_;
+        }
+
+        bool is_geomodel_valid()
+        {
+            geomodel_.mesh.vertices.test_and_initialize();
+            geomodel_.mesh.polygons.test_and_initialize();
+            geomodel_.epsilon();
+
+            auto changes = take_changes();
+            if( changes.structure_changed )
+            {
+                reset();
+            }
+            else if( changes.mesh_entities.empty()
+                     && changes.geological_entities.empty() )
+            {
+                return report( valid_ );
+            }
+            else
+            {
+                mark_changed_entities( changes );
+            }
+
+            valid_ = true;
+            check_mesh_entities();
+            check_connectivity();
+            check_geology();
+            check_surface_line_conformity();
+            check_region_surface_conformity();
+            check_geomodel();
+            return report( valid_ );
+        }
+
+        void mesh_entity_changed( const gmme_id& id )
+        {
+            std::lock_guard< std::mutex > locking( changes_lock_ );
+            if( !changes_.structure_changed )
+            {
+                changes_.mesh_entities.insert( id );
+            }
+        }
+
+        void geological_entity_changed( const gmge_id& id )
+        {
+            std::lock_guard< std::mutex > locking( changes_lock_ );
+            if( !changes_.structure_changed )
+            {
+                changes_.geological_entities.insert( id );
+            }
+        }
+
+        void geomodel_changed()
+        {
+            std::lock_guard< std::mutex > locking( changes_lock_ );
+            changes_.structure_changed = true;
+            changes_.mesh_entities.clear();
+            changes_.geological_entities.clear();
+        }
+
+    private:
+        struct Changes
+        {
+            std::set< gmme_id > mesh_entities;
+            std::set< gmge_id > geological_entities;
+            bool structure_changed{ true };
+        };
+
+        Changes take_changes()
+        {
+            std::lock_guard< std::mutex > locking( changes_lock_ );
+            Changes changes;
+            std::swap( changes, changes_ );
+            changes_.structure_changed = false;
+            return changes;
+        }
+
+        /*!
+         * @brief Lists the GeoModel entities and marks all of them to check
+         */
+        void reset()
+        {
+            mesh_entities_ = all_mesh_entities( geomodel_ );
+            mesh_entity_indices_.clear();
+            for( auto e : range( mesh_entities_.size() ) )
+            {
+                mesh_entity_indices_[mesh_entities_[e]->gmme()] =
+                    static_cast< index_t >( e );
+            }
+            geological_entities_ = all_geological_entities( geomodel_ );
+            geological_entity_indices_.clear();
+            for( auto e : range( geological_entities_.size() ) )
+            {
+                geological_entity_indices_[geological_entities_[e]->gmge()] =
+                    static_cast< index_t >( e );
+            }
+
+            auto nb_mesh_entities = mesh_entities_.size();
+            mesh_valid_.assign( nb_mesh_entities, true );
+            connectivity_valid_.assign( nb_mesh_entities, true );
+            parent_valid_.assign( nb_mesh_entities, true );
+            vertices_valid_.assign( nb_mesh_entities, true );
+            surface_boundary_valid_.assign( nb_mesh_entities, true );
+            surface_conformity_valid_.assign( nb_mesh_entities, true );
+            geological_valid_.assign( geological_entities_.size(), true );
+
+            to_check_.resize( nb_mesh_entities );
+            std::iota( to_check_.begin(), to_check_.end(), 0 );
+            geological_to_check_.resize( geological_entities_.size() );
+            std::iota(
+                geological_to_check_.begin(), geological_to_check_.end(), 0 );
+        }
+
+        /*!
+         * @brief Marks the changed entities and their topological neighbours
+         * to check
+         */
+        void mark_changed_entities( const Changes& changes )
+        {
+            std::vector< char > mesh_marked( mesh_entities_.size(), false );
+            std::vector< char > geol_marked(
+                geological_entities_.size(), false );
+            auto mark_mesh = [this, &mesh_marked]( const gmme_id& id ) {
+                mesh_marked[mesh_entity_indices_.at( id )] = true;
+            };
+            auto mark_geol = [this, &geol_marked]( const gmge_id& id ) {
+                geol_marked[geological_entity_indices_.at( id )] = true;
+            };
+            for( const auto& id : changes.mesh_entities )
+            {
+                const auto& entity = geomodel_.mesh_entity( id );
+                mark_mesh( id );
+                for( auto b : range( entity.nb_boundaries() ) )
+                {
+                    mark_mesh( entity.boundary_gmme( b ) );
+                }
+                for( auto i : range( entity.nb_incident_entities() ) )
+                {
+                    mark_mesh( entity.incident_entity_gmme( i ) );
+                }
+                for( auto p : range( entity.nb_parents() ) )
+                {
+                    mark_geol( entity.parent_gmge( p ) );
+                }
+            }
+            for( const auto& id : changes.geological_entities )
+            {
+                const auto& entity = geomodel_.geological_entity( id );
+                mark_geol( id );
+                for( auto c : range( entity.nb_children() ) )
+                {
+                    mark_mesh( entity.child_gmme( c ) );
+                }
+            }
+            to_check_ = marked_indices( mesh_marked );
+            geological_to_check_ = marked_indices( geol_marked );
+        }
+
+        static std::vector< index_t > marked_indices(
+            const std::vector< char >& marked )
+        {
+            std::vector< index_t > indices;
+            for( auto i : range( marked.size() ) )
+            {
+                if( marked[i] )
+                {
+                    indices.push_back( static_cast< index_t >( i ) );
+                }
+            }
+            return indices;
+        }
+
+        bool is_checked( ValidityCheckMode check ) const
+        {
+            return enum_contains( mode_, check );
+        }
+
+        template < typename TEST >
+        void check_mesh_entities_to_check(
+            std::vector< char >& valid, const TEST& is_valid )
+        {
+            auto results =
+                check_entities( static_cast< index_t >( to_check_.size() ),
+                    [this, &is_valid]( index_t i ) {
+                        return is_valid( *mesh_entities_[to_check_[i]] );
+                    } );
+            for( auto i : range( to_check_.size() ) )
+            {
+                valid[to_check_[i]] = results[i];
+            }
+        }
+
+        void check_mesh_entities()
+        {
+            if( !is_checked( ValidityCheckMode::MESH_ENTITIES ) )
+            {
+                return;
+            }
+            check_mesh_entities_to_check( mesh_valid_,
+                []( const GeoModelMeshEntity< DIMENSION >& entity ) {
+                    return entity.is_valid();
+                } );
+            auto count_invalid = count_false( mesh_valid_ );
+            if( count_invalid != 0 )
+            {
+                Logger::warn( "Validity", count_invalid,
+                    " mesh entities of the GeoModel have an invalid mesh." );
+                valid_ = false;
+            }
+        }
+
+        void check_connectivity()
+        {
+            if( !is_checked( ValidityCheckMode::GEOMODEL_CONNECTIVITY ) )
+            {
+                return;
+            }
+            check_mesh_entities_to_check( connectivity_valid_,
+                []( const GeoModelMeshEntity< DIMENSION >& entity ) {
+                    return entity.is_connectivity_valid();
+                } );
+            auto count_invalid = count_false( connectivity_valid_ );
+            if( count_invalid != 0 )
+            {
+                Logger::warn( "Validity", count_invalid,
+                    " mesh entities of the "
+                    "GeoModel have an invalid "
+                    "connectivity." );
+                valid_ = false;
+            }
+            else if( !has_geomodel_finite_extension( geomodel_ ) )
+            {
+                valid_ = false;
+            }
+        }
+
+        void check_geology()
+        {
+            if( !is_checked( ValidityCheckMode::GEOLOGICAL_ENTITIES ) )
+            {
+                return;
+            }
+            auto results = check_entities(
+                static_cast< index_t >( geological_to_check_.size() ),
+                [this]( index_t i ) {
+                    return geological_entities_[geological_to_check_[i]]
+                        ->is_valid();
+                } );
+            for( auto i : range( geological_to_check_.size() ) )
+            {
+                geological_valid_[geological_to_check_[i]] = results[i];
+            }
+            auto count_invalid = count_false( geological_valid_ );
+            if( count_invalid != 0 )
+            {
+                Logger::warn( "Validity", count_invalid,
+                    " geological entities of the GeoModel are invalid." );
+                valid_ = false;
+            }
+            check_mesh_entities_to_check( parent_valid_,
+                []( const GeoModelMeshEntity< DIMENSION >& entity ) {
+                    return entity.is_parent_connectivity_valid();
+                } );
+            count_invalid = count_false( parent_valid_ );
+            if( count_invalid != 0 )
+            {
+                Logger::warn( "Validity", count_invalid,
+                    " mesh entities of the GeoModel have an invalid ",
+                    "parent connectivity (geological relationships)." );
+                valid_ = false;
+            }
+        }
+
+        void check_surface_line_conformity()
+        {
+            if( !is_checked( ValidityCheckMode::SURFACE_LINE_MESH_CONFORMITY ) )
+            {
+                return;
+            }
+            check_entity_vertices();
+            auto surfaces = surfaces_to_check();
+            std::vector< std::vector< index_t > > invalid_corners(
+                surfaces.size() );
+            parallel_for( static_cast< index_t >( surfaces.size() ),
+                [this, &surfaces, &invalid_corners]( index_t s ) {
+                    const auto& surface = this->surface( surfaces[s] );
+                    invalid_corners[s] = invalid_surface_boundary_edges(
+                        surface, 0, surface.nb_mesh_elements() );
+                } );
+            for( auto s : range( surfaces.size() ) )
+            {
+                surface_boundary_valid_[surfaces[s]] = surface_boundary_valid(
+                    surface( surfaces[s] ), invalid_corners[s] );
+            }
+            if( count_false( surface_boundary_valid_ ) != 0 )
+            {
+                valid_ = false;
+            }
+        }
+
+        /*!
+         * @brief Checks the geomodel vertices of the entities to check
+         * @details An entity is valid if none of its vertices is invalid.
+         */
+        void check_entity_vertices()
+        {
+            const auto& vertices = geomodel_.mesh.vertices;
+            std::vector< char > checked( vertices.nb(), false );
+            std::vector< index_t > vertex_ids;
+            for( auto e : to_check_ )
+            {
+                const auto& entity = *mesh_entities_[e];
+                for( auto v : range( entity.nb_vertices() ) )
+                {
+                    auto vertex_id =
+                        vertices.geomodel_vertex_id( entity.gmme(), v );
+                    if( vertex_id != NO_ID && !checked[vertex_id] )
+                    {
+                        checked[vertex_id] = true;
+                        vertex_ids.push_back( vertex_id );
+                    }
+                }
+                vertices_valid_[e] = true;
+            }
+            auto valid = are_geomodel_vertices_valid( geomodel_, vertex_ids );
+            std::vector< char > geomodel_vertices_valid( vertices.nb(), true );
+            for( auto i : range( vertex_ids.size() ) )
+            {
+                if( valid[i] )
+                {
+                    continue;
+                }
+                geomodel_vertices_valid[vertex_ids[i]] = false;
+                for( const auto& vertex :
+                    vertices.gme_vertices( vertex_ids[i] ) )
+                {
+                    auto it = mesh_entity_indices_.find( vertex.gmme );
+                    if( it != mesh_entity_indices_.end() )
+                    {
+                        vertices_valid_[it->second] = false;
+                    }
+                }
+            }
+            report_invalid_points( geomodel_, geomodel_vertices_valid );
+            if( count_false( vertices_valid_ ) != 0 )
+            {
+                valid_ = false;
+            }
+        }
+
+        void check_region_surface_conformity();
+
+        /*!
+         * @brief Runs again the checks on the whole GeoModel
+         */
+        void check_geomodel()
+        {
+            auto global_mode =
+                mode_
+                & ( ValidityCheckMode::NON_MANIFOLD_EDGES
+                      | ValidityCheckMode::POLYGON_INTERSECTIONS );
+            if( global_mode == ValidityCheckMode::EMPTY )
+            {
+                return;
+            }
+            GeoModelValidityCheck< DIMENSION > validity_checker(
+                geomodel_, global_mode );
+            if( !validity_checker.is_geomodel_valid() )
+            {
+                valid_ = false;
+            }
+        }
+
+        /*!
+         * @brief Gets the Surfaces among the entities to check
+         */
+        std::vector< index_t > surfaces_to_check() const
+        {
+            std::vector< index_t > surfaces;
+            for( auto e : to_check_ )
+            {
+                if( mesh_entities_[e]->type_name()
+                    == Surface< DIMENSION >::type_name_static() )
+                {
+                    surfaces.push_back( e );
+                }
+            }
+            return surfaces;
+        }
+
+        const Surface< DIMENSION >& surface( index_t e ) const
+        {
+            return geomodel_.surface( mesh_entities_[e]->index() );
+        }
+
+        static index_t count_false( const std::vector< char >& values )
+        {
+            return static_cast< index_t >(
+                std::count( values.begin(), values.end(), 0 ) );
+        }
+
+        bool report( bool valid ) const
+        {
+            if( valid )
+            {
+                Logger::out(
+                    "Validity", "GeoModel ", geomodel_.name(), " is valid." );
+            }
+            else
+            {
+                Logger::warn( "Validity", "GeoModel ", geomodel_.name(),
+                    " is invalid." );
+            }
+            return valid;
+        }
+
+    private:
+        const GeoModel< DIMENSION >& geomodel_;
+        ValidityCheckMode mode_;
+        bool valid_{ true };
+
+        std::mutex changes_lock_{};
+        Changes changes_{};
+
+        std::vector< const GeoModelMeshEntity< DIMENSION >* > mesh_entities_{};
+        std::map< gmme_id, index_t > mesh_entity_indices_{};
+        std::vector< const GeoModelGeologicalEntity< DIMENSION >* >
+            geological_entities_{};
+        std::map< gmge_id, index_t > geological_entity_indices_{};
+
+        /// Entities whose checks are run by the next validity check
+        std::vector< index_t > to_check_{};
+        std::vector< index_t > geological_to_check_{};
+
+        /// Cached check results, one value per entity
+        std::vector< char > mesh_valid_{};
+        std::vector< char > connectivity_valid_{};
+        std::vector< char > parent_valid_{};
+        std::vector< char > vertices_valid_{};
+        std::vector< char > surface_boundary_valid_{};
+        std::vector< char > surface_conformity_valid_{};
+        std::vector< char > geological_valid_{};
+    };
+
+    template <>
+    void GeoModelValiditySession< 2 >::Impl::check_region_surface_conformity()
+    {
+    }
+
+    template <>
+    void GeoModelValiditySession< 3 >::Impl::check_region_surface_conformity()
+    {
+        if( !is_checked( ValidityCheckMode::REGION_SURFACE_MESH_CONFORMITY )
+            || geomodel_.mesh.cells.nb() == 0 )
+        {
+            return;
+        }
+        const auto& nn_search = geomodel_.mesh.cells.cell_facet_nn_search();
+        auto surfaces = surfaces_to_check();
+        std::vector< std::vector< index_t > > unconformal_polygons(
+            surfaces.size() );
+        parallel_for( static_cast< index_t >( surfaces.size() ),
+            [this, &nn_search, &surfaces, &unconformal_polygons]( index_t s ) {
+                const auto& surface = this->surface( surfaces[s] );
+                unconformal_polygons[s] = unconformal_surface_polygons(
+                    surface, nn_search, 0, surface.nb_mesh_elements() );
+            } );
+        for( auto s : range( surfaces.size() ) )
+        {
+            surface_conformity_valid_[surfaces[s]] =
+                is_surface_conformal_to_volume(
+                    surface( surfaces[s] ), unconformal_polygons[s] );
+        }
+        if( count_false( surface_conformity_valid_ ) != 0 )
+        {
+            valid_ = false;
+        }
+    }
+
+    template < index_t DIMENSION >
+    GeoModelValiditySession< DIMENSION >::GeoModelValiditySession(
+        const GeoModel< DIMENSION >& geomodel,
+        ValidityCheckMode validity_check_mode )
+        : impl_( geomodel, validity_check_mode )
+    {
+        geomodel.add_change_listener( *this );
+    }
+
+    template < index_t DIMENSION >
+    GeoModelValiditySession< DIMENSION >::~GeoModelValiditySession()
+    {
+        impl_->geomodel().remove_change_listener( *this );
+    }
+
+    template < index_t DIMENSION >
+    bool GeoModelValiditySession< DIMENSION >::is_geomodel_valid()
+    {
+        return impl_->is_geomodel_valid();
+    }
+
+    template < index_t DIMENSION >
+    void GeoModelValiditySession< DIMENSION >::mesh_entity_changed(
+        const gmme_id& id )
+    {
+        impl_->mesh_entity_changed( id );
+    }
+
+    template < index_t DIMENSION >
+    void GeoModelValiditySession< DIMENSION >::geological_entity_changed(
+        const gmge_id& id )
+    {
+        impl_->geological_entity_changed( id );
+    }
+
+    template < index_t DIMENSION >
+    void GeoModelValiditySession< DIMENSION >::geomodel_changed()
+    {
+        impl_->geomodel_changed();
+    }
+
+    template class geomodel_tools_api GeoModelValiditySession< 2 >;
     template bool geomodel_tools_api is_geomodel_valid< 2 >(
         const GeoModel2D&, ValidityCheckMode );
     template bool geomodel_tools_api are_geomodel_mesh_entities_mesh_valid(
@@ -1767,6 +2732,7 @@ namespace RINGMesh
     template bool geomodel_tools_api are_geomodel_geological_entities_valid(
         const GeoModel2D& );
 
+    template class geomodel_tools_api GeoModelValiditySession< 3 >;
     template bool geomodel_tools_api is_geomodel_valid< 3 >(
         const GeoModel3D&, ValidityCheckMode );
     template bool geomodel_tools_api are_geomodel_mesh_entities_mesh_valid(
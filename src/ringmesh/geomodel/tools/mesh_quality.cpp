@@ -34,8 +34,15 @@
  */
 
 #include <algorithm>
+#include <array>
+#include <limits>
 
 #include <geogram/basic/attributes.h>
+
+#include <ringmesh/basic/algorithm.h>
+#include <ringmesh/basic/task_handler.h>
+
+#include <ringmesh/geomodel/builder/geomodel_builder.h>
 #include <ringmesh/geomodel/core/geomodel.h>
 #include <ringmesh/geomodel/core/geomodel_mesh_entity.h>
 #include <ringmesh/geomodel/tools/mesh_quality.h>
@@ -44,6 +51,9 @@
 #include <ringmesh/mesh/mesh_index.h>
 
 #include <ringmesh/mesh/volume_mesh.h>
+
+#include "tet_block_quality.hpp"
+
 /*!
  * @author Benjamin Chauvin
  * This code is inspired from
@@ -353,6 +363,1274 @@ namespace
             quality > -1 * global_epsilon && quality < 1 + global_epsilon );
         return quality;
     }
+
+    void gather_tet_block(
+        const Region3D& region, index_t first_cell, TetBlock& block )
+    {
+        block.first_cell = first_cell;
+        block.nb_tets = std::min(
+            CELL_BLOCK_SIZE, region.nb_mesh_elements() - first_cell );
+        for( auto t : range( block.nb_tets ) )
+        {
+            for( auto v : range( 4 ) )
+            {
+                const auto& point =
+                    region.mesh_element_vertex( { first_cell + t, v } );
+                for( auto axis : range( 3 ) )
+                {
+                    block.coords[v][axis][t] = point[axis];
+                }
+            }
+        }
+    }
+
+    /*!
+     * @brief Splits the cells of all the Regions in blocks of consecutive
+     * cells, given by Region index and first cell
+     */
+    std::vector< std::pair< index_t, index_t > > region_cell_blocks(
+        const GeoModel3D& geomodel )
+    {
+        std::vector< std::pair< index_t, index_t > > blocks;
+        for( const auto& region : geomodel.regions() )
+        {
+            ringmesh_assert( region.is_meshed() );
+            for( index_t first_cell = 0;
+                 first_cell < region.nb_mesh_elements();
+                 first_cell += CELL_BLOCK_SIZE )
+            {
+                blocks.emplace_back( region.index(), first_cell );
+            }
+        }
+        return blocks;
+    }
+
+    /*!
+     * @brief Computes the qualities of all the Region cells by blocks
+     * processed in parallel
+     * @param[in] action called for each block as action( region, block ),
+     * possibly concurrently for different blocks
+     */
+    template < typename ACTION >
+    void for_each_tet_block( const GeoModel3D& geomodel, const ACTION& action )
+    {
+        auto blocks = region_cell_blocks( geomodel );
+        parallel_for( static_cast< index_t >( blocks.size() ),
+            [&geomodel, &blocks, &action]( index_t b ) {
+                const auto& region = geomodel.region( blocks[b].first );
+                ringmesh_assert( region.is_simplicial() );
+                TetBlock block;
+                gather_tet_block( region, blocks[b].second, block );
+                compute_tet_block_qualities( block );
+                action( region, block );
+            } );
+    }
+
+    /*!
+     * @brief Local description of a cell type, following the vertex
+     * numbering of geogram cell descriptors
+     */
+    struct CellShape
+    {
+        index_t nb_vertices;
+        /// Each corner vertex then its three neighbors, ordered so that the
+        /// corner Jacobian of a valid cell is positive
+        index_t nb_corners;
+        index_t corners[8][4];
+        index_t nb_facets;
+        index_t nb_facet_vertices[6];
+        index_t facets[6][4];
+        index_t nb_edges;
+        index_t edges[12][2];
+        /// Inverse of the corner Jacobian of the regular cell of unit edges
+        double jacobian_scale;
+    };
+
+    const CellShape tet_shape = { 4, 4,
+        { { 0, 1, 2, 3 }, { 1, 2, 0, 3 }, { 2, 0, 1, 3 }, { 3, 0, 2, 1 } }, 4,
+        { 3, 3, 3, 3 }, { { 1, 3, 2 }, { 0, 2, 3 }, { 3, 1, 0 }, { 0, 1, 2 } },
+        6, { { 1, 2 }, { 2, 3 }, { 3, 1 }, { 0, 1 }, { 0, 2 }, { 0, 3 } },
+        std::sqrt( 2. ) };
+
+    const CellShape hex_shape = { 8, 8,
+        { { 0, 1, 2, 4 }, { 1, 3, 0, 5 }, { 2, 0, 3, 6 }, { 3, 2, 1, 7 },
+            { 4, 6, 5, 0 }, { 5, 4, 7, 1 }, { 6, 7, 4, 2 }, { 7, 5, 6, 3 } },
+        6, { 4, 4, 4, 4, 4, 4 },
+        { { 0, 2, 6, 4 }, { 3, 1, 5, 7 }, { 1, 0, 4, 5 }, { 2, 3, 7, 6 },
+            { 1, 3, 2, 0 }, { 4, 6, 7, 5 } },
+        12, { { 0, 1 }, { 1, 3 }, { 3, 2 }, { 2, 0 }, { 4, 5 }, { 5, 7 },
+                { 7, 6 }, { 6, 4 }, { 0, 4 }, { 1, 5 }, { 3, 7 }, { 2, 6 } },
+        1. };
+
+    const CellShape prism_shape = { 6, 6,
+        { { 0, 1, 2, 3 }, { 1, 2, 0, 4 }, { 2, 0, 1, 5 }, { 3, 5, 4, 0 },
+            { 4, 3, 5, 1 }, { 5, 4, 3, 2 } },
+        5, { 3, 3, 4, 4, 4 },
+        { { 0, 1, 2 }, { 3, 5, 4 }, { 0, 3, 4, 1 }, { 0, 2, 5, 3 },
+            { 1, 4, 5, 2 } },
+        9, { { 0, 1 }, { 1, 2 }, { 2, 0 }, { 3, 4 }, { 4, 5 }, { 5, 3 },
+               { 0, 3 }, { 1, 4 }, { 2, 5 } },
+        2. / std::sqrt( 3. ) };
+
+    // The apex corners use three consecutive base vertices
+    const CellShape pyramid_shape = { 5, 8,
+        { { 0, 1, 3, 4 }, { 1, 2, 0, 4 }, { 2, 3, 1, 4 }, { 3, 0, 2, 4 },
+            { 4, 2, 1, 0 }, { 4, 3, 2, 1 }, { 4, 0, 3, 2 }, { 4, 1, 0, 3 } },
+        5, { 4, 3, 3, 3, 3 },
+        { { 0, 1, 2, 3 }, { 0, 4, 1 }, { 0, 3, 4 }, { 2, 4, 3 },
+            { 2, 1, 4 } },
+        8, { { 0, 1 }, { 1, 2 }, { 2, 3 }, { 3, 0 }, { 0, 4 }, { 1, 4 },
+               { 2, 4 }, { 3, 4 } },
+        std::sqrt( 2. ) };
+
+    const CellShape& cell_shape( CellType type )
+    {
+        switch( type )
+        {
+        case CellType::HEXAHEDRON:
+            return hex_shape;
+        case CellType::PRISM:
+            return prism_shape;
+        case CellType::PYRAMID:
+            return pyramid_shape;
+        default:
+            ringmesh_assert( type == CellType::TETRAHEDRON );
+            return tet_shape;
+        }
+    }
+
+    /*!
+     * @brief Minimum over the cell corners of the Jacobian determinant
+     * divided by the length of the three corner edges, scaled to 1 for the
+     * regular cell and clamped to [-1,1]. Negative for inverted corners.
+     */
+    double cell_scaled_jacobian(
+        const CellShape& shape, const std::array< vec3, 8 >& points )
+    {
+        double min_jacobian{ max_float64() };
+        for( auto c : range( shape.nb_corners ) )
+        {
+            const auto& corner = shape.corners[c];
+            const auto& origin = points[corner[0]];
+            vec3 u = points[corner[1]] - origin;
+            vec3 v = points[corner[2]] - origin;
+            vec3 w = points[corner[3]] - origin;
+            double lengths = u.length() * v.length() * w.length();
+            double jacobian =
+                lengths > 0 ? dot( u, cross( v, w ) ) / lengths : 0;
+            min_jacobian = std::min( min_jacobian, jacobian );
+        }
+        return std::max(
+            -1., std::min( 1., shape.jacobian_scale * min_jacobian ) );
+    }
+
+    /*!
+     * @brief Maximum over the cell facets of the equiangle skewness, the
+     * largest relative deviation of the facet angles from the angle of the
+     * regular polygon (60 degrees for triangles, 90 for quadrilaterals).
+     * 0 for regular facets, 1 for degenerate ones.
+     */
+    double cell_equiangle_skewness(
+        const CellShape& shape, const std::array< vec3, 8 >& points )
+    {
+        double max_skewness{ 0 };
+        for( auto f : range( shape.nb_facets ) )
+        {
+            auto nb_vertices = shape.nb_facet_vertices[f];
+            const auto& facet = shape.facets[f];
+            double min_angle{ M_PI };
+            double max_angle{ 0 };
+            for( auto v : range( nb_vertices ) )
+            {
+                const auto& point = points[facet[v]];
+                vec3 prev = points[facet[( v + nb_vertices - 1 ) % nb_vertices]]
+                            - point;
+                vec3 next = points[facet[( v + 1 ) % nb_vertices]] - point;
+                double lengths = prev.length() * next.length();
+                double angle{ 0 };
+                if( lengths > 0 )
+                {
+                    angle = std::acos( std::max(
+                        -1., std::min( 1., dot( prev, next ) / lengths ) ) );
+                }
+                min_angle = std::min( min_angle, angle );
+                max_angle = std::max( max_angle, angle );
+            }
+            double equiangle = nb_vertices == 3 ? M_PI / 3 : M_PI / 2;
+            max_skewness = std::max( max_skewness,
+                std::max( ( max_angle - equiangle ) / ( M_PI - equiangle ),
+                    ( equiangle - min_angle ) / equiangle ) );
+        }
+        return max_skewness;
+    }
+
+    /*!
+     * @brief Ratio of the longest cell edge to the shortest one, 1 for
+     * regular cells
+     */
+    double cell_edge_aspect_ratio(
+        const CellShape& shape, const std::array< vec3, 8 >& points )
+    {
+        double min_length2{ max_float64() };
+        double max_length2{ 0 };
+        for( auto e : range( shape.nb_edges ) )
+        {
+            double length2 =
+                ( points[shape.edges[e][1]] - points[shape.edges[e][0]] )
+                    .length2();
+            min_length2 = std::min( min_length2, length2 );
+            max_length2 = std::max( max_length2, length2 );
+        }
+        if( min_length2 <= 0 )
+        {
+            return max_float64();
+        }
+        return std::sqrt( max_length2 / min_length2 );
+    }
+
+    double get_cell_quality(
+        const Region3D& region, index_t cell, CellQualityMode mode )
+    {
+        const auto& shape = cell_shape( region.cell_type( cell ) );
+        std::array< vec3, 8 > points;
+        for( auto v : range( shape.nb_vertices ) )
+        {
+            points[v] = region.mesh_element_vertex( { cell, v } );
+        }
+        switch( mode )
+        {
+        case SCALED_JACOBIAN:
+            return cell_scaled_jacobian( shape, points );
+        case EQUIANGLE_SKEWNESS:
+            return cell_equiangle_skewness( shape, points );
+        case EDGE_ASPECT_RATIO:
+            return cell_edge_aspect_ratio( shape, points );
+        default:
+            ringmesh_assert_not_reached;
+            return 0;
+        }
+    }
+
+    std::string cell_qual_mode_to_prop_name( CellQualityMode mode )
+    {
+        switch( mode )
+        {
+        case SCALED_JACOBIAN:
+            return "SCALED_JACOBIAN";
+        case EQUIANGLE_SKEWNESS:
+            return "EQUIANGLE_SKEWNESS";
+        case EDGE_ASPECT_RATIO:
+            return "EDGE_ASPECT_RATIO";
+        default:
+            ringmesh_assert_not_reached;
+            return "";
+        }
+    }
+
+    /*!
+     * @brief Computes a cell quality of all the Region cells by blocks
+     * processed in parallel
+     * @param[in] action called for each cell as action( region, cell,
+     * quality ), possibly concurrently for cells of different blocks
+     */
+    template < typename ACTION >
+    void for_each_cell_quality( CellQualityMode mode,
+        const GeoModel3D& geomodel,
+        const ACTION& action )
+    {
+        auto blocks = region_cell_blocks( geomodel );
+        parallel_for( static_cast< index_t >( blocks.size() ),
+            [&geomodel, &blocks, &action, mode]( index_t b ) {
+                const auto& region = geomodel.region( blocks[b].first );
+                auto end = std::min( blocks[b].second + CELL_BLOCK_SIZE,
+                    region.nb_mesh_elements() );
+                for( auto cell : range( blocks[b].second, end ) )
+                {
+                    action( region, cell,
+                        get_cell_quality( region, cell, mode ) );
+                }
+            } );
+    }
+
+    /*!
+     * @brief Binds the quality attributes of each Region, before any
+     * concurrent write
+     */
+    std::vector< std::unique_ptr< GEO::Attribute< double > > >
+        bind_quality_attributes(
+            const std::string& name, const GeoModel3D& geomodel )
+    {
+        std::vector< std::unique_ptr< GEO::Attribute< double > > > attributes;
+        for( const auto& region : geomodel.regions() )
+        {
+            attributes.emplace_back( new GEO::Attribute< double >(
+                region.cell_attribute_manager(), name ) );
+        }
+        return attributes;
+    }
+
+    /*!
+     * @return for each Region, the index of its first cell among the cells
+     * of all the Regions, and the total number of cells
+     */
+    std::vector< index_t > region_cell_offsets( const GeoModel3D& geomodel )
+    {
+        std::vector< index_t > offsets( geomodel.nb_regions() + 1, 0 );
+        for( const auto& region : geomodel.regions() )
+        {
+            offsets[region.index() + 1] =
+                offsets[region.index()] + region.nb_mesh_elements();
+        }
+        return offsets;
+    }
+
+    /*!
+     * @brief Computes the distribution of cell quality values
+     * @param[in] values the cell qualities, reordered by the function
+     * @param[in] is_low_quality predicate telling if a value is of low
+     * quality
+     */
+    template < typename PREDICATE >
+    MeshQualityStatistics quality_statistics( std::vector< double >& values,
+        const PREDICATE& is_low_quality,
+        double histogram_min,
+        double histogram_max,
+        index_t nb_bins )
+    {
+        ringmesh_assert( nb_bins > 0 );
+        MeshQualityStatistics statistics;
+        statistics.histogram_min = histogram_min;
+        statistics.histogram_max = histogram_max;
+        statistics.histogram.resize( nb_bins, 0 );
+        statistics.nb_cells = static_cast< index_t >( values.size() );
+        if( values.empty() )
+        {
+            return statistics;
+        }
+        statistics.min_value = max_float64();
+        statistics.max_value = -max_float64();
+        double sum{ 0 };
+        auto bin_size = ( histogram_max - histogram_min )
+                        / static_cast< double >( nb_bins );
+        for( auto value : values )
+        {
+            statistics.min_value = std::min( statistics.min_value, value );
+            statistics.max_value = std::max( statistics.max_value, value );
+            sum += value;
+            if( is_low_quality( value ) )
+            {
+                statistics.nb_low_quality_cells++;
+            }
+            auto bin = static_cast< index_t >(
+                std::max( value - histogram_min, 0. ) / bin_size );
+            statistics.histogram[std::min( bin, nb_bins - 1 )]++;
+        }
+        statistics.mean = sum / static_cast< double >( values.size() );
+
+        // Nearest rank quantiles, the quartiles being searched on each
+        // side of the partially sorted median
+        auto last = static_cast< double >( values.size() - 1 );
+        auto rank = [&values, last]( double quantile ) {
+            return values.begin()
+                   + static_cast< std::ptrdiff_t >( quantile * last );
+        };
+        auto median = rank( 0.5 );
+        std::nth_element( values.begin(), median, values.end() );
+        statistics.median = *median;
+        auto first_quartile = rank( 0.25 );
+        std::nth_element( values.begin(), first_quartile, median );
+        statistics.first_quartile = *first_quartile;
+        auto third_quartile = rank( 0.75 );
+        std::nth_element( median, third_quartile, values.end() );
+        statistics.third_quartile = *third_quartile;
+        return statistics;
+    }
+
+    using TetFacet = std::array< index_t, 3 >;
+
+    TetFacet sorted_facet( index_t v0, index_t v1, index_t v2 )
+    {
+        TetFacet facet{ { v0, v1, v2 } };
+        std::sort( facet.begin(), facet.end() );
+        return facet;
+    }
+
+    /*!
+     * @brief Gets the triangles of the surfaces bounding a Region, given by
+     * sorted Region vertex indices
+     */
+    std::vector< TetFacet > region_constrained_facets( const Region3D& region )
+    {
+        const auto& geomodel_vertices = region.geomodel().mesh.vertices;
+        std::vector< index_t > region_vertices(
+            geomodel_vertices.nb(), NO_ID );
+        for( auto v : range( region.nb_vertices() ) )
+        {
+            region_vertices[geomodel_vertices.geomodel_vertex_id(
+                region.gmme(), v )] = v;
+        }
+        std::vector< TetFacet > facets;
+        for( auto b : range( region.nb_boundaries() ) )
+        {
+            const auto& surface = region.boundary( b );
+            for( auto p : range( surface.nb_mesh_elements() ) )
+            {
+                if( surface.nb_mesh_element_vertices( p ) != 3 )
+                {
+                    continue;
+                }
+                TetFacet facet;
+                for( auto v : range( 3 ) )
+                {
+                    facet[v] =
+                        region_vertices[geomodel_vertices.geomodel_vertex_id(
+                            surface.gmme(), { p, v } )];
+                }
+                if( !contains( facet, NO_ID ) )
+                {
+                    facets.push_back(
+                        sorted_facet( facet[0], facet[1], facet[2] ) );
+                }
+            }
+        }
+        sort_unique( facets );
+        return facets;
+    }
+
+    /*!
+     * @brief Cells and vertex reserved for the modifications of one cavity
+     */
+    struct CavitySlots
+    {
+        std::vector< index_t > cells;
+        index_t nb_used_cells{ 0 };
+        index_t vertex{ NO_ID };
+        bool vertex_used{ false };
+        std::vector< index_t > freed_cells;
+    };
+
+    /*!
+     * @brief Local improvement of the low quality tetrahedra of a Region
+     * @details The region mesh is copied in flat arrays, facet f of a cell
+     * being opposite to its vertex f. Each low quality cell is improved
+     * within its cavity (the cells around its vertices) by the first
+     * operation raising the minimal quality of the cavity: edge removal
+     * (3-2 flip), facet removal (2-3 flip), vertex smoothing or edge split.
+     * The cavities are processed by batches of disjoint cavities, each batch
+     * being improved in parallel. The facets on the region boundaries and on
+     * the surfaces inside the region are never removed and their vertices
+     * never move.
+     */
+    class RegionTetImprover
+    {
+    public:
+        RegionTetImprover( const Region3D& region,
+            std::vector< TetFacet > constrained_facets,
+            MeshQualityMode mesh_qual_mode,
+            double min_quality )
+            : mesh_qual_mode_( mesh_qual_mode ),
+              min_quality_( min_quality ),
+              constrained_facets_( std::move( constrained_facets ) )
+        {
+            copy_region_mesh( region );
+            initialize_fixed_vertices();
+        }
+
+        /*!
+         * Runs one improvement pass over the cells below the minimal quality
+         * @return the number of cells improved
+         */
+        index_t improve()
+        {
+            auto pending = low_quality_cells();
+            index_t nb_improved{ 0 };
+            std::vector< index_t > cell_batch( nb_cells(), NO_ID );
+            index_t batch_id{ 0 };
+            while( !pending.empty() )
+            {
+                std::vector< index_t > batch;
+                std::vector< index_t > postponed;
+                cell_batch.resize( nb_cells(), NO_ID );
+                for( auto cell : pending )
+                {
+                    if( is_dead( cell ) )
+                    {
+                        continue;
+                    }
+                    auto cavity = cell_cavity( cell );
+                    if( std::any_of( cavity.begin(), cavity.end(),
+                            [&cell_batch, batch_id]( index_t c ) {
+                                return cell_batch[c] == batch_id;
+                            } ) )
+                    {
+                        postponed.push_back( cell );
+                        continue;
+                    }
+                    for( auto c : cavity )
+                    {
+                        cell_batch[c] = batch_id;
+                    }
+                    batch.push_back( cell );
+                }
+                auto slots = reserve_slots( batch );
+                std::vector< char > improved( batch.size(), 0 );
+                parallel_for( static_cast< index_t >( batch.size() ),
+                    [&]( index_t i ) {
+                        improved[i] = improve_cell( batch[i], slots[i] );
+                    } );
+                release_slots( slots );
+                nb_improved += static_cast< index_t >(
+                    std::count( improved.begin(), improved.end(), 1 ) );
+                pending = std::move( postponed );
+                batch_id++;
+            }
+            return nb_improved;
+        }
+
+        index_t nb_low_quality_cells() const
+        {
+            return static_cast< index_t >( low_quality_cells().size() );
+        }
+
+        /*!
+         * Replaces the region mesh by the improved one
+         */
+        void update_region_mesh( VolumeMeshBuilder3D& builder )
+        {
+            compact();
+            builder.assign_tet_mesh( points_.front().data(),
+                static_cast< index_t >( points_.size() ), tets_.data(),
+                adjacents_.data(), nb_cells() );
+        }
+
+    private:
+        index_t nb_cells() const
+        {
+            return static_cast< index_t >( tets_.size() / 4 );
+        }
+
+        bool is_dead( index_t cell ) const
+        {
+            return tets_[4 * cell] == NO_ID;
+        }
+
+        index_t cell_vertex( index_t cell, index_t v ) const
+        {
+            return tets_[4 * cell + v];
+        }
+
+        index_t local_vertex( index_t cell, index_t vertex ) const
+        {
+            for( auto v : range( 4 ) )
+            {
+                if( cell_vertex( cell, v ) == vertex )
+                {
+                    return v;
+                }
+            }
+            return NO_ID;
+        }
+
+        double signed_volume( const std::array< index_t, 4 >& tet ) const
+        {
+            return orientation_
+                   * GEO::Geom::tetra_signed_volume( points_[tet[0]],
+                         points_[tet[1]], points_[tet[2]], points_[tet[3]] );
+        }
+
+        double quality( const std::array< index_t, 4 >& tet ) const
+        {
+            if( signed_volume( tet ) <= 0 )
+            {
+                return 0;
+            }
+            return get_tet_quality( points_[tet[0]], points_[tet[1]],
+                points_[tet[2]], points_[tet[3]], mesh_qual_mode_ );
+        }
+
+        std::array< index_t, 4 > cell_tet( index_t cell ) const
+        {
+            return { { tets_[4 * cell], tets_[4 * cell + 1],
+                tets_[4 * cell + 2], tets_[4 * cell + 3] } };
+        }
+
+        double cell_quality( index_t c ) const
+        {
+            return quality( cell_tet( c ) );
+        }
+
+        void copy_region_mesh( const Region3D& region )
+        {
+            const auto& mesh = region.mesh();
+            points_.resize( mesh.nb_vertices() );
+            parallel_for( mesh.nb_vertices(),
+                [this, &mesh]( index_t v ) { points_[v] = mesh.vertex( v ); } );
+            tets_.resize( 4 * mesh.nb_cells() );
+            adjacents_.resize( 4 * mesh.nb_cells() );
+            parallel_for( mesh.nb_cells(), [this, &mesh]( index_t c ) {
+                for( auto v : range( 4 ) )
+                {
+                    tets_[4 * c + v] = mesh.cell_vertex( { c, v } );
+                    adjacents_[4 * c + v] = mesh.cell_adjacent( { c, v } );
+                }
+            } );
+            vertex_cell_.assign( points_.size(), NO_ID );
+            for( auto c : range( nb_cells() ) )
+            {
+                for( auto v : range( 4 ) )
+                {
+                    vertex_cell_[cell_vertex( c, v )] = c;
+                }
+            }
+            for( auto c : range( nb_cells() ) )
+            {
+                auto volume = GEO::Geom::tetra_signed_volume(
+                    points_[cell_vertex( c, 0 )], points_[cell_vertex( c, 1 )],
+                    points_[cell_vertex( c, 2 )],
+                    points_[cell_vertex( c, 3 )] );
+                if( volume != 0 )
+                {
+                    orientation_ = volume > 0 ? 1. : -1.;
+                    break;
+                }
+            }
+        }
+
+        void initialize_fixed_vertices()
+        {
+            fixed_vertices_.assign( points_.size(), 0 );
+            for( auto c : range( nb_cells() ) )
+            {
+                for( auto f : range( 4 ) )
+                {
+                    if( adjacents_[4 * c + f] == NO_ID
+                        || is_constrained( c, f ) )
+                    {
+                        for( auto v : range( 4 ) )
+                        {
+                            if( v != f )
+                            {
+                                fixed_vertices_[cell_vertex( c, v )] = 1;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        bool is_constrained( index_t cell, index_t facet ) const
+        {
+            if( constrained_facets_.empty() )
+            {
+                return false;
+            }
+            std::array< index_t, 3 > vertices;
+            index_t count{ 0 };
+            for( auto v : range( 4 ) )
+            {
+                if( v != facet )
+                {
+                    vertices[count++] = cell_vertex( cell, v );
+                }
+            }
+            return contains_sorted( constrained_facets_,
+                sorted_facet( vertices[0], vertices[1], vertices[2] ) );
+        }
+
+        std::vector< index_t > low_quality_cells() const
+        {
+            std::vector< char > is_low( nb_cells(), 0 );
+            parallel_for( nb_cells(), [this, &is_low]( index_t c ) {
+                is_low[c] = !is_dead( c ) && cell_quality( c ) < min_quality_;
+            } );
+            std::vector< index_t > cells;
+            for( auto c : range( nb_cells() ) )
+            {
+                if( is_low[c] )
+                {
+                    cells.push_back( c );
+                }
+            }
+            return cells;
+        }
+
+        /*!
+         * Gets the cells around a vertex by walking across the facets
+         * incident to the vertex
+         */
+        std::vector< index_t > vertex_star( index_t vertex ) const
+        {
+            std::vector< index_t > star{ vertex_cell_[vertex] };
+            for( index_t i = 0; i < star.size(); i++ )
+            {
+                auto c = star[i];
+                for( auto f : range( 4 ) )
+                {
+                    auto adjacent = adjacents_[4 * c + f];
+                    if( cell_vertex( c, f ) != vertex && adjacent != NO_ID
+                        && !contains( star, adjacent ) )
+                    {
+                        star.push_back( adjacent );
+                    }
+                }
+            }
+            return star;
+        }
+
+        std::vector< index_t > cell_cavity( index_t cell ) const
+        {
+            std::vector< index_t > cavity;
+            for( auto v : range( 4 ) )
+            {
+                auto star = vertex_star( cell_vertex( cell, v ) );
+                cavity.insert( cavity.end(), star.begin(), star.end() );
+            }
+            sort_unique( cavity );
+            return cavity;
+        }
+
+        /*!
+         * Gets the cells around the edge (v0, v1) of a cell
+         * @param[out] ring_vertices the vertices opposite to the edge, the
+         * last two vertices of the cell being the first two ones
+         * @return true if the ring is closed
+         */
+        bool edge_ring( index_t cell,
+            index_t v0,
+            index_t v1,
+            std::vector< index_t >& ring_cells,
+            std::vector< index_t >& ring_vertices ) const
+        {
+            ring_cells.assign( 1, cell );
+            ring_vertices.clear();
+            for( auto v : range( 4 ) )
+            {
+                if( v != v0 && v != v1 )
+                {
+                    ring_vertices.push_back( cell_vertex( cell, v ) );
+                }
+            }
+            auto a = cell_vertex( cell, v0 );
+            auto b = cell_vertex( cell, v1 );
+            auto crossed = ring_vertices[0];
+            auto kept = ring_vertices[1];
+            auto current = cell;
+            while( true )
+            {
+                auto next =
+                    adjacents_[4 * current + local_vertex( current, crossed )];
+                if( next == NO_ID )
+                {
+                    return false;
+                }
+                if( next == cell )
+                {
+                    return true;
+                }
+                ring_cells.push_back( next );
+                for( auto v : range( 4 ) )
+                {
+                    auto vertex = cell_vertex( next, v );
+                    if( vertex != a && vertex != b && vertex != kept )
+                    {
+                        crossed = kept;
+                        kept = vertex;
+                        break;
+                    }
+                }
+                ring_vertices.push_back( kept );
+                current = next;
+            }
+        }
+
+        static std::array< index_t, 4 > replace_vertex(
+            std::array< index_t, 4 > tet, index_t from, index_t to )
+        {
+            for( auto& vertex : tet )
+            {
+                if( vertex == from )
+                {
+                    vertex = to;
+                }
+            }
+            return tet;
+        }
+
+        double min_quality( const std::vector< index_t >& cells ) const
+        {
+            double result{ max_float64() };
+            for( auto c : cells )
+            {
+                result = std::min( result, cell_quality( c ) );
+            }
+            return result;
+        }
+
+        double min_quality(
+            const std::vector< std::array< index_t, 4 > >& tets ) const
+        {
+            double result{ max_float64() };
+            for( const auto& tet : tets )
+            {
+                result = std::min( result, quality( tet ) );
+            }
+            return result;
+        }
+
+        /*!
+         * Replaces the old cells by the new ones filling the same cavity
+         * if they raise its minimal quality and if no constrained facet is
+         * removed
+         */
+        bool replace_cells( const std::vector< index_t >& old_cells,
+            const std::vector< std::array< index_t, 4 > >& new_tets,
+            CavitySlots& slots )
+        {
+            if( min_quality( new_tets ) <= min_quality( old_cells ) )
+            {
+                return false;
+            }
+            struct BorderFacet
+            {
+                TetFacet facet;
+                index_t outside_cell;
+                index_t outside_facet;
+            };
+            std::vector< BorderFacet > border;
+            for( auto c : old_cells )
+            {
+                for( auto f : range( 4 ) )
+                {
+                    auto adjacent = adjacents_[4 * c + f];
+                    if( contains( old_cells, adjacent ) )
+                    {
+                        if( is_constrained( c, f ) )
+                        {
+                            return false;
+                        }
+                        continue;
+                    }
+                    auto tet = cell_tet( c );
+                    tet[f] = NO_ID;
+                    std::sort( tet.begin(), tet.end() );
+                    index_t outside_facet{ NO_ID };
+                    if( adjacent != NO_ID )
+                    {
+                        for( auto g : range( 4 ) )
+                        {
+                            if( adjacents_[4 * adjacent + g] == c )
+                            {
+                                outside_facet = g;
+                            }
+                        }
+                    }
+                    border.push_back( { { { tet[0], tet[1], tet[2] } },
+                        adjacent, outside_facet } );
+                }
+            }
+
+            auto nb_new = static_cast< index_t >( new_tets.size() );
+            auto nb_old = static_cast< index_t >( old_cells.size() );
+            if( nb_new > nb_old + slots.cells.size() - slots.nb_used_cells )
+            {
+                return false;
+            }
+            std::vector< index_t > new_cells( nb_new );
+            for( auto i : range( nb_new ) )
+            {
+                new_cells[i] = i < nb_old
+                                   ? old_cells[i]
+                                   : slots.cells[slots.nb_used_cells
+                                                 + i - nb_old];
+            }
+
+            // Adjacencies of the new cells, inside and across the border
+            std::vector< index_t > new_adjacents( 4 * nb_new, NO_ID );
+            std::vector< index_t > border_facets( 4 * nb_new, NO_ID );
+            for( auto i : range( nb_new ) )
+            {
+                for( auto f : range( 4 ) )
+                {
+                    auto tet = new_tets[i];
+                    tet[f] = NO_ID;
+                    std::sort( tet.begin(), tet.end() );
+                    TetFacet facet{ { tet[0], tet[1], tet[2] } };
+                    for( auto j : range( nb_new ) )
+                    {
+                        if( j != i && contains( new_tets[j], facet[0] )
+                            && contains( new_tets[j], facet[1] )
+                            && contains( new_tets[j], facet[2] ) )
+                        {
+                            new_adjacents[4 * i + f] = new_cells[j];
+                        }
+                    }
+                    if( new_adjacents[4 * i + f] != NO_ID )
+                    {
+                        continue;
+                    }
+                    for( auto b : range( border.size() ) )
+                    {
+                        if( border[b].facet == facet )
+                        {
+                            border_facets[4 * i + f] = b;
+                            new_adjacents[4 * i + f] = border[b].outside_cell;
+                        }
+                    }
+                    if( border_facets[4 * i + f] == NO_ID )
+                    {
+                        return false;
+                    }
+                }
+            }
+
+            // The outside cells share a facet with an old cell, this facet
+            // has a vertex of the improved cell: they are in its cavity,
+            // which no other cavity of the batch touches
+            for( auto i : range( nb_new ) )
+            {
+                auto c = new_cells[i];
+                for( auto f : range( 4 ) )
+                {
+                    tets_[4 * c + f] = new_tets[i][f];
+                    adjacents_[4 * c + f] = new_adjacents[4 * i + f];
+                    vertex_cell_[new_tets[i][f]] = c;
+                    auto b = border_facets[4 * i + f];
+                    if( b != NO_ID && border[b].outside_cell != NO_ID )
+                    {
+                        adjacents_[4 * border[b].outside_cell
+                                   + border[b].outside_facet] = c;
+                    }
+                }
+            }
+            for( auto i : range( nb_new, nb_old ) )
+            {
+                tets_[4 * old_cells[i]] = NO_ID;
+                slots.freed_cells.push_back( old_cells[i] );
+            }
+            if( nb_new > nb_old )
+            {
+                slots.nb_used_cells += nb_new - nb_old;
+            }
+            return true;
+        }
+
+        bool remove_edge( index_t cell, index_t v0, index_t v1,
+            CavitySlots& slots )
+        {
+            std::vector< index_t > ring_cells;
+            std::vector< index_t > ring_vertices;
+            if( !edge_ring( cell, v0, v1, ring_cells, ring_vertices )
+                || ring_cells.size() != 3 )
+            {
+                return false;
+            }
+            auto a = cell_vertex( cell, v0 );
+            auto b = cell_vertex( cell, v1 );
+            auto tet = cell_tet( cell );
+            return replace_cells( ring_cells,
+                { replace_vertex( tet, b, ring_vertices[2] ),
+                    replace_vertex( tet, a, ring_vertices[2] ) },
+                slots );
+        }
+
+        bool remove_facet( index_t cell, index_t facet, CavitySlots& slots )
+        {
+            auto adjacent = adjacents_[4 * cell + facet];
+            if( adjacent == NO_ID )
+            {
+                return false;
+            }
+            index_t apex{ NO_ID };
+            for( auto g : range( 4 ) )
+            {
+                if( adjacents_[4 * adjacent + g] == cell )
+                {
+                    apex = cell_vertex( adjacent, g );
+                }
+            }
+            auto tet = cell_tet( cell );
+            std::vector< std::array< index_t, 4 > > new_tets;
+            for( auto v : range( 4 ) )
+            {
+                if( v != facet )
+                {
+                    new_tets.push_back( replace_vertex( tet, tet[v], apex ) );
+                }
+            }
+            return replace_cells( { cell, adjacent }, new_tets, slots );
+        }
+
+        vec3 link_barycenter(
+            index_t vertex, const std::vector< index_t >& cells ) const
+        {
+            std::vector< index_t > link;
+            for( auto c : cells )
+            {
+                for( auto v : range( 4 ) )
+                {
+                    if( cell_vertex( c, v ) != vertex )
+                    {
+                        link.push_back( cell_vertex( c, v ) );
+                    }
+                }
+            }
+            sort_unique( link );
+            vec3 barycenter;
+            for( auto v : link )
+            {
+                barycenter += points_[v];
+            }
+            return barycenter / static_cast< double >( link.size() );
+        }
+
+        bool smooth_vertex( index_t vertex )
+        {
+            if( fixed_vertices_[vertex] )
+            {
+                return false;
+            }
+            auto star = vertex_star( vertex );
+            auto old_position = points_[vertex];
+            auto old_quality = min_quality( star );
+            auto target = link_barycenter( vertex, star );
+            for( auto weight : { 1., 0.5 } )
+            {
+                points_[vertex] =
+                    ( 1 - weight ) * old_position + weight * target;
+                if( min_quality( star ) > old_quality )
+                {
+                    return true;
+                }
+            }
+            points_[vertex] = old_position;
+            return false;
+        }
+
+        bool split_edge( index_t cell, CavitySlots& slots )
+        {
+            index_t v0{ NO_ID };
+            index_t v1{ NO_ID };
+            double max_length{ 0 };
+            for( auto i : range( 4 ) )
+            {
+                for( auto j : range( i + 1, 4 ) )
+                {
+                    auto length = ( points_[cell_vertex( cell, i )]
+                                    - points_[cell_vertex( cell, j )] )
+                                      .length2();
+                    if( length > max_length )
+                    {
+                        max_length = length;
+                        v0 = i;
+                        v1 = j;
+                    }
+                }
+            }
+            std::vector< index_t > ring_cells;
+            std::vector< index_t > ring_vertices;
+            if( !edge_ring( cell, v0, v1, ring_cells, ring_vertices ) )
+            {
+                return false;
+            }
+            auto a = cell_vertex( cell, v0 );
+            auto b = cell_vertex( cell, v1 );
+            auto middle = slots.vertex;
+            std::vector< std::array< index_t, 4 > > new_tets;
+            for( auto c : ring_cells )
+            {
+                new_tets.push_back(
+                    replace_vertex( cell_tet( c ), b, middle ) );
+                new_tets.push_back(
+                    replace_vertex( cell_tet( c ), a, middle ) );
+            }
+            points_[middle] = 0.5 * ( points_[a] + points_[b] );
+            auto middle_quality = min_quality( new_tets );
+            auto middle_position = points_[middle];
+            std::vector< index_t > link{ a, b };
+            link.insert(
+                link.end(), ring_vertices.begin(), ring_vertices.end() );
+            sort_unique( link );
+            vec3 barycenter;
+            for( auto v : link )
+            {
+                barycenter += points_[v];
+            }
+            points_[middle] = barycenter / static_cast< double >( link.size() );
+            if( min_quality( new_tets ) < middle_quality )
+            {
+                points_[middle] = middle_position;
+            }
+            if( !replace_cells( ring_cells, new_tets, slots ) )
+            {
+                return false;
+            }
+            fixed_vertices_[middle] = 0;
+            slots.vertex_used = true;
+            return true;
+        }
+
+        bool improve_cell( index_t cell, CavitySlots& slots )
+        {
+            if( is_dead( cell ) || cell_quality( cell ) >= min_quality_ )
+            {
+                return false;
+            }
+            for( auto v0 : range( 4 ) )
+            {
+                for( auto v1 : range( v0 + 1, 4 ) )
+                {
+                    if( remove_edge( cell, v0, v1, slots ) )
+                    {
+                        return true;
+                    }
+                }
+            }
+            for( auto f : range( 4 ) )
+            {
+                if( remove_facet( cell, f, slots ) )
+                {
+                    return true;
+                }
+            }
+            for( auto v : range( 4 ) )
+            {
+                if( smooth_vertex( cell_vertex( cell, v ) ) )
+                {
+                    return true;
+                }
+            }
+            return split_edge( cell, slots );
+        }
+
+        /*!
+         * Reserves, for each cavity, as many cells as its largest vertex
+         * star (the largest edge ring to split) and one vertex
+         */
+        std::vector< CavitySlots > reserve_slots(
+            const std::vector< index_t >& cells )
+        {
+            std::vector< CavitySlots > slots( cells.size() );
+            for( auto i : range( cells.size() ) )
+            {
+                index_t nb_slots{ 1 };
+                for( auto v : range( 4 ) )
+                {
+                    nb_slots = std::max( nb_slots,
+                        static_cast< index_t >(
+                            vertex_star( cell_vertex( cells[i], v ) )
+                                .size() ) );
+                }
+                for( auto s : range( nb_slots ) )
+                {
+                    ringmesh_unused( s );
+                    slots[i].cells.push_back( take_free_cell() );
+                }
+                if( free_vertices_.empty() )
+                {
+                    free_vertices_.push_back(
+                        static_cast< index_t >( points_.size() ) );
+                    points_.emplace_back();
+                    vertex_cell_.push_back( NO_ID );
+                    fixed_vertices_.push_back( 1 );
+                }
+                slots[i].vertex = free_vertices_.back();
+                free_vertices_.pop_back();
+            }
+            return slots;
+        }
+
+        index_t take_free_cell()
+        {
+            if( free_cells_.empty() )
+            {
+                auto cell = nb_cells();
+                tets_.resize( tets_.size() + 4, NO_ID );
+                adjacents_.resize( adjacents_.size() + 4, NO_ID );
+                return cell;
+            }
+            auto cell = free_cells_.back();
+            free_cells_.pop_back();
+            return cell;
+        }
+
+        void release_slots( const std::vector< CavitySlots >& slots )
+        {
+            for( const auto& slot : slots )
+            {
+                free_cells_.insert( free_cells_.end(),
+                    slot.cells.begin() + slot.nb_used_cells,
+                    slot.cells.end() );
+                free_cells_.insert( free_cells_.end(),
+                    slot.freed_cells.begin(), slot.freed_cells.end() );
+                if( !slot.vertex_used )
+                {
+                    free_vertices_.push_back( slot.vertex );
+                }
+            }
+        }
+
+        /*!
+         * Removes the dead cells and the unused reserved vertices
+         */
+        void compact()
+        {
+            std::vector< index_t > new_cell_ids( nb_cells(), NO_ID );
+            index_t nb_alive{ 0 };
+            for( auto c : range( nb_cells() ) )
+            {
+                if( !is_dead( c ) )
+                {
+                    new_cell_ids[c] = nb_alive++;
+                }
+            }
+            std::vector< index_t > new_vertex_ids( points_.size() );
+            std::sort( free_vertices_.begin(), free_vertices_.end() );
+            index_t nb_vertices{ 0 };
+            for( auto v : range( points_.size() ) )
+            {
+                if( contains_sorted( free_vertices_, v ) )
+                {
+                    new_vertex_ids[v] = NO_ID;
+                    continue;
+                }
+                new_vertex_ids[v] = nb_vertices;
+                points_[nb_vertices++] = points_[v];
+            }
+            points_.resize( nb_vertices );
+            for( auto c : range( nb_cells() ) )
+            {
+                auto new_c = new_cell_ids[c];
+                if( new_c == NO_ID )
+                {
+                    continue;
+                }
+                for( auto v : range( 4 ) )
+                {
+                    tets_[4 * new_c + v] = new_vertex_ids[tets_[4 * c + v]];
+                    auto adjacent = adjacents_[4 * c + v];
+                    adjacents_[4 * new_c + v] =
+                        adjacent == NO_ID ? NO_ID : new_cell_ids[adjacent];
+                }
+            }
+            tets_.resize( 4 * nb_alive );
+            adjacents_.resize( 4 * nb_alive );
+            free_cells_.clear();
+            free_vertices_.clear();
+        }
+
+    private:
+        MeshQualityMode mesh_qual_mode_;
+        double min_quality_;
+        std::vector< TetFacet > constrained_facets_;
+        double orientation_{ 1 };
+        std::vector< vec3 > points_;
+        std::vector< index_t > tets_;
+        std::vector< index_t > adjacents_;
+        std::vector< index_t > vertex_cell_;
+        std::vector< char > fixed_vertices_;
+        std::vector< index_t > free_cells_;
+        std::vector< index_t > free_vertices_;
+    };
 } // namespace
 
 namespace RINGMesh
@@ -361,23 +1639,120 @@ namespace RINGMesh
         MeshQualityMode mesh_qual_mode, const GeoModel3D& geomodel )
     {
         ringmesh_assert( geomodel.nb_regions() != 0 );
-        for( const auto& region : geomodel.regions() )
+        auto attributes = bind_quality_attributes(
+            mesh_qual_mode_to_prop_name( mesh_qual_mode ), geomodel );
+        for_each_tet_block( geomodel,
+            [&attributes, mesh_qual_mode](
+                const Region3D& region, const TetBlock& block ) {
+                auto& attribute = *attributes[region.index()];
+                for( auto t : range( block.nb_tets ) )
+                {
+                    attribute[block.first_cell + t] =
+                        block.qualities[mesh_qual_mode][t];
+                }
+            } );
+    }
+
+    void compute_prop_tet_mesh_qualities( const GeoModel3D& geomodel )
+    {
+        ringmesh_assert( geomodel.nb_regions() != 0 );
+        std::vector< std::unique_ptr< GEO::Attribute< double > > >
+            attributes[4];
+        for( auto mode : range( 4 ) )
         {
-            ringmesh_assert( region.is_meshed() );
-            ringmesh_assert( region.is_simplicial() );
-            GEO::AttributesManager& reg_attr_mgr =
-                region.cell_attribute_manager();
-            GEO::Attribute< double > attr(
-                reg_attr_mgr, mesh_qual_mode_to_prop_name( mesh_qual_mode ) );
-            for( auto cell_itr : range( region.nb_mesh_elements() ) )
-            {
-                attr[cell_itr] = get_tet_quality(
-                    region.mesh_element_vertex( { cell_itr, 0 } ),
-                    region.mesh_element_vertex( { cell_itr, 1 } ),
-                    region.mesh_element_vertex( { cell_itr, 2 } ),
-                    region.mesh_element_vertex( { cell_itr, 3 } ),
-                    mesh_qual_mode );
-            }
+            attributes[mode] = bind_quality_attributes(
+                mesh_qual_mode_to_prop_name(
+                    static_cast< MeshQualityMode >( mode ) ),
+                geomodel );
+        }
+        for_each_tet_block( geomodel,
+            [&attributes]( const Region3D& region, const TetBlock& block ) {
+                for( auto mode : range( 4 ) )
+                {
+                    auto& attribute = *attributes[mode][region.index()];
+                    for( auto t : range( block.nb_tets ) )
+                    {
+                        attribute[block.first_cell + t] =
+                            block.qualities[mode][t];
+                    }
+                }
+            } );
+    }
+
+    MeshQualityStatistics compute_tet_mesh_quality_statistics(
+        MeshQualityMode mesh_qual_mode,
+        double min_quality,
+        const GeoModel3D& geomodel,
+        index_t nb_bins )
+    {
+        auto region_offsets = region_cell_offsets( geomodel );
+        std::vector< double > values( region_offsets.back() );
+        for_each_tet_block( geomodel,
+            [&values, &region_offsets, mesh_qual_mode](
+                const Region3D& region, const TetBlock& block ) {
+                auto offset = region_offsets[region.index()] + block.first_cell;
+                for( auto t : range( block.nb_tets ) )
+                {
+                    values[offset + t] = block.qualities[mesh_qual_mode][t];
+                }
+            } );
+        return quality_statistics( values,
+            [min_quality]( double value ) { return value < min_quality; }, 0.,
+            1., nb_bins );
+    }
+
+    void compute_prop_cell_mesh_quality(
+        CellQualityMode cell_qual_mode, const GeoModel3D& geomodel )
+    {
+        ringmesh_assert( geomodel.nb_regions() != 0 );
+        auto attributes = bind_quality_attributes(
+            cell_qual_mode_to_prop_name( cell_qual_mode ), geomodel );
+        for_each_cell_quality( cell_qual_mode, geomodel,
+            [&attributes](
+                const Region3D& region, index_t cell, double quality ) {
+                ( *attributes[region.index()] )[cell] = quality;
+            } );
+    }
+
+    MeshQualityStatistics compute_cell_mesh_quality_statistics(
+        CellQualityMode cell_qual_mode,
+        double threshold,
+        const GeoModel3D& geomodel,
+        index_t nb_bins )
+    {
+        auto region_offsets = region_cell_offsets( geomodel );
+        std::vector< double > values( region_offsets.back() );
+        for_each_cell_quality( cell_qual_mode, geomodel,
+            [&values, &region_offsets](
+                const Region3D& region, index_t cell, double quality ) {
+                values[region_offsets[region.index()] + cell] = quality;
+            } );
+        switch( cell_qual_mode )
+        {
+        case SCALED_JACOBIAN:
+            return quality_statistics( values,
+                [threshold]( double value ) { return value < threshold; },
+                -1., 1., nb_bins );
+        case EQUIANGLE_SKEWNESS:
+            return quality_statistics( values,
+                [threshold]( double value ) { return value > threshold; },
+                0., 1., nb_bins );
+        default:
+        {
+            // The cells with a null edge have no ratio to average
+            auto degenerate = std::partition( values.begin(), values.end(),
+                []( double value ) { return value != max_float64(); } );
+            auto nb_degenerate = static_cast< index_t >(
+                std::distance( degenerate, values.end() ) );
+            values.erase( degenerate, values.end() );
+            auto statistics = quality_statistics( values,
+                [threshold]( double value ) { return value > threshold; },
+                1., 10., nb_bins );
+            statistics.nb_cells += nb_degenerate;
+            statistics.nb_low_quality_cells += nb_degenerate;
+            statistics.nb_degenerate_cells = nb_degenerate;
+            return statistics;
+        }
         }
     }
 
@@ -422,4 +1797,54 @@ namespace RINGMesh
         }
         return min_qual_value;
     }
+
+    index_t improve_tet_mesh_quality( MeshQualityMode mesh_qual_mode,
+        double min_quality,
+        GeoModel3D& geomodel,
+        index_t nb_passes )
+    {
+        ringmesh_assert( geomodel.nb_regions() != 0 );
+        // The constraints are read before any region is modified
+        std::vector< std::vector< TetFacet > > constrained_facets(
+            geomodel.nb_regions() );
+        for( const auto& region : geomodel.regions() )
+        {
+            constrained_facets[region.index()] =
+                region_constrained_facets( region );
+        }
+
+        GeoModelBuilder3D builder( geomodel );
+        index_t nb_low_quality_cells{ 0 };
+        for( const auto& region : geomodel.regions() )
+        {
+            ringmesh_assert( region.is_simplicial() );
+            if( region.nb_mesh_elements() == 0 )
+            {
+                continue;
+            }
+            RegionTetImprover improver( region,
+                std::move( constrained_facets[region.index()] ),
+                mesh_qual_mode, min_quality );
+            index_t nb_improved{ 0 };
+            for( auto pass : range( nb_passes ) )
+            {
+                ringmesh_unused( pass );
+                auto nb_pass_improved = improver.improve();
+                if( nb_pass_improved == 0 )
+                {
+                    break;
+                }
+                nb_improved += nb_pass_improved;
+            }
+            nb_low_quality_cells += improver.nb_low_quality_cells();
+            if( nb_improved != 0 )
+            {
+                auto mesh_builder =
+                    builder.geometry.create_region_builder( region.index() );
+                improver.update_region_mesh( *mesh_builder );
+            }
+        }
+        builder.geometry.clear_geomodel_mesh();
+        return nb_low_quality_cells;
+    }
 } // namespace RINGMesh
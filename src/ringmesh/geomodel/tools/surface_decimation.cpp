@@ -0,0 +1,711 @@
+/*
+ * Copyright (c) 2012-2018, Association Scientifique pour la Geologie et ses
+ * Applications (ASGA). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of ASGA nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL ASGA BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *     http://www.ring-team.org
+ *
+ *     RING Project
+ *     Ecole Nationale Superieure de Geologie - GeoRessources
+ *     2 Rue du Doyen Marcel Roubault - TSA 70605
+ *     54518 VANDOEUVRE-LES-NANCY
+ *     FRANCE
+ */
+
+#include <ringmesh/geomodel/tools/surface_decimation.h>
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <queue>
+
+#include <ringmesh/basic/nn_search.h>
+#include <ringmesh/basic/task_handler.h>
+
+#include <ringmesh/geomodel/builder/geomodel_builder.h>
+#include <ringmesh/geomodel/core/geomodel.h>
+#include <ringmesh/geomodel/core/geomodel_mesh_entity.h>
+
+#include <ringmesh/mesh/mesh_index.h>
+
+/*!
+ * @file Quadric error decimation of the Surfaces of a GeoModel
+ */
+
+namespace
+{
+    using namespace RINGMesh;
+
+    /// Below this ratio between the determinant and the cubed trace,
+    /// a quadric is considered as singular
+    static const double SINGULAR_QUADRIC_RATIO = 1e-6;
+
+    /*!
+     * @brief Sum of the squared distances to a set of planes
+     * @details Stores the upper part of the symmetric 4x4 matrix summing
+     * (a, b, c, d)^T (a, b, c, d) over the planes ax + by + cz + d = 0
+     * with unit normals.
+     */
+    class Quadric
+    {
+    public:
+        Quadric()
+        {
+            coefs_.fill( 0. );
+        }
+
+        Quadric( const vec3& normal, double offset )
+            : coefs_( { { normal.x * normal.x, normal.x * normal.y,
+                  normal.x * normal.z, normal.x * offset, normal.y * normal.y,
+                  normal.y * normal.z, normal.y * offset, normal.z * normal.z,
+                  normal.z * offset, offset * offset } } )
+        {
+        }
+
+        Quadric& operator+=( const Quadric& rhs )
+        {
+            for( auto i : range( coefs_.size() ) )
+            {
+                coefs_[i] += rhs.coefs_[i];
+            }
+            return *this;
+        }
+
+        Quadric operator+( const Quadric& rhs ) const
+        {
+            Quadric result{ *this };
+            result += rhs;
+            return result;
+        }
+
+        double error( const vec3& p ) const
+        {
+            const auto& q = coefs_;
+            return q[0] * p.x * p.x + q[4] * p.y * p.y + q[7] * p.z * p.z
+                   + 2. * ( q[1] * p.x * p.y + q[2] * p.x * p.z
+                              + q[5] * p.y * p.z + q[3] * p.x + q[6] * p.y
+                              + q[8] * p.z )
+                   + q[9];
+        }
+
+        /*!
+         * Computes the point of minimal error
+         * @param[out] point the point minimizing the error
+         * @return false if the planes do not define a unique point
+         */
+        bool minimum( vec3& point ) const
+        {
+            const auto& q = coefs_;
+            auto c00 = q[4] * q[7] - q[5] * q[5];
+            auto c01 = q[2] * q[5] - q[1] * q[7];
+            auto c02 = q[1] * q[5] - q[2] * q[4];
+            auto c11 = q[0] * q[7] - q[2] * q[2];
+            auto c12 = q[1] * q[2] - q[0] * q[5];
+            auto c22 = q[0] * q[4] - q[1] * q[1];
+            auto det = q[0] * c00 + q[1] * c01 + q[2] * c02;
+            auto trace = q[0] + q[4] + q[7];
+            if( std::fabs( det )
+                <= SINGULAR_QUADRIC_RATIO * trace * trace * trace )
+            {
+                return false;
+            }
+            point.x = -( c00 * q[3] + c01 * q[6] + c02 * q[8] ) / det;
+            point.y = -( c01 * q[3] + c11 * q[6] + c12 * q[8] ) / det;
+            point.z = -( c02 * q[3] + c12 * q[6] + c22 * q[8] ) / det;
+            return true;
+        }
+
+    private:
+        std::array< double, 10 > coefs_;
+    };
+
+    /*!
+     * @brief Triangles of a decimated Surface
+     */
+    struct DecimatedSurface
+    {
+        std::vector< vec3 > vertices;
+        std::vector< index_t > triangles;
+        index_t nb_removed_triangles{ 0 };
+    };
+
+    /*!
+     * @brief Quadric error edge collapses on a copy of a triangulated Surface
+     * @details The vertices on the Surface borders and on its boundary Lines
+     * are fixed. The other vertices are collapsed onto a neighbor, or merged
+     * with a free neighbor at the point of minimal quadric error.
+     * Coordinates are taken relatively to the first Surface vertex to limit
+     * the cancellations in the quadric errors.
+     */
+    class SurfaceDecimation
+    {
+    public:
+        SurfaceDecimation( const Surface3D& surface, double max_error )
+            : surface_( surface ),
+              max_sq_error_( max_error * max_error ),
+              min_area_( surface.geomodel().epsilon2() )
+        {
+            initialize_triangles();
+            initialize_fixed_vertices();
+            initialize_quadrics();
+        }
+
+        void decimate()
+        {
+            for( auto t : range( triangles_.size() ) )
+            {
+                for( auto v : range( 3 ) )
+                {
+                    auto v0 = triangles_[t][v];
+                    auto v1 = triangles_[t][( v + 1 ) % 3];
+                    if( v0 < v1 )
+                    {
+                        push_collapse( v0, v1 );
+                    }
+                }
+            }
+            while( !collapses_.empty() )
+            {
+                auto collapse = collapses_.top();
+                collapses_.pop();
+                if( is_up_to_date( collapse ) && is_valid( collapse ) )
+                {
+                    apply( collapse );
+                }
+            }
+        }
+
+        DecimatedSurface result() const
+        {
+            DecimatedSurface result;
+            result.nb_removed_triangles = nb_removed_triangles_;
+            std::vector< index_t > new_ids( points_.size(), NO_ID );
+            for( auto v : range( points_.size() ) )
+            {
+                if( removed_[v] )
+                {
+                    continue;
+                }
+                new_ids[v] = static_cast< index_t >( result.vertices.size() );
+                if( moved_[v] )
+                {
+                    result.vertices.push_back( points_[v] + origin_ );
+                }
+                else
+                {
+                    result.vertices.push_back( surface_.vertex( v ) );
+                }
+            }
+            result.triangles.reserve(
+                3 * ( triangles_.size() - nb_removed_triangles_ ) );
+            for( auto t : range( triangles_.size() ) )
+            {
+                if( deleted_[t] )
+                {
+                    continue;
+                }
+                for( auto v : triangles_[t] )
+                {
+                    result.triangles.push_back( new_ids[v] );
+                }
+            }
+            return result;
+        }
+
+    private:
+        /*!
+         * @brief Collapse of the vertex from onto the vertex to,
+         * moved at position
+         */
+        struct Collapse
+        {
+            bool operator>( const Collapse& rhs ) const
+            {
+                return cost > rhs.cost;
+            }
+
+            double cost;
+            index_t from;
+            index_t to;
+            vec3 position;
+            index_t from_version;
+            index_t to_version;
+        };
+
+        void initialize_triangles()
+        {
+            auto nb_vertices = surface_.nb_vertices();
+            if( nb_vertices > 0 )
+            {
+                origin_ = surface_.vertex( 0 );
+            }
+            points_.reserve( nb_vertices );
+            for( auto v : range( nb_vertices ) )
+            {
+                points_.push_back( surface_.vertex( v ) - origin_ );
+            }
+            removed_.resize( nb_vertices, false );
+            moved_.resize( nb_vertices, false );
+            versions_.resize( nb_vertices, 0 );
+            vertex_triangles_.resize( nb_vertices );
+
+            auto nb_triangles = surface_.nb_mesh_elements();
+            triangles_.resize( nb_triangles );
+            deleted_.resize( nb_triangles, false );
+            for( auto t : range( nb_triangles ) )
+            {
+                for( auto v : range( 3 ) )
+                {
+                    auto vertex =
+                        surface_.mesh_element_vertex_index( { t, v } );
+                    triangles_[t][v] = vertex;
+                    vertex_triangles_[vertex].push_back( t );
+                }
+            }
+        }
+
+        void initialize_fixed_vertices()
+        {
+            fixed_.resize( points_.size(), false );
+            for( auto t : range( triangles_.size() ) )
+            {
+                for( auto v : range( 3 ) )
+                {
+                    if( surface_.polygon_adjacent_index( { t, v } ) == NO_ID )
+                    {
+                        fixed_[triangles_[t][v]] = true;
+                        fixed_[triangles_[t][( v + 1 ) % 3]] = true;
+                    }
+                }
+            }
+            // Internal borders are not free borders of the Surface mesh
+            const auto& nn_search = surface_.vertex_nn_search();
+            auto epsilon = surface_.geomodel().epsilon();
+            for( auto b : range( surface_.nb_boundaries() ) )
+            {
+                const auto& line = surface_.boundary( b );
+                for( auto v : range( line.nb_vertices() ) )
+                {
+                    for( auto vertex :
+                        nn_search.get_neighbors( line.vertex( v ), epsilon ) )
+                    {
+                        fixed_[vertex] = true;
+                    }
+                }
+            }
+            for( auto v : range( points_.size() ) )
+            {
+                if( !fixed_[v] && !is_manifold_interior( v ) )
+                {
+                    fixed_[v] = true;
+                }
+            }
+        }
+
+        /*!
+         * Checks that the triangles around a vertex form a single,
+         * consistently oriented, closed fan
+         */
+        bool is_manifold_interior( index_t vertex ) const
+        {
+            const auto& triangles = vertex_triangles_[vertex];
+            if( triangles.empty() )
+            {
+                return false;
+            }
+            std::vector< std::pair< index_t, index_t > > fan;
+            fan.reserve( triangles.size() );
+            for( auto t : triangles )
+            {
+                auto v = local_vertex( t, vertex );
+                fan.emplace_back( triangles_[t][( v + 1 ) % 3],
+                    triangles_[t][( v + 2 ) % 3] );
+            }
+            std::sort( fan.begin(), fan.end() );
+            auto current = fan.front().first;
+            for( auto i : range( fan.size() ) )
+            {
+                auto it = std::lower_bound( fan.begin(), fan.end(),
+                    std::make_pair( current, index_t( 0 ) ) );
+                if( it == fan.end() || it->first != current
+                    || ( it + 1 != fan.end() && ( it + 1 )->first == current ) )
+                {
+                    return false;
+                }
+                current = it->second;
+                if( current == fan.front().first )
+                {
+                    return i + 1 == fan.size();
+                }
+            }
+            return false;
+        }
+
+        void initialize_quadrics()
+        {
+            quadrics_.resize( points_.size() );
+            for( const auto& triangle : triangles_ )
+            {
+                auto normal = triangle_normal( triangle );
+                auto norm = normal.length();
+                if( norm == 0. )
+                {
+                    continue;
+                }
+                normal /= norm;
+                Quadric plane{ normal, -dot( normal, points_[triangle[0]] ) };
+                for( auto v : triangle )
+                {
+                    quadrics_[v] += plane;
+                }
+            }
+        }
+
+        index_t local_vertex( index_t triangle, index_t vertex ) const
+        {
+            for( auto v : range( 3 ) )
+            {
+                if( triangles_[triangle][v] == vertex )
+                {
+                    return v;
+                }
+            }
+            return NO_ID;
+        }
+
+        vec3 triangle_normal( const std::array< index_t, 3 >& triangle ) const
+        {
+            const auto& p0 = points_[triangle[0]];
+            return cross(
+                points_[triangle[1]] - p0, points_[triangle[2]] - p0 );
+        }
+
+        /*!
+         * Removes the deleted triangles from the triangles around a vertex
+         */
+        const std::vector< index_t >& triangles_around( index_t vertex )
+        {
+            auto& triangles = vertex_triangles_[vertex];
+            triangles.erase( std::remove_if( triangles.begin(),
+                                 triangles.end(),
+                                 [this]( index_t t ) { return deleted_[t]; } ),
+                triangles.end() );
+            return triangles;
+        }
+
+        std::vector< index_t > neighbors( index_t vertex )
+        {
+            std::vector< index_t > result;
+            for( auto t : triangles_around( vertex ) )
+            {
+                for( auto v : triangles_[t] )
+                {
+                    if( v != vertex )
+                    {
+                        result.push_back( v );
+                    }
+                }
+            }
+            std::sort( result.begin(), result.end() );
+            result.erase(
+                std::unique( result.begin(), result.end() ), result.end() );
+            return result;
+        }
+
+        void push_collapse( index_t v0, index_t v1 )
+        {
+            if( fixed_[v0] && fixed_[v1] )
+            {
+                return;
+            }
+            Collapse collapse;
+            if( fixed_[v0] || fixed_[v1] )
+            {
+                collapse.from = fixed_[v0] ? v1 : v0;
+                collapse.to = fixed_[v0] ? v0 : v1;
+                collapse.position = points_[collapse.to];
+                collapse.cost = ( quadrics_[v0] + quadrics_[v1] )
+                                    .error( collapse.position );
+            }
+            else
+            {
+                collapse.from = v0;
+                collapse.to = v1;
+                optimal_position( v0, v1, collapse );
+            }
+            if( collapse.cost > max_sq_error_ )
+            {
+                return;
+            }
+            collapse.from_version = versions_[collapse.from];
+            collapse.to_version = versions_[collapse.to];
+            collapses_.push( collapse );
+        }
+
+        /*!
+         * Sets the position of minimal error for merging two free vertices.
+         * The quadric minimum is only taken if it lies close to the edge,
+         * else the best of the edge extremities and middle is taken.
+         */
+        void optimal_position(
+            index_t v0, index_t v1, Collapse& collapse ) const
+        {
+            auto quadric = quadrics_[v0] + quadrics_[v1];
+            const auto& p0 = points_[v0];
+            const auto& p1 = points_[v1];
+            auto middle = 0.5 * ( p0 + p1 );
+            vec3 minimum;
+            if( quadric.minimum( minimum )
+                && ( minimum - middle ).length2() <= ( p1 - p0 ).length2() )
+            {
+                collapse.position = minimum;
+                collapse.cost = quadric.error( minimum );
+                return;
+            }
+            collapse.cost = GEO::Numeric::max_float64();
+            for( const auto& candidate : { p0, p1, middle } )
+            {
+                auto cost = quadric.error( candidate );
+                if( cost < collapse.cost )
+                {
+                    collapse.cost = cost;
+                    collapse.position = candidate;
+                }
+            }
+        }
+
+        bool is_up_to_date( const Collapse& collapse ) const
+        {
+            return !removed_[collapse.from] && !removed_[collapse.to]
+                   && versions_[collapse.from] == collapse.from_version
+                   && versions_[collapse.to] == collapse.to_version;
+        }
+
+        /*!
+         * Checks the link condition, so that the collapse keeps the mesh
+         * a manifold, then checks the triangles moved by the collapse
+         */
+        bool is_valid( const Collapse& collapse )
+        {
+            std::vector< index_t > opposites;
+            for( auto t : triangles_around( collapse.from ) )
+            {
+                auto v = local_vertex( t, collapse.to );
+                if( v != NO_ID )
+                {
+                    auto third = triangles_[t][0] + triangles_[t][1]
+                                 + triangles_[t][2] - collapse.from
+                                 - collapse.to;
+                    opposites.push_back( third );
+                }
+            }
+            if( opposites.size() != 2 )
+            {
+                return false;
+            }
+            std::sort( opposites.begin(), opposites.end() );
+            auto from_neighbors = neighbors( collapse.from );
+            auto to_neighbors = neighbors( collapse.to );
+            std::vector< index_t > common;
+            std::set_intersection( from_neighbors.begin(),
+                from_neighbors.end(), to_neighbors.begin(), to_neighbors.end(),
+                std::back_inserter( common ) );
+            if( common != opposites )
+            {
+                return false;
+            }
+            if( !keeps_triangles_valid(
+                    collapse.from, collapse.to, collapse.position ) )
+            {
+                return false;
+            }
+            return fixed_[collapse.to]
+                   || keeps_triangles_valid(
+                          collapse.to, collapse.from, collapse.position );
+        }
+
+        /*!
+         * Checks that the triangles around a moved vertex, and not removed
+         * by the collapse, are neither flipped nor degenerated
+         */
+        bool keeps_triangles_valid(
+            index_t moved, index_t other, const vec3& position )
+        {
+            for( auto t : triangles_around( moved ) )
+            {
+                if( local_vertex( t, other ) != NO_ID )
+                {
+                    continue;
+                }
+                auto triangle = triangles_[t];
+                auto v = local_vertex( t, moved );
+                auto old_normal = triangle_normal( triangle );
+                const auto& p1 = points_[triangle[( v + 1 ) % 3]];
+                const auto& p2 = points_[triangle[( v + 2 ) % 3]];
+                auto new_normal = cross( p1 - position, p2 - position );
+                if( 0.5 * new_normal.length() < min_area_
+                    || dot( old_normal, new_normal ) <= 0. )
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        void apply( const Collapse& collapse )
+        {
+            auto from = collapse.from;
+            auto to = collapse.to;
+            for( auto t : triangles_around( from ) )
+            {
+                auto v = local_vertex( t, to );
+                if( v != NO_ID )
+                {
+                    deleted_[t] = true;
+                    nb_removed_triangles_++;
+                }
+                else
+                {
+                    triangles_[t][local_vertex( t, from )] = to;
+                    vertex_triangles_[to].push_back( t );
+                }
+            }
+            vertex_triangles_[from].clear();
+            vertex_triangles_[from].shrink_to_fit();
+            removed_[from] = true;
+            quadrics_[to] += quadrics_[from];
+            if( points_[to] != collapse.position )
+            {
+                points_[to] = collapse.position;
+                moved_[to] = true;
+            }
+            versions_[to]++;
+            for( auto neighbor : neighbors( to ) )
+            {
+                push_collapse( to, neighbor );
+            }
+        }
+
+    private:
+        const Surface3D& surface_;
+        double max_sq_error_;
+        double min_area_;
+        vec3 origin_;
+        std::vector< vec3 > points_;
+        std::vector< bool > fixed_;
+        std::vector< bool > removed_;
+        std::vector< bool > moved_;
+        std::vector< index_t > versions_;
+        std::vector< Quadric > quadrics_;
+        std::vector< std::array< index_t, 3 > > triangles_;
+        std::vector< bool > deleted_;
+        std::vector< std::vector< index_t > > vertex_triangles_;
+        index_t nb_removed_triangles_{ 0 };
+        std::priority_queue< Collapse,
+            std::vector< Collapse >,
+            std::greater< Collapse > >
+            collapses_;
+    };
+
+    DecimatedSurface decimate_surface(
+        const Surface3D& surface, double max_error )
+    {
+        SurfaceDecimation decimation( surface, max_error );
+        decimation.decimate();
+        return decimation.result();
+    }
+} // namespace
+
+namespace RINGMesh
+{
+    index_t decimate_surfaces( GeoModel3D& geomodel, double max_error )
+    {
+        for( const auto& region : geomodel.regions() )
+        {
+            if( region.is_meshed() )
+            {
+                throw RINGMeshException( "Decimation", region.gmme(),
+                    " is meshed, its cells would not match the decimated "
+                    "Surfaces" );
+            }
+        }
+        // Lazy values shared by the decimation tasks
+        geomodel.epsilon();
+
+        std::vector< index_t > surfaces;
+        for( const auto& surface : geomodel.surfaces() )
+        {
+            if( surface.is_simplicial() )
+            {
+                surfaces.push_back( surface.index() );
+            }
+            else
+            {
+                Logger::warn( "Decimation", surface.gmme(),
+                    " is not triangulated, it is not decimated" );
+            }
+        }
+        std::stable_sort( surfaces.begin(), surfaces.end(),
+            [&geomodel]( index_t lhs, index_t rhs ) {
+                return geomodel.surface( lhs ).nb_mesh_elements()
+                       > geomodel.surface( rhs ).nb_mesh_elements();
+            } );
+
+        // Largest Surfaces first
+        std::vector< DecimatedSurface > decimated( geomodel.nb_surfaces() );
+        auto nb_surfaces = static_cast< index_t >( surfaces.size() );
+        OrderedJobQueue queue( std::move( surfaces ) );
+        process_job_queue( queue, nb_surfaces, [&]( index_t s ) {
+            decimated[s] =
+                decimate_surface( geomodel.surface( s ), max_error );
+        } );
+
+        GeoModelBuilder3D builder( geomodel );
+        index_t nb_removed_triangles{ 0 };
+        for( auto s : range( geomodel.nb_surfaces() ) )
+        {
+            const auto& surface = decimated[s];
+            if( surface.nb_removed_triangles == 0 )
+            {
+                continue;
+            }
+            std::vector< index_t > triangle_ptr;
+            triangle_ptr.reserve( surface.triangles.size() / 3 + 1 );
+            for( auto t : range( surface.triangles.size() / 3 + 1 ) )
+            {
+                triangle_ptr.push_back( 3 * t );
+            }
+            builder.geometry.set_surface_geometry(
+                s, surface.vertices, surface.triangles, triangle_ptr );
+            nb_removed_triangles += surface.nb_removed_triangles;
+        }
+
+        // The GeoModelMesh should be updated, just erase everything
+        // and it will be re-computed during its next access.
+        geomodel.mesh.vertices.clear();
+        Logger::out( "Decimation", nb_removed_triangles,
+            " triangles removed from ", nb_surfaces, " Surfaces" );
+        return nb_removed_triangles;
+    }
+} // namespace RINGMesh
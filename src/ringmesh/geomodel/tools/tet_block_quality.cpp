@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2012-2018, Association Scientifique pour la Geologie et ses
+ * Applications (ASGA). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of ASGA nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL ASGA BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *     http://www.ring-team.org
+ *
+ *     RING Project
+ *     Ecole Nationale Superieure de Geologie - GeoRessources
+ *     2 Rue du Doyen Marcel Roubault - TSA 70605
+ *     54518 VANDOEUVRE-LES-NANCY
+ *     FRANCE
+ */
+
+
+#include "tet_block_quality.hpp"
+
+#include <algorithm>
+#include <cfenv>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+    using namespace RINGMesh;
+
+    /*!
+     * @return \p numerator / \p denominator if \p denominator is positive,
+     * 0 otherwise. The division is always done to keep the kernel loops free
+     * of branches.
+     */
+    inline double safe_divide( double numerator, double denominator )
+    {
+        const double smallest = std::numeric_limits< double >::min();
+        double ratio = numerator / std::max( denominator, smallest );
+        return denominator > 0 ? ratio : 0;
+    }
+} // namespace
+
+namespace RINGMesh
+{
+    /*!
+     * @details Same metrics as the per tetrahedron functions of
+     * mesh_quality.cpp, written with closed forms sharing the edge vectors,
+     * the volume and the facet areas, without any branch.
+     * The operations on degenerate tetrahedra may raise floating point
+     * exceptions, whose trapping is enabled by RINGMesh, so the exceptions
+     * are masked while the kernel runs.
+     */
+    void compute_tet_block_qualities( TetBlock& block )
+    {
+        std::fenv_t environment;
+        std::feholdexcept( &environment );
+        const double sqrt_6 = std::sqrt( 6. );
+        const auto& p = block.coords;
+        double square_volumes[CELL_BLOCK_SIZE];
+        for( index_t t = 0; t < block.nb_tets; t++ )
+        {
+            // Edges from vertex 0 and opposite to vertex 0
+            double ax = p[1][0][t] - p[0][0][t];
+            double ay = p[1][1][t] - p[0][1][t];
+            double az = p[1][2][t] - p[0][2][t];
+            double bx = p[2][0][t] - p[0][0][t];
+            double by = p[2][1][t] - p[0][1][t];
+            double bz = p[2][2][t] - p[0][2][t];
+            double cx = p[3][0][t] - p[0][0][t];
+            double cy = p[3][1][t] - p[0][1][t];
+            double cz = p[3][2][t] - p[0][2][t];
+            double dx = bx - ax;
+            double dy = by - ay;
+            double dz = bz - az;
+            double ex = cx - ax;
+            double ey = cy - ay;
+            double ez = cz - az;
+            double fx = cx - bx;
+            double fy = cy - by;
+            double fz = cz - bz;
+
+            double l01 = ax * ax + ay * ay + az * az;
+            double l02 = bx * bx + by * by + bz * bz;
+            double l03 = cx * cx + cy * cy + cz * cz;
+            double l12 = dx * dx + dy * dy + dz * dz;
+            double l13 = ex * ex + ey * ey + ez * ez;
+            double l23 = fx * fx + fy * fy + fz * fz;
+
+            double bcx = by * cz - bz * cy;
+            double bcy = bz * cx - bx * cz;
+            double bcz = bx * cy - by * cx;
+            double cax = cy * az - cz * ay;
+            double cay = cz * ax - cx * az;
+            double caz = cx * ay - cy * ax;
+            double abx = ay * bz - az * by;
+            double aby = az * bx - ax * bz;
+            double abz = ax * by - ay * bx;
+            double dex = dy * ez - dz * ey;
+            double dey = dz * ex - dx * ez;
+            double dez = dx * ey - dy * ex;
+
+            double det = std::fabs( ax * bcx + ay * bcy + az * bcz );
+            double volume = det / 6.;
+            double sum_areas =
+                0.5
+                * ( std::sqrt( abx * abx + aby * aby + abz * abz )
+                      + std::sqrt( dex * dex + dey * dey + dez * dez )
+                      + std::sqrt( bcx * bcx + bcy * bcy + bcz * bcz )
+                      + std::sqrt( cax * cax + cay * cay + caz * caz ) );
+            double in_radius = safe_divide( 3. * volume, sum_areas );
+
+            // Circumcenter relative to vertex 0 is this vector / ( 2 det )
+            double ox = l01 * bcx + l02 * cax + l03 * abx;
+            double oy = l01 * bcy + l02 * cay + l03 * aby;
+            double oz = l01 * bcz + l02 * caz + l03 * abz;
+            double circum_diameter_by_det =
+                std::sqrt( ox * ox + oy * oy + oz * oz );
+            block.qualities[INSPHERE_RADIUS_BY_CIRCUMSPHERE_RADIUS][t] =
+                safe_divide( 6. * in_radius * det, circum_diameter_by_det );
+
+            double max_length2 = std::max( std::max( std::max( l01, l02 ),
+                                               std::max( l03, l12 ) ),
+                std::max( l13, l23 ) );
+            block.qualities[INSPHERE_RADIUS_BY_MAX_EDGE_LENGTH][t] =
+                safe_divide( 2 * sqrt_6 * in_radius, std::sqrt( max_length2 ) );
+
+            double sum_length2 = l01 + l02 + l03 + l12 + l13 + l23;
+            block.qualities[VOLUME_BY_SUM_SQUARE_EDGE][t] =
+                safe_divide( 12., sum_length2 );
+            square_volumes[t] = 9. * volume * volume;
+
+            // ( u + v + w ) * ( u + v - w ) for each corner of the facets
+            // around each vertex, the smallest half solid angle sinus has
+            // the largest product
+            double e01 = std::sqrt( l01 );
+            double e02 = std::sqrt( l02 );
+            double e03 = std::sqrt( l03 );
+            double e12 = std::sqrt( l12 );
+            double e13 = std::sqrt( l13 );
+            double e23 = std::sqrt( l23 );
+            double s012 = ( e01 + e02 ) * ( e01 + e02 ) - l12;
+            double s023 = ( e02 + e03 ) * ( e02 + e03 ) - l23;
+            double s031 = ( e03 + e01 ) * ( e03 + e01 ) - l13;
+            double s102 = ( e01 + e12 ) * ( e01 + e12 ) - l02;
+            double s123 = ( e12 + e13 ) * ( e12 + e13 ) - l23;
+            double s130 = ( e13 + e01 ) * ( e13 + e01 ) - l03;
+            double s201 = ( e02 + e12 ) * ( e02 + e12 ) - l01;
+            double s213 = ( e12 + e23 ) * ( e12 + e23 ) - l13;
+            double s230 = ( e23 + e02 ) * ( e23 + e02 ) - l03;
+            double s301 = ( e03 + e13 ) * ( e03 + e13 ) - l01;
+            double s312 = ( e13 + e23 ) * ( e13 + e23 ) - l12;
+            double s320 = ( e23 + e03 ) * ( e23 + e03 ) - l02;
+            double max_denominator =
+                std::max( std::max( s012 * s023 * s031, s102 * s123 * s130 ),
+                    std::max( s201 * s213 * s230, s301 * s312 * s320 ) );
+            block.qualities[MIN_SOLID_ANGLE][t] =
+                1.5 * sqrt_6
+                * safe_divide( 12. * volume, std::sqrt( max_denominator ) );
+        }
+        // No vectorized cube root is available, it gets its own loop
+        for( index_t t = 0; t < block.nb_tets; t++ )
+        {
+            block.qualities[VOLUME_BY_SUM_SQUARE_EDGE][t] *=
+                std::cbrt( square_volumes[t] );
+        }
+        std::fesetenv( &environment );
+    }
+} // namespace RINGMesh
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2012-2018, Association Scientifique pour la Geologie et ses
+ * Applications (ASGA). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of ASGA nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL ASGA BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *     http://www.ring-team.org
+ *
+ *     RING Project
+ *     Ecole Nationale Superieure de Geologie - GeoRessources
+ *     2 Rue du Doyen Marcel Roubault - TSA 70605
+ *     54518 VANDOEUVRE-LES-NANCY
+ *     FRANCE
+ */
+
+
+#pragma once
+
+#include <ringmesh/geomodel/tools/common.h>
+
+#include <ringmesh/geomodel/tools/mesh_quality.h>
+
+/*!
+ * @file Tetrahedron qualities computed by blocks of cells
+ * @details The kernel is built in its own file, with neither errno setting
+ * nor trapping floating point operations, so that the compiler vectorizes
+ * its loop without changing the rest of the mesh quality tools.
+ */
+
+namespace RINGMesh
+{
+    static const index_t CELL_BLOCK_SIZE = 64;
+
+    /*!
+     * @brief Coordinates and qualities of a block of consecutive Region
+     * cells stored axis by axis, so that the quality kernels run as
+     * vectorizable loops
+     */
+    struct TetBlock
+    {
+        index_t first_cell{ NO_ID };
+        index_t nb_tets{ 0 };
+        /// Coordinates indexed by tetrahedron vertex, axis and block cell
+        double coords[4][3][CELL_BLOCK_SIZE];
+        /// Qualities indexed by MeshQualityMode and block cell
+        double qualities[4][CELL_BLOCK_SIZE];
+    };
+
+    /*!
+     * @brief Computes the four tetrahedron qualities of a block in one pass
+     * @details Degenerate tetrahedra get a null quality.
+     */
+    void compute_tet_block_qualities( TetBlock& block );
+} // namespace RINGMesh
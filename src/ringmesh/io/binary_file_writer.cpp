@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2012-2018, Association Scientifique pour la Geologie et ses
+ * Applications (ASGA). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of ASGA nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL ASGA BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *     http://www.ring-team.org
+ *
+ *     RING Project
+ *     Ecole Nationale Superieure de Geologie - GeoRessources
+ *     2 Rue du Doyen Marcel Roubault - TSA 70605
+ *     54518 VANDOEUVRE-LES-NANCY
+ *     FRANCE
+ */
+
+#include <ringmesh/io/binary_file_writer.h>
+
+#ifdef RINGMESH_WINDOWS
+#include <fstream>
+#include <mutex>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <ringmesh/basic/pimpl_impl.h>
+
+/*!
+ * @file Binary file written at explicit offsets
+ */
+
+namespace RINGMesh
+{
+#ifdef RINGMESH_WINDOWS
+    class BinaryFileWriter::Impl
+    {
+    public:
+        Impl( const std::string& filename, std::size_t size )
+            : file_( filename.c_str(),
+                  std::ios::out | std::ios::binary | std::ios::trunc )
+        {
+            if( !file_ )
+            {
+                throw RINGMeshException(
+                    "I/O", "Failed to open file ", filename );
+            }
+            if( size > 0 )
+            {
+                file_.seekp( static_cast< std::streamoff >( size - 1 ) );
+                file_.put( '\0' );
+            }
+        }
+
+        bool write_at(
+            std::size_t offset, const void* data, std::size_t size ) const
+        {
+            std::lock_guard< std::mutex > lock( mutex_ );
+            file_.seekp( static_cast< std::streamoff >( offset ) );
+            file_.write( static_cast< const char* >( data ),
+                static_cast< std::streamsize >( size ) );
+            return static_cast< bool >( file_ );
+        }
+
+    private:
+        mutable std::ofstream file_;
+        mutable std::mutex mutex_;
+    };
+#else
+    class BinaryFileWriter::Impl
+    {
+    public:
+        Impl( const std::string& filename, std::size_t size )
+            : file_( open( filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC,
+                  S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH ) )
+        {
+            if( file_ < 0 )
+            {
+                throw RINGMeshException(
+                    "I/O", "Failed to open file ", filename );
+            }
+            if( ftruncate( file_, static_cast< off_t >( size ) ) != 0 )
+            {
+                close( file_ );
+                throw RINGMeshException(
+                    "I/O", "Failed to resize file ", filename );
+            }
+        }
+
+        ~Impl()
+        {
+            close( file_ );
+        }
+
+        bool write_at(
+            std::size_t offset, const void* data, std::size_t size ) const
+        {
+            const auto* bytes = static_cast< const char* >( data );
+            while( size > 0 )
+            {
+                auto written = pwrite(
+                    file_, bytes, size, static_cast< off_t >( offset ) );
+                if( written < 0 && errno == EINTR )
+                {
+                    continue;
+                }
+                if( written <= 0 )
+                {
+                    return false;
+                }
+                auto nb_bytes = static_cast< std::size_t >( written );
+                bytes += nb_bytes;
+                offset += nb_bytes;
+                size -= nb_bytes;
+            }
+            return true;
+        }
+
+    private:
+        int file_{ -1 };
+    };
+#endif
+
+    BinaryFileWriter::BinaryFileWriter(
+        const std::string& filename, std::size_t size )
+        : impl_{ filename, size }
+    {
+    }
+
+    BinaryFileWriter::~BinaryFileWriter() {}
+
+    bool BinaryFileWriter::write_at(
+        std::size_t offset, const void* data, std::size_t size ) const
+    {
+        return impl_->write_at( offset, data, size );
+    }
+
+} // namespace RINGMesh
@@ -0,0 +1,409 @@
+/*
+ * Copyright (c) 2012-2018, Association Scientifique pour la Geologie et ses
+ * Applications (ASGA). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of ASGA nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL ASGA BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *     http://www.ring-team.org
+ *
+ *     RING Project
+ *     Ecole Nationale Superieure de Geologie - GeoRessources
+ *     2 Rue du Doyen Marcel Roubault - TSA 70605
+ *     54518 VANDOEUVRE-LES-NANCY
+ *     FRANCE
+ */
+
+#include <ringmesh/io/buffered_text_writer.h>
+
+#include <algorithm>
+#include <cfenv>
+#include <clocale>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+/*!
+ * @file Buffered text output with locale independent number formatting
+ */
+
+namespace
+{
+    using namespace RINGMesh;
+
+    /// Enough for 17 significant digits, sign, point and exponent in
+    /// general and scientific formats
+    const std::size_t MAX_DOUBLE_DIGITS = 32;
+
+    /// Enough for any 64 bits integer and its sign
+    const std::size_t MAX_INTEGER_DIGITS = 24;
+
+    /// Significant digits needed to round-trip any double
+    const int MAX_DOUBLE_PRECISION = 17;
+
+    /// Significant digits that always round-trip from text to double
+    const int MIN_DOUBLE_PRECISION = 15;
+
+    /// Digits of the integer part of any double in fixed notation
+    const std::size_t MAX_FIXED_INTEGER_DIGITS = 309;
+
+    /*!
+     * Numbers near the limits of the double range may be printed with a
+     * text reading back out of this range, which raises floating point
+     * exceptions that can be trapped
+     */
+    bool may_read_out_of_range( double value )
+    {
+        auto magnitude = std::fabs( value );
+        return magnitude > 1e307 || ( magnitude != 0 && magnitude < 1e-307 );
+    }
+
+    char locale_decimal_point()
+    {
+        const auto* locale = std::localeconv();
+        if( locale == nullptr || locale->decimal_point == nullptr )
+        {
+            return '.';
+        }
+        return locale->decimal_point[0];
+    }
+
+    /*!
+     * Replaces the decimal separator \p decimal_point by '.'
+     */
+    void normalize_decimal_point(
+        char* digits, std::size_t size, char decimal_point )
+    {
+        if( decimal_point == '.' )
+        {
+            return;
+        }
+        for( auto i : range( size ) )
+        {
+            if( digits[i] == decimal_point )
+            {
+                digits[i] = '.';
+                return;
+            }
+        }
+    }
+
+    /*!
+     * Removes the trailing zeros of the mantissa of a number in
+     * scientific notation, and its point if no decimal remains.
+     * The terminating null character is kept.
+     * @return the new size of \p digits
+     */
+    std::size_t trim_mantissa_zeros( char* digits, std::size_t size )
+    {
+        auto* end = digits + size;
+        auto* exponent = std::find( digits, end, 'e' );
+        auto* point = std::find( digits, exponent, '.' );
+        if( point == exponent )
+        {
+            return size;
+        }
+        auto* mantissa_end = exponent;
+        while( *( mantissa_end - 1 ) == '0' )
+        {
+            mantissa_end--;
+        }
+        if( mantissa_end - 1 == point )
+        {
+            mantissa_end--;
+        }
+        auto* trimmed_end = std::copy( exponent, end + 1, mantissa_end );
+        return static_cast< std::size_t >( trimmed_end - 1 - digits );
+    }
+
+    std::size_t print_double( char* digits,
+        std::size_t capacity,
+        const char* format,
+        int precision,
+        double value )
+    {
+        auto size = std::snprintf( digits, capacity, format, precision, value );
+        ringmesh_assert( size >= 0 );
+        return std::min( static_cast< std::size_t >( size ), capacity - 1 );
+    }
+} // namespace
+
+namespace RINGMesh
+{
+    TextBuffer::TextBuffer( index_t precision, FloatFormat format )
+        : precision_( precision ),
+          format_( format ),
+          locale_decimal_point_( locale_decimal_point() )
+    {
+    }
+
+    TextBuffer& TextBuffer::operator<<( char value )
+    {
+        append( &value, 1 );
+        return *this;
+    }
+
+    TextBuffer& TextBuffer::operator<<( const char* value )
+    {
+        append( value, std::char_traits< char >::length( value ) );
+        return *this;
+    }
+
+    TextBuffer& TextBuffer::operator<<( const std::string& value )
+    {
+        append( value.data(), value.size() );
+        return *this;
+    }
+
+    TextBuffer& TextBuffer::operator<<( int value )
+    {
+        append_signed( value );
+        return *this;
+    }
+
+    TextBuffer& TextBuffer::operator<<( unsigned int value )
+    {
+        append_unsigned( value, false );
+        return *this;
+    }
+
+    TextBuffer& TextBuffer::operator<<( long value )
+    {
+        append_signed( value );
+        return *this;
+    }
+
+    TextBuffer& TextBuffer::operator<<( unsigned long value )
+    {
+        append_unsigned( value, false );
+        return *this;
+    }
+
+    TextBuffer& TextBuffer::operator<<( long long value )
+    {
+        append_signed( value );
+        return *this;
+    }
+
+    TextBuffer& TextBuffer::operator<<( unsigned long long value )
+    {
+        append_unsigned( value, false );
+        return *this;
+    }
+
+    TextBuffer& TextBuffer::operator<<( double value )
+    {
+        if( format_ == FloatFormat::FIXED )
+        {
+            append_fixed( value );
+            return *this;
+        }
+        char digits[MAX_DOUBLE_DIGITS];
+        auto size = format_double( value, format_, digits );
+        append( digits, size );
+        return *this;
+    }
+
+    std::size_t TextBuffer::format_double(
+        double value, FloatFormat format, char* digits ) const
+    {
+        const char* printf_format =
+            format == FloatFormat::SCIENTIFIC ? "%.*e" : "%.*g";
+        std::size_t size{ 0 };
+        if( precision_ != 0 )
+        {
+            size = print_double( digits, MAX_DOUBLE_DIGITS, printf_format,
+                static_cast< int >( precision_ ), value );
+            normalize_decimal_point( digits, size, locale_decimal_point_ );
+            return size;
+        }
+        // Shortest representation reading back to the same value
+        // (scientific precision counts the digits after the point)
+        auto offset = format == FloatFormat::SCIENTIFIC ? 1 : 0;
+        auto hold_exceptions = may_read_out_of_range( value );
+        std::fenv_t environment;
+        if( hold_exceptions )
+        {
+            std::feholdexcept( &environment );
+        }
+        for( auto precision = MIN_DOUBLE_PRECISION;
+             precision <= MAX_DOUBLE_PRECISION; precision++ )
+        {
+            size = print_double( digits, MAX_DOUBLE_DIGITS, printf_format,
+                precision - offset, value );
+            if( precision == MAX_DOUBLE_PRECISION
+                || std::strtod( digits, nullptr ) == value )
+            {
+                break;
+            }
+        }
+        if( hold_exceptions )
+        {
+            std::fesetenv( &environment );
+        }
+        normalize_decimal_point( digits, size, locale_decimal_point_ );
+        if( format == FloatFormat::SCIENTIFIC )
+        {
+            size = trim_mantissa_zeros( digits, size );
+        }
+        return size;
+    }
+
+    void TextBuffer::append_fixed( double value )
+    {
+        if( precision_ != 0 || !std::isfinite( value ) )
+        {
+            auto capacity =
+                MAX_FIXED_INTEGER_DIGITS + MAX_DOUBLE_DIGITS + precision_;
+            if( fixed_digits_.size() < capacity )
+            {
+                fixed_digits_.resize( capacity );
+            }
+            auto size = print_double( &fixed_digits_[0], capacity, "%.*f",
+                static_cast< int >( precision_ ), value );
+            normalize_decimal_point(
+                &fixed_digits_[0], size, locale_decimal_point_ );
+            append( fixed_digits_.data(), size );
+            return;
+        }
+        // The shortest scientific digits are moved around the point
+        char digits[MAX_DOUBLE_DIGITS];
+        auto size =
+            format_double( value, FloatFormat::SCIENTIFIC, digits );
+        auto* end = digits + size;
+        auto* exponent = std::find( digits, end, 'e' );
+        ringmesh_assert( exponent != end );
+        auto nb_integer_digits = std::atoi( exponent + 1 ) + 1;
+        fixed_digits_.clear();
+        auto* mantissa = digits;
+        if( *mantissa == '-' )
+        {
+            fixed_digits_.push_back( '-' );
+            mantissa++;
+        }
+        if( nb_integer_digits <= 0 )
+        {
+            fixed_digits_.append( "0." );
+            fixed_digits_.append(
+                static_cast< std::size_t >( -nb_integer_digits ), '0' );
+            // The point is already written
+            nb_integer_digits = -1;
+        }
+        for( auto* digit = mantissa; digit != exponent; digit++ )
+        {
+            if( *digit == '.' )
+            {
+                continue;
+            }
+            if( nb_integer_digits == 0 )
+            {
+                fixed_digits_.push_back( '.' );
+            }
+            fixed_digits_.push_back( *digit );
+            nb_integer_digits--;
+        }
+        if( nb_integer_digits > 0 )
+        {
+            fixed_digits_.append(
+                static_cast< std::size_t >( nb_integer_digits ), '0' );
+        }
+        append( fixed_digits_.data(), fixed_digits_.size() );
+    }
+
+    void TextBuffer::append_signed( long long value )
+    {
+        if( value < 0 )
+        {
+            // Negation in unsigned arithmetic handles the minimal value
+            append_unsigned(
+                0ULL - static_cast< unsigned long long >( value ), true );
+        }
+        else
+        {
+            append_unsigned(
+                static_cast< unsigned long long >( value ), false );
+        }
+    }
+
+    void TextBuffer::append_unsigned( unsigned long long value, bool negative )
+    {
+        char digits[MAX_INTEGER_DIGITS];
+        auto* end = digits + MAX_INTEGER_DIGITS;
+        auto* begin = end;
+        do
+        {
+            *--begin = static_cast< char >( '0' + value % 10 );
+            value /= 10;
+        } while( value != 0 );
+        if( negative )
+        {
+            *--begin = '-';
+        }
+        append( begin, static_cast< std::size_t >( end - begin ) );
+    }
+
+    void TextBuffer::append( const char* value, std::size_t size )
+    {
+        if( width_ > size )
+        {
+            buffer_.append( width_ - size, ' ' );
+        }
+        width_ = 0;
+        buffer_.append( value, size );
+    }
+
+    BufferedTextWriter::BufferedTextWriter(
+        const std::string& filename, index_t precision, FloatFormat format )
+        : file_( filename.c_str() ), buffer_( precision, format )
+    {
+        if( !file_ )
+        {
+            throw RINGMeshException(
+                "I/O", "Failed to open file for writing: ", filename );
+        }
+        buffer_.reserve( BUFFER_SIZE + BUFFER_SIZE / 8 );
+    }
+
+    BufferedTextWriter::~BufferedTextWriter()
+    {
+        flush();
+    }
+
+    void BufferedTextWriter::flush()
+    {
+        write_to_file( buffer_.str() );
+        buffer_.clear();
+        file_.flush();
+    }
+
+    void BufferedTextWriter::write_to_file( const std::string& text )
+    {
+        file_.write(
+            text.data(), static_cast< std::streamsize >( text.size() ) );
+    }
+
+    index_t BufferedTextWriter::nb_chunks_in_batch()
+    {
+        return 4 * std::max( 1u, std::thread::hardware_concurrency() );
+    }
+} // namespace RINGMesh
@@ -59,8 +59,7 @@ namespace
         void save(
             const GeoModel3D& geomodel, const std::string& filename ) final
         {
-            std::ofstream out( filename.c_str() );
-            out.precision( 16 );
+            BufferedTextWriter out( filename, 16 );
 
             out << "*HEADING" << EOL;
             out << "**Mesh exported from RINGMesh" << EOL;
@@ -73,28 +72,27 @@ namespace
             save_cells( geomodel, out );
 
             out << "*END PART" << EOL;
-            out << std::flush;
         }
 
     private:
         void save_vertices(
-            const GeoModel3D& geomodel, std::ofstream& out ) const
+            const GeoModel3D& geomodel, BufferedTextWriter& out ) const
         {
             const GeoModelMeshVertices3D& vertices = geomodel.mesh.vertices;
             out << "*NODE" << EOL;
-            for( auto v : range( vertices.nb() ) )
-            {
-                out << v + 1;
-                const vec3& vertex = vertices.vertex( v );
-                for( auto i : range( 3 ) )
-                {
-                    out << COMMA << SPACE << vertex[i];
-                }
-                out << EOL;
-            }
+            out.write_parallel(
+                vertices.nb(), [&vertices]( TextBuffer& buffer, index_t v ) {
+                    buffer << v + 1;
+                    const vec3& vertex = vertices.vertex( v );
+                    for( auto i : range( 3 ) )
+                    {
+                        buffer << COMMA << SPACE << vertex[i];
+                    }
+                    buffer << EOL;
+                } );
         }
         void save_nb_polygons(
-            const GeoModel3D& geomodel, std::ofstream& out ) const
+            const GeoModel3D& geomodel, BufferedTextWriter& out ) const
         {
             const GeologicalEntityType& type = Interface3D::type_name_static();
             index_t nb_interfaces = geomodel.nb_geological_entities( type );
@@ -105,7 +103,7 @@ namespace
         }
         void save_interface( const GeoModel3D& geomodel,
             index_t interface_id,
-            std::ofstream& out ) const
+            BufferedTextWriter& out ) const
         {
             const GeoModelMeshPolygons3D& polygons = geomodel.mesh.polygons;
             const GeoModelGeologicalEntity3D& entity =
@@ -138,7 +136,8 @@ namespace
             out << EOL;
         }
 
-        void save_tets( const GeoModel3D& geomodel, std::ofstream& out ) const
+        void save_tets(
+            const GeoModel3D& geomodel, BufferedTextWriter& out ) const
         {
             const GeoModelMeshCells3D& cells = geomodel.mesh.cells;
             if( cells.nb_tet() > 0 )
@@ -147,25 +146,26 @@ namespace
                     << EOL;
                 for( auto r : range( geomodel.nb_regions() ) )
                 {
-                    for( auto c : range( cells.nb_tet( r ) ) )
-                    {
-                        index_t tetra = cells.tet( r, c );
-                        out << tetra + 1;
-                        for( auto v : range( 4 ) )
-                        {
-                            index_t vertex_id =
-                                tet_descriptor_abaqus.vertices[v];
-                            out << COMMA << SPACE
-                                << cells.vertex(
-                                       ElementLocalVertex( tetra, vertex_id ) )
-                                       + 1;
-                        }
-                        out << EOL;
-                    }
+                    out.write_parallel( cells.nb_tet( r ),
+                        [&cells, r]( TextBuffer& buffer, index_t c ) {
+                            index_t tetra = cells.tet( r, c );
+                            buffer << tetra + 1;
+                            for( auto v : range( 4 ) )
+                            {
+                                index_t vertex_id =
+                                    tet_descriptor_abaqus.vertices[v];
+                                buffer << COMMA << SPACE
+                                       << cells.vertex( ElementLocalVertex(
+                                              tetra, vertex_id ) )
+                                              + 1;
+                            }
+                            buffer << EOL;
+                        } );
                 }
             }
         }
-        void save_hex( const GeoModel3D& geomodel, std::ofstream& out ) const
+        void save_hex(
+            const GeoModel3D& geomodel, BufferedTextWriter& out ) const
         {
             const GeoModelMeshCells3D& cells = geomodel.mesh.cells;
             if( cells.nb_hex() > 0 )
@@ -174,26 +174,26 @@ namespace
                     << EOL;
                 for( auto r : range( geomodel.nb_regions() ) )
                 {
-                    for( auto c : range( cells.nb_hex( r ) ) )
-                    {
-                        index_t hex = cells.hex( r, c );
-                        out << hex + 1;
-                        for( auto v : range( 8 ) )
-                        {
-                            index_t vertex_id =
-                                hex_descriptor_abaqus.vertices[v];
-                            out << COMMA << SPACE
-                                << cells.vertex(
-                                       ElementLocalVertex( hex, vertex_id ) )
-                                       + 1;
-                        }
-                        out << EOL;
-                    }
+                    out.write_parallel( cells.nb_hex( r ),
+                        [&cells, r]( TextBuffer& buffer, index_t c ) {
+                            index_t hex = cells.hex( r, c );
+                            buffer << hex + 1;
+                            for( auto v : range( 8 ) )
+                            {
+                                index_t vertex_id =
+                                    hex_descriptor_abaqus.vertices[v];
+                                buffer << COMMA << SPACE
+                                       << cells.vertex( ElementLocalVertex(
+                                              hex, vertex_id ) )
+                                              + 1;
+                            }
+                            buffer << EOL;
+                        } );
                 }
             }
         }
         void save_regions(
-            const GeoModel3D& geomodel, std::ofstream& out ) const
+            const GeoModel3D& geomodel, BufferedTextWriter& out ) const
         {
             const GeoModelMeshCells3D& cells = geomodel.mesh.cells;
             for( auto r : range( geomodel.nb_regions() ) )
@@ -221,14 +221,15 @@ namespace
                 out << "*NSET, nset=" << name << ", elset=" << name << EOL;
             }
         }
-        void save_cells( const GeoModel3D& geomodel, std::ofstream& out ) const
+        void save_cells(
+            const GeoModel3D& geomodel, BufferedTextWriter& out ) const
         {
             save_tets( geomodel, out );
             save_hex( geomodel, out );
             save_regions( geomodel, out );
         }
         void new_line_if_needed(
-            index_t& count, std::ofstream& out, std::string& sep ) const
+            index_t& count, BufferedTextWriter& out, std::string& sep ) const
         {
             count++;
             if( count == NB_ENTRY_PER_LINE )
@@ -238,7 +239,7 @@ namespace
                 out << EOL;
             }
         }
-        void reset_line( index_t& count, std::ofstream& out ) const
+        void reset_line( index_t& count, BufferedTextWriter& out ) const
         {
             if( count != 0 )
             {
@@ -83,7 +83,7 @@ namespace
             return nb_elements;
         }
 
-        void write_entities( std::ofstream& out )
+        void write_entities( BufferedTextWriter& out )
         {
             write_corners( out );
             write_entities( lines_, offset_lines_, out );
@@ -129,24 +129,28 @@ namespace
             sort_unique( lines_ );
             sort_unique( corners_ );
         }
-        void write_corners( std::ofstream& out )
+        void write_corners( BufferedTextWriter& out )
         {
             const auto& nn =
                 geomodel_.mesh_entity( region_gmme_ ).vertex_nn_search();
-            for( const auto& corner_gmme : corners_ )
-            {
-                std::vector< index_t > element_vertices( 1 );
-                element_vertices[0] =
-                    nn.get_closest_neighbor(
-                        geomodel_.mesh_entity( corner_gmme ).vertex( 0 ) )
-                    + offset_vertices_;
-                write_mesh_entity_element( adeli_point_type, element_vertices,
-                    offset_corners_++, out );
-            }
+            auto nb_corners = static_cast< index_t >( corners_.size() );
+            out.write_parallel(
+                nb_corners, [&nn, this]( TextBuffer& buffer, index_t c ) {
+                    std::vector< index_t > element_vertices( 1 );
+                    element_vertices[0] =
+                        nn.get_closest_neighbor(
+                            geomodel_.mesh_entity( corners_[c] ).vertex( 0 ) )
+                        + offset_vertices_;
+                    write_mesh_entity_element( adeli_point_type,
+                        element_vertices, offset_corners_ + c,
+                        offset_elements_ + c, buffer );
+                } );
+            offset_corners_ += nb_corners;
+            offset_elements_ += nb_corners;
         }
         void write_entities( const std::vector< gmme_id >& entities,
             index_t& offset,
-            std::ofstream& out )
+            BufferedTextWriter& out )
         {
             for( const auto& entity_gmme : entities )
             {
@@ -157,29 +161,34 @@ namespace
 
         void write_entity( const GeoModelMeshEntity3D& mesh_entity,
             index_t offset,
-            std::ofstream& out )
+            BufferedTextWriter& out )
         {
-            for( auto mesh_entity_element :
-                range( mesh_entity.nb_mesh_elements() ) )
-            {
-                std::vector< index_t > element_vertices =
-                    get_element_vertices( mesh_entity, mesh_entity_element );
-                write_mesh_entity_element(
-                    adeli_cell_types[mesh_entity.nb_mesh_element_vertices(
-                                         mesh_entity_element )
-                                     - 1],
-                    element_vertices, offset, out );
-            }
+            // Builds the search tree before the parallel queries
+            geomodel_.mesh_entity( region_gmme_ ).vertex_nn_search();
+            out.write_parallel( mesh_entity.nb_mesh_elements(),
+                [&mesh_entity, offset, this](
+                    TextBuffer& buffer, index_t mesh_entity_element ) {
+                    std::vector< index_t > element_vertices =
+                        get_element_vertices(
+                            mesh_entity, mesh_entity_element );
+                    write_mesh_entity_element(
+                        adeli_cell_types[mesh_entity.nb_mesh_element_vertices(
+                                             mesh_entity_element )
+                                         - 1],
+                        element_vertices, offset,
+                        offset_elements_ + mesh_entity_element, buffer );
+                } );
+            offset_elements_ += mesh_entity.nb_mesh_elements();
         }
 
         void write_mesh_entity_element( index_t cell_descriptor,
             const std::vector< index_t >& element_vertices,
             index_t offset,
-            std::ofstream& out )
+            index_t element_id,
+            TextBuffer& out ) const
         {
-            out << offset_elements_++ << " " << cell_descriptor << " "
-                << reg_phys << " " << offset << " " << element_vertices.size()
-                << " ";
+            out << element_id << " " << cell_descriptor << " " << reg_phys
+                << " " << offset << " " << element_vertices.size() << " ";
             for( auto element_vertex : element_vertices )
             {
                 out << element_vertex << " ";
@@ -296,8 +305,7 @@ namespace
         void save(
             const GeoModel3D& geomodel, const std::string& filename ) final
         {
-            std::ofstream out( filename.c_str() );
-            out.precision( 16 );
+            BufferedTextWriter out( filename, 16 );
             const RINGMesh::GeoModelMesh3D& geomodel_mesh = geomodel.mesh;
             if( geomodel_mesh.cells.nb() != geomodel_mesh.cells.nb_tet() )
             {
@@ -311,11 +319,11 @@ namespace
             }
             write_regions_vertices( geomodel, out );
             write_regions( geomodel, out );
-            out << std::flush;
         }
 
     private:
-        void write_regions( const GeoModel3D& geomodel, std::ofstream& out )
+        void write_regions(
+            const GeoModel3D& geomodel, BufferedTextWriter& out )
         {
             out << "$ELM" << EOL;
             out << count_regions_and_deps_elements( geomodel ) << EOL;
@@ -341,17 +349,19 @@ namespace
         }
 
         void write_regions_vertices(
-            const GeoModel3D& geomodel, std::ofstream& out )
+            const GeoModel3D& geomodel, BufferedTextWriter& out )
         {
             out << "$NOD" << EOL;
             out << count_regions_vertices( geomodel ) << EOL;
             index_t vertex_index{ id_offset_adeli };
             for( const auto& region : geomodel.regions() )
             {
-                for( auto v : range( region.nb_vertices() ) )
-                {
-                    out << vertex_index++ << " " << region.vertex( v ) << EOL;
-                }
+                out.write_parallel( region.nb_vertices(),
+                    [&region, vertex_index]( TextBuffer& buffer, index_t v ) {
+                        buffer << vertex_index + v << " " << region.vertex( v )
+                               << EOL;
+                    } );
+                vertex_index += region.nb_vertices();
             }
             out << "$ENDNOD" << EOL;
         }
@@ -73,8 +73,7 @@ namespace
         void save(
             const GeoModel3D& geomodel, const std::string& filename ) final
         {
-            std::ofstream out( filename.c_str() );
-            out.precision( 16 );
+            BufferedTextWriter out( filename, 16 );
             const RINGMesh::GeoModelMesh3D& geomodel_mesh = geomodel.mesh;
 
             write_title( out, geomodel );
@@ -84,29 +83,30 @@ namespace
             write_regions( geomodel, out );
             write_interfaces( geomodel, out );
             out << "FIN" << EOL;
-            out << std::flush;
         }
 
     private:
-        void write_title( std::ofstream& out, const GeoModel3D& geomodel ) const
+        void write_title(
+            BufferedTextWriter& out, const GeoModel3D& geomodel ) const
         {
             out << "TITRE" << EOL;
             out << geomodel.name() << EOL;
             out << "FINSF" << EOL;
         }
-        void write_vertices( std::ofstream& out,
+        void write_vertices( BufferedTextWriter& out,
             const RINGMesh::GeoModelMesh3D& geomodel_mesh ) const
         {
+            const auto& vertices = geomodel_mesh.vertices;
             out << "COOR_3D" << EOL;
-            for( auto v : range( geomodel_mesh.vertices.nb() ) )
-            {
-                out << "V" << v << " " << geomodel_mesh.vertices.vertex( v )
-                    << EOL;
-            }
+            out.write_parallel(
+                vertices.nb(), [&vertices]( TextBuffer& buffer, index_t v ) {
+                    buffer << "V" << v << " " << vertices.vertex( v ) << EOL;
+                } );
             out << "FINSF" << EOL;
         }
 
-        void write_cells( const GeoModel3D& geomodel, std::ofstream& out ) const
+        void write_cells(
+            const GeoModel3D& geomodel, BufferedTextWriter& out ) const
         {
             const GeoModelMesh3D& geomodel_mesh = geomodel.mesh;
             for( auto r : range( geomodel.nb_regions() ) )
@@ -124,7 +124,7 @@ namespace
         }
 
         void write_polygons(
-            const GeoModel3D& geomodel, std::ofstream& out ) const
+            const GeoModel3D& geomodel, BufferedTextWriter& out ) const
         {
             const GeoModelMesh3D& geomodel_mesh = geomodel.mesh;
             for( const auto& surface : geomodel.surfaces() )
@@ -146,57 +146,57 @@ namespace
         void write_cells_in_region( const CellType& cell_type,
             index_t region,
             const GeoModelMesh3D& geomodel_mesh,
-            std::ofstream& out ) const
+            BufferedTextWriter& out ) const
         {
             out << *cell_name_in_aster_mail_file[to_underlying_type(
                        cell_type )]
                 << EOL;
-            for( auto c :
-                range( geomodel_mesh.cells.nb_cells( region, cell_type ) ) )
-            {
-                index_t global_id =
-                    geomodel_mesh.cells.cell( region, c, cell_type );
-                out << "C" << global_id << " ";
-                for( auto v : range( geomodel_mesh.cells.nb_vertices( c ) ) )
-                {
-                    out << "V"
-                        << geomodel_mesh.cells.vertex(
-                               ElementLocalVertex( global_id, v ) )
-                        << " ";
-                }
-                out << EOL;
-            }
+            const auto& cells = geomodel_mesh.cells;
+            out.write_parallel( cells.nb_cells( region, cell_type ),
+                [&cells, region, &cell_type]( TextBuffer& buffer, index_t c ) {
+                    index_t global_id = cells.cell( region, c, cell_type );
+                    buffer << "C" << global_id << " ";
+                    for( auto v : range( cells.nb_vertices( c ) ) )
+                    {
+                        buffer << "V"
+                               << cells.vertex(
+                                      ElementLocalVertex( global_id, v ) )
+                               << " ";
+                    }
+                    buffer << EOL;
+                } );
             out << "FINSF" << EOL;
         }
 
         void write_polygons_in_interface( const PolygonType& polygon_type,
             index_t surface,
             const RINGMesh::GeoModelMesh3D& mesh,
-            std::ofstream& out ) const
+            BufferedTextWriter& out ) const
         {
             out << *polygon_name_in_aster_mail_file[to_underlying_type(
                        polygon_type )]
                 << EOL;
-            for( auto p :
-                range( mesh.polygons.nb_polygons( surface, polygon_type ) ) )
-            {
-                index_t global_id =
-                    mesh.polygons.polygon( surface, p, polygon_type );
-                out << "F" << global_id << " ";
-                for( auto v : range( mesh.polygons.nb_vertices( p ) ) )
-                {
-                    out << "V"
-                        << mesh.polygons.vertex(
-                               ElementLocalVertex( global_id, v ) )
-                        << " ";
-                }
-                out << EOL;
-            }
+            const auto& polygons = mesh.polygons;
+            out.write_parallel( polygons.nb_polygons( surface, polygon_type ),
+                [&polygons, surface, &polygon_type](
+                    TextBuffer& buffer, index_t p ) {
+                    index_t global_id =
+                        polygons.polygon( surface, p, polygon_type );
+                    buffer << "F" << global_id << " ";
+                    for( auto v : range( polygons.nb_vertices( p ) ) )
+                    {
+                        buffer << "V"
+                               << polygons.vertex(
+                                      ElementLocalVertex( global_id, v ) )
+                               << " ";
+                    }
+                    buffer << EOL;
+                } );
             out << "FINSF" << EOL;
         }
 
         void write_regions(
-            const GeoModel3D& geomodel, std::ofstream& out ) const
+            const GeoModel3D& geomodel, BufferedTextWriter& out ) const
         {
             for( const auto& region : geomodel.regions() )
             {
@@ -217,7 +217,7 @@ namespace
         }
 
         void write_interfaces(
-            const GeoModel3D& geomodel, std::ofstream& out ) const
+            const GeoModel3D& geomodel, BufferedTextWriter& out ) const
         {
             for( auto& cur_interface :
                 geomodel.geol_entities( Interface3D::type_name_static() ) )
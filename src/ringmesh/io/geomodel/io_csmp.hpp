@@ -97,20 +97,18 @@ namespace
 
             std::ostringstream oss_ascii;
             oss_ascii << directory << "/" << file << ".asc";
-            std::ofstream ascii( oss_ascii.str().c_str() );
-            ascii.precision( 16 );
+            BufferedTextWriter ascii( oss_ascii.str(), 16 );
 
             ascii << geomodel.name() << EOL;
             ascii << "Model generated from RINGMesh" << EOL;
 
             std::ostringstream oss_data;
             oss_data << directory << "/" << file << ".dat";
-            std::ofstream data( oss_data.str().c_str() );
-            data.precision( 16 );
+            BufferedTextWriter data( oss_data.str(), 16 );
 
             std::ostringstream oss_regions;
             oss_regions << directory << "/" << file << "-regions.txt";
-            std::ofstream regions( oss_regions.str().c_str() );
+            BufferedTextWriter regions( oss_regions.str() );
             regions << "'" << oss_regions.str() << EOL;
             regions << "no properties" << EOL;
 
@@ -120,17 +118,25 @@ namespace
             // Conversion from (X,Y,Z) to (X,Z,-Y)
             signed_index_t conversion_sign[3] = { 1, 1, -1 };
             index_t conversion_axis[3] = { 0, 2, 1 };
-            data << mesh.vertices.nb() << " # PX, PY, PZ" << EOL;
+            const auto& vertices = mesh.vertices;
+            data << vertices.nb() << " # PX, PY, PZ" << EOL;
             for( auto dim : range( 3 ) )
             {
-                for( auto v : range( mesh.vertices.nb() ) )
-                {
-                    data << " "
-                         << conversion_sign[dim]
-                                * mesh.vertices.vertex(
-                                      v )[conversion_axis[dim]];
-                    new_line( count, 5, data );
-                }
+                // Five coordinates per line, the line breaks only depend
+                // on the vertex index
+                data.write_parallel( vertices.nb(),
+                    [&vertices, &conversion_sign, &conversion_axis, dim](
+                        TextBuffer& buffer, index_t v ) {
+                        buffer << " "
+                               << conversion_sign[dim]
+                                      * vertices.vertex(
+                                            v )[conversion_axis[dim]];
+                        if( ( v + 1 ) % 5 == 0 )
+                        {
+                            buffer << EOL;
+                        }
+                    } );
+                count = vertices.nb() % 5;
                 reset_line( count, data );
             }
             reset_line( count, data );
@@ -222,7 +228,7 @@ namespace
             data << "# PBFLAGS" << EOL;
             for( auto p : range( mesh.vertices.nb() ) )
             {
-                data << " " << std::setw( 3 ) << point_boundary( p );
+                data << " " << TextWidth( 3 ) << point_boundary( p );
                 new_line( count, 20, data );
             }
             reset_line( count, data );
@@ -231,7 +237,7 @@ namespace
             for( auto p : range( mesh.vertices.nb() ) )
             {
                 ringmesh_unused( p );
-                data << " " << std::setw( 3 ) << 0;
+                data << " " << TextWidth( 3 ) << 0;
                 new_line( count, 20, data );
             }
             reset_line( count, data );
@@ -251,7 +257,7 @@ namespace
                     for( auto el : range( mesh.cells.nb_cells( r, T ) ) )
                     {
                         ringmesh_unused( el );
-                        data << " " << std::setw( 3 ) << entity_type[type];
+                        data << " " << TextWidth( 3 ) << entity_type[type];
                         new_line( count, 20, data );
                     }
                 }
@@ -261,13 +267,13 @@ namespace
                 for( auto el : range( nb_triangle_interface[i] ) )
                 {
                     ringmesh_unused( el );
-                    data << " " << std::setw( 3 ) << 8;
+                    data << " " << TextWidth( 3 ) << 8;
                     new_line( count, 20, data );
                 }
                 for( auto el : range( nb_quad_interface[i] ) )
                 {
                     ringmesh_unused( el );
-                    data << " " << std::setw( 3 ) << 14;
+                    data << " " << TextWidth( 3 ) << 14;
                     new_line( count, 20, data );
                 }
             }
@@ -279,7 +285,7 @@ namespace
                     for( auto e : range( well.nb_edges() ) )
                     {
                         ringmesh_unused( e );
-                        data << " " << std::setw( 3 ) << 2;
+                        data << " " << TextWidth( 3 ) << 2;
                         new_line( count, 20, data );
                     }
                 }
@@ -384,7 +390,7 @@ namespace
                             index_t csmp_p = descriptor.vertices[p];
                             index_t vertex_id = mesh.cells.vertex(
                                 ElementLocalVertex( cell, csmp_p ) );
-                            data << " " << std::setw( 7 ) << vertex_id;
+                            data << " " << TextWidth( 7 ) << vertex_id;
                             new_line( count, 10, data );
                         }
                     }
@@ -405,7 +411,7 @@ namespace
                         {
                             index_t vertex_id =
                                 polygons.vertex( ElementLocalVertex( tri, p ) );
-                            data << " " << std::setw( 7 ) << vertex_id;
+                            data << " " << TextWidth( 7 ) << vertex_id;
                             new_line( count, 10, data );
                         }
                     }
@@ -416,7 +422,7 @@ namespace
                         {
                             index_t vertex_id = polygons.vertex(
                                 ElementLocalVertex( quad, p ) );
-                            data << " " << std::setw( 7 ) << vertex_id;
+                            data << " " << TextWidth( 7 ) << vertex_id;
                             new_line( count, 10, data );
                         }
                     }
@@ -429,7 +435,7 @@ namespace
                     for( auto v : range( 2 ) )
                     {
                         index_t vertex_id = mesh.wells.vertex( w, e, v );
-                        data << " " << std::setw( 7 ) << vertex_id;
+                        data << " " << TextWidth( 7 ) << vertex_id;
                         new_line( count, 10, data );
                     }
                 }
@@ -460,11 +466,11 @@ namespace
                             index_t adj = mesh.cells.adjacent( cell, csmp_f );
                             if( adj == NO_ID )
                             {
-                                data << " " << std::setw( 7 ) << -28;
+                                data << " " << TextWidth( 7 ) << -28;
                             }
                             else
                             {
-                                data << " " << std::setw( 7 ) << adj;
+                                data << " " << TextWidth( 7 ) << adj;
                             }
                             new_line( count, 10, data );
                         }
@@ -488,11 +494,11 @@ namespace
                                 polygons.adjacent( PolygonLocalEdge( tri, e ) );
                             if( adj == NO_ID )
                             {
-                                data << " " << std::setw( 7 ) << -28;
+                                data << " " << TextWidth( 7 ) << -28;
                             }
                             else
                             {
-                                data << " " << std::setw( 7 ) << adj;
+                                data << " " << TextWidth( 7 ) << adj;
                             }
                             new_line( count, 10, data );
                         }
@@ -506,11 +512,11 @@ namespace
                                 PolygonLocalEdge( quad, e ) );
                             if( adj == NO_ID )
                             {
-                                data << " " << std::setw( 7 ) << -28;
+                                data << " " << TextWidth( 7 ) << -28;
                             }
                             else
                             {
-                                data << " " << std::setw( 7 ) << adj;
+                                data << " " << TextWidth( 7 ) << adj;
                             }
                             new_line( count, 10, data );
                         }
@@ -521,27 +527,27 @@ namespace
             index_t cur_edge = 0;
             for( auto w : range( mesh.wells.nb_wells() ) )
             {
-                data << " " << std::setw( 7 ) << -28;
+                data << " " << TextWidth( 7 ) << -28;
                 new_line( count, 10, data );
                 if( mesh.wells.nb_edges( w ) > 1 )
                 {
-                    data << " " << std::setw( 7 ) << edge_offset + cur_edge + 1;
+                    data << " " << TextWidth( 7 ) << edge_offset + cur_edge + 1;
                     cur_edge++;
                     new_line( count, 10, data );
                     for( index_t e = 1; e < mesh.wells.nb_edges( w ) - 1;
                          e++, cur_edge++ )
                     {
-                        data << " " << std::setw( 7 )
+                        data << " " << TextWidth( 7 )
                              << edge_offset + cur_edge - 1;
                         new_line( count, 10, data );
-                        data << " " << std::setw( 7 )
+                        data << " " << TextWidth( 7 )
                              << edge_offset + cur_edge + 1;
                         new_line( count, 10, data );
                     }
-                    data << " " << std::setw( 7 ) << edge_offset + cur_edge - 1;
+                    data << " " << TextWidth( 7 ) << edge_offset + cur_edge - 1;
                     new_line( count, 10, data );
                 }
-                data << " " << std::setw( 7 ) << -28;
+                data << " " << TextWidth( 7 ) << -28;
                 cur_edge++;
                 new_line( count, 10, data );
             }
@@ -551,18 +557,15 @@ namespace
             for( auto i : range( nb_total_entities ) )
             {
                 ringmesh_unused( i );
-                data << " " << std::setw( 3 ) << 0;
+                data << " " << TextWidth( 3 ) << 0;
                 new_line( count, 20, data );
             }
-
-            ascii << std::flush;
-            data << std::flush;
-            regions << std::flush;
         }
 
     private:
-        void new_line(
-            index_t& count, index_t number_of_counts, std::ofstream& out ) const
+        void new_line( index_t& count,
+            index_t number_of_counts,
+            BufferedTextWriter& out ) const
         {
             count++;
             if( count == number_of_counts )
@@ -571,7 +574,7 @@ namespace
                 out << EOL;
             }
         }
-        void reset_line( index_t& count, std::ofstream& out ) const
+        void reset_line( index_t& count, BufferedTextWriter& out ) const
         {
             if( count != 0 )
             {
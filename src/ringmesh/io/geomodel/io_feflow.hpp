@@ -64,8 +64,7 @@ namespace
         void save(
             const GeoModel3D& geomodel, const std::string& filename ) final
         {
-            std::ofstream out( filename.c_str() );
-            out.precision( 16 );
+            BufferedTextWriter out( filename, 16 );
 
             write_header( out );
             write_dimensions( geomodel, out );
@@ -74,11 +73,11 @@ namespace
             write_regions( geomodel, out );
             write_wells( geomodel, out );
 
-            out << "END" << std::endl;
+            out << "END" << EOL;
         }
 
     private:
-        void write_header( std::ofstream& out ) const
+        void write_header( BufferedTextWriter& out ) const
         {
             out << "PROBLEM:\n";
             out << "CLASS (v.7.006.14742)\n";
@@ -88,7 +87,7 @@ namespace
             out << "   0    0    0    3    0    0    8    8    0    0\n";
         }
         void write_dimensions(
-            const GeoModel3D& geomodel, std::ofstream& out ) const
+            const GeoModel3D& geomodel, BufferedTextWriter& out ) const
         {
             const GeoModelMesh3D& mesh = geomodel.mesh;
             out << "DIMENS\n";
@@ -97,7 +96,7 @@ namespace
             out << "SCALE\n\n";
         }
         void write_elements(
-            const GeoModel3D& geomodel, std::ofstream& out ) const
+            const GeoModel3D& geomodel, BufferedTextWriter& out ) const
         {
             const GeoModelMeshCells3D& cells = geomodel.mesh.cells;
             out << "VARNODE\n";
@@ -147,42 +146,43 @@ namespace
             out << SPACE << min_nb_vertices_per_element << SPACE
                 << max_nb_vertices_per_element << "\n";
 
-            for( auto c : range( cells.nb() ) )
-            {
-                const RINGMesh2Feflow& descriptor =
-                    *cell_type_to_feflow_cell_descriptor[to_underlying_type(
-                        cells.type( c ) )];
-                out << SPACE << descriptor.entity_type;
-                for( auto v : range( cells.nb_vertices( c ) ) )
-                {
-                    out << SPACE
-                        << cells.vertex(
-                               ElementLocalVertex( c, descriptor.vertices[v] ) )
-                               + STARTING_OFFSET;
-                }
-                out << "\n";
-            }
+            out.write_parallel(
+                cells.nb(), [&cells]( TextBuffer& buffer, index_t c ) {
+                    const RINGMesh2Feflow& descriptor =
+                        *cell_type_to_feflow_cell_descriptor
+                            [to_underlying_type( cells.type( c ) )];
+                    buffer << SPACE << descriptor.entity_type;
+                    for( auto v : range( cells.nb_vertices( c ) ) )
+                    {
+                        buffer << SPACE
+                               << cells.vertex( ElementLocalVertex(
+                                      c, descriptor.vertices[v] ) )
+                                      + STARTING_OFFSET;
+                    }
+                    buffer << "\n";
+                } );
         }
         void write_vertices(
-            const GeoModel3D& geomodel, std::ofstream& out ) const
+            const GeoModel3D& geomodel, BufferedTextWriter& out ) const
         {
             const GeoModelMeshVertices3D& vertices = geomodel.mesh.vertices;
-            out << "XYZCOOR\n" << std::scientific;
-            for( auto v : range( vertices.nb() ) )
-            {
-                const vec3& point = vertices.vertex( v );
-                std::string sep = "";
-                for( auto i : range( 3 ) )
-                {
-                    out << sep << SPACE << point[i];
-                    sep = ",";
-                }
-                out << "\n";
-            }
-            out << std::fixed;
+            out << "XYZCOOR\n";
+            out.set_float_format( FloatFormat::SCIENTIFIC );
+            out.write_parallel(
+                vertices.nb(), [&vertices]( TextBuffer& buffer, index_t v ) {
+                    const vec3& point = vertices.vertex( v );
+                    std::string sep = "";
+                    for( auto i : range( 3 ) )
+                    {
+                        buffer << sep << SPACE << point[i];
+                        sep = ",";
+                    }
+                    buffer << "\n";
+                } );
+            out.set_float_format( FloatFormat::FIXED );
         }
         void write_regions(
-            const GeoModel3D& geomodel, std::ofstream& out ) const
+            const GeoModel3D& geomodel, BufferedTextWriter& out ) const
         {
             out << "ELEMENTALSETS\n";
             index_t offset = 0;
@@ -194,7 +194,8 @@ namespace
                 out << "-" << offset << "\n";
             }
         }
-        void write_wells( const GeoModel3D& geomodel, std::ofstream& out ) const
+        void write_wells(
+            const GeoModel3D& geomodel, BufferedTextWriter& out ) const
         {
             const WellGroup3D* wells = geomodel.wells();
             if( !wells )
@@ -212,7 +213,7 @@ namespace
             out << " </fractures>\n";
         }
         void write_well_edges(
-            const GeoModel3D& geomodel, std::ofstream& out ) const
+            const GeoModel3D& geomodel, BufferedTextWriter& out ) const
         {
             const GeoModelMeshWells3D& wells = geomodel.mesh.wells;
             out << " <nop count=\"" << wells.nb_edges() << "\">\n";
@@ -230,7 +231,7 @@ namespace
             out << " </nop>\n";
         }
         void write_well_groups(
-            const GeoModel3D& geomodel, std::ofstream& out ) const
+            const GeoModel3D& geomodel, BufferedTextWriter& out ) const
         {
             const GeoModelMeshWells3D& well_edges = geomodel.mesh.wells;
             const WellGroup3D* wells = geomodel.wells();
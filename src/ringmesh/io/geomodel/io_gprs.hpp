@@ -52,14 +52,12 @@ namespace
             std::string path = GEO::FileSystem::dir_name( filename );
             std::string name = GEO::FileSystem::base_name( filename );
 
-            std::ofstream out_pipes( "pipes.in" );
-            std::ofstream out_vol( "vol.in" );
-            out_vol.precision( 16 );
+            BufferedTextWriter out_pipes( "pipes.in" );
+            BufferedTextWriter out_vol( "vol.in", 16 );
 
             std::ostringstream oss_xyz;
             oss_xyz << name << ".xyz";
-            std::ofstream out_xyz( oss_xyz.str().c_str() );
-            out_xyz.precision( 16 );
+            BufferedTextWriter out_xyz( oss_xyz.str(), 16 );
 
             const GeoModelMesh3D& mesh = geomodel.mesh;
             std::deque< Pipe > pipes;
@@ -166,20 +164,48 @@ namespace
             out_xyz << "Node geometry, not used by GPRS but useful to "
                        "reconstruct a pipe-network"
                     << EOL;
-            for( auto c : range( mesh.cells.nb() ) )
+            const auto& cells = mesh.cells;
+            out_xyz.write_parallel(
+                cells.nb(), [&cells]( TextBuffer& buffer, index_t c ) {
+                    buffer << cells.barycenter( c ) << EOL;
+                } );
+            out_vol.write_parallel(
+                cells.nb(), [&cells]( TextBuffer& buffer, index_t c ) {
+                    buffer << cells.volume( c ) << EOL;
+                } );
+            out_xyz.write_parallel(
+                polygons.nb(), [&polygons]( TextBuffer& buffer, index_t p ) {
+                    buffer << polygons.center( p ) << EOL;
+                } );
+            out_vol.write_parallel(
+                polygons.nb(), [&polygons]( TextBuffer& buffer, index_t p ) {
+                    buffer << polygons.area( p ) << EOL;
+                } );
+
+            if( geomodel.wells() )
             {
-                out_xyz << mesh.cells.barycenter( c ) << EOL;
-                out_vol << mesh.cells.volume( c ) << EOL;
+                save_wells( geomodel );
             }
-            for( auto p : range( polygons.nb() ) )
+        }
+        /*!
+         * Saves the cells perforated by each well: the well name and
+         * its number of perforated cells, then the cell indices
+         */
+        void save_wells( const GeoModel3D& geomodel ) const
+        {
+            BufferedTextWriter out_wells( "wells.in" );
+            const auto& wells = geomodel.mesh.wells;
+            out_wells << wells.nb_wells() << EOL;
+            for( auto w : range( wells.nb_wells() ) )
             {
-                out_xyz << polygons.center( p ) << EOL;
-                out_vol << polygons.area( p ) << EOL;
+                const auto& cells = wells.perforated_cells( w );
+                out_wells << geomodel.wells()->well( w ).name() << SPACE
+                          << cells.size() << EOL;
+                for( auto cell : cells )
+                {
+                    out_wells << cell << EOL;
+                }
             }
-
-            out_pipes << std::flush;
-            out_vol << std::flush;
-            out_xyz << std::flush;
         }
         index_t binomial_coef( index_t n ) const
         {
@@ -78,14 +78,12 @@ namespace
             const auto& geomodel_mesh = geomodel.mesh;
             test_if_mesh_is_valid( geomodel.mesh );
 
-            std::ofstream out( filename.c_str() );
-            out.precision( 16 );
+            BufferedTextWriter out( filename, 16 );
 
             write_header( out );
             write_elements( geomodel_mesh, out );
             write_boundaries( geomodel_mesh, out );
             write_vertices( geomodel_mesh, out );
-            out << std::flush;
         }
 
     private:
@@ -95,9 +93,9 @@ namespace
         /*!
          * @brief Write the header for the MFEM mesh file
          * @param[in] geomodel_mesh the GeoModelMesh to be saved
-         * @param[in] out the ofstream that wrote the MFEM mesh file
+         * @param[in] out the writer of the MFEM mesh file
          */
-        void write_header( std::ofstream& out ) const
+        void write_header( BufferedTextWriter& out ) const
         {
             out << "MFEM mesh v1.0" << EOL;
             out << EOL;
@@ -107,28 +105,29 @@ namespace
         }
 
         void write_elements( const GeoModelMesh< DIMENSION >& geomodel_mesh,
-            std::ofstream& out ) const;
+            BufferedTextWriter& out ) const;
 
         void write_boundaries( const GeoModelMesh< DIMENSION >& geomodel_mesh,
-            std::ofstream& out ) const;
+            BufferedTextWriter& out ) const;
 
         /*!
          * @brief Write the vertices for the MFEM mesh file
          * @details The structure of the MFEM file for vertices is
          * [x] [y] [z]
          * @param[in] geomodel_mesh the GeoModelMesh to be saved
-         * @param[in] out the ofstream that wrote the MFEM mesh file
+         * @param[in] out the writer of the MFEM mesh file
          */
         void write_vertices( const GeoModelMesh< DIMENSION >& geomodel_mesh,
-            std::ofstream& out ) const
+            BufferedTextWriter& out ) const
         {
             out << "vertices" << EOL;
             out << geomodel_mesh.vertices.nb() << EOL;
             out << DIMENSION << EOL;
-            for( auto v : range( geomodel_mesh.vertices.nb() ) )
-            {
-                out << geomodel_mesh.vertices.vertex( v ) << EOL;
-            }
+            const auto& vertices = geomodel_mesh.vertices;
+            out.write_parallel(
+                vertices.nb(), [&vertices]( TextBuffer& buffer, index_t v ) {
+                    buffer << vertices.vertex( v ) << EOL;
+                } );
         }
     };
 
@@ -168,51 +167,51 @@ namespace
      * cell_type is 4 for  tetrahedra and 5 for hexahedra.
      * group_id begin with 1
      * @param[in] geomodel_mesh the GeoModelMesh to be saved
-     * @param[in] out the ofstream that wrote the MFEM mesh file
+     * @param[in] out the writer of the MFEM mesh file
      */
     template <>
     void MFEMIOHandler3D::write_elements(
-        const GeoModelMesh3D& geomodel_mesh, std::ofstream& out ) const
+        const GeoModelMesh3D& geomodel_mesh, BufferedTextWriter& out ) const
     {
         index_t nb_cells{ geomodel_mesh.cells.nb() };
         out << "elements" << EOL;
         out << nb_cells << EOL;
-        for( auto c : range( nb_cells ) )
-        {
-            out << geomodel_mesh.cells.region( c ) + mfem_offset << " ";
-            out << cell_type_mfem[to_underlying_type(
-                       geomodel_mesh.cells.type( c ) )]
-                << " ";
-            for( auto v : range( geomodel_mesh.cells.nb_vertices( c ) ) )
-            {
-                out << geomodel_mesh.cells.vertex(
-                           ElementLocalVertex( c, cell2mfem[v] ) )
-                    << " ";
-            }
-            out << EOL;
-        }
+        const GeoModelMeshCells3D& cells = geomodel_mesh.cells;
+        out.write_parallel(
+            nb_cells, [&cells]( TextBuffer& buffer, index_t c ) {
+                buffer << cells.region( c ) + mfem_offset << " ";
+                buffer << cell_type_mfem[to_underlying_type( cells.type( c ) )]
+                       << " ";
+                for( auto v : range( cells.nb_vertices( c ) ) )
+                {
+                    buffer << cells.vertex(
+                                  ElementLocalVertex( c, cell2mfem[v] ) )
+                           << " ";
+                }
+                buffer << EOL;
+            } );
         out << EOL;
     }
 
     template <>
     void MFEMIOHandler2D::write_elements(
-        const GeoModelMesh2D& geomodel_mesh, std::ofstream& out ) const
+        const GeoModelMesh2D& geomodel_mesh, BufferedTextWriter& out ) const
     {
         index_t nb_triangles{ geomodel_mesh.polygons.nb_triangle() };
         out << "elements" << EOL;
         out << nb_triangles << EOL;
-        for( auto c : range( nb_triangles ) )
-        {
-            out << geomodel_mesh.polygons.surface( c ) + mfem_offset << " ";
-            out << TRIANGLE << " ";
-            for( auto v : range( geomodel_mesh.polygons.nb_vertices( c ) ) )
-            {
-                out << geomodel_mesh.polygons.vertex(
-                           ElementLocalVertex( c, v ) )
-                    << " ";
-            }
-            out << EOL;
-        }
+        const GeoModelMeshPolygons2D& polygons = geomodel_mesh.polygons;
+        out.write_parallel(
+            nb_triangles, [&polygons]( TextBuffer& buffer, index_t c ) {
+                buffer << polygons.surface( c ) + mfem_offset << " ";
+                buffer << TRIANGLE << " ";
+                for( auto v : range( polygons.nb_vertices( c ) ) )
+                {
+                    buffer << polygons.vertex( ElementLocalVertex( c, v ) )
+                           << " ";
+                }
+                buffer << EOL;
+            } );
         out << EOL;
     }
 
@@ -224,47 +223,50 @@ namespace
      * polygon_type is 2 for triangles and 3 for the quads
      * group_id is continuous with the groupd indexes of the cells
      * @param[in] geomodel_mesh the GeoModelMesh to be saved
-     * @param[in] out the ofstream that wrote the MFEM mesh file
+     * @param[in] out the writer of the MFEM mesh file
      */
     template <>
     void MFEMIOHandler3D::write_boundaries(
-        const GeoModelMesh3D& geomodel_mesh, std::ofstream& out ) const
+        const GeoModelMesh3D& geomodel_mesh, BufferedTextWriter& out ) const
     {
         const GeoModelMeshPolygons3D& polygons = geomodel_mesh.polygons;
         out << "boundary" << EOL;
         out << polygons.nb() << EOL;
-        for( auto p : range( polygons.nb() ) )
-        {
-            out << polygons.surface( p ) + mfem_offset << " ";
-            PolygonType polygon_type;
-            std::tie( polygon_type, std::ignore ) = polygons.type( p );
-            out << polygon_type_mfem[to_underlying_type( polygon_type )] << " ";
-            for( auto v : range( polygons.nb_vertices( p ) ) )
-            {
-                out << polygons.vertex( ElementLocalVertex( p, v ) ) << " ";
-            }
-            out << EOL;
-        }
+        out.write_parallel(
+            polygons.nb(), [&polygons]( TextBuffer& buffer, index_t p ) {
+                buffer << polygons.surface( p ) + mfem_offset << " ";
+                PolygonType polygon_type;
+                std::tie( polygon_type, std::ignore ) = polygons.type( p );
+                buffer << polygon_type_mfem[to_underlying_type( polygon_type )]
+                       << " ";
+                for( auto v : range( polygons.nb_vertices( p ) ) )
+                {
+                    buffer << polygons.vertex( ElementLocalVertex( p, v ) )
+                           << " ";
+                }
+                buffer << EOL;
+            } );
         out << EOL;
     }
 
     template <>
     void MFEMIOHandler2D::write_boundaries(
-        const GeoModelMesh2D& geomodel_mesh, std::ofstream& out ) const
+        const GeoModelMesh2D& geomodel_mesh, BufferedTextWriter& out ) const
     {
         const GeoModelMeshEdges2D& edges = geomodel_mesh.edges;
         out << "boundary" << EOL;
         out << edges.nb() << EOL;
-        for( auto p : range( edges.nb() ) )
-        {
-            out << edges.line( p ) + mfem_offset << " ";
-            out << SEGMENT << " ";
-            for( auto v : range( 2 ) )
-            {
-                out << edges.vertex( ElementLocalVertex( p, v ) ) << " ";
-            }
-            out << EOL;
-        }
+        out.write_parallel(
+            edges.nb(), [&edges]( TextBuffer& buffer, index_t p ) {
+                buffer << edges.line( p ) + mfem_offset << " ";
+                buffer << SEGMENT << " ";
+                for( auto v : range( 2 ) )
+                {
+                    buffer << edges.vertex( ElementLocalVertex( p, v ) )
+                           << " ";
+                }
+                buffer << EOL;
+            } );
         out << EOL;
     }
 }
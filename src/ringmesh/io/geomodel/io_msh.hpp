@@ -83,31 +83,1067 @@ namespace
     // in GMSH, a tag is a physical id (not used) or a geometry id
     index_t nb_of_tags = 2;
 
+    // MSH 4.1 binary files store tags as int and sizes as size_t
+    using msh_int = std::int32_t;
+    using msh_size = std::uint64_t;
+
+    // Number of bytes of an entity block header: 3 int and 1 size_t
+    const std::size_t msh_block_header_size{ 3 * sizeof( msh_int )
+                                             + sizeof( msh_size ) };
+
+    // Number of nodes or elements encoded at once by a writing task
+    const index_t msh_chunk_size{ 1 << 14 };
+
+    template < typename T >
+    void append_binary( std::string& bytes, T value )
+    {
+        bytes.append( reinterpret_cast< const char* >( &value ), sizeof( T ) );
+    }
+
+    /*!
+     * Nodes or elements of one type stored in the same mesh entity
+     */
+    struct MSHBlock
+    {
+        MSHBlock( index_t entity_dimension,
+            index_t entity_index,
+            index_t element_type,
+            index_t nb_element_vertices )
+            : dimension( entity_dimension ),
+              entity( entity_index ),
+              type( element_type ),
+              nb_vertices( nb_element_vertices )
+        {
+        }
+
+        index_t dimension;
+        index_t entity;
+        index_t type;
+        index_t nb_vertices;
+        std::vector< index_t > items;
+        std::size_t offset{ 0 };
+        msh_size first_tag{ 0 };
+    };
+
+    /*!
+     * @brief Export for the GMSH format 4.1 binary which is described here:
+     * http://gmsh.info/doc/texinfo/gmsh.html#MSH-file-format
+     * @details Corners, Lines, Surfaces and Regions are saved as the point,
+     * curve, surface and volume entities of the file, with their boundary
+     * relations. Each GeoModelMesh vertex is saved once, in the node block
+     * of the lowest dimension entity it belongs to.
+     * The size of every block is known before writing, so the blocks are
+     * encoded in parallel and written directly at their final position.
+     */
+    class MSHBinaryWriter
+    {
+    public:
+        explicit MSHBinaryWriter( const GeoModel3D& geomodel )
+            : geomodel_( geomodel ),
+              types_( geomodel.entity_type_manager()
+                          .mesh_entity_manager.mesh_entity_types() )
+        {
+            index_t nb_entities{ 0 };
+            for( auto dimension : range( 4 ) )
+            {
+                first_entity_[dimension] = nb_entities;
+                nb_entities += geomodel.nb_mesh_entities( types_[dimension] );
+            }
+            first_entity_[4] = nb_entities;
+        }
+
+        void write( const std::string& filename )
+        {
+            build_node_blocks();
+            build_element_blocks();
+
+            std::string header{ "$MeshFormat\n4.1 1 8\n" };
+            append_binary< msh_int >( header, 1 );
+            header += "\n$EndMeshFormat\n";
+            header += entities_section();
+            header += "$Nodes\n";
+            const auto nb_nodes = geomodel_.mesh.vertices.nb();
+            append_binary< msh_size >( header, node_blocks_.size() );
+            append_binary< msh_size >( header, nb_nodes );
+            append_binary< msh_size >( header, gmsh_offset );
+            append_binary< msh_size >( header, nb_nodes );
+
+            auto offset = header.size();
+            for( auto& block : node_blocks_ )
+            {
+                block.offset = offset;
+                offset += msh_block_header_size
+                          + block.items.size()
+                                * ( sizeof( msh_size ) + 3 * sizeof( double ) );
+            }
+
+            const auto middle_offset = offset;
+            std::string middle{ "\n$EndNodes\n$Elements\n" };
+            append_binary< msh_size >( middle, element_blocks_.size() );
+            append_binary< msh_size >( middle, nb_elements_ );
+            append_binary< msh_size >( middle, gmsh_offset );
+            append_binary< msh_size >( middle, nb_elements_ );
+            offset += middle.size();
+            msh_size element_tag{ gmsh_offset };
+            for( auto& block : element_blocks_ )
+            {
+                block.offset = offset;
+                block.first_tag = element_tag;
+                element_tag += block.items.size();
+                offset += msh_block_header_size
+                          + block.items.size() * ( block.nb_vertices + 1 )
+                                * sizeof( msh_size );
+            }
+            const auto footer_offset = offset;
+            const std::string footer{ "\n$EndElements\n" };
+
+            BinaryFileWriter file{ filename, footer_offset + footer.size() };
+            auto ok = file.write_at( 0, header )
+                      && file.write_at( middle_offset, middle )
+                      && file.write_at( footer_offset, footer );
+            ok = write_blocks( file, node_blocks_,
+                     [this]( const BinaryFileWriter& out,
+                         const MSHBlock& block, index_t begin, index_t end ) {
+                         return write_nodes( out, block, begin, end );
+                     } )
+                 && ok;
+            ok = write_blocks( file, element_blocks_,
+                     [this]( const BinaryFileWriter& out,
+                         const MSHBlock& block, index_t begin, index_t end ) {
+                         return write_elements( out, block, begin, end );
+                     } )
+                 && ok;
+            if( !ok )
+            {
+                throw RINGMeshException(
+                    "I/O", "Failed to write file ", filename );
+            }
+        }
+
+    private:
+        gmme_id entity_id( index_t dimension, index_t index ) const
+        {
+            return { types_[dimension], index };
+        }
+
+        index_t entity_dimension( const MeshEntityType& type ) const
+        {
+            return static_cast< index_t >(
+                std::find( types_.begin(), types_.end(), type )
+                - types_.begin() );
+        }
+
+        /*!
+         * Dimension of an entity given by its index among all the mesh
+         * entities sorted by dimension
+         */
+        index_t entity_dimension( index_t entity ) const
+        {
+            return static_cast< index_t >(
+                std::upper_bound(
+                    first_entity_.begin(), first_entity_.end(), entity )
+                - first_entity_.begin() - 1 );
+        }
+
+        /*!
+         * Sorts the GeoModelMesh vertices by the lowest dimension entity
+         * they belong to, keeping the vertex order inside each entity
+         */
+        void build_node_blocks()
+        {
+            const auto& vertices = geomodel_.mesh.vertices;
+            std::vector< index_t > owner( vertices.nb() );
+            parallel_for(
+                vertices.nb(), [&vertices, &owner, this]( index_t v ) {
+                    auto lowest = NO_ID;
+                    for( const auto& gme_vertex : vertices.gme_vertices( v ) )
+                    {
+                        const auto& entity = gme_vertex.gmme;
+                        lowest = std::min( lowest,
+                            first_entity_[entity_dimension( entity.type() )]
+                                + entity.index() );
+                    }
+                    owner[v] = lowest;
+                } );
+
+            std::vector< index_t > nb_nodes( first_entity_[4] + 1, 0 );
+            for( auto entity : owner )
+            {
+                if( entity == NO_ID )
+                {
+                    throw RINGMeshException( "I/O",
+                        "A GeoModelMesh vertex belongs to no mesh entity" );
+                }
+                nb_nodes[entity]++;
+            }
+            std::vector< index_t > block_of_entity( first_entity_[4], NO_ID );
+            for( auto dimension : range( 4 ) )
+            {
+                for( auto entity :
+                    range( first_entity_[dimension],
+                        first_entity_[dimension + 1] ) )
+                {
+                    if( nb_nodes[entity] == 0 )
+                    {
+                        continue;
+                    }
+                    block_of_entity[entity] =
+                        static_cast< index_t >( node_blocks_.size() );
+                    node_blocks_.emplace_back( dimension,
+                        entity - first_entity_[dimension], 0, 1 );
+                    node_blocks_.back().items.reserve( nb_nodes[entity] );
+                }
+            }
+            for( auto v : range( vertices.nb() ) )
+            {
+                node_blocks_[block_of_entity[owner[v]]].items.push_back( v );
+            }
+        }
+
+        /*!
+         * Splits the elements of each mesh entity by number of vertices
+         */
+        void build_element_blocks()
+        {
+            std::vector< std::vector< MSHBlock > > entity_blocks(
+                first_entity_[4] );
+            std::vector< char > valid( first_entity_[4], 1 );
+            parallel_for( first_entity_[4], [&entity_blocks, &valid, this](
+                                                index_t entity ) {
+                const auto dimension = entity_dimension( entity );
+                const auto& gmme = geomodel_.mesh_entity(
+                    entity_id( dimension, entity - first_entity_[dimension] ) );
+                std::vector< index_t > block_of_type( 12, NO_ID );
+                auto& blocks = entity_blocks[entity];
+                for( auto element : range( gmme.nb_mesh_elements() ) )
+                {
+                    const auto nb_vertices =
+                        gmme.nb_mesh_element_vertices( element );
+                    const auto type_index = nb_vertices + dimension;
+                    if( type_index >= 12
+                        || element_type[type_index] == NO_ID )
+                    {
+                        valid[entity] = 0;
+                        return;
+                    }
+                    if( block_of_type[type_index] == NO_ID )
+                    {
+                        block_of_type[type_index] =
+                            static_cast< index_t >( blocks.size() );
+                        blocks.emplace_back( dimension, gmme.index(),
+                            element_type[type_index], nb_vertices );
+                    }
+                    blocks[block_of_type[type_index]].items.push_back(
+                        element );
+                }
+            } );
+            if( std::find( valid.begin(), valid.end(), 0 ) != valid.end() )
+            {
+                throw RINGMeshException( "I/O",
+                    "The GeoModel has elements not supported by MSH format" );
+            }
+            for( auto& blocks : entity_blocks )
+            {
+                for( auto& block : blocks )
+                {
+                    nb_elements_ += block.items.size();
+                    element_blocks_.push_back( std::move( block ) );
+                }
+            }
+        }
+
+        std::string entities_section() const
+        {
+            std::vector< Box3D > boxes( first_entity_[4] );
+            parallel_for( first_entity_[4], [&boxes, this]( index_t entity ) {
+                const auto dimension = entity_dimension( entity );
+                const auto& gmme = geomodel_.mesh_entity(
+                    entity_id( dimension, entity - first_entity_[dimension] ) );
+                for( auto v : range( gmme.nb_vertices() ) )
+                {
+                    boxes[entity].add_point( gmme.vertex( v ) );
+                }
+            } );
+
+            std::string bytes{ "$Entities\n" };
+            for( auto dimension : range( 4 ) )
+            {
+                append_binary< msh_size >(
+                    bytes, geomodel_.nb_mesh_entities( types_[dimension] ) );
+            }
+            for( const auto& corner : geomodel_.corners() )
+            {
+                append_binary< msh_int >( bytes, tag( corner.index() ) );
+                for( auto coordinate : range( 3 ) )
+                {
+                    append_binary< double >(
+                        bytes, corner.vertex( 0 )[coordinate] );
+                }
+                append_binary< msh_size >( bytes, 0 );
+            }
+            for( auto dimension : range( 1, 4 ) )
+            {
+                for( auto index : range(
+                         geomodel_.nb_mesh_entities( types_[dimension] ) ) )
+                {
+                    const auto& gmme =
+                        geomodel_.mesh_entity( entity_id( dimension, index ) );
+                    const auto& box = boxes[first_entity_[dimension] + index];
+                    append_binary< msh_int >( bytes, tag( index ) );
+                    for( auto coordinate : range( 3 ) )
+                    {
+                        append_binary< double >( bytes, box.min()[coordinate] );
+                    }
+                    for( auto coordinate : range( 3 ) )
+                    {
+                        append_binary< double >( bytes, box.max()[coordinate] );
+                    }
+                    append_binary< msh_size >( bytes, 0 );
+                    append_binary< msh_size >( bytes, gmme.nb_boundaries() );
+                    for( auto boundary : range( gmme.nb_boundaries() ) )
+                    {
+                        auto boundary_tag =
+                            tag( gmme.boundary_gmme( boundary ).index() );
+                        if( dimension == 3
+                            && !geomodel_.region( index ).side( boundary ) )
+                        {
+                            boundary_tag = -boundary_tag;
+                        }
+                        append_binary< msh_int >( bytes, boundary_tag );
+                    }
+                }
+            }
+            bytes += "\n$EndEntities\n";
+            return bytes;
+        }
+
+        static msh_int tag( index_t index )
+        {
+            return static_cast< msh_int >( index + gmsh_offset );
+        }
+
+        template < typename WRITER >
+        static bool write_blocks( const BinaryFileWriter& file,
+            const std::vector< MSHBlock >& blocks,
+            const WRITER& writer )
+        {
+            struct Chunk
+            {
+                index_t block;
+                index_t begin;
+                index_t end;
+            };
+            std::vector< Chunk > chunks;
+            for( auto b : range( blocks.size() ) )
+            {
+                const auto nb_items =
+                    static_cast< index_t >( blocks[b].items.size() );
+                for( index_t begin = 0; begin < nb_items;
+                     begin += msh_chunk_size )
+                {
+                    chunks.push_back( { b, begin,
+                        std::min( nb_items, begin + msh_chunk_size ) } );
+                }
+            }
+            std::vector< char > written( chunks.size(), 0 );
+            parallel_for( static_cast< index_t >( chunks.size() ),
+                [&file, &blocks, &writer, &chunks, &written]( index_t c ) {
+                    const auto& chunk = chunks[c];
+                    const auto& block = blocks[chunk.block];
+                    auto ok = writer( file, block, chunk.begin, chunk.end );
+                    if( chunk.begin == 0 )
+                    {
+                        std::string header;
+                        append_binary< msh_int >( header,
+                            static_cast< msh_int >( block.dimension ) );
+                        append_binary< msh_int >( header, tag( block.entity ) );
+                        append_binary< msh_int >(
+                            header, static_cast< msh_int >( block.type ) );
+                        append_binary< msh_size >( header, block.items.size() );
+                        ok = file.write_at( block.offset, header ) && ok;
+                    }
+                    written[c] = ok ? 1 : 0;
+                } );
+            return std::find( written.begin(), written.end(), 0 )
+                   == written.end();
+        }
+
+        bool write_nodes( const BinaryFileWriter& file,
+            const MSHBlock& block,
+            index_t begin,
+            index_t end ) const
+        {
+            const auto& vertices = geomodel_.mesh.vertices;
+            const auto data = block.offset + msh_block_header_size;
+            std::string bytes;
+            bytes.reserve( ( end - begin ) * 3 * sizeof( double ) );
+            for( auto i : range( begin, end ) )
+            {
+                append_binary< msh_size >(
+                    bytes, block.items[i] + gmsh_offset );
+            }
+            auto ok = file.write_at( data + begin * sizeof( msh_size ), bytes );
+            bytes.clear();
+            for( auto i : range( begin, end ) )
+            {
+                const auto& point = vertices.vertex( block.items[i] );
+                for( auto coordinate : range( 3 ) )
+                {
+                    append_binary< double >( bytes, point[coordinate] );
+                }
+            }
+            return file.write_at( data + block.items.size() * sizeof( msh_size )
+                                      + begin * 3 * sizeof( double ),
+                       bytes )
+                   && ok;
+        }
+
+        bool write_elements( const BinaryFileWriter& file,
+            const MSHBlock& block,
+            index_t begin,
+            index_t end ) const
+        {
+            const auto& vertices = geomodel_.mesh.vertices;
+            const gmme_id entity = entity_id( block.dimension, block.entity );
+            const auto& gmme = geomodel_.mesh_entity( entity );
+            const auto* vertex_order =
+                vertices_in_elements[block.nb_vertices + block.dimension];
+            const auto element_size =
+                ( block.nb_vertices + 1 ) * sizeof( msh_size );
+            std::string bytes;
+            bytes.reserve( ( end - begin ) * element_size );
+            for( auto i : range( begin, end ) )
+            {
+                append_binary< msh_size >( bytes, block.first_tag + i );
+                for( auto v : range( block.nb_vertices ) )
+                {
+                    append_binary< msh_size >( bytes,
+                        vertices.geomodel_vertex_id( entity,
+                            gmme.mesh_element_vertex_index( ElementLocalVertex(
+                                block.items[i], vertex_order[v] ) ) )
+                            + gmsh_offset );
+                }
+            }
+            return file.write_at( block.offset + msh_block_header_size
+                                      + begin * element_size,
+                bytes );
+        }
+
+    private:
+        const GeoModel3D& geomodel_;
+        const std::vector< MeshEntityType >& types_;
+        std::array< index_t, 5 > first_entity_;
+        std::vector< MSHBlock > node_blocks_;
+        std::vector< MSHBlock > element_blocks_;
+        msh_size nb_elements_{ 0 };
+    };
+
+    /*!
+     * @brief Import for the GMSH format 4.1 binary
+     * @details Point, curve, surface and volume entities become Corners,
+     * Lines, Surfaces and Regions, and their bounding entities give the
+     * boundary relations. Physical groups are ignored.
+     */
+    class GeoModelBuilderMSH final : public GeoModelBuilderFile< 3 >
+    {
+    public:
+        GeoModelBuilderMSH( GeoModel3D& geomodel, std::string filename )
+            : GeoModelBuilderFile< 3 >( geomodel, std::move( filename ) ),
+              types_( geomodel.entity_type_manager()
+                          .mesh_entity_manager.mesh_entity_types() )
+        {
+        }
+
+    private:
+        struct MSHElements
+        {
+            index_t type_index;
+            index_t nb_vertices;
+            std::vector< msh_size > nodes;
+        };
+
+        struct MSHEntity
+        {
+            vec3 point;
+            std::vector< msh_int > boundaries;
+            std::vector< MSHElements > elements;
+        };
+
+        /*!
+         * Vertices and elements of an entity indexed from its own vertices
+         */
+        struct EntityMesh
+        {
+            std::vector< vec3 > points;
+            std::vector< std::vector< index_t > > elements;
+        };
+
+        void load_file() override
+        {
+            read_file();
+            build_topology();
+            build_corners();
+            build_lines();
+            build_surfaces();
+            build_regions();
+        }
+
+        void read_file()
+        {
+            std::ifstream file( filename().c_str(), std::ios::binary );
+            if( !file )
+            {
+                throw RINGMeshException(
+                    "I/O", "Failed to open file ", filename() );
+            }
+            read_format( file );
+            bool has_entities{ false };
+            std::string line;
+            while( read_line( file, line ) )
+            {
+                if( line == "$Entities" )
+                {
+                    read_entities( file );
+                    has_entities = true;
+                }
+                else if( line == "$Nodes" )
+                {
+                    read_nodes( file );
+                }
+                else if( line == "$Elements" )
+                {
+                    read_elements( file );
+                }
+                else if( !line.empty() && line[0] == '$' )
+                {
+                    read_section_end( file, "$End" + line.substr( 1 ), true );
+                }
+            }
+            if( !has_entities )
+            {
+                throw RINGMeshException(
+                    "I/O", "No $Entities section in file ", filename() );
+            }
+        }
+
+        bool read_line( std::istream& file, std::string& line ) const
+        {
+            if( !std::getline( file, line ) )
+            {
+                return false;
+            }
+            if( !line.empty() && line.back() == '\r' )
+            {
+                line.pop_back();
+            }
+            return true;
+        }
+
+        void read_section_end( std::istream& file,
+            const std::string& section_end,
+            bool skip_content = false ) const
+        {
+            std::string line;
+            while( read_line( file, line ) )
+            {
+                if( line == section_end )
+                {
+                    return;
+                }
+                if( !line.empty() && !skip_content )
+                {
+                    break;
+                }
+            }
+            throw RINGMeshException(
+                "I/O", "Missing ", section_end, " in file ", filename() );
+        }
+
+        template < typename T >
+        T read_value( std::istream& file ) const
+        {
+            T value;
+            read_values( file, &value, 1 );
+            return value;
+        }
+
+        template < typename T >
+        void read_values( std::istream& file, T* values, std::size_t nb ) const
+        {
+            file.read( reinterpret_cast< char* >( values ),
+                static_cast< std::streamsize >( nb * sizeof( T ) ) );
+            if( !file )
+            {
+                throw RINGMeshException(
+                    "I/O", "Unexpected end of file ", filename() );
+            }
+        }
+
+        void read_format( std::istream& file ) const
+        {
+            std::string line;
+            read_line( file, line );
+            if( line != "$MeshFormat" )
+            {
+                throw RINGMeshException(
+                    "I/O", "File ", filename(), " is not a MSH file" );
+            }
+            read_line( file, line );
+            std::istringstream format( line );
+            std::string version;
+            index_t file_type{ 0 };
+            index_t data_size{ 0 };
+            format >> version >> file_type >> data_size;
+            if( version != "4.1" || file_type != 1
+                || data_size != sizeof( msh_size ) )
+            {
+                throw RINGMeshException( "I/O",
+                    "Only MSH 4.1 binary files are supported, got format ",
+                    line );
+            }
+            if( read_value< msh_int >( file ) != 1 )
+            {
+                throw RINGMeshException( "I/O",
+                    "MSH file written with another byte order: ", filename() );
+            }
+            read_section_end( file, "$EndMeshFormat" );
+        }
+
+        void read_entities( std::istream& file )
+        {
+            std::array< msh_size, 4 > nb_entities;
+            read_values( file, nb_entities.data(), nb_entities.size() );
+            for( auto dimension : range( 4 ) )
+            {
+                entities_[dimension].resize(
+                    static_cast< index_t >( nb_entities[dimension] ) );
+                for( auto entity : range( nb_entities[dimension] ) )
+                {
+                    auto& msh_entity = entities_[dimension][entity];
+                    tag_to_entity_[dimension][read_value< msh_int >( file )] =
+                        entity;
+                    std::array< double, 6 > coordinates;
+                    read_values( file, coordinates.data(),
+                        dimension == 0 ? 3 : coordinates.size() );
+                    msh_entity.point = { coordinates[0], coordinates[1],
+                        coordinates[2] };
+                    std::vector< msh_int > physicals(
+                        read_value< msh_size >( file ) );
+                    read_values( file, physicals.data(), physicals.size() );
+                    if( dimension > 0 )
+                    {
+                        msh_entity.boundaries.resize(
+                            read_value< msh_size >( file ) );
+                        read_values( file, msh_entity.boundaries.data(),
+                            msh_entity.boundaries.size() );
+                    }
+                }
+            }
+            read_section_end( file, "$EndEntities" );
+        }
+
+        void read_nodes( std::istream& file )
+        {
+            std::array< msh_size, 4 > info;
+            read_values( file, info.data(), info.size() );
+            const auto nb_blocks = info[0];
+            min_node_tag_ = info[2];
+            if( info[1] > 0 )
+            {
+                nodes_.resize( info[3] - info[2] + 1 );
+            }
+            for( auto block : range( nb_blocks ) )
+            {
+                ringmesh_unused( block );
+                const auto dimension = read_value< msh_int >( file );
+                read_value< msh_int >( file );
+                const auto parametric = read_value< msh_int >( file );
+                std::vector< msh_size > tags( read_value< msh_size >( file ) );
+                read_values( file, tags.data(), tags.size() );
+                // Parametric coordinates follow x, y and z
+                std::size_t nb_coordinates{ 3 };
+                if( parametric != 0 )
+                {
+                    nb_coordinates += static_cast< std::size_t >( dimension );
+                }
+                std::vector< double > coordinates(
+                    tags.size() * nb_coordinates );
+                read_values( file, coordinates.data(), coordinates.size() );
+                for( auto n : range( tags.size() ) )
+                {
+                    const auto* point = &coordinates[n * nb_coordinates];
+                    nodes_[node_index( tags[n] )] = { point[0], point[1],
+                        point[2] };
+                }
+            }
+            read_section_end( file, "$EndNodes" );
+        }
+
+        void read_elements( std::istream& file )
+        {
+            std::array< msh_size, 4 > info;
+            read_values( file, info.data(), info.size() );
+            for( auto block : range( info[0] ) )
+            {
+                ringmesh_unused( block );
+                const auto dimension =
+                    static_cast< index_t >( read_value< msh_int >( file ) );
+                const auto tag = read_value< msh_int >( file );
+                const auto type =
+                    static_cast< index_t >( read_value< msh_int >( file ) );
+                const auto nb_elements = read_value< msh_size >( file );
+                const auto nb_vertices = nb_element_vertices( type );
+                const auto type_index = nb_vertices + dimension;
+                if( dimension > 3 || type_index >= 12
+                    || element_type[type_index] != type )
+                {
+                    throw RINGMeshException( "I/O", "Element type ", type,
+                        " is not supported in entities of dimension ",
+                        dimension );
+                }
+                std::vector< msh_size > data(
+                    nb_elements * ( nb_vertices + 1 ) );
+                read_values( file, data.data(), data.size() );
+                MSHElements elements{ type_index, nb_vertices, {} };
+                elements.nodes.reserve( nb_elements * nb_vertices );
+                for( auto element : range( nb_elements ) )
+                {
+                    const auto* nodes =
+                        &data[element * ( nb_vertices + 1 ) + 1];
+                    for( auto v : range( nb_vertices ) )
+                    {
+                        // Throws if the node does not exist
+                        node_index( nodes[v] );
+                        elements.nodes.push_back( nodes[v] );
+                    }
+                }
+                entities_[dimension][entity_index( dimension, tag )]
+                    .elements.push_back( std::move( elements ) );
+            }
+            read_section_end( file, "$EndElements" );
+        }
+
+        index_t nb_element_vertices( index_t type ) const
+        {
+            switch( type )
+            {
+            case 15:
+                return 1;
+            case 1:
+                return 2;
+            case 2:
+                return 3;
+            case 3:
+            case 4:
+                return 4;
+            case 7:
+                return 5;
+            case 6:
+                return 6;
+            case 5:
+                return 8;
+            default:
+                throw RINGMeshException(
+                    "I/O", "Unsupported MSH element type ", type );
+            }
+        }
+
+        index_t entity_index( index_t dimension, msh_int tag ) const
+        {
+            const auto entity =
+                tag_to_entity_[dimension].find( std::abs( tag ) );
+            if( entity == tag_to_entity_[dimension].end() )
+            {
+                throw RINGMeshException( "I/O", "No entity of dimension ",
+                    dimension, " with tag ", tag );
+            }
+            return entity->second;
+        }
+
+        index_t node_index( msh_size tag ) const
+        {
+            if( tag < min_node_tag_ || tag - min_node_tag_ >= nodes_.size() )
+            {
+                throw RINGMeshException( "I/O", "Invalid node tag ", tag );
+            }
+            return static_cast< index_t >( tag - min_node_tag_ );
+        }
+
+        void build_topology()
+        {
+            for( auto dimension : range( 4 ) )
+            {
+                topology.create_mesh_entities( types_[dimension],
+                    static_cast< index_t >( entities_[dimension].size() ) );
+            }
+            for( auto line : range( entities_[1].size() ) )
+            {
+                for( auto tag : entities_[1][line].boundaries )
+                {
+                    topology.add_line_corner_boundary_relation(
+                        line, entity_index( 0, tag ) );
+                }
+            }
+            for( auto surface : range( entities_[2].size() ) )
+            {
+                for( auto tag : entities_[2][surface].boundaries )
+                {
+                    topology.add_surface_line_boundary_relation(
+                        surface, entity_index( 1, tag ) );
+                }
+            }
+            for( auto region : range( entities_[3].size() ) )
+            {
+                for( auto tag : entities_[3][region].boundaries )
+                {
+                    topology.add_region_surface_boundary_relation(
+                        region, entity_index( 2, tag ), tag > 0 );
+                }
+            }
+        }
+
+        void build_corners()
+        {
+            for( auto corner : range( entities_[0].size() ) )
+            {
+                const auto& entity = entities_[0][corner];
+                if( entity.elements.empty() )
+                {
+                    geometry.set_corner( corner, entity.point );
+                }
+                else
+                {
+                    geometry.set_corner( corner,
+                        nodes_[node_index( entity.elements[0].nodes[0] )] );
+                }
+            }
+        }
+
+        void build_lines()
+        {
+            for( auto line : range( entities_[1].size() ) )
+            {
+                std::vector< msh_size > chain;
+                for( const auto& elements : entities_[1][line].elements )
+                {
+                    for( auto e : range( elements.nodes.size() / 2 ) )
+                    {
+                        if( chain.empty() )
+                        {
+                            chain.push_back( elements.nodes[2 * e] );
+                        }
+                        else if( chain.back() != elements.nodes[2 * e] )
+                        {
+                            throw RINGMeshException( "I/O", "Line ", line,
+                                " is not a chain of consecutive edges" );
+                        }
+                        chain.push_back( elements.nodes[2 * e + 1] );
+                    }
+                }
+                if( chain.empty() )
+                {
+                    continue;
+                }
+                std::vector< vec3 > vertices( chain.size() );
+                for( auto v : range( chain.size() ) )
+                {
+                    vertices[v] = nodes_[node_index( chain[v] )];
+                }
+                geometry.set_line( line, vertices );
+            }
+        }
+
+        void build_surfaces()
+        {
+            const auto meshes = entity_meshes( entities_[2] );
+            for( auto surface : range( meshes.size() ) )
+            {
+                const auto& mesh = meshes[surface];
+                if( mesh.points.empty() )
+                {
+                    continue;
+                }
+                std::vector< index_t > polygons;
+                std::vector< index_t > polygon_ptr( 1, 0 );
+                for( auto b : range( mesh.elements.size() ) )
+                {
+                    const auto nb_vertices =
+                        entities_[2][surface].elements[b].nb_vertices;
+                    const auto& polygon_vertices = mesh.elements[b];
+                    for( index_t v = 0; v < polygon_vertices.size();
+                         v += nb_vertices )
+                    {
+                        polygons.insert( polygons.end(),
+                            polygon_vertices.begin() + v,
+                            polygon_vertices.begin() + v + nb_vertices );
+                        polygon_ptr.push_back(
+                            static_cast< index_t >( polygons.size() ) );
+                    }
+                }
+                geometry.set_surface_geometry(
+                    surface, mesh.points, polygons, polygon_ptr );
+            }
+        }
+
+        void build_regions()
+        {
+            const auto meshes = entity_meshes( entities_[3] );
+            for( auto region : range( meshes.size() ) )
+            {
+                const auto& mesh = meshes[region];
+                if( mesh.points.empty() )
+                {
+                    continue;
+                }
+                geometry.set_mesh_entity_vertices(
+                    { types_[3], region }, mesh.points, true );
+                auto builder = geometry.create_region_builder( region );
+                for( auto b : range( mesh.elements.size() ) )
+                {
+                    const auto nb_vertices =
+                        entities_[3][region].elements[b].nb_vertices;
+                    const auto& cell_vertices = mesh.elements[b];
+                    const auto nb_cells = static_cast< index_t >(
+                        cell_vertices.size() / nb_vertices );
+                    const auto first_cell = builder->create_cells(
+                        nb_cells, cell_type( nb_vertices ) );
+                    for( auto cell : range( nb_cells ) )
+                    {
+                        for( auto v : range( nb_vertices ) )
+                        {
+                            builder->set_cell_vertex(
+                                { first_cell + cell, v },
+                                cell_vertices[cell * nb_vertices + v] );
+                        }
+                    }
+                }
+                builder.reset();
+                geometry.compute_region_adjacencies( region );
+            }
+        }
+
+        CellType cell_type( index_t nb_vertices ) const
+        {
+            switch( nb_vertices )
+            {
+            case 4:
+                return CellType::TETRAHEDRON;
+            case 5:
+                return CellType::PYRAMID;
+            case 6:
+                return CellType::PRISM;
+            default:
+                return CellType::HEXAHEDRON;
+            }
+        }
+
+        /*!
+         * Computes in parallel the vertices of each entity and its elements
+         * in RINGMesh vertex order
+         */
+        std::vector< EntityMesh > entity_meshes(
+            const std::vector< MSHEntity >& entities ) const
+        {
+            std::vector< EntityMesh > meshes( entities.size() );
+            parallel_for( static_cast< index_t >( entities.size() ),
+                [&entities, &meshes, this]( index_t entity ) {
+                    const auto& msh_entity = entities[entity];
+                    std::vector< msh_size > tags;
+                    for( const auto& elements : msh_entity.elements )
+                    {
+                        tags.insert( tags.end(), elements.nodes.begin(),
+                            elements.nodes.end() );
+                    }
+                    std::sort( tags.begin(), tags.end() );
+                    tags.erase( std::unique( tags.begin(), tags.end() ),
+                        tags.end() );
+
+                    auto& mesh = meshes[entity];
+                    mesh.points.reserve( tags.size() );
+                    for( auto tag : tags )
+                    {
+                        mesh.points.push_back( nodes_[tag - min_node_tag_] );
+                    }
+                    for( const auto& elements : msh_entity.elements )
+                    {
+                        const auto* vertex_order =
+                            vertices_in_elements[elements.type_index];
+                        std::vector< index_t > vertices(
+                            elements.nodes.size() );
+                        for( auto v : range( elements.nodes.size() ) )
+                        {
+                            const auto element = v / elements.nb_vertices;
+                            const auto local = v % elements.nb_vertices;
+                            vertices[element * elements.nb_vertices
+                                     + vertex_order[local]] =
+                                static_cast< index_t >(
+                                    std::lower_bound( tags.begin(),
+                                        tags.end(), elements.nodes[v] )
+                                    - tags.begin() );
+                        }
+                        mesh.elements.push_back( std::move( vertices ) );
+                    }
+                } );
+            return meshes;
+        }
+
+    private:
+        const std::vector< MeshEntityType >& types_;
+        std::array< std::vector< MSHEntity >, 4 > entities_;
+        std::array< std::map< msh_int, index_t >, 4 > tag_to_entity_;
+        std::vector< vec3 > nodes_;
+        msh_size min_node_tag_{ 0 };
+    };
+
     /*!
      * @brief Export for the GMSH format 2.2 which is described here:
      * http://gmsh.info/doc/texinfo/gmsh.html#MSH-ASCII-file-format
+     * or, with the io:binary option, for the GMSH format 4.1 binary.
+     * Import is done from the GMSH format 4.1 binary.
      * NB : Mesh entities are also exported
      */
-    class MSHIOHandler final : public GeoModelOutputHandler3D
+    class MSHIOHandler final : public GeoModelInputHandler3D,
+                               public GeoModelOutputHandler3D
     {
     public:
+        void load( const std::string& filename, GeoModel3D& geomodel ) final
+        {
+            GeoModelBuilderMSH builder{ geomodel, filename };
+            builder.build_geomodel();
+        }
+
         void save(
             const GeoModel3D& geomodel, const std::string& filename ) final
         {
-            std::ofstream out( filename.c_str() );
-            out.precision( 16 );
+            if( GEO::CmdLine::get_arg_bool( "io:binary" ) )
+            {
+                MSHBinaryWriter writer{ geomodel };
+                writer.write( filename );
+            }
+            else
+            {
+                save_ascii( geomodel, filename );
+            }
+        }
+
+    private:
+        void save_ascii(
+            const GeoModel3D& geomodel, const std::string& filename )
+        {
+            BufferedTextWriter out( filename, 16 );
 
             out << "$MeshFormat" << EOL;
             out << "2.2 0 8" << EOL;
             out << "$EndMeshFormat" << EOL;
 
+            const auto& vertices = geomodel.mesh.vertices;
             out << "$Nodes" << EOL;
-            out << geomodel.mesh.vertices.nb() << EOL;
-            for( auto v : range( geomodel.mesh.vertices.nb() ) )
-            {
-                out << v + gmsh_offset << SPACE
-                    << geomodel.mesh.vertices.vertex( v ) << EOL;
-            }
+            out << vertices.nb() << EOL;
+            out.write_parallel(
+                vertices.nb(), [&vertices]( TextBuffer& buffer, index_t v ) {
+                    buffer << v + gmsh_offset << SPACE << vertices.vertex( v )
+                           << EOL;
+                } );
             out << "$EndNodes" << EOL;
 
             out << "$Elements" << EOL;
@@ -130,49 +1166,57 @@ namespace
                         index_of_gmme_of_the_current_type );
                     const GeoModelMeshEntity< 3 >& cur_gmme =
                         geomodel.mesh_entity( cur_gmme_id );
-                    for( auto elem_in_cur_gmme :
-                        range( cur_gmme.nb_mesh_elements() ) )
-                    {
-                        index_t nb_vertices_in_cur_element =
-                            cur_gmme.nb_mesh_element_vertices(
-                                elem_in_cur_gmme );
-                        index_t gmsh_element_type = find_gmsh_element_type(
-                            nb_vertices_in_cur_element, gmme_type_index );
-                        out << element_index++ << SPACE << gmsh_element_type
-                            << SPACE << nb_of_tags << SPACE << physical_id
-                            << SPACE
-                            << index_of_gmme_of_the_current_type + gmsh_offset
-                            << SPACE /*<< nb_vertices_in_cur_element << SPACE*/;
-                        for( auto v_index_in_cur_element :
-                            range( nb_vertices_in_cur_element ) )
-                        {
-                            out << geomodel.mesh.vertices.geomodel_vertex_id(
-                                       cur_gmme_id,
-                                       cur_gmme.mesh_element_vertex_index(
-                                           ElementLocalVertex( elem_in_cur_gmme,
-                                               find_gmsh_element_local_vertex_id(
-                                                   nb_vertices_in_cur_element,
-                                                   gmme_type_index,
-                                                   v_index_in_cur_element ) ) ) )
-                                       + gmsh_offset
-                                << SPACE;
-                        }
-                        out << EOL;
-                    }
+                    out.write_parallel( cur_gmme.nb_mesh_elements(),
+                        [&]( TextBuffer& buffer, index_t elem_in_cur_gmme ) {
+                            write_element( buffer, vertices, cur_gmme_id,
+                                cur_gmme, gmme_type_index, elem_in_cur_gmme,
+                                element_index + elem_in_cur_gmme );
+                        } );
+                    element_index += cur_gmme.nb_mesh_elements();
                 }
             }
             out << "$EndElements" << EOL;
-            out << std::flush;
         }
 
-    private:
+        void write_element( TextBuffer& out,
+            const GeoModelMeshVertices3D& vertices,
+            const gmme_id& cur_gmme_id,
+            const GeoModelMeshEntity< 3 >& cur_gmme,
+            index_t gmme_type_index,
+            index_t elem_in_cur_gmme,
+            index_t element_index ) const
+        {
+            index_t nb_vertices_in_cur_element =
+                cur_gmme.nb_mesh_element_vertices( elem_in_cur_gmme );
+            index_t gmsh_element_type = find_gmsh_element_type(
+                nb_vertices_in_cur_element, gmme_type_index );
+            out << element_index << SPACE << gmsh_element_type << SPACE
+                << nb_of_tags << SPACE << physical_id << SPACE
+                << cur_gmme_id.index() + gmsh_offset
+                << SPACE /*<< nb_vertices_in_cur_element << SPACE*/;
+            for( auto v_index_in_cur_element :
+                range( nb_vertices_in_cur_element ) )
+            {
+                out << vertices.geomodel_vertex_id( cur_gmme_id,
+                           cur_gmme.mesh_element_vertex_index(
+                               ElementLocalVertex( elem_in_cur_gmme,
+                                   find_gmsh_element_local_vertex_id(
+                                       nb_vertices_in_cur_element,
+                                       gmme_type_index,
+                                       v_index_in_cur_element ) ) ) )
+                           + gmsh_offset
+                    << SPACE;
+            }
+            out << EOL;
+        }
+
         /*!
          * @brief Find the gmsh type on an element using
          * the number of vertices and the mesh entity index
          * in which the element belong
          */
         index_t find_gmsh_element_type(
-            index_t nb_vertices, index_t mesh_entity_type_index )
+            index_t nb_vertices, index_t mesh_entity_type_index ) const
         {
             return element_type[nb_vertices + mesh_entity_type_index];
         }
@@ -184,7 +1228,7 @@ namespace
          */
         index_t find_gmsh_element_local_vertex_id( index_t nb_vertices,
             index_t mesh_entity_type_index,
-            index_t local_vertex_index )
+            index_t local_vertex_index ) const
         {
             return vertices_in_elements[nb_vertices + mesh_entity_type_index]
                                        [local_vertex_index];
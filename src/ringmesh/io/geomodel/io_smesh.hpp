@@ -45,27 +45,21 @@ namespace
         void save(
             const GeoModel3D& geomodel, const std::string& filename ) final
         {
-            std::ofstream out( filename.c_str() );
-            if( out.bad() )
-            {
-                Logger::err(
-                    "I/O", "Error when opening the file: ", filename.c_str() );
-                return;
-            }
-            out.precision( 16 );
+            BufferedTextWriter out( filename, 16 );
+            const auto& vertices = geomodel.mesh.vertices;
 
             /// 1. Write the unique vertices
             out << "# Node list" << EOL;
             out << "# node count, 3 dim, no attribute, no boundary marker"
                 << EOL;
-            out << geomodel.mesh.vertices.nb() << " 3 0 0" << EOL;
+            out << vertices.nb() << " 3 0 0" << EOL;
             out << "# node index, node coordinates " << EOL;
-            for( auto p : range( geomodel.mesh.vertices.nb() ) )
-            {
-                const vec3& V = geomodel.mesh.vertices.vertex( p );
-                out << p << " "
-                    << " " << V.x << " " << V.y << " " << V.z << EOL;
-            }
+            out.write_parallel(
+                vertices.nb(), [&vertices]( TextBuffer& buffer, index_t p ) {
+                    const vec3& V = vertices.vertex( p );
+                    buffer << p << " "
+                           << " " << V.x << " " << V.y << " " << V.z << EOL;
+                } );
 
             /// 2. Write the triangles
             out << "# Part 2 - facet list" << EOL;
@@ -74,23 +68,23 @@ namespace
 
             for( const auto& surface : geomodel.surfaces() )
             {
-                for( auto p : range( surface.nb_mesh_elements() ) )
-                {
-                    out << surface.nb_mesh_element_vertices( p ) << " ";
-                    for( auto v :
-                        range( surface.nb_mesh_element_vertices( p ) ) )
-                    {
-                        out << geomodel.mesh.vertices.geomodel_vertex_id(
-                                   surface.gmme(), ElementLocalVertex( p, v ) )
-                            << " ";
-                    }
-                    out << EOL;
-                }
+                out.write_parallel( surface.nb_mesh_elements(),
+                    [&vertices, &surface]( TextBuffer& buffer, index_t p ) {
+                        buffer << surface.nb_mesh_element_vertices( p ) << " ";
+                        for( auto v :
+                            range( surface.nb_mesh_element_vertices( p ) ) )
+                        {
+                            buffer << vertices.geomodel_vertex_id(
+                                          surface.gmme(),
+                                          ElementLocalVertex( p, v ) )
+                                   << " ";
+                        }
+                        buffer << EOL;
+                    } );
             }
 
             // Do not forget the stupid zeros at the end of the file
             out << EOL << "0" << EOL << "0" << EOL;
-            out << std::flush;
         }
     };
 }
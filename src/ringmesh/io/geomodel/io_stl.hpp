@@ -35,78 +35,69 @@
 
 namespace
 {
-    void save_header( const GeoModel3D& geomodel, std::ostream& out )
-    {
-        out << "solid " << geomodel.name() << EOL;
-    }
+    // Binary STL: 80 bytes header, number of triangles, then for each
+    // triangle its normal, its 3 vertices and a 2 bytes attribute
+    const std::size_t stl_header_size{ 80 };
+    const std::size_t stl_triangle_size{ 12 * sizeof( float )
+                                         + sizeof( std::uint16_t ) };
 
-    void save_footer( const GeoModel3D& geomodel, std::ostream& out )
-    {
-        out << "endsolid " << geomodel.name() << EOL;
-    }
-
-    void save_normal(
-        const GeoModel3D& geomodel, index_t triangle_id, std::ostream& out )
-    {
-        out << "facet normal " << geomodel.mesh.polygons.normal( triangle_id )
-            << EOL;
-    }
+    // Number of triangles encoded at once by a writing task
+    const index_t stl_chunk_size{ 1 << 14 };
 
-    void begin_triangle( std::ostream& out )
+    void save_header( const GeoModel3D& geomodel, BufferedTextWriter& out )
     {
-        out << "outer loop" << EOL;
-    }
-
-    void end_triangle( std::ostream& out )
-    {
-        out << "endloop" << EOL;
-	out << "endfacet" << EOL;
+        out << "solid " << geomodel.name() << EOL;
     }
 
-    void save_triangle_vertex( const GeoModel3D& geomodel,
-        index_t triangle_id,
-        index_t local_vertex_id,
-        std::ostream& out )
+    void save_footer( const GeoModel3D& geomodel, BufferedTextWriter& out )
     {
-        out << "vertex "
-            << geomodel.mesh.vertices.vertex( geomodel.mesh.polygons.vertex(
-                   ElementLocalVertex( triangle_id, local_vertex_id ) ) )
-            << EOL;
+        out << "endsolid " << geomodel.name() << EOL;
     }
 
     void save_triangle(
-        const GeoModel3D& geomodel, index_t triangle_id, std::ostream& out )
+        const Surface3D& surface, index_t triangle_id, TextBuffer& out )
     {
-        save_normal( geomodel, triangle_id, out );
-        begin_triangle( out );
+        const auto& mesh = surface.mesh();
+        out << "facet normal " << mesh.polygon_normal( triangle_id ) << EOL;
+        out << "outer loop" << EOL;
         for( auto vertex : range( 3 ) )
         {
-            save_triangle_vertex( geomodel, triangle_id, vertex, out );
-        }
-        end_triangle( out );
-    }
-
-    void save_triangles( const GeoModel3D& geomodel, std::ostream& out )
-    {
-        for( auto triangle : range( geomodel.mesh.polygons.nb_triangle() ) )
-        {
-            save_triangle( geomodel, triangle, out );
+            out << "vertex "
+                << surface.vertex( mesh.polygon_vertex(
+                       ElementLocalVertex( triangle_id, vertex ) ) )
+                << EOL;
         }
+        out << "endloop" << EOL;
+        out << "endfacet" << EOL;
     }
 
-    void check_stl_validity( const GeoModel3D& geomodel )
+    void encode_binary_triangle(
+        const Surface3D& surface, index_t triangle_id, char* bytes )
     {
-        if( geomodel.mesh.polygons.nb()
-            != geomodel.mesh.polygons.nb_triangle() )
+        const auto& mesh = surface.mesh();
+        std::array< float, 12 > values;
+        auto normal = mesh.polygon_normal( triangle_id );
+        for( auto v : range( 4 ) )
         {
-            throw RINGMeshException( "I/O",
-                "Geological model save in STL format support only triangles" );
+            const auto& point =
+                v == 0 ? normal
+                       : surface.vertex( mesh.polygon_vertex(
+                             ElementLocalVertex( triangle_id, v - 1 ) ) );
+            for( auto coordinate : range( 3 ) )
+            {
+                values[3 * v + coordinate] =
+                    static_cast< float >( point[coordinate] );
+            }
         }
+        std::memcpy( bytes, values.data(), sizeof( values ) );
+        const std::uint16_t attribute{ 0 };
+        std::memcpy(
+            bytes + sizeof( values ), &attribute, sizeof( attribute ) );
     }
 
     /*!
      * STL is an (old) file format used in CAD software
-     * This is the ASCII export for this format
+     * The ASCII export for this format is
      * facet normal ni nj nk
      *   outer loop
      *      vertex v1x v1y v1z
@@ -114,6 +105,11 @@ namespace
      *      vertex v3x v3y v3z
      *   endloop
      * endfacet
+     * The ASCII triangles are written in the GeoModelMesh order.
+     * The binary export (io:binary) stores the same data as float values,
+     * in the Surface order without building the GeoModelMesh.
+     * Only the Surfaces given by io:entities are exported, all of them
+     * by default.
      */
     class STLIOHandler final : public GeoModelOutputHandler3D
     {
@@ -121,13 +117,125 @@ namespace
         void save(
             const GeoModel3D& geomodel, const std::string& filename ) final
         {
-            check_stl_validity( geomodel );
-            std::ofstream out( filename.c_str() );
-            out.precision( 17 );
+            auto surfaces = selected_mesh_entities( geomodel.nb_surfaces() );
+            check_stl_validity( geomodel, surfaces );
+            if( GEO::CmdLine::get_arg_bool( "io:binary" ) )
+            {
+                save_binary( geomodel, surfaces, filename );
+            }
+            else
+            {
+                save_ascii( geomodel, surfaces, filename );
+            }
+        }
+
+    private:
+        void check_stl_validity( const GeoModel3D& geomodel,
+            const std::vector< index_t >& surfaces ) const
+        {
+            for( auto surface : surfaces )
+            {
+                if( !geomodel.surface( surface ).is_simplicial() )
+                {
+                    throw RINGMeshException( "I/O",
+                        "Geological model save in STL format support only "
+                        "triangles" );
+                }
+            }
+        }
+
+        void save_ascii( const GeoModel3D& geomodel,
+            const std::vector< index_t >& surfaces,
+            const std::string& filename ) const
+        {
+            BufferedTextWriter out( filename, 17 );
             save_header( geomodel, out );
-            save_triangles( geomodel, out );
+            const auto& polygons = geomodel.mesh.polygons;
+            for( auto surface_id : surfaces )
+            {
+                const auto& surface = geomodel.surface( surface_id );
+                std::vector< index_t > triangles( surface.nb_mesh_elements() );
+                for( auto t : range( surface.nb_mesh_elements() ) )
+                {
+                    triangles[t] = polygons.index_in_surface(
+                        polygons.triangle( surface_id, t ) );
+                }
+                out.write_parallel( surface.nb_mesh_elements(),
+                    [&surface, &triangles](
+                        TextBuffer& buffer, index_t triangle ) {
+                        save_triangle( surface, triangles[triangle], buffer );
+                    } );
+            }
             save_footer( geomodel, out );
-            out << std::flush;
+        }
+
+        void save_binary( const GeoModel3D& geomodel,
+            const std::vector< index_t >& surfaces,
+            const std::string& filename ) const
+        {
+            struct Chunk
+            {
+                index_t surface;
+                index_t begin;
+                index_t end;
+                std::size_t offset;
+            };
+            std::vector< Chunk > chunks;
+            std::size_t nb_triangles{ 0 };
+            for( auto surface : surfaces )
+            {
+                const auto nb_surface_triangles =
+                    geomodel.surface( surface ).nb_mesh_elements();
+                for( index_t begin = 0; begin < nb_surface_triangles;
+                     begin += stl_chunk_size )
+                {
+                    chunks.push_back( { surface, begin,
+                        std::min( nb_surface_triangles,
+                            begin + stl_chunk_size ),
+                        stl_header_size + sizeof( std::uint32_t )
+                            + ( nb_triangles + begin ) * stl_triangle_size } );
+                }
+                nb_triangles += nb_surface_triangles;
+            }
+            if( nb_triangles > std::numeric_limits< std::uint32_t >::max() )
+            {
+                throw RINGMeshException(
+                    "I/O", "Too many triangles for a binary STL file" );
+            }
+
+            std::string header{ "binary STL " + geomodel.name() };
+            header.resize( stl_header_size, '\0' );
+            const auto nb_stl_triangles =
+                static_cast< std::uint32_t >( nb_triangles );
+            header.append( reinterpret_cast< const char* >( &nb_stl_triangles ),
+                sizeof( nb_stl_triangles ) );
+
+            BinaryFileWriter file{ filename,
+                header.size() + nb_triangles * stl_triangle_size };
+            std::vector< char > written( chunks.size(), 0 );
+            parallel_for( static_cast< index_t >( chunks.size() ),
+                [&geomodel, &file, &chunks, &written]( index_t c ) {
+                    const auto& chunk = chunks[c];
+                    const auto& surface = geomodel.surface( chunk.surface );
+                    std::vector< char > bytes(
+                        ( chunk.end - chunk.begin ) * stl_triangle_size );
+                    for( auto triangle : range( chunk.begin, chunk.end ) )
+                    {
+                        encode_binary_triangle( surface, triangle,
+                            &bytes[( triangle - chunk.begin )
+                                   * stl_triangle_size] );
+                    }
+                    auto ok = file.write_at(
+                        chunk.offset, bytes.data(), bytes.size() );
+                    written[c] = ok ? 1 : 0;
+                } );
+            if( !file.write_at( 0, header )
+                || std::find( written.begin(), written.end(), 0 )
+                       != written.end() )
+            {
+                throw RINGMeshException(
+                    "I/O", "Failed to write file ", filename );
+            }
         }
     };
 }
@@ -35,6 +35,7 @@
 
 /*!
  * @brief Classes to load and build a GeoModel2D from a .svg
+ * and to save the Lines of a GeoModel2D in a .svg
  * @author Arnaud Botella
  */
 
@@ -252,7 +253,64 @@ namespace
         double height_;
     };
 
-    class SVGIOHandler final : public GeoModelInputHandler2D
+    /*!
+     * Simplifies a Line with the Douglas-Peucker algorithm
+     * @param[in] tolerance maximal distance between the removed vertices
+     * and the simplified line, nothing is removed if it is not positive
+     * @return the indices of the kept vertices, the extremities are
+     * always kept
+     */
+    std::vector< index_t > simplify_line(
+        const Line2D& line, double tolerance )
+    {
+        const auto nb_vertices = line.nb_vertices();
+        std::vector< char > kept( nb_vertices, tolerance > 0 ? 0 : 1 );
+        kept.front() = 1;
+        kept.back() = 1;
+        std::stack< std::pair< index_t, index_t > > ranges;
+        if( tolerance > 0 )
+        {
+            ranges.emplace( 0, nb_vertices - 1 );
+        }
+        while( !ranges.empty() )
+        {
+            auto first = ranges.top().first;
+            auto last = ranges.top().second;
+            ranges.pop();
+            Geometry::Segment2D segment{ line.vertex( first ),
+                line.vertex( last ) };
+            auto farthest = NO_ID;
+            auto max_distance = tolerance;
+            for( auto v : range( first + 1, last ) )
+            {
+                auto distance = std::get< 0 >(
+                    Distance::point_to_segment( line.vertex( v ), segment ) );
+                if( distance > max_distance )
+                {
+                    max_distance = distance;
+                    farthest = v;
+                }
+            }
+            if( farthest != NO_ID )
+            {
+                kept[farthest] = 1;
+                ranges.emplace( first, farthest );
+                ranges.emplace( farthest, last );
+            }
+        }
+        std::vector< index_t > vertices;
+        for( auto v : range( nb_vertices ) )
+        {
+            if( kept[v] )
+            {
+                vertices.push_back( v );
+            }
+        }
+        return vertices;
+    }
+
+    class SVGIOHandler final : public GeoModelInputHandler2D,
+                               public GeoModelOutputHandler2D
     {
     public:
         void load( const std::string& filename, GeoModel2D& geomodel ) final
@@ -260,5 +318,62 @@ namespace
             GeoModelBuilderSVG builder( geomodel, filename );
             builder.build_geomodel();
         }
+
+        /*!
+         * Saves each Line given by io:entities (all of them by default)
+         * as a path, after its simplification with the io:tolerance
+         * distance. The y axis is flipped using the height of the svg
+         * so that the file can be loaded back. The GeoModelMesh is not used.
+         */
+        void save(
+            const GeoModel2D& geomodel, const std::string& filename ) final
+        {
+            auto lines = selected_mesh_entities( geomodel.nb_lines() );
+            const auto tolerance =
+                GEO::CmdLine::get_arg_double( "io:tolerance" );
+            std::vector< std::vector< index_t > > line_vertices(
+                lines.size() );
+            std::vector< Box2D > boxes( lines.size() );
+            parallel_for( static_cast< index_t >( lines.size() ),
+                [&geomodel, &lines, &line_vertices, &boxes, tolerance](
+                    index_t l ) {
+                    const auto& line = geomodel.line( lines[l] );
+                    line_vertices[l] = simplify_line( line, tolerance );
+                    for( auto v : line_vertices[l] )
+                    {
+                        boxes[l].add_point( line.vertex( v ) );
+                    }
+                } );
+            Box2D box;
+            for( const auto& line_box : boxes )
+            {
+                box.add_box( line_box );
+            }
+            auto size = box.diagonal();
+            auto height = size.y;
+
+            BufferedTextWriter out( filename );
+            out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>" << EOL;
+            out << "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\""
+                << size.x << "\" height=\"" << height << "\" viewBox=\""
+                << box.min().x << " " << height - box.max().y << " " << size.x
+                << " " << height << "\">" << EOL;
+            out << "<g fill=\"none\" stroke=\"black\" stroke-width=\""
+                << std::max( size.x, size.y ) / 1000 << "\">" << EOL;
+            for( auto l : range( lines.size() ) )
+            {
+                const auto& line = geomodel.line( lines[l] );
+                out << "<path id=\"line_" << lines[l] << "\" d=\"";
+                for( auto v : range( line_vertices[l].size() ) )
+                {
+                    const auto& vertex = line.vertex( line_vertices[l][v] );
+                    out << ( v == 0 ? "M " : v == 1 ? " L " : " " ) << vertex.x
+                        << "," << height - vertex.y;
+                }
+                out << "\"/>" << EOL;
+            }
+            out << "</g>" << EOL;
+            out << "</svg>" << EOL;
+        }
     };
 }
@@ -44,63 +44,66 @@ namespace
             std::string directory = GEO::FileSystem::dir_name( filename );
             std::string file = GEO::FileSystem::base_name( filename );
 
+            const GeoModelMesh3D& mesh = geomodel.mesh;
+            const auto& vertices = mesh.vertices;
+            const auto& cells = mesh.cells;
+
             std::ostringstream oss_node;
             oss_node << directory << "/" << file << ".node";
-            std::ofstream node( oss_node.str().c_str() );
-            node.precision( 16 );
-
-            const GeoModelMesh3D& mesh = geomodel.mesh;
-            node << mesh.vertices.nb() << " 3 0 0" << EOL;
-            for( auto v : range( mesh.vertices.nb() ) )
-            {
-                node << v << SPACE << mesh.vertices.vertex( v ) << EOL;
-            }
+            BufferedTextWriter node( oss_node.str(), 16 );
+            node << vertices.nb() << " 3 0 0" << EOL;
+            node.write_parallel(
+                vertices.nb(), [&vertices]( TextBuffer& buffer, index_t v ) {
+                    buffer << v << SPACE << vertices.vertex( v ) << EOL;
+                } );
 
             std::ostringstream oss_ele;
             oss_ele << directory << "/" << file << ".ele";
-            std::ofstream ele( oss_ele.str().c_str() );
+            BufferedTextWriter ele( oss_ele.str() );
             std::ostringstream oss_neigh;
             oss_neigh << directory << "/" << file << ".neigh";
-            std::ofstream neigh( oss_neigh.str().c_str() );
+            BufferedTextWriter neigh( oss_neigh.str() );
 
-            ele << mesh.cells.nb() << " 4 1" << EOL;
-            neigh << mesh.cells.nb() << " 4" << EOL;
+            ele << cells.nb() << " 4 1" << EOL;
+            neigh << cells.nb() << " 4" << EOL;
             index_t nb_tet_exported = 0;
             for( auto m : range( geomodel.nb_regions() ) )
             {
-                for( auto tet : range( mesh.cells.nb_tet( m ) ) )
-                {
-                    index_t cell = mesh.cells.tet( m, tet );
-                    ele << nb_tet_exported << SPACE
-                        << mesh.cells.vertex( ElementLocalVertex( cell, 0 ) )
-                        << SPACE
-                        << mesh.cells.vertex( ElementLocalVertex( cell, 1 ) )
-                        << SPACE
-                        << mesh.cells.vertex( ElementLocalVertex( cell, 2 ) )
-                        << SPACE
-                        << mesh.cells.vertex( ElementLocalVertex( cell, 3 ) )
-                        << SPACE << m + 1 << EOL;
-                    neigh << nb_tet_exported;
-                    for( auto f : range( mesh.cells.nb_facets( tet ) ) )
-                    {
-                        neigh << SPACE;
-                        index_t adj = mesh.cells.adjacent( cell, f );
-                        if( adj == NO_ID )
+                ele.write_parallel( cells.nb_tet( m ),
+                    [&cells, m, nb_tet_exported](
+                        TextBuffer& buffer, index_t tet ) {
+                        index_t cell = cells.tet( m, tet );
+                        buffer << nb_tet_exported + tet;
+                        for( auto v : range( 4 ) )
                         {
-                            neigh << -1;
+                            buffer << SPACE
+                                   << cells.vertex(
+                                          ElementLocalVertex( cell, v ) );
                         }
-                        else
+                        buffer << SPACE << m + 1 << EOL;
+                    } );
+                neigh.write_parallel( cells.nb_tet( m ),
+                    [&cells, m, nb_tet_exported](
+                        TextBuffer& buffer, index_t tet ) {
+                        index_t cell = cells.tet( m, tet );
+                        buffer << nb_tet_exported + tet;
+                        for( auto f : range( cells.nb_facets( tet ) ) )
                         {
-                            neigh << adj;
+                            buffer << SPACE;
+                            index_t adj = cells.adjacent( cell, f );
+                            if( adj == NO_ID )
+                            {
+                                buffer << -1;
+                            }
+                            else
+                            {
+                                buffer << adj;
+                            }
                         }
-                    }
-                    neigh << EOL;
-                    nb_tet_exported++;
-                }
+                        buffer << EOL;
+                    } );
+                nb_tet_exported += cells.nb_tet( m );
             }
-            ele << std::flush;
-            neigh << std::flush;
-            node << std::flush;
         }
     };
 }
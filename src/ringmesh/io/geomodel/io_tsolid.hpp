@@ -55,57 +55,59 @@ namespace
         void save(
             const GeoModel3D& geomodel, const std::string& filename ) final
         {
-            ringmesh_assert( !out_.is_open() );
-            out_.open( filename.c_str() );
-            ringmesh_assert( out_.is_open() );
-            out_.precision( 16 );
+            ringmesh_assert( !out_ );
+            out_.reset( new BufferedTextWriter( filename, 16 ) );
 
             fill_top_header( geomodel );
-
-            const GeoModelMesh3D& mesh = geomodel.mesh;
-            // mesh.set_duplicate_mode( GeoModelMeshCells::ALL ) ;
-
             fill_vertex_attribute_header( geomodel );
             fill_cell_attribute_header( geomodel );
+            initialize_surface_points( geomodel );
 
-            vertex_exported_.resize( mesh.vertices.nb(), false );
-            atom_exported_.resize( mesh.cells.nb_duplicated_vertices(), false );
-            vertex_exported_id_.resize( mesh.vertices.nb(), NO_ID );
-            atom_exported_id_.resize(
-                mesh.cells.nb_duplicated_vertices(), NO_ID );
-            for( index_t r = 0; r < geomodel.nb_regions(); r++ )
+            for( const auto& region : geomodel.regions() )
             {
-                const auto& region = geomodel.region( r );
                 export_one_region( region );
             }
 
             export_model( geomodel );
             export_model_region( geomodel );
 
-            out_ << "END" << std::endl;
+            *out_ << "END" << EOL;
+            out_.reset();
+            surface_vertex_ptr_.clear();
+            surface_point_ids_.clear();
+            surface_points_.reset();
+            shared_vertex_ids_.clear();
+            nb_vertices_exported_ = 1;
         }
 
     private:
-        const GeoModelMesh3D& geomodel_mesh( const Region3D& region ) const
+        /// Sorted Surface points of a cell facet or a polygon,
+        /// completed with NO_ID
+        using FacetKey = std::array< index_t, 4 >;
+
+        /// Polygon of a Surface bounding the exported region
+        struct SurfaceFacet
         {
-            return region.geomodel().mesh;
-        }
+            index_t surface;
+            vec3 normal;
+        };
+
         void fill_top_header( const GeoModel3D& geomodel )
         {
-            ringmesh_assert( out_.is_open() );
+            ringmesh_assert( out_ );
             // Print Model3d headers
-            out_ << "GOCAD TSolid 1" << EOL << "HEADER {" << EOL
-                 << "name:" << geomodel.name() << EOL << "}" << EOL;
-
-            out_ << "GOCAD_ORIGINAL_COORDINATE_SYSTEM" << EOL << "NAME Default"
-                 << EOL << "AXIS_NAME \"X\" \"Y\" \"Z\"" << EOL
-                 << "AXIS_UNIT \"m\" \"m\" \"m\"" << EOL
-                 << "ZPOSITIVE Elevation" << EOL
-                 << "END_ORIGINAL_COORDINATE_SYSTEM" << EOL;
+            *out_ << "GOCAD TSolid 1" << EOL << "HEADER {" << EOL
+                  << "name:" << geomodel.name() << EOL << "}" << EOL;
+
+            *out_ << "GOCAD_ORIGINAL_COORDINATE_SYSTEM" << EOL << "NAME Default"
+                  << EOL << "AXIS_NAME \"X\" \"Y\" \"Z\"" << EOL
+                  << "AXIS_UNIT \"m\" \"m\" \"m\"" << EOL
+                  << "ZPOSITIVE Elevation" << EOL
+                  << "END_ORIGINAL_COORDINATE_SYSTEM" << EOL;
         }
         void fill_vertex_attribute_header( const GeoModel3D& geomodel )
         {
-            ringmesh_assert( out_.is_open() );
+            ringmesh_assert( out_ );
             std::vector< bool > is_integer_like_attribute;
             for( index_t reg_i = 0; reg_i < geomodel.nb_regions(); ++reg_i )
             {
@@ -162,92 +164,93 @@ namespace
             if( !numeric_like_vertex_attribute_names_.empty() )
             {
                 ringmesh_assert( nb_numeric_like_vertex_attribute_names > 0 );
-                out_ << "PROPERTIES";
+                *out_ << "PROPERTIES";
                 for( const std::string& cur_num_like_v_att_name :
                     numeric_like_vertex_attribute_names_ )
                 {
-                    out_ << " " << cur_num_like_v_att_name;
+                    *out_ << " " << cur_num_like_v_att_name;
                 }
-                out_ << EOL;
-                out_ << "PROP_LEGAL_RANGES";
+                *out_ << EOL;
+                *out_ << "PROP_LEGAL_RANGES";
                 for( auto i : range( nb_numeric_like_vertex_attribute_names ) )
                 {
                     ringmesh_unused( i );
-                    out_ << " **none**  **none**";
-                }
-                out_ << EOL;
-                out_ << "NO_DATA_VALUES";
-                write_no_data_value( nb_numeric_like_vertex_attribute_names );
-                out_ << EOL;
-                out_ << "READ_ONLY";
+                    *out_ << " **none**  **none**";
+                }
+                *out_ << EOL;
+                *out_ << "NO_DATA_VALUES";
+                write_no_data_value(
+                    *out_, nb_numeric_like_vertex_attribute_names );
+                *out_ << EOL;
+                *out_ << "READ_ONLY";
                 for( auto i : range( nb_numeric_like_vertex_attribute_names ) )
                 {
                     ringmesh_unused( i );
-                    out_ << " 1";
+                    *out_ << " 1";
                 }
-                out_ << EOL;
-                out_ << "PROPERTY_CLASSES";
+                *out_ << EOL;
+                *out_ << "PROPERTY_CLASSES";
                 for( const std::string& cur_num_like_v_att_name :
                     numeric_like_vertex_attribute_names_ )
                 {
-                    out_ << " " << cur_num_like_v_att_name;
+                    *out_ << " " << cur_num_like_v_att_name;
                 }
-                out_ << EOL;
-                out_ << "PROPERTY_KINDS";
+                *out_ << EOL;
+                *out_ << "PROPERTY_KINDS";
                 for( auto i : range( nb_numeric_like_vertex_attribute_names ) )
                 {
                     if( is_integer_like_attribute[i] )
                     {
-                        out_ << " \"Number\"";
+                        *out_ << " \"Number\"";
                     }
                     else
                     {
-                        out_ << " \"Real Number\"";
+                        *out_ << " \"Real Number\"";
                     }
                 }
-                out_ << EOL;
-                out_ << "PROPERTY_SUBCLASSES";
+                *out_ << EOL;
+                *out_ << "PROPERTY_SUBCLASSES";
                 for( auto i : range( nb_numeric_like_vertex_attribute_names ) )
                 {
                     ringmesh_unused( i );
-                    out_ << " QUANTITY Float";
+                    *out_ << " QUANTITY Float";
                 }
-                out_ << EOL;
-                out_ << "ESIZES";
+                *out_ << EOL;
+                *out_ << "ESIZES";
                 for( const auto& cur_v_att_dim : vertex_attribute_dimensions_ )
                 {
-                    out_ << " " << GEO::String::to_string( cur_v_att_dim );
+                    *out_ << " " << GEO::String::to_string( cur_v_att_dim );
                 }
-                out_ << EOL;
-                out_ << "UNITS";
+                *out_ << EOL;
+                *out_ << "UNITS";
                 for( auto i : range( nb_numeric_like_vertex_attribute_names ) )
                 {
                     ringmesh_unused( i );
-                    out_ << " unitless";
+                    *out_ << " unitless";
                 }
-                out_ << EOL;
+                *out_ << EOL;
                 for( auto i : range( nb_numeric_like_vertex_attribute_names ) )
                 {
-                    out_ << "PROPERTY_CLASS_HEADER "
-                         << numeric_like_vertex_attribute_names_[i] << " {"
-                         << EOL;
+                    *out_ << "PROPERTY_CLASS_HEADER "
+                          << numeric_like_vertex_attribute_names_[i] << " {"
+                          << EOL;
                     if( is_integer_like_attribute[i] )
                     {
-                        out_ << "kind: Number" << EOL;
+                        *out_ << "kind: Number" << EOL;
                     }
                     else
                     {
-                        out_ << "kind: Real Number" << EOL;
+                        *out_ << "kind: Real Number" << EOL;
                     }
-                    out_ << "unit: unitless" << EOL;
-                    out_ << "}" << EOL;
+                    *out_ << "unit: unitless" << EOL;
+                    *out_ << "}" << EOL;
                 }
             }
         }
 
         void fill_cell_attribute_header( const GeoModel3D& geomodel )
         {
-            ringmesh_assert( out_.is_open() );
+            ringmesh_assert( out_ );
             std::vector< bool > is_integer_like_attribute;
             for( const auto& cur_reg : region_range< 3 >( geomodel ) )
             {
@@ -295,461 +298,426 @@ namespace
                     numeric_like_cell_attribute_names_.size() );
             if( !numeric_like_cell_attribute_names_.empty() )
             {
-                out_ << "TETRA_PROPERTIES";
+                *out_ << "TETRA_PROPERTIES";
                 for( const auto& cur_num_like_c_att_name :
                     numeric_like_cell_attribute_names_ )
                 {
-                    out_ << " " << cur_num_like_c_att_name;
+                    *out_ << " " << cur_num_like_c_att_name;
                 }
-                out_ << EOL;
-                out_ << "TETRA_PROP_LEGAL_RANGES";
+                *out_ << EOL;
+                *out_ << "TETRA_PROP_LEGAL_RANGES";
                 for( auto i : range( nb_numeric_like_cell_attribute_names ) )
                 {
                     ringmesh_unused( i );
-                    out_ << " **none**  **none**";
-                }
-                out_ << EOL;
-                out_ << "TETRA_NO_DATA_VALUES";
-                write_no_data_value( nb_numeric_like_cell_attribute_names );
-                out_ << EOL;
-                out_ << "READ_ONLY";
+                    *out_ << " **none**  **none**";
+                }
+                *out_ << EOL;
+                *out_ << "TETRA_NO_DATA_VALUES";
+                write_no_data_value(
+                    *out_, nb_numeric_like_cell_attribute_names );
+                *out_ << EOL;
+                *out_ << "READ_ONLY";
                 for( auto i : range( nb_numeric_like_cell_attribute_names ) )
                 {
                     ringmesh_unused( i );
-                    out_ << " 1";
+                    *out_ << " 1";
                 }
-                out_ << EOL;
-                out_ << "TETRA_PROPERTY_CLASSES";
+                *out_ << EOL;
+                *out_ << "TETRA_PROPERTY_CLASSES";
                 for( const auto& cur_num_like_c_att_name :
                     numeric_like_cell_attribute_names_ )
                 {
-                    out_ << " " << cur_num_like_c_att_name;
+                    *out_ << " " << cur_num_like_c_att_name;
                 }
-                out_ << EOL;
-                out_ << "TETRA_PROPERTY_KINDS";
+                *out_ << EOL;
+                *out_ << "TETRA_PROPERTY_KINDS";
                 for( auto i : range( nb_numeric_like_cell_attribute_names ) )
                 {
                     if( is_integer_like_attribute[i] )
                     {
-                        out_ << " \"Number\"";
+                        *out_ << " \"Number\"";
                     }
                     else
                     {
-                        out_ << " \"Real Number\"";
+                        *out_ << " \"Real Number\"";
                     }
                 }
-                out_ << EOL;
-                out_ << "TETRA_PROPERTY_SUBCLASSES";
+                *out_ << EOL;
+                *out_ << "TETRA_PROPERTY_SUBCLASSES";
                 for( auto i : range( nb_numeric_like_cell_attribute_names ) )
                 {
                     ringmesh_unused( i );
-                    out_ << " QUANTITY Float";
+                    *out_ << " QUANTITY Float";
                 }
-                out_ << EOL;
-                out_ << "TETRA_ESIZES";
+                *out_ << EOL;
+                *out_ << "TETRA_ESIZES";
                 for( const auto& cur_cell_attr_dim :
                     cell_attribute_dimensions_ )
                 {
-                    out_ << " " << std::to_string( cur_cell_attr_dim );
+                    *out_ << " " << std::to_string( cur_cell_attr_dim );
                 }
-                out_ << EOL;
-                out_ << "TETRA_UNITS";
+                *out_ << EOL;
+                *out_ << "TETRA_UNITS";
                 for( auto i : range( nb_numeric_like_cell_attribute_names ) )
                 {
                     ringmesh_unused( i );
-                    out_ << " unitless";
+                    *out_ << " unitless";
                 }
-                out_ << EOL;
+                *out_ << EOL;
                 for( auto i : range( nb_numeric_like_cell_attribute_names ) )
                 {
-                    out_ << "TETRA_PROPERTY_CLASS_HEADER "
-                         << numeric_like_cell_attribute_names_[i] << " {"
-                         << EOL;
+                    *out_ << "TETRA_PROPERTY_CLASS_HEADER "
+                          << numeric_like_cell_attribute_names_[i] << " {"
+                          << EOL;
                     if( is_integer_like_attribute[i] )
                     {
-                        out_ << "kind: Number" << EOL;
+                        *out_ << "kind: Number" << EOL;
                     }
                     else
                     {
-                        out_ << "kind: Real Number" << EOL;
+                        *out_ << "kind: Real Number" << EOL;
                     }
-                    out_ << "unit: unitless" << EOL;
-                    out_ << "}" << EOL;
+                    *out_ << "unit: unitless" << EOL;
+                    *out_ << "}" << EOL;
                 }
             }
         }
 
-        void export_one_region( const Region3D& region )
-        {
-            ringmesh_assert( out_.is_open() );
-            out_ << "TVOLUME " << region.name() << EOL;
-            export_region_vertices( region );
-            export_tetrahedra( region );
-        }
-
-        void export_region_vertices( const Region3D& region )
+        /*!
+         * @brief Identifies the Surface vertices
+         * @details Colocated Surface vertices get the same point id. Only
+         * the Region vertices on a Surface can be shared with other
+         * entities, so they are the only ones identified in the whole
+         * geomodel.
+         */
+        void initialize_surface_points( const GeoModel3D& geomodel )
         {
-            // Export not duplicated vertices
-            for( auto c : range( region.nb_mesh_elements() ) )
+            surface_vertex_ptr_.assign( geomodel.nb_surfaces() + 1, 0 );
+            for( const auto& surface : geomodel.surfaces() )
             {
-                export_region_cell_vertices( region, c );
+                surface_vertex_ptr_[surface.index() + 1] =
+                    surface_vertex_ptr_[surface.index()]
+                    + surface.nb_vertices();
             }
-        }
-
-        void export_region_cell_vertices( const Region3D& region, index_t c )
-        {
-            const auto& mesh = geomodel_mesh( region );
-            auto cell = mesh.cells.cell( region.gmme().index(), c );
-            auto cell_center = mesh.cells.barycenter( cell );
-            for( auto v : range( mesh.cells.nb_vertices( cell ) ) )
+            std::vector< vec3 > points;
+            points.reserve( surface_vertex_ptr_.back() );
+            for( const auto& surface : geomodel.surfaces() )
+            {
+                for( auto v : range( surface.nb_vertices() ) )
+                {
+                    points.push_back( surface.vertex( v ) );
+                }
+            }
+            if( points.empty() )
             {
-                export_region_cell_vertex( region, cell, v, cell_center );
+                return;
             }
+            std::vector< vec3 > unique_points;
+            std::tie( std::ignore, surface_point_ids_, unique_points ) =
+                NNSearch3D( points, false )
+                    .get_colocated_index_mapping_and_unique_points(
+                        geomodel.epsilon() );
+            surface_points_.reset( new NNSearch3D( unique_points ) );
+            shared_vertex_ids_.assign( unique_points.size(), NO_ID );
         }
 
-        void export_region_cell_vertex( const Region3D& region,
-            index_t cell,
-            index_t v,
-            const vec3& cell_center )
+        /*!
+         * @brief Exports the vertices and the tetrahedra of a region
+         * @details Vertices are numbered in the order the region cells use
+         * them. Only the numbers of the vertices on the Surfaces are kept
+         * once the region is written, so the memory needed depends on the
+         * largest region and on the Surfaces, not on the whole geomodel.
+         */
+        void export_one_region( const Region3D& region )
         {
-            ringmesh_assert( out_.is_open() );
-            const auto& mesh = geomodel_mesh( region );
-            auto atom_id = mesh.cells.duplicated_corner_index( { cell, v } );
-            if( atom_id == NO_ID )
-            {
-                auto vertex_id = mesh.cells.vertex( { cell, v } );
-                if( vertex_exported_[vertex_id] )
-                    return;
-                vertex_exported_[vertex_id] = true;
-                vertex_exported_id_[vertex_id] = nb_vertices_exported_;
-                // PVRTX keyword must be used instead of VRTX keyword because
-                // properties are not read by Gocad if it is VRTX keyword.
-                out_ << "PVRTX " << nb_vertices_exported_++ << " "
-                     << mesh.vertices.vertex( vertex_id );
-
-                /// Export of vertex attributes
-                export_region_cell_vertex_attributes(
-                    region, vertex_id, cell_center );
-                out_ << EOL;
-            }
+            ringmesh_assert( out_ );
+            *out_ << "TVOLUME " << region.name() << EOL;
+            const auto point_ids = region_surface_point_ids( region );
+            std::vector< index_t > vertex_ids( region.nb_vertices(), NO_ID );
+            export_region_vertices( region, point_ids, vertex_ids );
+            export_tetrahedra( region, point_ids, vertex_ids );
         }
 
-        void export_region_cell_vertex_attributes(
-            const Region3D& region, index_t vertex_id, const vec3& cell_center )
+        /*!
+         * Gets the Surface point of each Region vertex, NO_ID for the
+         * vertices inside the Region
+         */
+        std::vector< index_t > region_surface_point_ids(
+            const Region3D& region ) const
         {
-            ringmesh_assert( out_.is_open() );
-            auto& reg_vertex_attr_mgr = region.vertex_attribute_manager();
-            auto vertex_id_in_reg =
-                find_gmm_cell_in_gm_region( region, vertex_id, cell_center );
-            ringmesh_assert( vertex_id_in_reg != NO_ID );
-
-            for( auto attr_dbl_itr : range( static_cast< index_t >(
-                     numeric_like_vertex_attribute_names_.size() ) ) )
+            std::vector< index_t > point_ids( region.nb_vertices(), NO_ID );
+            if( !surface_points_ )
             {
-                if( reg_vertex_attr_mgr.is_defined(
-                        numeric_like_vertex_attribute_names_[attr_dbl_itr] ) )
-                {
-                    ringmesh_assert(
-                        reg_vertex_attr_mgr.find_attribute_store(
-                            numeric_like_vertex_attribute_names_[attr_dbl_itr] )
-                        != nullptr );
-                    ringmesh_assert(
-                        reg_vertex_attr_mgr
-                            .find_attribute_store(
-                                numeric_like_vertex_attribute_names_
-                                    [attr_dbl_itr] )
-                            ->dimension()
-                        == vertex_attribute_dimensions_[attr_dbl_itr] );
-                    ringmesh_assert(
-                        GEO::ReadOnlyScalarAttributeAdapter::can_be_bound_to(
-                            reg_vertex_attr_mgr.find_attribute_store(
-                                numeric_like_vertex_attribute_names_
-                                    [attr_dbl_itr] ) ) );
-                    GEO::ReadOnlyScalarAttributeAdapter cur_attr(
-                        reg_vertex_attr_mgr,
-                        numeric_like_vertex_attribute_names_[attr_dbl_itr] );
-                    for( auto dim_itr :
-                        range( vertex_attribute_dimensions_[attr_dbl_itr] ) )
+                return point_ids;
+            }
+            const auto epsilon = region.geomodel().epsilon();
+            parallel_for( region.nb_vertices(),
+                [&region, &point_ids, epsilon, this]( index_t v ) {
+                    auto points = surface_points_->get_neighbors(
+                        region.vertex( v ), epsilon );
+                    if( !points.empty() )
                     {
-                        out_ << " "
-                             << cur_attr[vertex_id_in_reg
-                                             * vertex_attribute_dimensions_
-                                                   [attr_dbl_itr]
-                                         + dim_itr];
+                        point_ids[v] = points.front();
                     }
-                }
-                else
-                {
-                    write_no_data_value(
-                        vertex_attribute_dimensions_[attr_dbl_itr] );
-                }
-            }
+                } );
+            return point_ids;
         }
 
-        index_t find_gmm_cell_in_gm_region( const Region3D& region,
-            index_t vertex_id,
-            const vec3& cell_center ) const
+        void export_region_vertices( const Region3D& region,
+            const std::vector< index_t >& point_ids,
+            std::vector< index_t >& vertex_ids )
         {
-            const auto& mesh = geomodel_mesh( region );
-            /// As we export the non duplicated vertices,
-            /// gme_vertices should be at size 1 (to check),
-            /// so the loop should not be needed but I [BC]
-            /// keep it for now since duplicated nodes is not
-            /// operational yet...
-            const auto& gme_vertices = mesh.vertices.gme_vertices( vertex_id );
-            for( const auto& cur_gme_vertex : gme_vertices )
+            ringmesh_assert( out_ );
+            const auto attributes =
+                bind_attributes( region.vertex_attribute_manager(),
+                    numeric_like_vertex_attribute_names_ );
+            for( auto c : range( region.nb_mesh_elements() ) )
             {
-                if( cur_gme_vertex.gmme != region.gmme() )
+                for( auto v : range( region.nb_mesh_element_vertices( c ) ) )
                 {
-                    continue;
-                }
-                auto cells_around_vertex =
-                    region.cells_around_vertex( cur_gme_vertex.v_index, NO_ID );
-                /// WARNING: the cell id in the region corresponding
-                /// to the cell id in the GMM "cell" is not the
-                /// variable "c" (in the for loop over the region cells).
-                for( const auto& cur_cell_around_vertex : cells_around_vertex )
-                {
-                    auto center = region.mesh_element_barycenter(
-                        cur_cell_around_vertex );
-                    if( ( center - cell_center ).length()
-                        < region.geomodel().epsilon() )
+                    auto region_vertex =
+                        region.mesh_element_vertex_index( { c, v } );
+                    if( vertex_ids[region_vertex] != NO_ID )
+                    {
+                        continue;
+                    }
+                    vertex_ids[region_vertex] = nb_vertices_exported_;
+                    auto point = region.vertex( region_vertex );
+                    auto point_id = point_ids[region_vertex];
+                    if( point_id != NO_ID )
                     {
-                        return cur_gme_vertex.v_index;
+                        // The vertex may have been exported with another
+                        // region or another vertex of this region
+                        auto& shared_id = shared_vertex_ids_[point_id];
+                        if( shared_id != NO_ID )
+                        {
+                            vertex_ids[region_vertex] = shared_id;
+                            continue;
+                        }
+                        shared_id = nb_vertices_exported_;
+                        point = surface_points_->point( point_id );
                     }
+                    // PVRTX keyword must be used instead of VRTX keyword
+                    // because properties are not read by Gocad if it is
+                    // VRTX keyword.
+                    *out_ << "PVRTX " << nb_vertices_exported_++ << " "
+                          << point;
+                    write_attributes( *out_, attributes,
+                        vertex_attribute_dimensions_, region_vertex );
+                    *out_ << EOL;
                 }
             }
-            ringmesh_assert_not_reached;
-            return NO_ID;
-        }
-
-        void export_tetrahedra( const Region3D& region )
-        {
-            // Export duplicated vertices
-            export_duplicated_vertices();
-
-            // Mark if a boundary is ending in the region
-            mark_boundary_ending_in_region( region );
-
-            const auto& mesh = geomodel_mesh( region );
-            for( auto c : range( region.nb_mesh_elements() ) )
-            {
-                out_ << "TETRA";
-                auto cell = mesh.cells.cell( region.gmme().index(), c );
-                export_tetra( region, cell );
-                out_ << EOL;
-                out_ << "# CTETRA " << region.name();
-                export_ctetra( region, c );
-                out_ << EOL;
-            }
         }
 
-        void export_duplicated_vertices() const
+        void export_tetrahedra( const Region3D& region,
+            const std::vector< index_t >& point_ids,
+            const std::vector< index_t >& vertex_ids )
         {
-            /*for( index_t c = 0; c < region.nb_mesh_elements(); c++ ) {
-             index_t cell = mesh.cells.cell( r, c ) ;
-             for( index_t v = 0; v < mesh.cells.nb_vertices( cell ); v++ ) {
-             index_t atom_id ;
-             if( mesh.cells.is_corner_duplicated( cell, v, atom_id ) ) {
-             if( atom_exported[atom_id] ) continue ;
-             atom_exported[atom_id] = true ;
-             atom_exported_id[atom_id] = nb_vertices_exported ;
-             index_t vertex_id = mesh.cells.vertex( cell, v ) ;
-             out << "ATOM " << nb_vertices_exported++ << " "
-             << vertex_exported_id[vertex_id] << EOL ;
-             }
-             }
-             }*/
+            ringmesh_assert( out_ );
+            const auto facets = region_surface_facets( region );
+            const auto attributes =
+                bind_attributes( region.cell_attribute_manager(),
+                    numeric_like_cell_attribute_names_ );
+            out_->write_parallel( region.nb_mesh_elements(),
+                [&region, &point_ids, &vertex_ids, &facets, &attributes,
+                    this]( TextBuffer& buffer, index_t c ) {
+                    buffer << "TETRA";
+                    for( auto v :
+                        range( region.nb_mesh_element_vertices( c ) ) )
+                    {
+                        buffer << " "
+                               << vertex_ids[region.mesh_element_vertex_index(
+                                      { c, v } )];
+                    }
+                    write_attributes(
+                        buffer, attributes, cell_attribute_dimensions_, c );
+                    buffer << EOL << "# CTETRA " << region.name();
+                    export_ctetra( buffer, region, c, point_ids, facets );
+                    buffer << EOL;
+                } );
         }
 
-        /// TODO it seems that this code is not used for export since no
-        /// writtings
-        /// in out ofstream.
-        void mark_boundary_ending_in_region( const Region3D& region )
+        /*!
+         * Gets the polygons of the surfaces bounding a region,
+         * identified by their Surface points
+         */
+        std::map< FacetKey, SurfaceFacet > region_surface_facets(
+            const Region3D& region ) const
         {
-            std::map< index_t, index_t > sides;
-            for( auto s : range( region.nb_boundaries() ) )
+            const auto& geomodel = region.geomodel();
+            std::map< FacetKey, SurfaceFacet > facets;
+            for( auto b : range( region.nb_boundaries() ) )
             {
-                if( sides.count( region.boundary_gmme( s ).index() ) > 0 )
+                const auto& surface =
+                    geomodel.surface( region.boundary_gmme( b ).index() );
+                for( auto p : range( surface.nb_mesh_elements() ) )
                 {
-                    // a surface is encountered twice, it is ending in the
-                    // region
-                    sides[region.boundary_gmme( s ).index()] = 2;
-                }
-                else
-                {
-                    sides[region.boundary_gmme( s ).index()] = region.side( s );
+                    auto nb_vertices = surface.nb_mesh_element_vertices( p );
+                    if( nb_vertices > FacetKey().size() )
+                    {
+                        // Cannot be colocated with a cell facet
+                        continue;
+                    }
+                    FacetKey key;
+                    key.fill( NO_ID );
+                    for( auto v : range( nb_vertices ) )
+                    {
+                        key[v] = surface_point_ids_
+                            [surface_vertex_ptr_[surface.index()]
+                                + surface.mesh_element_vertex_index(
+                                      { p, v } )];
+                    }
+                    std::sort( key.begin(), key.begin() + nb_vertices );
+                    facets.emplace( key,
+                        SurfaceFacet{ surface.index(),
+                            surface.mesh().polygon_normal( p ) } );
                 }
             }
+            return facets;
         }
 
-        void export_tetra( const Region3D& region, index_t cell )
+        void export_ctetra( TextBuffer& buffer,
+            const Region3D& region,
+            index_t c,
+            const std::vector< index_t >& point_ids,
+            const std::map< FacetKey, SurfaceFacet >& facets ) const
         {
-            export_tetra_coordinates( region, cell );
-            /// Export cell attributes
-            export_tetra_attributes( region, cell );
-        }
-
-        void export_tetra_coordinates( const Region3D& region, index_t cell )
-        {
-            ringmesh_assert( out_.is_open() );
-            const auto& mesh = geomodel_mesh( region );
-            for( auto v :
-                range( region.geomodel().mesh.cells.nb_vertices( cell ) ) )
+            const auto& geomodel = region.geomodel();
+            for( auto f : range( region.nb_cell_facets( c ) ) )
             {
-                auto atom_id =
-                    mesh.cells.duplicated_corner_index( { cell, v } );
-                if( atom_id == NO_ID )
+                buffer << " ";
+                auto nb_vertices = region.nb_cell_facet_vertices( c, f );
+                FacetKey key;
+                key.fill( NO_ID );
+                for( auto v : range( nb_vertices ) )
                 {
-                    auto vertex_id = mesh.cells.vertex( { cell, v } );
-                    out_ << " " << vertex_exported_id_[vertex_id];
+                    key[v] = point_ids[region.cell_facet_vertex_index(
+                        c, f, v )];
                 }
-                else
+                std::sort( key.begin(), key.begin() + nb_vertices );
+                auto facet = facets.find( key );
+                if( facet == facets.end() )
                 {
-                    out_ << " " << atom_exported_id_[atom_id];
+                    buffer << "none";
+                    continue;
                 }
+                auto side = dot( facet->second.normal,
+                                region.mesh().cell_facet_normal( { c, f } ) )
+                            > 0;
+                buffer << ( side ? "+" : "-" )
+                       << geomodel.surface( facet->second.surface )
+                              .parent( 0 )
+                              .name();
             }
         }
 
-        void export_tetra_attributes( const Region3D& region, index_t cell )
+        using AttributeAdapters = std::vector<
+            std::unique_ptr< GEO::ReadOnlyScalarAttributeAdapter > >;
+
+        /*!
+         * Binds the given attributes if they are defined, once for all
+         * the elements of an entity
+         */
+        AttributeAdapters bind_attributes( GEO::AttributesManager& manager,
+            const std::vector< std::string >& names ) const
         {
-            ringmesh_assert( out_.is_open() );
-            auto& reg_cell_attr_mgr = region.cell_attribute_manager();
-            const auto& mesh = geomodel_mesh( region );
-            auto center = mesh.cells.barycenter( cell );
-            const auto c_in_reg = region.cell_nn_search().get_neighbors(
-                center, region.geomodel().epsilon() );
-            ringmesh_assert( c_in_reg.size() == 1 );
-            for( auto attr_dbl_itr :
-                range( numeric_like_cell_attribute_names_.size() ) )
+            AttributeAdapters adapters( names.size() );
+            for( auto i : range( names.size() ) )
             {
-                if( reg_cell_attr_mgr.is_defined(
-                        numeric_like_cell_attribute_names_[attr_dbl_itr] ) )
+                if( manager.is_defined( names[i] ) )
                 {
-                    ringmesh_assert(
-                        reg_cell_attr_mgr.find_attribute_store(
-                            numeric_like_cell_attribute_names_[attr_dbl_itr] )
-                        != nullptr );
-                    ringmesh_assert(
-                        reg_cell_attr_mgr
-                            .find_attribute_store(
-                                numeric_like_cell_attribute_names_
-                                    [attr_dbl_itr] )
-                            ->dimension()
-                        == cell_attribute_dimensions_[attr_dbl_itr] );
-                    ringmesh_assert(
-                        GEO::ReadOnlyScalarAttributeAdapter::can_be_bound_to(
-                            reg_cell_attr_mgr.find_attribute_store(
-                                numeric_like_cell_attribute_names_
-                                    [attr_dbl_itr] ) ) );
-                    GEO::ReadOnlyScalarAttributeAdapter cur_attr(
-                        reg_cell_attr_mgr,
-                        numeric_like_cell_attribute_names_[attr_dbl_itr] );
-                    for( auto dim_itr :
-                        range( cell_attribute_dimensions_[attr_dbl_itr] ) )
-                    {
-                        out_
-                            << " "
-                            << cur_attr[c_in_reg[0] * cell_attribute_dimensions_
-                                                          [attr_dbl_itr]
-                                        + dim_itr];
-                    }
-                }
-                else
-                {
-                    write_no_data_value(
-                        cell_attribute_dimensions_[attr_dbl_itr] );
+                    adapters[i].reset( new GEO::ReadOnlyScalarAttributeAdapter(
+                        manager, names[i] ) );
                 }
             }
+            return adapters;
         }
 
-        void export_ctetra( const Region3D& region, index_t c )
+        template < typename OUT >
+        void write_attributes( OUT& out,
+            const AttributeAdapters& adapters,
+            const std::vector< index_t >& dimensions,
+            index_t element ) const
         {
-            ringmesh_assert( out_.is_open() );
-            const auto& mesh = geomodel_mesh( region );
-            for( auto f : range( mesh.cells.nb_facets( c ) ) )
+            for( auto i : range( adapters.size() ) )
             {
-                out_ << " ";
-                index_t polygon{ NO_ID };
-                bool side;
-                if( mesh.cells.is_cell_facet_on_surface( c, f, polygon, side ) )
+                if( !adapters[i] )
                 {
-                    index_t surface_id{ mesh.polygons.surface( polygon ) };
-                    side ? out_ << "+" : out_ << "-";
-                    out_ << region.geomodel()
-                                .surface( surface_id )
-                                .parent( 0 )
-                                .name();
+                    write_no_data_value( out, dimensions[i] );
+                    continue;
                 }
-                else
+                for( auto d : range( dimensions[i] ) )
                 {
-                    out_ << "none";
+                    out << " " << ( *adapters[i] )[element * dimensions[i] + d];
                 }
             }
         }
 
         void export_model( const GeoModel3D& geomodel )
         {
-            ringmesh_assert( out_.is_open() );
-            out_ << "MODEL" << EOL;
+            ringmesh_assert( out_ );
+            *out_ << "MODEL" << EOL;
             int tface_count = 1;
 
-            const auto& polygons = geomodel.mesh.polygons;
             for( auto& cur_interface :
                 geomodel.geol_entities( Interface3D::type_name_static() ) )
             {
-                out_ << "SURFACE " << cur_interface.name() << EOL;
+                *out_ << "SURFACE " << cur_interface.name() << EOL;
                 for( auto s : range( cur_interface.nb_children() ) )
                 {
-                    out_ << "TFACE " << tface_count++ << EOL;
-                    auto surface_id = cur_interface.child_gmme( s ).index();
-                    out_ << "KEYVERTICES";
-                    auto key_polygon_id = polygons.polygon( surface_id, 0 );
-                    for( auto v :
-                        range( polygons.nb_vertices( key_polygon_id ) ) )
+                    *out_ << "TFACE " << tface_count++ << EOL;
+                    const auto& surface = geomodel.surface(
+                        cur_interface.child_gmme( s ).index() );
+                    *out_ << "KEYVERTICES";
+                    export_polygon_vertices( surface, 0 );
+                    *out_ << EOL;
+                    for( auto p : range( surface.nb_mesh_elements() ) )
                     {
-                        out_ << " " << vertex_exported_id_[polygons.vertex(
-                                           { key_polygon_id, v } )];
-                    }
-                    out_ << EOL;
-                    for( auto p : range( polygons.nb_polygons( surface_id ) ) )
-                    {
-                        auto polygon_id = polygons.polygon( surface_id, p );
-                        out_ << "TRGL";
-                        for( auto v :
-                            range( polygons.nb_vertices( polygon_id ) ) )
-                        {
-                            out_ << " " << vertex_exported_id_[polygons.vertex(
-                                               { polygon_id, v } )];
-                        }
-                        out_ << EOL;
+                        *out_ << "TRGL";
+                        export_polygon_vertices( surface, p );
+                        *out_ << EOL;
                     }
                 }
             }
         }
+
+        void export_polygon_vertices( const Surface3D& surface, index_t p )
+        {
+            ringmesh_assert( out_ );
+            const auto first_vertex = surface_vertex_ptr_[surface.index()];
+            for( auto v : range( surface.nb_mesh_element_vertices( p ) ) )
+            {
+                auto point_id = surface_point_ids_[first_vertex
+                                    + surface.mesh_element_vertex_index(
+                                          { p, v } )];
+                *out_ << " " << shared_vertex_ids_[point_id];
+            }
+        }
+
         void export_model_region( const GeoModel3D& geomodel )
         {
-            ringmesh_assert( out_.is_open() );
+            ringmesh_assert( out_ );
             for( auto& region : geomodel.regions() )
             {
-                out_ << "MODEL_REGION " << region.name() << " ";
-                region.side( 0 ) ? out_ << "+" : out_ << "-";
-                out_ << region.boundary_gmme( 0 ).index() + 1 << EOL;
+                *out_ << "MODEL_REGION " << region.name() << " ";
+                *out_ << ( region.side( 0 ) ? "+" : "-" );
+                *out_ << region.boundary_gmme( 0 ).index() + 1 << EOL;
             }
         }
 
-        void write_no_data_value( index_t nb )
+        template < typename OUT >
+        void write_no_data_value( OUT& out, index_t nb ) const
         {
             for( auto i : range( nb ) )
             {
                 ringmesh_unused( i );
-                out_ << " " << GEO::String::to_string( gocad_no_data_value_ );
+                out << " " << GEO::String::to_string( gocad_no_data_value_ );
             }
         }
 
     private:
         /// Attributes for save
-        std::ofstream out_;
+        std::unique_ptr< BufferedTextWriter > out_;
         /// numeric_like_vertex_attribute_names_ and
         /// numeric_like_cell_attribute_names_ contain all the
         /// attribute names found the regions which can be used with
@@ -762,10 +730,15 @@ namespace
         std::vector< index_t > vertex_attribute_dimensions_;
         std::vector< std::string > numeric_like_cell_attribute_names_;
         std::vector< index_t > cell_attribute_dimensions_;
-        std::vector< bool > vertex_exported_;
-        std::vector< bool > atom_exported_;
-        std::vector< index_t > vertex_exported_id_;
-        std::vector< index_t > atom_exported_id_;
+        /// Index of the first vertex of each Surface in surface_point_ids_
+        std::vector< index_t > surface_vertex_ptr_;
+        /// Point id of each Surface vertex, colocated vertices share it
+        std::vector< index_t > surface_point_ids_;
+        /// Search structure of the Surface points
+        std::unique_ptr< NNSearch3D > surface_points_;
+        /// Exported ids of the Surface points, the ids of the vertices
+        /// inside a region are only kept during the export of the region
+        std::vector< index_t > shared_vertex_ids_;
         index_t nb_vertices_exported_{ 1 };
 
         /// Classical Gocad NoDataValue
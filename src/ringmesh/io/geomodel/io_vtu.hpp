@@ -0,0 +1,536 @@
+/*
+ * Copyright (c) 2012-2018, Association Scientifique pour la Geologie et ses
+ * Applications (ASGA). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of ASGA nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL ASGA BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *     http://www.ring-team.org
+ *
+ *     RING Project
+ *     Ecole Nationale Superieure de Geologie - GeoRessources
+ *     2 Rue du Doyen Marcel Roubault - TSA 70605
+ *     54518 VANDOEUVRE-LES-NANCY
+ *     FRANCE
+ */
+
+namespace
+{
+    /*!
+     * Size in bytes of the zlib blocks of a compressed data array
+     */
+    const std::size_t VTU_BLOCK_SIZE{ 1 << 20 };
+
+    /*!
+     * A data array of the VTU appended data section.
+     * Its raw bytes are either owned by the array or borrowed from
+     * a geogram attribute store. An array is identified by the XML section
+     * it is declared in (Points, Cells, PointData or CellData) and its name.
+     */
+    struct VTUDataArray
+    {
+        VTUDataArray( std::string array_section,
+            std::string array_name,
+            std::string vtk_type,
+            index_t components )
+            : section( std::move( array_section ) ),
+              name( std::move( array_name ) ),
+              type( std::move( vtk_type ) ),
+              nb_components( components )
+        {
+        }
+
+        index_t nb_blocks() const
+        {
+            return static_cast< index_t >(
+                ( nb_bytes + VTU_BLOCK_SIZE - 1 ) / VTU_BLOCK_SIZE );
+        }
+
+        std::size_t block_size( index_t block ) const
+        {
+            return std::min(
+                VTU_BLOCK_SIZE, nb_bytes - block * VTU_BLOCK_SIZE );
+        }
+
+        std::string section;
+        std::string name;
+        std::string type;
+        index_t nb_components{ 1 };
+        std::vector< char > owned_bytes;
+        const char* bytes{ nullptr };
+        std::size_t nb_bytes{ 0 };
+        std::vector< std::vector< Bytef > > compressed_blocks;
+        std::uint64_t offset{ 0 };
+    };
+
+    /*!
+     * Appended data section of a VTU file.
+     * Arrays are written either as raw binary blocks (UInt64 byte count
+     * followed by the bytes) or as zlib compressed blocks following the
+     * vtkZLibDataCompressor layout. Compression is done in parallel on
+     * the blocks of all the arrays.
+     */
+    class VTUAppendedData
+    {
+        ringmesh_disable_copy_and_move( VTUAppendedData );
+
+    public:
+        explicit VTUAppendedData( bool compressed ) : compressed_( compressed )
+        {
+        }
+
+        template < typename T >
+        T* create_array( const std::string& section,
+            const std::string& name,
+            const std::string& vtk_type,
+            index_t nb_components,
+            index_t nb_values )
+        {
+            auto& array = new_array( section, name, vtk_type, nb_components );
+            array.owned_bytes.resize( sizeof( T ) * nb_values );
+            array.bytes = array.owned_bytes.data();
+            array.nb_bytes = array.owned_bytes.size();
+            return reinterpret_cast< T* >( array.owned_bytes.data() );
+        }
+
+        void borrow_array( const std::string& section,
+            const std::string& name,
+            const std::string& vtk_type,
+            index_t nb_components,
+            const void* bytes,
+            std::size_t nb_bytes )
+        {
+            auto& array = new_array( section, name, vtk_type, nb_components );
+            array.bytes = static_cast< const char* >( bytes );
+            array.nb_bytes = nb_bytes;
+        }
+
+        bool compressed() const
+        {
+            return compressed_;
+        }
+
+        bool has_array(
+            const std::string& section, const std::string& name ) const
+        {
+            return lookup_array( section, name ) != nullptr;
+        }
+
+        void encode()
+        {
+            if( compressed_ )
+            {
+                compress_blocks();
+            }
+            std::uint64_t offset{ 0 };
+            for( auto& array : arrays_ )
+            {
+                array->offset = offset;
+                offset += encoded_size( *array );
+            }
+        }
+
+        void write_data_array( std::ostream& out,
+            const std::string& section,
+            const std::string& name ) const
+        {
+            const auto& array = find_array( section, name );
+            out << "<DataArray type=\"" << array.type << "\" Name=\""
+                << array.name << "\" NumberOfComponents=\""
+                << array.nb_components << "\" format=\"appended\" offset=\""
+                << array.offset << "\"/>" << EOL;
+        }
+
+        void write( std::ostream& out ) const
+        {
+            out << "<AppendedData encoding=\"raw\">" << EOL << "_";
+            for( const auto& array : arrays_ )
+            {
+                if( compressed_ )
+                {
+                    write_compressed_array( out, *array );
+                }
+                else
+                {
+                    write_raw_array( out, *array );
+                }
+            }
+            out << EOL << "</AppendedData>" << EOL;
+        }
+
+    private:
+        VTUDataArray& new_array( const std::string& section,
+            const std::string& name,
+            const std::string& vtk_type,
+            index_t nb_components )
+        {
+            if( has_array( section, name ) )
+            {
+                throw RINGMeshException( "I/O", "VTU data array ", name,
+                    " already exists in ", section );
+            }
+            arrays_.emplace_back(
+                new VTUDataArray( section, name, vtk_type, nb_components ) );
+            return *arrays_.back();
+        }
+
+        const VTUDataArray* lookup_array(
+            const std::string& section, const std::string& name ) const
+        {
+            for( const auto& array : arrays_ )
+            {
+                if( array->section == section && array->name == name )
+                {
+                    return array.get();
+                }
+            }
+            return nullptr;
+        }
+
+        const VTUDataArray& find_array(
+            const std::string& section, const std::string& name ) const
+        {
+            const auto* array = lookup_array( section, name );
+            if( array == nullptr )
+            {
+                throw RINGMeshException( "I/O", "No VTU data array named ",
+                    name, " in ", section );
+            }
+            return *array;
+        }
+
+        void compress_blocks()
+        {
+            std::vector< std::pair< VTUDataArray*, index_t > > blocks;
+            for( auto& array : arrays_ )
+            {
+                array->compressed_blocks.resize( array->nb_blocks() );
+                for( auto block : range( array->nb_blocks() ) )
+                {
+                    blocks.emplace_back( array.get(), block );
+                }
+            }
+            std::vector< int > status( blocks.size(), Z_OK );
+            parallel_for( static_cast< index_t >( blocks.size() ),
+                [&blocks, &status]( index_t b ) {
+                    auto& array = *blocks[b].first;
+                    auto block = blocks[b].second;
+                    auto source_size =
+                        static_cast< uLong >( array.block_size( block ) );
+                    auto& destination = array.compressed_blocks[block];
+                    auto destination_size = compressBound( source_size );
+                    destination.resize( destination_size );
+                    status[b] = compress2( destination.data(),
+                        &destination_size,
+                        reinterpret_cast< const Bytef* >(
+                            array.bytes + block * VTU_BLOCK_SIZE ),
+                        source_size, Z_DEFAULT_COMPRESSION );
+                    destination.resize( destination_size );
+                } );
+            for( auto b : range( blocks.size() ) )
+            {
+                if( status[b] != Z_OK )
+                {
+                    throw RINGMeshException( "I/O",
+                        "Failed to compress VTU data array ",
+                        blocks[b].first->name );
+                }
+            }
+        }
+
+        std::uint64_t encoded_size( const VTUDataArray& array ) const
+        {
+            if( !compressed_ )
+            {
+                return sizeof( std::uint64_t ) + array.nb_bytes;
+            }
+            std::uint64_t size{ sizeof( std::uint64_t )
+                                * ( 3 + array.compressed_blocks.size() ) };
+            for( const auto& block : array.compressed_blocks )
+            {
+                size += block.size();
+            }
+            return size;
+        }
+
+        void write_raw_array(
+            std::ostream& out, const VTUDataArray& array ) const
+        {
+            std::uint64_t nb_bytes{ array.nb_bytes };
+            write_header( out, &nb_bytes, 1 );
+            out.write( array.bytes,
+                static_cast< std::streamsize >( array.nb_bytes ) );
+        }
+
+        void write_compressed_array(
+            std::ostream& out, const VTUDataArray& array ) const
+        {
+            auto nb_blocks = array.nb_blocks();
+            std::vector< std::uint64_t > header( 3 + nb_blocks );
+            header[0] = nb_blocks;
+            header[1] = VTU_BLOCK_SIZE;
+            header[2] = nb_blocks == 0 ? 0 : array.block_size( nb_blocks - 1 );
+            for( auto block : range( nb_blocks ) )
+            {
+                header[3 + block] = array.compressed_blocks[block].size();
+            }
+            write_header( out, header.data(), header.size() );
+            for( const auto& block : array.compressed_blocks )
+            {
+                out.write( reinterpret_cast< const char* >( block.data() ),
+                    static_cast< std::streamsize >( block.size() ) );
+            }
+        }
+
+        void write_header( std::ostream& out,
+            const std::uint64_t* header,
+            std::size_t size ) const
+        {
+            out.write( reinterpret_cast< const char* >( header ),
+                static_cast< std::streamsize >(
+                    size * sizeof( std::uint64_t ) ) );
+        }
+
+    private:
+        bool compressed_;
+        std::vector< std::unique_ptr< VTUDataArray > > arrays_;
+    };
+
+    bool is_little_endian()
+    {
+        const std::uint16_t value{ 1 };
+        return *reinterpret_cast< const std::uint8_t* >( &value ) == 1;
+    }
+
+    /*!
+     * Gets the VTK type and the number of scalar components per item
+     * of a geogram attribute
+     * @return false if the attribute type has no VTK equivalent
+     */
+    bool vtk_attribute_type( const GEO::AttributeStore& store,
+        std::string& vtk_type,
+        index_t& nb_components )
+    {
+        const auto& type_name = store.element_typeid_name();
+        nb_components = store.dimension();
+        if( type_name == typeid( double ).name() )
+        {
+            vtk_type = "Float64";
+        }
+        else if( type_name == typeid( float ).name() )
+        {
+            vtk_type = "Float32";
+        }
+        else if( type_name == typeid( int ).name() )
+        {
+            vtk_type = "Int32";
+        }
+        else if( type_name == typeid( index_t ).name() )
+        {
+            vtk_type = "UInt32";
+        }
+        else if( type_name == typeid( char ).name()
+                 || type_name == typeid( GEO::Numeric::int8 ).name() )
+        {
+            vtk_type = "Int8";
+        }
+        else if( type_name == typeid( GEO::Numeric::uint8 ).name()
+                 || type_name == typeid( bool ).name() )
+        {
+            vtk_type = "UInt8";
+        }
+        else if( type_name == typeid( vec2 ).name() )
+        {
+            vtk_type = "Float64";
+            nb_components *= 2;
+        }
+        else if( type_name == typeid( vec3 ).name() )
+        {
+            vtk_type = "Float64";
+            nb_components *= 3;
+        }
+        else
+        {
+            return false;
+        }
+        return true;
+    }
+
+    std::vector< std::string > add_attribute_arrays(
+        GEO::AttributesManager& manager,
+        const std::string& location,
+        const std::string& section,
+        VTUAppendedData& data )
+    {
+        std::vector< std::string > array_names;
+        GEO::vector< std::string > names;
+        manager.list_attribute_names( names );
+        for( const auto& name : names )
+        {
+            if( name == "point" )
+            {
+                continue;
+            }
+            const auto* store = manager.find_attribute_store( name );
+            std::string vtk_type;
+            index_t nb_components{ 0 };
+            if( !vtk_attribute_type( *store, vtk_type, nb_components ) )
+            {
+                Logger::warn( "I/O", "Skipping ", location, " attribute ",
+                    name, ": type ", store->element_typeid_name(),
+                    " not supported by VTU" );
+                continue;
+            }
+            if( data.has_array( section, name ) )
+            {
+                Logger::warn( "I/O", "Skipping ", location, " attribute ",
+                    name, ": name already used in VTU ", section );
+                continue;
+            }
+            data.borrow_array( section, name, vtk_type, nb_components,
+                store->data(),
+                store->size() * store->dimension() * store->element_size() );
+            array_names.push_back( name );
+        }
+        return array_names;
+    }
+
+    /*!
+     * VTK XML unstructured grid exporter of the GeoModel3D volumetric mesh.
+     * Points, cells, region indices and every vertex and cell attribute
+     * bound on the GeoModelMesh are stored in a binary appended data
+     * section, zlib compressed if io:compression is set.
+     */
+    class VTUIOHandler final : public GeoModelOutputHandler3D
+    {
+    public:
+        void save(
+            const GeoModel3D& geomodel, const std::string& filename ) final
+        {
+            const auto& mesh = geomodel.mesh;
+            VTUAppendedData data(
+                GEO::CmdLine::get_arg_bool( "io:compression" ) );
+            add_points( mesh, data );
+            add_cells( mesh, data );
+            auto point_data =
+                add_attribute_arrays( mesh.vertices.attribute_manager(),
+                    "vertex", "PointData", data );
+            auto cell_data = add_attribute_arrays(
+                mesh.cells.attribute_manager(), "cell", "CellData", data );
+            data.encode();
+
+            std::ofstream out( filename.c_str(), std::ios::binary );
+            out << "<?xml version=\"1.0\"?>" << EOL;
+            out << "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" "
+                << "byte_order=\""
+                << ( is_little_endian() ? "LittleEndian" : "BigEndian" )
+                << "\" header_type=\"UInt64\"";
+            if( data.compressed() )
+            {
+                out << " compressor=\"vtkZLibDataCompressor\"";
+            }
+            out << ">" << EOL;
+            out << "<UnstructuredGrid>" << EOL;
+            out << "<Piece NumberOfPoints=\"" << mesh.vertices.nb()
+                << "\" NumberOfCells=\"" << mesh.cells.nb() << "\">" << EOL;
+            out << "<PointData>" << EOL;
+            for( const auto& name : point_data )
+            {
+                data.write_data_array( out, "PointData", name );
+            }
+            out << "</PointData>" << EOL;
+            out << "<CellData Scalars=\"region\">" << EOL;
+            data.write_data_array( out, "CellData", "region" );
+            for( const auto& name : cell_data )
+            {
+                data.write_data_array( out, "CellData", name );
+            }
+            out << "</CellData>" << EOL;
+            out << "<Points>" << EOL;
+            data.write_data_array( out, "Points", "Points" );
+            out << "</Points>" << EOL;
+            out << "<Cells>" << EOL;
+            data.write_data_array( out, "Cells", "connectivity" );
+            data.write_data_array( out, "Cells", "offsets" );
+            data.write_data_array( out, "Cells", "types" );
+            out << "</Cells>" << EOL;
+            out << "</Piece>" << EOL;
+            out << "</UnstructuredGrid>" << EOL;
+            data.write( out );
+            out << "</VTKFile>" << EOL;
+            out << std::flush;
+        }
+
+    private:
+        void add_points( const GeoModelMesh3D& mesh, VTUAppendedData& data )
+        {
+            auto nb_vertices = mesh.vertices.nb();
+            auto* points = data.create_array< double >(
+                "Points", "Points", "Float64", 3, 3 * nb_vertices );
+            parallel_for( nb_vertices, [&mesh, points]( index_t v ) {
+                const auto& vertex = mesh.vertices.vertex( v );
+                for( auto i : range( 3 ) )
+                {
+                    points[3 * v + i] = vertex[i];
+                }
+            } );
+        }
+
+        void add_cells( const GeoModelMesh3D& mesh, VTUAppendedData& data )
+        {
+            auto nb_cells = mesh.cells.nb();
+            auto* offsets = data.create_array< std::int64_t >(
+                "Cells", "offsets", "Int64", 1, nb_cells );
+            std::int64_t nb_corners{ 0 };
+            for( auto c : range( nb_cells ) )
+            {
+                nb_corners += mesh.cells.nb_vertices( c );
+                offsets[c] = nb_corners;
+            }
+
+            auto* connectivity = data.create_array< std::int64_t >(
+                "Cells", "connectivity", "Int64", 1,
+                static_cast< index_t >( nb_corners ) );
+            auto* types = data.create_array< std::uint8_t >(
+                "Cells", "types", "UInt8", 1, nb_cells );
+            auto* regions = data.create_array< std::int32_t >(
+                "CellData", "region", "Int32", 1, nb_cells );
+            parallel_for( nb_cells,
+                [&mesh, offsets, connectivity, types, regions]( index_t c ) {
+                    const auto& descriptor =
+                        *cell_type_to_cell_descriptor_vtk[to_underlying_type(
+                            mesh.cells.type( c ) )];
+                    auto nb_cell_vertices = mesh.cells.nb_vertices( c );
+                    auto start = offsets[c] - nb_cell_vertices;
+                    for( auto v : range( nb_cell_vertices ) )
+                    {
+                        connectivity[start + v] = mesh.cells.vertex(
+                            { c, descriptor.vertices[v] } );
+                    }
+                    types[c] =
+                        static_cast< std::uint8_t >( descriptor.entity_type );
+                    regions[c] =
+                        static_cast< std::int32_t >( mesh.cells.region( c ) );
+                } );
+        }
+    };
+} // namespace
@@ -33,9 +33,14 @@
  *     FRANCE
  */
 
+#include <algorithm>
+#include <thread>
+
 #include <geogram/basic/attributes.h>
+#include <geogram/basic/command_line.h>
 
 #include <ringmesh/basic/geometry.h>
+#include <ringmesh/basic/task_handler.h>
 #include <ringmesh/geomodel/core/geomodel.h>
 #include <ringmesh/geomodel/core/geomodel_api.h>
 #include <ringmesh/geomodel/core/geomodel_geological_entity.h>
@@ -122,6 +127,10 @@ namespace RINGMesh
         std::map< gmge_id, AbstractFeature* > geo_entity_2_feature_;
         std::map< AbstractFeature*, AbstractFeatureInterpretation* >
             feature_2_interp_;
+
+        /// Write buffers reused by all the triangulated patches
+        std::vector< double > points_buffer_;
+        std::vector< unsigned int > node_indices_buffer_;
     };
 
     GeoModelAdapterRESQMLImpl::GeoModelAdapterRESQMLImpl(
@@ -142,6 +151,12 @@ namespace RINGMesh
 
         hdf_proxy_ = pck_->createHdfProxy( "", "Hdf Proxy",
             pck_->getStorageDirectory(), pck_->getName() + ".h5" );
+        // The HDF proxy chunks the datasets it compresses
+        hdf_proxy_->setCompressionLevel(
+            GEO::CmdLine::get_arg_bool( "io:compression" )
+                ? std::min( 9u,
+                      GEO::CmdLine::get_arg_uint( "io:compression_level" ) )
+                : 0u );
 
         local_3d_crs_ = pck_->createLocalDepth3dCrs( "", "Default local CRS",
             .0, .0, .0, .0, gsoap_resqml2_0_1::eml20__LengthUom__m, 23031,
@@ -358,32 +373,29 @@ namespace RINGMesh
             const Surface3D& surface =
                 static_cast< const Surface3D& >( interface.child( i ) );
 
-            std::unique_ptr< double[] > points(
-                new double[surface.nb_vertices() * 3] );
-
-            vec3 p;
+            points_buffer_.resize( surface.nb_vertices() * 3 );
             for( auto v : range( surface.nb_vertices() ) )
             {
-                p = surface.vertex( v );
-                points[v * 3] = p[0];
-                points[v * 3 + 1] = p[1];
-                points[v * 3 + 2] = p[2];
+                const vec3& p = surface.vertex( v );
+                points_buffer_[v * 3] = p[0];
+                points_buffer_[v * 3 + 1] = p[1];
+                points_buffer_[v * 3 + 2] = p[2];
             }
 
-            std::unique_ptr< unsigned int[] > node_indices(
-                new unsigned int[surface.nb_mesh_elements() * 3] );
+            node_indices_buffer_.resize( surface.nb_mesh_elements() * 3 );
             for( auto t : range( surface.nb_mesh_elements() ) )
             {
                 for( auto v : range( surface.nb_mesh_element_vertices( t ) ) )
                 {
-                    node_indices[t * 3 + v] =
+                    node_indices_buffer_[t * 3 + v] =
                         interface_vertex_count
                         + surface.mesh_element_vertex_index( { t, v } );
                 }
             }
 
-            rep->pushBackTrianglePatch( surface.nb_vertices(), &points[0],
-                surface.nb_mesh_elements(), &node_indices[0], hdf_proxy_ );
+            rep->pushBackTrianglePatch( surface.nb_vertices(),
+                points_buffer_.data(), surface.nb_mesh_elements(),
+                node_indices_buffer_.data(), hdf_proxy_ );
 
             interface_vertex_count += surface.nb_vertices();
         }
@@ -458,6 +470,81 @@ namespace RINGMesh
         return true;
     }
 
+    namespace
+    {
+        struct UnstructuredGridGeometry
+        {
+            std::vector< double > points;
+            std::vector< ULONG64 > face_indices_per_cell;
+            std::vector< ULONG64 > cumul_faces_cells;
+            std::vector< ULONG64 > node_indices_per_face;
+            std::vector< ULONG64 > cumul_vertices_face;
+            std::vector< unsigned char > face_righthandness;
+
+            /// Empties the arrays, their memory is kept for the next region
+            void clear()
+            {
+                points.clear();
+                face_indices_per_cell.clear();
+                cumul_faces_cells.clear();
+                node_indices_per_face.clear();
+                cumul_vertices_face.clear();
+                face_righthandness.clear();
+            }
+        };
+
+        void fill_unstructured_grid_geometry(
+            const Region3D& region, UnstructuredGridGeometry& geometry )
+        {
+            geometry.points.resize( region.nb_vertices() * 3 );
+            for( auto v : range( region.nb_vertices() ) )
+            {
+                const vec3& p = region.vertex( v );
+                geometry.points[v * 3] = p[0];
+                geometry.points[v * 3 + 1] = p[1];
+                geometry.points[v * 3 + 2] = p[2];
+            }
+
+            index_t nb_facets{ 0 };
+            index_t nb_facet_vertices{ 0 };
+            for( auto t : range( region.nb_mesh_elements() ) )
+            {
+                for( auto f : range( region.nb_cell_facets( t ) ) )
+                {
+                    nb_facet_vertices += region.nb_cell_facet_vertices( t, f );
+                }
+                nb_facets += region.nb_cell_facets( t );
+            }
+
+            geometry.cumul_faces_cells.resize( region.nb_mesh_elements() );
+            geometry.face_indices_per_cell.resize( nb_facets );
+            geometry.cumul_vertices_face.resize( nb_facets );
+            // TODO: compute real face righthandness
+            geometry.face_righthandness.assign( nb_facets, 1 );
+            geometry.node_indices_per_face.resize( nb_facet_vertices );
+
+            index_t facet_count{ 0 };
+            index_t facet_vertex_count{ 0 };
+            for( auto t : range( region.nb_mesh_elements() ) )
+            {
+                for( auto f : range( region.nb_cell_facets( t ) ) )
+                {
+                    for( auto v :
+                        range( region.nb_cell_facet_vertices( t, f ) ) )
+                    {
+                        geometry.node_indices_per_face[facet_vertex_count++] =
+                            region.cell_facet_vertex_index( t, f, v );
+                    }
+                    geometry.face_indices_per_cell[facet_count] = facet_count;
+                    geometry.cumul_vertices_face[facet_count] =
+                        facet_vertex_count;
+                    ++facet_count;
+                }
+                geometry.cumul_faces_cells[t] = facet_count;
+            }
+        }
+    } // namespace
+
     bool GeoModelAdapterRESQMLImpl::write_volumes()
     {
         for( const auto& layer :
@@ -490,54 +577,44 @@ namespace RINGMesh
                     pck_->createUnstructuredGridRepresentation( local_3d_crs_,
                         guid, region.name(), region.nb_mesh_elements() );
                 reps.push_back( rep );
+            }
 
-                std::unique_ptr< double[] > points(
-                    new double[region.nb_vertices() * 3] );
-
-                vec3 p;
-                for( auto v : range( region.nb_vertices() ) )
-                {
-                    p = region.vertex( v );
-                    points[v * 3] = p[0];
-                    points[v * 3 + 1] = p[1];
-                    points[v * 3 + 2] = p[2];
-                }
-
-                std::unique_ptr< ULONG64[] > cumul_faces_cells(
-                    new ULONG64[region.nb_mesh_elements()] );
-
-                std::vector< ULONG64 > face_indices_per_cell;
-                std::vector< ULONG64 > cumul_vertices_face;
-                std::vector< ULONG64 > node_indices_per_face;
-                std::vector< unsigned char > face_righthandness;
-
-                index_t facet_count = 0;
-                for( auto t : range( region.nb_mesh_elements() ) )
+            // The HDF proxy is not thread safe: the geometry arrays of the
+            // regions are filled concurrently and written one by one.
+            // At most one region per thread is prepared at a time, so that
+            // the buffers of a whole layer are never held together.
+            const index_t nb_regions{ layer.nb_children() };
+            const index_t batch_size{ std::max(
+                1u, std::min( std::thread::hardware_concurrency(),
+                        nb_regions ) ) };
+            std::vector< UnstructuredGridGeometry > geometries( batch_size );
+            for( index_t first = 0; first < nb_regions; first += batch_size )
+            {
+                const index_t nb_batch_regions{ std::min(
+                    batch_size, nb_regions - first ) };
+                parallel_for( nb_batch_regions,
+                    [&layer, &geometries, first]( index_t i ) {
+                        fill_unstructured_grid_geometry(
+                            static_cast< const Region3D& >(
+                                layer.child( first + i ) ),
+                            geometries[i] );
+                    } );
+                for( auto i : range( nb_batch_regions ) )
                 {
-                    for( auto f : range( region.nb_cell_facets( t ) ) )
-                    {
-                        for( auto v :
-                            range( region.nb_cell_facet_vertices( t, f ) ) )
-                        {
-                            node_indices_per_face.push_back(
-                                region.cell_facet_vertex_index( t, f, v ) );
-                        }
-                        face_indices_per_cell.push_back( facet_count );
-                        ++facet_count;
-
-                        // TODO: compute real face righthandness
-                        face_righthandness.push_back( 1 );
-                        cumul_vertices_face.push_back(
-                            node_indices_per_face.size() );
-                    }
-                    cumul_faces_cells[t] = facet_count;
+                    const Region3D& region = static_cast< const Region3D& >(
+                        layer.child( first + i ) );
+                    UnstructuredGridGeometry& geometry = geometries[i];
+                    reps[first + i]->setGeometry(
+                        geometry.face_righthandness.data(),
+                        geometry.points.data(), region.nb_vertices(),
+                        hdf_proxy_, geometry.face_indices_per_cell.data(),
+                        geometry.cumul_faces_cells.data(),
+                        geometry.face_righthandness.size(),
+                        geometry.node_indices_per_face.data(),
+                        geometry.cumul_vertices_face.data(),
+                        gsoap_resqml2_0_1::resqml2__CellShape__polyhedral );
+                    geometry.clear();
                 }
-
-                rep->setGeometry( &face_righthandness[0], &points[0],
-                    region.nb_vertices(), hdf_proxy_, &face_indices_per_cell[0],
-                    &cumul_faces_cells[0], face_righthandness.size(),
-                    &node_indices_per_face[0], &cumul_vertices_face[0],
-                    gsoap_resqml2_0_1::resqml2__CellShape__polyhedral );
             }
 
             for( auto i : range( layer.nb_children() ) )
@@ -33,10 +33,14 @@
  *     FRANCE
  */
 
+#include <array>
+#include <mutex>
+
 #include <geogram/basic/attributes.h>
 #include <geogram/basic/logger.h>
 
 #include <ringmesh/basic/geometry.h>
+#include <ringmesh/basic/task_handler.h>
 #include <ringmesh/geomodel/core/geomodel.h>
 #include <ringmesh/geomodel/core/geomodel_api.h>
 #include <ringmesh/geomodel/core/geomodel_geological_entity.h>
@@ -112,6 +116,26 @@ namespace RINGMesh
             }
         }
 
+        /*!
+         * HDF5 is not thread safe: the accesses to the HDF5 files are
+         * serialized when the representations are read concurrently
+         */
+        std::mutex hdf_mutex;
+
+        /*!
+         * Throws the first error raised by a task of parallel_for
+         */
+        void throw_first_error( const std::vector< std::string >& errors )
+        {
+            for( const auto& error : errors )
+            {
+                if( !error.empty() )
+                {
+                    throw RINGMeshException( "RESQML2", error );
+                }
+            }
+        }
+
     } // anonymous namespace
 
     /****************************************************************************/
@@ -459,6 +483,33 @@ namespace RINGMesh
 
     namespace
     {
+        /*!
+         * Creates the attribute storing a property and returns its storage,
+         * in which the property values are directly read
+         */
+        template < typename T >
+        T* create_property_attribute( AbstractValuesProperty& property,
+            unsigned int el_per_val,
+            unsigned int val_count,
+            GEO::AttributesManager& attri_manager )
+        {
+            GEO::Attribute< T > attribute;
+            attribute.create_vector_attribute(
+                attri_manager, property.getTitle(), el_per_val );
+            if( static_cast< ULONG64 >( attribute.size() ) * el_per_val
+                < val_count )
+            {
+                throw RINGMeshException( "RESQML2", "Property ",
+                    property.getTitle(),
+                    " has more values than its supporting elements" );
+            }
+            if( val_count == 0 )
+            {
+                return nullptr;
+            }
+            return &attribute[0];
+        }
+
         bool read_property( AbstractValuesProperty& property,
             const unsigned int patch_index,
             GEO::AttributesManager& attri_manager )
@@ -471,6 +522,7 @@ namespace RINGMesh
             }
 
             showAllMetadata( &property );
+            std::lock_guard< std::mutex > lock( hdf_mutex );
             const unsigned int el_per_val = property.getElementCountPerValue();
 
             const unsigned int val_count =
@@ -486,16 +538,12 @@ namespace RINGMesh
                     || property.getValuesHdfDatatype()
                            == AbstractValuesProperty::DOUBLE )
                 {
-                    GEO::Attribute< double > attribute;
-                    attribute.create_vector_attribute(
-                        attri_manager, property.getTitle(), el_per_val );
-
-                    std::unique_ptr< double[] > values( new double[val_count] );
-                    continuousProp.getDoubleValuesOfPatch(
-                        patch_index, &values[0] );
-                    for( auto val : range( val_count ) )
+                    double* values = create_property_attribute< double >(
+                        property, el_per_val, val_count, attri_manager );
+                    if( values != nullptr )
                     {
-                        attribute[val] = values[val];
+                        continuousProp.getDoubleValuesOfPatch(
+                            patch_index, values );
                     }
                 }
             }
@@ -504,20 +552,70 @@ namespace RINGMesh
                 DiscreteProperty* discreteProp =
                     dynamic_cast< DiscreteProperty* >( &property );
 
-                GEO::Attribute< int > attribute;
-                attribute.create_vector_attribute(
-                    attri_manager, property.getTitle(), el_per_val );
-
-                std::unique_ptr< int[] > values( new int[val_count] );
-                discreteProp->getIntValuesOfPatch( patch_index, &values[0] );
-                for( auto val : range( val_count ) )
+                int* values = create_property_attribute< int >(
+                    property, el_per_val, val_count, attri_manager );
+                if( values != nullptr )
                 {
-                    attribute[val] = values[val];
+                    discreteProp->getIntValuesOfPatch( patch_index, values );
                 }
             }
 
             return true;
         }
+
+        struct SurfacePatch
+        {
+            std::vector< vec3 > points;
+            std::vector< index_t > triangles;
+            std::vector< index_t > triangle_ptr;
+        };
+
+        std::vector< SurfacePatch > read_surface_patches(
+            TriangulatedSetRepresentation& tri_set )
+        {
+            std::vector< SurfacePatch > patches( tri_set.getPatchCount() );
+            ULONG64 global_point_count = 0;
+            for( auto patch : range( patches.size() ) )
+            {
+                auto& surface_patch = patches[patch];
+                ULONG64 pointCount{ 0 };
+                std::unique_ptr< double[] > xyzPoints;
+                {
+                    std::lock_guard< std::mutex > lock( hdf_mutex );
+                    pointCount = tri_set.getXyzPointCountOfPatch( patch );
+                    xyzPoints.reset( new double[pointCount * 3] );
+                    tri_set.getXyzPointsOfPatch( patch, &xyzPoints[0] );
+
+                    const unsigned int triangleCount =
+                        tri_set.getTriangleCountOfPatch( patch );
+                    surface_patch.triangles.resize( triangleCount * 3, 0 );
+                    tri_set.getTriangleNodeIndicesOfPatch(
+                        patch, &surface_patch.triangles[0] );
+                }
+
+                surface_patch.points.resize( pointCount );
+                for( auto i : range( pointCount ) )
+                {
+                    surface_patch.points[i] = vec3( xyzPoints[i * 3],
+                        xyzPoints[i * 3 + 1], xyzPoints[i * 3 + 2] );
+                }
+                for( auto& node : surface_patch.triangles )
+                {
+                    node -= (index_t) global_point_count;
+                }
+
+                const auto triangleCount = static_cast< index_t >(
+                    surface_patch.triangles.size() / 3 );
+                surface_patch.triangle_ptr.resize( triangleCount + 1, 0 );
+                for( auto i : range( surface_patch.triangle_ptr.size() ) )
+                {
+                    surface_patch.triangle_ptr[i] = i * 3;
+                }
+
+                global_point_count += pointCount;
+            }
+            return patches;
+        }
     } // namespace
 
     gmge_id GeoModelBuilderRESQMLImpl::read_surface_geology(
@@ -572,43 +670,35 @@ namespace RINGMesh
                 "RESQML2", "At least one surface is required" );
         }
 
-        for( auto tri_set : all_tri_set_rep )
-        {
-            const gmge_id interface_id = read_surface_geology( tri_set );
-
-            ULONG64 global_point_count = 0;
-            for( auto patch : range( tri_set->getPatchCount() ) )
-            {
-                const ULONG64 pointCount =
-                    tri_set->getXyzPointCountOfPatch( patch );
-
-                std::unique_ptr< double[] > xyzPoints(
-                    new double[pointCount * 3] );
-                tri_set->getXyzPointsOfPatch( patch, &xyzPoints[0] );
-
-                std::vector< vec3 > points( pointCount, vec3() );
-                for( auto i : range( pointCount ) )
+        // The patch geometries of the representations are read concurrently,
+        // the GeoModel entities are then built in the file order
+        const auto nb_tri_sets =
+            static_cast< index_t >( all_tri_set_rep.size() );
+        std::vector< std::vector< SurfacePatch > > tri_set_patches(
+            nb_tri_sets );
+        std::vector< std::string > errors( nb_tri_sets );
+        parallel_for( nb_tri_sets,
+            [&all_tri_set_rep, &tri_set_patches, &errors]( index_t t ) {
+                try
                 {
-                    points[i] = vec3( xyzPoints[i * 3], xyzPoints[i * 3 + 1],
-                        xyzPoints[i * 3 + 2] );
+                    tri_set_patches[t] =
+                        read_surface_patches( *all_tri_set_rep[t] );
                 }
-
-                const unsigned int triangleCount =
-                    tri_set->getTriangleCountOfPatch( patch );
-
-                std::vector< index_t > trgls( triangleCount * 3, 0 );
-
-                tri_set->getTriangleNodeIndicesOfPatch( patch, &trgls[0] );
-                for( auto& node : trgls )
+                catch( const std::exception& e )
                 {
-                    node -= (index_t) global_point_count;
+                    errors[t] = e.what();
                 }
+            } );
+        throw_first_error( errors );
 
-                std::vector< index_t > trgls_ptr( triangleCount + 1, 0 );
-                for( auto i : range( trgls_ptr.size() ) )
-                {
-                    trgls_ptr[i] = i * 3;
-                }
+        for( auto t : range( nb_tri_sets ) )
+        {
+            TriangulatedSetRepresentation* tri_set = all_tri_set_rep[t];
+            const gmge_id interface_id = read_surface_geology( tri_set );
+
+            for( auto patch : range( tri_set_patches[t].size() ) )
+            {
+                SurfacePatch& surface_patch = tri_set_patches[t][patch];
 
                 const gmme_id children = builder_.topology.create_mesh_entity(
                     Surface3D::type_name_static() );
@@ -616,8 +706,10 @@ namespace RINGMesh
                 builder_.geology.add_parent_children_relation(
                     interface_id, children );
 
-                builder_.geometry.set_surface_geometry(
-                    children.index(), points, trgls, trgls_ptr );
+                builder_.geometry.set_surface_geometry( children.index(),
+                    surface_patch.points, surface_patch.triangles,
+                    surface_patch.triangle_ptr );
+                surface_patch = SurfacePatch();
 
                 for( auto prop_index :
                     range( tri_set->getValuesPropertySet().size() ) )
@@ -644,8 +736,6 @@ namespace RINGMesh
                             cur_surf.polygon_attribute_manager() );
                     }
                 }
-
-                global_point_count += pointCount;
             }
         }
 
@@ -658,42 +748,35 @@ namespace RINGMesh
     namespace
     {
         void read_tetrahedron( VolumeMeshBuilder3D& mesh_builder,
-            UnstructuredGridRepresentation& unstructed_grid )
+            UnstructuredGridRepresentation& unstructed_grid,
+            ULONG64 grid_cell )
         {
             const index_t cell =
                 mesh_builder.create_cells( (index_t) 1, CellType::TETRAHEDRON );
 
-            std::vector< index_t > vertices = {
-                (index_t) unstructed_grid.getNodeIndicesOfFaceOfCell(
-                    cell, 0 )[0],
-                (index_t) unstructed_grid.getNodeIndicesOfFaceOfCell(
-                    cell, 0 )[1],
-                (index_t) unstructed_grid.getNodeIndicesOfFaceOfCell(
-                    cell, 0 )[2],
-                0
-            };
+            const ULONG64* base =
+                unstructed_grid.getNodeIndicesOfFaceOfCell( grid_cell, 0 );
+            std::array< index_t, 4 > vertices{ { (index_t) base[0],
+                (index_t) base[1], (index_t) base[2], NO_ID } };
 
-            bool found = false;
-            for( unsigned int f = 1; f < 4; ++f )
+            for( unsigned int f = 1; f < 4 && vertices[3] == NO_ID; ++f )
             {
                 const ULONG64 nb_nodes =
-                    unstructed_grid.getNodeCountOfFaceOfCell( cell, f );
+                    unstructed_grid.getNodeCountOfFaceOfCell( grid_cell, f );
+                const ULONG64* nodes =
+                    unstructed_grid.getNodeIndicesOfFaceOfCell( grid_cell, f );
 
                 for( ULONG64 node = 0; node < nb_nodes; ++node )
                 {
-                    const ULONG64 node_index =
-                        unstructed_grid.getNodeIndicesOfFaceOfCell(
-                            cell, f )[node];
-                    if( node_index != vertices[0] && node_index != vertices[1]
-                        && node_index != vertices[2] )
+                    if( nodes[node] != base[0] && nodes[node] != base[1]
+                        && nodes[node] != base[2] )
                     {
-                        vertices[3] = (index_t) node_index;
-                        found = true;
+                        vertices[3] = (index_t) nodes[node];
                         break;
                     }
                 }
             }
-            ringmesh_assert( found );
+            ringmesh_assert( vertices[3] != NO_ID );
 
             for( auto v_id : range( 4 ) )
             {
@@ -702,23 +785,19 @@ namespace RINGMesh
         }
 
         void read_pyramid( VolumeMeshBuilder3D& mesh_builder,
-            UnstructuredGridRepresentation& unstructed_grid )
+            UnstructuredGridRepresentation& unstructed_grid,
+            ULONG64 grid_cell )
         {
             const index_t cell =
                 mesh_builder.create_cells( (index_t) 1, CellType::PYRAMID );
 
-            std::vector< index_t > vertices = {
-                (index_t) unstructed_grid.getNodeIndicesOfFaceOfCell(
-                    cell, 0 )[1],
-                (index_t) unstructed_grid.getNodeIndicesOfFaceOfCell(
-                    cell, 0 )[0],
-                (index_t) unstructed_grid.getNodeIndicesOfFaceOfCell(
-                    cell, 0 )[3],
-                (index_t) unstructed_grid.getNodeIndicesOfFaceOfCell(
-                    cell, 0 )[2],
-                (index_t) unstructed_grid.getNodeIndicesOfFaceOfCell(
-                    cell, 1 )[0]
-            };
+            const ULONG64* base =
+                unstructed_grid.getNodeIndicesOfFaceOfCell( grid_cell, 0 );
+            const ULONG64* side =
+                unstructed_grid.getNodeIndicesOfFaceOfCell( grid_cell, 1 );
+            const std::array< index_t, 5 > vertices{ { (index_t) base[1],
+                (index_t) base[0], (index_t) base[3], (index_t) base[2],
+                (index_t) side[0] } };
 
             for( auto v_id : range( 5 ) )
             {
@@ -727,29 +806,20 @@ namespace RINGMesh
         }
 
         void read_hexahedron( VolumeMeshBuilder3D& mesh_builder,
-            UnstructuredGridRepresentation& unstructed_grid )
+            UnstructuredGridRepresentation& unstructed_grid,
+            ULONG64 grid_cell )
         {
             const index_t cell =
                 mesh_builder.create_cells( (index_t) 1, CellType::HEXAHEDRON );
 
-            std::vector< index_t > vertices = {
-                (index_t) unstructed_grid.getNodeIndicesOfFaceOfCell(
-                    cell, 0 )[0],
-                (index_t) unstructed_grid.getNodeIndicesOfFaceOfCell(
-                    cell, 0 )[1],
-                (index_t) unstructed_grid.getNodeIndicesOfFaceOfCell(
-                    cell, 0 )[3],
-                (index_t) unstructed_grid.getNodeIndicesOfFaceOfCell(
-                    cell, 0 )[2],
-                (index_t) unstructed_grid.getNodeIndicesOfFaceOfCell(
-                    cell, 1 )[0],
-                (index_t) unstructed_grid.getNodeIndicesOfFaceOfCell(
-                    cell, 1 )[1],
-                (index_t) unstructed_grid.getNodeIndicesOfFaceOfCell(
-                    cell, 1 )[3],
-                (index_t) unstructed_grid.getNodeIndicesOfFaceOfCell(
-                    cell, 1 )[2]
-            };
+            const ULONG64* bottom =
+                unstructed_grid.getNodeIndicesOfFaceOfCell( grid_cell, 0 );
+            const ULONG64* top =
+                unstructed_grid.getNodeIndicesOfFaceOfCell( grid_cell, 1 );
+            const std::array< index_t, 8 > vertices{ { (index_t) bottom[0],
+                (index_t) bottom[1], (index_t) bottom[3], (index_t) bottom[2],
+                (index_t) top[0], (index_t) top[1], (index_t) top[3],
+                (index_t) top[2] } };
 
             for( auto v_id : range( 8 ) )
             {
@@ -762,24 +832,29 @@ namespace RINGMesh
         {
             auto mesh_builder = VolumeMeshBuilder3D::create_builder( mesh );
 
-            unstructed_grid.loadGeometry();
-
-            std::unique_ptr< double[] > gridPoints(
-                new double[unstructed_grid.getXyzPointCountOfPatch( 0 ) * 3] );
-            unstructed_grid.getXyzPointsOfAllPatchesInGlobalCrs(
-                &gridPoints[0] );
+            ULONG64 nb_vertices{ 0 };
+            std::unique_ptr< double[] > gridPoints;
+            {
+                std::lock_guard< std::mutex > lock( hdf_mutex );
+                unstructed_grid.loadGeometry();
 
-            const ULONG64 nb_vertices =
-                unstructed_grid.getXyzPointCountOfPatch( 0 );
+                nb_vertices = unstructed_grid.getXyzPointCountOfPatch( 0 );
+                gridPoints.reset( new double[nb_vertices * 3] );
+                unstructed_grid.getXyzPointsOfAllPatchesInGlobalCrs(
+                    &gridPoints[0] );
+            }
 
+            const index_t first_vertex =
+                mesh_builder->create_vertices( (index_t) nb_vertices );
             for( auto v : range( nb_vertices ) )
             {
-                const vec3 vertex( gridPoints[v * 3], gridPoints[v * 3 + 1],
-                    gridPoints[v * 3 + 2] );
-
-                mesh_builder->create_vertex( vertex );
+                mesh_builder->set_vertex( first_vertex + v,
+                    vec3( gridPoints[v * 3], gridPoints[v * 3 + 1],
+                        gridPoints[v * 3 + 2] ) );
             }
+            gridPoints.reset();
 
+            // The cell topology is in memory once the geometry is loaded
             const ULONG64 nb_cells = unstructed_grid.getCellCount();
             for( auto c : range( nb_cells ) )
             {
@@ -787,18 +862,21 @@ namespace RINGMesh
                     (index_t) unstructed_grid.getFaceCountOfCell( c );
                 if( nb_faces == 4 )
                 {
-                    read_tetrahedron( *mesh_builder, unstructed_grid );
+                    read_tetrahedron( *mesh_builder, unstructed_grid, c );
                 }
                 else if( nb_faces == 5 )
                 {
-                    read_pyramid( *mesh_builder, unstructed_grid );
+                    read_pyramid( *mesh_builder, unstructed_grid, c );
                 }
                 else if( nb_faces == 6 )
                 {
-                    read_hexahedron( *mesh_builder, unstructed_grid );
+                    read_hexahedron( *mesh_builder, unstructed_grid, c );
                 }
             }
-            unstructed_grid.unloadGeometry();
+            {
+                std::lock_guard< std::mutex > lock( hdf_mutex );
+                unstructed_grid.unloadGeometry();
+            }
             mesh_builder->connect_cells();
 
             return true;
@@ -848,7 +926,7 @@ namespace RINGMesh
                      .mesh_entity_manager.is_valid_type(
                          Region3D::type_name_static() ) )
             {
-                return -1;
+                return NO_ID;
             }
             else
             {
@@ -856,7 +934,7 @@ namespace RINGMesh
             }
         }
 
-        return region_index;
+        return (index_t) region_index;
     }
 
     bool GeoModelBuilderRESQMLImpl::read_volumes( const EpcDocument& pck )
@@ -868,8 +946,13 @@ namespace RINGMesh
             return true;
         }
 
-        for( auto unstructured_grid : unstructuredGridRepSet )
+        const auto nb_grids =
+            static_cast< index_t >( unstructuredGridRepSet.size() );
+        std::vector< bool > is_readable( nb_grids, true );
+        for( auto g : range( nb_grids ) )
         {
+            UnstructuredGridRepresentation* unstructured_grid =
+                unstructuredGridRepSet[g];
             showAllMetadata( unstructured_grid );
 
             if( unstructured_grid->isPartial()
@@ -877,18 +960,54 @@ namespace RINGMesh
             {
                 Logger::err(
                     "Attempted to read partial or empty UnstructuredGrid" );
-                continue;
+                is_readable[g] = false;
             }
+        }
 
-            auto mesh = VolumeMesh3D::create_mesh();
-            bool result = read_volume_rep( *mesh, *unstructured_grid );
-            ringmesh_assert( result );
-
-            // the volume mesh from resqml is here, need to find the
-            // corresponding region of in the GeoModel3D
+        // The grids are read and matched with the GeoModel regions
+        // concurrently (epsilon is lazily computed and is computed first)
+        geomodel_.epsilon();
+        std::vector< std::unique_ptr< VolumeMesh3D > > meshes( nb_grids );
+        std::vector< index_t > region_indices( nb_grids, NO_ID );
+        std::vector< std::string > errors( nb_grids );
+        parallel_for( nb_grids, [&unstructuredGridRepSet, &is_readable,
+                                    &meshes, &region_indices, &errors,
+                                    this]( index_t g ) {
+            if( !is_readable[g] )
+            {
+                return;
+            }
+            try
+            {
+                auto mesh = VolumeMesh3D::create_mesh();
+                bool result =
+                    read_volume_rep( *mesh, *unstructuredGridRepSet[g] );
+                ringmesh_assert( result );
+                ringmesh_unused( result );
+
+                // the volume mesh from resqml is here, need to find the
+                // corresponding region of in the GeoModel3D
+                region_indices[g] = find_matching_geomodel_region( *mesh );
+                meshes[g] = std::move( mesh );
+            }
+            catch( const std::exception& e )
+            {
+                errors[g] = e.what();
+            }
+        } );
+        throw_first_error( errors );
 
-            const int region_index = find_matching_geomodel_region( *mesh );
-            if( region_index == -1 )
+        for( auto g : range( nb_grids ) )
+        {
+            if( !meshes[g] )
+            {
+                continue;
+            }
+            UnstructuredGridRepresentation* unstructured_grid =
+                unstructuredGridRepSet[g];
+            std::unique_ptr< VolumeMesh3D > mesh = std::move( meshes[g] );
+            const index_t region_index = region_indices[g];
+            if( region_index == NO_ID )
             {
                 Logger::err( "I/O", "RESQML2 could not find a matching region "
                                     "for the volumn mesh" );
@@ -897,7 +1016,7 @@ namespace RINGMesh
 
             // corresponding region found, build its volume mesh
             const gmme_id region_id(
-                region_type_name_static(), (index_t) region_index );
+                region_type_name_static(), region_index );
 
             auto mesh_builder =
                 builder_.geometry.create_region_builder( region_id.index() );
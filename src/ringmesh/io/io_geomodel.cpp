@@ -35,16 +35,25 @@
 
 #include <ringmesh/io/io.h>
 
+#include <array>
 #include <cctype>
+#include <cstdint>
+#include <cstring>
 #include <deque>
 #include <iomanip>
+#include <limits>
+#include <map>
+#include <stack>
 
 #include <tinyxml2.h>
 
+#include <zlib.h>
+
 #include <geogram/basic/command_line.h>
 #include <geogram/basic/file_system.h>
 
 #include <ringmesh/basic/algorithm.h>
+#include <ringmesh/basic/nn_search.h>
 #include <ringmesh/basic/task_handler.h>
 #include <ringmesh/geomodel/builder/geomodel_builder.h>
 #include <ringmesh/geomodel/core/geomodel.h>
@@ -52,6 +61,8 @@
 #include <ringmesh/geomodel/core/geomodel_mesh_entity.h>
 #include <ringmesh/geomodel/core/well.h>
 #include <ringmesh/geomodel/tools/geomodel_validity.h>
+#include <ringmesh/io/binary_file_writer.h>
+#include <ringmesh/io/buffered_text_writer.h>
 #include <ringmesh/io/geomodel_adapter_resqml.h>
 #include <ringmesh/io/geomodel_builder_gocad.h>
 #if defined( RINGMESH_WITH_RESQML2 )
@@ -75,6 +86,42 @@ namespace
 {
     using namespace RINGMesh;
 
+    /*!
+     * Gets the indices of the mesh entities to export given by the
+     * io:entities argument. All the entities are exported when it is empty.
+     * @param[in] nb_entities number of mesh entities of the exported type
+     */
+    std::vector< index_t > selected_mesh_entities( index_t nb_entities )
+    {
+        std::string selection = GEO::CmdLine::get_arg( "io:entities" );
+        std::replace( selection.begin(), selection.end(), ',', ' ' );
+        std::vector< std::string > fields;
+        GEO::String::split_string( selection, ' ', fields );
+        std::vector< index_t > entities;
+        if( fields.empty() )
+        {
+            entities.reserve( nb_entities );
+            for( auto entity : range( nb_entities ) )
+            {
+                entities.push_back( entity );
+            }
+            return entities;
+        }
+        for( const auto& field : fields )
+        {
+            index_t entity{ NO_ID };
+            if( !GEO::String::from_string( field, entity )
+                || entity >= nb_entities )
+            {
+                throw RINGMeshException(
+                    "I/O", "Invalid entity index to export: ", field );
+            }
+            entities.push_back( entity );
+        }
+        sort_unique( entities );
+        return entities;
+    }
+
 #include "geomodel/io_abaqus.hpp"
 #include "geomodel/io_adeli.hpp"
 #include "geomodel/io_aster.hpp"
@@ -95,6 +142,7 @@ namespace
 #include "geomodel/io_tetgen.hpp"
 #include "geomodel/io_tsolid.hpp"
 #include "geomodel/io_vtk.hpp"
+#include "geomodel/io_vtu.hpp"
 
     template < typename Class, typename Factory >
     std::unique_ptr< Class > create_handler( const std::string& format )
@@ -124,6 +172,8 @@ namespace RINGMesh
             "gm" );
         GeoModelOutputHandlerFactory2D::register_creator< MFEMIOHandler2D >(
             "mfem" );
+        GeoModelOutputHandlerFactory2D::register_creator< SVGIOHandler >(
+            "svg" );
     }
 
     template <>
@@ -153,6 +203,8 @@ namespace RINGMesh
             "mail" );
         GeoModelOutputHandlerFactory3D::register_creator< VTKIOHandler >(
             "vtk" );
+        GeoModelOutputHandlerFactory3D::register_creator< VTUIOHandler >(
+            "vtu" );
         // todo GPRS export is not working for the moment [AB]
         //        GeoModelOutputHandlerFactory3D::register_creator<
         //        GPRSIOHandler >( "gprs" );
@@ -187,6 +239,8 @@ namespace RINGMesh
         GeoModelInputHandlerFactory3D::register_creator< MLIOHandler >( "ml" );
         GeoModelInputHandlerFactory3D::register_creator< TSolidIOHandler >(
             "so" );
+        GeoModelInputHandlerFactory3D::register_creator< MSHIOHandler >(
+            "msh" );
 #ifdef RINGMESH_WITH_RESQML2
         GeoModelInputHandlerFactory3D::register_creator< RESQMLIOHandler >(
             "epc" );
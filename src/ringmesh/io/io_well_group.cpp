@@ -35,6 +35,11 @@
 
 #include <ringmesh/io/io.h>
 
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+
 #include <geogram/basic/file_system.h>
 #include <geogram/basic/line_stream.h>
 #include <ringmesh/geomodel/core/geomodel.h>
@@ -56,6 +61,7 @@ namespace
 
 #include "well_group/io_smesh.hpp"
 #include "well_group/io_wl.hpp"
+#include "well_group/io_wlb.hpp"
 } // namespace
 
 namespace RINGMesh
@@ -100,6 +106,7 @@ namespace RINGMesh
     void WellGroupIOHandler::initialize()
     {
         WellGroupIOHandlerFactory::register_creator< WLIOHandler >( "wl" );
+        WellGroupIOHandlerFactory::register_creator< WLBIOHandler >( "wlb" );
         WellGroupIOHandlerFactory::register_creator< SmeshIOHandler >(
             "smesh" );
     }
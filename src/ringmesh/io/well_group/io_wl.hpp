@@ -46,12 +46,16 @@ namespace
                 throw RINGMeshException( "I/O", "Could not open file" );
             }
 
-            auto mesh = LineMesh3D::create_mesh();
-            auto builder = LineMeshBuilder3D::create_builder( *mesh );
+            WellTrajectories trajectories;
             std::string name;
             double z_sign = 1.0;
             vec3 vertex_ref;
 
+            auto add_vertex = [&trajectories]( const vec3& vertex ) {
+                trajectories.x.push_back( vertex.x );
+                trajectories.y.push_back( vertex.y );
+                trajectories.z.push_back( vertex.z );
+            };
             while( !in.eof() )
             {
                 in.get_line();
@@ -74,7 +78,7 @@ namespace
                     vertex_ref[0] = in.field_as_double( 1 );
                     vertex_ref[1] = in.field_as_double( 2 );
                     vertex_ref[2] = z_sign * in.field_as_double( 3 );
-                    builder->create_vertex( vertex_ref );
+                    add_vertex( vertex_ref );
                 }
                 else if( in.field_matches( 0, "PATH" ) )
                 {
@@ -84,16 +88,16 @@ namespace
                     vertex[2] = z_sign * in.field_as_double( 2 );
                     vertex[0] = in.field_as_double( 3 ) + vertex_ref[0];
                     vertex[1] = in.field_as_double( 4 ) + vertex_ref[1];
-                    index_t id = builder->create_vertex( vertex );
-                    builder->create_edge( id - 1, id );
+                    add_vertex( vertex );
                 }
                 else if( in.field_matches( 0, "END" ) )
                 {
-                    wells.add_well( *mesh, name );
-                    mesh = LineMesh3D::create_mesh();
-                    builder = LineMeshBuilder3D::create_builder( *mesh );
+                    trajectories.names.push_back( name );
+                    trajectories.offsets.push_back(
+                        static_cast< index_t >( trajectories.x.size() ) );
                 }
             }
+            wells.add_wells( trajectories );
         }
         void save( const WellGroup3D& wells, const std::string& filename ) final
         {
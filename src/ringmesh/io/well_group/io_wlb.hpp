@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2012-2018, Association Scientifique pour la Geologie et ses
+ * Applications (ASGA). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of ASGA nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL ASGA BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *     http://www.ring-team.org
+ *
+ *     RING Project
+ *     Ecole Nationale Superieure de Geologie - GeoRessources
+ *     2 Rue du Doyen Marcel Roubault - TSA 70605
+ *     54518 VANDOEUVRE-LES-NANCY
+ *     FRANCE
+ */
+
+
+namespace
+{
+    bool is_little_endian()
+    {
+        const std::uint16_t value{ 1 };
+        return *reinterpret_cast< const std::uint8_t* >( &value ) == 1;
+    }
+
+    /*!
+     * Converts a value read in little endian order to the host byte order
+     */
+    template < typename T >
+    void from_little_endian( T& value )
+    {
+        auto bytes = reinterpret_cast< char* >( &value );
+        std::reverse( bytes, bytes + sizeof( T ) );
+    }
+
+    /*!
+     * Reads values stored in little endian order from a binary file
+     */
+    template < typename T >
+    void read_binary_values(
+        std::ifstream& in, std::vector< T >& values, std::size_t nb_values )
+    {
+        values.resize( nb_values );
+        in.read( reinterpret_cast< char* >( values.data() ),
+            static_cast< std::streamsize >( nb_values * sizeof( T ) ) );
+        if( !is_little_endian() )
+        {
+            for( auto& value : values )
+            {
+                from_little_endian( value );
+            }
+        }
+    }
+
+    template < typename T >
+    T read_binary_value( std::ifstream& in )
+    {
+        T value{};
+        in.read( reinterpret_cast< char* >( &value ), sizeof( T ) );
+        if( !is_little_endian() )
+        {
+            from_little_endian( value );
+        }
+        return value;
+    }
+
+    /*!
+     * Binary file of well trajectories, all values are little endian
+     * and converted to the host byte order when read:
+     * - the 8 characters "RMWELLS1"
+     * - the number of wells (uint32) and of vertices (uint64)
+     * - for each well, the size of its name (uint32) and its characters
+     * - the offsets of the well vertices (nb wells + 1 uint64)
+     * - the x, then y, then z coordinates of all the vertices (double)
+     * The vertices of the well w are [offset[w], offset[w+1]), in the order
+     * of the trajectory.
+     */
+    class WLBIOHandler final : public WellGroupIOHandler
+    {
+    public:
+        void load( const std::string& filename, WellGroup3D& wells ) final
+        {
+            std::ifstream in( filename, std::ios::binary );
+            if( !in )
+            {
+                throw RINGMeshException( "I/O", "Could not open file" );
+            }
+            std::string magic( 8, '\0' );
+            in.read( &magic[0], 8 );
+            if( magic != "RMWELLS1" )
+            {
+                throw RINGMeshException(
+                    "I/O", "Unknown binary well trajectory file ", filename );
+            }
+            const auto nb_wells = read_binary_value< std::uint32_t >( in );
+            const auto nb_vertices = read_binary_value< std::uint64_t >( in );
+            if( !in || nb_vertices > std::numeric_limits< index_t >::max() )
+            {
+                throw RINGMeshException(
+                    "I/O", "Invalid header in file ", filename );
+            }
+
+            WellTrajectories trajectories;
+            trajectories.names.resize( nb_wells );
+            for( auto& name : trajectories.names )
+            {
+                name.resize( read_binary_value< std::uint32_t >( in ) );
+                in.read(
+                    &name[0], static_cast< std::streamsize >( name.size() ) );
+            }
+            std::vector< std::uint64_t > offsets;
+            read_binary_values( in, offsets, nb_wells + std::size_t( 1 ) );
+            read_binary_values( in, trajectories.x, nb_vertices );
+            read_binary_values( in, trajectories.y, nb_vertices );
+            read_binary_values( in, trajectories.z, nb_vertices );
+            if( !in )
+            {
+                throw RINGMeshException(
+                    "I/O", "Unexpected end of file ", filename );
+            }
+            trajectories.offsets.resize( offsets.size() );
+            for( auto w : range( offsets.size() ) )
+            {
+                if( offsets[w] > nb_vertices )
+                {
+                    throw RINGMeshException(
+                        "I/O", "Invalid well offset in file ", filename );
+                }
+                trajectories.offsets[w] = static_cast< index_t >( offsets[w] );
+            }
+            wells.add_wells( trajectories );
+        }
+
+        void save( const WellGroup3D& wells, const std::string& filename ) final
+        {
+            ringmesh_unused( wells );
+            ringmesh_unused( filename );
+            throw RINGMeshException( "I/O",
+                "Saving of a WellGroup in binary trajectories not implemented "
+                "yet" );
+        }
+    };
+}
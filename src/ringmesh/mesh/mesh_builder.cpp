@@ -35,6 +35,12 @@
 
 /*! \author Francois Bonneau */
 
+#include <array>
+#include <cstdint>
+#include <thread>
+
+#include <ringmesh/basic/algorithm.h>
+
 #include <ringmesh/mesh/line_mesh.h>
 #include <ringmesh/mesh/mesh_builder.h>
 #include <ringmesh/mesh/mesh_index.h>
@@ -99,10 +105,127 @@ namespace
         }
         return {};
     }
+
+    /*!
+     * Number of keys below which matching them is not split between threads
+     */
+    const index_t min_keys_per_thread{ 4096 };
+
+    /*!
+     * Number of facet key bits added to the number of bits of the facet
+     * count, so that few different facets share a key
+     */
+    const index_t nb_facet_key_extra_bits{ 8 };
+
+    using FacetVertices = std::array< index_t, 4 >;
+
+    index_t nb_significant_bits( index_t value )
+    {
+        index_t nb_bits{ 0 };
+        while( nb_bits < 32 && value >> nb_bits != 0 )
+        {
+            nb_bits++;
+        }
+        return nb_bits;
+    }
+
+    std::uint64_t edge_key( index_t v0, index_t v1, index_t nb_vertex_bits )
+    {
+        return ( static_cast< std::uint64_t >( std::min( v0, v1 ) )
+                   << nb_vertex_bits )
+               | std::max( v0, v1 );
+    }
+
+    std::uint64_t facet_key( const FacetVertices& vertices, std::uint64_t mask )
+    {
+        std::uint64_t key{ 0 };
+        for( auto vertex : vertices )
+        {
+            // SplitMix64 finalizer
+            key += vertex + 0x9E3779B97F4A7C15ULL;
+            key = ( key ^ ( key >> 30 ) ) * 0xBF58476D1CE4E5B9ULL;
+            key = ( key ^ ( key >> 27 ) ) * 0x94D049BB133111EBULL;
+            key ^= key >> 31;
+        }
+        return key & mask;
+    }
+
+    template < index_t DIMENSION >
+    FacetVertices sorted_facet_vertices(
+        const VolumeMesh< DIMENSION >& mesh, const CellLocalFacet& facet )
+    {
+        FacetVertices vertices;
+        vertices.fill( NO_ID );
+        auto nb_vertices = mesh.nb_cell_facet_vertices( facet );
+        ringmesh_assert( nb_vertices <= vertices.size() );
+        for( auto v : range( nb_vertices ) )
+        {
+            vertices[v] = mesh.cell_facet_vertex( facet, v );
+        }
+        std::sort( vertices.begin(), vertices.begin() + nb_vertices );
+        return vertices;
+    }
+
+    /*!
+     * Calls @param match_run( begin, end ) on every range of equal keys of
+     * the sorted @param keys, in parallel, and sums the returned reports.
+     */
+    template < typename T, typename MATCH >
+    AdjacencyReport match_sorted_keys(
+        const std::vector< std::pair< std::uint64_t, T > >& keys,
+        const MATCH& match_run )
+    {
+        const index_t nb_keys = static_cast< index_t >( keys.size() );
+        const index_t nb_chunks{ std::max( 1u,
+            std::min( std::thread::hardware_concurrency(),
+                nb_keys / min_keys_per_thread ) ) };
+        const index_t chunk_size{ ( nb_keys + nb_chunks - 1 ) / nb_chunks };
+        auto run_begin = [&keys, nb_keys, chunk_size]( index_t chunk ) {
+            auto begin = std::min( nb_keys, chunk * chunk_size );
+            while( begin > 0 && begin < nb_keys
+                   && keys[begin].first == keys[begin - 1].first )
+            {
+                begin++;
+            }
+            return begin;
+        };
+
+        std::vector< AdjacencyReport > reports( nb_chunks );
+        parallel_for( nb_chunks, [&]( index_t chunk ) {
+            auto end = run_begin( chunk + 1 );
+            for( auto begin = run_begin( chunk ); begin < end; )
+            {
+                auto run_end = begin + 1;
+                while( run_end < nb_keys
+                       && keys[run_end].first == keys[begin].first )
+                {
+                    run_end++;
+                }
+                reports[chunk] += match_run( begin, run_end );
+                begin = run_end;
+            }
+        } );
+
+        AdjacencyReport report;
+        for( const auto& chunk_report : reports )
+        {
+            report += chunk_report;
+        }
+        return report;
+    }
 } // namespace
 
 namespace RINGMesh
 {
+    AdjacencyReport& AdjacencyReport::operator+=( const AdjacencyReport& rhs )
+    {
+        nb_connected += rhs.nb_connected;
+        nb_borders += rhs.nb_borders;
+        nb_non_manifold += rhs.nb_non_manifold;
+        nb_inconsistent += rhs.nb_inconsistent;
+        return *this;
+    }
+
     template <>
     std::unique_ptr< MeshBaseBuilder< 2 > >
         mesh_api MeshBaseBuilder< 2 >::create_builder( MeshBase< 2 >& mesh )
@@ -368,6 +491,154 @@ namespace RINGMesh
         this->delete_vertices( to_delete );
     }
 
+    template < index_t DIMENSION >
+    AdjacencyReport
+        SurfaceMeshBuilder< DIMENSION >::compute_polygon_adjacencies()
+    {
+        const auto& mesh = surface_mesh_;
+        std::vector< index_t > polygon_ptr( mesh.nb_polygons() + 1, 0 );
+        for( auto p : range( mesh.nb_polygons() ) )
+        {
+            polygon_ptr[p + 1] = polygon_ptr[p] + mesh.nb_polygon_vertices( p );
+        }
+        std::vector< std::pair< std::uint64_t, PolygonLocalEdge > > edges(
+            polygon_ptr.back() );
+        auto nb_vertex_bits = nb_significant_bits( mesh.nb_vertices() );
+        parallel_for( mesh.nb_polygons(), [&]( index_t p ) {
+            for( auto v : range( mesh.nb_polygon_vertices( p ) ) )
+            {
+                auto vertex = mesh.polygon_vertex( { p, v } );
+                auto next_vertex = mesh.polygon_vertex(
+                    mesh.next_polygon_vertex( { p, v } ) );
+                edges[polygon_ptr[p] + v] = {
+                    edge_key( vertex, next_vertex, nb_vertex_bits ), { p, v }
+                };
+            }
+        } );
+        parallel_radix_sort( edges, 2 * nb_vertex_bits );
+
+        return match_sorted_keys(
+            edges, [this, &mesh, &edges]( index_t begin, index_t end ) {
+                AdjacencyReport report;
+                if( end - begin == 2 )
+                {
+                    const auto& edge0 = edges[begin].second;
+                    const auto& edge1 = edges[begin + 1].second;
+                    if( mesh.polygon_vertex( edge0 )
+                        != mesh.polygon_vertex( edge1 ) )
+                    {
+                        this->set_polygon_adjacent( edge0, edge1.polygon_id );
+                        this->set_polygon_adjacent( edge1, edge0.polygon_id );
+                        report.nb_connected++;
+                        return report;
+                    }
+                    report.nb_inconsistent++;
+                }
+                else if( end - begin == 1 )
+                {
+                    report.nb_borders++;
+                }
+                else
+                {
+                    report.nb_non_manifold++;
+                }
+                for( auto i : range( begin, end ) )
+                {
+                    this->set_polygon_adjacent( edges[i].second, NO_ID );
+                }
+                return report;
+            } );
+    }
+
+    template < index_t DIMENSION >
+    AdjacencyReport VolumeMeshBuilder< DIMENSION >::compute_cell_adjacencies()
+    {
+        const auto& mesh = volume_mesh_;
+        std::vector< index_t > cell_ptr( mesh.nb_cells() + 1, 0 );
+        for( auto c : range( mesh.nb_cells() ) )
+        {
+            cell_ptr[c + 1] = cell_ptr[c] + mesh.nb_cell_facets( c );
+        }
+        std::vector< std::pair< std::uint64_t, CellLocalFacet > > facets(
+            cell_ptr.back() );
+        auto nb_key_bits = std::min( 64u,
+            nb_significant_bits( cell_ptr.back() ) + nb_facet_key_extra_bits );
+        auto key_mask = ~std::uint64_t{ 0 } >> ( 64 - nb_key_bits );
+        parallel_for( mesh.nb_cells(), [&]( index_t c ) {
+            for( auto f : range( mesh.nb_cell_facets( c ) ) )
+            {
+                facets[cell_ptr[c] + f] = {
+                    facet_key(
+                        sorted_facet_vertices( mesh, { c, f } ), key_mask ),
+                    { c, f }
+                };
+            }
+        } );
+        parallel_radix_sort( facets, nb_key_bits );
+
+        return match_sorted_keys(
+            facets, [this, &mesh, &facets]( index_t begin, index_t end ) {
+                AdjacencyReport report;
+                if( end - begin == 1 )
+                {
+                    this->set_cell_adjacent( facets[begin].second, NO_ID );
+                    report.nb_borders++;
+                    return report;
+                }
+                // Equal keys may come from different facets
+                using RunFacet = std::pair< FacetVertices, CellLocalFacet >;
+                std::vector< RunFacet > run_facets;
+                run_facets.reserve( end - begin );
+                for( auto i : range( begin, end ) )
+                {
+                    run_facets.emplace_back(
+                        sorted_facet_vertices( mesh, facets[i].second ),
+                        facets[i].second );
+                }
+                std::sort( run_facets.begin(), run_facets.end(),
+                    []( const RunFacet& lhs, const RunFacet& rhs ) {
+                        return lhs.first < rhs.first;
+                    } );
+                for( index_t group_begin = 0;
+                     group_begin < run_facets.size(); )
+                {
+                    auto group_end = group_begin + 1;
+                    while( group_end < run_facets.size()
+                           && run_facets[group_end].first
+                                  == run_facets[group_begin].first )
+                    {
+                        group_end++;
+                    }
+                    if( group_end - group_begin == 2 )
+                    {
+                        const auto& facet0 = run_facets[group_begin].second;
+                        const auto& facet1 = run_facets[group_end - 1].second;
+                        this->set_cell_adjacent( facet0, facet1.cell_id );
+                        this->set_cell_adjacent( facet1, facet0.cell_id );
+                        report.nb_connected++;
+                    }
+                    else
+                    {
+                        if( group_end - group_begin == 1 )
+                        {
+                            report.nb_borders++;
+                        }
+                        else
+                        {
+                            report.nb_non_manifold++;
+                        }
+                        for( auto i : range( group_begin, group_end ) )
+                        {
+                            this->set_cell_adjacent(
+                                run_facets[i].second, NO_ID );
+                        }
+                    }
+                    group_begin = group_end;
+                }
+                return report;
+            } );
+    }
+
     template < index_t DIMENSION >
     void VolumeMeshBuilder< DIMENSION >::remove_isolated_vertices()
     {
@@ -38,6 +38,7 @@
 #include <ringmesh/tetrahedralize/tetgen_mesher.h>
 
 #include <cstring>
+#include <mutex>
 
 #include <geogram/mesh/mesh.h>
 
@@ -104,6 +105,10 @@ namespace RINGMesh
 
     void TetgenMesher::tetrahedralize()
     {
+        // Each run initializes static tables and predicates of TetGen,
+        // the runs of concurrent meshers are serialized
+        static std::mutex tetgen_mutex;
+        std::lock_guard< std::mutex > lock( tetgen_mutex );
         try
         {
             GEO_3rdParty::tetrahedralize(
@@ -241,41 +246,85 @@ namespace RINGMesh
     }
 
     void TetgenMesher::assign_result_tetmesh_to_mesh(
-        VolumeMeshBuilder3D& output_mesh_builder ) const
+        VolumeMeshBuilder3D& output_mesh_builder )
     {
-        output_mesh_builder.assign_vertices( get_result_tetmesh_points() );
-        output_mesh_builder.assign_cell_tet_mesh( get_result_tetmesh_tets() );
-        output_mesh_builder.remove_isolated_vertices();
-        output_mesh_builder.connect_cells();
+        static_assert( sizeof( int ) == sizeof( index_t ),
+            "TetGen buffers are reused as index_t buffers" );
+        auto nb_tets = compact_result_tets();
+        auto nb_points = compact_result_points( nb_tets );
+        output_mesh_builder.assign_tet_mesh( tetgen_out_.pointlist, nb_points,
+            reinterpret_cast< const index_t* >( tetgen_out_.tetrahedronlist ),
+            reinterpret_cast< const index_t* >( tetgen_out_.neighborlist ),
+            nb_tets );
     }
 
-    std::vector< double > TetgenMesher::get_result_tetmesh_points() const
+    index_t TetgenMesher::compact_result_tets()
     {
-        auto nb_points = static_cast< index_t >( tetgen_out_.numberofpoints );
-        std::vector< double > points( 3 * nb_points );
-        double* points_ptr = tetgen_out_.pointlist;
-        parallel_for( 3 * nb_points, [&points, &points_ptr]( index_t i ) {
-            points[i] = points_ptr[i];
-        } );
-        return points;
+        std::set< double > regions_to_keep = determine_tet_regions_to_keep();
+        auto nb_tets = static_cast< index_t >( tetgen_out_.numberoftetrahedra );
+        std::vector< index_t > new_tet_ids( nb_tets, NO_ID );
+        index_t nb_kept_tets{ 0 };
+        for( auto t : range( nb_tets ) )
+        {
+            if( regions_to_keep.find( tetgen_out_.tetrahedronattributelist[t] )
+                != regions_to_keep.end() )
+            {
+                new_tet_ids[t] = nb_kept_tets++;
+            }
+        }
+
+        // The kept tets only move toward the beginning of the buffers
+        auto tets = reinterpret_cast< index_t* >( tetgen_out_.tetrahedronlist );
+        auto neighbors =
+            reinterpret_cast< index_t* >( tetgen_out_.neighborlist );
+        for( auto t : range( nb_tets ) )
+        {
+            auto new_t = new_tet_ids[t];
+            if( new_t == NO_ID )
+            {
+                continue;
+            }
+            for( auto v : range( 4 ) )
+            {
+                tets[4 * new_t + v] = tets[4 * t + v];
+                auto neighbor = tetgen_out_.neighborlist[4 * t + v];
+                neighbors[4 * new_t + v] =
+                    neighbor < 0
+                        ? NO_ID
+                        : new_tet_ids[static_cast< index_t >( neighbor )];
+            }
+        }
+        return nb_kept_tets;
     }
 
-    std::vector< index_t > TetgenMesher::get_result_tetmesh_tets() const
+    index_t TetgenMesher::compact_result_points( index_t nb_tets )
     {
-        std::vector< index_t > tets_to_keep = determine_tets_to_keep();
-
-        auto nb_tets = static_cast< index_t >( tets_to_keep.size() );
-        std::vector< index_t > tets( 4 * nb_tets );
-        int* tets_ptr = tetgen_out_.tetrahedronlist;
-        parallel_for( nb_tets, [&tets_to_keep, &tets_ptr, &tets]( index_t i ) {
-            index_t tetra = tets_to_keep[i];
-            for( auto v : range( 4 ) )
+        auto nb_points = static_cast< index_t >( tetgen_out_.numberofpoints );
+        auto tets = reinterpret_cast< index_t* >( tetgen_out_.tetrahedronlist );
+        std::vector< index_t > new_point_ids( nb_points, NO_ID );
+        for( auto c : range( 4 * nb_tets ) )
+        {
+            new_point_ids[tets[c]] = 0;
+        }
+        index_t nb_kept_points{ 0 };
+        auto points = tetgen_out_.pointlist;
+        for( auto p : range( nb_points ) )
+        {
+            if( new_point_ids[p] == NO_ID )
             {
-                tets[4 * i + v] =
-                    static_cast< index_t >( tets_ptr[4 * tetra + v] );
+                continue;
             }
+            new_point_ids[p] = nb_kept_points;
+            for( auto i : range( 3 ) )
+            {
+                points[3 * nb_kept_points + i] = points[3 * p + i];
+            }
+            nb_kept_points++;
+        }
+        parallel_for( 4 * nb_tets, [&tets, &new_point_ids]( index_t c ) {
+            tets[c] = new_point_ids[tets[c]];
         } );
-        return tets;
+        return nb_kept_points;
     }
 
     std::set< double > TetgenMesher::determine_tet_regions_to_keep() const
@@ -302,24 +351,6 @@ namespace RINGMesh
         return regions_to_keep;
     }
 
-    std::vector< index_t > TetgenMesher::determine_tets_to_keep() const
-    {
-        std::vector< index_t > tets_to_keep;
-        std::set< double > regions_to_keep = determine_tet_regions_to_keep();
-
-        auto nb_tets = static_cast< index_t >( tetgen_out_.numberoftetrahedra );
-        tets_to_keep.reserve( nb_tets );
-        for( auto t : range( nb_tets ) )
-        {
-            if( regions_to_keep.find( tetgen_out_.tetrahedronattributelist[t] )
-                != regions_to_keep.end() )
-            {
-                tets_to_keep.push_back( t );
-            }
-        }
-        return tets_to_keep;
-    }
-
     void tetrahedralize_mesh_tetgen( VolumeMeshBuilder3D& out_tet_mesh,
         const GEO::Mesh& in_mesh,
         bool refine,
@@ -35,6 +35,8 @@
 
 #include <ringmesh/tetrahedralize/tetra_gen.h>
 
+#include <mutex>
+
 #ifdef RINGMESH_WINDOWS
 #include <io.h>
 #endif
@@ -115,6 +117,41 @@ namespace RINGMesh
 #endif
     }
 
+    /*!
+     * @brief Runs MG_Tetra calls one at a time, with the standard outputs
+     * redirected until the end of the scope
+     * @details The redirection applies to the whole process and MG_Tetra
+     * is not known to be thread safe: Regions meshed concurrently wait for
+     * each other here.
+     */
+    class MGTetraCall
+    {
+        ringmesh_disable_copy_and_move( MGTetraCall );
+
+    public:
+        MGTetraCall() : lock_( mutex_ )
+        {
+            start_redirect( out_pos_, stdout, out_fd_ );
+            start_redirect( err_pos_, stderr, err_fd_ );
+        }
+
+        ~MGTetraCall()
+        {
+            stop_redirect( out_pos_, stdout, out_fd_ );
+            stop_redirect( err_pos_, stderr, err_fd_ );
+        }
+
+    private:
+        static std::mutex mutex_;
+        std::lock_guard< std::mutex > lock_;
+        fpos_t out_pos_;
+        int out_fd_{ 0 };
+        fpos_t err_pos_;
+        int err_fd_{ 0 };
+    };
+
+    std::mutex MGTetraCall::mutex_;
+
     class tetrahedralize_api TetraGen_MG_Tetra final : public TetraGen
     {
     public:
@@ -125,30 +162,17 @@ namespace RINGMesh
 
         virtual ~TetraGen_MG_Tetra()
         {
-            fpos_t pos;
-            int fd = 0;
-            start_redirect( pos, stdout, fd );
-            fpos_t pos_err;
-            int fd_err = 0;
-            start_redirect( pos_err, stderr, fd_err );
+            MGTetraCall call;
 
             tetra_regain_mesh( tms_, mesh_output_ );
             tetra_session_delete( tms_ );
             mesh_delete( mesh_input_ );
             context_delete( context_ );
-
-            stop_redirect( pos, stdout, fd );
-            stop_redirect( pos_err, stderr, fd_err );
         }
 
         bool do_tetrahedralize( bool refine ) final
         {
-            fpos_t pos;
-            int fd = 0;
-            start_redirect( pos, stdout, fd );
-            fpos_t pos_err;
-            int fd_err = 0;
-            start_redirect( pos_err, stderr, fd_err );
+            MGTetraCall call;
 
             initialize_mgtetra_variables();
 
@@ -161,9 +185,6 @@ namespace RINGMesh
             write_vertices_in_ringmesh_data_structure();
             write_tet_in_ringmesh_data_structure();
 
-            stop_redirect( pos, stdout, fd );
-            stop_redirect( pos_err, stderr, fd_err );
-
             return true;
         }
 
@@ -620,10 +641,10 @@ namespace RINGMesh
             points.front().data(), points.size() * 3 * sizeof( double ) );
     }
 
-    bool TetraGen::tetrahedralize( bool refine )
+    bool TetraGen::tetrahedralize( bool refine, bool update_geomodel_mesh )
     {
         bool result = do_tetrahedralize( refine );
-        if( result )
+        if( result && update_geomodel_mesh )
         {
             builder_.geometry.clear_geomodel_mesh();
         }
@@ -0,0 +1,253 @@
+/*
+ * Copyright (c) 2012-2018, Association Scientifique pour la Geologie et ses
+ * Applications (ASGA). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of ASGA nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL ASGA BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *     http://www.ring-team.org
+ *
+ *     RING Project
+ *     Ecole Nationale Superieure de Geologie - GeoRessources
+ *     2 Rue du Doyen Marcel Roubault - TSA 70605
+ *     54518 VANDOEUVRE-LES-NANCY
+ *     FRANCE
+ */
+
+#include <ringmesh/ringmesh_tests_config.h>
+
+#include <vector>
+
+#include <geogram/mesh/mesh.h>
+
+#include <ringmesh/geomodel/builder/geomodel_builder_from_mesh.h>
+#include <ringmesh/geomodel/core/geomodel.h>
+#include <ringmesh/geomodel/core/geomodel_mesh_entity.h>
+
+/*!
+ * Tests the Lines and Corners built from the Surfaces of a model made of
+ * two stacked boxes, a square hanging from the top of the boxes and an
+ * isolated square. The expected Lines, their order and their orientation,
+ * are the ones given on these Surfaces by the serial propagation used
+ * before the border edge graph.
+ */
+
+using namespace RINGMesh;
+
+struct ExpectedLine
+{
+    std::vector< index_t > corners;
+    std::vector< index_t > surfaces;
+    vec3 first;
+    vec3 last;
+    index_t nb_vertices;
+};
+
+const std::vector< vec3 > expected_corners{
+    { 0, 1, 0 },
+    { 0, 0, 0 },
+    { 1, 0, 0 },
+    { 0, 0, 0.5 },
+    { 1, 1, 0 },
+    { 0, 1, 0.5 },
+    { 1, 0, 0.5 },
+    { 1, 1, 0.5 },
+    { 0, 0, 1 },
+    { 0, 1, 1 },
+    { 1, 0, 1 },
+    { 1, 1, 1 },
+    { 0.5, 0, 1 },
+    { 0.5, 0.25, 1 },
+    { 0.5, 0.5, 1 },
+    { 3, 0.25, 0 }
+};
+
+const std::vector< ExpectedLine > expected_lines{
+    { { 0, 1 }, { 0, 5 }, { 0, 1, 0 }, { 0, 0, 0 }, 5 },
+    { { 1, 2 }, { 0, 3 }, { 0, 0, 0 }, { 1, 0, 0 }, 5 },
+    { { 3, 1 }, { 3, 5 }, { 0, 0, 0.5 }, { 0, 0, 0 }, 5 },
+    { { 4, 0 }, { 0, 4 }, { 1, 1, 0 }, { 0, 1, 0 }, 5 },
+    { { 5, 0 }, { 4, 5 }, { 0, 1, 0.5 }, { 0, 1, 0 }, 5 },
+    { { 2, 4 }, { 0, 6 }, { 1, 0, 0 }, { 1, 1, 0 }, 5 },
+    { { 2, 6 }, { 3, 6 }, { 1, 0, 0 }, { 1, 0, 0.5 }, 5 },
+    { { 4, 7 }, { 4, 6 }, { 1, 1, 0 }, { 1, 1, 0.5 }, 5 },
+    { { 5, 3 }, { 1, 5, 9 }, { 0, 1, 0.5 }, { 0, 0, 0.5 }, 5 },
+    { { 3, 6 }, { 1, 3, 7 }, { 0, 0, 0.5 }, { 1, 0, 0.5 }, 5 },
+    { { 8, 3 }, { 7, 9 }, { 0, 0, 1 }, { 0, 0, 0.5 }, 5 },
+    { { 7, 5 }, { 1, 4, 8 }, { 1, 1, 0.5 }, { 0, 1, 0.5 }, 5 },
+    { { 9, 5 }, { 8, 9 }, { 0, 1, 1 }, { 0, 1, 0.5 }, 5 },
+    { { 6, 7 }, { 1, 6, 10 }, { 1, 0, 0.5 }, { 1, 1, 0.5 }, 5 },
+    { { 6, 10 }, { 7, 10 }, { 1, 0, 0.5 }, { 1, 0, 1 }, 5 },
+    { { 7, 11 }, { 8, 10 }, { 1, 1, 0.5 }, { 1, 1, 1 }, 5 },
+    { { 9, 8 }, { 2, 9 }, { 0, 1, 1 }, { 0, 0, 1 }, 5 },
+    { { 8, 12 }, { 2, 7 }, { 0, 0, 1 }, { 0.5, 0, 1 }, 3 },
+    { { 11, 9 }, { 2, 8 }, { 1, 1, 1 }, { 0, 1, 1 }, 5 },
+    { { 12, 13 }, { 12 }, { 0.5, 0, 1 }, { 0.5, 0.25, 1 }, 2 },
+    { { 12, 10 }, { 2, 7 }, { 0.5, 0, 1 }, { 1, 0, 1 }, 3 },
+    { { 14, 12 }, { 12 }, { 0.5, 0.5, 1 }, { 0.5, 0, 1 }, 7 },
+    { { 13, 14 }, { 12 }, { 0.5, 0.25, 1 }, { 0.5, 0.5, 1 }, 2 },
+    { { 10, 11 }, { 2, 10 }, { 1, 0, 1 }, { 1, 1, 1 }, 5 },
+    { { 15, 15 }, { 11 }, { 3, 0.25, 0 }, { 3, 0.25, 0 }, 17 }
+};
+
+void add_square( GEO::Mesh& mesh,
+    const vec3& origin,
+    const vec3& u_axis,
+    const vec3& v_axis,
+    index_t nb_subdivisions )
+{
+    auto nb_points = nb_subdivisions + 1;
+    auto first = mesh.vertices.create_vertices( nb_points * nb_points );
+    for( auto i : range( nb_points ) )
+    {
+        for( auto j : range( nb_points ) )
+        {
+            mesh.vertices.point( first + i * nb_points + j ) =
+                origin + ( double( i ) / nb_subdivisions ) * u_axis
+                + ( double( j ) / nb_subdivisions ) * v_axis;
+        }
+    }
+    for( auto i : range( nb_subdivisions ) )
+    {
+        for( auto j : range( nb_subdivisions ) )
+        {
+            auto v00 = first + i * nb_points + j;
+            auto v10 = v00 + nb_points;
+            mesh.facets.create_triangle( v00, v10, v10 + 1 );
+            mesh.facets.create_triangle( v00, v10 + 1, v00 + 1 );
+        }
+    }
+}
+
+void build_model( GeoModel3D& geomodel )
+{
+    const index_t nb_subdivisions{ 4 };
+    GEO::Mesh mesh;
+    vec3 x( 1, 0, 0 );
+    vec3 y( 0, 1, 0 );
+    vec3 z( 0, 0, 0.5 );
+    for( auto height : { 0., 0.5, 1. } )
+    {
+        add_square( mesh, vec3( 0, 0, height ), x, y, nb_subdivisions );
+    }
+    for( auto height : { 0., 0.5 } )
+    {
+        add_square( mesh, vec3( 0, 0, height ), x, z, nb_subdivisions );
+        add_square( mesh, vec3( 0, 1, height ), x, z, nb_subdivisions );
+        add_square( mesh, vec3( 0, 0, height ), y, z, nb_subdivisions );
+        add_square( mesh, vec3( 1, 0, height ), y, z, nb_subdivisions );
+    }
+    // Square without Corner on its boundary
+    add_square( mesh, vec3( 3, 0, 0 ), x, y, nb_subdivisions );
+    // Square hanging from the inside of the top Surface
+    add_square( mesh, vec3( 0.5, 0, 1 ), 0.5 * y, z, nb_subdivisions / 2 );
+    mesh.facets.connect();
+
+    GeoModelBuilderSurfaceMesh builder( geomodel, mesh );
+    builder.build_polygonal_surfaces_from_connected_components();
+    builder.build_lines_and_corners_from_surfaces();
+}
+
+void check_corners( const GeoModel3D& geomodel )
+{
+    if( geomodel.nb_corners() != expected_corners.size() )
+    {
+        throw RINGMeshException( "RINGMesh Test", "Wrong number of Corners" );
+    }
+    for( const auto& corner : geomodel.corners() )
+    {
+        if( corner.vertex( 0 ) != expected_corners[corner.index()] )
+        {
+            throw RINGMeshException(
+                "RINGMesh Test", "Wrong position of ", corner.gmme() );
+        }
+    }
+}
+
+void check_lines( const GeoModel3D& geomodel )
+{
+    if( geomodel.nb_lines() != expected_lines.size() )
+    {
+        throw RINGMeshException( "RINGMesh Test", "Wrong number of Lines" );
+    }
+    for( const auto& line : geomodel.lines() )
+    {
+        const auto& expected = expected_lines[line.index()];
+        if( line.nb_vertices() != expected.nb_vertices
+            || line.vertex( 0 ) != expected.first
+            || line.vertex( line.nb_vertices() - 1 ) != expected.last )
+        {
+            throw RINGMeshException(
+                "RINGMesh Test", "Wrong vertices of ", line.gmme() );
+        }
+        if( line.nb_boundaries() != expected.corners.size() )
+        {
+            throw RINGMeshException(
+                "RINGMesh Test", "Wrong boundaries of ", line.gmme() );
+        }
+        for( auto i : range( line.nb_boundaries() ) )
+        {
+            if( line.boundary_gmme( i ).index() != expected.corners[i] )
+            {
+                throw RINGMeshException(
+                    "RINGMesh Test", "Wrong boundaries of ", line.gmme() );
+            }
+        }
+        if( line.nb_incident_entities() != expected.surfaces.size() )
+        {
+            throw RINGMeshException(
+                "RINGMesh Test", "Wrong incident Surfaces of ", line.gmme() );
+        }
+        for( auto i : range( line.nb_incident_entities() ) )
+        {
+            if( line.incident_entity_gmme( i ).index()
+                != expected.surfaces[i] )
+            {
+                throw RINGMeshException( "RINGMesh Test",
+                    "Wrong incident Surfaces of ", line.gmme() );
+            }
+        }
+    }
+}
+
+int main()
+{
+    try
+    {
+        GeoModel3D geomodel;
+        build_model( geomodel );
+        check_corners( geomodel );
+        check_lines( geomodel );
+    }
+    catch( const RINGMeshException& e )
+    {
+        Logger::err( e.category(), e.what() );
+        return 1;
+    }
+    catch( const std::exception& e )
+    {
+        Logger::err( "Exception", e.what() );
+        return 1;
+    }
+    Logger::out( "TEST", "SUCCESS" );
+    return 0;
+}
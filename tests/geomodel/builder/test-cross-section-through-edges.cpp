@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2012-2018, Association Scientifique pour la Geologie et ses
+ * Applications (ASGA). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of ASGA nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL ASGA BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *     http://www.ring-team.org
+ *
+ *     RING Project
+ *     Ecole Nationale Superieure de Geologie - GeoRessources
+ *     2 Rue du Doyen Marcel Roubault - TSA 70605
+ *     54518 VANDOEUVRE-LES-NANCY
+ *     FRANCE
+ */
+
+
+#include <ringmesh/ringmesh_tests_config.h>
+
+#include <algorithm>
+
+#include <geogram/mesh/mesh.h>
+
+#include <ringmesh/basic/geometry.h>
+#include <ringmesh/geomodel/builder/geomodel_builder_2d_from_3d.h>
+#include <ringmesh/geomodel/builder/geomodel_builder_from_mesh.h>
+#include <ringmesh/geomodel/core/geomodel.h>
+#include <ringmesh/geomodel/core/geomodel_mesh_entity.h>
+
+/*!
+ * Tests the cross sections of a cube GeoModel3D cutting its triangulated
+ * faces between their vertices: through the middle of the mesh edges, along
+ * a curtain bent inside a triangle, and along a plane oblique to the mesh.
+ * The cut of each face must be one continuous Line of the expected length.
+ */
+
+using namespace RINGMesh;
+
+const index_t nb_subdivisions = 4;
+
+void add_square( GEO::Mesh& mesh,
+    const vec3& origin,
+    const vec3& u_axis,
+    const vec3& v_axis )
+{
+    auto nb_points = nb_subdivisions + 1;
+    auto first = mesh.vertices.create_vertices( nb_points * nb_points );
+    for( auto i : range( nb_points ) )
+    {
+        for( auto j : range( nb_points ) )
+        {
+            mesh.vertices.point( first + i * nb_points + j ) =
+                origin + ( double( i ) / nb_subdivisions ) * u_axis
+                + ( double( j ) / nb_subdivisions ) * v_axis;
+        }
+    }
+    for( auto i : range( nb_subdivisions ) )
+    {
+        for( auto j : range( nb_subdivisions ) )
+        {
+            auto v00 = first + i * nb_points + j;
+            auto v10 = v00 + nb_points;
+            mesh.facets.create_triangle( v00, v10, v10 + 1 );
+            mesh.facets.create_triangle( v00, v10 + 1, v00 + 1 );
+        }
+    }
+}
+
+void build_cube( GeoModel3D& geomodel )
+{
+    GEO::Mesh mesh;
+    vec3 x( 1, 0, 0 );
+    vec3 y( 0, 1, 0 );
+    vec3 z( 0, 0, 1 );
+    add_square( mesh, vec3(), y, z );
+    add_square( mesh, x, y, z );
+    add_square( mesh, vec3(), x, z );
+    add_square( mesh, y, x, z );
+    add_square( mesh, vec3(), x, y );
+    add_square( mesh, z, x, y );
+    mesh.facets.connect();
+
+    GeoModelBuilderSurfaceMesh builder( geomodel, mesh );
+    builder.build_polygonal_surfaces_from_connected_components();
+    builder.build_lines_and_corners_from_surfaces();
+    builder.build_regions_from_lines_and_surfaces();
+    builder.end_geomodel();
+}
+
+/*!
+ * The sections cut the four faces of the cube around the x axis: the
+ * section is a quadrilateral made of one Line per face. The Lines cut on
+ * the faces z = 0 and z = 1 have the length @param z_face_length, the
+ * Lines cut on the faces y = 0 and y = 1 have the length 1.
+ * @param nb_line_vertices expected number of vertices of each Line,
+ * NO_ID to skip this check
+ */
+void check_section( const GeoModel2D& section,
+    double z_face_length,
+    index_t nb_line_vertices )
+{
+    if( section.nb_corners() != 4 || section.nb_lines() != 4 )
+    {
+        throw RINGMeshException( "RINGMesh Test", "Section has ",
+            section.nb_corners(), " Corners and ", section.nb_lines(),
+            " Lines instead of 4 and 4" );
+    }
+    std::vector< double > lengths;
+    for( const auto& line : section.lines() )
+    {
+        if( nb_line_vertices != NO_ID
+            && line.nb_vertices() != nb_line_vertices )
+        {
+            throw RINGMeshException( "RINGMesh Test", line.gmme(), " has ",
+                line.nb_vertices(), " vertices instead of ",
+                nb_line_vertices );
+        }
+        lengths.push_back( line.size() );
+    }
+    std::vector< double > expected_lengths{ 1., 1., z_face_length,
+        z_face_length };
+    std::sort( lengths.begin(), lengths.end() );
+    std::sort( expected_lengths.begin(), expected_lengths.end() );
+    for( auto l : range( lengths.size() ) )
+    {
+        if( std::fabs( lengths[l] - expected_lengths[l] ) > global_epsilon )
+        {
+            throw RINGMeshException( "RINGMesh Test", "Section Line length ",
+                lengths[l], " instead of ", expected_lengths[l] );
+        }
+    }
+    if( section.nb_surfaces() != 1 )
+    {
+        throw RINGMeshException( "RINGMesh Test", "Section has ",
+            section.nb_surfaces(), " Surfaces instead of 1" );
+    }
+    if( std::fabs( section.surface( 0 ).size() - z_face_length )
+        > global_epsilon )
+    {
+        throw RINGMeshException( "RINGMesh Test", "Section area is ",
+            section.surface( 0 ).size(), " instead of ", z_face_length );
+    }
+}
+
+/*!
+ * The plane x = 0.375 goes through the middle of the edges of one column
+ * of triangles of each face it cuts
+ */
+void test_mid_edge_section( const GeoModel3D& geomodel )
+{
+    Logger::out( "TEST", "Section through the middle of the edges" );
+    Geometry::Plane plane( { 1., 0., 0. }, { 0.375, 0.5, 0.5 } );
+    GeoModel2D section;
+    GeoModelBuilder2DCrossSection builder( section, geomodel, plane );
+    builder.build_geomodel();
+    check_section( section, 1., 2 * nb_subdivisions + 1 );
+}
+
+/*!
+ * The curtain is bent at y = 0.6, i.e. inside a triangle of the faces
+ * z = 0 and z = 1
+ */
+void test_mid_face_curtain_section( const GeoModel3D& geomodel )
+{
+    Logger::out( "TEST", "Section along a curtain bent inside a triangle" );
+    vec2 bend{ 0.375, 0.6 };
+    vec2 end{ 0.625, 2. };
+    std::vector< vec2 > curtain{ { 0.375, -1. }, bend, end };
+    GeoModel2D section;
+    GeoModelBuilder2DCrossSection builder( section, geomodel, curtain );
+    builder.build_geomodel();
+    auto z_face_length = bend.y
+                         + ( end - bend ).length() * ( 1. - bend.y )
+                               / ( end.y - bend.y );
+    check_section( section, z_face_length, NO_ID );
+}
+
+/*!
+ * The plane x + 0.3 y = 0.6 is oblique to the mesh edges and goes
+ * through none of the mesh vertices
+ */
+void test_oblique_section( const GeoModel3D& geomodel )
+{
+    Logger::out( "TEST", "Section along an oblique plane" );
+    Geometry::Plane plane( { 1., 0.3, 0. }, { 0.6, 0., 0.5 } );
+    GeoModel2D section;
+    GeoModelBuilder2DCrossSection builder( section, geomodel, plane );
+    builder.build_geomodel();
+    check_section( section, std::sqrt( 1. + 0.3 * 0.3 ), NO_ID );
+}
+
+int main()
+{
+    try
+    {
+        GeoModel3D geomodel;
+        build_cube( geomodel );
+        test_mid_edge_section( geomodel );
+        test_mid_face_curtain_section( geomodel );
+        test_oblique_section( geomodel );
+    }
+    catch( const RINGMeshException& e )
+    {
+        Logger::err( e.category(), e.what() );
+        return 1;
+    }
+    catch( const std::exception& e )
+    {
+        Logger::err( "Exception", e.what() );
+        return 1;
+    }
+    Logger::out( "TEST", "SUCCESS" );
+    return 0;
+}
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2012-2018, Association Scientifique pour la Geologie et ses
+ * Applications (ASGA). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of ASGA nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL ASGA BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *     http://www.ring-team.org
+ *
+ *     RING Project
+ *     Ecole Nationale Superieure de Geologie - GeoRessources
+ *     2 Rue du Doyen Marcel Roubault - TSA 70605
+ *     54518 VANDOEUVRE-LES-NANCY
+ *     FRANCE
+ */
+
+#include <ringmesh/ringmesh_tests_config.h>
+
+#include <vector>
+
+#include <ringmesh/geomodel/builder/geomodel_builder.h>
+#include <ringmesh/geomodel/core/geomodel.h>
+#include <ringmesh/geomodel/core/geomodel_mesh_entity.h>
+
+#include <ringmesh/mesh/mesh_index.h>
+#include <ringmesh/mesh/surface_mesh.h>
+
+/*!
+ * Tests the cut of a Surface along an internal Line: a square triangulated
+ * on a 4x4 grid is cut along its middle column of vertices.
+ */
+
+using namespace RINGMesh;
+
+const index_t nb_cells = 4;
+
+void build_square_with_internal_line( GeoModel3D& geomodel )
+{
+    GeoModelBuilder3D builder( geomodel );
+    auto surface_id =
+        builder.topology.create_mesh_entity( Surface3D::type_name_static() );
+    auto line_id =
+        builder.topology.create_mesh_entity( Line3D::type_name_static() );
+
+    std::vector< vec3 > vertices;
+    for( auto i : range( nb_cells + 1 ) )
+    {
+        for( auto j : range( nb_cells + 1 ) )
+        {
+            vertices.emplace_back( i, j, 0 );
+        }
+    }
+    std::vector< index_t > polygons;
+    std::vector< index_t > polygon_ptr{ 0 };
+    for( auto i : range( nb_cells ) )
+    {
+        for( auto j : range( nb_cells ) )
+        {
+            auto v00 = i * ( nb_cells + 1 ) + j;
+            auto v10 = v00 + nb_cells + 1;
+            polygons.insert( polygons.end(), { v00, v10, v10 + 1 } );
+            polygon_ptr.push_back( static_cast< index_t >( polygons.size() ) );
+            polygons.insert( polygons.end(), { v00, v10 + 1, v00 + 1 } );
+            polygon_ptr.push_back( static_cast< index_t >( polygons.size() ) );
+        }
+    }
+    builder.geometry.set_surface_geometry(
+        surface_id.index(), vertices, polygons, polygon_ptr );
+
+    std::vector< vec3 > line_vertices;
+    for( auto j : range( nb_cells + 1 ) )
+    {
+        line_vertices.emplace_back( nb_cells / 2, j, 0 );
+    }
+    builder.geometry.set_line( line_id.index(), line_vertices );
+    // The Line is twice a boundary of the Surface: it is an internal border
+    builder.topology.add_surface_line_boundary_relation(
+        surface_id.index(), line_id.index() );
+    builder.topology.add_surface_line_boundary_relation(
+        surface_id.index(), line_id.index() );
+}
+
+std::vector< vec3 > polygon_barycenters( const Surface3D& surface )
+{
+    std::vector< vec3 > barycenters;
+    for( auto p : range( surface.nb_mesh_elements() ) )
+    {
+        barycenters.push_back( surface.mesh_element_barycenter( p ) );
+    }
+    return barycenters;
+}
+
+void check_cut_surface(
+    const Surface3D& surface, const std::vector< vec3 >& barycenters )
+{
+    if( surface.nb_vertices() != ( nb_cells + 1 ) * ( nb_cells + 2 ) )
+    {
+        throw RINGMeshException( "RINGMesh Test",
+            "The Line vertices should be duplicated in the Surface" );
+    }
+    const auto& mesh = surface.mesh();
+    for( auto p : range( surface.nb_mesh_elements() ) )
+    {
+        if( surface.mesh_element_barycenter( p ) != barycenters[p] )
+        {
+            throw RINGMeshException(
+                "RINGMesh Test", "The cut moved the polygon ", p );
+        }
+        auto left = barycenters[p].x < nb_cells / 2;
+        for( auto v : range( 3 ) )
+        {
+            // The polygons on each side of the Line do not share vertices
+            for( auto polygon : mesh.polygons_around_vertex(
+                     mesh.polygon_vertex( { p, v } ), false, p ) )
+            {
+                if( ( barycenters[polygon].x < nb_cells / 2 ) != left )
+                {
+                    throw RINGMeshException( "RINGMesh Test", "Polygons ", p,
+                        " and ", polygon, " are connected across the Line" );
+                }
+            }
+            auto adjacent = surface.polygon_adjacent_index( { p, v } );
+            if( adjacent != NO_ID
+                && ( barycenters[adjacent].x < nb_cells / 2 ) != left )
+            {
+                throw RINGMeshException( "RINGMesh Test", "Polygons ", p,
+                    " and ", adjacent, " are adjacent across the Line" );
+            }
+        }
+    }
+}
+
+int main()
+{
+    try
+    {
+        GeoModel3D geomodel;
+        build_square_with_internal_line( geomodel );
+        const auto& surface = geomodel.surface( 0 );
+        auto barycenters = polygon_barycenters( surface );
+
+        GeoModelBuilder3D builder( geomodel );
+        builder.geometry.cut_surfaces_by_internal_lines();
+        check_cut_surface( surface, barycenters );
+    }
+    catch( const RINGMeshException& e )
+    {
+        Logger::err( e.category(), e.what() );
+        return 1;
+    }
+    catch( const std::exception& e )
+    {
+        Logger::err( "Exception", e.what() );
+        return 1;
+    }
+    Logger::out( "TEST", "SUCCESS" );
+    return 0;
+}
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2012-2018, Association Scientifique pour la Geologie et ses
+ * Applications (ASGA). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of ASGA nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL ASGA BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *     http://www.ring-team.org
+ *
+ *     RING Project
+ *     Ecole Nationale Superieure de Geologie - GeoRessources
+ *     2 Rue du Doyen Marcel Roubault - TSA 70605
+ *     54518 VANDOEUVRE-LES-NANCY
+ *     FRANCE
+ */
+
+#include <ringmesh/ringmesh_tests_config.h>
+
+#include <vector>
+
+#include <ringmesh/geomodel/builder/geomodel_builder.h>
+#include <ringmesh/geomodel/core/geomodel.h>
+#include <ringmesh/geomodel/core/geomodel_mesh_entity.h>
+
+#include <ringmesh/mesh/mesh_index.h>
+#include <ringmesh/mesh/surface_mesh.h>
+
+/*!
+ * Tests the recomputation of the polygon adjacencies of a Surface around
+ * non-manifold edges and edges traversed in the same direction
+ */
+
+using namespace RINGMesh;
+
+void check_adjacent( const Surface3D& surface,
+    index_t polygon,
+    index_t edge,
+    index_t adjacent )
+{
+    if( surface.polygon_adjacent_index( { polygon, edge } ) != adjacent )
+    {
+        throw RINGMeshException( "RINGMesh Test", "Wrong adjacent polygon ",
+            "of edge ", edge, " of polygon ", polygon );
+    }
+}
+
+void check_adjacencies( const Surface3D& surface )
+{
+    // Polygons 0, 1 and 2 share the non-manifold edge 0-1
+    check_adjacent( surface, 0, 0, NO_ID );
+    check_adjacent( surface, 1, 0, NO_ID );
+    check_adjacent( surface, 2, 0, NO_ID );
+    // Polygons 3 and 4 both traverse the edge 5-6 from 5 to 6
+    check_adjacent( surface, 3, 0, NO_ID );
+    check_adjacent( surface, 4, 0, NO_ID );
+    // Polygons 5 and 6 share the edge 9-10 with opposite directions
+    check_adjacent( surface, 5, 0, 6 );
+    check_adjacent( surface, 6, 0, 5 );
+    for( auto p : range( surface.nb_mesh_elements() ) )
+    {
+        for( auto e : range( 1, 3 ) )
+        {
+            check_adjacent( surface, p, e, NO_ID );
+        }
+    }
+}
+
+int main()
+{
+    try
+    {
+        GeoModel3D geomodel;
+        GeoModelBuilder3D builder( geomodel );
+        auto id = builder.topology.create_mesh_entity(
+            Surface3D::type_name_static() );
+
+        std::vector< vec3 > vertices;
+        for( auto v : range( 13 ) )
+        {
+            vertices.emplace_back( v, v * v, 1 );
+        }
+        std::vector< index_t > polygons{ 0, 1, 2, 1, 0, 3, 1, 0, 4, 5, 6, 7, 5,
+            6, 8, 9, 10, 11, 10, 9, 12 };
+        std::vector< index_t > polygon_ptr;
+        for( auto p : range( 8 ) )
+        {
+            polygon_ptr.push_back( 3 * p );
+        }
+        builder.geometry.set_surface_geometry(
+            id.index(), vertices, polygons, polygon_ptr );
+        const auto& surface = geomodel.surface( id.index() );
+        check_adjacencies( surface );
+
+        // The recomputation overwrites the existing adjacencies
+        builder.geometry.set_surface_element_adjacency(
+            id.index(), 0, { 1, 3, 4 } );
+        builder.geometry.compute_surface_adjacencies( id.index(), true );
+        check_adjacencies( surface );
+    }
+    catch( const RINGMeshException& e )
+    {
+        Logger::err( e.category(), e.what() );
+        return 1;
+    }
+    catch( const std::exception& e )
+    {
+        Logger::err( "Exception", e.what() );
+        return 1;
+    }
+    Logger::out( "TEST", "SUCCESS" );
+    return 0;
+}
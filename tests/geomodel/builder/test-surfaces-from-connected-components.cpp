@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) 2012-2018, Association Scientifique pour la Geologie et ses
+ * Applications (ASGA). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of ASGA nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL ASGA BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *     http://www.ring-team.org
+ *
+ *     RING Project
+ *     Ecole Nationale Superieure de Geologie - GeoRessources
+ *     2 Rue du Doyen Marcel Roubault - TSA 70605
+ *     54518 VANDOEUVRE-LES-NANCY
+ *     FRANCE
+ */
+
+
+#include <ringmesh/ringmesh_tests_config.h>
+
+#include <algorithm>
+#include <array>
+#include <stack>
+#include <vector>
+
+#include <geogram/mesh/mesh.h>
+
+#include <ringmesh/geomodel/builder/geomodel_builder_from_mesh.h>
+#include <ringmesh/geomodel/core/geomodel.h>
+#include <ringmesh/geomodel/core/geomodel_mesh_entity.h>
+
+#include <ringmesh/mesh/mesh_index.h>
+
+/*!
+ * Tests the Surfaces built from the connected components of a mesh:
+ * squares of several sizes, two strips whose triangles are interleaved in
+ * the input, squares touching at a single vertex and an isolated triangle.
+ * The Surfaces are compared with the components given by a sequential
+ * propagation from the smallest facet of each component.
+ */
+
+using namespace RINGMesh;
+
+using Polygon = std::array< double, 9 >;
+
+void add_square( GEO::Mesh& mesh,
+    const vec3& origin,
+    const vec3& u_axis,
+    const vec3& v_axis,
+    index_t nb_subdivisions )
+{
+    auto nb_points = nb_subdivisions + 1;
+    auto first = mesh.vertices.create_vertices( nb_points * nb_points );
+    for( auto i : range( nb_points ) )
+    {
+        for( auto j : range( nb_points ) )
+        {
+            mesh.vertices.point( first + i * nb_points + j ) =
+                origin + ( double( i ) / nb_subdivisions ) * u_axis
+                + ( double( j ) / nb_subdivisions ) * v_axis;
+        }
+    }
+    for( auto i : range( nb_subdivisions ) )
+    {
+        for( auto j : range( nb_subdivisions ) )
+        {
+            auto v00 = first + i * nb_points + j;
+            auto v10 = v00 + nb_points;
+            mesh.facets.create_triangle( v00, v10, v10 + 1 );
+            mesh.facets.create_triangle( v00, v10 + 1, v00 + 1 );
+        }
+    }
+}
+
+/*!
+ * Two parallel strips of triangles, created alternately
+ */
+void add_interleaved_strips( GEO::Mesh& mesh, index_t nb_triangles )
+{
+    auto nb_points = nb_triangles / 2 + 1;
+    std::array< index_t, 2 > first;
+    for( auto strip : range( 2 ) )
+    {
+        first[strip] = mesh.vertices.create_vertices( 2 * nb_points );
+        for( auto i : range( nb_points ) )
+        {
+            mesh.vertices.point( first[strip] + 2 * i ) =
+                vec3( double( i ), 10. + strip, 0 );
+            mesh.vertices.point( first[strip] + 2 * i + 1 ) =
+                vec3( double( i ), 10.5 + strip, 0 );
+        }
+    }
+    for( auto t : range( nb_triangles ) )
+    {
+        for( auto strip : range( 2 ) )
+        {
+            auto v = first[strip] + 2 * ( t / 2 );
+            if( t % 2 == 0 )
+            {
+                mesh.facets.create_triangle( v, v + 2, v + 1 );
+            }
+            else
+            {
+                mesh.facets.create_triangle( v + 1, v + 2, v + 3 );
+            }
+        }
+    }
+}
+
+void build_mesh( GEO::Mesh& mesh )
+{
+    vec3 x( 1, 0, 0 );
+    vec3 y( 0, 1, 0 );
+    add_square( mesh, vec3( 0, 0, 0 ), x, y, 3 );
+    add_interleaved_strips( mesh, 6 );
+    add_square( mesh, vec3( 2, 0, 0 ), x, y, 1 );
+    // Touches the previous square at its corner
+    add_square( mesh, vec3( 3, 1, 0 ), x, y, 2 );
+    auto v = mesh.vertices.create_vertices( 3 );
+    mesh.vertices.point( v ) = vec3( 0, 5, 0 );
+    mesh.vertices.point( v + 1 ) = vec3( 1, 5, 0 );
+    mesh.vertices.point( v + 2 ) = vec3( 0, 6, 0 );
+    mesh.facets.create_triangle( v, v + 1, v + 2 );
+    add_square( mesh, vec3( 5, 0, 0 ), x, y, 5 );
+    mesh.facets.connect();
+}
+
+Polygon mesh_polygon( const GEO::Mesh& mesh, index_t facet )
+{
+    Polygon polygon;
+    for( auto v : range( 3 ) )
+    {
+        const auto& point =
+            mesh.vertices.point( mesh.facets.vertex( facet, v ) );
+        for( auto i : range( 3 ) )
+        {
+            polygon[3 * v + i] = point[i];
+        }
+    }
+    return polygon;
+}
+
+/*!
+ * Facets of each connected component, propagated sequentially from the
+ * smallest facet of the component
+ */
+std::vector< std::vector< Polygon > > sequential_components(
+    const GEO::Mesh& mesh )
+{
+    std::vector< std::vector< Polygon > > components;
+    std::vector< bool > visited( mesh.facets.nb(), false );
+    for( auto f : range( mesh.facets.nb() ) )
+    {
+        if( visited[f] )
+        {
+            continue;
+        }
+        components.emplace_back();
+        std::stack< index_t > S;
+        S.push( f );
+        visited[f] = true;
+        while( !S.empty() )
+        {
+            auto cur = S.top();
+            S.pop();
+            components.back().push_back( mesh_polygon( mesh, cur ) );
+            for( auto c : range( mesh.facets.corners_begin( cur ),
+                     mesh.facets.corners_end( cur ) ) )
+            {
+                auto n = mesh.facet_corners.adjacent_facet( c );
+                if( n != NO_ID && !visited[n] )
+                {
+                    visited[n] = true;
+                    S.push( n );
+                }
+            }
+        }
+        std::sort( components.back().begin(), components.back().end() );
+    }
+    return components;
+}
+
+std::vector< Polygon > surface_polygons( const Surface3D& surface )
+{
+    std::vector< Polygon > polygons;
+    for( auto p : range( surface.nb_mesh_elements() ) )
+    {
+        Polygon polygon;
+        for( auto v : range( 3 ) )
+        {
+            const auto& point = surface.mesh_element_vertex( { p, v } );
+            for( auto i : range( 3 ) )
+            {
+                polygon[3 * v + i] = point[i];
+            }
+        }
+        polygons.push_back( polygon );
+    }
+    std::sort( polygons.begin(), polygons.end() );
+    return polygons;
+}
+
+void test_surfaces_from_connected_components()
+{
+    GEO::Mesh mesh;
+    build_mesh( mesh );
+    auto components = sequential_components( mesh );
+
+    GeoModel3D geomodel;
+    GeoModelBuilderSurfaceMesh builder( geomodel, mesh );
+    builder.build_polygonal_surfaces_from_connected_components();
+
+    if( geomodel.nb_surfaces() != components.size() )
+    {
+        throw RINGMeshException( "RINGMesh Test", geomodel.nb_surfaces(),
+            " Surfaces built instead of ", components.size() );
+    }
+    for( const auto& surface : geomodel.surfaces() )
+    {
+        const auto& expected = components[surface.index()];
+        if( surface.nb_mesh_elements() != expected.size() )
+        {
+            throw RINGMeshException( "RINGMesh Test", surface.gmme(), " has ",
+                surface.nb_mesh_elements(), " polygons instead of ",
+                expected.size() );
+        }
+        if( surface_polygons( surface ) != expected )
+        {
+            throw RINGMeshException(
+                "RINGMesh Test", surface.gmme(), " has wrong polygons" );
+        }
+    }
+}
+
+int main()
+{
+    try
+    {
+        test_surfaces_from_connected_components();
+    }
+    catch( const RINGMeshException& e )
+    {
+        Logger::err( e.category(), e.what() );
+        return 1;
+    }
+    catch( const std::exception& e )
+    {
+        Logger::err( "Exception", e.what() );
+        return 1;
+    }
+    Logger::out( "TEST", "SUCCESS" );
+    return 0;
+}
@@ -0,0 +1,357 @@
+/*
+ * Copyright (c) 2012-2018, Association Scientifique pour la Geologie et ses
+ * Applications (ASGA). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of ASGA nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL ASGA BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *     http://www.ring-team.org
+ *
+ *     RING Project
+ *     Ecole Nationale Superieure de Geologie - GeoRessources
+ *     2 Rue du Doyen Marcel Roubault - TSA 70605
+ *     54518 VANDOEUVRE-LES-NANCY
+ *     FRANCE
+ */
+
+#include <ringmesh/ringmesh_tests_config.h>
+
+#include <array>
+#include <map>
+
+#include <geogram/mesh/mesh.h>
+
+#include <ringmesh/geomodel/builder/geomodel_builder.h>
+#include <ringmesh/geomodel/builder/geomodel_builder_from_mesh.h>
+#include <ringmesh/geomodel/core/geomodel.h>
+#include <ringmesh/geomodel/core/geomodel_mesh_entity.h>
+#include <ringmesh/geomodel/core/well.h>
+
+#include <ringmesh/mesh/mesh_index.h>
+
+/*!
+ * Tests the GeoModelMesh cells crossed by the wells.
+ * The unit cube is split into the 6 tetrahedra sharing its diagonal from
+ * (0,0,0) to (1,1,1): the tetrahedron containing a point is given by the
+ * order of its coordinates, which gives the reference intersections.
+ */
+
+using namespace RINGMesh;
+
+using CoordinateOrder = std::array< index_t, 3 >;
+
+const double tolerance = 1e-9;
+
+void add_square( GEO::Mesh& mesh,
+    const vec3& origin,
+    const vec3& u_axis,
+    const vec3& v_axis )
+{
+    auto first = mesh.vertices.create_vertices( 4 );
+    mesh.vertices.point( first ) = origin;
+    mesh.vertices.point( first + 1 ) = origin + u_axis;
+    mesh.vertices.point( first + 2 ) = origin + u_axis + v_axis;
+    mesh.vertices.point( first + 3 ) = origin + v_axis;
+    mesh.facets.create_triangle( first, first + 1, first + 2 );
+    mesh.facets.create_triangle( first, first + 2, first + 3 );
+}
+
+/*!
+ * Order of the coordinates of a point, from the largest to the smallest
+ */
+CoordinateOrder coordinate_order( const vec3& point )
+{
+    CoordinateOrder order{ { 0, 1, 2 } };
+    std::sort( order.begin(), order.end(), [&point]( index_t a, index_t b ) {
+        return point[a] > point[b];
+    } );
+    return order;
+}
+
+void build_tetrahedralized_cube( GeoModel3D& geomodel )
+{
+    GEO::Mesh mesh;
+    vec3 x( 1, 0, 0 );
+    vec3 y( 0, 1, 0 );
+    vec3 z( 0, 0, 1 );
+    add_square( mesh, vec3(), y, z );
+    add_square( mesh, x, y, z );
+    add_square( mesh, vec3(), x, z );
+    add_square( mesh, y, x, z );
+    add_square( mesh, vec3(), x, y );
+    add_square( mesh, z, x, y );
+    mesh.facets.connect();
+
+    GeoModelBuilderSurfaceMesh builder( geomodel, mesh );
+    builder.build_polygonal_surfaces_from_connected_components();
+    builder.build_lines_and_corners_from_surfaces();
+    builder.build_regions_from_lines_and_surfaces();
+    builder.end_geomodel();
+
+    // One tetrahedron per coordinate order, from (0,0,0) to (1,1,1)
+    // by increasing the coordinates in this order
+    std::vector< vec3 > points;
+    std::vector< index_t > tetras;
+    CoordinateOrder order{ { 0, 1, 2 } };
+    do
+    {
+        vec3 point;
+        tetras.push_back( static_cast< index_t >( points.size() ) );
+        points.push_back( point );
+        for( auto coordinate : order )
+        {
+            point[coordinate] = 1;
+            tetras.push_back( static_cast< index_t >( points.size() ) );
+            points.push_back( point );
+        }
+    } while( std::next_permutation( order.begin(), order.end() ) );
+    GeoModelBuilder3D geometry_builder( geomodel );
+    geometry_builder.geometry.set_region_geometry( 0, points, tetras );
+    // The GeoModelMesh is re-computed with the Region cells
+    geomodel.mesh.vertices.clear();
+}
+
+void add_wells( WellGroup3D& wells )
+{
+    WellTrajectories trajectories;
+    auto add_trajectory = [&trajectories]( const std::string& name,
+        const std::vector< vec3 >& vertices ) {
+        trajectories.names.push_back( name );
+        for( const auto& vertex : vertices )
+        {
+            trajectories.x.push_back( vertex.x );
+            trajectories.y.push_back( vertex.y );
+            trajectories.z.push_back( vertex.z );
+        }
+        trajectories.offsets.push_back(
+            static_cast< index_t >( trajectories.x.size() ) );
+    };
+    // Crosses 3 tetrahedra between the top and the bottom of the cube
+    add_trajectory(
+        "vertical", { vec3( 0.2, 0.6, 1.5 ), vec3( 0.2, 0.6, -0.5 ) } );
+    add_trajectory( "deviated",
+        { vec3( -0.5, 0.3, 0.4 ), vec3( 0.5, 0.5, 0.42 ),
+            vec3( 1.5, 0.7, 0.45 ) } );
+    add_trajectory( "inside",
+        { vec3( 0.1, 0.2, 0.3 ), vec3( 0.8, 0.55, 0.4 ),
+            vec3( 0.6, 0.9, 0.7 ) } );
+    wells.add_wells( trajectories );
+}
+
+/*!
+ * Cells crossed by the segment [p0, p1] computed from the coordinate
+ * orders: the segment changes of tetrahedron where two coordinates are
+ * equal and leaves the cube where a coordinate is 0 or 1
+ */
+std::vector< WellEdgeCellIntersection > reference_intersections(
+    const std::map< CoordinateOrder, index_t >& cells,
+    const vec3& p0,
+    const vec3& p1 )
+{
+    auto direction = p1 - p0;
+    std::vector< double > parameters{ 0, 1 };
+    auto add_parameter = [&parameters]( double value, double speed ) {
+        if( speed != 0 )
+        {
+            auto t = value / speed;
+            if( t > 0 && t < 1 )
+            {
+                parameters.push_back( t );
+            }
+        }
+    };
+    for( auto i : range( 3 ) )
+    {
+        add_parameter( -p0[i], direction[i] );
+        add_parameter( 1 - p0[i], direction[i] );
+        for( auto j : range( i + 1, 3 ) )
+        {
+            add_parameter( p0[j] - p0[i], direction[i] - direction[j] );
+        }
+    }
+    std::sort( parameters.begin(), parameters.end() );
+
+    std::vector< WellEdgeCellIntersection > intersections;
+    for( auto p : range( parameters.size() - 1 ) )
+    {
+        auto entry = parameters[p];
+        auto exit = parameters[p + 1];
+        if( exit - entry < tolerance )
+        {
+            continue;
+        }
+        auto middle = p0 + 0.5 * ( entry + exit ) * direction;
+        if( std::min( std::min( middle.x, middle.y ), middle.z ) < 0
+            || std::max( std::max( middle.x, middle.y ), middle.z ) > 1 )
+        {
+            continue;
+        }
+        auto cell = cells.at( coordinate_order( middle ) );
+        if( !intersections.empty() && intersections.back().cell == cell
+            && std::abs( intersections.back().exit - entry ) < tolerance )
+        {
+            intersections.back().exit = exit;
+        }
+        else
+        {
+            intersections.emplace_back( cell, entry, exit );
+        }
+    }
+    return intersections;
+}
+
+void check_well_edges( const GeoModel3D& geomodel, const WellGroup3D& wells )
+{
+    const auto& mesh_wells = geomodel.mesh.wells;
+    if( mesh_wells.nb_wells() != wells.nb_wells() )
+    {
+        throw RINGMeshException( "RINGMesh Test", "Wrong number of wells" );
+    }
+    index_t nb_edges{ 0 };
+    for( auto w : range( wells.nb_wells() ) )
+    {
+        if( mesh_wells.nb_edges( w ) != wells.well( w ).nb_edges() )
+        {
+            throw RINGMeshException( "RINGMesh Test", "Well ", w, " has ",
+                mesh_wells.nb_edges( w ), " mesh edges instead of ",
+                wells.well( w ).nb_edges() );
+        }
+        nb_edges += wells.well( w ).nb_edges();
+    }
+    if( mesh_wells.nb_edges() != nb_edges )
+    {
+        throw RINGMeshException( "RINGMesh Test", "The wells have ",
+            mesh_wells.nb_edges(), " mesh edges instead of ", nb_edges );
+    }
+}
+
+void check_cell_intersections(
+    const GeoModel3D& geomodel, const WellGroup3D& wells )
+{
+    const auto& mesh_cells = geomodel.mesh.cells;
+    if( mesh_cells.nb() != 6 )
+    {
+        throw RINGMeshException( "RINGMesh Test", "The cube has ",
+            mesh_cells.nb(), " cells instead of 6" );
+    }
+    std::map< CoordinateOrder, index_t > cells;
+    for( auto c : range( mesh_cells.nb() ) )
+    {
+        cells[coordinate_order( mesh_cells.barycenter( c ) )] = c;
+    }
+
+    const auto& mesh_wells = geomodel.mesh.wells;
+    for( auto w : range( wells.nb_wells() ) )
+    {
+        const auto& well = wells.well( w );
+        std::vector< index_t > perforated_cells;
+        index_t edge{ 0 };
+        for( auto p : range( well.nb_parts() ) )
+        {
+            const auto& part = well.part( p );
+            for( auto e : range( part.nb_edges() ) )
+            {
+                auto intersections = reference_intersections( cells,
+                    part.edge_vertex( ElementLocalVertex( e, 0 ) ),
+                    part.edge_vertex( ElementLocalVertex( e, 1 ) ) );
+                if( mesh_wells.nb_cell_intersections( w, edge )
+                    != intersections.size() )
+                {
+                    throw RINGMeshException( "RINGMesh Test", "Edge ", edge,
+                        " of well ", well.name(), " crosses ",
+                        mesh_wells.nb_cell_intersections( w, edge ),
+                        " cells instead of ", intersections.size() );
+                }
+                for( auto i : range( intersections.size() ) )
+                {
+                    const auto& result =
+                        mesh_wells.cell_intersection( w, edge, i );
+                    const auto& reference = intersections[i];
+                    if( result.cell != reference.cell
+                        || std::abs( result.entry - reference.entry )
+                               > tolerance
+                        || std::abs( result.exit - reference.exit )
+                               > tolerance )
+                    {
+                        throw RINGMeshException( "RINGMesh Test",
+                            "Wrong intersection ", i, " of edge ", edge,
+                            " of well ", well.name(), ": cell ", result.cell,
+                            " from ", result.entry, " to ", result.exit,
+                            " instead of cell ", reference.cell, " from ",
+                            reference.entry, " to ", reference.exit );
+                    }
+                    if( std::find( perforated_cells.begin(),
+                            perforated_cells.end(), reference.cell )
+                        == perforated_cells.end() )
+                    {
+                        perforated_cells.push_back( reference.cell );
+                    }
+                }
+                edge++;
+            }
+        }
+        if( mesh_wells.perforated_cells( w ) != perforated_cells )
+        {
+            throw RINGMeshException( "RINGMesh Test",
+                "Wrong perforated cells of well ", well.name() );
+        }
+    }
+
+    // The vertical well crosses the 3 tetrahedra where y > x
+    auto vertical = wells.find_well( "vertical" );
+    if( mesh_wells.perforated_cells( vertical ).size() != 3 )
+    {
+        throw RINGMeshException( "RINGMesh Test", "The vertical well crosses ",
+            mesh_wells.perforated_cells( vertical ).size(),
+            " cells instead of 3" );
+    }
+}
+
+int main()
+{
+    try
+    {
+        Logger::out( "TEST", "Test the cells crossed by wells" );
+        GeoModel3D geomodel;
+        build_tetrahedralized_cube( geomodel );
+
+        WellGroup3D wells;
+        wells.set_geomodel( &geomodel );
+        add_wells( wells );
+        geomodel.set_wells( &wells );
+
+        check_well_edges( geomodel, wells );
+        check_cell_intersections( geomodel, wells );
+    }
+    catch( const RINGMeshException& e )
+    {
+        Logger::err( e.category(), e.what() );
+        return 1;
+    }
+    catch( const std::exception& e )
+    {
+        Logger::err( "Exception", e.what() );
+        return 1;
+    }
+    Logger::out( "TEST", "SUCCESS" );
+    return 0;
+}
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2012-2018, Association Scientifique pour la Geologie et ses
+ * Applications (ASGA). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of ASGA nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL ASGA BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *     http://www.ring-team.org
+ *
+ *     RING Project
+ *     Ecole Nationale Superieure de Geologie - GeoRessources
+ *     2 Rue du Doyen Marcel Roubault - TSA 70605
+ *     54518 VANDOEUVRE-LES-NANCY
+ *     FRANCE
+ */
+
+#include <ringmesh/ringmesh_tests_config.h>
+
+#include <vector>
+
+#include <ringmesh/basic/geometry.h>
+#include <ringmesh/geomodel/core/geomodel.h>
+#include <ringmesh/geomodel/core/geomodel_aabb.h>
+#include <ringmesh/geomodel/core/geomodel_mesh_entity.h>
+
+#include <ringmesh/io/io.h>
+
+#include <ringmesh/mesh/mesh_index.h>
+
+using namespace RINGMesh;
+
+std::vector< Geometry::Segment3D > create_segments( const GeoModel3D& geomodel )
+{
+    Box3D box;
+    for( const auto& surface : geomodel.surfaces() )
+    {
+        for( auto v : range( surface.nb_vertices() ) )
+        {
+            box.add_point( surface.vertex( v ) );
+        }
+    }
+    const auto& min = box.min();
+    const auto diagonal = box.diagonal();
+    const index_t nb_steps{ 10 };
+    std::vector< Geometry::Segment3D > segments;
+    for( auto i : range( nb_steps ) )
+    {
+        for( auto j : range( nb_steps ) )
+        {
+            vec3 start{ min.x + diagonal.x * ( i + 0.37 ) / nb_steps,
+                min.y + diagonal.y * ( j + 0.61 ) / nb_steps,
+                min.z - 0.1 * diagonal.z };
+            vec3 end{ min.x + diagonal.x * ( j + 0.23 ) / nb_steps,
+                min.y + diagonal.y * ( i + 0.71 ) / nb_steps,
+                min.z + 1.1 * diagonal.z };
+            segments.emplace_back( start, end );
+        }
+    }
+    return segments;
+}
+
+index_t nb_brute_force_intersections(
+    const GeoModel3D& geomodel, const Geometry::Segment3D& segment )
+{
+    index_t nb_intersections{ 0 };
+    for( const auto& surface : geomodel.surfaces() )
+    {
+        for( auto triangle : range( surface.nb_mesh_elements() ) )
+        {
+            bool does_intersect{ false };
+            std::tie( does_intersect, std::ignore ) =
+                Intersection::segment_triangle( segment,
+                    { surface.mesh_element_vertex( { triangle, 0 } ),
+                        surface.mesh_element_vertex( { triangle, 1 } ),
+                        surface.mesh_element_vertex( { triangle, 2 } ) } );
+            if( does_intersect )
+            {
+                nb_intersections++;
+            }
+        }
+    }
+    return nb_intersections;
+}
+
+void test_segment_intersections( const GeoModel3D& geomodel )
+{
+    GeoModelSurfacesAABBTree3D tree( geomodel );
+    auto segments = create_segments( geomodel );
+    auto result = tree.segment_intersections( segments );
+    if( result.offsets.size() != segments.size() + 1
+        || result.offsets.back() != result.intersections.size() )
+    {
+        throw RINGMeshException( "TEST", "Wrong intersection offsets" );
+    }
+    index_t nb_intersections{ 0 };
+    for( auto s : range( segments.size() ) )
+    {
+        const auto begin = result.offsets[s];
+        const auto end = result.offsets[s + 1];
+        if( end - begin
+            != nb_brute_force_intersections( geomodel, segments[s] ) )
+        {
+            throw RINGMeshException(
+                "TEST", "Wrong number of intersections for segment ", s );
+        }
+        for( auto i : range( begin, end ) )
+        {
+            const auto& intersection = result.intersections[i];
+            if( i > begin
+                && intersection.distance
+                       < result.intersections[i - 1].distance )
+            {
+                throw RINGMeshException(
+                    "TEST", "Intersections not sorted for segment ", s );
+            }
+        }
+        nb_intersections += end - begin;
+    }
+    if( nb_intersections == 0 )
+    {
+        throw RINGMeshException( "TEST", "No intersection found" );
+    }
+}
+
+int main()
+{
+    using namespace RINGMesh;
+
+    try
+    {
+        Logger::out( "TEST", "Test GeoModel Surfaces AABB tree" );
+
+        std::string input_model_file_name =
+            ringmesh_test_data_path + "modelA6.ml";
+
+        GeoModel3D in;
+        bool loaded_model_is_valid = geomodel_load( in, input_model_file_name );
+
+        if( !loaded_model_is_valid )
+        {
+            throw RINGMeshException(
+                "RINGMesh Test", "Failed when loading model ", in.name() );
+        }
+        test_segment_intersections( in );
+    }
+    catch( const RINGMeshException& e )
+    {
+        Logger::err( e.category(), e.what() );
+        return 1;
+    }
+    catch( const std::exception& e )
+    {
+        Logger::err( "Exception", e.what() );
+        return 1;
+    }
+    Logger::out( "TEST", "SUCCESS" );
+    return 0;
+}
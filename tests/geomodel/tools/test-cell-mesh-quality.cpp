@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2012-2018, Association Scientifique pour la Geologie et ses
+ * Applications (ASGA). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of ASGA nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL ASGA BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *     http://www.ring-team.org
+ *
+ *     RING Project
+ *     Ecole Nationale Superieure de Geologie - GeoRessources
+ *     2 Rue du Doyen Marcel Roubault - TSA 70605
+ *     54518 VANDOEUVRE-LES-NANCY
+ *     FRANCE
+ */
+
+
+#include <ringmesh/ringmesh_tests_config.h>
+
+#include <array>
+
+#include <geogram/basic/attributes.h>
+
+#include <ringmesh/geomodel/builder/geomodel_builder.h>
+#include <ringmesh/geomodel/core/geomodel.h>
+#include <ringmesh/geomodel/core/geomodel_mesh_entity.h>
+#include <ringmesh/geomodel/tools/mesh_quality.h>
+
+/*!
+ * Tests the cell qualities of hexahedra, prisms and pyramids, and the
+ * statistics of the cells with a null edge.
+ */
+
+using namespace RINGMesh;
+
+struct TestCell
+{
+    CellType type;
+    std::vector< vec3 > points;
+    std::array< double, 3 > qualities;
+};
+
+const std::array< CellQualityMode, 3 > quality_modes{ { SCALED_JACOBIAN,
+    EQUIANGLE_SKEWNESS, EDGE_ASPECT_RATIO } };
+
+const std::array< std::string, 3 > quality_names{ { "SCALED_JACOBIAN",
+    "EQUIANGLE_SKEWNESS", "EDGE_ASPECT_RATIO" } };
+
+/*!
+ * Hexahedron vertices are numbered by their x, y and z bits
+ */
+std::vector< vec3 > hex_points( const vec3& size, double shear )
+{
+    std::vector< vec3 > points;
+    for( auto v : range( 8 ) )
+    {
+        auto z = static_cast< double >( v >> 2 );
+        points.emplace_back( ( v & 1 ) * size.x + z * shear,
+            ( ( v >> 1 ) & 1 ) * size.y, z * size.z );
+    }
+    return points;
+}
+
+std::vector< TestCell > test_cells()
+{
+    auto h = 1. / std::sqrt( 2. );
+    auto s = std::sqrt( 3. ) / 2.;
+    auto inverted = hex_points( vec3( 1, 1, 1 ), 0 );
+    std::rotate( inverted.begin(), inverted.begin() + 4, inverted.end() );
+    auto degenerate = hex_points( vec3( 1, 1, 1 ), 0 );
+    degenerate[1] = degenerate[0];
+    return { { CellType::HEXAHEDRON, hex_points( vec3( 1, 1, 1 ), 0 ),
+                 { { 1., 0., 1. } } },
+        { CellType::HEXAHEDRON, hex_points( vec3( 2, 1, 1 ), 0 ),
+            { { 1., 0., 2. } } },
+        { CellType::HEXAHEDRON, hex_points( vec3( 1, 1, 1 ), 1 ),
+            { { h, 0.5, std::sqrt( 2. ) } } },
+        { CellType::HEXAHEDRON, inverted, { { -1., 0., 1. } } },
+        { CellType::PRISM,
+            { vec3( 0, 0, 0 ), vec3( 1, 0, 0 ), vec3( 0.5, s, 0 ),
+                vec3( 0, 0, 1 ), vec3( 1, 0, 1 ), vec3( 0.5, s, 1 ) },
+            { { 1., 0., 1. } } },
+        { CellType::PYRAMID,
+            { vec3( 0, 0, 0 ), vec3( 1, 0, 0 ), vec3( 1, 1, 0 ),
+                vec3( 0, 1, 0 ), vec3( 0.5, 0.5, h ) },
+            { { 1., 0., 1. } } },
+        { CellType::HEXAHEDRON, degenerate, { { 0., 1., max_float64() } } } };
+}
+
+void build_region( GeoModel3D& geomodel, const std::vector< TestCell >& cells )
+{
+    GeoModelBuilder3D builder( geomodel );
+    auto region =
+        builder.topology.create_mesh_entity( Region3D::type_name_static() );
+    std::vector< vec3 > points;
+    for( const auto& cell : cells )
+    {
+        points.insert( points.end(), cell.points.begin(), cell.points.end() );
+    }
+    builder.geometry.set_mesh_entity_vertices( region, points, false );
+    index_t first_vertex{ 0 };
+    for( const auto& cell : cells )
+    {
+        std::vector< index_t > vertices;
+        for( auto v : range( cell.points.size() ) )
+        {
+            vertices.push_back( first_vertex + v );
+        }
+        builder.geometry.create_region_cell(
+            region.index(), cell.type, vertices );
+        first_vertex += static_cast< index_t >( cell.points.size() );
+    }
+}
+
+void test_cell_qualities(
+    const GeoModel3D& geomodel, const std::vector< TestCell >& cells )
+{
+    const auto& region = geomodel.region( 0 );
+    for( auto mode : range( quality_modes.size() ) )
+    {
+        compute_prop_cell_mesh_quality( quality_modes[mode], geomodel );
+        GEO::Attribute< double > qualities(
+            region.cell_attribute_manager(), quality_names[mode] );
+        for( auto c : range( cells.size() ) )
+        {
+            auto expected = cells[c].qualities[mode];
+            if( std::fabs( qualities[c] - expected ) > 1e-9 )
+            {
+                throw RINGMeshException( "RINGMesh Test", "Cell ", c,
+                    " has the ", quality_names[mode], " ", qualities[c],
+                    " instead of ", expected );
+            }
+        }
+    }
+}
+
+/*!
+ * The cell with a null edge is a low quality cell, out of the mean
+ */
+void test_edge_aspect_ratio_statistics(
+    const GeoModel3D& geomodel, const std::vector< TestCell >& cells )
+{
+    auto statistics = compute_cell_mesh_quality_statistics(
+        EDGE_ASPECT_RATIO, 1.5, geomodel );
+    double sum{ 0 };
+    index_t nb_low_quality_cells{ 0 };
+    for( const auto& cell : cells )
+    {
+        auto ratio = cell.qualities[EDGE_ASPECT_RATIO];
+        if( ratio != max_float64() )
+        {
+            sum += ratio;
+        }
+        if( ratio > 1.5 )
+        {
+            nb_low_quality_cells++;
+        }
+    }
+    auto nb_cells = static_cast< index_t >( cells.size() );
+    if( statistics.nb_cells != nb_cells
+        || statistics.nb_degenerate_cells != 1
+        || statistics.nb_low_quality_cells != nb_low_quality_cells )
+    {
+        throw RINGMeshException( "RINGMesh Test", "Statistics count ",
+            statistics.nb_cells, " cells, ", statistics.nb_degenerate_cells,
+            " degenerate and ", statistics.nb_low_quality_cells,
+            " of low quality instead of ", nb_cells, ", 1 and ",
+            nb_low_quality_cells );
+    }
+    auto mean = sum / ( nb_cells - 1 );
+    if( std::fabs( statistics.mean - mean ) > 1e-9
+        || statistics.max_value != 2. )
+    {
+        throw RINGMeshException( "RINGMesh Test", "Statistics mean and max ",
+            statistics.mean, " and ", statistics.max_value, " instead of ",
+            mean, " and 2" );
+    }
+}
+
+int main()
+{
+    try
+    {
+        auto cells = test_cells();
+        GeoModel3D geomodel;
+        build_region( geomodel, cells );
+        test_cell_qualities( geomodel, cells );
+        test_edge_aspect_ratio_statistics( geomodel, cells );
+    }
+    catch( const RINGMeshException& e )
+    {
+        Logger::err( e.category(), e.what() );
+        return 1;
+    }
+    catch( const std::exception& e )
+    {
+        Logger::err( "Exception", e.what() );
+        return 1;
+    }
+    Logger::out( "TEST", "SUCCESS" );
+    return 0;
+}
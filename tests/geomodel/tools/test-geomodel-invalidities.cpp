@@ -123,6 +123,34 @@ int main()
             }
         } ) );
 
+        futures.emplace_back( std::async( std::launch::async, [] {
+            std::string input_model_file_name{ ringmesh_test_data_path
+                                               + "modelA6.ml" };
+            GeoModel3D geomodel;
+            geomodel_load( geomodel, input_model_file_name );
+
+            GeoModel3D invalid_model;
+            make_geomodel_copy( geomodel, "broken model 2", invalid_model );
+            GeoModelValiditySession3D session(
+                invalid_model, ValidityCheckMode::TOPOLOGY );
+            if( session.is_geomodel_valid()
+                != is_geomodel_valid(
+                       invalid_model, ValidityCheckMode::TOPOLOGY ) )
+            {
+                throw RINGMeshException( "RINGMesh Test",
+                    "Validity session differs from the full check" );
+            }
+            GeoModelBuilder3D geomodel_breaker( invalid_model );
+            geomodel_breaker.topology.create_mesh_entity(
+                RINGMesh::Surface3D::type_name_static() );
+            if( session.is_geomodel_valid() )
+            {
+                throw RINGMeshException( "RINGMesh Test",
+                    "Validity session fails to detect addition of an "
+                    "isolated GeoModelMeshEntity" );
+            }
+        } ) );
+
         futures.emplace_back( std::async( std::launch::async, [] {
             GeoModel3D cloudspin;
             geomodel_load(
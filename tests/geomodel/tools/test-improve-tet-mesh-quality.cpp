@@ -0,0 +1,277 @@
+/*
+ * Copyright (c) 2012-2018, Association Scientifique pour la Geologie et ses
+ * Applications (ASGA). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of ASGA nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL ASGA BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *     http://www.ring-team.org
+ *
+ *     RING Project
+ *     Ecole Nationale Superieure de Geologie - GeoRessources
+ *     2 Rue du Doyen Marcel Roubault - TSA 70605
+ *     54518 VANDOEUVRE-LES-NANCY
+ *     FRANCE
+ */
+
+
+#include <ringmesh/ringmesh_tests_config.h>
+
+#include <geogram/basic/command_line.h>
+#include <geogram/basic/geometry.h>
+#include <geogram/mesh/mesh.h>
+
+#include <ringmesh/geomodel/builder/geomodel_builder_from_mesh.h>
+#include <ringmesh/geomodel/core/geomodel.h>
+#include <ringmesh/geomodel/core/geomodel_mesh_entity.h>
+#include <ringmesh/geomodel/tools/geomodel_tools.h>
+#include <ringmesh/geomodel/tools/mesh_quality.h>
+#include <ringmesh/mesh/mesh_builder.h>
+#include <ringmesh/mesh/mesh_index.h>
+#include <ringmesh/mesh/volume_mesh.h>
+
+/*!
+ * Tests the improvement of the low quality tetrahedra of a meshed cube
+ * GeoModel: the improved mesh must be valid, not worse, and independent
+ * of the multithreading.
+ */
+
+using namespace RINGMesh;
+
+#ifdef RINGMESH_WITH_TETGEN
+
+const index_t nb_subdivisions = 4;
+const MeshQualityMode quality_mode =
+    MeshQualityMode::INSPHERE_RADIUS_BY_CIRCUMSPHERE_RADIUS;
+
+void add_square( GEO::Mesh& mesh,
+    const vec3& origin,
+    const vec3& u_axis,
+    const vec3& v_axis )
+{
+    auto nb_points = nb_subdivisions + 1;
+    auto first = mesh.vertices.create_vertices( nb_points * nb_points );
+    for( auto i : range( nb_points ) )
+    {
+        for( auto j : range( nb_points ) )
+        {
+            mesh.vertices.point( first + i * nb_points + j ) =
+                origin + ( double( i ) / nb_subdivisions ) * u_axis
+                + ( double( j ) / nb_subdivisions ) * v_axis;
+        }
+    }
+    for( auto i : range( nb_subdivisions ) )
+    {
+        for( auto j : range( nb_subdivisions ) )
+        {
+            auto v00 = first + i * nb_points + j;
+            auto v10 = v00 + nb_points;
+            mesh.facets.create_triangle( v00, v10, v10 + 1 );
+            mesh.facets.create_triangle( v00, v10 + 1, v00 + 1 );
+        }
+    }
+}
+
+void build_meshed_cube( GeoModel3D& geomodel )
+{
+    GEO::Mesh mesh;
+    vec3 x( 1, 0, 0 );
+    vec3 y( 0, 1, 0 );
+    vec3 z( 0, 0, 1 );
+    add_square( mesh, vec3(), y, z );
+    add_square( mesh, x, y, z );
+    add_square( mesh, vec3(), x, z );
+    add_square( mesh, y, x, z );
+    add_square( mesh, vec3(), x, y );
+    add_square( mesh, z, x, y );
+    mesh.facets.connect();
+
+    GeoModelBuilderSurfaceMesh builder( geomodel, mesh );
+    builder.build_polygonal_surfaces_from_connected_components();
+    builder.build_lines_and_corners_from_surfaces();
+    builder.build_regions_from_lines_and_surfaces();
+    builder.end_geomodel();
+    tetrahedralize( geomodel, NO_ID, true );
+}
+
+double tet_signed_volume( const VolumeMesh3D& mesh, index_t cell )
+{
+    return GEO::Geom::tetra_signed_volume(
+        mesh.vertex( mesh.cell_vertex( { cell, 0 } ) ),
+        mesh.vertex( mesh.cell_vertex( { cell, 1 } ) ),
+        mesh.vertex( mesh.cell_vertex( { cell, 2 } ) ),
+        mesh.vertex( mesh.cell_vertex( { cell, 3 } ) ) );
+}
+
+/*!
+ * The tets must have the orientation of the first one and fill the cube
+ */
+void check_no_inverted_tet( const Region3D& region )
+{
+    const auto& mesh = region.mesh();
+    auto orientation = tet_signed_volume( mesh, 0 ) > 0 ? 1. : -1.;
+    double volume{ 0 };
+    for( auto c : range( mesh.nb_cells() ) )
+    {
+        auto signed_volume = orientation * tet_signed_volume( mesh, c );
+        if( signed_volume <= 0 )
+        {
+            throw RINGMeshException(
+                "RINGMesh Test", "Tet ", c, " is inverted or flat" );
+        }
+        volume += signed_volume;
+    }
+    if( std::fabs( volume - 1. ) > global_epsilon )
+    {
+        throw RINGMeshException(
+            "RINGMesh Test", "Tets volume is ", volume, " instead of 1" );
+    }
+}
+
+/*!
+ * The cell adjacencies must be the ones recomputed from the cells
+ */
+void check_adjacencies( const Region3D& region )
+{
+    const auto& mesh = region.mesh();
+    auto connected = VolumeMesh3D::create_mesh();
+    auto builder = VolumeMeshBuilder3D::create_builder( *connected );
+    builder->create_vertices( mesh.nb_vertices() );
+    for( auto v : range( mesh.nb_vertices() ) )
+    {
+        builder->set_vertex( v, mesh.vertex( v ) );
+    }
+    builder->create_cells( mesh.nb_cells(), CellType::TETRAHEDRON );
+    for( auto c : range( mesh.nb_cells() ) )
+    {
+        for( auto v : range( mesh.nb_cell_vertices( c ) ) )
+        {
+            builder->set_cell_vertex(
+                { c, v }, mesh.cell_vertex( { c, v } ) );
+        }
+    }
+    builder->connect_cells();
+    for( auto c : range( mesh.nb_cells() ) )
+    {
+        for( auto f : range( mesh.nb_cell_facets( c ) ) )
+        {
+            if( mesh.cell_adjacent( { c, f } )
+                != connected->cell_adjacent( { c, f } ) )
+            {
+                throw RINGMeshException( "RINGMesh Test",
+                    "Wrong adjacent for facet ", f, " of tet ", c );
+            }
+        }
+    }
+}
+
+void check_same_region_meshes( const Region3D& region, const Region3D& other )
+{
+    const auto& mesh = region.mesh();
+    const auto& other_mesh = other.mesh();
+    if( mesh.nb_vertices() != other_mesh.nb_vertices()
+        || mesh.nb_cells() != other_mesh.nb_cells() )
+    {
+        throw RINGMeshException( "RINGMesh Test",
+            "Multithreaded improvement gives ", mesh.nb_cells(),
+            " tets instead of ", other_mesh.nb_cells() );
+    }
+    for( auto v : range( mesh.nb_vertices() ) )
+    {
+        if( mesh.vertex( v ) != other_mesh.vertex( v ) )
+        {
+            throw RINGMeshException( "RINGMesh Test",
+                "Multithreaded improvement moves vertex ", v, " elsewhere" );
+        }
+    }
+    for( auto c : range( mesh.nb_cells() ) )
+    {
+        for( auto v : range( mesh.nb_cell_vertices( c ) ) )
+        {
+            if( mesh.cell_vertex( { c, v } )
+                != other_mesh.cell_vertex( { c, v } ) )
+            {
+                throw RINGMeshException( "RINGMesh Test",
+                    "Multithreaded improvement gives another tet ", c );
+            }
+        }
+    }
+}
+
+void test_improve_tet_mesh_quality()
+{
+    GeoModel3D geomodel;
+    build_meshed_cube( geomodel );
+    GeoModel3D sequential_geomodel;
+    copy_geomodel( geomodel, sequential_geomodel );
+
+    // The half of the tets of lowest quality are improved
+    auto before = compute_tet_mesh_quality_statistics(
+        quality_mode, 0., geomodel );
+    auto min_quality = before.median;
+
+    GEO::CmdLine::set_arg( "sys:multithread", false );
+    improve_tet_mesh_quality( quality_mode, min_quality, sequential_geomodel );
+    GEO::CmdLine::set_arg( "sys:multithread", true );
+    improve_tet_mesh_quality( quality_mode, min_quality, geomodel );
+
+    auto after = compute_tet_mesh_quality_statistics(
+        quality_mode, min_quality, geomodel );
+    if( after.min_value < before.min_value )
+    {
+        throw RINGMeshException( "RINGMesh Test", "Minimal quality drops from ",
+            before.min_value, " to ", after.min_value );
+    }
+    if( after.nb_low_quality_cells >= before.nb_cells / 2 )
+    {
+        throw RINGMeshException( "RINGMesh Test", "No tet is improved" );
+    }
+    const auto& region = geomodel.region( 0 );
+    check_no_inverted_tet( region );
+    check_adjacencies( region );
+    check_same_region_meshes( region, sequential_geomodel.region( 0 ) );
+}
+
+#endif
+
+int main()
+{
+    try
+    {
+#ifdef RINGMESH_WITH_TETGEN
+        GEO::CmdLine::set_arg( "algo:tet", "TetGen" );
+        test_improve_tet_mesh_quality();
+#endif
+    }
+    catch( const RINGMeshException& e )
+    {
+        Logger::err( e.category(), e.what() );
+        return 1;
+    }
+    catch( const std::exception& e )
+    {
+        Logger::err( "Exception", e.what() );
+        return 1;
+    }
+    Logger::out( "TEST", "SUCCESS" );
+    return 0;
+}
@@ -36,7 +36,9 @@
 #include <ringmesh/ringmesh_tests_config.h>
 
 #include <geogram/basic/command_line.h>
+#include <ringmesh/geomodel/core/geomodel_mesh_entity.h>
 #include <ringmesh/geomodel/tools/geomodel_repair.h>
+#include <ringmesh/geomodel/tools/geomodel_tools.h>
 #include <ringmesh/geomodel/tools/geomodel_validity.h>
 #include <ringmesh/io/io.h>
 
@@ -44,10 +46,116 @@
  * Load and fix a given structural model file.
  * @author Jeanne Pellerin
  */
-int main()
+
+using namespace RINGMesh;
+
+/*!
+ * Numbers of vertices and mesh elements of each GeoModelMeshEntity
+ */
+std::vector< std::pair< index_t, index_t > > entity_sizes(
+    const GeoModel3D& geomodel )
+{
+    std::vector< std::pair< index_t, index_t > > sizes;
+    for( const auto& type : geomodel.entity_type_manager()
+                                .mesh_entity_manager.mesh_entity_types() )
+    {
+        for( auto e : range( geomodel.nb_mesh_entities( type ) ) )
+        {
+            const auto& entity = geomodel.mesh_entity( type, e );
+            sizes.emplace_back(
+                entity.nb_vertices(), entity.nb_mesh_elements() );
+        }
+    }
+    return sizes;
+}
+
+index_t nb_vertices( const GeoModel3D& geomodel, const MeshEntityType& type )
+{
+    index_t nb{ 0 };
+    for( auto e : range( geomodel.nb_mesh_entities( type ) ) )
+    {
+        nb += geomodel.mesh_entity( type, e ).nb_vertices();
+    }
+    return nb;
+}
+
+index_t nb_mesh_elements(
+    const GeoModel3D& geomodel, const MeshEntityType& type )
+{
+    index_t nb{ 0 };
+    for( auto e : range( geomodel.nb_mesh_entities( type ) ) )
+    {
+        nb += geomodel.mesh_entity( type, e ).nb_mesh_elements();
+    }
+    return nb;
+}
+
+index_t nb_switched_line_boundaries(
+    const GeoModel3D& geomodel, const GeoModel3D& repaired )
+{
+    index_t nb{ 0 };
+    for( const auto& line : geomodel.lines() )
+    {
+        if( line.boundary_gmme( 0 )
+            != repaired.line( line.index() ).boundary_gmme( 0 ) )
+        {
+            nb++;
+        }
+    }
+    return nb;
+}
+
+void check_count( const std::string& name, index_t reported, index_t repaired )
+{
+    if( reported != repaired )
+    {
+        throw RINGMeshException( "RINGMesh Test", "Repair dry run reports ",
+            reported, " ", name, " while the repair fixes ", repaired );
+    }
+}
+
+/*!
+ * Runs each repair mode on a copy of the GeoModel and checks that it
+ * removes what the dry run reports
+ */
+void check_dry_run( const GeoModel3D& geomodel, const RepairReport& report )
 {
-    using namespace RINGMesh;
+    const auto& line = Line3D::type_name_static();
+    const auto& surface = Surface3D::type_name_static();
+    const auto& region = Region3D::type_name_static();
+    auto repaired = [&geomodel]( RepairMode mode ) {
+        std::unique_ptr< GeoModel3D > copy( new GeoModel3D );
+        copy_geomodel( geomodel, *copy );
+        repair_geomodel( *copy, mode );
+        return copy;
+    };
 
+    auto copy = repaired( RepairMode::COLOCATED_VERTICES );
+    check_count( "colocated vertices", report.nb_colocated_vertices,
+        nb_vertices( geomodel, line ) + nb_vertices( geomodel, surface )
+            - nb_vertices( *copy, line ) - nb_vertices( *copy, surface ) );
+
+    copy = repaired( RepairMode::DEGENERATE_POLYGONS_EDGES );
+    check_count( "degenerate edges", report.nb_degenerate_edges,
+        nb_mesh_elements( geomodel, line ) - nb_mesh_elements( *copy, line ) );
+    check_count( "degenerate polygons", report.nb_degenerate_polygons,
+        nb_mesh_elements( geomodel, surface )
+            - nb_mesh_elements( *copy, surface ) );
+
+    copy = repaired( RepairMode::LINE_BOUNDARY_ORDER );
+    check_count( "lines with wrong boundary order",
+        report.nb_lines_with_wrong_boundary_order,
+        nb_switched_line_boundaries( geomodel, *copy ) );
+
+    copy = repaired( RepairMode::ISOLATED_VERTICES );
+    check_count( "isolated vertices", report.nb_isolated_vertices,
+        nb_vertices( geomodel, line ) + nb_vertices( geomodel, surface )
+            + nb_vertices( geomodel, region ) - nb_vertices( *copy, line )
+            - nb_vertices( *copy, surface ) - nb_vertices( *copy, region ) );
+}
+
+int main()
+{
     try
     {
         std::string file_name( ringmesh_test_data_path );
@@ -69,6 +177,18 @@ int main()
                 " must be invalid to check the repair functionalities." );
         }
 
+        // A dry run reports the changes without modifying the geomodel
+        index_t nb_geomodel_vertices{ geomodel.mesh.vertices.nb() };
+        auto sizes = entity_sizes( geomodel );
+        auto report = dry_run_repair_geomodel( geomodel, RepairMode::ALL );
+        if( geomodel.mesh.vertices.nb() != nb_geomodel_vertices
+            || entity_sizes( geomodel ) != sizes )
+        {
+            throw RINGMeshException( "RINGMesh Test",
+                "Repair dry run modified ", geomodel.name() );
+        }
+        check_dry_run( geomodel, report );
+
         Logger::out( "RINGMesh Test", "Repairing..." );
 
         // Repair the geomodel
@@ -81,6 +201,14 @@ int main()
                 "RINGMesh Test", "Fixing the invalid geological model "
                                      + geomodel.name() + " failed." );
         }
+        report = dry_run_repair_geomodel(
+            geomodel, RepairMode::COLOCATED_VERTICES );
+        if( report.nb_colocated_vertices != 0 )
+        {
+            throw RINGMeshException( "RINGMesh Test",
+                "Colocated vertices remain in the repaired geomodel ",
+                geomodel.name() );
+        }
 
         Logger::out( "TEST", "SUCCESS" );
         return 0;
@@ -0,0 +1,281 @@
+/*
+ * Copyright (c) 2012-2018, Association Scientifique pour la Geologie et ses
+ * Applications (ASGA). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of ASGA nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL ASGA BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *     http://www.ring-team.org
+ *
+ *     RING Project
+ *     Ecole Nationale Superieure de Geologie - GeoRessources
+ *     2 Rue du Doyen Marcel Roubault - TSA 70605
+ *     54518 VANDOEUVRE-LES-NANCY
+ *     FRANCE
+ */
+
+
+#include <ringmesh/ringmesh_tests_config.h>
+
+#include <geogram/mesh/mesh.h>
+
+#include <ringmesh/geomodel/builder/geomodel_builder.h>
+#include <ringmesh/geomodel/builder/geomodel_builder_from_mesh.h>
+#include <ringmesh/geomodel/core/geomodel.h>
+#include <ringmesh/geomodel/core/geomodel_mesh_entity.h>
+#include <ringmesh/geomodel/tools/geomodel_repair.h>
+#include <ringmesh/geomodel/tools/geomodel_tools.h>
+#include <ringmesh/mesh/mesh_index.h>
+
+/*!
+ * Tests the repair dry run on a cube GeoModel damaged in memory: the dry
+ * run must leave the GeoModel unchanged and report what each repair mode
+ * fixes on a copy of the GeoModel.
+ */
+
+using namespace RINGMesh;
+
+const index_t nb_subdivisions = 4;
+
+void add_square( GEO::Mesh& mesh,
+    const vec3& origin,
+    const vec3& u_axis,
+    const vec3& v_axis )
+{
+    auto nb_points = nb_subdivisions + 1;
+    auto first = mesh.vertices.create_vertices( nb_points * nb_points );
+    for( auto i : range( nb_points ) )
+    {
+        for( auto j : range( nb_points ) )
+        {
+            mesh.vertices.point( first + i * nb_points + j ) =
+                origin + ( double( i ) / nb_subdivisions ) * u_axis
+                + ( double( j ) / nb_subdivisions ) * v_axis;
+        }
+    }
+    for( auto i : range( nb_subdivisions ) )
+    {
+        for( auto j : range( nb_subdivisions ) )
+        {
+            auto v00 = first + i * nb_points + j;
+            auto v10 = v00 + nb_points;
+            mesh.facets.create_triangle( v00, v10, v10 + 1 );
+            mesh.facets.create_triangle( v00, v10 + 1, v00 + 1 );
+        }
+    }
+}
+
+void build_cube( GeoModel3D& geomodel )
+{
+    GEO::Mesh mesh;
+    vec3 x( 1, 0, 0 );
+    vec3 y( 0, 1, 0 );
+    vec3 z( 0, 0, 1 );
+    add_square( mesh, vec3(), y, z );
+    add_square( mesh, x, y, z );
+    add_square( mesh, vec3(), x, z );
+    add_square( mesh, y, x, z );
+    add_square( mesh, vec3(), x, y );
+    add_square( mesh, z, x, y );
+    mesh.facets.connect();
+
+    GeoModelBuilderSurfaceMesh builder( geomodel, mesh );
+    builder.build_polygonal_surfaces_from_connected_components();
+    builder.build_lines_and_corners_from_surfaces();
+    builder.build_regions_from_lines_and_surfaces();
+    builder.end_geomodel();
+}
+
+/*!
+ * Damages the cube so that each repair mode has something to fix:
+ * - a Surface polygon edge is collapsed, which gives colocated vertices
+ * and degenerate polygons,
+ * - a Line edge is collapsed, which gives a degenerate edge,
+ * - the boundary Corners of a Line are switched,
+ * - a Surface gets a vertex used by no polygon.
+ */
+void damage_cube( GeoModel3D& geomodel )
+{
+    GeoModelBuilder3D builder( geomodel );
+    const auto& surface = geomodel.surface( 0 );
+    auto polygon = surface.nb_mesh_elements() / 2;
+    auto v0 = surface.mesh_element_vertex_index( { polygon, 0 } );
+    auto v1 = surface.mesh_element_vertex_index( { polygon, 1 } );
+    builder.geometry.set_mesh_entity_vertex(
+        surface.gmme(), v1, surface.vertex( v0 ), false );
+
+    const auto& line = geomodel.line( 0 );
+    builder.geometry.set_mesh_entity_vertex(
+        line.gmme(), 2, line.vertex( 1 ), false );
+
+    const auto& switched_line = geomodel.line( 1 );
+    auto corner0 = switched_line.boundary_gmme( 0 ).index();
+    auto corner1 = switched_line.boundary_gmme( 1 ).index();
+    builder.topology.set_line_corner_boundary( 1, 0, corner1 );
+    builder.topology.set_line_corner_boundary( 1, 1, corner0 );
+
+    const auto& isolated_surface = geomodel.surface( 1 );
+    auto isolated = builder.geometry.create_mesh_entity_vertices(
+        isolated_surface.gmme(), 1 );
+    builder.geometry.set_mesh_entity_vertex( isolated_surface.gmme(),
+        isolated, vec3( 0.5, 0.5, 0.5 ), false );
+    builder.geometry.clear_geomodel_mesh();
+}
+
+/*!
+ * Numbers of vertices and mesh elements of each GeoModelMeshEntity
+ */
+std::vector< std::pair< index_t, index_t > > entity_sizes(
+    const GeoModel3D& geomodel )
+{
+    std::vector< std::pair< index_t, index_t > > sizes;
+    for( const auto& type : geomodel.entity_type_manager()
+                                .mesh_entity_manager.mesh_entity_types() )
+    {
+        for( auto e : range( geomodel.nb_mesh_entities( type ) ) )
+        {
+            const auto& entity = geomodel.mesh_entity( type, e );
+            sizes.emplace_back(
+                entity.nb_vertices(), entity.nb_mesh_elements() );
+        }
+    }
+    return sizes;
+}
+
+index_t nb_vertices( const GeoModel3D& geomodel, const MeshEntityType& type )
+{
+    index_t nb{ 0 };
+    for( auto e : range( geomodel.nb_mesh_entities( type ) ) )
+    {
+        nb += geomodel.mesh_entity( type, e ).nb_vertices();
+    }
+    return nb;
+}
+
+index_t nb_mesh_elements(
+    const GeoModel3D& geomodel, const MeshEntityType& type )
+{
+    index_t nb{ 0 };
+    for( auto e : range( geomodel.nb_mesh_entities( type ) ) )
+    {
+        nb += geomodel.mesh_entity( type, e ).nb_mesh_elements();
+    }
+    return nb;
+}
+
+index_t nb_switched_line_boundaries(
+    const GeoModel3D& geomodel, const GeoModel3D& repaired )
+{
+    index_t nb{ 0 };
+    for( const auto& line : geomodel.lines() )
+    {
+        if( line.boundary_gmme( 0 )
+            != repaired.line( line.index() ).boundary_gmme( 0 ) )
+        {
+            nb++;
+        }
+    }
+    return nb;
+}
+
+void check_count( const std::string& name, index_t reported, index_t repaired )
+{
+    if( reported == 0 )
+    {
+        throw RINGMeshException(
+            "RINGMesh Test", "Repair dry run reports no ", name );
+    }
+    if( reported != repaired )
+    {
+        throw RINGMeshException( "RINGMesh Test", "Repair dry run reports ",
+            reported, " ", name, " while the repair fixes ", repaired );
+    }
+}
+
+/*!
+ * Runs each repair mode on a copy of the GeoModel and checks that it
+ * fixes what the dry run reports
+ */
+void check_dry_run( const GeoModel3D& geomodel, const RepairReport& report )
+{
+    const auto& line = Line3D::type_name_static();
+    const auto& surface = Surface3D::type_name_static();
+    auto repaired = [&geomodel]( RepairMode mode ) {
+        std::unique_ptr< GeoModel3D > copy( new GeoModel3D );
+        copy_geomodel( geomodel, *copy );
+        repair_geomodel( *copy, mode );
+        return copy;
+    };
+
+    auto copy = repaired( RepairMode::COLOCATED_VERTICES );
+    check_count( "colocated vertices", report.nb_colocated_vertices,
+        nb_vertices( geomodel, line ) + nb_vertices( geomodel, surface )
+            - nb_vertices( *copy, line ) - nb_vertices( *copy, surface ) );
+
+    copy = repaired( RepairMode::DEGENERATE_POLYGONS_EDGES );
+    check_count( "degenerate edges", report.nb_degenerate_edges,
+        nb_mesh_elements( geomodel, line ) - nb_mesh_elements( *copy, line ) );
+    check_count( "degenerate polygons", report.nb_degenerate_polygons,
+        nb_mesh_elements( geomodel, surface )
+            - nb_mesh_elements( *copy, surface ) );
+
+    copy = repaired( RepairMode::LINE_BOUNDARY_ORDER );
+    check_count( "lines with wrong boundary order",
+        report.nb_lines_with_wrong_boundary_order,
+        nb_switched_line_boundaries( geomodel, *copy ) );
+
+    copy = repaired( RepairMode::ISOLATED_VERTICES );
+    check_count( "isolated vertices", report.nb_isolated_vertices,
+        nb_vertices( geomodel, line ) + nb_vertices( geomodel, surface )
+            - nb_vertices( *copy, line ) - nb_vertices( *copy, surface ) );
+}
+
+int main()
+{
+    try
+    {
+        GeoModel3D geomodel;
+        build_cube( geomodel );
+        damage_cube( geomodel );
+
+        auto sizes = entity_sizes( geomodel );
+        auto report = dry_run_repair_geomodel( geomodel, RepairMode::ALL );
+        if( entity_sizes( geomodel ) != sizes )
+        {
+            throw RINGMeshException(
+                "RINGMesh Test", "Repair dry run modified the GeoModel" );
+        }
+        check_dry_run( geomodel, report );
+    }
+    catch( const RINGMeshException& e )
+    {
+        Logger::err( e.category(), e.what() );
+        return 1;
+    }
+    catch( const std::exception& e )
+    {
+        Logger::err( "Exception", e.what() );
+        return 1;
+    }
+    Logger::out( "TEST", "SUCCESS" );
+    return 0;
+}
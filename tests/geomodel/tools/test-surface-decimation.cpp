@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2012-2018, Association Scientifique pour la Geologie et ses
+ * Applications (ASGA). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of ASGA nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL ASGA BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *     http://www.ring-team.org
+ *
+ *     RING Project
+ *     Ecole Nationale Superieure de Geologie - GeoRessources
+ *     2 Rue du Doyen Marcel Roubault - TSA 70605
+ *     54518 VANDOEUVRE-LES-NANCY
+ *     FRANCE
+ */
+
+#include <ringmesh/ringmesh_tests_config.h>
+
+#include <geogram/basic/command_line.h>
+#include <geogram/mesh/mesh.h>
+
+#include <ringmesh/geomodel/builder/geomodel_builder_from_mesh.h>
+#include <ringmesh/geomodel/core/geomodel.h>
+#include <ringmesh/geomodel/core/geomodel_mesh_entity.h>
+#include <ringmesh/geomodel/tools/geomodel_tools.h>
+#include <ringmesh/geomodel/tools/geomodel_validity.h>
+#include <ringmesh/geomodel/tools/surface_decimation.h>
+
+/*!
+ * Tests the decimation of the Surfaces of a cube GeoModel whose faces
+ * are finely triangulated squares, and that a cube GeoModel with meshed
+ * Regions is not decimated.
+ */
+
+using namespace RINGMesh;
+
+const index_t nb_subdivisions = 8;
+
+void add_square( GEO::Mesh& mesh,
+    const vec3& origin,
+    const vec3& u_axis,
+    const vec3& v_axis )
+{
+    auto nb_points = nb_subdivisions + 1;
+    auto first = mesh.vertices.create_vertices( nb_points * nb_points );
+    for( auto i : range( nb_points ) )
+    {
+        for( auto j : range( nb_points ) )
+        {
+            mesh.vertices.point( first + i * nb_points + j ) =
+                origin + ( double( i ) / nb_subdivisions ) * u_axis
+                + ( double( j ) / nb_subdivisions ) * v_axis;
+        }
+    }
+    for( auto i : range( nb_subdivisions ) )
+    {
+        for( auto j : range( nb_subdivisions ) )
+        {
+            auto v00 = first + i * nb_points + j;
+            auto v10 = v00 + nb_points;
+            mesh.facets.create_triangle( v00, v10, v10 + 1 );
+            mesh.facets.create_triangle( v00, v10 + 1, v00 + 1 );
+        }
+    }
+}
+
+void build_cube( GeoModel3D& geomodel )
+{
+    GEO::Mesh mesh;
+    vec3 x( 1, 0, 0 );
+    vec3 y( 0, 1, 0 );
+    vec3 z( 0, 0, 1 );
+    add_square( mesh, vec3(), y, z );
+    add_square( mesh, x, y, z );
+    add_square( mesh, vec3(), x, z );
+    add_square( mesh, y, x, z );
+    add_square( mesh, vec3(), x, y );
+    add_square( mesh, z, x, y );
+    mesh.facets.connect();
+
+    GeoModelBuilderSurfaceMesh builder( geomodel, mesh );
+    builder.build_polygonal_surfaces_from_connected_components();
+    builder.build_lines_and_corners_from_surfaces();
+    builder.build_regions_from_lines_and_surfaces();
+    builder.end_geomodel();
+}
+
+void test_decimation()
+{
+    GeoModel3D geomodel;
+    build_cube( geomodel );
+
+    std::vector< std::vector< vec3 > > lines;
+    for( const auto& line : geomodel.lines() )
+    {
+        lines.emplace_back();
+        for( auto v : range( line.nb_vertices() ) )
+        {
+            lines.back().push_back( line.vertex( v ) );
+        }
+    }
+
+    auto nb_removed = decimate_surfaces( geomodel, 1e-3 );
+    if( nb_removed == 0 )
+    {
+        throw RINGMeshException(
+            "RINGMesh Test", "No triangle removed by the decimation" );
+    }
+    if( !is_geomodel_valid( geomodel, ValidityCheckMode::ALL ) )
+    {
+        throw RINGMeshException(
+            "RINGMesh Test", "Decimated GeoModel is not valid" );
+    }
+    for( const auto& line : geomodel.lines() )
+    {
+        for( auto v : range( line.nb_vertices() ) )
+        {
+            if( line.vertex( v ) != lines[line.index()][v] )
+            {
+                throw RINGMeshException( "RINGMesh Test",
+                    "Decimation moved a vertex of ", line.gmme() );
+            }
+        }
+    }
+    for( const auto& surface : geomodel.surfaces() )
+    {
+        // The squares are planar: most interior vertices are removed
+        if( surface.nb_mesh_elements() > nb_subdivisions * nb_subdivisions )
+        {
+            throw RINGMeshException(
+                "RINGMesh Test", surface.gmme(), " is not decimated enough" );
+        }
+    }
+}
+
+#ifdef RINGMESH_WITH_TETGEN
+
+void test_meshed_geomodel()
+{
+    GeoModel3D geomodel;
+    build_cube( geomodel );
+    tetrahedralize( geomodel, NO_ID, false );
+
+    std::vector< index_t > nb_triangles;
+    for( const auto& surface : geomodel.surfaces() )
+    {
+        nb_triangles.push_back( surface.nb_mesh_elements() );
+    }
+    auto nb_cells = geomodel.region( 0 ).nb_mesh_elements();
+
+    bool rejected{ false };
+    try
+    {
+        decimate_surfaces( geomodel, 1e-3 );
+    }
+    catch( const RINGMeshException& )
+    {
+        rejected = true;
+    }
+    if( !rejected )
+    {
+        throw RINGMeshException( "RINGMesh Test",
+            "Decimation of a GeoModel with meshed Regions is not rejected" );
+    }
+    for( const auto& surface : geomodel.surfaces() )
+    {
+        if( surface.nb_mesh_elements() != nb_triangles[surface.index()] )
+        {
+            throw RINGMeshException( "RINGMesh Test", surface.gmme(),
+                " is modified by a rejected decimation" );
+        }
+    }
+    if( geomodel.region( 0 ).nb_mesh_elements() != nb_cells )
+    {
+        throw RINGMeshException( "RINGMesh Test",
+            "Region is modified by a rejected decimation" );
+    }
+}
+
+#endif
+
+int main()
+{
+    try
+    {
+        test_decimation();
+#ifdef RINGMESH_WITH_TETGEN
+        GEO::CmdLine::set_arg( "algo:tet", "TetGen" );
+        test_meshed_geomodel();
+#endif
+    }
+    catch( const RINGMeshException& e )
+    {
+        Logger::err( e.category(), e.what() );
+        return 1;
+    }
+    catch( const std::exception& e )
+    {
+        Logger::err( "Exception", e.what() );
+        return 1;
+    }
+    Logger::out( "TEST", "SUCCESS" );
+    return 0;
+}
@@ -0,0 +1,274 @@
+/*
+ * Copyright (c) 2012-2018, Association Scientifique pour la Geologie et ses
+ * Applications (ASGA). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of ASGA nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL ASGA BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *     http://www.ring-team.org
+ *
+ *     RING Project
+ *     Ecole Nationale Superieure de Geologie - GeoRessources
+ *     2 Rue du Doyen Marcel Roubault - TSA 70605
+ *     54518 VANDOEUVRE-LES-NANCY
+ *     FRANCE
+ */
+
+
+#include <ringmesh/ringmesh_tests_config.h>
+
+#include <array>
+#include <random>
+
+#include <geogram/basic/attributes.h>
+#include <geogram/basic/geometry.h>
+
+#include <ringmesh/geomodel/builder/geomodel_builder.h>
+#include <ringmesh/geomodel/core/geomodel.h>
+#include <ringmesh/geomodel/core/geomodel_mesh_entity.h>
+#include <ringmesh/geomodel/tools/mesh_quality.h>
+
+/*!
+ * Tests that the tetrahedron qualities computed by blocks over the
+ * Region cells are the ones given by the definitions of the metrics.
+ */
+
+using namespace RINGMesh;
+
+using Tet = std::array< vec3, 4 >;
+
+const std::array< MeshQualityMode, 4 > quality_modes{ {
+    INSPHERE_RADIUS_BY_CIRCUMSPHERE_RADIUS,
+    INSPHERE_RADIUS_BY_MAX_EDGE_LENGTH, VOLUME_BY_SUM_SQUARE_EDGE,
+    MIN_SOLID_ANGLE } };
+
+const std::array< std::string, 4 > quality_names{ {
+    "INSPHERE_RADIUS_BY_CIRCUMSPHERE_RADIUS",
+    "INSPHERE_RADIUS_BY_MAX_EDGE_LENGTH", "VOLUME_BY_SUM_SQUARE_EDGE",
+    "MIN_SOLID_ANGLE" } };
+
+/*!
+ * Well shaped, badly shaped and random tetrahedra, more than a block of
+ * cells
+ */
+std::vector< Tet > valid_tets()
+{
+    std::vector< Tet > tets{ // Regular
+        { { vec3( 1, 1, 1 ), vec3( 1, -1, -1 ), vec3( -1, 1, -1 ),
+            vec3( -1, -1, 1 ) } },
+        // Corner of a cube
+        { { vec3( 0, 0, 0 ), vec3( 1, 0, 0 ), vec3( 0, 1, 0 ),
+            vec3( 0, 0, 1 ) } },
+        // Sliver
+        { { vec3( 0, 0, 0 ), vec3( 1, 1, 0 ), vec3( 1, 0, 1e-3 ),
+            vec3( 0, 1, 1e-3 ) } },
+        // Needle
+        { { vec3( 0, 0, 0 ), vec3( 1e-3, 0, 0 ), vec3( 0, 1e-3, 0 ),
+            vec3( 0, 0, 10 ) } },
+        // Cap
+        { { vec3( 0, 0, 0 ), vec3( 1, 0, 0 ), vec3( 0.5, 0.9, 0 ),
+            vec3( 0.5, 0.3, 1e-3 ) } },
+        // Wedge
+        { { vec3( 0, 0, 0 ), vec3( 1, 0, 0 ), vec3( 0, 1e-3, 0 ),
+            vec3( 0, 0, 1e-3 ) } },
+        // Far from the origin
+        { { vec3( 1e5, 1e5, 1e3 ), vec3( 1e5 + 1, 1e5, 1e3 ),
+            vec3( 1e5, 1e5 + 1, 1e3 ), vec3( 1e5, 1e5, 1e3 + 1 ) } }
+    };
+    std::mt19937 generator( 42 );
+    std::uniform_real_distribution< double > coordinate( -1., 1. );
+    while( tets.size() < 150 )
+    {
+        Tet tet;
+        for( auto& point : tet )
+        {
+            point = vec3( coordinate( generator ), coordinate( generator ),
+                coordinate( generator ) );
+        }
+        if( std::fabs( GEO::Geom::tetra_signed_volume(
+                tet[0], tet[1], tet[2], tet[3] ) )
+            > 1e-6 )
+        {
+            tets.push_back( tet );
+        }
+    }
+    return tets;
+}
+
+std::vector< Tet > degenerate_tets()
+{
+    return { // Flat
+        { { vec3( 0, 0, 0 ), vec3( 1, 0, 0 ), vec3( 0, 1, 0 ),
+            vec3( 1, 1, 0 ) } },
+        // Collinear
+        { { vec3( 0, 0, 0 ), vec3( 1, 1, 1 ), vec3( 2, 2, 2 ),
+            vec3( 0, 0, 1 ) } },
+        // Two colocated vertices
+        { { vec3( 0, 0, 0 ), vec3( 0, 0, 0 ), vec3( 0, 1, 0 ),
+            vec3( 0, 0, 1 ) } },
+        // Point
+        { { vec3( 1, 2, 3 ), vec3( 1, 2, 3 ), vec3( 1, 2, 3 ),
+            vec3( 1, 2, 3 ) } }
+    };
+}
+
+/*!
+ * Reference qualities, computed from the definitions of the metrics
+ */
+double insphere_radius( const Tet& tet )
+{
+    double sum_areas{ 0 };
+    for( auto v : range( 4 ) )
+    {
+        sum_areas += GEO::Geom::triangle_area(
+            tet[( v + 1 ) % 4], tet[( v + 2 ) % 4], tet[( v + 3 ) % 4] );
+    }
+    return 3 * GEO::Geom::tetra_volume( tet[0], tet[1], tet[2], tet[3] )
+           / sum_areas;
+}
+
+double sin_half_solid_angle( const vec3& v0,
+    const vec3& v1,
+    const vec3& v2,
+    const vec3& v3 )
+{
+    double l01 = ( v1 - v0 ).length();
+    double l02 = ( v2 - v0 ).length();
+    double l03 = ( v3 - v0 ).length();
+    double l12 = ( v2 - v1 ).length();
+    double l13 = ( v3 - v1 ).length();
+    double l23 = ( v3 - v2 ).length();
+    double denominator = ( l01 + l02 + l12 ) * ( l01 + l02 - l12 )
+                         * ( l02 + l03 + l23 ) * ( l02 + l03 - l23 )
+                         * ( l03 + l01 + l13 ) * ( l03 + l01 - l13 );
+    return 12 * GEO::Geom::tetra_volume( v0, v1, v2, v3 )
+           / std::sqrt( denominator );
+}
+
+double tet_quality( const Tet& tet, MeshQualityMode mode )
+{
+    double max_length2{ 0 };
+    double sum_length2{ 0 };
+    for( auto v0 : range( 4 ) )
+    {
+        for( auto v1 : range( v0 + 1, 4 ) )
+        {
+            auto length2 = ( tet[v1] - tet[v0] ).length2();
+            max_length2 = std::max( max_length2, length2 );
+            sum_length2 += length2;
+        }
+    }
+    auto volume = GEO::Geom::tetra_volume( tet[0], tet[1], tet[2], tet[3] );
+    switch( mode )
+    {
+    case INSPHERE_RADIUS_BY_CIRCUMSPHERE_RADIUS:
+    {
+        auto center =
+            GEO::Geom::tetra_circum_center( tet[0], tet[1], tet[2], tet[3] );
+        return 3 * insphere_radius( tet ) / ( center - tet[0] ).length();
+    }
+    case INSPHERE_RADIUS_BY_MAX_EDGE_LENGTH:
+        return 2 * std::sqrt( 6. ) * insphere_radius( tet )
+               / std::sqrt( max_length2 );
+    case VOLUME_BY_SUM_SQUARE_EDGE:
+        return 12. * std::pow( 3. * volume, 2. / 3. ) / sum_length2;
+    case MIN_SOLID_ANGLE:
+        return 1.5 * std::sqrt( 6. )
+               * std::min(
+                     std::min( sin_half_solid_angle(
+                                   tet[0], tet[1], tet[2], tet[3] ),
+                         sin_half_solid_angle(
+                             tet[1], tet[0], tet[2], tet[3] ) ),
+                     std::min( sin_half_solid_angle(
+                                   tet[2], tet[0], tet[1], tet[3] ),
+                         sin_half_solid_angle(
+                             tet[3], tet[0], tet[1], tet[2] ) ) );
+    }
+    return -1;
+}
+
+void build_region( GeoModel3D& geomodel, const std::vector< Tet >& tets )
+{
+    GeoModelBuilder3D builder( geomodel );
+    builder.topology.create_mesh_entity( Region3D::type_name_static() );
+    std::vector< vec3 > points;
+    std::vector< index_t > corners;
+    for( const auto& tet : tets )
+    {
+        for( const auto& point : tet )
+        {
+            corners.push_back( static_cast< index_t >( points.size() ) );
+            points.push_back( point );
+        }
+    }
+    builder.geometry.set_region_geometry( 0, points, corners );
+}
+
+void test_block_qualities()
+{
+    auto tets = valid_tets();
+    auto degenerate = degenerate_tets();
+    auto nb_valid = static_cast< index_t >( tets.size() );
+    tets.insert( tets.end(), degenerate.begin(), degenerate.end() );
+    GeoModel3D geomodel;
+    build_region( geomodel, tets );
+    compute_prop_tet_mesh_qualities( geomodel );
+
+    const auto& region = geomodel.region( 0 );
+    for( auto mode : range( quality_modes.size() ) )
+    {
+        GEO::Attribute< double > qualities(
+            region.cell_attribute_manager(), quality_names[mode] );
+        for( auto t : range( tets.size() ) )
+        {
+            const auto& tet = tets[t];
+            auto expected =
+                t < nb_valid ? tet_quality( tet, quality_modes[mode] ) : 0.;
+            if( std::fabs( qualities[t] - expected ) > 1e-9 )
+            {
+                throw RINGMeshException( "RINGMesh Test", "Tet ", t,
+                    " has the ", quality_names[mode], " ", qualities[t],
+                    " instead of ", expected );
+            }
+        }
+    }
+}
+
+int main()
+{
+    try
+    {
+        test_block_qualities();
+    }
+    catch( const RINGMeshException& e )
+    {
+        Logger::err( e.category(), e.what() );
+        return 1;
+    }
+    catch( const std::exception& e )
+    {
+        Logger::err( "Exception", e.what() );
+        return 1;
+    }
+    Logger::out( "TEST", "SUCCESS" );
+    return 0;
+}
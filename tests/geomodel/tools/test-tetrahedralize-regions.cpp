@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2012-2018, Association Scientifique pour la Geologie et ses
+ * Applications (ASGA). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of ASGA nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL ASGA BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *     http://www.ring-team.org
+ *
+ *     RING Project
+ *     Ecole Nationale Superieure de Geologie - GeoRessources
+ *     2 Rue du Doyen Marcel Roubault - TSA 70605
+ *     54518 VANDOEUVRE-LES-NANCY
+ *     FRANCE
+ */
+
+
+#include <ringmesh/ringmesh_tests_config.h>
+
+#include <geogram/basic/command_line.h>
+#include <geogram/mesh/mesh.h>
+
+#include <ringmesh/geomodel/builder/geomodel_builder_from_mesh.h>
+#include <ringmesh/geomodel/core/geomodel.h>
+#include <ringmesh/geomodel/core/geomodel_mesh_entity.h>
+#include <ringmesh/geomodel/tools/geomodel_tools.h>
+#include <ringmesh/mesh/mesh_index.h>
+#include <ringmesh/mesh/volume_mesh.h>
+
+/*!
+ * Tests that the Regions of a model made of three stacked boxes meshed
+ * concurrently, with or without a meshing budget (algo:tet_budget), get
+ * the meshes of a sequential run.
+ */
+
+using namespace RINGMesh;
+
+#ifdef RINGMESH_WITH_TETGEN
+
+const index_t nb_subdivisions = 3;
+const index_t nb_boxes = 3;
+
+void add_square( GEO::Mesh& mesh,
+    const vec3& origin,
+    const vec3& u_axis,
+    const vec3& v_axis )
+{
+    auto nb_points = nb_subdivisions + 1;
+    auto first = mesh.vertices.create_vertices( nb_points * nb_points );
+    for( auto i : range( nb_points ) )
+    {
+        for( auto j : range( nb_points ) )
+        {
+            mesh.vertices.point( first + i * nb_points + j ) =
+                origin + ( double( i ) / nb_subdivisions ) * u_axis
+                + ( double( j ) / nb_subdivisions ) * v_axis;
+        }
+    }
+    for( auto i : range( nb_subdivisions ) )
+    {
+        for( auto j : range( nb_subdivisions ) )
+        {
+            auto v00 = first + i * nb_points + j;
+            auto v10 = v00 + nb_points;
+            mesh.facets.create_triangle( v00, v10, v10 + 1 );
+            mesh.facets.create_triangle( v00, v10 + 1, v00 + 1 );
+        }
+    }
+}
+
+/*!
+ * Boxes of increasing heights, so that the Regions get different meshes
+ */
+void build_stacked_boxes( GeoModel3D& geomodel )
+{
+    GEO::Mesh mesh;
+    vec3 x( 1, 0, 0 );
+    vec3 y( 0, 1, 0 );
+    double height{ 0 };
+    for( auto box : range( nb_boxes ) )
+    {
+        add_square( mesh, vec3( 0, 0, height ), x, y );
+        vec3 z( 0, 0, 0.5 * ( box + 1 ) );
+        add_square( mesh, vec3( 0, 0, height ), x, z );
+        add_square( mesh, vec3( 0, 1, height ), x, z );
+        add_square( mesh, vec3( 0, 0, height ), y, z );
+        add_square( mesh, vec3( 1, 0, height ), y, z );
+        height += z.z;
+    }
+    add_square( mesh, vec3( 0, 0, height ), x, y );
+    mesh.facets.connect();
+
+    GeoModelBuilderSurfaceMesh builder( geomodel, mesh );
+    builder.build_polygonal_surfaces_from_connected_components();
+    builder.build_lines_and_corners_from_surfaces();
+    builder.build_regions_from_lines_and_surfaces();
+    builder.end_geomodel();
+}
+
+void check_same_region_meshes( const Region3D& region, const Region3D& other )
+{
+    const auto& mesh = region.mesh();
+    const auto& other_mesh = other.mesh();
+    if( mesh.nb_vertices() != other_mesh.nb_vertices()
+        || mesh.nb_cells() != other_mesh.nb_cells() )
+    {
+        throw RINGMeshException( "RINGMesh Test", region.gmme(),
+            " has another mesh size than in the sequential run" );
+    }
+    for( auto v : range( mesh.nb_vertices() ) )
+    {
+        if( mesh.vertex( v ) != other_mesh.vertex( v ) )
+        {
+            throw RINGMeshException( "RINGMesh Test", "Vertex ", v, " of ",
+                region.gmme(), " differs from the sequential run" );
+        }
+    }
+    for( auto c : range( mesh.nb_cells() ) )
+    {
+        for( auto v : range( mesh.nb_cell_vertices( c ) ) )
+        {
+            if( mesh.cell_vertex( { c, v } )
+                != other_mesh.cell_vertex( { c, v } ) )
+            {
+                throw RINGMeshException( "RINGMesh Test", "Cell ", c, " of ",
+                    region.gmme(), " differs from the sequential run" );
+            }
+        }
+    }
+}
+
+void test_tetrahedralize_regions()
+{
+    GeoModel3D sequential_geomodel;
+    build_stacked_boxes( sequential_geomodel );
+    if( sequential_geomodel.nb_regions() != nb_boxes )
+    {
+        throw RINGMeshException( "RINGMesh Test", "Wrong number of Regions" );
+    }
+    GEO::CmdLine::set_arg( "sys:multithread", false );
+    tetrahedralize( sequential_geomodel, NO_ID, true );
+    GEO::CmdLine::set_arg( "sys:multithread", true );
+
+    // Each Region costs 108 boundary triangles: no budget, two Regions
+    // at a time, then Regions exceeding the budget meshed alone
+    for( auto budget : { "0", "250", "50" } )
+    {
+        GEO::CmdLine::set_arg( "algo:tet_budget", budget );
+        GeoModel3D geomodel;
+        build_stacked_boxes( geomodel );
+        tetrahedralize( geomodel, NO_ID, true );
+        for( const auto& region : geomodel.regions() )
+        {
+            if( !region.is_meshed() )
+            {
+                throw RINGMeshException(
+                    "RINGMesh Test", region.gmme(), " is not meshed" );
+            }
+            check_same_region_meshes(
+                region, sequential_geomodel.region( region.index() ) );
+        }
+    }
+    GEO::CmdLine::set_arg( "algo:tet_budget", "0" );
+}
+
+#endif
+
+int main()
+{
+    try
+    {
+#ifdef RINGMESH_WITH_TETGEN
+        GEO::CmdLine::set_arg( "algo:tet", "TetGen" );
+        test_tetrahedralize_regions();
+#endif
+    }
+    catch( const RINGMeshException& e )
+    {
+        Logger::err( e.category(), e.what() );
+        return 1;
+    }
+    catch( const std::exception& e )
+    {
+        Logger::err( "Exception", e.what() );
+        return 1;
+    }
+    Logger::out( "TEST", "SUCCESS" );
+    return 0;
+}
@@ -0,0 +1,299 @@
+/*
+ * Copyright (c) 2012-2018, Association Scientifique pour la Geologie et ses
+ * Applications (ASGA). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of ASGA nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL ASGA BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *     http://www.ring-team.org
+ *
+ *     RING Project
+ *     Ecole Nationale Superieure de Geologie - GeoRessources
+ *     2 Rue du Doyen Marcel Roubault - TSA 70605
+ *     54518 VANDOEUVRE-LES-NANCY
+ *     FRANCE
+ */
+
+
+#include <ringmesh/ringmesh_tests_config.h>
+
+#include <cmath>
+#include <random>
+
+#include <geogram/mesh/triangle_intersection.h>
+
+#include <ringmesh/basic/logger.h>
+
+#include <ringmesh/geomodel/tools/geomodel_validity.h>
+
+/*!
+ * Tests that the filtered triangle intersection test of the validity
+ * checks gives the result of the exact predicate of Geogram on degenerate
+ * and near-degenerate triangle pairs.
+ */
+
+using namespace RINGMesh;
+
+using Triangle = std::array< vec3, 3 >;
+
+/*!
+ * Result of an intersection test, NO_RESULT when the exact predicate of
+ * Geogram asserts on the configuration (e.g. for some segments coplanar to
+ * a triangle)
+ */
+enum struct Result
+{
+    DISJOINT,
+    INTERSECTING,
+    NO_RESULT
+};
+
+template < typename TEST >
+Result test_result( const TEST& test )
+{
+    try
+    {
+        return test() ? Result::INTERSECTING : Result::DISJOINT;
+    }
+    catch( const std::exception& )
+    {
+        return Result::NO_RESULT;
+    }
+}
+
+Result exact_intersection( const Triangle& t0, const Triangle& t1 )
+{
+    return test_result( [&t0, &t1] {
+        GEO::vector< GEO::TriangleIsect > sym;
+        return GEO::triangles_intersections(
+            t0[0], t0[1], t0[2], t1[0], t1[1], t1[2], sym );
+    } );
+}
+
+Result filtered_intersection( const Triangle& t0, const Triangle& t1 )
+{
+    return test_result( [&t0, &t1] {
+        return are_triangles_intersecting(
+            t0[0], t0[1], t0[2], t1[0], t1[1], t1[2] );
+    } );
+}
+
+/*!
+ * @brief Compares the filtered and exact intersections of two triangles
+ * in both orders, the exact predicate not being always symmetric (e.g. when
+ * an edge contains an edge of the other triangle)
+ * @return 1 if the triangles intersect, 0 otherwise
+ */
+index_t check_pair( const Triangle& t0, const Triangle& t1 )
+{
+    auto exact = exact_intersection( t0, t1 );
+    if( filtered_intersection( t0, t1 ) != exact
+        || filtered_intersection( t1, t0 ) != exact_intersection( t1, t0 ) )
+    {
+        throw RINGMeshException( "RINGMesh Test",
+            "Filtered intersection differs from the exact one for triangles (",
+            t0[0], ", ", t0[1], ", ", t0[2], ") and (", t1[0], ", ", t1[1],
+            ", ", t1[2], ")" );
+    }
+    return exact == Result::INTERSECTING ? 1 : 0;
+}
+
+void test_special_pairs()
+{
+    vec3 o( 0, 0, 0 );
+    vec3 x( 1, 0, 0 );
+    vec3 y( 0, 1, 0 );
+    vec3 z( 0, 0, 1 );
+    double tiny{ 1e-17 };
+    std::vector< std::pair< Triangle, Triangle > > pairs{
+        // Coplanar overlapping
+        { { { o, x, y } }, { { vec3( 0.2, 0.2, 0 ), vec3( 2, 0.2, 0 ),
+                               vec3( 0.2, 2, 0 ) } } },
+        // Coplanar sharing an edge, on both sides of it
+        { { { o, x, y } }, { { x, y, vec3( 1, 1, 0 ) } } },
+        // Coplanar sharing an edge, folded on each other
+        { { { o, x, y } }, { { x, y, vec3( 0.2, 0.2, 0 ) } } },
+        // Sharing a vertex only
+        { { { o, x, y } }, { { o, -1. * x, z } } },
+        // Sharing an edge, not coplanar
+        { { { o, x, y } }, { { o, x, z } } },
+        // Crossing
+        { { { o, x, y } }, { { vec3( 0.2, 0.2, -1 ), vec3( 0.2, 0.2, 1 ),
+                               vec3( 2, 2, 0 ) } } },
+        // Vertex on the other triangle
+        { { { o, x, y } }, { { vec3( 0.2, 0.2, 0 ), vec3( 0.2, 0.2, 1 ),
+                               vec3( 1, 1, 1 ) } } },
+        // Vertex on an edge of the other triangle
+        { { { o, x, y } }, { { vec3( 0.5, 0, 0 ), vec3( 0.5, -1, 1 ),
+                               vec3( 0.5, -1, -1 ) } } },
+        // Repeated vertex crossing the other triangle
+        { { { o, x, y } }, { { vec3( 0.2, 0.2, -1 ), vec3( 0.2, 0.2, -1 ),
+                               vec3( 0.2, 0.2, 1 ) } } },
+        // Repeated vertex away from the other triangle
+        { { { o, x, y } }, { { vec3( 2, 2, -1 ), vec3( 2, 2, -1 ),
+                               vec3( 2, 2, 1 ) } } },
+        // Collinear vertices crossing the other triangle
+        { { { o, x, y } }, { { vec3( 0.2, 0.2, -1 ), vec3( 0.2, 0.2, 0.5 ),
+                               vec3( 0.2, 0.2, 1 ) } } },
+        // Single point in the other triangle
+        { { { o, x, y } }, { { vec3( 0.2, 0.2, 0 ), vec3( 0.2, 0.2, 0 ),
+                               vec3( 0.2, 0.2, 0 ) } } },
+        // Both triangles degenerate and crossing
+        { { { o, x, 2. * x } }, { { vec3( 0.5, -1, 0 ), vec3( 0.5, 1, 0 ),
+                                    vec3( 0.5, 2, 0 ) } } },
+        // Needle triangle crossing the other triangle
+        { { { vec3( 0.2, 0.2, -1 ), vec3( 0.2, 0.2 + tiny, 1 ),
+              vec3( 0.2, 0.2, 1 ) } },
+            { { o, x, y } } },
+        // Almost coplanar, above the other triangle
+        { { { o, x, y } }, { { vec3( 0.2, 0.2, tiny ), vec3( 2, 0.2, tiny ),
+                               vec3( 0.2, 2, tiny ) } } },
+        // Almost coplanar, slightly tilted through the other triangle
+        { { { o, x, y } }, { { vec3( 0.2, 0.2, -tiny ), vec3( 2, 0.2, tiny ),
+                               vec3( 0.2, 2, tiny ) } } },
+        // Almost touching at a vertex
+        { { { o, x, y } }, { { vec3( 0.2, 0.2, tiny ), vec3( 0.2, 0.2, 1 ),
+                               vec3( 1, 1, 1 ) } } },
+        // Almost sharing an edge
+        { { { o, x, y } }, { { vec3( 0, 0, tiny ), vec3( 1, 0, tiny ), z } } }
+    };
+    index_t nb_intersections{ 0 };
+    for( const auto& pair : pairs )
+    {
+        nb_intersections += check_pair( pair.first, pair.second );
+    }
+    if( nb_intersections == 0 || nb_intersections == pairs.size() )
+    {
+        throw RINGMeshException(
+            "RINGMesh Test", "Special triangle pairs are not discriminating" );
+    }
+}
+
+/*!
+ * Compares the intersections of random triangles whose vertices are on a
+ * small grid, so that most of them are degenerate or share vertices, and
+ * of the same triangles with a vertex moved by a few ulps
+ */
+void test_random_pairs()
+{
+    std::mt19937 random( 42 );
+    std::uniform_int_distribution< int > coordinate( 1, 3 );
+    std::uniform_int_distribution< index_t > index( 0, 5 );
+    std::uniform_int_distribution< int > ulps( -2, 2 );
+    auto random_point = [&random, &coordinate] {
+        return vec3( coordinate( random ), coordinate( random ),
+            coordinate( random ) );
+    };
+    index_t nb_pairs{ 20000 };
+    index_t nb_intersections{ 0 };
+    for( auto p : range( nb_pairs ) )
+    {
+        Triangle t0{ { random_point(), random_point(), random_point() } };
+        Triangle t1{ { random_point(), random_point(), random_point() } };
+        if( p % 2 == 1 )
+        {
+            auto moved = index( random );
+            auto& point = moved < 3 ? t0[moved] : t1[moved - 3];
+            auto axis = index( random ) % 3;
+            auto nb_ulps = ulps( random );
+            for( auto u : range( std::abs( nb_ulps ) ) )
+            {
+                ringmesh_unused( u );
+                point[axis] = std::nextafter(
+                    point[axis], nb_ulps > 0 ? 4. : 0. );
+            }
+        }
+        nb_intersections += check_pair( t0, t1 );
+    }
+    if( nb_intersections == 0 || nb_intersections == nb_pairs )
+    {
+        throw RINGMeshException(
+            "RINGMesh Test", "Random triangle pairs are not discriminating" );
+    }
+    Logger::out( "TEST", nb_intersections, " intersections among ", nb_pairs,
+        " random triangle pairs" );
+}
+
+/*!
+ * Compares the intersections of random triangles with triangles whose
+ * vertices are computed on their plane or on the lines of their edges: the
+ * rounded vertices are a few ulps away, on either side
+ */
+void test_near_coplanar_pairs()
+{
+    std::mt19937 random( 42 );
+    std::uniform_real_distribution< double > coordinate( 0, 1 );
+    std::uniform_real_distribution< double > weight( -0.5, 1.5 );
+    std::uniform_int_distribution< int > on_edge( 0, 3 );
+    auto random_point = [&random, &coordinate] {
+        return vec3( coordinate( random ), coordinate( random ),
+            coordinate( random ) );
+    };
+    index_t nb_pairs{ 20000 };
+    index_t nb_intersections{ 0 };
+    for( auto p : range( nb_pairs ) )
+    {
+        ringmesh_unused( p );
+        Triangle t0{ { random_point(), random_point(), random_point() } };
+        Triangle t1;
+        for( auto& point : t1 )
+        {
+            auto w0 = weight( random );
+            auto w1 = on_edge( random ) == 0 ? 1. - w0 : weight( random );
+            point = w0 * t0[0] + w1 * t0[1] + ( 1. - w0 - w1 ) * t0[2];
+        }
+        if( on_edge( random ) == 0 )
+        {
+            t1[2] = random_point();
+        }
+        nb_intersections += check_pair( t0, t1 );
+    }
+    if( nb_intersections == 0 || nb_intersections == nb_pairs )
+    {
+        throw RINGMeshException( "RINGMesh Test",
+            "Near coplanar triangle pairs are not discriminating" );
+    }
+    Logger::out( "TEST", nb_intersections, " intersections among ", nb_pairs,
+        " near coplanar triangle pairs" );
+}
+
+int main()
+{
+    try
+    {
+        test_special_pairs();
+        test_random_pairs();
+        test_near_coplanar_pairs();
+    }
+    catch( const RINGMeshException& e )
+    {
+        Logger::err( e.category(), e.what() );
+        return 1;
+    }
+    catch( const std::exception& e )
+    {
+        Logger::err( "Exception", e.what() );
+        return 1;
+    }
+    Logger::out( "TEST", "SUCCESS" );
+    return 0;
+}
@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2012-2018, Association Scientifique pour la Geologie et ses
+ * Applications (ASGA). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of ASGA nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL ASGA BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *     http://www.ring-team.org
+ *
+ *     RING Project
+ *     Ecole Nationale Superieure de Geologie - GeoRessources
+ *     2 Rue du Doyen Marcel Roubault - TSA 70605
+ *     54518 VANDOEUVRE-LES-NANCY
+ *     FRANCE
+ */
+
+
+#include <ringmesh/ringmesh_tests_config.h>
+
+#include <algorithm>
+#include <sstream>
+
+#include <geogram/basic/command_line.h>
+#include <geogram/mesh/mesh.h>
+
+#include <ringmesh/geomodel/builder/geomodel_builder.h>
+#include <ringmesh/geomodel/builder/geomodel_builder_from_mesh.h>
+#include <ringmesh/geomodel/core/geomodel.h>
+#include <ringmesh/geomodel/core/geomodel_mesh_entity.h>
+#include <ringmesh/geomodel/tools/geomodel_validity.h>
+#include <ringmesh/mesh/mesh_index.h>
+
+/*!
+ * Tests that the validity check of a cube GeoModel whose Surfaces have
+ * degenerate polygons gives the same result and the same warnings, in the
+ * same order, with and without multithreading.
+ */
+
+using namespace RINGMesh;
+
+const index_t nb_subdivisions = 4;
+
+void add_square( GEO::Mesh& mesh,
+    const vec3& origin,
+    const vec3& u_axis,
+    const vec3& v_axis )
+{
+    auto nb_points = nb_subdivisions + 1;
+    auto first = mesh.vertices.create_vertices( nb_points * nb_points );
+    for( auto i : range( nb_points ) )
+    {
+        for( auto j : range( nb_points ) )
+        {
+            mesh.vertices.point( first + i * nb_points + j ) =
+                origin + ( double( i ) / nb_subdivisions ) * u_axis
+                + ( double( j ) / nb_subdivisions ) * v_axis;
+        }
+    }
+    for( auto i : range( nb_subdivisions ) )
+    {
+        for( auto j : range( nb_subdivisions ) )
+        {
+            auto v00 = first + i * nb_points + j;
+            auto v10 = v00 + nb_points;
+            mesh.facets.create_triangle( v00, v10, v10 + 1 );
+            mesh.facets.create_triangle( v00, v10 + 1, v00 + 1 );
+        }
+    }
+}
+
+void build_cube( GeoModel3D& geomodel )
+{
+    GEO::Mesh mesh;
+    vec3 x( 1, 0, 0 );
+    vec3 y( 0, 1, 0 );
+    vec3 z( 0, 0, 1 );
+    add_square( mesh, vec3(), y, z );
+    add_square( mesh, x, y, z );
+    add_square( mesh, vec3(), x, z );
+    add_square( mesh, y, x, z );
+    add_square( mesh, vec3(), x, y );
+    add_square( mesh, z, x, y );
+    mesh.facets.connect();
+
+    GeoModelBuilderSurfaceMesh builder( geomodel, mesh );
+    builder.build_polygonal_surfaces_from_connected_components();
+    builder.build_lines_and_corners_from_surfaces();
+    builder.build_regions_from_lines_and_surfaces();
+    builder.end_geomodel();
+}
+
+/*!
+ * Collapses the first edge of a polygon of each Surface so that every
+ * Surface logs its own warnings
+ */
+void break_surfaces( GeoModel3D& geomodel )
+{
+    GeoModelBuilder3D builder( geomodel );
+    for( const auto& surface : geomodel.surfaces() )
+    {
+        auto polygon = surface.nb_mesh_elements() / 2;
+        auto v0 = surface.mesh_element_vertex_index( { polygon, 0 } );
+        auto v1 = surface.mesh_element_vertex_index( { polygon, 1 } );
+        builder.geometry.set_mesh_entity_vertex(
+            surface.gmme(), v1, surface.vertex( v0 ), false );
+    }
+}
+
+bool check_validity( const GeoModel3D& geomodel,
+    bool multithread,
+    Logger::CapturedMessages& messages )
+{
+    GEO::CmdLine::set_arg( "sys:multithread", multithread );
+    Logger::MessageCapture capture;
+    auto valid = is_geomodel_valid( geomodel, ValidityCheckMode::ALL );
+    messages = capture.messages();
+    return valid;
+}
+
+void check_same_messages( const Logger::CapturedMessages& sequential,
+    const Logger::CapturedMessages& parallel )
+{
+    if( sequential.size() != parallel.size() )
+    {
+        throw RINGMeshException( "RINGMesh Test", "Sequential check logs ",
+            sequential.size(), " messages, parallel check logs ",
+            parallel.size() );
+    }
+    for( auto m : range( sequential.size() ) )
+    {
+        if( sequential[m].is_error != parallel[m].is_error
+            || sequential[m].feature != parallel[m].feature
+            || sequential[m].message != parallel[m].message )
+        {
+            throw RINGMeshException( "RINGMesh Test", "Message ", m,
+                " differs: \"", sequential[m].message, "\" vs \"",
+                parallel[m].message, "\"" );
+        }
+    }
+}
+
+void check_entity_messages( const GeoModel3D& geomodel,
+    const Logger::CapturedMessages& messages )
+{
+    for( const auto& surface : geomodel.surfaces() )
+    {
+        std::ostringstream oss;
+        oss << surface.gmme() << " mesh has ";
+        auto found = std::any_of( messages.begin(), messages.end(),
+            [&oss]( const Logger::CapturedMessage& message ) {
+                return message.feature == "GeoModelEntity"
+                       && message.message.find( oss.str() ) == 0;
+            } );
+        if( !found )
+        {
+            throw RINGMeshException( "RINGMesh Test",
+                "Missing the warning of ", surface.gmme() );
+        }
+    }
+}
+
+int main()
+{
+    try
+    {
+        GeoModel3D geomodel;
+        build_cube( geomodel );
+
+        Logger::CapturedMessages sequential;
+        Logger::CapturedMessages parallel;
+        if( !check_validity( geomodel, false, sequential )
+            || !check_validity( geomodel, true, parallel ) )
+        {
+            throw RINGMeshException(
+                "RINGMesh Test", "Cube GeoModel is not valid" );
+        }
+        check_same_messages( sequential, parallel );
+
+        break_surfaces( geomodel );
+        auto sequential_valid = check_validity( geomodel, false, sequential );
+        auto parallel_valid = check_validity( geomodel, true, parallel );
+        if( sequential_valid || parallel_valid )
+        {
+            throw RINGMeshException(
+                "RINGMesh Test", "Broken cube GeoModel is valid" );
+        }
+        check_same_messages( sequential, parallel );
+        check_entity_messages( geomodel, sequential );
+    }
+    catch( const RINGMeshException& e )
+    {
+        Logger::err( e.category(), e.what() );
+        return 1;
+    }
+    catch( const std::exception& e )
+    {
+        Logger::err( "Exception", e.what() );
+        return 1;
+    }
+    Logger::out( "TEST", "SUCCESS" );
+    return 0;
+}
@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2012-2018, Association Scientifique pour la Geologie et ses
+ * Applications (ASGA). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of ASGA nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL ASGA BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *     http://www.ring-team.org
+ *
+ *     RING Project
+ *     Ecole Nationale Superieure de Geologie - GeoRessources
+ *     2 Rue du Doyen Marcel Roubault - TSA 70605
+ *     54518 VANDOEUVRE-LES-NANCY
+ *     FRANCE
+ */
+
+
+#include <ringmesh/ringmesh_tests_config.h>
+
+#include <algorithm>
+#include <set>
+#include <sstream>
+
+#include <geogram/mesh/mesh.h>
+
+#include <ringmesh/geomodel/builder/geomodel_builder.h>
+#include <ringmesh/geomodel/builder/geomodel_builder_from_mesh.h>
+#include <ringmesh/geomodel/core/geomodel.h>
+#include <ringmesh/geomodel/core/geomodel_mesh_entity.h>
+#include <ringmesh/geomodel/tools/geomodel_validity.h>
+#include <ringmesh/mesh/mesh_index.h>
+
+/*!
+ * Tests the incremental validity checks of a GeoModelValiditySession:
+ * after the geometry of one Surface of a cube GeoModel is edited, only the
+ * checks of this Surface are run again, the results of the other
+ * Surfaces being kept from the previous check. Accessing the GeoModel
+ * through a builder without changing its geometry or its topology keeps
+ * all the results.
+ */
+
+using namespace RINGMesh;
+
+const ValidityCheckMode mode = ValidityCheckMode::MESH_ENTITIES;
+
+const index_t nb_subdivisions = 4;
+
+void add_square( GEO::Mesh& mesh,
+    const vec3& origin,
+    const vec3& u_axis,
+    const vec3& v_axis )
+{
+    auto nb_points = nb_subdivisions + 1;
+    auto first = mesh.vertices.create_vertices( nb_points * nb_points );
+    for( auto i : range( nb_points ) )
+    {
+        for( auto j : range( nb_points ) )
+        {
+            mesh.vertices.point( first + i * nb_points + j ) =
+                origin + ( double( i ) / nb_subdivisions ) * u_axis
+                + ( double( j ) / nb_subdivisions ) * v_axis;
+        }
+    }
+    for( auto i : range( nb_subdivisions ) )
+    {
+        for( auto j : range( nb_subdivisions ) )
+        {
+            auto v00 = first + i * nb_points + j;
+            auto v10 = v00 + nb_points;
+            mesh.facets.create_triangle( v00, v10, v10 + 1 );
+            mesh.facets.create_triangle( v00, v10 + 1, v00 + 1 );
+        }
+    }
+}
+
+void build_cube( GeoModel3D& geomodel )
+{
+    GEO::Mesh mesh;
+    vec3 x( 1, 0, 0 );
+    vec3 y( 0, 1, 0 );
+    vec3 z( 0, 0, 1 );
+    add_square( mesh, vec3(), y, z );
+    add_square( mesh, x, y, z );
+    add_square( mesh, vec3(), x, z );
+    add_square( mesh, y, x, z );
+    add_square( mesh, vec3(), x, y );
+    add_square( mesh, z, x, y );
+    mesh.facets.connect();
+
+    GeoModelBuilderSurfaceMesh builder( geomodel, mesh );
+    builder.build_polygonal_surfaces_from_connected_components();
+    builder.build_lines_and_corners_from_surfaces();
+    builder.build_regions_from_lines_and_surfaces();
+    builder.end_geomodel();
+}
+
+/*!
+ * Collapses the first edge of a polygon of the Surface @param surface_id
+ */
+void break_surface( GeoModel3D& geomodel, index_t surface_id )
+{
+    GeoModelBuilder3D builder( geomodel );
+    const auto& surface = geomodel.surface( surface_id );
+    auto polygon = surface.nb_mesh_elements() / 2;
+    auto v0 = surface.mesh_element_vertex_index( { polygon, 0 } );
+    auto v1 = surface.mesh_element_vertex_index( { polygon, 1 } );
+    builder.geometry.set_mesh_entity_vertex(
+        surface.gmme(), v1, surface.vertex( v0 ), false );
+}
+
+/*!
+ * Uses a builder without changing the geometry or the topology
+ */
+void access_through_builder( GeoModel3D& geomodel )
+{
+    GeoModelBuilder3D builder( geomodel );
+    std::set< gmme_id > mesh_entities{ geomodel.surface( 2 ).gmme() };
+    std::set< gmge_id > geological_entities;
+    builder.topology.get_dependent_entities(
+        mesh_entities, geological_entities );
+    builder.topology.find_or_create_corner( geomodel.corner( 0 ).vertex( 0 ) );
+    builder.info.set_mesh_entity_name(
+        geomodel.surface( 3 ).gmme(), "renamed_surface" );
+    builder.info.set_geomodel_name( "renamed_cube" );
+}
+
+bool check_session( GeoModelValiditySession3D& session,
+    Logger::CapturedMessages& messages )
+{
+    Logger::MessageCapture capture;
+    auto valid = session.is_geomodel_valid();
+    messages = capture.messages();
+    return valid;
+}
+
+bool is_surface_checked( const GeoModel3D& geomodel,
+    index_t surface_id,
+    const Logger::CapturedMessages& messages )
+{
+    std::ostringstream oss;
+    oss << geomodel.surface( surface_id ).gmme() << " mesh has ";
+    return std::any_of( messages.begin(), messages.end(),
+        [&oss]( const Logger::CapturedMessage& message ) {
+            return message.feature == "GeoModelEntity"
+                   && message.message.find( oss.str() ) == 0;
+        } );
+}
+
+void check_nb_invalid_entities(
+    index_t nb_invalid, const Logger::CapturedMessages& messages )
+{
+    std::ostringstream oss;
+    oss << nb_invalid << " mesh entities of the GeoModel have an invalid mesh.";
+    auto found = std::any_of( messages.begin(), messages.end(),
+        [&oss]( const Logger::CapturedMessage& message ) {
+            return message.feature == "Validity"
+                   && message.message == oss.str();
+        } );
+    if( !found )
+    {
+        throw RINGMeshException( "RINGMesh Test", "Validity session does not ",
+            "report ", nb_invalid, " invalid mesh entities" );
+    }
+}
+
+int main()
+{
+    try
+    {
+        GeoModel3D geomodel;
+        build_cube( geomodel );
+        GeoModelValiditySession3D session( geomodel, mode );
+        Logger::CapturedMessages messages;
+        if( !check_session( session, messages ) )
+        {
+            throw RINGMeshException(
+                "RINGMesh Test", "Cube GeoModel is not valid" );
+        }
+
+        break_surface( geomodel, 0 );
+        break_surface( geomodel, 5 );
+        if( check_session( session, messages ) )
+        {
+            throw RINGMeshException( "RINGMesh Test",
+                "Validity session fails to detect broken Surfaces" );
+        }
+        if( !is_surface_checked( geomodel, 0, messages )
+            || !is_surface_checked( geomodel, 5, messages ) )
+        {
+            throw RINGMeshException(
+                "RINGMesh Test", "Edited Surfaces are not checked again" );
+        }
+        check_nb_invalid_entities( 2, messages );
+
+        break_surface( geomodel, 1 );
+        if( check_session( session, messages ) )
+        {
+            throw RINGMeshException( "RINGMesh Test",
+                "Validity session fails to detect a broken Surface" );
+        }
+        if( !is_surface_checked( geomodel, 1, messages ) )
+        {
+            throw RINGMeshException(
+                "RINGMesh Test", "Edited Surface 1 is not checked again" );
+        }
+        for( auto s : range( geomodel.nb_surfaces() ) )
+        {
+            if( s != 1 && is_surface_checked( geomodel, s, messages ) )
+            {
+                throw RINGMeshException( "RINGMesh Test", "Surface ", s,
+                    " is checked again while it is not edited" );
+            }
+        }
+        check_nb_invalid_entities( 3, messages );
+
+        if( is_geomodel_valid( geomodel, mode )
+            || check_session( session, messages ) )
+        {
+            throw RINGMeshException(
+                "RINGMesh Test", "Broken cube GeoModel is valid" );
+        }
+        if( std::any_of( messages.begin(), messages.end(),
+                []( const Logger::CapturedMessage& message ) {
+                    return message.feature == "GeoModelEntity";
+                } ) )
+        {
+            throw RINGMeshException( "RINGMesh Test",
+                "Entities are checked again without any change" );
+        }
+
+        auto nb_corners = geomodel.nb_corners();
+        auto surfaces_revision = geomodel.surfaces_revision();
+        access_through_builder( geomodel );
+        if( geomodel.nb_corners() != nb_corners
+            || geomodel.surfaces_revision() != surfaces_revision )
+        {
+            throw RINGMeshException( "RINGMesh Test",
+                "Read-only builder access modifies the GeoModel" );
+        }
+        if( check_session( session, messages ) )
+        {
+            throw RINGMeshException(
+                "RINGMesh Test", "Broken cube GeoModel is valid" );
+        }
+        if( std::any_of( messages.begin(), messages.end(),
+                []( const Logger::CapturedMessage& message ) {
+                    return message.feature == "GeoModelEntity";
+                } ) )
+        {
+            throw RINGMeshException( "RINGMesh Test",
+                "Entities are checked again after a read-only builder access" );
+        }
+    }
+    catch( const RINGMeshException& e )
+    {
+        Logger::err( e.category(), e.what() );
+        return 1;
+    }
+    catch( const std::exception& e )
+    {
+        Logger::err( "Exception", e.what() );
+        return 1;
+    }
+    Logger::out( "TEST", "SUCCESS" );
+    return 0;
+}
@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) 2012-2018, Association Scientifique pour la Geologie et ses
+ * Applications (ASGA). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of ASGA nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL ASGA BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *     http://www.ring-team.org
+ *
+ *     RING Project
+ *     Ecole Nationale Superieure de Geologie - GeoRessources
+ *     2 Rue du Doyen Marcel Roubault - TSA 70605
+ *     54518 VANDOEUVRE-LES-NANCY
+ *     FRANCE
+ */
+
+#include <ringmesh/ringmesh_tests_config.h>
+
+#include <cfenv>
+#include <cfloat>
+#include <clocale>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <sstream>
+
+#include <ringmesh/basic/logger.h>
+
+#include <ringmesh/io/buffered_text_writer.h>
+#include <ringmesh/io/io.h>
+
+/*!
+ * @file Test the number formatting of TextBuffer and BufferedTextWriter
+ */
+
+using namespace RINGMesh;
+
+const std::vector< double > values = { 0., -0., 1., -1., 0.5, 0.1, 1. / 3.,
+    -2. / 3., 123.456, 1500., 1e22, 1e23, 9007199254740993., 1e-3, 1.25e-7,
+    6.02214076e23, 1e300, -1e-300, DBL_MAX, DBL_MIN, 4.9e-324 };
+
+std::string format( double value, FloatFormat format, index_t precision )
+{
+    TextBuffer buffer( precision, format );
+    buffer << value;
+    return buffer.str();
+}
+
+void check_string( const std::string& result, const std::string& expected )
+{
+    if( result != expected )
+    {
+        throw RINGMeshException( "RINGMesh Test", "Formatted ", result,
+            " instead of ", expected );
+    }
+}
+
+void test_round_trips( FloatFormat float_format, const std::string& name )
+{
+    for( auto value : values )
+    {
+        auto text = format( value, float_format, 0 );
+        char* end{ nullptr };
+        // Reading subnormal numbers raises trapped underflow exceptions
+        std::fenv_t environment;
+        std::feholdexcept( &environment );
+        auto read_value = std::strtod( text.c_str(), &end );
+        std::fesetenv( &environment );
+        if( read_value != value || *end != '\0'
+            || std::signbit( read_value ) != std::signbit( value ) )
+        {
+            throw RINGMeshException( "RINGMesh Test", "Value ", text,
+                " does not read back in ", name, " format" );
+        }
+    }
+}
+
+void test_shortest_representations()
+{
+    check_string( format( 0.5, FloatFormat::GENERAL, 0 ), "0.5" );
+    check_string( format( 0.1, FloatFormat::GENERAL, 0 ), "0.1" );
+    check_string( format( 1e22, FloatFormat::GENERAL, 0 ), "1e+22" );
+
+    check_string( format( 0., FloatFormat::SCIENTIFIC, 0 ), "0e+00" );
+    check_string( format( 1., FloatFormat::SCIENTIFIC, 0 ), "1e+00" );
+    check_string( format( 0.5, FloatFormat::SCIENTIFIC, 0 ), "5e-01" );
+    check_string(
+        format( -1.25e10, FloatFormat::SCIENTIFIC, 0 ), "-1.25e+10" );
+    check_string( format( 1. / 3., FloatFormat::SCIENTIFIC, 0 ),
+        "3.333333333333333e-01" );
+
+    check_string( format( 0., FloatFormat::FIXED, 0 ), "0" );
+    check_string( format( -0., FloatFormat::FIXED, 0 ), "-0" );
+    check_string( format( 1500., FloatFormat::FIXED, 0 ), "1500" );
+    check_string( format( 123.456, FloatFormat::FIXED, 0 ), "123.456" );
+    check_string( format( 0.5, FloatFormat::FIXED, 0 ), "0.5" );
+    check_string( format( -1.25e-7, FloatFormat::FIXED, 0 ), "-0.000000125" );
+    check_string( format( 1e22, FloatFormat::FIXED, 0 ),
+        "10000000000000000000000" );
+}
+
+void test_precisions()
+{
+    for( auto value : values )
+    {
+        std::ostringstream general;
+        general.precision( 6 );
+        general << value;
+        check_string( format( value, FloatFormat::GENERAL, 6 ), general.str() );
+
+        std::ostringstream scientific;
+        scientific.precision( 8 );
+        scientific << std::scientific << value;
+        check_string(
+            format( value, FloatFormat::SCIENTIFIC, 8 ), scientific.str() );
+
+        std::ostringstream fixed;
+        fixed.precision( 3 );
+        fixed << std::fixed << value;
+        check_string( format( value, FloatFormat::FIXED, 3 ), fixed.str() );
+    }
+}
+
+void test_integers_and_width()
+{
+    TextBuffer buffer;
+    buffer << TextWidth( 4 ) << 12 << ' ' << -7 << ' '
+           << std::numeric_limits< long long >::min() << ' '
+           << std::numeric_limits< unsigned long long >::max() << ' '
+           << vec3( 1., -0.5, 2.25 );
+    check_string( buffer.str(), "  12 -7 -9223372036854775808 "
+                                "18446744073709551615 1 -0.5 2.25" );
+}
+
+void test_locale()
+{
+    if( std::setlocale( LC_NUMERIC, "fr_FR.UTF-8" ) == nullptr
+        && std::setlocale( LC_NUMERIC, "de_DE.UTF-8" ) == nullptr )
+    {
+        Logger::out( "TEST", "No locale with a comma, skip locale test" );
+        return;
+    }
+    std::string general = format( 0.5, FloatFormat::GENERAL, 0 );
+    std::string scientific = format( 0.5, FloatFormat::SCIENTIFIC, 3 );
+    std::string fixed = format( 0.5, FloatFormat::FIXED, 2 );
+    std::setlocale( LC_NUMERIC, "C" );
+    check_string( general, "0.5" );
+    check_string( scientific, "5.000e-01" );
+    check_string( fixed, "0.50" );
+}
+
+void test_file_writer()
+{
+    std::string filename = ringmesh_test_output_path + "buffered_text.txt";
+    const index_t nb_items = 20000;
+    std::string expected;
+    {
+        BufferedTextWriter writer( filename, 0, FloatFormat::SCIENTIFIC );
+        writer << "header " << nb_items << EOL;
+        TextBuffer serial( 0, FloatFormat::SCIENTIFIC );
+        serial << "header " << nb_items << EOL;
+        writer.write_parallel( nb_items, []( TextBuffer& buffer, index_t i ) {
+            buffer << i << SPACE << 1. / ( i + 1 ) << EOL;
+        } );
+        for( auto i : range( nb_items ) )
+        {
+            serial << i << SPACE << 1. / ( i + 1 ) << EOL;
+        }
+        writer << "end" << EOL;
+        serial << "end" << EOL;
+        expected = serial.str();
+    }
+    std::ifstream file( filename.c_str() );
+    std::string content( ( std::istreambuf_iterator< char >( file ) ),
+        std::istreambuf_iterator< char >() );
+    if( content != expected )
+    {
+        throw RINGMeshException(
+            "RINGMesh Test", "Parallel output differs from the serial one" );
+    }
+}
+
+int main()
+{
+    try
+    {
+        Logger::out( "TEST", "Test BufferedTextWriter" );
+        test_round_trips( FloatFormat::GENERAL, "general" );
+        test_round_trips( FloatFormat::SCIENTIFIC, "scientific" );
+        test_round_trips( FloatFormat::FIXED, "fixed" );
+        test_shortest_representations();
+        test_precisions();
+        test_integers_and_width();
+        test_locale();
+        test_file_writer();
+    }
+    catch( const RINGMeshException& e )
+    {
+        Logger::err( e.category(), e.what() );
+        return 1;
+    }
+    catch( const std::exception& e )
+    {
+        Logger::err( "Exception", e.what() );
+        return 1;
+    }
+    Logger::out( "TEST", "SUCCESS" );
+    return 0;
+}
@@ -152,6 +152,12 @@ void check_geomodel( const GeoModel3D& geomodel,
 template < index_t DIMENSION >
 void process_extension( const std::string& extension )
 {
+    if( extension == "msh" )
+    {
+        // The MSH import is checked by the binary MSH round trip
+        // of test-save-geomodel
+        return;
+    }
     std::string info{ ringmesh_test_load_path + extension
                       + std::to_string( DIMENSION ) + "d.txt" };
     GEO::LineInput in{ info };
@@ -0,0 +1,273 @@
+/*
+ * Copyright (c) 2012-2018, Association Scientifique pour la Geologie et ses
+ * Applications (ASGA). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of ASGA nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL ASGA BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *     http://www.ring-team.org
+ *
+ *     RING Project
+ *     Ecole Nationale Superieure de Geologie - GeoRessources
+ *     2 Rue du Doyen Marcel Roubault - TSA 70605
+ *     54518 VANDOEUVRE-LES-NANCY
+ *     FRANCE
+ */
+
+#include <ringmesh/ringmesh_tests_config.h>
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
+#include <geogram/mesh/mesh.h>
+
+#include <ringmesh/geomodel/builder/geomodel_builder_from_mesh.h>
+#include <ringmesh/geomodel/core/geomodel.h>
+#include <ringmesh/geomodel/core/well.h>
+
+#include <ringmesh/io/io.h>
+
+/*!
+ * Tests the loading of the same well trajectories from a Gocad well file
+ * and from a binary well trajectory file written in little endian order.
+ */
+
+using namespace RINGMesh;
+
+struct Trajectory
+{
+    std::string name;
+    std::vector< vec3 > vertices;
+};
+
+void add_square( GEO::Mesh& mesh,
+    const vec3& origin,
+    const vec3& u_axis,
+    const vec3& v_axis )
+{
+    auto first = mesh.vertices.create_vertices( 4 );
+    mesh.vertices.point( first ) = origin;
+    mesh.vertices.point( first + 1 ) = origin + u_axis;
+    mesh.vertices.point( first + 2 ) = origin + u_axis + v_axis;
+    mesh.vertices.point( first + 3 ) = origin + v_axis;
+    mesh.facets.create_triangle( first, first + 1, first + 2 );
+    mesh.facets.create_triangle( first, first + 2, first + 3 );
+}
+
+void build_cube( GeoModel3D& geomodel )
+{
+    GEO::Mesh mesh;
+    vec3 x( 1, 0, 0 );
+    vec3 y( 0, 1, 0 );
+    vec3 z( 0, 0, 1 );
+    add_square( mesh, vec3(), y, z );
+    add_square( mesh, x, y, z );
+    add_square( mesh, vec3(), x, z );
+    add_square( mesh, y, x, z );
+    add_square( mesh, vec3(), x, y );
+    add_square( mesh, z, x, y );
+    mesh.facets.connect();
+
+    GeoModelBuilderSurfaceMesh builder( geomodel, mesh );
+    builder.build_polygonal_surfaces_from_connected_components();
+    builder.build_lines_and_corners_from_surfaces();
+    builder.build_regions_from_lines_and_surfaces();
+    builder.end_geomodel();
+}
+
+void save_wl( const std::vector< Trajectory >& trajectories,
+    const std::string& filename )
+{
+    std::ofstream out( filename );
+    out.precision( 17 );
+    for( const auto& trajectory : trajectories )
+    {
+        const auto& ref = trajectory.vertices.front();
+        out << "GOCAD Well 1\nHEADER {\nname: " << trajectory.name
+            << "\n}\nZPOSITIVE Elevation\n";
+        out << "WREF " << ref.x << " " << ref.y << " " << ref.z << "\n";
+        for( auto v : range( 1, trajectory.vertices.size() ) )
+        {
+            const auto& vertex = trajectory.vertices[v];
+            out << "PATH " << v << " " << vertex.z << " " << vertex.x - ref.x
+                << " " << vertex.y - ref.y << "\n";
+        }
+        out << "END\n";
+    }
+}
+
+template < typename T >
+void write_little_endian( std::ofstream& out, T value )
+{
+    for( auto byte : range( sizeof( T ) ) )
+    {
+        out.put( static_cast< char >( ( value >> ( 8 * byte ) ) & 0xFF ) );
+    }
+}
+
+void write_little_endian( std::ofstream& out, double value )
+{
+    std::uint64_t bits;
+    std::memcpy( &bits, &value, sizeof( double ) );
+    write_little_endian( out, bits );
+}
+
+void save_wlb( const std::vector< Trajectory >& trajectories,
+    const std::string& filename )
+{
+    std::ofstream out( filename, std::ios::binary );
+    out.write( "RMWELLS1", 8 );
+    std::vector< std::uint64_t > offsets{ 0 };
+    for( const auto& trajectory : trajectories )
+    {
+        offsets.push_back( offsets.back() + trajectory.vertices.size() );
+    }
+    write_little_endian(
+        out, static_cast< std::uint32_t >( trajectories.size() ) );
+    write_little_endian( out, offsets.back() );
+    for( const auto& trajectory : trajectories )
+    {
+        write_little_endian(
+            out, static_cast< std::uint32_t >( trajectory.name.size() ) );
+        out.write( trajectory.name.data(),
+            static_cast< std::streamsize >( trajectory.name.size() ) );
+    }
+    for( auto offset : offsets )
+    {
+        write_little_endian( out, offset );
+    }
+    for( auto coordinate : range( 3 ) )
+    {
+        for( const auto& trajectory : trajectories )
+        {
+            for( const auto& vertex : trajectory.vertices )
+            {
+                write_little_endian( out, vertex[coordinate] );
+            }
+        }
+    }
+}
+
+void check_same_wells( const WellGroup3D& wells, const WellGroup3D& reference )
+{
+    if( wells.nb_wells() != reference.nb_wells() )
+    {
+        throw RINGMeshException( "RINGMesh Test", "Wrong number of wells" );
+    }
+    for( auto w : range( wells.nb_wells() ) )
+    {
+        const auto& well = wells.well( w );
+        const auto& reference_well = reference.well( w );
+        if( well.name() != reference_well.name()
+            || well.nb_parts() != reference_well.nb_parts() )
+        {
+            throw RINGMeshException(
+                "RINGMesh Test", "Wrong parts of well ", well.name() );
+        }
+        for( auto p : range( well.nb_parts() ) )
+        {
+            const auto& part = well.part( p );
+            const auto& reference_part = reference_well.part( p );
+            if( part.nb_vertices() != reference_part.nb_vertices() )
+            {
+                throw RINGMeshException( "RINGMesh Test",
+                    "Wrong vertices in part ", p, " of well ", well.name() );
+            }
+            for( auto v : range( part.nb_vertices() ) )
+            {
+                if( ( part.vertex( v ) - reference_part.vertex( v ) ).length()
+                    > global_epsilon )
+                {
+                    throw RINGMeshException( "RINGMesh Test", "Wrong vertex ",
+                        v, " in part ", p, " of well ", well.name() );
+                }
+            }
+        }
+    }
+}
+
+void check_trajectory_ends(
+    const WellGroup3D& wells, const std::vector< Trajectory >& trajectories )
+{
+    for( auto w : range( wells.nb_wells() ) )
+    {
+        const auto& well = wells.well( w );
+        const auto& first_part = well.part( 0 );
+        const auto& last_part = well.part( well.nb_parts() - 1 );
+        const auto& first = first_part.vertex( 0 );
+        const auto& last = last_part.vertex( last_part.nb_vertices() - 1 );
+        // The parts may be built from either end of the trajectory
+        const auto& vertices = trajectories[w].vertices;
+        if( ( first != vertices.front() || last != vertices.back() )
+            && ( first != vertices.back() || last != vertices.front() ) )
+        {
+            throw RINGMeshException( "RINGMesh Test",
+                "Wrong trajectory ends of well ", well.name() );
+        }
+    }
+}
+
+int main()
+{
+    try
+    {
+        GeoModel3D geomodel;
+        build_cube( geomodel );
+
+        std::vector< Trajectory > trajectories( 2 );
+        trajectories[0].name = "vertical";
+        trajectories[0].vertices = { vec3( 0.25, 0.5, 1.5 ),
+            vec3( 0.25, 0.5, 0.75 ), vec3( 0.25, 0.5, -0.5 ) };
+        trajectories[1].name = "deviated";
+        trajectories[1].vertices = { vec3( 0.5, 0.25, 1.25 ),
+            vec3( 0.5, 0.5, 0.5 ), vec3( 0.75, 0.75, 0.25 ),
+            vec3( 1.5, 0.75, 0.25 ) };
+
+        auto wl_file = ringmesh_test_output_path + "wells.wl";
+        auto wlb_file = ringmesh_test_output_path + "wells.wlb";
+        save_wl( trajectories, wl_file );
+        save_wlb( trajectories, wlb_file );
+
+        WellGroup3D wl_wells;
+        wl_wells.set_geomodel( &geomodel );
+        well_load( wl_file, wl_wells );
+        WellGroup3D wlb_wells;
+        wlb_wells.set_geomodel( &geomodel );
+        well_load( wlb_file, wlb_wells );
+
+        check_trajectory_ends( wlb_wells, trajectories );
+        check_same_wells( wlb_wells, wl_wells );
+    }
+    catch( const RINGMeshException& e )
+    {
+        Logger::err( e.category(), e.what() );
+        return 1;
+    }
+    catch( const std::exception& e )
+    {
+        Logger::err( "Exception", e.what() );
+        return 1;
+    }
+    Logger::out( "TEST", "SUCCESS" );
+    return 0;
+}
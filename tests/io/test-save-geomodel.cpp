@@ -35,11 +35,19 @@
 
 #include <ringmesh/ringmesh_tests_config.h>
 
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+#include <geogram/basic/attributes.h>
 #include <geogram/basic/command_line.h>
 #include <geogram/basic/line_stream.h>
 
 #include <ringmesh/basic/algorithm.h>
 #include <ringmesh/geomodel/core/geomodel.h>
+#include <ringmesh/geomodel/core/geomodel_mesh_entity.h>
 
 #include <ringmesh/io/io.h>
 
@@ -226,6 +234,348 @@ void check_output_by_model(
     }
 }
 
+std::string vtu_attribute(
+    const std::string& tag, const std::string& attribute )
+{
+    auto start = tag.find( " " + attribute + "=\"" );
+    if( start == std::string::npos )
+    {
+        return "";
+    }
+    start += attribute.size() + 3;
+    return tag.substr( start, tag.find( '"', start ) - start );
+}
+
+/*!
+ * Raw appended arrays of a VTU file, by XML section and name
+ */
+class VTUArrays
+{
+public:
+    explicit VTUArrays( const std::string& filename )
+    {
+        std::ifstream vtu{ filename, std::ios::binary };
+        content_.assign( std::istreambuf_iterator< char >( vtu ),
+            std::istreambuf_iterator< char >() );
+        auto appended = content_.find( "<AppendedData encoding=\"raw\">" );
+        if( appended == std::string::npos )
+        {
+            throw RINGMeshException( "TEST", "No VTU appended data" );
+        }
+        data_start_ = content_.find( '_', appended ) + 1;
+        std::istringstream header{ content_.substr( 0, appended ) };
+        std::string section;
+        std::string line;
+        while( std::getline( header, line ) )
+        {
+            for( const std::string tag :
+                { "Points", "Cells", "PointData", "CellData" } )
+            {
+                if( line.find( "<" + tag ) == 0 )
+                {
+                    section = tag;
+                }
+            }
+            if( line.find( "<VTKFile " ) == 0 )
+            {
+                header_ = line;
+            }
+            if( line.find( "<Piece " ) == 0 )
+            {
+                piece_ = line;
+            }
+            if( line.find( "<DataArray " ) == 0 )
+            {
+                offsets_[section + "/" + vtu_attribute( line, "Name" )] =
+                    std::stoull( vtu_attribute( line, "offset" ) );
+            }
+        }
+    }
+
+    const std::string& piece() const
+    {
+        return piece_;
+    }
+
+    template < typename T >
+    std::vector< T > array(
+        const std::string& section, const std::string& name ) const
+    {
+        auto it = offsets_.find( section + "/" + name );
+        if( it == offsets_.end() )
+        {
+            throw RINGMeshException(
+                "TEST", "No VTU array ", name, " in ", section );
+        }
+        if( vtu_attribute( header_, "compressor" ) != "" )
+        {
+            throw RINGMeshException( "TEST", "Compressed VTU arrays" );
+        }
+        auto position = data_start_ + it->second;
+        std::uint64_t nb_bytes{ 0 };
+        if( position + sizeof( nb_bytes ) > content_.size() )
+        {
+            throw RINGMeshException( "TEST", "Wrong VTU offset of ", name );
+        }
+        std::memcpy( &nb_bytes, &content_[position], sizeof( nb_bytes ) );
+        if( position + sizeof( nb_bytes ) + nb_bytes > content_.size() )
+        {
+            throw RINGMeshException( "TEST", "Wrong VTU size of ", name );
+        }
+        std::vector< T > values( nb_bytes / sizeof( T ) );
+        std::memcpy( values.data(), &content_[position + sizeof( nb_bytes )],
+            nb_bytes );
+        return values;
+    }
+
+private:
+    std::string content_;
+    std::size_t data_start_{ 0 };
+    std::string header_;
+    std::string piece_;
+    std::map< std::string, std::size_t > offsets_;
+};
+
+template < index_t DIMENSION >
+void check_vtu_output( const GeoModel< DIMENSION >&, GEO::LineInput& )
+{
+    throw RINGMeshException( "TEST", "VTU output is only defined in 3D" );
+}
+
+template <>
+void check_vtu_output( const GeoModel3D& geomodel, GEO::LineInput& in )
+{
+    get_line( in );
+    VTUArrays vtu{ ringmesh_test_output_path + in.field( 0 ) };
+    if( vtu_attribute( vtu.piece(), "NumberOfPoints" )
+            != std::to_string( geomodel.mesh.vertices.nb() )
+        || vtu_attribute( vtu.piece(), "NumberOfCells" )
+               != std::to_string( geomodel.mesh.cells.nb() ) )
+    {
+        throw RINGMeshException(
+            "TEST", "Wrong VTU piece description: ", vtu.piece() );
+    }
+
+    // A vertex and a cell attribute with the same name
+    const std::string name{ "vtu_check" };
+    GEO::Attribute< double > vertex_attribute(
+        geomodel.mesh.vertices.attribute_manager(), name );
+    GEO::Attribute< double > cell_attribute(
+        geomodel.mesh.cells.attribute_manager(), name );
+    for( auto v : range( geomodel.mesh.vertices.nb() ) )
+    {
+        vertex_attribute[v] = v;
+    }
+    for( auto c : range( geomodel.mesh.cells.nb() ) )
+    {
+        cell_attribute[c] = -1. - c;
+    }
+    // Raw appended data, so that the arrays can be read back
+    const auto file = ringmesh_test_output_path + "geomodel3d_attributes.vtu";
+    GEO::CmdLine::set_arg( "io:compression", false );
+    geomodel_save( geomodel, file );
+    GEO::CmdLine::set_arg( "io:compression", true );
+    vertex_attribute.unbind();
+    cell_attribute.unbind();
+
+    VTUArrays attributes{ file };
+    auto points = attributes.array< double >( "Points", "Points" );
+    auto vertex_values = attributes.array< double >( "PointData", name );
+    if( points.size() != 3 * geomodel.mesh.vertices.nb()
+        || vertex_values.size() != geomodel.mesh.vertices.nb() )
+    {
+        throw RINGMeshException( "TEST", "Wrong VTU point arrays size" );
+    }
+    for( auto v : range( geomodel.mesh.vertices.nb() ) )
+    {
+        const auto& vertex = geomodel.mesh.vertices.vertex( v );
+        if( vertex_values[v] != v || points[3 * v] != vertex.x
+            || points[3 * v + 1] != vertex.y || points[3 * v + 2] != vertex.z )
+        {
+            throw RINGMeshException( "TEST", "Wrong VTU point ", v );
+        }
+    }
+    auto cell_values = attributes.array< double >( "CellData", name );
+    auto regions = attributes.array< std::int32_t >( "CellData", "region" );
+    auto offsets = attributes.array< std::int64_t >( "Cells", "offsets" );
+    auto connectivity =
+        attributes.array< std::int64_t >( "Cells", "connectivity" );
+    if( cell_values.size() != geomodel.mesh.cells.nb()
+        || regions.size() != geomodel.mesh.cells.nb()
+        || offsets.size() != geomodel.mesh.cells.nb()
+        || ( !offsets.empty()
+               && connectivity.size()
+                      != static_cast< std::size_t >( offsets.back() ) ) )
+    {
+        throw RINGMeshException( "TEST", "Wrong VTU cell arrays size" );
+    }
+    for( auto c : range( geomodel.mesh.cells.nb() ) )
+    {
+        if( cell_values[c] != -1. - c
+            || regions[c]
+                   != static_cast< std::int32_t >(
+                          geomodel.mesh.cells.region( c ) ) )
+        {
+            throw RINGMeshException( "TEST", "Wrong VTU cell ", c );
+        }
+    }
+}
+
+template < index_t DIMENSION >
+void check_msh_binary_output( const GeoModel< DIMENSION >& )
+{
+    throw RINGMeshException( "TEST", "MSH output is only defined in 3D" );
+}
+
+template <>
+void check_msh_binary_output( const GeoModel3D& geomodel )
+{
+    const auto file = ringmesh_test_output_path + "geomodel3d_binary.msh";
+    GEO::CmdLine::set_arg( "io:binary", true );
+    geomodel_save( geomodel, file );
+    GEO::CmdLine::set_arg( "io:binary", false );
+
+    GeoModel3D reloaded_geomodel;
+    geomodel_load( reloaded_geomodel, file );
+    for( const auto& type : geomodel.entity_type_manager()
+                                .mesh_entity_manager.mesh_entity_types() )
+    {
+        if( geomodel.nb_mesh_entities( type )
+            != reloaded_geomodel.nb_mesh_entities( type ) )
+        {
+            throw RINGMeshException( "TEST", "Wrong number of ", type.string(),
+                " after binary MSH round trip" );
+        }
+    }
+    if( geomodel.mesh.vertices.nb() != reloaded_geomodel.mesh.vertices.nb()
+        || geomodel.mesh.edges.nb() != reloaded_geomodel.mesh.edges.nb()
+        || geomodel.mesh.polygons.nb() != reloaded_geomodel.mesh.polygons.nb()
+        || geomodel.mesh.cells.nb() != reloaded_geomodel.mesh.cells.nb() )
+    {
+        throw RINGMeshException(
+            "TEST", "Wrong mesh after binary MSH round trip" );
+    }
+}
+
+template < index_t DIMENSION >
+void check_stl_binary_output( const GeoModel< DIMENSION >& )
+{
+    throw RINGMeshException( "TEST", "STL output is only defined in 3D" );
+}
+
+template <>
+void check_stl_binary_output( const GeoModel3D& geomodel )
+{
+    const auto file = ringmesh_test_output_path + "geomodel3d_binary.stl";
+    GEO::CmdLine::set_arg( "io:binary", true );
+    geomodel_save( geomodel, file );
+    GEO::CmdLine::set_arg( "io:binary", false );
+
+    std::uint32_t nb_triangles{ 0 };
+    for( const auto& surface : geomodel.surfaces() )
+    {
+        nb_triangles += surface.nb_mesh_elements();
+    }
+    std::ifstream in( file, std::ios::binary | std::ios::ate );
+    const auto file_size = static_cast< std::size_t >( in.tellg() );
+    std::uint32_t nb_stl_triangles{ 0 };
+    in.seekg( 80 );
+    in.read( reinterpret_cast< char* >( &nb_stl_triangles ),
+        sizeof( nb_stl_triangles ) );
+    if( !in || nb_stl_triangles != nb_triangles
+        || file_size != 84 + 50 * std::size_t( nb_triangles ) )
+    {
+        throw RINGMeshException( "TEST", "Wrong binary STL output" );
+    }
+}
+
+template < index_t DIMENSION >
+void check_so_output( const GeoModel< DIMENSION >& )
+{
+    throw RINGMeshException( "TEST", "TSolid output is only defined in 3D" );
+}
+
+template <>
+void check_so_output( const GeoModel3D& geomodel )
+{
+    // Tetrahedra are written region by region, in the region cell order
+    const double tolerance{ 1e-5 };
+    std::map< index_t, vec3 > vertices;
+    std::vector< std::vector< vec3 > > barycenters;
+    index_t nb_triangles{ 0 };
+    GEO::LineInput in{ ringmesh_test_output_path + "geomodel3d.so" };
+    while( !in.eof() && in.get_line() )
+    {
+        in.get_fields();
+        if( in.nb_fields() == 0 )
+        {
+            continue;
+        }
+        if( in.field_matches( 0, "TVOLUME" ) )
+        {
+            barycenters.emplace_back();
+        }
+        else if( in.field_matches( 0, "PVRTX" )
+                 || in.field_matches( 0, "VRTX" ) )
+        {
+            vertices[in.field_as_uint( 1 )] =
+                vec3( in.field_as_double( 2 ), in.field_as_double( 3 ),
+                    in.field_as_double( 4 ) );
+        }
+        else if( in.field_matches( 0, "ATOM" )
+                 || in.field_matches( 0, "PATOM" ) )
+        {
+            vertices[in.field_as_uint( 1 )] =
+                vertices[in.field_as_uint( 2 )];
+        }
+        else if( in.field_matches( 0, "TETRA" ) && !barycenters.empty() )
+        {
+            vec3 barycenter;
+            for( auto v : range( 1, 5 ) )
+            {
+                barycenter += 0.25 * vertices[in.field_as_uint( v )];
+            }
+            barycenters.back().push_back( barycenter );
+        }
+        else if( in.field_matches( 0, "TRGL" ) )
+        {
+            nb_triangles++;
+        }
+    }
+    if( barycenters.size() != geomodel.nb_regions() )
+    {
+        throw RINGMeshException( "TEST", "Wrong number of TSolid volumes" );
+    }
+    for( const auto& region : geomodel.regions() )
+    {
+        const auto& tetrahedra = barycenters[region.index()];
+        if( tetrahedra.size() != region.nb_mesh_elements() )
+        {
+            throw RINGMeshException( "TEST", "Wrong number of tetrahedra in ",
+                region.gmme(), " TSolid volume" );
+        }
+        for( auto c : range( region.nb_mesh_elements() ) )
+        {
+            auto barycenter = region.mesh_element_barycenter( c );
+            if( ( tetrahedra[c] - barycenter ).length()
+                > tolerance * ( 1. + barycenter.length() ) )
+            {
+                throw RINGMeshException( "TEST", "Wrong tetrahedron ", c,
+                    " of ", region.gmme(), " in TSolid" );
+            }
+        }
+    }
+    index_t nb_surface_triangles{ 0 };
+    for( const auto& surface : geomodel.surfaces() )
+    {
+        nb_surface_triangles += surface.nb_mesh_elements();
+    }
+    if( nb_triangles != nb_surface_triangles )
+    {
+        throw RINGMeshException( "TEST", "Wrong number of TSolid triangles" );
+    }
+}
+
 template < index_t DIMENSION >
 void io_geomodel( GeoModel< DIMENSION >& geomodel,
     const std::string& geomodel_file,
@@ -319,13 +669,31 @@ void process_extension( const std::string& extension )
     io_geomodel< DIMENSION >(
         geomodel, ringmesh_test_data_path + in.field( 0 ), extension );
 
-    if( extension == "epc" )
+    if( extension == "epc" || extension == "svg" )
     {
         check_output_by_model< DIMENSION >( geomodel, extension );
     }
+    else if( extension == "so" )
+    {
+        // The TSolid is checked against the regions and surfaces
+        check_so_output( geomodel );
+    }
+    else if( extension == "vtu" )
+    {
+        // Binary output: the appended arrays are checked
+        check_vtu_output( geomodel, in );
+    }
     else
     {
         check_output_by_file( in );
+        if( extension == "msh" )
+        {
+            check_msh_binary_output( geomodel );
+        }
+        else if( extension == "stl" )
+        {
+            check_stl_binary_output( geomodel );
+        }
     }
     Logger::out( "TEST", "Format ", extension, " OK" );
 }
@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2012-2018, Association Scientifique pour la Geologie et ses
+ * Applications (ASGA). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of ASGA nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL ASGA BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *     http://www.ring-team.org
+ *
+ *     RING Project
+ *     Ecole Nationale Superieure de Geologie - GeoRessources
+ *     2 Rue du Doyen Marcel Roubault - TSA 70605
+ *     54518 VANDOEUVRE-LES-NANCY
+ *     FRANCE
+ */
+
+#include <ringmesh/ringmesh_tests_config.h>
+
+#include <vector>
+
+#include <ringmesh/mesh/mesh_builder.h>
+#include <ringmesh/mesh/mesh_index.h>
+#include <ringmesh/mesh/surface_mesh.h>
+#include <ringmesh/mesh/volume_mesh.h>
+
+/*!
+ * @brief Tests the one pass computation of polygon and cell adjacencies
+ */
+
+using namespace RINGMesh;
+
+namespace
+{
+    void check_report( const AdjacencyReport& report,
+        index_t nb_connected,
+        index_t nb_borders,
+        index_t nb_non_manifold,
+        index_t nb_inconsistent )
+    {
+        if( report.nb_connected != nb_connected
+            || report.nb_borders != nb_borders
+            || report.nb_non_manifold != nb_non_manifold
+            || report.nb_inconsistent != nb_inconsistent )
+        {
+            throw RINGMeshException( "RINGMesh Test",
+                "Wrong adjacency report: ", report.nb_connected, " connected, ",
+                report.nb_borders, " borders, ", report.nb_non_manifold,
+                " non-manifold, ", report.nb_inconsistent, " inconsistent" );
+        }
+    }
+
+    void test_polygon_configurations()
+    {
+        auto mesh = SurfaceMesh3D::create_mesh();
+        auto builder = SurfaceMeshBuilder3D::create_builder( *mesh );
+        builder->create_vertices( 5 );
+        builder->create_polygon( { 0, 1, 2 } );
+        builder->create_polygon( { 0, 2, 3 } );
+        check_report( builder->compute_polygon_adjacencies(), 1, 4, 0, 0 );
+        if( mesh->polygon_adjacent( { 0, 2 } ) != 1
+            || mesh->polygon_adjacent( { 1, 0 } ) != 0 )
+        {
+            throw RINGMeshException(
+                "RINGMesh Test", "Polygons 0 and 1 should be adjacent" );
+        }
+
+        builder->create_polygon( { 2, 0, 4 } );
+        check_report( builder->compute_polygon_adjacencies(), 0, 6, 1, 0 );
+        if( mesh->polygon_adjacent( { 0, 2 } ) != NO_ID
+            || mesh->polygon_adjacent( { 1, 0 } ) != NO_ID )
+        {
+            throw RINGMeshException( "RINGMesh Test",
+                "Polygons around a non-manifold edge should not be adjacent" );
+        }
+
+        builder->delete_polygons( { false, true, false }, false );
+        check_report( builder->compute_polygon_adjacencies(), 0, 4, 0, 1 );
+    }
+
+    void test_polygon_grid()
+    {
+        const index_t size{ 150 };
+        auto mesh = SurfaceMesh3D::create_mesh();
+        auto builder = SurfaceMeshBuilder3D::create_builder( *mesh );
+        builder->create_vertices( ( size + 1 ) * ( size + 1 ) );
+        for( auto i : range( size ) )
+        {
+            for( auto j : range( size ) )
+            {
+                auto v0 = i * ( size + 1 ) + j;
+                auto v1 = v0 + 1;
+                auto v2 = v0 + size + 2;
+                auto v3 = v0 + size + 1;
+                builder->create_polygon( { v0, v1, v2 } );
+                builder->create_polygon( { v0, v2, v3 } );
+            }
+        }
+        builder->connect_polygons();
+        std::vector< index_t > expected;
+        for( auto p : range( mesh->nb_polygons() ) )
+        {
+            for( auto e : range( 3 ) )
+            {
+                expected.push_back( mesh->polygon_adjacent( { p, e } ) );
+            }
+        }
+
+        check_report( builder->compute_polygon_adjacencies(),
+            3 * size * size - 2 * size, 4 * size, 0, 0 );
+        for( auto p : range( mesh->nb_polygons() ) )
+        {
+            for( auto e : range( 3 ) )
+            {
+                if( mesh->polygon_adjacent( { p, e } ) != expected[3 * p + e] )
+                {
+                    throw RINGMeshException( "RINGMesh Test",
+                        "Wrong adjacent for edge ", e, " of polygon ", p );
+                }
+            }
+        }
+    }
+
+    void test_cell_grid()
+    {
+        const index_t size{ 20 };
+        auto mesh = VolumeMesh3D::create_mesh();
+        auto builder = VolumeMeshBuilder3D::create_builder( *mesh );
+        builder->create_vertices( ( size + 1 ) * ( size + 1 ) * ( size + 1 ) );
+        auto vertex = [size]( index_t i, index_t j, index_t k ) {
+            return ( k * ( size + 1 ) + j ) * ( size + 1 ) + i;
+        };
+        builder->create_cells( size * size * size, CellType::HEXAHEDRON );
+        index_t cell{ 0 };
+        for( auto k : range( size ) )
+        {
+            for( auto j : range( size ) )
+            {
+                for( auto i : range( size ) )
+                {
+                    for( auto v : range( 8 ) )
+                    {
+                        builder->set_cell_vertex( { cell, v },
+                            vertex( i + ( v & 1 ), j + ( ( v >> 1 ) & 1 ),
+                                k + ( v >> 2 ) ) );
+                    }
+                    cell++;
+                }
+            }
+        }
+        builder->connect_cells();
+        std::vector< index_t > expected;
+        for( auto c : range( mesh->nb_cells() ) )
+        {
+            for( auto f : range( mesh->nb_cell_facets( c ) ) )
+            {
+                expected.push_back( mesh->cell_adjacent( { c, f } ) );
+            }
+        }
+
+        check_report( builder->compute_cell_adjacencies(),
+            3 * size * size * ( size - 1 ), 6 * size * size, 0, 0 );
+        index_t facet{ 0 };
+        for( auto c : range( mesh->nb_cells() ) )
+        {
+            for( auto f : range( mesh->nb_cell_facets( c ) ) )
+            {
+                if( mesh->cell_adjacent( { c, f } ) != expected[facet++] )
+                {
+                    throw RINGMeshException( "RINGMesh Test",
+                        "Wrong adjacent for facet ", f, " of cell ", c );
+                }
+            }
+        }
+    }
+
+    void run_tests()
+    {
+        test_polygon_configurations();
+        test_polygon_grid();
+        test_cell_grid();
+    }
+} // namespace
+
+int main()
+{
+    using namespace RINGMesh;
+
+    try
+    {
+        Logger::out( "TEST", "Test mesh adjacencies" );
+        run_tests();
+    }
+    catch( const RINGMeshException& e )
+    {
+        Logger::err( e.category(), e.what() );
+        return 1;
+    }
+    catch( const std::exception& e )
+    {
+        Logger::err( "Exception", e.what() );
+        return 1;
+    }
+    Logger::out( "TEST", "SUCCESS" );
+    return 0;
+}
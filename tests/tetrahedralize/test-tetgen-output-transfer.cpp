@@ -0,0 +1,269 @@
+/*
+ * Copyright (c) 2012-2018, Association Scientifique pour la Geologie et ses
+ * Applications (ASGA). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of ASGA nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL ASGA BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *     http://www.ring-team.org
+ *
+ *     RING Project
+ *     Ecole Nationale Superieure de Geologie - GeoRessources
+ *     2 Rue du Doyen Marcel Roubault - TSA 70605
+ *     54518 VANDOEUVRE-LES-NANCY
+ *     FRANCE
+ */
+
+
+#include <ringmesh/ringmesh_tests_config.h>
+
+#include <set>
+
+#include <geogram/mesh/mesh.h>
+#include <geogram/mesh/mesh_repair.h>
+
+#include <ringmesh/mesh/mesh_builder.h>
+#include <ringmesh/mesh/mesh_index.h>
+#include <ringmesh/mesh/volume_mesh.h>
+#include <ringmesh/tetrahedralize/tetgen_mesher.h>
+
+/*!
+ * @file Tests that the TetGen output handed over to a volume mesh is the
+ * same as the one given by copying the kept tets, removing the isolated
+ * vertices and recomputing the tet adjacencies.
+ */
+
+using namespace RINGMesh;
+
+#ifdef RINGMESH_WITH_TETGEN
+
+const index_t nb_subdivisions = 3;
+
+void add_square( GEO::Mesh& mesh,
+    const vec3& origin,
+    const vec3& u_axis,
+    const vec3& v_axis )
+{
+    auto nb_points = nb_subdivisions + 1;
+    auto first = mesh.vertices.create_vertices( nb_points * nb_points );
+    for( auto i : range( nb_points ) )
+    {
+        for( auto j : range( nb_points ) )
+        {
+            mesh.vertices.point( first + i * nb_points + j ) =
+                origin + ( double( i ) / nb_subdivisions ) * u_axis
+                + ( double( j ) / nb_subdivisions ) * v_axis;
+        }
+    }
+    for( auto i : range( nb_subdivisions ) )
+    {
+        for( auto j : range( nb_subdivisions ) )
+        {
+            auto v00 = first + i * nb_points + j;
+            auto v10 = v00 + nb_points;
+            mesh.facets.create_triangle( v00, v10, v10 + 1 );
+            mesh.facets.create_triangle( v00, v10 + 1, v00 + 1 );
+        }
+    }
+}
+
+void add_box( GEO::Mesh& mesh, const vec3& origin, double size )
+{
+    vec3 x( size, 0, 0 );
+    vec3 y( 0, size, 0 );
+    vec3 z( 0, 0, size );
+    add_square( mesh, origin, y, z );
+    add_square( mesh, origin + x, y, z );
+    add_square( mesh, origin, x, z );
+    add_square( mesh, origin + y, x, z );
+    add_square( mesh, origin, x, y );
+    add_square( mesh, origin + z, x, y );
+}
+
+/*!
+ * A box with a cavity: the tets of the cavity, which is not incident to
+ * the outside, and the vertex isolated in it are not kept
+ */
+void build_box_with_cavity( GEO::Mesh& mesh )
+{
+    add_box( mesh, vec3(), 1. );
+    add_box( mesh, vec3( 0.3, 0.3, 0.3 ), 0.4 );
+    GEO::mesh_repair( mesh, GEO::MeshRepairMode(
+                                GEO::MESH_REPAIR_COLOCATE
+                                | GEO::MESH_REPAIR_QUIET ) );
+    auto center = mesh.vertices.create_vertex();
+    mesh.vertices.point( center ) = vec3( 0.5, 0.5, 0.5 );
+}
+
+/*!
+ * Runs TetGen with the TetgenMesher switches and copies its output
+ * through std::vectors, before removing the isolated vertices and
+ * connecting the cells
+ */
+void tetrahedralize_with_copies(
+    const GEO::Mesh& mesh, VolumeMeshBuilder3D& builder )
+{
+    GEO_3rdParty::tetgenio in;
+    GEO_3rdParty::tetgenio out;
+    in.numberofpoints = static_cast< int >( mesh.vertices.nb() );
+    in.pointlist = new double[3 * mesh.vertices.nb()];
+    for( auto v : range( mesh.vertices.nb() ) )
+    {
+        for( auto i : range( 3 ) )
+        {
+            in.pointlist[3 * v + i] = mesh.vertices.point( v )[i];
+        }
+    }
+    in.numberoffacets = static_cast< int >( mesh.facets.nb() );
+    in.facetlist = new GEO_3rdParty::tetgenio::facet[mesh.facets.nb()];
+    for( auto f : range( mesh.facets.nb() ) )
+    {
+        auto& facet = in.facetlist[f];
+        GEO_3rdParty::tetgenio::init( &facet );
+        facet.numberofpolygons = 1;
+        facet.polygonlist = new GEO_3rdParty::tetgenio::polygon[1];
+        auto& polygon = facet.polygonlist[0];
+        GEO_3rdParty::tetgenio::init( &polygon );
+        polygon.numberofvertices = 3;
+        polygon.vertexlist = new int[3];
+        for( auto v : range( 3 ) )
+        {
+            polygon.vertexlist[v] =
+                static_cast< int >( mesh.facets.vertex( f, v ) );
+        }
+    }
+    GEO_3rdParty::tetgenbehavior switches;
+    std::string command_line( "QpnYAA" );
+    switches.parse_commandline( &command_line[0] );
+    GEO_3rdParty::tetrahedralize( &switches, &in, &out );
+
+    // The regions incident to the outside are kept
+    auto nb_tets = static_cast< index_t >( out.numberoftetrahedra );
+    std::set< double > regions_to_keep;
+    for( auto c : range( 4 * nb_tets ) )
+    {
+        if( out.neighborlist[c] == -1 )
+        {
+            regions_to_keep.insert( out.tetrahedronattributelist[c / 4] );
+        }
+    }
+    std::vector< index_t > tets;
+    for( auto t : range( nb_tets ) )
+    {
+        if( regions_to_keep.count( out.tetrahedronattributelist[t] ) == 1 )
+        {
+            for( auto v : range( 4 ) )
+            {
+                tets.push_back(
+                    static_cast< index_t >( out.tetrahedronlist[4 * t + v] ) );
+            }
+        }
+    }
+    builder.assign_vertices( std::vector< double >(
+        out.pointlist, out.pointlist + 3 * out.numberofpoints ) );
+    builder.assign_cell_tet_mesh( tets );
+    builder.remove_isolated_vertices();
+    builder.connect_cells();
+}
+
+void compare_meshes( const VolumeMesh3D& mesh, const VolumeMesh3D& expected )
+{
+    if( mesh.nb_vertices() != expected.nb_vertices()
+        || mesh.nb_cells() != expected.nb_cells() )
+    {
+        throw RINGMeshException( "RINGMesh Test", "Mesh has ",
+            mesh.nb_vertices(), " vertices and ", mesh.nb_cells(),
+            " tets instead of ", expected.nb_vertices(), " and ",
+            expected.nb_cells() );
+    }
+    for( auto v : range( mesh.nb_vertices() ) )
+    {
+        if( mesh.vertex( v ) != expected.vertex( v ) )
+        {
+            throw RINGMeshException(
+                "RINGMesh Test", "Wrong coordinates for vertex ", v );
+        }
+    }
+    for( auto c : range( mesh.nb_cells() ) )
+    {
+        for( auto v : range( mesh.nb_cell_vertices( c ) ) )
+        {
+            if( mesh.cell_vertex( { c, v } )
+                != expected.cell_vertex( { c, v } ) )
+            {
+                throw RINGMeshException( "RINGMesh Test",
+                    "Wrong vertex ", v, " for tet ", c );
+            }
+            if( mesh.cell_adjacent( { c, v } )
+                != expected.cell_adjacent( { c, v } ) )
+            {
+                throw RINGMeshException( "RINGMesh Test",
+                    "Wrong adjacent for facet ", v, " of tet ", c );
+            }
+        }
+    }
+}
+
+void test_tetgen_output_transfer()
+{
+    GEO::Mesh box;
+    build_box_with_cavity( box );
+
+    auto mesh = VolumeMesh3D::create_mesh();
+    auto builder = VolumeMeshBuilder3D::create_builder( *mesh );
+    tetrahedralize_mesh_tetgen( *builder, box, false, 0 );
+
+    auto expected = VolumeMesh3D::create_mesh();
+    auto expected_builder = VolumeMeshBuilder3D::create_builder( *expected );
+    tetrahedralize_with_copies( box, *expected_builder );
+
+    if( expected->nb_vertices() + 1 != box.vertices.nb() )
+    {
+        throw RINGMeshException( "RINGMesh Test",
+            "The vertex in the cavity should be the only one removed" );
+    }
+    compare_meshes( *mesh, *expected );
+}
+
+#endif
+
+int main()
+{
+    try
+    {
+#ifdef RINGMESH_WITH_TETGEN
+        test_tetgen_output_transfer();
+#endif
+    }
+    catch( const RINGMeshException& e )
+    {
+        Logger::err( e.category(), e.what() );
+        return 1;
+    }
+    catch( const std::exception& e )
+    {
+        Logger::err( "Exception", e.what() );
+        return 1;
+    }
+    Logger::out( "TEST", "SUCCESS" );
+    return 0;
+}